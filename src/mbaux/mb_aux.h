@@ -219,6 +219,11 @@ void mb_justify_string(double height, char *string, double *s);
 void mb_plot_string(double x, double y, double hgt, double angle, char *label);
 
 /* mb_surface function prototypes */
+int mb_surface_init(int verbose, int nthreads, void **surface_ptr, int *error);
+int mb_surface_grid(int verbose, void *surface_ptr, int ndat, float *xdat, float *ydat, float *zdat, double xxmin,
+                    double xxmax, double yymin, double yymax, double xxinc, double yyinc, double ttension, float *sgrid,
+                    int *error);
+int mb_surface_deall(int verbose, void **surface_ptr, int *error);
 int mb_surface(int verbose, int ndat, float *xdat, float *ydat, float *zdat, double xxmin, double xxmax, double yymin,
                double yymax, double xxinc, double yyinc, double ttension, float *sgrid);
 int mb_zgrid(float *z, int *n_columns, int *n_rows, float *x1, float *y1, float *dx, float *dy, float *xyz, int *n, float *zpij, int *knxt,
@@ -65,12 +65,23 @@
  * Author:	D. W. Caress
  * Date:	May 2, 1994
  *
+ * The state formerly held in static variables now lives in a context
+ * structure allocated by mb_surface_init(), so that several surfaces
+ * may be computed concurrently. Large grids are relaxed using a
+ * red-black ordering of strips of grid columns, shared among the
+ * threads, so the solution does not depend on the number of threads:
+ *
+ * Author:	D. W. Caress
+ * Date:	October 15, 2026
  *
  */
 
 #include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "mb_aux.h"
 #include "mb_define.h"
@@ -90,234 +101,283 @@ struct MB_SURFACE_DATA {
 	float y;
 	float z;
 	int index;
+	double dist; /* squared distance to the node given by index */
 };
 
 struct MB_SURFACE_BRIGGS {
 	double b[6];
 };
 
-static int npoints = 0; /* Number of data points */
-static int n_columns = 0;      /* Number of nodes in x-dir. */
-static int n_rows = 0;      /* Number of nodes in y-dir. (Final grid) */
-static int m_columns = 0;
-static int m_rows = 0;
-static int ij_sw_corner, ij_se_corner, ij_nw_corner, ij_ne_corner;
-static int block_n_columns;             /* Number of nodes in x-dir for a given grid factor */
-static int block_n_rows;             /* Number of nodes in y-dir for a given grid factor */
-static int max_iterations = 250; /* Max iter per call to iterate */
-static int total_iterations = 0;
-static int grid, old_grid; /* Node spacings  */
-static int grid_east;
-static int n_fact = 0;  /* Number of factors in common (n_rows-1, n_columns-1) */
-static int factors[32]; /* Array of common factors */
-static int local_verbose = FALSE;
-static int local_error = MB_ERROR_NO_ERROR;
-static int status = MB_SUCCESS;
-// static int n_empty;                                     /* No of unconstrained nodes at initialization  */
-static int set_low = 0;                                 /* 0 unconstrained,1 = by min data value, 2 = by user value */
-static int set_high = 0;                                /* 0 unconstrained,1 = by max data value, 2 = by user value */
-static int constrained = FALSE;                         /* TRUE if set_low or set_high is TRUE */
-static double low_limit, high_limit;                    /* Constrains on range of solution */
-static double xmin, xmax, ymin, ymax;                   /* minmax coordinates */
-static float *lower, *upper;                            /* arrays for minmax values, if set */
-static double xinc, yinc;                               /* Size of each grid cell (final size) */
-static double grid_xinc, grid_yinc;                     /* size of each grid cell for a given grid factor */
-static double r_xinc, r_yinc, r_grid_xinc, r_grid_yinc; /* Reciprocals  */
-static double converge_limit = 0.0;                     /* Convergence limit */
-static double radius = 0.0;                             /* Search radius for initializing grid  */
-static double tension = 0.00;                           /* Tension parameter on the surface  */
-static double boundary_tension = 0.0;
-static double interior_tension = 0.0;
-static double a0_const_1, a0_const_2; /* Constants for off grid point equation  */
-static double e_2, e_m2, one_plus_e2;
-static double eps_p2, eps_m2, two_plus_ep2, two_plus_em2;
-static double x_edge_const, y_edge_const;
-static double epsilon = 1.0;
-static double z_mean;
-static double z_scale = 1.0;                /* Root mean square range of z after removing planar trend  */
-static double r_z_scale = 1.0;              /* reciprocal of z_scale  */
-static double plane_c0, plane_c1, plane_c2; /* Coefficients of best fitting plane to data  */
-static double smalldistance;                /* Let data point coincide with node if distance < smalldistance */
-static float *u;                            /* Pointer to grid array */
-static char *iu;                            /* Pointer to grid info array */
-static char mode_type[2] = {'I', 'D'};      /* D means include data points when iterating
-                                             * I means just interpolate from larger grid */
-
-static int offset[25][12];  /* Indices of 12 nearby points in 25 cases of edge conditions  */
-static double coeff[2][12]; /* Coefficients for 12 nearby points, constrained and unconstrained  */
-
-static double relax_old, relax_new = 1.4; /* Coefficients for relaxation factor to speed up convergence */
-
-static struct MB_SURFACE_DATA *data;     /* Data point and index to node it currently constrains  */
-static struct MB_SURFACE_BRIGGS *briggs; /* Coefficients in Taylor series for Laplacian(z) a la I. C. Briggs (1974)  */
-
-void set_coefficients() {
-	const double loose = 1.0 - interior_tension;
-	e_2 = epsilon * epsilon;
-	const double e_4 = e_2 * e_2;
-	eps_p2 = e_2;
-	eps_m2 = 1.0 / e_2;
-	one_plus_e2 = 1.0 + e_2;
-	two_plus_ep2 = 2.0 + 2.0 * eps_p2;
-	two_plus_em2 = 2.0 + 2.0 * eps_m2;
-
-	x_edge_const = 4 * one_plus_e2 - 2 * (interior_tension / loose);
-	e_m2 = 1.0 / e_2;
-	y_edge_const = 4 * (1.0 + e_m2) - 2 * (interior_tension * e_m2 / loose);
-
-	const double a0 = 1.0 / ((6 * e_4 * loose + 10 * e_2 * loose + 8 * loose - 2 * one_plus_e2) + 4 * interior_tension * one_plus_e2);
-	a0_const_1 = 2 * loose * (1.0 + e_4);
-	a0_const_2 = 2.0 - interior_tension + 2 * loose * e_2;
-
-	coeff[1][4] = coeff[1][7] = -loose;
-	coeff[1][0] = coeff[1][11] = -loose * e_4;
-	coeff[0][4] = coeff[0][7] = -loose * a0;
-	coeff[0][0] = coeff[0][11] = -loose * e_4 * a0;
-	coeff[1][5] = coeff[1][6] = 2 * loose * one_plus_e2;
-	coeff[0][5] = coeff[0][6] = (2 * coeff[1][5] + interior_tension) * a0;
-	coeff[1][2] = coeff[1][9] = coeff[1][5] * e_2;
-	coeff[0][2] = coeff[0][9] = coeff[0][5] * e_2;
-	coeff[1][1] = coeff[1][3] = coeff[1][8] = coeff[1][10] = -2 * loose * e_2;
-	coeff[0][1] = coeff[0][3] = coeff[0][8] = coeff[0][10] = coeff[1][1] * a0;
-
-	e_2 *= 2; /* We will need these in boundary conditions  */
-	e_m2 *= 2;
-
-	ij_sw_corner = 2 * m_rows + 2; /*  Corners of array of actual data  */
-	ij_se_corner = ij_sw_corner + (n_columns - 1) * m_rows;
-	ij_nw_corner = ij_sw_corner + (n_rows - 1);
-	ij_ne_corner = ij_se_corner + (n_rows - 1);
+/* Minimum number of nodes in a grid, and of block columns in a strip, for
+    strip relaxation, and the largest number of strips */
+#define MB_SURFACE_PARALLEL_NODES 65536
+#define MB_SURFACE_STRIP_COLUMNS 8
+#define MB_SURFACE_MAX_STRIPS 32
+
+/* Strip of block columns relaxed by one thread */
+struct mb_surface_strip_struct {
+	int column_start;       /* First block column in the strip */
+	int column_end;         /* One past the last block column in the strip */
+	int briggs_index;       /* Constraint table entry of the first constrained node in the strip */
+	double max_change;
+};
+
+/* Thread relaxing every stride'th strip starting from first_strip */
+struct mb_surface_worker_struct {
+	struct mb_surface_struct *surf;
+	int first_strip;
+	int stride;
+	bool started;
+	pthread_t thread;
+};
+
+/* Surface gridding context, holding the state of one surface solution */
+struct mb_surface_struct {
+	int nthreads;                                 /* Number of threads used to relax large grids */
+	struct mb_surface_worker_struct *workers;     /* One per thread */
+	int nstrips;                                  /* Number of strips, or 1 if relaxed serially */
+	struct mb_surface_strip_struct strips[MB_SURFACE_MAX_STRIPS];
+
+	int npoints;                                  /* Number of data points */
+	int n_columns;                                /* Number of nodes in x-dir. */
+	int n_rows;                                   /* Number of nodes in y-dir. (Final grid) */
+	int m_columns;
+	int m_rows;
+	int ij_sw_corner, ij_se_corner, ij_nw_corner, ij_ne_corner;
+	int block_n_columns;                          /* Number of nodes in x-dir for a given grid factor */
+	int block_n_rows;                             /* Number of nodes in y-dir for a given grid factor */
+	int max_iterations;                           /* Max iter per call to iterate */
+	int total_iterations;
+	int grid, old_grid;                           /* Node spacings  */
+	int grid_east;
+	int n_fact;                                   /* Number of factors in common (n_rows-1, n_columns-1) */
+	int factors[32];                              /* Array of common factors */
+	int local_verbose;
+	int local_error;
+	int status;
+	int set_low;                                  /* 0 unconstrained,1 = by min data value, 2 = by user value */
+	int set_high;                                 /* 0 unconstrained,1 = by max data value, 2 = by user value */
+	int constrained;                              /* TRUE if set_low or set_high is TRUE */
+	double low_limit, high_limit;                 /* Constrains on range of solution */
+	double xmin, xmax, ymin, ymax;                /* minmax coordinates */
+	float *lower, *upper;                         /* arrays for minmax values, if set */
+	double xinc, yinc;                            /* Size of each grid cell (final size) */
+	double grid_xinc, grid_yinc;                  /* size of each grid cell for a given grid factor */
+	double r_xinc, r_yinc, r_grid_xinc, r_grid_yinc; /* Reciprocals  */
+	double converge_limit;                        /* Convergence limit */
+	double radius;                                /* Search radius for initializing grid  */
+	double tension;                               /* Tension parameter on the surface  */
+	double boundary_tension;
+	double interior_tension;
+	double a0_const_1, a0_const_2;                /* Constants for off grid point equation  */
+	double e_2, e_m2, one_plus_e2;
+	double eps_p2, eps_m2, two_plus_ep2, two_plus_em2;
+	double x_edge_const, y_edge_const;
+	double epsilon;
+	double z_mean;
+	double z_scale;                               /* Root mean square range of z after removing planar trend  */
+	double r_z_scale;                             /* reciprocal of z_scale  */
+	double plane_c0, plane_c1, plane_c2;          /* Coefficients of best fitting plane to data  */
+	double smalldistance;                         /* Let data point coincide with node if distance < smalldistance */
+	float *u;                                     /* Pointer to grid array */
+	char *iu;                                     /* Pointer to grid info array */
+
+	int offset[25][12];                           /* Indices of 12 nearby points in 25 cases of edge conditions  */
+	double coeff[2][12];                          /* Coefficients for 12 nearby points, constrained and unconstrained  */
+
+	double relax_old, relax_new;                  /* Coefficients for relaxation factor to speed up convergence */
+
+	struct MB_SURFACE_DATA *data;                 /* Data point and index to node it currently constrains  */
+	struct MB_SURFACE_BRIGGS *briggs;             /* Coefficients in Taylor series for Laplacian(z) a la I. C. Briggs (1974)  */
+};
+
+static const char mode_type[2] = {'I', 'D'};  /* D means include data points when iterating
+                                               * I means just interpolate from larger grid */
+
+static void set_coefficients(struct mb_surface_struct *surf) {
+	const double loose = 1.0 - surf->interior_tension;
+	surf->e_2 = surf->epsilon * surf->epsilon;
+	const double e_4 = surf->e_2 * surf->e_2;
+	surf->eps_p2 = surf->e_2;
+	surf->eps_m2 = 1.0 / surf->e_2;
+	surf->one_plus_e2 = 1.0 + surf->e_2;
+	surf->two_plus_ep2 = 2.0 + 2.0 * surf->eps_p2;
+	surf->two_plus_em2 = 2.0 + 2.0 * surf->eps_m2;
+
+	surf->x_edge_const = 4 * surf->one_plus_e2 - 2 * (surf->interior_tension / loose);
+	surf->e_m2 = 1.0 / surf->e_2;
+	surf->y_edge_const = 4 * (1.0 + surf->e_m2) - 2 * (surf->interior_tension * surf->e_m2 / loose);
+
+	const double a0 = 1.0 / ((6 * e_4 * loose + 10 * surf->e_2 * loose + 8 * loose - 2 * surf->one_plus_e2) + 4 * surf->interior_tension * surf->one_plus_e2);
+	surf->a0_const_1 = 2 * loose * (1.0 + e_4);
+	surf->a0_const_2 = 2.0 - surf->interior_tension + 2 * loose * surf->e_2;
+
+	surf->coeff[1][4] = surf->coeff[1][7] = -loose;
+	surf->coeff[1][0] = surf->coeff[1][11] = -loose * e_4;
+	surf->coeff[0][4] = surf->coeff[0][7] = -loose * a0;
+	surf->coeff[0][0] = surf->coeff[0][11] = -loose * e_4 * a0;
+	surf->coeff[1][5] = surf->coeff[1][6] = 2 * loose * surf->one_plus_e2;
+	surf->coeff[0][5] = surf->coeff[0][6] = (2 * surf->coeff[1][5] + surf->interior_tension) * a0;
+	surf->coeff[1][2] = surf->coeff[1][9] = surf->coeff[1][5] * surf->e_2;
+	surf->coeff[0][2] = surf->coeff[0][9] = surf->coeff[0][5] * surf->e_2;
+	surf->coeff[1][1] = surf->coeff[1][3] = surf->coeff[1][8] = surf->coeff[1][10] = -2 * loose * surf->e_2;
+	surf->coeff[0][1] = surf->coeff[0][3] = surf->coeff[0][8] = surf->coeff[0][10] = surf->coeff[1][1] * a0;
+
+	surf->e_2 *= 2; /* We will need these in boundary conditions  */
+	surf->e_m2 *= 2;
+
+	surf->ij_sw_corner = 2 * surf->m_rows + 2; /*  Corners of array of actual data  */
+	surf->ij_se_corner = surf->ij_sw_corner + (surf->n_columns - 1) * surf->m_rows;
+	surf->ij_nw_corner = surf->ij_sw_corner + (surf->n_rows - 1);
+	surf->ij_ne_corner = surf->ij_se_corner + (surf->n_rows - 1);
 }
 
-void set_offset() {
+static void set_offset(struct mb_surface_struct *surf) {
 	/* Make these const. */
 	int add_w[5];
-	add_w[0] = -m_rows;
-	add_w[1] = add_w[2] = add_w[3] = add_w[4] = -grid_east;
+	add_w[0] = -surf->m_rows;
+	add_w[1] = add_w[2] = add_w[3] = add_w[4] = -surf->grid_east;
 	int add_w2[5];
-	add_w2[0] = -2 * m_rows;
-	add_w2[1] = -m_rows - grid_east;
-	add_w2[2] = add_w2[3] = add_w2[4] = -2 * grid_east;
+	add_w2[0] = -2 * surf->m_rows;
+	add_w2[1] = -surf->m_rows - surf->grid_east;
+	add_w2[2] = add_w2[3] = add_w2[4] = -2 * surf->grid_east;
 	int add_e[5];
-	add_e[4] = m_rows;
-	add_e[0] = add_e[1] = add_e[2] = add_e[3] = grid_east;
+	add_e[4] = surf->m_rows;
+	add_e[0] = add_e[1] = add_e[2] = add_e[3] = surf->grid_east;
 	int add_e2[5];
-	add_e2[4] = 2 * m_rows;
-	add_e2[3] = m_rows + grid_east;
-	add_e2[2] = add_e2[1] = add_e2[0] = 2 * grid_east;
+	add_e2[4] = 2 * surf->m_rows;
+	add_e2[3] = surf->m_rows + surf->grid_east;
+	add_e2[2] = add_e2[1] = add_e2[0] = 2 * surf->grid_east;
 
 	int add_n[5];
 	add_n[4] = 1;
-	add_n[3] = add_n[2] = add_n[1] = add_n[0] = grid;
+	add_n[3] = add_n[2] = add_n[1] = add_n[0] = surf->grid;
 	int add_n2[5];
 	add_n2[4] = 2;
-	add_n2[3] = grid + 1;
-	add_n2[2] = add_n2[1] = add_n2[0] = 2 * grid;
+	add_n2[3] = surf->grid + 1;
+	add_n2[2] = add_n2[1] = add_n2[0] = 2 * surf->grid;
 	int add_s[5];
 	add_s[0] = -1;
-	add_s[1] = add_s[2] = add_s[3] = add_s[4] = -grid;
+	add_s[1] = add_s[2] = add_s[3] = add_s[4] = -surf->grid;
 	int add_s2[5];
 	add_s2[0] = -2;
-	add_s2[1] = -grid - 1;
-	add_s2[2] = add_s2[3] = add_s2[4] = -2 * grid;
+	add_s2[1] = -surf->grid - 1;
+	add_s2[2] = add_s2[3] = add_s2[4] = -2 * surf->grid;
 
 	for (int i = 0, kase = 0; i < 5; i++) {
 		for (int j = 0; j < 5; j++, kase++) {
-			offset[kase][0] = add_n2[j];
-			offset[kase][1] = add_n[j] + add_w[i];
-			offset[kase][2] = add_n[j];
-			offset[kase][3] = add_n[j] + add_e[i];
-			offset[kase][4] = add_w2[i];
-			offset[kase][5] = add_w[i];
-			offset[kase][6] = add_e[i];
-			offset[kase][7] = add_e2[i];
-			offset[kase][8] = add_s[j] + add_w[i];
-			offset[kase][9] = add_s[j];
-			offset[kase][10] = add_s[j] + add_e[i];
-			offset[kase][11] = add_s2[j];
+			surf->offset[kase][0] = add_n2[j];
+			surf->offset[kase][1] = add_n[j] + add_w[i];
+			surf->offset[kase][2] = add_n[j];
+			surf->offset[kase][3] = add_n[j] + add_e[i];
+			surf->offset[kase][4] = add_w2[i];
+			surf->offset[kase][5] = add_w[i];
+			surf->offset[kase][6] = add_e[i];
+			surf->offset[kase][7] = add_e2[i];
+			surf->offset[kase][8] = add_s[j] + add_w[i];
+			surf->offset[kase][9] = add_s[j];
+			surf->offset[kase][10] = add_s[j] + add_e[i];
+			surf->offset[kase][11] = add_s2[j];
 		}
 	}
 }
 
-void fill_in_forecast() {
+static void fill_in_forecast(struct mb_surface_struct *surf) {
 	// Fills in bilinear estimates into new node locations
 	// after grid is divided.
 
-	const double old_size = 1.0 / (double)old_grid;
+	const double old_size = 1.0 / (double)surf->old_grid;
 
 	/* first do from southwest corner */
-	for (int i = 0; i < n_columns - 1; i += old_grid) {
-		for (int j = 0; j < n_rows - 1; j += old_grid) {
+	for (int i = 0; i < surf->n_columns - 1; i += surf->old_grid) {
+		for (int j = 0; j < surf->n_rows - 1; j += surf->old_grid) {
 
 			/* get indices of bilinear square */
-			const int index_0 = ij_sw_corner + i * m_rows + j;
-			const int index_1 = index_0 + old_grid * m_rows;
-			const int index_2 = index_1 + old_grid;
-			const int index_3 = index_0 + old_grid;
+			const int index_0 = surf->ij_sw_corner + i * surf->m_rows + j;
+			const int index_1 = index_0 + surf->old_grid * surf->m_rows;
+			const int index_2 = index_1 + surf->old_grid;
+			const int index_3 = index_0 + surf->old_grid;
 
 			/* get coefficients */
-			const double a0 = u[index_0];
-			const double a1 = u[index_1] - a0;
-			const double a2 = u[index_3] - a0;
-			const double a3 = u[index_2] - a0 - a1 - a2;
+			const double a0 = surf->u[index_0];
+			const double a1 = surf->u[index_1] - a0;
+			const double a2 = surf->u[index_3] - a0;
+			const double a3 = surf->u[index_2] - a0 - a1 - a2;
 
 			/* find all possible new fill ins */
 
-			for (int ii = i; ii < i + old_grid; ii += grid) {
+			for (int ii = i; ii < i + surf->old_grid; ii += surf->grid) {
 				const double delta_x = (ii - i) * old_size;
-				for (int jj = j; jj < j + old_grid; jj += grid) {
-					const int index_new = ij_sw_corner + ii * m_rows + jj;
+				for (int jj = j; jj < j + surf->old_grid; jj += surf->grid) {
+					const int index_new = surf->ij_sw_corner + ii * surf->m_rows + jj;
 					if (index_new == index_0)
 						continue;
 					const double delta_y = (jj - j) * old_size;
-					u[index_new] = a0 + a1 * delta_x + delta_y * (a2 + a3 * delta_x);
-					iu[index_new] = 0;
+					surf->u[index_new] = a0 + a1 * delta_x + delta_y * (a2 + a3 * delta_x);
+					surf->iu[index_new] = 0;
 				}
 			}
-			iu[index_0] = 5;
+			surf->iu[index_0] = 5;
 		}
 	}
 
 	/* now do linear guess along east edge */
 
-	for (int j = 0; j < (n_rows - 1); j += old_grid) {
-		const int index_0 = ij_se_corner + j;
-		const int index_3 = index_0 + old_grid;
-		for (int jj = j; jj < j + old_grid; jj += grid) {
-			const int index_new = ij_se_corner + jj;
+	for (int j = 0; j < (surf->n_rows - 1); j += surf->old_grid) {
+		const int index_0 = surf->ij_se_corner + j;
+		const int index_3 = index_0 + surf->old_grid;
+		for (int jj = j; jj < j + surf->old_grid; jj += surf->grid) {
+			const int index_new = surf->ij_se_corner + jj;
 			const double delta_y = (jj - j) * old_size;
-			u[index_new] = u[index_0] + delta_y * (u[index_3] - u[index_0]);
-			iu[index_new] = 0;
+			surf->u[index_new] = surf->u[index_0] + delta_y * (surf->u[index_3] - surf->u[index_0]);
+			surf->iu[index_new] = 0;
 		}
-		iu[index_0] = 5;
+		surf->iu[index_0] = 5;
 	}
 	/* now do linear guess along north edge */
-	for (int i = 0; i < (n_columns - 1); i += old_grid) {
-		const int index_0 = ij_nw_corner + i * m_rows;
-		const int index_1 = index_0 + old_grid * m_rows;
-		for (int ii = i; ii < i + old_grid; ii += grid) {
-			const int index_new = ij_nw_corner + ii * m_rows;
+	for (int i = 0; i < (surf->n_columns - 1); i += surf->old_grid) {
+		const int index_0 = surf->ij_nw_corner + i * surf->m_rows;
+		const int index_1 = index_0 + surf->old_grid * surf->m_rows;
+		for (int ii = i; ii < i + surf->old_grid; ii += surf->grid) {
+			const int index_new = surf->ij_nw_corner + ii * surf->m_rows;
 			const double delta_x = (ii - i) * old_size;
-			u[index_new] = u[index_0] + delta_x * (u[index_1] - u[index_0]);
-			iu[index_new] = 0;
+			surf->u[index_new] = surf->u[index_0] + delta_x * (surf->u[index_1] - surf->u[index_0]);
+			surf->iu[index_new] = 0;
 		}
-		iu[index_0] = 5;
+		surf->iu[index_0] = 5;
 	}
 	/* now set northeast corner to fixed and we're done */
-	iu[ij_ne_corner] = 5;
+	surf->iu[surf->ij_ne_corner] = 5;
 }
 
-void smart_divide() {
+static void smart_divide(struct mb_surface_struct *surf) {
 	/* Divide grid by its largest prime factor */
-	grid /= factors[n_fact - 1];
-	n_fact--;
+	surf->grid /= surf->factors[surf->n_fact - 1];
+	surf->n_fact--;
+}
+
+static void set_distances(struct mb_surface_struct *surf) {
+	/* Stores the squared distance from each datum to the node it is indexed to,
+	    so that the sort below does not need to know the current grid spacing.
+	*/
+	for (int k = 0; k < surf->npoints; k++) {
+		if (surf->data[k].index == OUTSIDE)
+			continue;
+		const int block_i = surf->data[k].index / surf->block_n_rows;
+		const int block_j = surf->data[k].index % surf->block_n_rows;
+		const double x0 = surf->xmin + block_i * surf->grid_xinc;
+		const double y0 = surf->ymin + block_j * surf->grid_yinc;
+		surf->data[k].dist = (surf->data[k].x - x0) * (surf->data[k].x - x0) + (surf->data[k].y - y0) * (surf->data[k].y - y0);
+	}
 }
 
-int compare_points(struct MB_SURFACE_DATA *point_1, struct MB_SURFACE_DATA *point_2) {
+static int compare_points(const void *p1, const void *p2) {
 	/*  Routine for qsort to sort data structure for fast access to data by node location.
 	    Sorts on index first, then on radius to node corresponding to index, so that index
 	    goes from low to high, and so does radius.
 	*/
+	const struct MB_SURFACE_DATA *point_1 = (const struct MB_SURFACE_DATA *)p1;
+	const struct MB_SURFACE_DATA *point_2 = (const struct MB_SURFACE_DATA *)p2;
 	const int index_1 = point_1->index;
 	const int index_2 = point_2->index;
 	if (index_1 < index_2)
@@ -328,151 +388,146 @@ int compare_points(struct MB_SURFACE_DATA *point_1, struct MB_SURFACE_DATA *poin
 		return (0);
 
 	/* Points are in same grid cell, find the one who is nearest to grid point */
-	const int block_i = point_1->index / block_n_rows;
-	const int block_j = point_1->index % block_n_rows;
-	const double x0 = xmin + block_i * grid_xinc;
-	const double y0 = ymin + block_j * grid_yinc;
-	const double dist_1 = (point_1->x - x0) * (point_1->x - x0) + (point_1->y - y0) * (point_1->y - y0);
-	const double dist_2 = (point_2->x - x0) * (point_2->x - x0) + (point_2->y - y0) * (point_2->y - y0);
-	if (dist_1 < dist_2)
+	if (point_1->dist < point_2->dist)
 		return (-1);
-	if (dist_1 > dist_2)
+	if (point_1->dist > point_2->dist)
 		return (1);
 	else
 		return (0);
 }
 
-void set_index() {
+static void set_index(struct mb_surface_struct *surf) {
 	/* recomputes data[k].index for new value of grid,
 	   sorts data on index and radii, and throws away
 	   data which are now outside the useable limits. */
 	int k_skipped = 0;
 
-	for (int k = 0; k < npoints; k++) {
-		const int i = floor(((data[k].x - xmin) * r_grid_xinc) + 0.5);
-		const int j = floor(((data[k].y - ymin) * r_grid_yinc) + 0.5);
-		if (i < 0 || i >= block_n_columns || j < 0 || j >= block_n_rows) {
-			data[k].index = OUTSIDE;
+	for (int k = 0; k < surf->npoints; k++) {
+		const int i = floor(((surf->data[k].x - surf->xmin) * surf->r_grid_xinc) + 0.5);
+		const int j = floor(((surf->data[k].y - surf->ymin) * surf->r_grid_yinc) + 0.5);
+		if (i < 0 || i >= surf->block_n_columns || j < 0 || j >= surf->block_n_rows) {
+			surf->data[k].index = OUTSIDE;
 			k_skipped++;
 		}
 		else
-			data[k].index = i * block_n_rows + j;
+			surf->data[k].index = i * surf->block_n_rows + j;
 	}
 
-	qsort((char *)data, npoints, sizeof(struct MB_SURFACE_DATA), (void *)compare_points);
+	set_distances(surf);
+	qsort((char *)surf->data, surf->npoints, sizeof(struct MB_SURFACE_DATA), compare_points);
 
-	npoints -= k_skipped;
+	surf->npoints -= k_skipped;
 }
 
-void find_nearest_point() {
-	smalldistance = 0.05 * ((grid_xinc < grid_yinc) ? grid_xinc : grid_yinc);
+static void find_nearest_point(struct mb_surface_struct *surf) {
+	surf->smalldistance = 0.05 * ((surf->grid_xinc < surf->grid_yinc) ? surf->grid_xinc : surf->grid_yinc);
 
-	for (int i = 0; i < n_columns; i += grid) /* Reset grid info */
-		for (int j = 0; j < n_rows; j += grid)
-			iu[ij_sw_corner + i * m_rows + j] = 0;
+	for (int i = 0; i < surf->n_columns; i += surf->grid) /* Reset grid info */
+		for (int j = 0; j < surf->n_rows; j += surf->grid)
+			surf->iu[surf->ij_sw_corner + i * surf->m_rows + j] = 0;
 
 	int last_index = -1;
 	int briggs_index = 0;
-	for (int k = 0; k < npoints; k++) { /* Find constraining value  */
-		if (data[k].index != last_index) {
-			const int block_i = data[k].index / block_n_rows;
-			const int block_j = data[k].index % block_n_rows;
-			last_index = data[k].index;
-			const int iu_index = ij_sw_corner + (block_i * m_rows + block_j) * grid;
-			const double x0 = xmin + block_i * grid_xinc;
-			const double y0 = ymin + block_j * grid_yinc;
-			double dx = (data[k].x - x0) * r_grid_xinc;
-			double dy = (data[k].y - y0) * r_grid_yinc;
-			if (fabs(dx) < smalldistance && fabs(dy) < smalldistance) {
-				iu[iu_index] = 5;
-				u[iu_index] = data[k].z;
+	for (int k = 0; k < surf->npoints; k++) { /* Find constraining value  */
+		if (surf->data[k].index != last_index) {
+			const int block_i = surf->data[k].index / surf->block_n_rows;
+			const int block_j = surf->data[k].index % surf->block_n_rows;
+			last_index = surf->data[k].index;
+			const int iu_index = surf->ij_sw_corner + (block_i * surf->m_rows + block_j) * surf->grid;
+			const double x0 = surf->xmin + block_i * surf->grid_xinc;
+			const double y0 = surf->ymin + block_j * surf->grid_yinc;
+			double dx = (surf->data[k].x - x0) * surf->r_grid_xinc;
+			double dy = (surf->data[k].y - y0) * surf->r_grid_yinc;
+			if (fabs(dx) < surf->smalldistance && fabs(dy) < surf->smalldistance) {
+				surf->iu[iu_index] = 5;
+				surf->u[iu_index] = surf->data[k].z;
 			}
 			else {
 				if (dx >= 0.0) {
 					if (dy >= 0.0)
-						iu[iu_index] = 1;
+						surf->iu[iu_index] = 1;
 					else
-						iu[iu_index] = 4;
+						surf->iu[iu_index] = 4;
 				}
 				else {
 					if (dy >= 0.0)
-						iu[iu_index] = 2;
+						surf->iu[iu_index] = 2;
 					else
-						iu[iu_index] = 3;
+						surf->iu[iu_index] = 3;
 				}
 				dx = fabs(dx);
 				dy = fabs(dy);
-				const double btemp = 2 * one_plus_e2 / ((dx + dy) * (1.0 + dx + dy));
+				const double btemp = 2 * surf->one_plus_e2 / ((dx + dy) * (1.0 + dx + dy));
 				const double b0 = 1.0 - 0.5 * (dx + (dx * dx)) * btemp;
-				const double b3 = 0.5 * (e_2 - (dy + (dy * dy)) * btemp);
+				const double b3 = 0.5 * (surf->e_2 - (dy + (dy * dy)) * btemp);
 				const double xys = 1.0 + dx + dy;
 				const double xy1 = 1.0 / xys;
-				const double b1 = (e_2 * xys - 4 * dy) * xy1;
+				const double b1 = (surf->e_2 * xys - 4 * dy) * xy1;
 				const double b2 = 2 * (dy - dx + 1.0) * xy1;
 				const double b4 = b0 + b1 + b2 + b3 + btemp;
-				const double b5 = btemp * data[k].z;
-				briggs[briggs_index].b[0] = b0;
-				briggs[briggs_index].b[1] = b1;
-				briggs[briggs_index].b[2] = b2;
-				briggs[briggs_index].b[3] = b3;
-				briggs[briggs_index].b[4] = b4;
-				briggs[briggs_index].b[5] = b5;
+				const double b5 = btemp * surf->data[k].z;
+				surf->briggs[briggs_index].b[0] = b0;
+				surf->briggs[briggs_index].b[1] = b1;
+				surf->briggs[briggs_index].b[2] = b2;
+				surf->briggs[briggs_index].b[3] = b3;
+				surf->briggs[briggs_index].b[4] = b4;
+				surf->briggs[briggs_index].b[5] = b5;
 				briggs_index++;
 			}
 		}
 	}
 }
 
-void set_grid_parameters() {
-	block_n_rows = (n_rows - 1) / grid + 1;
-	block_n_columns = (n_columns - 1) / grid + 1;
-	grid_xinc = grid * xinc;
-	grid_yinc = grid * yinc;
-	grid_east = grid * m_rows;
-	r_grid_xinc = 1.0 / grid_xinc;
-	r_grid_yinc = 1.0 / grid_yinc;
+static void set_grid_parameters(struct mb_surface_struct *surf) {
+	surf->block_n_rows = (surf->n_rows - 1) / surf->grid + 1;
+	surf->block_n_columns = (surf->n_columns - 1) / surf->grid + 1;
+	surf->grid_xinc = surf->grid * surf->xinc;
+	surf->grid_yinc = surf->grid * surf->yinc;
+	surf->grid_east = surf->grid * surf->m_rows;
+	surf->r_grid_xinc = 1.0 / surf->grid_xinc;
+	surf->r_grid_yinc = 1.0 / surf->grid_yinc;
 }
 
-void initialize_grid() {
+static void initialize_grid(struct mb_surface_struct *surf) {
 	// For the initial gridsize, compute weighted averages of data inside the search radius
 	// and assign the values to u[i,j] where i,j are multiples of gridsize.
-	const int irad = ceil(radius / grid_xinc);
-	const int jrad = ceil(radius / grid_yinc);
-	const double rfact = -4.5 / (radius * radius);
-
-	for (int i = 0; i < block_n_columns; i++) {
-		const double x0 = xmin + i * grid_xinc;
-		for (int j = 0; j < block_n_rows; j++) {
-			const double y0 = ymin + j * grid_yinc;
+	const int irad = ceil(surf->radius / surf->grid_xinc);
+	const int jrad = ceil(surf->radius / surf->grid_yinc);
+	const double rfact = -4.5 / (surf->radius * surf->radius);
+
+	for (int i = 0; i < surf->block_n_columns; i++) {
+		const double x0 = surf->xmin + i * surf->grid_xinc;
+		for (int j = 0; j < surf->block_n_rows; j++) {
+			const double y0 = surf->ymin + j * surf->grid_yinc;
 			int imin = i - irad;
 			if (imin < 0)
 				imin = 0;
 			int imax = i + irad;
-			if (imax >= block_n_columns)
-				imax = block_n_columns - 1;
+			if (imax >= surf->block_n_columns)
+				imax = surf->block_n_columns - 1;
 			int jmin = j - jrad;
 			if (jmin < 0)
 				jmin = 0;
 			int jmax = j + jrad;
-			if (jmax >= block_n_rows)
-				jmax = block_n_rows - 1;
-			const int index_1 = imin * block_n_rows + jmin;
-			const int index_2 = imax * block_n_rows + jmax + 1;
+			if (jmax >= surf->block_n_rows)
+				jmax = surf->block_n_rows - 1;
+			const int index_1 = imin * surf->block_n_rows + jmin;
+			const int index_2 = imax * surf->block_n_rows + jmax + 1;
 			double sum_w = 0.0;
                         double sum_zw = 0.0;
 			int k = 0;
-			while (k < npoints && data[k].index < index_1)
+			while (k < surf->npoints && surf->data[k].index < index_1)
 				k++;
-			for (int ki = imin; k < npoints && ki <= imax && data[k].index < index_2; ki++) {
-				for (int kj = jmin; k < npoints && kj <= jmax && data[k].index < index_2; kj++) {
-					const int k_index = ki * block_n_rows + kj;
-					while (k < npoints && data[k].index < k_index)
+			for (int ki = imin; k < surf->npoints && ki <= imax && surf->data[k].index < index_2; ki++) {
+				for (int kj = jmin; k < surf->npoints && kj <= jmax && surf->data[k].index < index_2; kj++) {
+					const int k_index = ki * surf->block_n_rows + kj;
+					while (k < surf->npoints && surf->data[k].index < k_index)
 						k++;
-					while (k < npoints && data[k].index == k_index) {
-						const double r = (data[k].x - x0) * (data[k].x - x0) + (data[k].y - y0) * (data[k].y - y0);
+					while (k < surf->npoints && surf->data[k].index == k_index) {
+						const double r = (surf->data[k].x - x0) * (surf->data[k].x - x0) + (surf->data[k].y - y0) * (surf->data[k].y - y0);
 						const double weight = exp(rfact * r);
 						sum_w += weight;
-						sum_zw += weight * data[k].z;
+						sum_zw += weight * surf->data[k].z;
 						k++;
 					}
 				}
@@ -481,35 +536,37 @@ void initialize_grid() {
 				/*
 				fprintf (stderr, "surface: Warning: no data inside search radius at: %.8lg %.8lg\n", x0, y0);
 				*/
-				u[ij_sw_corner + (i * m_rows + j) * grid] = z_mean;
+				surf->u[surf->ij_sw_corner + (i * surf->m_rows + j) * surf->grid] = surf->z_mean;
 			}
 			else {
-				u[ij_sw_corner + (i * m_rows + j) * grid] = sum_zw / sum_w;
+				surf->u[surf->ij_sw_corner + (i * surf->m_rows + j) * surf->grid] = sum_zw / sum_w;
 			}
 		}
 	}
 }
 
 /* This function rewritten by D.W. Caress 5/3/94 */
-void read_data(int ndat, float *xdat, float *ydat, float *zdat) {
+static void read_data(struct mb_surface_struct *surf, int ndat, float *xdat, float *ydat, float *zdat) {
 	int kmax = 0;
 	int kmin = 0;
 	double zmin = 1.0e38;
 	double zmax = -1.0e38;
 
-	status = mb_mallocd(local_verbose, __FILE__, __LINE__, ndat * sizeof(struct MB_SURFACE_DATA), (void **)&data, &local_error);
+	surf->status = mb_mallocd(surf->local_verbose, __FILE__, __LINE__, ndat * sizeof(struct MB_SURFACE_DATA), (void **)&surf->data, &surf->local_error);
+	if (surf->status != MB_SUCCESS)
+		return;
 
 	/* Read in xyz data and computes index no and store it in a structure */
 	int k = 0;
-	z_mean = 0;
+	surf->z_mean = 0;
 	for (int idat = 0; idat < ndat; idat++) {
-		const int i = floor(((xdat[idat] - xmin) * r_grid_xinc) + 0.5);
-		const int j = floor(((ydat[idat] - ymin) * r_grid_yinc) + 0.5);
-		if (i >= 0 && i < block_n_columns && j >= 0 && j < block_n_rows) {
-			data[k].index = i * block_n_rows + j;
-			data[k].x = xdat[idat];
-			data[k].y = ydat[idat];
-			data[k].z = zdat[idat];
+		const int i = floor(((xdat[idat] - surf->xmin) * surf->r_grid_xinc) + 0.5);
+		const int j = floor(((ydat[idat] - surf->ymin) * surf->r_grid_yinc) + 0.5);
+		if (i >= 0 && i < surf->block_n_columns && j >= 0 && j < surf->block_n_rows) {
+			surf->data[k].index = i * surf->block_n_rows + j;
+			surf->data[k].x = xdat[idat];
+			surf->data[k].y = ydat[idat];
+			surf->data[k].z = zdat[idat];
 			if (zmin > zdat[idat]) {
 				zmin = zdat[idat];
 				kmin = k;
@@ -519,14 +576,14 @@ void read_data(int ndat, float *xdat, float *ydat, float *zdat) {
 				kmax = k;
 			}
 			k++;
-			z_mean += zdat[idat];
+			surf->z_mean += zdat[idat];
 		}
 	}
 
-	npoints = k;
-	z_mean /= k;
-	if (converge_limit == 0.0) {
-		converge_limit = 0.001 * z_scale; /* c_l = 1 ppt of L2 scale */
+	surf->npoints = k;
+	surf->z_mean /= k;
+	if (surf->converge_limit == 0.0) {
+		surf->converge_limit = 0.001 * surf->z_scale; /* c_l = 1 ppt of L2 scale */
 	}
 	/*
 	if (local_verbose) {
@@ -537,17 +594,17 @@ void read_data(int ndat, float *xdat, float *ydat, float *zdat) {
 	}
 	*/
 
-	if (set_low == 1)
-		low_limit = data[kmin].z;
-	else if (set_low == 2 && low_limit > data[kmin].z) {
+	if (surf->set_low == 1)
+		surf->low_limit = surf->data[kmin].z;
+	else if (surf->set_low == 2 && surf->low_limit > surf->data[kmin].z) {
 		/*	low_limit = data[kmin].z;	*/
 		/*
 		fprintf (stderr, "surface: Warning:  Your lower value is > than min data value.\n");
 		*/
 	}
-	if (set_high == 1)
-		high_limit = data[kmax].z;
-	else if (set_high == 2 && high_limit < data[kmax].z) {
+	if (surf->set_high == 1)
+		surf->high_limit = surf->data[kmax].z;
+	else if (surf->set_high == 2 && surf->high_limit < surf->data[kmax].z) {
 		/*	high_limit = data[kmax].z;	*/
 		/*
 		fprintf (stderr, "surface: Warning:  Your upper value is < than max data value.\n");
@@ -556,82 +613,258 @@ void read_data(int ndat, float *xdat, float *ydat, float *zdat) {
 }
 
 /* this function rewritten from write_output() by D.W. Caress 5/3/94 */
-void get_output(float *sgrid) {
-        int index = ij_sw_corner;
-	for (int i = 0; i < n_columns; i++, index += m_rows)
-		for (int j = 0; j < n_rows; j++) {
-			sgrid[j * n_columns + i] = u[index + n_rows - j - 1];
+static void get_output(struct mb_surface_struct *surf, float *sgrid) {
+        int index = surf->ij_sw_corner;
+	for (int i = 0; i < surf->n_columns; i++, index += surf->m_rows)
+		for (int j = 0; j < surf->n_rows; j++) {
+			sgrid[j * surf->n_columns + i] = surf->u[index + surf->n_rows - j - 1];
 		}
 }
 
-int iterate(int mode) {
-	int k, kase, ij_v2;
+static double relax_columns(struct mb_surface_struct *surf, int column_start, int column_end, int briggs_index) {
+	/* Performs one overrelaxation sweep over the block columns column_start
+	    to column_end - 1, starting from the given constraint table entry,
+	    and returns the largest change made to any node.
+	*/
+	double max_change = -1.0;
+
+	int x_w_case = column_start;
+	int x_e_case = surf->block_n_columns - 1 - column_start;
+	for (int i = column_start * surf->grid; x_w_case < column_end; i += surf->grid, x_w_case++, x_e_case--) {
+
+		int x_case;
+		if (x_w_case < 2)
+			x_case = x_w_case;
+		else if (x_e_case < 2)
+			x_case = 4 - x_e_case;
+		else
+			x_case = 2;
+
+		int y_s_case = 0;
+		int y_n_case = surf->block_n_rows - 1;
+
+		int ij = surf->ij_sw_corner + i * surf->m_rows;
+
+		for (int j = 0; j < surf->n_rows; j += surf->grid, ij += surf->grid, y_s_case++, y_n_case--) {
+
+			if (surf->iu[ij] == 5)
+				continue; /* Point is fixed  */
+
+			int y_case;
+			if (y_s_case < 2)
+				y_case = y_s_case;
+			else if (y_n_case < 2)
+				y_case = 4 - y_n_case;
+			else
+				y_case = 2;
+
+			const int kase = x_case * 5 + y_case;
+			double sum_ij = 0.0;
+
+			if (surf->iu[ij] == 0) { /* Point is unconstrained  */
+				for (int k = 0; k < 12; k++) {
+					sum_ij += (surf->u[ij + surf->offset[kase][k]] * surf->coeff[0][k]);
+				}
+			}
+			else { /* Point is constrained  */
+
+				const double b0 = surf->briggs[briggs_index].b[0];
+				const double b1 = surf->briggs[briggs_index].b[1];
+				const double b2 = surf->briggs[briggs_index].b[2];
+				const double b3 = surf->briggs[briggs_index].b[3];
+				const double b4 = surf->briggs[briggs_index].b[4];
+				const double b5 = surf->briggs[briggs_index].b[5];
+				briggs_index++;
+				double busum;
+				if (surf->iu[ij] < 3) {
+					if (surf->iu[ij] == 1) { /* Point is in quadrant 1  */
+						busum = b0 * surf->u[ij + surf->offset[kase][10]] + b1 * surf->u[ij + surf->offset[kase][9]] + b2 * surf->u[ij + surf->offset[kase][5]] +
+						        b3 * surf->u[ij + surf->offset[kase][1]];
+					}
+					else { /* Point is in quadrant 2  */
+						busum = b0 * surf->u[ij + surf->offset[kase][8]] + b1 * surf->u[ij + surf->offset[kase][9]] + b2 * surf->u[ij + surf->offset[kase][6]] +
+						        b3 * surf->u[ij + surf->offset[kase][3]];
+					}
+				}
+				else {
+					if (surf->iu[ij] == 3) { /* Point is in quadrant 3  */
+						busum = b0 * surf->u[ij + surf->offset[kase][1]] + b1 * surf->u[ij + surf->offset[kase][2]] + b2 * surf->u[ij + surf->offset[kase][6]] +
+						        b3 * surf->u[ij + surf->offset[kase][10]];
+					}
+					else { /* Point is in quadrant 4  */
+						busum = b0 * surf->u[ij + surf->offset[kase][3]] + b1 * surf->u[ij + surf->offset[kase][2]] + b2 * surf->u[ij + surf->offset[kase][5]] +
+						        b3 * surf->u[ij + surf->offset[kase][8]];
+					}
+				}
+				for (int k = 0; k < 12; k++) {
+					sum_ij += (surf->u[ij + surf->offset[kase][k]] * surf->coeff[1][k]);
+				}
+				sum_ij = (sum_ij + surf->a0_const_2 * (busum + b5)) / (surf->a0_const_1 + surf->a0_const_2 * b4);
+			}
+
+			/* New relaxation here  */
+			sum_ij = surf->u[ij] * surf->relax_old + sum_ij * surf->relax_new;
+
+			if (surf->constrained) { /* Must check limits.  Note lower/upper is v2 format and need ij_v2! */
+				const int ij_v2 = (surf->n_rows - j - 1) * surf->n_columns + i;
+				if (surf->set_low /*&& !GMT_is_fnan((double)lower[ij_v2])*/ && sum_ij < surf->lower[ij_v2])
+					sum_ij = surf->lower[ij_v2];
+				else if (surf->set_high /*&& !GMT_is_fnan((double)upper[ij_v2])*/ && sum_ij > surf->upper[ij_v2])
+					sum_ij = surf->upper[ij_v2];
+			}
+
+			const double change = fabs(sum_ij - surf->u[ij]);
+			surf->u[ij] = sum_ij;
+			if (change > max_change)
+				max_change = change;
+		}
+	}
+
+	return (max_change);
+}
+
+static int set_strips(struct mb_surface_struct *surf) {
+	/* Chooses the number of strips of block columns that relax_strips()
+	    will relax, and finds the constraint table entry of the first
+	    constrained node in each strip. The stencil reaches two block
+	    columns east and west, so each strip must be at least two block
+	    columns wide. The strips depend only on the grid, not on the
+	    number of threads, so that the solution does not either.
+	    Returns 1 if the grid should be relaxed serially.
+	*/
+	surf->nstrips = 1;
+	if (surf->block_n_columns * surf->block_n_rows < MB_SURFACE_PARALLEL_NODES)
+		return (1);
+	int nstrips = MB_SURFACE_MAX_STRIPS;
+	while (nstrips >= 4 && surf->block_n_columns < nstrips * MB_SURFACE_STRIP_COLUMNS)
+		nstrips -= 2;
+	if (nstrips < 4)
+		return (1);
+
+	int briggs_index = 0;
+	for (int strip = 0; strip < nstrips; strip++) {
+		struct mb_surface_strip_struct *s = &surf->strips[strip];
+		s->column_start = strip * surf->block_n_columns / nstrips;
+		s->column_end = (strip + 1) * surf->block_n_columns / nstrips;
+		s->briggs_index = briggs_index;
+		for (int i = s->column_start * surf->grid; i < s->column_end * surf->grid; i += surf->grid) {
+			const int ij = surf->ij_sw_corner + i * surf->m_rows;
+			for (int j = 0; j < surf->n_rows; j += surf->grid)
+				if (surf->iu[ij + j] > 0 && surf->iu[ij + j] < 5)
+					briggs_index++;
+		}
+	}
+	surf->nstrips = nstrips;
+	return (nstrips);
+}
+
+static void *relax_worker(void *arg) {
+	struct mb_surface_worker_struct *worker = (struct mb_surface_worker_struct *)arg;
+	struct mb_surface_struct *surf = worker->surf;
+	for (int strip = worker->first_strip; strip < surf->nstrips; strip += worker->stride) {
+		struct mb_surface_strip_struct *s = &surf->strips[strip];
+		s->max_change = relax_columns(surf, s->column_start, s->column_end, s->briggs_index);
+	}
+	return (NULL);
+}
+
+static double relax_strips(struct mb_surface_struct *surf, int nstrips) {
+	/* Red-black version of relax_columns(): the even numbered strips are
+	    relaxed, shared among the threads, then the odd numbered strips, so
+	    no strip is changed while a neighbouring strip is reading it. The
+	    nodes within a strip are relaxed in the same order as the serial
+	    sweep, and each strip sees the same neighbours whichever thread
+	    relaxes it, so the result is the same for any number of threads.
+	*/
+	const int nworkers = MIN(surf->nthreads, nstrips / 2);
+	for (int parity = 0; parity < 2; parity++) {
+		for (int w = 0; w < nworkers; w++) {
+			struct mb_surface_worker_struct *worker = &surf->workers[w];
+			worker->surf = surf;
+			worker->first_strip = parity + 2 * w;
+			worker->stride = 2 * nworkers;
+			worker->started = false;
+			if (w + 1 < nworkers)
+				worker->started = (pthread_create(&worker->thread, NULL, relax_worker, (void *)worker) == 0);
+			if (!worker->started)
+				relax_worker((void *)worker);
+		}
+		for (int w = 0; w < nworkers; w++)
+			if (surf->workers[w].started)
+				pthread_join(surf->workers[w].thread, NULL);
+	}
+
+	double max_change = -1.0;
+	for (int strip = 0; strip < nstrips; strip++)
+		if (surf->strips[strip].max_change > max_change)
+			max_change = surf->strips[strip].max_change;
+	return (max_change);
+}
+
+static int iterate(struct mb_surface_struct *surf, int mode) {
+	int kase;
 	int x_case, y_case, x_w_case, x_e_case, y_s_case, y_n_case;
 	int iteration_count = 0;
 
-	double current_limit = converge_limit / grid;
-	double change;
+	double current_limit = surf->converge_limit / surf->grid;
 	double max_change = 0.0;
-	double busum, sum_ij;
-	double b0, b1, b2, b3, b4, b5;
 
-	const double x_0_const = 4.0 * (1.0 - boundary_tension) / (2.0 - boundary_tension);
-	const double x_1_const = (3 * boundary_tension - 2.0) / (2.0 - boundary_tension);
-	const double y_denom = 2 * epsilon * (1.0 - boundary_tension) + boundary_tension;
-	const double y_0_const = 4 * epsilon * (1.0 - boundary_tension) / y_denom;
-	const double y_1_const = (boundary_tension - 2 * epsilon * (1.0 - boundary_tension)) / y_denom;
+	const double x_0_const = 4.0 * (1.0 - surf->boundary_tension) / (2.0 - surf->boundary_tension);
+	const double x_1_const = (3 * surf->boundary_tension - 2.0) / (2.0 - surf->boundary_tension);
+	const double y_denom = 2 * surf->epsilon * (1.0 - surf->boundary_tension) + surf->boundary_tension;
+	const double y_0_const = 4 * surf->epsilon * (1.0 - surf->boundary_tension) / y_denom;
+	const double y_1_const = (surf->boundary_tension - 2 * surf->epsilon * (1.0 - surf->boundary_tension)) / y_denom;
 
-	do {
-		int briggs_index = 0; /* Reset the constraint table stack pointer  */
-
-		max_change = -1.0;
+	/* Large grids are relaxed in parallel strips of block columns  */
+	const int nstrips = set_strips(surf);
 
+	do {
 		/* Fill in auxiliary boundary values (in new way) */
 
 		/* First set d2[]/dn2 = 0 along edges:  */
 		/* New experiment : (1-T)d2[]/dn2 + Td[]/dn = 0  */
 
-		for (int i = 0; i < n_columns; i += grid) {
+		for (int i = 0; i < surf->n_columns; i += surf->grid) {
 			/* set d2[]/dy2 = 0 on south side:  */
-			int ij = ij_sw_corner + i * m_rows;
+			int ij = surf->ij_sw_corner + i * surf->m_rows;
 			/* u[ij - 1] = 2 * u[ij] - u[ij + grid];  */
-			u[ij - 1] = y_0_const * u[ij] + y_1_const * u[ij + grid];
+			surf->u[ij - 1] = y_0_const * surf->u[ij] + y_1_const * surf->u[ij + surf->grid];
 			/* set d2[]/dy2 = 0 on north side:  */
-			ij = ij_nw_corner + i * m_rows;
+			ij = surf->ij_nw_corner + i * surf->m_rows;
 			/* u[ij + 1] = 2 * u[ij] - u[ij - grid];  */
-			u[ij + 1] = y_0_const * u[ij] + y_1_const * u[ij - grid];
+			surf->u[ij + 1] = y_0_const * surf->u[ij] + y_1_const * surf->u[ij - surf->grid];
 		}
 
-		for (int j = 0; j < n_rows; j += grid) {
+		for (int j = 0; j < surf->n_rows; j += surf->grid) {
 			/* set d2[]/dx2 = 0 on west side:  */
-			int ij = ij_sw_corner + j;
+			int ij = surf->ij_sw_corner + j;
 			/* u[ij - m_rows] = 2 * u[ij] - u[ij + grid_east];  */
-			u[ij - m_rows] = x_1_const * u[ij + grid_east] + x_0_const * u[ij];
+			surf->u[ij - surf->m_rows] = x_1_const * surf->u[ij + surf->grid_east] + x_0_const * surf->u[ij];
 			/* set d2[]/dx2 = 0 on east side:  */
-			ij = ij_se_corner + j;
+			ij = surf->ij_se_corner + j;
 			/* u[ij + m_rows] = 2 * u[ij] - u[ij - grid_east];  */
-			u[ij + m_rows] = x_1_const * u[ij - grid_east] + x_0_const * u[ij];
+			surf->u[ij + surf->m_rows] = x_1_const * surf->u[ij - surf->grid_east] + x_0_const * surf->u[ij];
 		}
 
 		/* Now set d2[]/dxdy = 0 at each corner:  */
-		int ij = ij_sw_corner;
-		u[ij - m_rows - 1] = u[ij + grid_east - 1] + u[ij - m_rows + grid] - u[ij + grid_east + grid];
+		int ij = surf->ij_sw_corner;
+		surf->u[ij - surf->m_rows - 1] = surf->u[ij + surf->grid_east - 1] + surf->u[ij - surf->m_rows + surf->grid] - surf->u[ij + surf->grid_east + surf->grid];
 
-		ij = ij_nw_corner;
-		u[ij - m_rows + 1] = u[ij + grid_east + 1] + u[ij - m_rows - grid] - u[ij + grid_east - grid];
+		ij = surf->ij_nw_corner;
+		surf->u[ij - surf->m_rows + 1] = surf->u[ij + surf->grid_east + 1] + surf->u[ij - surf->m_rows - surf->grid] - surf->u[ij + surf->grid_east - surf->grid];
 
-		ij = ij_se_corner;
-		u[ij + m_rows - 1] = u[ij - grid_east - 1] + u[ij + m_rows + grid] - u[ij - grid_east + grid];
+		ij = surf->ij_se_corner;
+		surf->u[ij + surf->m_rows - 1] = surf->u[ij - surf->grid_east - 1] + surf->u[ij + surf->m_rows + surf->grid] - surf->u[ij - surf->grid_east + surf->grid];
 
-		ij = ij_ne_corner;
-		u[ij + m_rows + 1] = u[ij - grid_east + 1] + u[ij + m_rows - grid] - u[ij - grid_east - grid];
+		ij = surf->ij_ne_corner;
+		surf->u[ij + surf->m_rows + 1] = surf->u[ij - surf->grid_east + 1] + surf->u[ij + surf->m_rows - surf->grid] - surf->u[ij - surf->grid_east - surf->grid];
 
 		/* Now set (1-T)dC/dn + Tdu/dn = 0 at each edge :  */
 		/* New experiment:  only dC/dn = 0  */
 
 		x_w_case = 0;
-		x_e_case = block_n_columns - 1;
-		for (int i = 0; i < n_columns; i += grid, x_w_case++, x_e_case--) {
+		x_e_case = surf->block_n_columns - 1;
+		for (int i = 0; i < surf->n_columns; i += surf->grid, x_w_case++, x_e_case--) {
 
 			if (x_w_case < 2)
 				x_case = x_w_case;
@@ -642,25 +875,25 @@ int iterate(int mode) {
 
 			/* South side :  */
 			kase = x_case * 5;
-			ij = ij_sw_corner + i * m_rows;
-			u[ij + offset[kase][11]] = (u[ij + offset[kase][0]] +
-			                            eps_m2 * (u[ij + offset[kase][1]] + u[ij + offset[kase][3]] - u[ij + offset[kase][8]] -
-			                                      u[ij + offset[kase][10]]) +
-			                            two_plus_em2 * (u[ij + offset[kase][9]] - u[ij + offset[kase][2]]));
+			ij = surf->ij_sw_corner + i * surf->m_rows;
+			surf->u[ij + surf->offset[kase][11]] = (surf->u[ij + surf->offset[kase][0]] +
+			                            surf->eps_m2 * (surf->u[ij + surf->offset[kase][1]] + surf->u[ij + surf->offset[kase][3]] - surf->u[ij + surf->offset[kase][8]] -
+			                                      surf->u[ij + surf->offset[kase][10]]) +
+			                            surf->two_plus_em2 * (surf->u[ij + surf->offset[kase][9]] - surf->u[ij + surf->offset[kase][2]]));
 			/*  + tense * eps_m2 * (u[ij + offset[kase][2]] - u[ij + offset[kase][9]]) / (1.0 - tense);  */
 			/* North side :  */
 			kase = x_case * 5 + 4;
-			ij = ij_nw_corner + i * m_rows;
-			u[ij + offset[kase][0]] = -(-u[ij + offset[kase][11]] +
-			                            eps_m2 * (u[ij + offset[kase][1]] + u[ij + offset[kase][3]] - u[ij + offset[kase][8]] -
-			                                      u[ij + offset[kase][10]]) +
-			                            two_plus_em2 * (u[ij + offset[kase][9]] - u[ij + offset[kase][2]]));
+			ij = surf->ij_nw_corner + i * surf->m_rows;
+			surf->u[ij + surf->offset[kase][0]] = -(-surf->u[ij + surf->offset[kase][11]] +
+			                            surf->eps_m2 * (surf->u[ij + surf->offset[kase][1]] + surf->u[ij + surf->offset[kase][3]] - surf->u[ij + surf->offset[kase][8]] -
+			                                      surf->u[ij + surf->offset[kase][10]]) +
+			                            surf->two_plus_em2 * (surf->u[ij + surf->offset[kase][9]] - surf->u[ij + surf->offset[kase][2]]));
 			/*  - tense * eps_m2 * (u[ij + offset[kase][2]] - u[ij + offset[kase][9]]) / (1.0 - tense);  */
 		}
 
 		y_s_case = 0;
-		y_n_case = block_n_rows - 1;
-		for (int j = 0; j < n_rows; j += grid, y_s_case++, y_n_case--) {
+		y_n_case = surf->block_n_rows - 1;
+		for (int j = 0; j < surf->n_rows; j += surf->grid, y_s_case++, y_n_case--) {
 
 			if (y_s_case < 2)
 				y_case = y_s_case;
@@ -671,149 +904,65 @@ int iterate(int mode) {
 
 			/* West side :  */
 			kase = y_case;
-			ij = ij_sw_corner + j;
-			u[ij + offset[kase][4]] = u[ij + offset[kase][7]] +
-			                          eps_p2 * (u[ij + offset[kase][3]] + u[ij + offset[kase][10]] - u[ij + offset[kase][1]] -
-			                                    u[ij + offset[kase][8]]) +
-			                          two_plus_ep2 * (u[ij + offset[kase][5]] - u[ij + offset[kase][6]]);
+			ij = surf->ij_sw_corner + j;
+			surf->u[ij + surf->offset[kase][4]] = surf->u[ij + surf->offset[kase][7]] +
+			                          surf->eps_p2 * (surf->u[ij + surf->offset[kase][3]] + surf->u[ij + surf->offset[kase][10]] - surf->u[ij + surf->offset[kase][1]] -
+			                                    surf->u[ij + surf->offset[kase][8]]) +
+			                          surf->two_plus_ep2 * (surf->u[ij + surf->offset[kase][5]] - surf->u[ij + surf->offset[kase][6]]);
 			/*  + tense * (u[ij + offset[kase][6]] - u[ij + offset[kase][5]]) / (1.0 - tense);  */
 			/* East side :  */
 			kase = 20 + y_case;
-			ij = ij_se_corner + j;
-			u[ij + offset[kase][7]] = -(-u[ij + offset[kase][4]] +
-			                            eps_p2 * (u[ij + offset[kase][3]] + u[ij + offset[kase][10]] - u[ij + offset[kase][1]] -
-			                                      u[ij + offset[kase][8]]) +
-			                            two_plus_ep2 * (u[ij + offset[kase][5]] - u[ij + offset[kase][6]]));
+			ij = surf->ij_se_corner + j;
+			surf->u[ij + surf->offset[kase][7]] = -(-surf->u[ij + surf->offset[kase][4]] +
+			                            surf->eps_p2 * (surf->u[ij + surf->offset[kase][3]] + surf->u[ij + surf->offset[kase][10]] - surf->u[ij + surf->offset[kase][1]] -
+			                                      surf->u[ij + surf->offset[kase][8]]) +
+			                            surf->two_plus_ep2 * (surf->u[ij + surf->offset[kase][5]] - surf->u[ij + surf->offset[kase][6]]));
 			/*  - tense * (u[ij + offset[kase][6]] - u[ij + offset[kase][5]]) / (1.0 - tense);  */
 		}
 
 		/* That's it for the boundary points.  Now loop over all data  */
 
-		x_w_case = 0;
-		x_e_case = block_n_columns - 1;
-		for (int i = 0; i < n_columns; i += grid, x_w_case++, x_e_case--) {
-
-			if (x_w_case < 2)
-				x_case = x_w_case;
-			else if (x_e_case < 2)
-				x_case = 4 - x_e_case;
-			else
-				x_case = 2;
-
-			y_s_case = 0;
-			y_n_case = block_n_rows - 1;
-
-			ij = ij_sw_corner + i * m_rows;
-
-			for (int j = 0; j < n_rows; j += grid, ij += grid, y_s_case++, y_n_case--) {
-
-				if (iu[ij] == 5)
-					continue; /* Point is fixed  */
-
-				if (y_s_case < 2)
-					y_case = y_s_case;
-				else if (y_n_case < 2)
-					y_case = 4 - y_n_case;
-				else
-					y_case = 2;
-
-				kase = x_case * 5 + y_case;
-				sum_ij = 0.0;
-
-				if (iu[ij] == 0) { /* Point is unconstrained  */
-					for (k = 0; k < 12; k++) {
-						sum_ij += (u[ij + offset[kase][k]] * coeff[0][k]);
-					}
-				}
-				else { /* Point is constrained  */
-
-					b0 = briggs[briggs_index].b[0];
-					b1 = briggs[briggs_index].b[1];
-					b2 = briggs[briggs_index].b[2];
-					b3 = briggs[briggs_index].b[3];
-					b4 = briggs[briggs_index].b[4];
-					b5 = briggs[briggs_index].b[5];
-					briggs_index++;
-					if (iu[ij] < 3) {
-						if (iu[ij] == 1) { /* Point is in quadrant 1  */
-							busum = b0 * u[ij + offset[kase][10]] + b1 * u[ij + offset[kase][9]] + b2 * u[ij + offset[kase][5]] +
-							        b3 * u[ij + offset[kase][1]];
-						}
-						else { /* Point is in quadrant 2  */
-							busum = b0 * u[ij + offset[kase][8]] + b1 * u[ij + offset[kase][9]] + b2 * u[ij + offset[kase][6]] +
-							        b3 * u[ij + offset[kase][3]];
-						}
-					}
-					else {
-						if (iu[ij] == 3) { /* Point is in quadrant 3  */
-							busum = b0 * u[ij + offset[kase][1]] + b1 * u[ij + offset[kase][2]] + b2 * u[ij + offset[kase][6]] +
-							        b3 * u[ij + offset[kase][10]];
-						}
-						else { /* Point is in quadrant 4  */
-							busum = b0 * u[ij + offset[kase][3]] + b1 * u[ij + offset[kase][2]] + b2 * u[ij + offset[kase][5]] +
-							        b3 * u[ij + offset[kase][8]];
-						}
-					}
-					for (k = 0; k < 12; k++) {
-						sum_ij += (u[ij + offset[kase][k]] * coeff[1][k]);
-					}
-					sum_ij = (sum_ij + a0_const_2 * (busum + b5)) / (a0_const_1 + a0_const_2 * b4);
-				}
-
-				/* New relaxation here  */
-				sum_ij = u[ij] * relax_old + sum_ij * relax_new;
-
-				if (constrained) { /* Must check limits.  Note lower/upper is v2 format and need ij_v2! */
-					ij_v2 = (n_rows - j - 1) * n_columns + i;
-					if (set_low /*&& !GMT_is_fnan((double)lower[ij_v2])*/ && sum_ij < lower[ij_v2])
-						sum_ij = lower[ij_v2];
-					else if (set_high /*&& !GMT_is_fnan((double)upper[ij_v2])*/ && sum_ij > upper[ij_v2])
-						sum_ij = upper[ij_v2];
-				}
-
-				change = fabs(sum_ij - u[ij]);
-				u[ij] = sum_ij;
-				if (change > max_change)
-					max_change = change;
-			}
-		}
+		if (nstrips > 1)
+			max_change = relax_strips(surf, nstrips);
+		else
+			max_change = relax_columns(surf, 0, surf->block_n_columns, 0);
 		iteration_count++;
-		total_iterations++;
-		max_change *= z_scale; /* Put max_change into z units  */
-		if (local_verbose > 1)
-			fprintf(stderr, "%4d\t%c\t%8d\t%10lg\t%10lg\t%10d\n", grid, mode_type[mode], iteration_count, max_change,
-			        current_limit, total_iterations);
+		surf->total_iterations++;
+		max_change *= surf->z_scale; /* Put max_change into z units  */
+		if (surf->local_verbose > 1)
+			fprintf(stderr, "%4d\t%c\t%8d\t%10lg\t%10lg\t%10d\n", surf->grid, mode_type[mode], iteration_count, max_change,
+			        current_limit, surf->total_iterations);
 
-	} while (max_change > current_limit && iteration_count < max_iterations);
+	} while (max_change > current_limit && iteration_count < surf->max_iterations);
 
-	if (local_verbose)
-		fprintf(stderr, "%4d\t%c\t%8d\t%10lg\t%10lg\t%10d\n", grid, mode_type[mode], iteration_count, max_change, current_limit,
-		        total_iterations);
+	if (surf->local_verbose)
+		fprintf(stderr, "%4d\t%c\t%8d\t%10lg\t%10lg\t%10d\n", surf->grid, mode_type[mode], iteration_count, max_change, current_limit,
+		        surf->total_iterations);
 
 	return (iteration_count);
 }
 
 
-void check_errors() {
-	const double x_0_const = 4.0 * (1.0 - boundary_tension) / (2.0 - boundary_tension);
-	const double x_1_const = (3 * boundary_tension - 2.0) / (2.0 - boundary_tension);
-	const double y_denom = 2 * epsilon * (1.0 - boundary_tension) + boundary_tension;
-	const double y_0_const = 4 * epsilon * (1.0 - boundary_tension) / y_denom;
-	const double y_1_const = (boundary_tension - 2 * epsilon * (1.0 - boundary_tension)) / y_denom;
+static void check_errors(struct mb_surface_struct *surf) {
+	const double x_0_const = 4.0 * (1.0 - surf->boundary_tension) / (2.0 - surf->boundary_tension);
+	const double x_1_const = (3 * surf->boundary_tension - 2.0) / (2.0 - surf->boundary_tension);
+	const double y_denom = 2 * surf->epsilon * (1.0 - surf->boundary_tension) + surf->boundary_tension;
+	const double y_0_const = 4 * surf->epsilon * (1.0 - surf->boundary_tension) / y_denom;
+	const double y_1_const = (surf->boundary_tension - 2 * surf->epsilon * (1.0 - surf->boundary_tension)) / y_denom;
 
 	// move_over = offset[kase][12], but grid = 1 so move_over is easy
 	const int move_over[12] = {
 		2,
-		1 - m_rows,
+		1 - surf->m_rows,
 		1,
-		1 + m_rows,
-		-2 * m_rows,
-		-m_rows,
-		m_rows,
-		2 * m_rows,
-		-1 - m_rows,
+		1 + surf->m_rows,
+		-2 * surf->m_rows,
+		-surf->m_rows,
+		surf->m_rows,
+		2 * surf->m_rows,
+		-1 - surf->m_rows,
 		-1,
-		-1 + m_rows,
+		-1 + surf->m_rows,
 		-2,
 	};
 
@@ -821,106 +970,106 @@ void check_errors() {
 	double mean_squared_error = 0.0;
 
 	/* First update the boundary values  */
-	for (int i = 0; i < n_columns; i++) {
-		int ij = ij_sw_corner + i * m_rows;
-		u[ij - 1] = y_0_const * u[ij] + y_1_const * u[ij + 1];
-		ij = ij_nw_corner + i * m_rows;
-		u[ij + 1] = y_0_const * u[ij] + y_1_const * u[ij - 1];
+	for (int i = 0; i < surf->n_columns; i++) {
+		int ij = surf->ij_sw_corner + i * surf->m_rows;
+		surf->u[ij - 1] = y_0_const * surf->u[ij] + y_1_const * surf->u[ij + 1];
+		ij = surf->ij_nw_corner + i * surf->m_rows;
+		surf->u[ij + 1] = y_0_const * surf->u[ij] + y_1_const * surf->u[ij - 1];
 	}
 
-	for (int j = 0; j < n_rows; j++) {
-		int ij = ij_sw_corner + j;
-		u[ij - m_rows] = x_1_const * u[ij + m_rows] + x_0_const * u[ij];
-		ij = ij_se_corner + j;
-		u[ij + m_rows] = x_1_const * u[ij - m_rows] + x_0_const * u[ij];
+	for (int j = 0; j < surf->n_rows; j++) {
+		int ij = surf->ij_sw_corner + j;
+		surf->u[ij - surf->m_rows] = x_1_const * surf->u[ij + surf->m_rows] + x_0_const * surf->u[ij];
+		ij = surf->ij_se_corner + j;
+		surf->u[ij + surf->m_rows] = x_1_const * surf->u[ij - surf->m_rows] + x_0_const * surf->u[ij];
 	}
 
-	int ij = ij_sw_corner;
-	u[ij - m_rows - 1] = u[ij + m_rows - 1] + u[ij - m_rows + 1] - u[ij + m_rows + 1];
-	ij = ij_nw_corner;
-	u[ij - m_rows + 1] = u[ij + m_rows + 1] + u[ij - m_rows - 1] - u[ij + m_rows - 1];
-	ij = ij_se_corner;
-	u[ij + m_rows - 1] = u[ij - m_rows - 1] + u[ij + m_rows + 1] - u[ij - m_rows + 1];
-	ij = ij_ne_corner;
-	u[ij + m_rows + 1] = u[ij - m_rows + 1] + u[ij + m_rows - 1] - u[ij - m_rows - 1];
-
-	for (int i = 0; i < n_columns; i++) {
-
-		ij = ij_sw_corner + i * m_rows;
-		u[ij + move_over[11]] =
-		    (u[ij + move_over[0]] +
-		     eps_m2 * (u[ij + move_over[1]] + u[ij + move_over[3]] - u[ij + move_over[8]] - u[ij + move_over[10]]) +
-		     two_plus_em2 * (u[ij + move_over[9]] - u[ij + move_over[2]]));
-
-		ij = ij_nw_corner + i * m_rows;
-		u[ij + move_over[0]] =
-		    -(-u[ij + move_over[11]] +
-		      eps_m2 * (u[ij + move_over[1]] + u[ij + move_over[3]] - u[ij + move_over[8]] - u[ij + move_over[10]]) +
-		      two_plus_em2 * (u[ij + move_over[9]] - u[ij + move_over[2]]));
+	int ij = surf->ij_sw_corner;
+	surf->u[ij - surf->m_rows - 1] = surf->u[ij + surf->m_rows - 1] + surf->u[ij - surf->m_rows + 1] - surf->u[ij + surf->m_rows + 1];
+	ij = surf->ij_nw_corner;
+	surf->u[ij - surf->m_rows + 1] = surf->u[ij + surf->m_rows + 1] + surf->u[ij - surf->m_rows - 1] - surf->u[ij + surf->m_rows - 1];
+	ij = surf->ij_se_corner;
+	surf->u[ij + surf->m_rows - 1] = surf->u[ij - surf->m_rows - 1] + surf->u[ij + surf->m_rows + 1] - surf->u[ij - surf->m_rows + 1];
+	ij = surf->ij_ne_corner;
+	surf->u[ij + surf->m_rows + 1] = surf->u[ij - surf->m_rows + 1] + surf->u[ij + surf->m_rows - 1] - surf->u[ij - surf->m_rows - 1];
+
+	for (int i = 0; i < surf->n_columns; i++) {
+
+		ij = surf->ij_sw_corner + i * surf->m_rows;
+		surf->u[ij + move_over[11]] =
+		    (surf->u[ij + move_over[0]] +
+		     surf->eps_m2 * (surf->u[ij + move_over[1]] + surf->u[ij + move_over[3]] - surf->u[ij + move_over[8]] - surf->u[ij + move_over[10]]) +
+		     surf->two_plus_em2 * (surf->u[ij + move_over[9]] - surf->u[ij + move_over[2]]));
+
+		ij = surf->ij_nw_corner + i * surf->m_rows;
+		surf->u[ij + move_over[0]] =
+		    -(-surf->u[ij + move_over[11]] +
+		      surf->eps_m2 * (surf->u[ij + move_over[1]] + surf->u[ij + move_over[3]] - surf->u[ij + move_over[8]] - surf->u[ij + move_over[10]]) +
+		      surf->two_plus_em2 * (surf->u[ij + move_over[9]] - surf->u[ij + move_over[2]]));
 	}
 
-	for (int j = 0; j < n_rows; j++) {
+	for (int j = 0; j < surf->n_rows; j++) {
 
-		ij = ij_sw_corner + j;
-		u[ij + move_over[4]] =
-		    u[ij + move_over[7]] +
-		    eps_p2 * (u[ij + move_over[3]] + u[ij + move_over[10]] - u[ij + move_over[1]] - u[ij + move_over[8]]) +
-		    two_plus_ep2 * (u[ij + move_over[5]] - u[ij + move_over[6]]);
+		ij = surf->ij_sw_corner + j;
+		surf->u[ij + move_over[4]] =
+		    surf->u[ij + move_over[7]] +
+		    surf->eps_p2 * (surf->u[ij + move_over[3]] + surf->u[ij + move_over[10]] - surf->u[ij + move_over[1]] - surf->u[ij + move_over[8]]) +
+		    surf->two_plus_ep2 * (surf->u[ij + move_over[5]] - surf->u[ij + move_over[6]]);
 
-		ij = ij_se_corner + j;
-		u[ij + move_over[7]] =
-		    -(-u[ij + move_over[4]] +
-		      eps_p2 * (u[ij + move_over[3]] + u[ij + move_over[10]] - u[ij + move_over[1]] - u[ij + move_over[8]]) +
-		      two_plus_ep2 * (u[ij + move_over[5]] - u[ij + move_over[6]]));
+		ij = surf->ij_se_corner + j;
+		surf->u[ij + move_over[7]] =
+		    -(-surf->u[ij + move_over[4]] +
+		      surf->eps_p2 * (surf->u[ij + move_over[3]] + surf->u[ij + move_over[10]] - surf->u[ij + move_over[1]] - surf->u[ij + move_over[8]]) +
+		      surf->two_plus_ep2 * (surf->u[ij + move_over[5]] - surf->u[ij + move_over[6]]));
 	}
 
 	/* That resets the boundary values.  Now we can test all data.
 	    Note that this loop checks all values, even though only nearest were used.  */
 
-	for (int k = 0; k < npoints; k++) {
-		int i = data[k].index / n_rows;
-		int j = data[k].index % n_rows;
-		ij = ij_sw_corner + i * m_rows + j;
-		if (iu[ij] == 5)
+	for (int k = 0; k < surf->npoints; k++) {
+		int i = surf->data[k].index / surf->n_rows;
+		int j = surf->data[k].index % surf->n_rows;
+		ij = surf->ij_sw_corner + i * surf->m_rows + j;
+		if (surf->iu[ij] == 5)
 			continue;
-		const double x0 = xmin + i * xinc;
-		const double y0 = ymin + j * yinc;
-		const double dx = (data[k].x - x0) * r_xinc;
-		const double dy = (data[k].y - y0) * r_yinc;
-
-		const double du_dx = 0.5 * (u[ij + move_over[6]] - u[ij + move_over[5]]);
-		const double du_dy = 0.5 * (u[ij + move_over[2]] - u[ij + move_over[9]]);
-		const double d2u_dx2 = u[ij + move_over[6]] + u[ij + move_over[5]] - 2 * u[ij];
-		const double d2u_dy2 = u[ij + move_over[2]] + u[ij + move_over[9]] - 2 * u[ij];
-		const double d2u_dxdy = 0.25 * (u[ij + move_over[3]] - u[ij + move_over[1]] - u[ij + move_over[10]] + u[ij + move_over[8]]);
-		const double d3u_dx3 = 0.5 * (u[ij + move_over[7]] - 2 * u[ij + move_over[6]] + 2 * u[ij + move_over[5]] - u[ij + move_over[4]]);
-		const double d3u_dy3 = 0.5 * (u[ij + move_over[0]] - 2 * u[ij + move_over[2]] + 2 * u[ij + move_over[9]] - u[ij + move_over[11]]);
-		const double d3u_dx2dy = 0.5 * ((u[ij + move_over[3]] + u[ij + move_over[1]] - 2 * u[ij + move_over[2]]) -
-		                   (u[ij + move_over[10]] + u[ij + move_over[8]] - 2 * u[ij + move_over[9]]));
-		const double d3u_dxdy2 = 0.5 * ((u[ij + move_over[3]] + u[ij + move_over[10]] - 2 * u[ij + move_over[6]]) -
-		                   (u[ij + move_over[1]] + u[ij + move_over[8]] - 2 * u[ij + move_over[5]]));
+		const double x0 = surf->xmin + i * surf->xinc;
+		const double y0 = surf->ymin + j * surf->yinc;
+		const double dx = (surf->data[k].x - x0) * surf->r_xinc;
+		const double dy = (surf->data[k].y - y0) * surf->r_yinc;
+
+		const double du_dx = 0.5 * (surf->u[ij + move_over[6]] - surf->u[ij + move_over[5]]);
+		const double du_dy = 0.5 * (surf->u[ij + move_over[2]] - surf->u[ij + move_over[9]]);
+		const double d2u_dx2 = surf->u[ij + move_over[6]] + surf->u[ij + move_over[5]] - 2 * surf->u[ij];
+		const double d2u_dy2 = surf->u[ij + move_over[2]] + surf->u[ij + move_over[9]] - 2 * surf->u[ij];
+		const double d2u_dxdy = 0.25 * (surf->u[ij + move_over[3]] - surf->u[ij + move_over[1]] - surf->u[ij + move_over[10]] + surf->u[ij + move_over[8]]);
+		const double d3u_dx3 = 0.5 * (surf->u[ij + move_over[7]] - 2 * surf->u[ij + move_over[6]] + 2 * surf->u[ij + move_over[5]] - surf->u[ij + move_over[4]]);
+		const double d3u_dy3 = 0.5 * (surf->u[ij + move_over[0]] - 2 * surf->u[ij + move_over[2]] + 2 * surf->u[ij + move_over[9]] - surf->u[ij + move_over[11]]);
+		const double d3u_dx2dy = 0.5 * ((surf->u[ij + move_over[3]] + surf->u[ij + move_over[1]] - 2 * surf->u[ij + move_over[2]]) -
+		                   (surf->u[ij + move_over[10]] + surf->u[ij + move_over[8]] - 2 * surf->u[ij + move_over[9]]));
+		const double d3u_dxdy2 = 0.5 * ((surf->u[ij + move_over[3]] + surf->u[ij + move_over[10]] - 2 * surf->u[ij + move_over[6]]) -
+		                   (surf->u[ij + move_over[1]] + surf->u[ij + move_over[8]] - 2 * surf->u[ij + move_over[5]]));
 
 		/* 3rd order Taylor approx:  */
 
-		const double z_est = u[ij] + dx * (du_dx + dx * ((0.5 * d2u_dx2) + dx * (d3u_dx3 / 6.0))) +
+		const double z_est = surf->u[ij] + dx * (du_dx + dx * ((0.5 * d2u_dx2) + dx * (d3u_dx3 / 6.0))) +
 		        dy * (du_dy + dy * ((0.5 * d2u_dy2) + dy * (d3u_dy3 / 6.0))) + dx * dy * (d2u_dxdy) + (0.5 * dx * d3u_dx2dy) +
 		        (0.5 * dy * d3u_dxdy2);
 
-		const double z_err = z_est - data[k].z;
+		const double z_err = z_est - surf->data[k].z;
 		mean_error += z_err;
 		mean_squared_error += (z_err * z_err);
 	}
-	mean_error /= npoints;
-	mean_squared_error = sqrt(mean_squared_error / npoints);
+	mean_error /= surf->npoints;
+	mean_squared_error = sqrt(mean_squared_error / surf->npoints);
 
-	const int n_nodes = n_columns * n_rows;
+	const int n_nodes = surf->n_columns * surf->n_rows;
 	double curvature = 0.0;
 
-	for (int i = 0; i < n_columns; i++) {
-		for (int j = 0; j < n_rows; j++) {
-			ij = ij_sw_corner + i * m_rows + j;
-			const double c = u[ij + move_over[6]] + u[ij + move_over[5]] + u[ij + move_over[2]] + u[ij + move_over[9]] -
-			    4.0 * u[ij + move_over[6]];
+	for (int i = 0; i < surf->n_columns; i++) {
+		for (int j = 0; j < surf->n_rows; j++) {
+			ij = surf->ij_sw_corner + i * surf->m_rows + j;
+			const double c = surf->u[ij + move_over[6]] + surf->u[ij + move_over[5]] + surf->u[ij + move_over[2]] + surf->u[ij + move_over[9]] -
+			    4.0 * surf->u[ij + move_over[6]];
 			curvature += (c * c);
 		}
 	}
@@ -930,14 +1079,14 @@ void check_errors() {
 	fprintf (stderr,"\t%8d\t%8d\t%.8lg\t%.8lg\t%.8lg\n", npoints, n_nodes, mean_error, mean_squared_error,
 	   curvature);
    */
-	if (local_verbose) {
+	if (surf->local_verbose) {
 		fprintf(stderr, "\nSpline interpolation fit information:\n");
 		fprintf(stderr, "Data points   nodes    mean error     rms error     curvature\n");
-		fprintf(stderr, "%9d %9d   %10g   %10g  %10g\n", npoints, n_nodes, mean_error, mean_squared_error, curvature);
+		fprintf(stderr, "%9d %9d   %10g   %10g  %10g\n", surf->npoints, n_nodes, mean_error, mean_squared_error, curvature);
 	}
 }
 
-int remove_planar_trend() {
+static int remove_planar_trend(struct mb_surface_struct *surf) {
 	double xx = 0.0;
 	double yy = 0.0;
 	double zz = 0.0;
@@ -950,11 +1099,11 @@ int remove_planar_trend() {
 	double syy = 0.0;
 	double syz = 0.0;
 
-	for (int i = 0; i < npoints; i++) {
+	for (int i = 0; i < surf->npoints; i++) {
 
-		xx = (data[i].x - xmin) * r_xinc;
-		yy = (data[i].y - ymin) * r_yinc;
-		zz = data[i].z;
+		xx = (surf->data[i].x - surf->xmin) * surf->r_xinc;
+		yy = (surf->data[i].y - surf->ymin) * surf->r_yinc;
+		zz = surf->data[i].z;
 
 		sx += xx;
 		sy += yy;
@@ -966,43 +1115,43 @@ int remove_planar_trend() {
 		syz += (yy * zz);
 	}
 
-	const double d = npoints * sxx * syy + 2 * sx * sy * sxy - npoints * sxy * sxy - sx * sx * syy - sy * sy * sxx;
+	const double d = surf->npoints * sxx * syy + 2 * sx * sy * sxy - surf->npoints * sxy * sxy - sx * sx * syy - sy * sy * sxx;
 
 	if (d == 0.0) {
-		plane_c0 = plane_c1 = plane_c2 = 0.0;
+		surf->plane_c0 = surf->plane_c1 = surf->plane_c2 = 0.0;
 		return (0);
 	}
 
 	const double a = sz * sxx * syy + sx * sxy * syz + sy * sxy * sxz - sz * sxy * sxy - sx * sxz * syy - sy * syz * sxx;
-	const double b = npoints * sxz * syy + sz * sy * sxy + sy * sx * syz - npoints * sxy * syz - sz * sx * syy - sy * sy * sxz;
-	const double c = npoints * sxx * syz + sx * sy * sxz + sz * sx * sxy - npoints * sxy * sxz - sx * sx * syz - sz * sy * sxx;
+	const double b = surf->npoints * sxz * syy + sz * sy * sxy + sy * sx * syz - surf->npoints * sxy * syz - sz * sx * syy - sy * sy * sxz;
+	const double c = surf->npoints * sxx * syz + sx * sy * sxz + sz * sx * sxy - surf->npoints * sxy * sxz - sx * sx * syz - sz * sy * sxx;
 
-	plane_c0 = a / d;
-	plane_c1 = b / d;
-	plane_c2 = c / d;
+	surf->plane_c0 = a / d;
+	surf->plane_c1 = b / d;
+	surf->plane_c2 = c / d;
 
-	for (int i = 0; i < npoints; i++) {
+	for (int i = 0; i < surf->npoints; i++) {
 
-		xx = (data[i].x - xmin) * r_xinc;
-		yy = (data[i].y - ymin) * r_yinc;
+		xx = (surf->data[i].x - surf->xmin) * surf->r_xinc;
+		yy = (surf->data[i].y - surf->ymin) * surf->r_yinc;
 
-		data[i].z -= (plane_c0 + plane_c1 * xx + plane_c2 * yy);
+		surf->data[i].z -= (surf->plane_c0 + surf->plane_c1 * xx + surf->plane_c2 * yy);
 	}
 
 	return (0);
 }
 
-int replace_planar_trend() {
-	for (int i = 0; i < n_columns; i++) {
-		for (int j = 0; j < n_rows; j++) {
-			const int ij = ij_sw_corner + i * m_rows + j;
-			u[ij] = (u[ij] * z_scale) + (plane_c0 + plane_c1 * i + plane_c2 * j);
+static int replace_planar_trend(struct mb_surface_struct *surf) {
+	for (int i = 0; i < surf->n_columns; i++) {
+		for (int j = 0; j < surf->n_rows; j++) {
+			const int ij = surf->ij_sw_corner + i * surf->m_rows + j;
+			surf->u[ij] = (surf->u[ij] * surf->z_scale) + (surf->plane_c0 + surf->plane_c1 * i + surf->plane_c2 * j);
 		}
 	}
 	return (0);
 }
 
-int throw_away_unusables() {
+static int throw_away_unusables(struct mb_surface_struct *surf) {
 	/* This is a new routine to eliminate data which will become
 	    unusable on the final iteration, when grid = 1.
 	    It assumes grid = 1 and set_grid_parameters has been
@@ -1013,28 +1162,29 @@ int throw_away_unusables() {
 	    of a new implementation using core memory for b[6]
 	    coefficients, eliminating calls to temp file.
 	*/
-	qsort((char *)data, npoints, sizeof(struct MB_SURFACE_DATA), (void *)compare_points);
+	set_distances(surf);
+	qsort((char *)surf->data, surf->npoints, sizeof(struct MB_SURFACE_DATA), compare_points);
 
 	/* If more than one datum is indexed to same node, only the first should be kept.
 	    Mark the additional ones as OUTSIDE
 	*/
 	int last_index = -1;
 	int n_outside = 0;
-	for (int k = 0; k < npoints; k++) {
-		if (data[k].index == last_index) {
-			data[k].index = OUTSIDE;
+	for (int k = 0; k < surf->npoints; k++) {
+		if (surf->data[k].index == last_index) {
+			surf->data[k].index = OUTSIDE;
 			n_outside++;
 		}
 		else {
-			last_index = data[k].index;
+			last_index = surf->data[k].index;
 		}
 	}
 	/* Sort again; this time the OUTSIDE points will be thrown away  */
-	qsort((char *)data, npoints, sizeof(struct MB_SURFACE_DATA), (void *)compare_points);
-	npoints -= n_outside;
-	status =
-	    mb_reallocd(local_verbose, __FILE__, __LINE__, npoints * sizeof(struct MB_SURFACE_DATA), (void **)&data, &local_error);
-	if (local_verbose && (n_outside)) {
+	qsort((char *)surf->data, surf->npoints, sizeof(struct MB_SURFACE_DATA), compare_points);
+	surf->npoints -= n_outside;
+	surf->status =
+	    mb_reallocd(surf->local_verbose, __FILE__, __LINE__, surf->npoints * sizeof(struct MB_SURFACE_DATA), (void **)&surf->data, &surf->local_error);
+	if (surf->local_verbose && (n_outside)) {
 		fprintf(stderr, "surface: %d unusable points were supplied; these will be ignored.\n", n_outside);
 		fprintf(stderr, "\tYou should have pre-processed the data with blockmean or blockmedian.\n");
 	}
@@ -1042,36 +1192,36 @@ int throw_away_unusables() {
 	return (0);
 }
 
-int rescale_z_values() {
+static int rescale_z_values(struct mb_surface_struct *surf) {
 	double ssz = 0.0;
 
-	for (int i = 0; i < npoints; i++) {
-		ssz += (data[i].z * data[i].z);
+	for (int i = 0; i < surf->npoints; i++) {
+		ssz += (surf->data[i].z * surf->data[i].z);
 	}
 
 	/* Set z_scale = rms(z):  */
 
-	z_scale = sqrt(ssz / npoints);
-	r_z_scale = 1.0 / z_scale;
+	surf->z_scale = sqrt(ssz / surf->npoints);
+	surf->r_z_scale = 1.0 / surf->z_scale;
 
-	for (int i = 0; i < npoints; i++) {
-		data[i].z *= r_z_scale;
+	for (int i = 0; i < surf->npoints; i++) {
+		surf->data[i].z *= surf->r_z_scale;
 	}
 	return (0);
 }
 
-void load_constraints(char *low, char *high) {
+static void load_constraints(struct mb_surface_struct *surf, char *low, char *high) {
 	(void)low;  // Unused parameter
 	(void)high;  // Unused parameter
 	/*	struct GRD_HEADER hdr;*/
 
 	/* Load lower/upper limits, verify range, deplane, and rescale */
 
-	if (set_low > 0) {
-		status = mb_mallocd(local_verbose, __FILE__, __LINE__, n_columns * n_rows * sizeof(float), (void **)&lower, &local_error);
-		if (set_low < 3)
-			for (int i = 0; i < n_columns * n_rows; i++)
-				lower[i] = low_limit;
+	if (surf->set_low > 0) {
+		surf->status = mb_mallocd(surf->local_verbose, __FILE__, __LINE__, surf->n_columns * surf->n_rows * sizeof(float), (void **)&surf->lower, &surf->local_error);
+		if (surf->set_low < 3)
+			for (int i = 0; i < surf->n_columns * surf->n_rows; i++)
+				surf->lower[i] = surf->low_limit;
 		/* Comment this out:
 		        else {
 		            if (read_grd_info (low, &hdr)) {
@@ -1095,21 +1245,21 @@ void load_constraints(char *low, char *high) {
 		        }
 		*/
 
-		for (int j = 0, ij = 0; j < n_rows; j++) {
-			int iyy = n_rows - j - 1;
-			for (int i = 0; i < n_columns; i++, ij++) {
+		for (int j = 0, ij = 0; j < surf->n_rows; j++) {
+			int iyy = surf->n_rows - j - 1;
+			for (int i = 0; i < surf->n_columns; i++, ij++) {
 				/*if (GMT_is_fnan ((double)lower[ij])) continue;*/
-				lower[ij] -= (plane_c0 + plane_c1 * i + plane_c2 * iyy);
-				lower[ij] *= r_z_scale;
+				surf->lower[ij] -= (surf->plane_c0 + surf->plane_c1 * i + surf->plane_c2 * iyy);
+				surf->lower[ij] *= surf->r_z_scale;
 			}
 		}
-		constrained = TRUE;
+		surf->constrained = TRUE;
 	}
-	if (set_high > 0) {
-		status = mb_mallocd(local_verbose, __FILE__, __LINE__, n_columns * n_rows * sizeof(float), (void **)&upper, &local_error);
-		if (set_high < 3)
-			for (int i = 0; i < n_columns * n_rows; i++)
-				upper[i] = high_limit;
+	if (surf->set_high > 0) {
+		surf->status = mb_mallocd(surf->local_verbose, __FILE__, __LINE__, surf->n_columns * surf->n_rows * sizeof(float), (void **)&surf->upper, &surf->local_error);
+		if (surf->set_high < 3)
+			for (int i = 0; i < surf->n_columns * surf->n_rows; i++)
+				surf->upper[i] = surf->high_limit;
 		/* Comment this out:
 		        else {
 		            if (read_grd_info (high, &hdr)) {
@@ -1132,19 +1282,19 @@ void load_constraints(char *low, char *high) {
 		            if (n_trimmed) fprintf (stderr, "surface: %d upper limit values < max data, reset to max data!\n");
 		        }
 		*/
-		for (int j = 0, ij = 0; j < n_rows; j++) {
-			int iyy = n_rows - j - 1;
-			for (int i = 0; i < n_columns; i++, ij++) {
+		for (int j = 0, ij = 0; j < surf->n_rows; j++) {
+			int iyy = surf->n_rows - j - 1;
+			for (int i = 0; i < surf->n_columns; i++, ij++) {
 				/*if (GMT_is_fnan ((double)upper[ij])) continue;*/
-				upper[ij] -= (plane_c0 + plane_c1 * i + plane_c2 * iyy);
-				upper[ij] *= r_z_scale;
+				surf->upper[ij] -= (surf->plane_c0 + surf->plane_c1 * i + surf->plane_c2 * iyy);
+				surf->upper[ij] *= surf->r_z_scale;
 			}
 		}
-		constrained = TRUE;
+		surf->constrained = TRUE;
 	}
 }
 
-int get_prime_factors(int n, int f[]) {
+static int get_prime_factors(int n, int f[]) {
 	/* Fills the integer array f with the prime factors of n.
 	 * Returns the number of locations filled in f, which is
 	 * one if n is prime.
@@ -1260,7 +1410,7 @@ int get_prime_factors(int n, int f[]) {
 // #define IABS(i) (((i) < 0) ? -(i) : (i))
 static int IABS(int i) {return i < 0 ? -i : i;}
 
-int gcd_euclid(int a, int b) {
+static int gcd_euclid(int a, int b) {
 	/* Returns the greatest common divisor of u and v by Euclid's method.
 	 * I have experimented also with Stein's method, which involves only
 	 * subtraction and left/right shifting; Euclid is faster, both for
@@ -1281,158 +1431,265 @@ int gcd_euclid(int a, int b) {
 	return (u);
 }
 
-int mb_surface(int verbose, int ndat, float *xdat, float *ydat, float *zdat, double xxmin, double xxmax, double yymin,
-               double yymax, double xxinc, double yyinc, double ttension, float *sgrid) {
+int mb_surface_init(int verbose, int nthreads, void **surface_ptr, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       nthreads:   %d\n", nthreads);
+	}
+
+	if (nthreads < 1)
+		nthreads = 1;
+
+	/* allocate and initialize the surface context */
+	int status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mb_surface_struct), (void **)surface_ptr, error);
+	if (status == MB_SUCCESS) {
+		struct mb_surface_struct *surf = (struct mb_surface_struct *)*surface_ptr;
+		memset(surf, 0, sizeof(struct mb_surface_struct));
+		surf->nthreads = nthreads;
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nthreads * sizeof(struct mb_surface_worker_struct),
+		                    (void **)&surf->workers, error);
+		if (status == MB_SUCCESS) {
+			memset(surf->workers, 0, nthreads * sizeof(struct mb_surface_worker_struct));
+		}
+		else {
+			int local_error = MB_ERROR_NO_ERROR;
+			mb_freed(verbose, __FILE__, __LINE__, (void **)surface_ptr, &local_error);
+		}
+	}
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       surface_ptr:%p\n", (void *)*surface_ptr);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	return (status);
+}
+
+int mb_surface_grid(int verbose, void *surface_ptr, int ndat, float *xdat, float *ydat, float *zdat, double xxmin,
+                    double xxmax, double yymin, double yymax, double xxinc, double yyinc, double ttension, float *sgrid,
+                    int *error) {
 	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBBA function <%s> called\n", __func__);
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       surface_ptr:%p\n", surface_ptr);
 		fprintf(stderr, "dbg2       xxmin:      %f\n", xxmin);
 		fprintf(stderr, "dbg2       xxmax:      %f\n", xxmax);
 		fprintf(stderr, "dbg2       yymin:      %f\n", yymin);
 		fprintf(stderr, "dbg2       yymax:      %f\n", yymax);
 		fprintf(stderr, "dbg2       xxinc:      %f\n", xxinc);
-		fprintf(stderr, "dbg2       xxinc:      %f\n", xxinc);
+		fprintf(stderr, "dbg2       yyinc:      %f\n", yyinc);
 		fprintf(stderr, "dbg2       ttension:   %f\n", ttension);
 		fprintf(stderr, "dbg2       ndat:       %d\n", ndat);
 		for (int i = 0; i < ndat; i++)
 			fprintf(stderr, "dbg2       data:       %f %f %f\n", xdat[i], ydat[i], zdat[i]);
 	}
 
+	struct mb_surface_struct *surf = (struct mb_surface_struct *)surface_ptr;
+
 	/* copy parameters */
-	xmin = xxmin;
-	xmax = xxmax;
-	ymin = yymin;
-	ymax = yymax;
-	xinc = xxinc;
-	yinc = yyinc;
-	tension = ttension;
-	total_iterations = 0;
+	surf->xmin = xxmin;
+	surf->xmax = xxmax;
+	surf->ymin = yymin;
+	surf->ymax = yymax;
+	surf->xinc = xxinc;
+	surf->yinc = yyinc;
+	surf->tension = ttension;
+	surf->total_iterations = 0;
 
 	/* set local verbose */
 	if (verbose > 0)
-		local_verbose = TRUE;
+		surf->local_verbose = TRUE;
 	else
-		local_verbose = FALSE;
+		surf->local_verbose = FALSE;
+	surf->local_error = MB_ERROR_NO_ERROR;
+	surf->status = MB_SUCCESS;
+
+	/* reset the solution parameters to their defaults */
+	surf->max_iterations = 250;
+	surf->converge_limit = 0.0;
+	surf->radius = 0.0;
+	surf->epsilon = 1.0;
+	surf->z_scale = 1.0;
+	surf->r_z_scale = 1.0;
+	surf->relax_new = 1.4;
+	surf->boundary_tension = 0.0;
+	surf->interior_tension = 0.0;
+	surf->constrained = FALSE;
+	surf->data = NULL;
+	surf->briggs = NULL;
+	surf->iu = NULL;
+	surf->u = NULL;
+	surf->lower = NULL;
+	surf->upper = NULL;
 
 	/* New in v4.3:  Default to unconstrained:  */
-	set_low = set_high = 0;
-
-	// bool serror = false;
-	// if (xmin >= xmax || ymin >= ymax)
-	// 	serror = true;
-	// if (xinc <= 0.0 || yinc <= 0.0)
-	// 	serror = true;
+	surf->set_low = surf->set_high = 0;
 
-	if (tension != 0.0) {
-		boundary_tension = tension;
-		interior_tension = tension;
+	if (surf->tension != 0.0) {
+		surf->boundary_tension = surf->tension;
+		surf->interior_tension = surf->tension;
 	}
-	relax_old = 1.0 - relax_new;
+	surf->relax_old = 1.0 - surf->relax_new;
 
-	n_columns = rint((xmax - xmin) / xinc) + 1;
-	n_rows = rint((ymax - ymin) / yinc) + 1;
-	m_columns = n_columns + 4;
-	m_rows = n_rows + 4;
-	r_xinc = 1.0 / xinc;
-	r_yinc = 1.0 / yinc;
-
-	/* New stuff here for v4.3:  Check out the grid dimensions:  */
-	grid = gcd_euclid(n_columns - 1, n_rows - 1);
-
-	/*
-	if (local_verbose || size_query || grid == 1) fprintf (stderr, "W: %.3lf E: %.3lf S: %.3lf N: %.3lf n_columns: %d n_rows: %d\n",
-	    xmin, xmax, ymin, ymax, n_columns, n_rows);
-	if (grid == 1) fprintf(stderr,"surface:  WARNING:  Your grid dimensions are mutually prime.\n");
-	if (grid == 1 || size_query) suggest_sizes_for_surface(n_columns-1, n_rows-1);
-	if (size_query) exit(0);
-	*/
+	surf->n_columns = rint((surf->xmax - surf->xmin) / surf->xinc) + 1;
+	surf->n_rows = rint((surf->ymax - surf->ymin) / surf->yinc) + 1;
+	surf->m_columns = surf->n_columns + 4;
+	surf->m_rows = surf->n_rows + 4;
+	surf->r_xinc = 1.0 / surf->xinc;
+	surf->r_yinc = 1.0 / surf->yinc;
 
 	/* New idea: set grid = 1, read data, setting index.  Then throw
 	    away data that can't be used in end game, constraining
 	    size of briggs->b[6] structure.  */
 
-	grid = 1;
-	set_grid_parameters();
-	read_data(ndat, xdat, ydat, zdat);
-	throw_away_unusables();
-	remove_planar_trend();
-	rescale_z_values();
-
-	char low[100];
-	char high[100];
-	load_constraints(low, high);
-
-	/* Set up factors and reset grid to first value  */
-
-	grid = gcd_euclid(n_columns - 1, n_rows - 1);
-	n_fact = get_prime_factors(grid, factors);
-	set_grid_parameters();
-	while (block_n_columns < 4 || block_n_rows < 4) {
-		smart_divide();
-		set_grid_parameters();
+	surf->grid = 1;
+	set_grid_parameters(surf);
+	read_data(surf, ndat, xdat, ydat, zdat);
+	if (surf->status == MB_SUCCESS) {
+		throw_away_unusables(surf);
+		remove_planar_trend(surf);
+		rescale_z_values(surf);
+
+		char low[100];
+		char high[100];
+		load_constraints(surf, low, high);
+
+		/* Set up factors and reset grid to first value  */
+
+		surf->grid = gcd_euclid(surf->n_columns - 1, surf->n_rows - 1);
+		surf->n_fact = get_prime_factors(surf->grid, surf->factors);
+		set_grid_parameters(surf);
+		while (surf->block_n_columns < 4 || surf->block_n_rows < 4) {
+			smart_divide(surf);
+			set_grid_parameters(surf);
+		}
+		set_offset(surf);
+		set_index(surf);
+		/* Now the data are ready to go for the first iteration.  */
+
+		/* Allocate more space  */
+
+		surf->status = mb_mallocd(surf->local_verbose, __FILE__, __LINE__, surf->npoints * sizeof(struct MB_SURFACE_BRIGGS),
+		                          (void **)&surf->briggs, &surf->local_error);
+		if (surf->status == MB_SUCCESS)
+			surf->status = mb_mallocd(surf->local_verbose, __FILE__, __LINE__, surf->m_columns * surf->m_rows * sizeof(char),
+			                          (void **)&surf->iu, &surf->local_error);
+		if (surf->status == MB_SUCCESS)
+			surf->status = mb_mallocd(surf->local_verbose, __FILE__, __LINE__, surf->m_columns * surf->m_rows * sizeof(float),
+			                          (void **)&surf->u, &surf->local_error);
 	}
-	set_offset();
-	set_index();
-	/* Now the data are ready to go for the first iteration.  */
 
-	/* Allocate more space  */
+	if (surf->status == MB_SUCCESS) {
+		/* start from a zero surface rather than whatever the allocator returned,
+		    so that repeated calls give the same result  */
+		memset(surf->iu, 0, surf->m_columns * surf->m_rows * sizeof(char));
+		memset(surf->u, 0, surf->m_columns * surf->m_rows * sizeof(float));
+
+		if (surf->radius > 0)
+			initialize_grid(surf); /* Fill in nodes with a weighted avg in a search radius  */
+
+		set_coefficients(surf);
+
+		surf->old_grid = surf->grid;
+		find_nearest_point(surf);
+		iterate(surf, 1);
+
+		while (surf->grid > 1) {
+			smart_divide(surf);
+			set_grid_parameters(surf);
+			set_offset(surf);
+			set_index(surf);
+			fill_in_forecast(surf);
+			iterate(surf, 0);
+			surf->old_grid = surf->grid;
+			find_nearest_point(surf);
+			iterate(surf, 1);
+		}
 
-	status =
-	    mb_mallocd(local_verbose, __FILE__, __LINE__, npoints * sizeof(struct MB_SURFACE_BRIGGS), (void **)&briggs, &local_error);
-	status = mb_mallocd(local_verbose, __FILE__, __LINE__, m_columns * m_rows * sizeof(char), (void **)&iu, &local_error);
-	status = mb_mallocd(local_verbose, __FILE__, __LINE__, m_columns * m_rows * sizeof(float), (void **)&u, &local_error);
+		if (surf->local_verbose)
+			check_errors(surf);
 
-	if (radius > 0)
-		initialize_grid(); /* Fill in nodes with a weighted avg in a search radius  */
+		replace_planar_trend(surf);
 
-	/*
-	if (local_verbose) fprintf(stderr,"Grid\tMode\tIteration\tMax Change\tConv Limit\tTotal Iterations\n");
-	*/
-
-	set_coefficients();
-
-	old_grid = grid;
-	find_nearest_point();
-	iterate(1);
-
-	while (grid > 1) {
-		smart_divide();
-		set_grid_parameters();
-		set_offset();
-		set_index();
-		fill_in_forecast();
-		iterate(0);
-		old_grid = grid;
-		find_nearest_point();
-		iterate(1);
+		get_output(surf, sgrid);
 	}
 
-	if (local_verbose)
-		check_errors();
+	/* release the working arrays, keeping the first error encountered */
+	int local_error = MB_ERROR_NO_ERROR;
+	if (surf->data != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&surf->data, &local_error);
+	if (surf->briggs != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&surf->briggs, &local_error);
+	if (surf->iu != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&surf->iu, &local_error);
+	if (surf->u != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&surf->u, &local_error);
+	if (surf->lower != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&surf->lower, &local_error);
+	if (surf->upper != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&surf->upper, &local_error);
+
+	const int status = surf->status;
+	*error = surf->local_error;
 
-	replace_planar_trend();
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		if (status == MB_SUCCESS)
+			for (int i = 0; i < surf->n_columns * surf->n_rows; i++)
+				fprintf(stderr, "dbg2       grid:       %d %f\n", i, sgrid[i]);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
 
-	get_output(sgrid);
+	return (status);
+}
 
-	status = mb_freed(verbose, __FILE__, __LINE__, (void **)&data, &local_error);
-	status = mb_freed(verbose, __FILE__, __LINE__, (void **)&briggs, &local_error);
-	status = mb_freed(verbose, __FILE__, __LINE__, (void **)&iu, &local_error);
-	status = mb_freed(verbose, __FILE__, __LINE__, (void **)&u, &local_error);
-	if (set_low)
-		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&lower, &local_error);
-	if (set_high)
-		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&upper, &local_error);
+int mb_surface_deall(int verbose, void **surface_ptr, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       surface_ptr:%p\n", (void *)*surface_ptr);
+	}
+
+	int status = MB_SUCCESS;
+	if (*surface_ptr != NULL) {
+		struct mb_surface_struct *surf = (struct mb_surface_struct *)*surface_ptr;
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&surf->workers, error);
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)surface_ptr, error);
+	}
 
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       error:      %d\n", local_error);
-		for (int i = 0; i < m_columns * m_rows; i++)
-			fprintf(stderr, "dbg2       grid:       %d %f\n", i, sgrid[i]);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	return (status);
 }
+
+int mb_surface(int verbose, int ndat, float *xdat, float *ydat, float *zdat, double xxmin, double xxmax, double yymin,
+               double yymax, double xxinc, double yyinc, double ttension, float *sgrid) {
+	/* single threaded convenience wrapper around the surface context functions */
+	int error = MB_ERROR_NO_ERROR;
+	void *surface_ptr = NULL;
+	int status = mb_surface_init(verbose, 1, &surface_ptr, &error);
+	if (status == MB_SUCCESS) {
+		status = mb_surface_grid(verbose, surface_ptr, ndat, xdat, ydat, zdat, xxmin, xxmax, yymin, yymax, xxinc, yyinc,
+		                         ttension, sgrid, &error);
+		int local_error = MB_ERROR_NO_ERROR;
+		mb_surface_deall(verbose, &surface_ptr, &local_error);
+	}
+	return (status);
+}
@@ -1128,9 +1128,23 @@ int mbeditviz_load_file(int ifile, bool assertLock) {
         }
       }
 
-      /* attempt to load bathymetry edits */
-      mbev_status = mb_esf_load(mbev_verbose, program_name, file->path, true, MBP_ESF_NOWRITE, file->esffile,
-                                &(file->esf), &mbev_error);
+      /* attempt to load the bathymetry edits within the time span of the pings -
+          for a compacted esf file only the edits in that window are read */
+      int esf_found = false;
+      mbev_status = mb_esf_check(mbev_verbose, file->path, file->esffile, &esf_found, &mbev_error);
+      if (esf_found && file->num_pings > 0) {
+        double time_d_min = file->pings[0].time_d;
+        double time_d_max = file->pings[0].time_d;
+        for (iping = 1; iping < file->num_pings; iping++) {
+          time_d_min = MIN(time_d_min, file->pings[iping].time_d);
+          time_d_max = MAX(time_d_max, file->pings[iping].time_d);
+        }
+        mbev_status = mb_esf_open_window(mbev_verbose, program_name, file->esffile, time_d_min, time_d_max,
+                                         &(file->esf), &mbev_error);
+      }
+      else {
+        mbev_status = MB_FAILURE;
+      }
       if (mbev_status == MB_SUCCESS) {
         file->esf_open = true;
         mbev_num_esf_open++;
@@ -2568,6 +2582,19 @@ int mbeditviz_setup_grid() {
   return (mbev_status);
 }
 
+/*--------------------------------------------------------------------*/
+/* project all of the soundings of a ping into the grid projection
+    with a single call to PROJ - soundings that cannot be projected
+    are set to HUGE_VAL */
+static void mbeditviz_project_ping(struct mbev_ping_struct *ping) {
+  for (int ibeam = 0; ibeam < ping->beams_bath; ibeam++) {
+    ping->bathx[ibeam] = ping->bathlon[ibeam];
+    ping->bathy[ibeam] = ping->bathlat[ibeam];
+  }
+  int error = MB_ERROR_NO_ERROR;
+  mb_proj_forward_array(mbev_verbose, mbev_grid.pjptr, ping->beams_bath, ping->bathx, ping->bathy, &error);
+}
+
 /*--------------------------------------------------------------------*/
 int mbeditviz_project_soundings() {
   if (mbev_verbose >= 2) {
@@ -2589,12 +2616,7 @@ int mbeditviz_project_soundings() {
           struct mbev_ping_struct *ping = &(file->pings[iping]);
           mb_proj_forward(mbev_verbose, mbev_grid.pjptr, ping->navlon, ping->navlat, &ping->navlonx, &ping->navlaty,
                           &mbev_error);
-          for (int ibeam = 0; ibeam < ping->beams_bath; ibeam++) {
-            if (!mb_beam_check_flag_unusable(ping->beamflag[ibeam])) {
-              mb_proj_forward(mbev_verbose, mbev_grid.pjptr, ping->bathlon[ibeam], ping->bathlat[ibeam],
-                              &ping->bathx[ibeam], &ping->bathy[ibeam], &mbev_error);
-            }
-          }
+          mbeditviz_project_ping(ping);
         }
       }
     }
@@ -3134,11 +3156,8 @@ int mbeditviz_make_grid_simple() {
         (*showMessage)(message);
         for (iping = 0; iping < file->num_pings; iping++) {
           struct mbev_ping_struct *ping = &(file->pings[iping]);
+          mbeditviz_project_ping(ping);
           for (ibeam = 0; ibeam < ping->beams_bath; ibeam++) {
-            if (!mb_beam_check_flag_unusable(ping->beamflag[ibeam])) {
-              mb_proj_forward(mbev_verbose, mbev_grid.pjptr, ping->bathlon[ibeam], ping->bathlat[ibeam],
-                              &ping->bathx[ibeam], &ping->bathy[ibeam], &mbev_error);
-            }
             if (mb_beam_ok(ping->beamflag[ibeam])) {
               const int i = (ping->bathx[ibeam] - mbev_grid.boundsutm[0] + 0.5 * mbev_grid.dx) / mbev_grid.dx;
               const int j = (ping->bathy[ibeam] - mbev_grid.boundsutm[2] + 0.5 * mbev_grid.dy) / mbev_grid.dy;
@@ -294,7 +294,15 @@ int mb_sonartype(int verbose, void *mbio_ptr, void *store_ptr, int *sonartype, i
           mb_io_ptr->system == MB_SYS_HDCS
           mb_io_ptr->system == MB_SYS_HYSWEEP */
   int status = MB_SUCCESS;
-  if (mb_io_ptr->mb_io_sonartype != NULL) {
+
+  /* pings returned from a ping cache leave the data store empty, so the
+      sonar type kept with the ping in the cache is used */
+  if (mb_io_ptr->pingcache != NULL && (store_ptr == NULL || store_ptr == mb_io_ptr->store_data) &&
+      mb_pingcache_sonartype(verbose, mbio_ptr, sonartype, error) == MB_SUCCESS) {
+    status = MB_SUCCESS;
+  }
+
+  else if (mb_io_ptr->mb_io_sonartype != NULL) {
     if (store_ptr == NULL)
       store_ptr = (void *)mb_io_ptr->store_data;
     status = (*mb_io_ptr->mb_io_sonartype)(verbose, mbio_ptr, store_ptr, sonartype, error);
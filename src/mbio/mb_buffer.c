@@ -44,6 +44,12 @@
  *   mb_buffer_insert_nav - insert altered navigation into
  *   				record in buffer
  *
+ * The buffer holds its records in a ring that grows as needed, so
+ * there is no fixed limit on the number of records held. The data
+ * storage structures of dumped or cleared records are kept on a spare
+ * list and reused by later loads rather than being deallocated and
+ * allocated again for every record.
+ *
  * Author:	D. W. Caress
  * Date:	February 25, 1993
  */
@@ -58,6 +64,103 @@
 #include "mb_io.h"
 #include "mb_status.h"
 
+/* ring index of buffer record i */
+#define MB_BUFFER_INDEX(buff, i) (((buff)->ifirst + (i)) % (buff)->nalloc)
+
+/*--------------------------------------------------------------------*/
+/* get a data storage structure for a new buffer record, reusing one
+    from the spare list if possible */
+static int mb_buffer_store_get(int verbose, struct mb_buffer_struct *buff, void *mbio_ptr, void **store_ptr, int *error) {
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* spare structures can only be reused for the same format */
+	int status = MB_SUCCESS;
+	if (buff->nspare > 0 && buff->spare_format != mb_io_ptr->format) {
+		for (int i = 0; i < buff->nspare; i++)
+			status &= mb_deall(verbose, mbio_ptr, &buff->spare[i], error);
+		buff->nspare = 0;
+	}
+
+	if (buff->nspare > 0) {
+		buff->nspare--;
+		*store_ptr = buff->spare[buff->nspare];
+		buff->spare[buff->nspare] = NULL;
+		*error = MB_ERROR_NO_ERROR;
+		status = MB_SUCCESS;
+	}
+	else {
+		status = mb_alloc(verbose, mbio_ptr, store_ptr, error);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+/* put the data storage structure of a dumped buffer record on the spare list */
+static int mb_buffer_store_release(int verbose, struct mb_buffer_struct *buff, void *mbio_ptr, void **store_ptr, int *error) {
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	int status = MB_SUCCESS;
+	if (*store_ptr == NULL)
+		return (status);
+	if (buff->nspare > 0 && buff->spare_format != mb_io_ptr->format) {
+		for (int i = 0; i < buff->nspare; i++)
+			status &= mb_deall(verbose, mbio_ptr, &buff->spare[i], error);
+		buff->nspare = 0;
+	}
+	if (buff->nspare >= buff->nspare_alloc) {
+		buff->nspare_alloc += MB_BUFFER_ALLOC_STEP;
+		status = mb_reallocd(verbose, __FILE__, __LINE__, buff->nspare_alloc * sizeof(void *), (void **)&buff->spare, error);
+		if (status != MB_SUCCESS) {
+			buff->nspare_alloc = 0;
+			buff->nspare = 0;
+			return (mb_deall(verbose, mbio_ptr, store_ptr, error));
+		}
+	}
+	buff->spare[buff->nspare] = *store_ptr;
+	buff->nspare++;
+	buff->spare_format = mb_io_ptr->format;
+	*store_ptr = NULL;
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+/* make sure the ring can hold one more record, reordering the records
+    to start at the beginning of the ring when it is enlarged */
+static int mb_buffer_grow(int verbose, struct mb_buffer_struct *buff, int *error) {
+	int status = MB_SUCCESS;
+	if (buff->nbuffer < buff->nalloc)
+		return (status);
+
+	const int nalloc = buff->nalloc > 0 ? 2 * buff->nalloc : MB_BUFFER_ALLOC_STEP;
+	void **buffer = NULL;
+	int *buffer_kind = NULL;
+	status = mb_mallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(void *), (void **)&buffer, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(int), (void **)&buffer_kind, error);
+	if (status != MB_SUCCESS) {
+		int free_error = MB_ERROR_NO_ERROR;
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&buffer, &free_error);
+		return (status);
+	}
+	for (int i = 0; i < nalloc; i++) {
+		if (i < buff->nbuffer) {
+			buffer[i] = buff->buffer[(buff->ifirst + i) % buff->nalloc];
+			buffer_kind[i] = buff->buffer_kind[(buff->ifirst + i) % buff->nalloc];
+		}
+		else {
+			buffer[i] = NULL;
+			buffer_kind[i] = 0;
+		}
+	}
+	mb_freed(verbose, __FILE__, __LINE__, (void **)&buff->buffer, error);
+	mb_freed(verbose, __FILE__, __LINE__, (void **)&buff->buffer_kind, error);
+	buff->buffer = buffer;
+	buff->buffer_kind = buffer_kind;
+	buff->nalloc = nalloc;
+	buff->ifirst = 0;
+
+	return (status);
+}
 /*--------------------------------------------------------------------*/
 int mb_buffer_init(int verbose, void **buff_ptr, int *error) {
 	if (verbose >= 2) {
@@ -70,10 +173,18 @@ int mb_buffer_init(int verbose, void **buff_ptr, int *error) {
 	const int status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mb_buffer_struct), buff_ptr, error);
 	struct mb_buffer_struct *buff = (struct mb_buffer_struct *)*buff_ptr;
 
-	/* set nbuffer to zero */
-	buff->nbuffer = 0;
-	for (int i = 0; i < MB_BUFFER_MAX; i++)
-		buff->buffer[i] = NULL;
+	/* set nbuffer to zero - the ring and spare list are allocated as needed */
+	if (status == MB_SUCCESS) {
+		buff->buffer = NULL;
+		buff->buffer_kind = NULL;
+		buff->nbuffer = 0;
+		buff->ifirst = 0;
+		buff->nalloc = 0;
+		buff->spare = NULL;
+		buff->nspare = 0;
+		buff->nspare_alloc = 0;
+		buff->spare_format = 0;
+	}
 
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
@@ -105,13 +216,20 @@ int mb_buffer_close(int verbose, void **buff_ptr, void *mbio_ptr, int *error) {
 		if (verbose >= 4) {
 			fprintf(stderr, "\ndbg4  Remaining records in buffer: %d\n", buff->nbuffer);
 			for (int i = 0; i < buff->nbuffer; i++)
-				fprintf(stderr, "dbg4       Record[%d] pointer: %p\n", i, (void *)(buff->buffer[i]));
+				fprintf(stderr, "dbg4       Record[%d] pointer: %p\n", i, (void *)(buff->buffer[MB_BUFFER_INDEX(buff, i)]));
 		}
 		for (int i = 0; i < buff->nbuffer; i++)
-			status = mb_deall(verbose, mbio_ptr, &buff->buffer[i], error);
+			status = mb_deall(verbose, mbio_ptr, &buff->buffer[MB_BUFFER_INDEX(buff, i)], error);
 	}
 
+	/* deallocate the spare data structures */
+	for (int i = 0; i < buff->nspare; i++)
+		status &= mb_deall(verbose, mbio_ptr, &buff->spare[i], error);
+
 	/* deallocate memory for data structure */
+	status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&buff->buffer, error);
+	status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&buff->buffer_kind, error);
+	status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&buff->spare, error);
 	status &= mb_freed(verbose, __FILE__, __LINE__, (void **)buff_ptr, error);
 
 	if (verbose >= 2) {
@@ -142,10 +260,8 @@ int mb_buffer_load(int verbose, void *buff_ptr, void *mbio_ptr, int nwant, int *
 	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 	char *store_ptr = mb_io_ptr->store_data;
 
-	/* can't get more than the buffer will hold */
-	int nget = nwant - buff->nbuffer;
-	if (buff->nbuffer + nget > MB_BUFFER_MAX)
-		nget = MB_BUFFER_MAX - buff->nbuffer;
+	/* the buffer grows as needed so get all of the records wanted */
+	const int nget = nwant - buff->nbuffer;
 	*nload = 0;
 	*error = MB_ERROR_NO_ERROR;
 
@@ -187,12 +303,22 @@ int mb_buffer_load(int verbose, void *buff_ptr, void *mbio_ptr, int nwant, int *
 		/* deal with good data */
 		if (*error == MB_ERROR_NO_ERROR && store_ptr != NULL) {
 
-			/* allocate space and copy the data */
-			status = mb_alloc(verbose, mbio_ptr, &buff->buffer[buff->nbuffer], error);
+			/* get space and copy the data */
+			void *buffer_store = NULL;
+			status = mb_buffer_grow(verbose, buff, error);
 			if (status == MB_SUCCESS)
-				status = mb_copyrecord(verbose, mbio_ptr, store_ptr, buff->buffer[buff->nbuffer], error);
+				status = mb_buffer_store_get(verbose, buff, mbio_ptr, &buffer_store, error);
+			if (status == MB_SUCCESS) {
+				status = mb_copyrecord(verbose, mbio_ptr, store_ptr, buffer_store, error);
+				if (status != MB_SUCCESS) {
+					int deall_error = MB_ERROR_NO_ERROR;
+					mb_deall(verbose, mbio_ptr, &buffer_store, &deall_error);
+				}
+			}
 			if (status == MB_SUCCESS) {
-				buff->buffer_kind[buff->nbuffer] = kind;
+				const int ibuffer = MB_BUFFER_INDEX(buff, buff->nbuffer);
+				buff->buffer[ibuffer] = buffer_store;
+				buff->buffer_kind[ibuffer] = kind;
 				buff->nbuffer++;
 				(*nload)++;
 			}
@@ -207,7 +333,8 @@ int mb_buffer_load(int verbose, void *buff_ptr, void *mbio_ptr, int nwant, int *
 			fprintf(stderr, "dbg4       error:         %d\n", *error);
 			fprintf(stderr, "dbg4       status:        %d\n", status);
 			for (int i = 0; i < buff->nbuffer; i++) {
-				fprintf(stderr, "dbg4       i:%d  kind:%d  ptr:%p\n", i, buff->buffer_kind[i], (void *)buff->buffer[i]);
+				fprintf(stderr, "dbg4       i:%d  kind:%d  ptr:%p\n", i, buff->buffer_kind[MB_BUFFER_INDEX(buff, i)],
+				        (void *)buff->buffer[MB_BUFFER_INDEX(buff, i)]);
 			}
 		}
 	}
@@ -276,67 +403,34 @@ int mb_buffer_dump(int verbose, void *buff_ptr, void *mbio_ptr, void *ombio_ptr,
 		fprintf(stderr, "\ndbg4  Buffer list in MBIO function <%s>\n", __func__);
 		fprintf(stderr, "dbg4       nbuffer:     %d\n", buff->nbuffer);
 		for (int i = 0; i < buff->nbuffer; i++) {
-			fprintf(stderr, "dbg4       i:%d  kind:%d  ptr:%p\n", i, buff->buffer_kind[i], (void *)buff->buffer[i]);
+			fprintf(stderr, "dbg4       i:%d  kind:%d  ptr:%p\n", i, buff->buffer_kind[MB_BUFFER_INDEX(buff, i)],
+			        (void *)buff->buffer[MB_BUFFER_INDEX(buff, i)]);
 		}
 	}
 
 	/* dump records from buffer */
 	if (status == MB_SUCCESS) {
 		for (int i = 0; i < *ndump; i++) {
+			const int ibuffer = MB_BUFFER_INDEX(buff, i);
 			if (verbose >= 4) {
 				fprintf(stderr, "\ndbg4  Dumping record in MBIO function <%s>\n", __func__);
 				fprintf(stderr, "dbg4       record:      %d\n", i);
-				fprintf(stderr, "dbg4       ptr:         %p\n", (void *)buff->buffer[i]);
-				fprintf(stderr, "dbg4       kind:        %d\n", buff->buffer_kind[i]);
+				fprintf(stderr, "dbg4       ptr:         %p\n", (void *)buff->buffer[ibuffer]);
+				fprintf(stderr, "dbg4       kind:        %d\n", buff->buffer_kind[ibuffer]);
 			}
 
 			/* only write out data if output defined */
 			if (ombio_ptr != NULL)
-				status = mb_write_ping(verbose, ombio_ptr, buff->buffer[i], error);
+				status = mb_write_ping(verbose, ombio_ptr, buff->buffer[ibuffer], error);
 
-			if (verbose >= 4) {
-				fprintf(stderr, "\ndbg4  Deallocating record in MBIO function <%s>\n", __func__);
-				fprintf(stderr, "dbg4       record:      %d\n", i);
-				fprintf(stderr, "dbg4       ptr:         %p\n", (void *)buff->buffer[i]);
-				fprintf(stderr, "dbg4       kind:        %d\n", buff->buffer_kind[i]);
-			}
-
-			status &= mb_deall(verbose, mbio_ptr, &buff->buffer[i], error);
-			buff->buffer[i] = NULL;
-
-			if (verbose >= 4) {
-				fprintf(stderr, "\ndbg4  Done dumping record in MBIO function <%s>\n", __func__);
-				fprintf(stderr, "dbg4       record:      %d\n", i);
-				fprintf(stderr, "dbg4       ptr:         %p\n", (void *)buff->buffer[i]);
-				fprintf(stderr, "dbg4       kind:        %d\n", buff->buffer_kind[i]);
-			}
+			/* keep the data structure for reuse */
+			status &= mb_buffer_store_release(verbose, buff, mbio_ptr, &buff->buffer[ibuffer], error);
+			buff->buffer[ibuffer] = NULL;
+			buff->buffer_kind[ibuffer] = 0;
 		}
-		for (int i = 0; i < nhold; i++) {
-			if (verbose >= 4) {
-				fprintf(stderr, "\ndbg4  Moving buffer record in MBIO function <%s>\n", __func__);
-				fprintf(stderr, "dbg4       old:         %d\n", *ndump + i);
-				fprintf(stderr, "dbg4       new:         %d\n", i);
-				fprintf(stderr, "dbg4       old ptr:     %p\n", (void *)buff->buffer[*ndump + i]);
-				fprintf(stderr, "dbg4       new ptr:     %p\n", (void *)buff->buffer[i]);
-				fprintf(stderr, "dbg4       old kind:    %d\n", buff->buffer_kind[*ndump + i]);
-				fprintf(stderr, "dbg4       new kind:    %d\n", buff->buffer_kind[i]);
-			}
 
-			buff->buffer[i] = buff->buffer[*ndump + i];
-			buff->buffer_kind[i] = buff->buffer_kind[*ndump + i];
-			buff->buffer[*ndump + i] = NULL;
-			buff->buffer_kind[*ndump + i] = 0;
-
-			if (verbose >= 4) {
-				fprintf(stderr, "\ndbg4  Done moving buffer record in MBIO function <%s>\n", __func__);
-				fprintf(stderr, "dbg4       old:         %d\n", *ndump + i);
-				fprintf(stderr, "dbg4       new:         %d\n", i);
-				fprintf(stderr, "dbg4       old ptr:     %p\n", (void *)buff->buffer[*ndump + i]);
-				fprintf(stderr, "dbg4       new ptr:     %p\n", (void *)buff->buffer[i]);
-				fprintf(stderr, "dbg4       old kind:    %d\n", buff->buffer_kind[*ndump + i]);
-				fprintf(stderr, "dbg4       new kind:    %d\n", buff->buffer_kind[i]);
-			}
-		}
+		/* the held records are now at the start of the buffer */
+		buff->ifirst = MB_BUFFER_INDEX(buff, *ndump);
 		buff->nbuffer = buff->nbuffer - *ndump;
 	}
 
@@ -344,7 +438,8 @@ int mb_buffer_dump(int verbose, void *buff_ptr, void *mbio_ptr, void *ombio_ptr,
 		fprintf(stderr, "\ndbg4  Buffer list at end of MBIO function <%s>\n", __func__);
 		fprintf(stderr, "dbg4       nbuffer:     %d\n", buff->nbuffer);
 		for (int i = 0; i < buff->nbuffer; i++) {
-			fprintf(stderr, "dbg4       i:%d  kind:%d  ptr:%p\n", i, buff->buffer_kind[i], (void *)buff->buffer[i]);
+			fprintf(stderr, "dbg4       i:%d  kind:%d  ptr:%p\n", i, buff->buffer_kind[MB_BUFFER_INDEX(buff, i)],
+			        (void *)buff->buffer[MB_BUFFER_INDEX(buff, i)]);
 		}
 	}
 
@@ -374,90 +469,9 @@ int mb_buffer_clear(int verbose, void *buff_ptr, void *mbio_ptr, int nhold, int
 		fprintf(stderr, "dbg2       nhold:      %d\n", nhold);
 	}
 
-	/* get buffer structure */
-	struct mb_buffer_struct *buff = (struct mb_buffer_struct *)buff_ptr;
-
-	/* figure out how much to dump */
-	*ndump = buff->nbuffer - nhold;
-	int status = MB_SUCCESS;
-	if (buff->nbuffer <= 0) {
-		status = MB_FAILURE;
-		*error = MB_ERROR_BUFFER_EMPTY;
-		*ndump = 0;
-	}
-	else if (*ndump <= 0) {
-		status = MB_FAILURE;
-		*error = MB_ERROR_NO_DATA_DUMPED;
-		*ndump = 0;
-	}
-
-	if (verbose >= 4) {
-		fprintf(stderr, "\ndbg4  Buffer list in MBIO function <%s>\n", __func__);
-		fprintf(stderr, "dbg4       nbuffer:     %d\n", buff->nbuffer);
-		for (int i = 0; i < buff->nbuffer; i++) {
-			fprintf(stderr, "dbg4       i:%d  kind:%d  ptr:%p\n", i, buff->buffer_kind[i], (void *)buff->buffer[i]);
-		}
-	}
-
-	/* dump records from buffer */
-	if (status == MB_SUCCESS) {
-		for (int i = 0; i < *ndump; i++) {
-			if (verbose >= 4) {
-				fprintf(stderr, "\ndbg4  Deallocating record in MBIO function <%s>\n", __func__);
-				fprintf(stderr, "dbg4       record:      %d\n", i);
-				fprintf(stderr, "dbg4       ptr:         %p\n", (void *)buff->buffer[i]);
-				fprintf(stderr, "dbg4       kind:        %d\n", buff->buffer_kind[i]);
-			}
-
-			status = mb_deall(verbose, mbio_ptr, &buff->buffer[i], error);
-			buff->buffer[i] = NULL;
-
-			if (verbose >= 4) {
-				fprintf(stderr, "\ndbg4  Done dumping record in MBIO function <%s>\n", __func__);
-				fprintf(stderr, "dbg4       record:      %d\n", i);
-				fprintf(stderr, "dbg4       ptr:         %p\n", (void *)buff->buffer[i]);
-				fprintf(stderr, "dbg4       kind:        %d\n", buff->buffer_kind[i]);
-			}
-		}
-		for (int i = 0; i < nhold; i++) {
-			if (verbose >= 4) {
-				fprintf(stderr, "\ndbg4  Moving buffer record in MBIO function <%s>\n", __func__);
-				fprintf(stderr, "dbg4       old:         %d\n", *ndump + i);
-				fprintf(stderr, "dbg4       new:         %d\n", i);
-				fprintf(stderr, "dbg4       old ptr:     %p\n", (void *)buff->buffer[*ndump + i]);
-				fprintf(stderr, "dbg4       new ptr:     %p\n", (void *)buff->buffer[i]);
-				fprintf(stderr, "dbg4       old kind:    %d\n", buff->buffer_kind[*ndump + i]);
-				fprintf(stderr, "dbg4       new kind:    %d\n", buff->buffer_kind[i]);
-			}
-
-			buff->buffer[i] = buff->buffer[*ndump + i];
-			buff->buffer_kind[i] = buff->buffer_kind[*ndump + i];
-			buff->buffer[*ndump + i] = NULL;
-			buff->buffer_kind[*ndump + i] = 0;
-
-			if (verbose >= 4) {
-				fprintf(stderr, "\ndbg4  Done moving buffer record in MBIO function <%s>\n", __func__);
-				fprintf(stderr, "dbg4       old:         %d\n", *ndump + i);
-				fprintf(stderr, "dbg4       new:         %d\n", i);
-				fprintf(stderr, "dbg4       old ptr:     %p\n", (void *)buff->buffer[*ndump + i]);
-				fprintf(stderr, "dbg4       new ptr:     %p\n", (void *)buff->buffer[i]);
-				fprintf(stderr, "dbg4       old kind:    %d\n", buff->buffer_kind[*ndump + i]);
-				fprintf(stderr, "dbg4       new kind:    %d\n", buff->buffer_kind[i]);
-			}
-		}
-		buff->nbuffer = buff->nbuffer - *ndump;
-	}
-
-	if (verbose >= 4) {
-		fprintf(stderr, "\ndbg4  Buffer list at end of MBIO function <%s>\n", __func__);
-		fprintf(stderr, "dbg4       nbuffer:     %d\n", buff->nbuffer);
-		for (int i = 0; i < buff->nbuffer; i++) {
-			fprintf(stderr, "dbg4       i:%d  kind:%d  ptr:%p\n", i, buff->buffer_kind[i], (void *)buff->buffer[i]);
-		}
-	}
-
-	/* set return value */
-	*nbuff = buff->nbuffer;
+	/* the records are cleared in the same way as they are dumped
+	    but without being written out */
+	const int status = mb_buffer_dump(verbose, buff_ptr, mbio_ptr, NULL, nhold, ndump, nbuff, error);
 
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
@@ -492,7 +506,7 @@ int mb_buffer_get_next_data(int verbose, void *buff_ptr, void *mbio_ptr, int sta
 	/* look for next survey data */
 	bool found = false;
 	for (int i = start; i < buff->nbuffer; i++) {
-		if (!found && buff->buffer_kind[i] == MB_DATA_DATA) {
+		if (!found && buff->buffer_kind[MB_BUFFER_INDEX(buff, i)] == MB_DATA_DATA) {
 			*id = i;
 			found = true;
 		}
@@ -581,7 +595,7 @@ int mb_buffer_get_next_nav(int verbose, void *buff_ptr, void *mbio_ptr, int star
 	/* look for next data of the appropriate type */
 	bool found = false;
 	for (int i = start; i < buff->nbuffer; i++) {
-		if (!found && buff->buffer_kind[i] == mb_io_ptr->nav_source) {
+		if (!found && buff->buffer_kind[MB_BUFFER_INDEX(buff, i)] == mb_io_ptr->nav_source) {
 			*id = i;
 			found = true;
 		}
@@ -656,8 +670,8 @@ int mb_buffer_extract(int verbose, void *buff_ptr, void *mbio_ptr, int id, int *
 		status = MB_FAILURE;
 		*error = MB_ERROR_BAD_BUFFER_ID;
 	} else {
-		store_ptr = buff->buffer[id];
-		*kind = buff->buffer_kind[id];
+		store_ptr = buff->buffer[MB_BUFFER_INDEX(buff, id)];
+		*kind = buff->buffer_kind[MB_BUFFER_INDEX(buff, id)];
 		*error = MB_ERROR_NO_ERROR;
 	}
 
@@ -743,8 +757,8 @@ int mb_buffer_extract_nav(int verbose, void *buff_ptr, void *mbio_ptr, int id, i
 		status = MB_FAILURE;
 		*error = MB_ERROR_BAD_BUFFER_ID;
 	} else {
-		store_ptr = buff->buffer[id];
-		*kind = buff->buffer_kind[id];
+		store_ptr = buff->buffer[MB_BUFFER_INDEX(buff, id)];
+		*kind = buff->buffer_kind[MB_BUFFER_INDEX(buff, id)];
 		*error = MB_ERROR_NO_ERROR;
 	}
 
@@ -840,8 +854,8 @@ int mb_buffer_insert(int verbose, void *buff_ptr, void *mbio_ptr, int id, int ti
 		*error = MB_ERROR_BAD_BUFFER_ID;
 	}
 	else {
-		char *store_ptr = buff->buffer[id];
-		status = mb_insert(verbose, mbio_ptr, store_ptr, buff->buffer_kind[id], time_i, time_d, navlon, navlat, speed, heading,
+		char *store_ptr = buff->buffer[MB_BUFFER_INDEX(buff, id)];
+		status = mb_insert(verbose, mbio_ptr, store_ptr, buff->buffer_kind[MB_BUFFER_INDEX(buff, id)], time_i, time_d, navlon, navlat, speed, heading,
 		                   nbath, namp, nss, beamflag, bath, amp, bathacrosstrack, bathalongtrack, ss, ssacrosstrack,
 		                   ssalongtrack, comment, error);
 	}
@@ -894,7 +908,7 @@ int mb_buffer_insert_nav(int verbose, void *buff_ptr, void *mbio_ptr, int id, in
 		*error = MB_ERROR_BAD_BUFFER_ID;
 	}
 	else {
-		char *store_ptr = buff->buffer[id];
+		char *store_ptr = buff->buffer[MB_BUFFER_INDEX(buff, id)];
 		status = mb_insert_nav(verbose, mbio_ptr, store_ptr, time_i, time_d, navlon, navlat, speed, heading, draft, roll, pitch,
 		                       heave, error);
 	}
@@ -929,7 +943,7 @@ int mb_buffer_get_kind(int verbose, void *buff_ptr, void *mbio_ptr, int id, int
 		*error = MB_ERROR_BAD_BUFFER_ID;
 	}
 	else {
-		*kind = buff->buffer_kind[id];
+		*kind = buff->buffer_kind[MB_BUFFER_INDEX(buff, id)];
 	}
 
 	if (verbose >= 2) {
@@ -963,7 +977,7 @@ int mb_buffer_get_ptr(int verbose, void *buff_ptr, void *mbio_ptr, int id, void
 		*error = MB_ERROR_BAD_BUFFER_ID;
 	}
 	else {
-		*store_ptr = buff->buffer[id];
+		*store_ptr = buff->buffer[MB_BUFFER_INDEX(buff, id)];
 	}
 
 	if (verbose >= 2) {
@@ -46,6 +46,7 @@
 #include "mb_define.h"
 #include "mb_format.h"
 #include "mb_info.h"
+#include "mb_io.h"
 #include "mb_status.h"
 
 /*--------------------------------------------------------------------*/
@@ -620,6 +621,8 @@ int mb_make_info(int verbose, bool force, char *file, int format, int *error) {
 	sprintf(fbtfile, "%s.fbt", file);
 	char fnvfile[MB_PATH_MAXLINE];
 	sprintf(fnvfile, "%s.fnv", file);
+	char idxfile[MB_PATH_MAXLINE];
+	sprintf(idxfile, "%s%s", file, MB_INDEX_SUFFIX);
 
 	int fstat;
 	struct stat file_status;
@@ -639,47 +642,30 @@ int mb_make_info(int verbose, bool force, char *file, int format, int *error) {
 	if ((fstat = stat(fnvfile, &file_status)) == 0 && (file_status.st_mode & S_IFMT) != S_IFDIR && file_status.st_size > 0) {
 		fnvmodtime = file_status.st_mtime;
 	}
+	int idxmodtime = 0;
+	if ((fstat = stat(idxfile, &file_status)) == 0 && (file_status.st_mode & S_IFMT) != S_IFDIR && file_status.st_size > 0) {
+		idxmodtime = file_status.st_mtime;
+	}
 
 	int status = MB_SUCCESS;
-	int shellstatus = 0;
 
-	/* make new inf file if not there or out of date */
-	if (force || (datmodtime > 0 && datmodtime > infmodtime)) {
-		if (verbose >= 1)
+	/* make new inf, fbt, fnv, and idx files as needed if not there or out of date,
+	    generating all of them from a single pass through the swath file - an idx
+	    record index is only made for formats that can start reading within a file */
+	const bool make_inf = force || (datmodtime > 0 && datmodtime > infmodtime);
+	const bool make_fbt = (force || (datmodtime > 0 && datmodtime > fbtmodtime)) && mb_should_make_fbt(verbose, format);
+	const bool make_fnv = (force || (datmodtime > 0 && datmodtime > fnvmodtime)) && mb_should_make_fnv(verbose, format);
+	const bool make_idx = force || (datmodtime > 0 && datmodtime > idxmodtime);
+	if (verbose >= 1) {
+		if (make_inf)
 			fprintf(stderr, "\nGenerating inf file for %s\n", file);
-		char command[MB_PATH_MAXLINE];
-		sprintf(command, "mbinfo -F %d -I %s -G -N -O -M10/10", format, file);
-		if (verbose >= 2)
-			fprintf(stderr, "\t%s\n", command);
-		if ((shellstatus = system(command)) != 0)
-      status = MB_FAILURE;
-	}
-
-	/* make new fbt file if not there or out of date */
-	if ((force || (datmodtime > 0 && datmodtime > fbtmodtime)) && mb_should_make_fbt(verbose, format)) {
-		if (verbose >= 1)
+		if (make_fbt)
 			fprintf(stderr, "Generating fbt file for %s\n", file);
-		  char command[MB_PATH_MAXLINE];
-		  sprintf(command, "mbcopy -F %d/71 -I %s -D -O %s.fbt", format, file, file);
-		  if ((shellstatus = system(command)) != 0)
-        status = MB_FAILURE;
-	}
-
-	/* make new fnv file if not there or out of date */
-	if ((force || (datmodtime > 0 && datmodtime > fnvmodtime)) && mb_should_make_fnv(verbose, format)) {
-		if (verbose >= 1)
+		if (make_fnv)
 			fprintf(stderr, "Generating fnv file for %s\n", file);
-	  char command[MB_PATH_MAXLINE];
-    sprintf(command,  "echo \"## <yyyy mm dd hh mm ss.ssssss> <epoch seconds> "
-                      "<longitude (deg)> <latitude (deg)> <heading (deg)> <speed (km/hr)> "
-                      "<draft (m)> <roll (deg)> <pitch (deg)> <heave (m)> <portlon (deg)> "
-                      "<portlat (deg)> <stbdlon (deg)> <stbdlat (deg)>\"  > %s.fnv", file);
-	  if ((shellstatus = system(command)) != 0)
-      status = MB_FAILURE;
-	  sprintf(command, "mblist -F %d -I %s -O tMXYHScRPr=X=Y+X+Y -UN >> %s.fnv", format, file, file);
-	  if ((shellstatus = system(command)) != 0)
-      status = MB_FAILURE;
 	}
+	if (make_inf || make_fbt || make_fnv || make_idx)
+		status = mb_make_ancillary(verbose, file, format, make_inf, make_fbt, make_fnv, make_idx, error);
 
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
@@ -1116,6 +1102,248 @@ int mb_info_init(int verbose, struct mb_info_struct *mb_info, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------*/
+/* the sections of the mbinfo text report are printed by the functions
+    below, which are shared by mbinfo and mb_make_ancillary() */
+int mb_info_print_file(int verbose, FILE *output, char *file, int format, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       output:     %p\n", (void *)output);
+		fprintf(stderr, "dbg2       file:       %s\n", file);
+		fprintf(stderr, "dbg2       format:     %d\n", format);
+	}
+
+	const char *fileprint = strrchr(file, '/') != NULL ? strrchr(file, '/') + 1 : file;
+	char format_description[MB_DESCRIPTION_LENGTH] = "";
+	int format_use = format;
+	mb_format_description(verbose, &format_use, format_description, error);
+	fprintf(output, "\nSwath Data File:      %s\n", fileprint);
+	fprintf(output, "MBIO Data Format ID:  %d\n", format);
+	fprintf(output, "%s", format_description);
+
+	*error = MB_ERROR_NO_ERROR;
+	const int status = MB_SUCCESS;
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_info_print_totals(int verbose, FILE *output, struct mb_info_struct *mb_info, int time_start_i[7],
+                         int time_end_i[7], bool bathy_in_meters, int *notice_list, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:         %d\n", verbose);
+		fprintf(stderr, "dbg2       output:          %p\n", (void *)output);
+		fprintf(stderr, "dbg2       mb_info:         %p\n", (void *)mb_info);
+		fprintf(stderr, "dbg2       bathy_in_meters: %d\n", bathy_in_meters);
+		fprintf(stderr, "dbg2       notice_list:     %p\n", (void *)notice_list);
+	}
+
+	/* calculate percentages of data */
+	double ngd_percent = 0.0;
+	double nzd_percent = 0.0;
+	double nfd_percent = 0.0;
+	if (mb_info->nbeams_bath_total > 0) {
+		ngd_percent = 100.0 * mb_info->nbeams_bath_good / mb_info->nbeams_bath_total;
+		nzd_percent = 100.0 * mb_info->nbeams_bath_zero / mb_info->nbeams_bath_total;
+		nfd_percent = 100.0 * mb_info->nbeams_bath_flagged / mb_info->nbeams_bath_total;
+	}
+	double nga_percent = 0.0;
+	double nza_percent = 0.0;
+	double nfa_percent = 0.0;
+	if (mb_info->nbeams_amp_total > 0) {
+		nga_percent = 100.0 * mb_info->nbeams_amp_good / mb_info->nbeams_amp_total;
+		nza_percent = 100.0 * mb_info->nbeams_amp_zero / mb_info->nbeams_amp_total;
+		nfa_percent = 100.0 * mb_info->nbeams_amp_flagged / mb_info->nbeams_amp_total;
+	}
+	double ngs_percent = 0.0;
+	double nzs_percent = 0.0;
+	double nfs_percent = 0.0;
+	if (mb_info->npixels_ss_total > 0) {
+		ngs_percent = 100.0 * mb_info->npixels_ss_good / mb_info->npixels_ss_total;
+		nzs_percent = 100.0 * mb_info->npixels_ss_zero / mb_info->npixels_ss_total;
+		nfs_percent = 100.0 * mb_info->npixels_ss_flagged / mb_info->npixels_ss_total;
+	}
+
+	/* depths are reported in meters or in feet */
+	const double bathy_scale = bathy_in_meters ? 1.0 : 1.0 / 0.3048;
+	const char *bathy_units = bathy_in_meters ? "meters" : "feet";
+	int time_start_j[5];
+	int time_end_j[5];
+	mb_get_jtime(verbose, time_start_i, time_start_j);
+	mb_get_jtime(verbose, time_end_i, time_end_j);
+
+	fprintf(output, "\nData Totals:\n");
+	fprintf(output, "Number of Records:                    %8d\n", mb_info->nrecords);
+	const int isbtmrec = notice_list[MB_DATA_SUBBOTTOM_MCS] + notice_list[MB_DATA_SUBBOTTOM_CNTRBEAM] +
+	                     notice_list[MB_DATA_SUBBOTTOM_SUBBOTTOM];
+	if (isbtmrec > 0)
+		fprintf(output, "Number of Subbottom Records:          %8d\n", isbtmrec);
+	if (notice_list[MB_DATA_SIDESCAN2] > 0)
+		fprintf(output, "Number of Secondary Sidescan Records: %8d\n", notice_list[MB_DATA_SIDESCAN2]);
+	if (notice_list[MB_DATA_SIDESCAN3] > 0)
+		fprintf(output, "Number of Tertiary Sidescan Records:  %8d\n", notice_list[MB_DATA_SIDESCAN3]);
+	if (notice_list[MB_DATA_WATER_COLUMN] > 0)
+		fprintf(output, "Number of Water Column Records:       %8d\n", notice_list[MB_DATA_WATER_COLUMN]);
+
+	fprintf(output, "Bathymetry Data (%d beams):\n", mb_info->nbeams_bath);
+	fprintf(output, "  Number of Beams:         %8d\n", mb_info->nbeams_bath_total);
+	fprintf(output, "  Number of Good Beams:    %8d     %5.2f%%\n", mb_info->nbeams_bath_good, ngd_percent);
+	fprintf(output, "  Number of Zero Beams:    %8d     %5.2f%%\n", mb_info->nbeams_bath_zero, nzd_percent);
+	fprintf(output, "  Number of Flagged Beams: %8d     %5.2f%%\n", mb_info->nbeams_bath_flagged, nfd_percent);
+	fprintf(output, "Amplitude Data (%d beams):\n", mb_info->nbeams_amp);
+	fprintf(output, "  Number of Beams:         %8d\n", mb_info->nbeams_amp_total);
+	fprintf(output, "  Number of Good Beams:    %8d     %5.2f%%\n", mb_info->nbeams_amp_good, nga_percent);
+	fprintf(output, "  Number of Zero Beams:    %8d     %5.2f%%\n", mb_info->nbeams_amp_zero, nza_percent);
+	fprintf(output, "  Number of Flagged Beams: %8d     %5.2f%%\n", mb_info->nbeams_amp_flagged, nfa_percent);
+	fprintf(output, "Sidescan Data (%d pixels):\n", mb_info->npixels_ss);
+	fprintf(output, "  Number of Pixels:        %8d\n", mb_info->npixels_ss_total);
+	fprintf(output, "  Number of Good Pixels:   %8d     %5.2f%%\n", mb_info->npixels_ss_good, ngs_percent);
+	fprintf(output, "  Number of Zero Pixels:   %8d     %5.2f%%\n", mb_info->npixels_ss_zero, nzs_percent);
+	fprintf(output, "  Number of Flagged Pixels:%8d     %5.2f%%\n", mb_info->npixels_ss_flagged, nfs_percent);
+	fprintf(output, "\nNavigation Totals:\n");
+	fprintf(output, "Total Time:         %10.4f hours\n", mb_info->time_total);
+	fprintf(output, "Total Track Length: %10.4f km\n", mb_info->dist_total);
+	fprintf(output, "Average Speed:      %10.4f km/hr (%7.4f knots)\n", mb_info->speed_avg, mb_info->speed_avg / 1.85);
+	fprintf(output, "\nStart of Data:\n");
+	fprintf(output, "Time:  %2.2d %2.2d %4.4d %2.2d:%2.2d:%2.2d.%6.6d  JD%d (%4.4d-%2.2d-%2.2dT%2.2d:%2.2d:%2.2d.%6.6d)\n",
+	        time_start_i[1], time_start_i[2], time_start_i[0], time_start_i[3], time_start_i[4], time_start_i[5],
+	        time_start_i[6], time_start_j[1], time_start_i[0], time_start_i[1], time_start_i[2], time_start_i[3],
+	        time_start_i[4], time_start_i[5], time_start_i[6]);
+	fprintf(output, "Lon: %15.9f     Lat: %15.9f     Depth: %10.4f %s\n", mb_info->lon_start, mb_info->lat_start,
+	        bathy_scale * mb_info->depth_start, bathy_units);
+	fprintf(output, "Speed: %7.4f km/hr (%7.4f knots)  Heading:%9.4f degrees\n", mb_info->speed_start,
+	        mb_info->speed_start / 1.85, mb_info->heading_start);
+	fprintf(output, "Sonar Depth:%10.4f m  Sonar Altitude:%10.4f m\n", mb_info->sensordepth_start,
+	        mb_info->sonaraltitude_start);
+	fprintf(output, "\nEnd of Data:\n");
+	fprintf(output, "Time:  %2.2d %2.2d %4.4d %2.2d:%2.2d:%2.2d.%6.6d  JD%d (%4.4d-%2.2d-%2.2dT%2.2d:%2.2d:%2.2d.%6.6d)\n",
+	        time_end_i[1], time_end_i[2], time_end_i[0], time_end_i[3], time_end_i[4], time_end_i[5], time_end_i[6],
+	        time_end_j[1], time_end_i[0], time_end_i[1], time_end_i[2], time_end_i[3], time_end_i[4], time_end_i[5],
+	        time_end_i[6]);
+	fprintf(output, "Lon: %15.9f     Lat: %15.9f     Depth: %10.4f %s\n", mb_info->lon_end, mb_info->lat_end,
+	        bathy_scale * mb_info->depth_end, bathy_units);
+	fprintf(output, "Speed: %7.4f km/hr (%7.4f knots)  Heading:%9.4f degrees\n", mb_info->speed_end,
+	        mb_info->speed_end / 1.85, mb_info->heading_end);
+	fprintf(output, "Sonar Depth:%10.4f m  Sonar Altitude:%10.4f m\n", mb_info->sensordepth_end,
+	        mb_info->sonaraltitude_end);
+	fprintf(output, "\nLimits:\n");
+	fprintf(output, "Minimum Longitude:   %15.9f   Maximum Longitude:   %15.9f\n", mb_info->lon_min, mb_info->lon_max);
+	fprintf(output, "Minimum Latitude:    %15.9f   Maximum Latitude:    %15.9f\n", mb_info->lat_min, mb_info->lat_max);
+	fprintf(output, "Minimum Sonar Depth: %10.4f   Maximum Sonar Depth: %10.4f\n", mb_info->sensordepth_min,
+	        mb_info->sensordepth_max);
+	fprintf(output, "Minimum Altitude:    %10.4f   Maximum Altitude:    %10.4f\n", mb_info->altitude_min,
+	        mb_info->altitude_max);
+	if (mb_info->nbeams_bath_good > 0 || verbose >= 1)
+		fprintf(output, "Minimum Depth:       %10.4f   Maximum Depth:       %10.4f\n", bathy_scale * mb_info->depth_min,
+		        bathy_scale * mb_info->depth_max);
+	if (mb_info->nbeams_amp_good > 0 || verbose >= 1)
+		fprintf(output, "Minimum Amplitude:   %10.4f   Maximum Amplitude:   %10.4f\n", mb_info->amp_min, mb_info->amp_max);
+	if (mb_info->npixels_ss_good > 0 || verbose >= 1)
+		fprintf(output, "Minimum Sidescan:    %10.4f   Maximum Sidescan:    %10.4f\n", mb_info->ss_min, mb_info->ss_max);
+
+	*error = MB_ERROR_NO_ERROR;
+	const int status = MB_SUCCESS;
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_info_print_notices(int verbose, FILE *output, int *notice_list, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+		fprintf(stderr, "dbg2       output:      %p\n", (void *)output);
+		fprintf(stderr, "dbg2       notice_list: %p\n", (void *)notice_list);
+	}
+
+	char *notice_message;
+	fprintf(output, "\nData Record Type Notices:\n");
+	for (int i = 0; i <= MB_DATA_KINDS; i++) {
+		if (notice_list[i] > 0) {
+			mb_notice_message(verbose, i, &notice_message);
+			fprintf(output, "DN: %d %s\n", notice_list[i], notice_message);
+		}
+	}
+	fprintf(output, "\nNonfatal Error Notices:\n");
+	for (int i = MB_DATA_KINDS + 1; i <= MB_DATA_KINDS - (MB_ERROR_MIN); i++) {
+		if (notice_list[i] > 0) {
+			mb_notice_message(verbose, i, &notice_message);
+			fprintf(output, "EN: %d %s\n", notice_list[i], notice_message);
+		}
+	}
+	fprintf(output, "\nProblem Notices:\n");
+	for (int i = MB_DATA_KINDS - (MB_ERROR_MIN) + 1; i < MB_NOTICE_MAX; i++) {
+		if (notice_list[i] > 0) {
+			mb_notice_message(verbose, i, &notice_message);
+			fprintf(output, "PN: %d %s\n", notice_list[i], notice_message);
+		}
+	}
+
+	*error = MB_ERROR_NO_ERROR;
+	const int status = MB_SUCCESS;
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_info_print_mask(int verbose, FILE *output, int mask_nx, int mask_ny, int *mask, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       output:     %p\n", (void *)output);
+		fprintf(stderr, "dbg2       mask_nx:    %d\n", mask_nx);
+		fprintf(stderr, "dbg2       mask_ny:    %d\n", mask_ny);
+		fprintf(stderr, "dbg2       mask:       %p\n", (void *)mask);
+	}
+
+	fprintf(output, "\nCoverage Mask:\nCM dimensions: %d %d\n", mask_nx, mask_ny);
+	for (int j = mask_ny - 1; j >= 0; j--) {
+		fprintf(output, "CM:  ");
+		for (int i = 0; i < mask_nx; i++)
+			fprintf(output, " %1d", mask[i + j * mask_nx]);
+		fprintf(output, "\n");
+	}
+
+	*error = MB_ERROR_NO_ERROR;
+	const int status = MB_SUCCESS;
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
 int mb_get_info_datalist(int verbose, char *read_file, int *format, struct mb_info_struct *mb_info, int lonflip, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
@@ -57,8 +57,14 @@ int mb_close(int verbose, void **mbio_ptr, int *error) {
   /* get pointer to mbio descriptor */
   struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)*mbio_ptr;
 
+  /* stop any read-ahead thread before anything it uses is released */
+  int status = mb_read_ahead_close(verbose, *mbio_ptr, error);
+
+  /* release any ping cache, discarding a cache not completely written */
+  status &= mb_pingcache_close(verbose, *mbio_ptr, error);
+
   /* deallocate format dependent structures */
-  int status = (*mb_io_ptr->mb_io_format_free)(verbose, *mbio_ptr, error);
+  status &= (*mb_io_ptr->mb_io_format_free)(verbose, *mbio_ptr, error);
 
   /* deallocate system dependent structures */
   /*status = (*mb_io_ptr->mb_io_store_free)
@@ -74,6 +80,7 @@ int mb_close(int verbose, void **mbio_ptr, int *error) {
   if (mb_io_ptr->hdr_comment != NULL)
     status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&mb_io_ptr->hdr_comment, error);
   status &= mb_deall_ioarrays(verbose, *mbio_ptr, error);
+  status &= mb_extract_batch_deall(verbose, *mbio_ptr, error);
 
   /* close the files if normal */
   if (mb_io_ptr->filetype == MB_FILETYPE_NORMAL || mb_io_ptr->filetype == MB_FILETYPE_XDR) {
@@ -123,7 +130,11 @@ int mb_close(int verbose, void **mbio_ptr, int *error) {
   /* deallocate UTM projection if required */
   if (mb_io_ptr->projection_initialized) {
     mb_io_ptr->projection_initialized = false;
-    mb_proj_free(verbose, &(mb_io_ptr->pjptr), error);
+    if (mb_io_ptr->projection_cached)
+      mb_io_ptr->pjptr = NULL;
+    else
+      mb_proj_free(verbose, &(mb_io_ptr->pjptr), error);
+    mb_io_ptr->projection_cached = false;
   }
 
   /* deallocate alternative navigation arrays if initialized */
@@ -354,6 +354,8 @@ int mb_mbview_defaults(int verbose, int *primary_colortable, int *primary_colort
 int mb_fbtversion(int verbose, int *fbtversion);
 int mb_uselockfiles(int verbose, bool *uselockfiles);
 int mb_fileiobuffer(int verbose, int *fileiobuffer);
+int mb_readahead(int verbose, int *readahead, int *readthreads);
+int mb_pingcache(int verbose, char *pingcache);
 int mb_format_register(int verbose, int *format, void *mbio_ptr, int *error);
 int mb_format_info(int verbose, int *format, int *system, int *beams_bath_max, int *beams_amp_max, int *pixels_ss_max,
                    char *format_name, char *system_name, char *format_description, int *numfile, int *filetype,
@@ -378,6 +380,7 @@ int mb_format_beamwidth(int verbose, int *format, double *beamwidth_xtrack, doub
     @return MB_SUCCESS or MB_FAILURE
  */
  int mb_get_format(int verbose, char *filename, char *fileroot, int *format, int *error);
+int mb_get_format_probe(int verbose, char *filename, int *format, int *error);
   
 int mb_datalist_open(int verbose, void **datalist_ptr, char *path, int look_processed, int *error);
 int mb_datalist_read(int verbose, void *datalist_ptr, char *path, char *dpath, int *format, double *weight, int *error);
@@ -404,10 +407,21 @@ int mb_check_info(int verbose, char *file, int lonflip, double bounds[4], bool *
 bool mb_should_make_fbt(int verbose, int format);
 bool mb_should_make_fnv(int verbose, int format);
 int mb_make_info(int verbose, bool force, char *file, int format, int *error);
+int mb_make_ancillary(int verbose, char *file, int format, bool make_inf, bool make_fbt, bool make_fnv, bool make_idx,
+                      int *error);
+int mb_make_info_datalist(int verbose, bool force, void *datalist_ptr, int nthreads, int *nfile, int *error);
 int mb_get_fbt(int verbose, char *file, int *format, int *error);
 int mb_get_fnv(int verbose, char *file, int *format, int *error);
 int mb_get_ffa(int verbose, char *file, int *format, int *error);
 int mb_get_ffs(int verbose, char *file, int *format, int *error);
+int mb_index_make(int verbose, bool force, char *file, int format, int *error);
+bool mb_index_seekable(int verbose, void *mbio_ptr);
+int mb_index_add(int verbose, void *mbio_ptr, void *store_ptr, long offset, int kind, int *num_fileindex,
+                 int *num_fileindex_alloc, void **fileindex_ptr, int *error);
+int mb_index_write(int verbose, char *file, int format, int num_fileindex, void *fileindex_ptr, int *error);
+int mb_index_read(int verbose, char *file, int format, int *num_fileindex, void **fileindex_ptr, int *error);
+int mb_index_format(int verbose, char *file, int *format, int *error);
+int mb_index_seek_init(int verbose, void *mbio_ptr, int *error);
 int mb_swathbounds(int verbose, int checkgood, int nbath, int nss,
                   char *beamflag, double *bathacrosstrack,
                   double *ss, double *ssacrosstrack,
@@ -435,14 +449,36 @@ int mb_set_debug_records(int verbose, void *mbio_ptr,
 									int num_debug_record_identifiers, 
 									mb_name *debug_record_identifiers,
 									int *error);
+int mb_set_lazy_decode(int verbose, void *mbio_ptr, bool lazy_decode, int *error);
+int mb_set_pingcache(int verbose, void *mbio_ptr, bool use, int *error);
+int mb_pingcache_get(int verbose, void *mbio_ptr, void *store_ptr, int *kind, double *sensordepth, double *altitude,
+                     int *error);
+int mb_pingcache_detach(int verbose, void *mbio_ptr, void *store_ptr, int *error);
+int mb_pingcache_sonartype(int verbose, void *mbio_ptr, int *sonartype, int *error);
+int mb_pingcache_close(int verbose, void *mbio_ptr, int *error);
 int mb_write_init(int verbose, char *file, int format, void **mbio_ptr, int *beams_bath, int *beams_amp, int *pixels_ss,
                   int *error);
 int mb_close(int verbose, void **mbio_ptr, int *error);
+int mb_read_datalist_init(int verbose, void *datalist_ptr, int pings, int lonflip, double bounds[4], int btime_i[7],
+                  int etime_i[7], double speedmin, double timegap, bool use_fbt, int nthreads, int queue_size,
+                  bool ordered, void **reader_ptr, int *error);
+int mb_read_datalist(int verbose, void *reader_ptr, void **ping_ptr, int *error);
+int mb_read_datalist_close(int verbose, void **reader_ptr, int *error);
 int mb_read_ping(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *error);
+int mb_extract_batch(int verbose, void *mbio_ptr, int npings_want, int *npings, void **batch_ptr, int *error);
+int mb_extract_batch_deall(int verbose, void *mbio_ptr, int *error);
+int mb_read_ahead_init(int verbose, void *mbio_ptr, int nahead, int nthread, int *error);
+int mb_read_ahead_next(int verbose, void *mbio_ptr, void *store_ptr, int *error);
+int mb_read_ahead_close(int verbose, void *mbio_ptr, int *error);
 int mb_get_all(int verbose, void *mbio_ptr, void **store_ptr, int *kind, int time_i[7], double *time_d, double *navlon,
                   double *navlat, double *speed, double *heading, double *distance, double *altitude, double *sensordepth, int *nbath,
                   int *namp, int *nss, char *beamflag, double *bath, double *amp, double *bathacrosstrack, double *bathalongtrack,
                   double *ss, double *ssacrosstrack, double *ssalongtrack, char *comment, int *error);
+int mb_get_all_extract(int verbose, void *mbio_ptr, void *store_ptr, int read_status, int *kind, int time_i[7],
+                  double *time_d, double *navlon, double *navlat, double *speed, double *heading, double *distance,
+                  double *altitude, double *sensordepth, int *nbath, int *namp, int *nss, char *beamflag, double *bath,
+                  double *amp, double *bathacrosstrack, double *bathalongtrack, double *ss, double *ssacrosstrack,
+                  double *ssalongtrack, char *comment, int *error);
 int mb_get(int verbose, void *mbio_ptr, int *kind, int *pings, int time_i[7], double *time_d, double *navlon, double *navlat,
                   double *speed, double *heading, double *distance, double *altitude, double *sensordepth, int *nbath, int *namp,
                   int *nss, char *beamflag, double *bath, double *amp, double *bathacrosstrack, double *bathalongtrack, double *ss,
@@ -638,19 +674,26 @@ int mb_notice_message(int verbose, int notice, char **message);
 int mb_navint_add(int verbose, void *mbio_ptr, double time_d, double lon_easting, double lat_northing, int *error);
 int mb_navint_interp(int verbose, void *mbio_ptr, double time_d, double heading, double rawspeed, double *lon, double *lat,
                      double *speed, int *error);
+int mb_navint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double heading, double rawspeed,
+                      double *lon, double *lat, double *speed, int *error);
 int mb_navint_prjinterp(int verbose, void *mbio_ptr, double time_d, double heading, double rawspeed, double *easting,
                         double *northing, double *speed, int *error);
 int mb_attint_add(int verbose, void *mbio_ptr, double time_d, double heave, double roll, double pitch, int *error);
 int mb_attint_nadd(int verbose, void *mbio_ptr, int nsamples, double *time_d, double *heave, double *roll, double *pitch,
                    int *error);
 int mb_attint_interp(int verbose, void *mbio_ptr, double time_d, double *heave, double *roll, double *pitch, int *error);
+int mb_attint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double *heave, double *roll,
+                      double *pitch, int *error);
 int mb_hedint_add(int verbose, void *mbio_ptr, double time_d, double heading, int *error);
 int mb_hedint_nadd(int verbose, void *mbio_ptr, int nsamples, double *time_d, double *heading, int *error);
 int mb_hedint_interp(int verbose, void *mbio_ptr, double time_d, double *heading, int *error);
+int mb_hedint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double *heading, int *error);
 int mb_depint_add(int verbose, void *mbio_ptr, double time_d, double sensordepth, int *error);
 int mb_depint_interp(int verbose, void *mbio_ptr, double time_d, double *sensordepth, int *error);
+int mb_depint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double *sensordepth, int *error);
 int mb_altint_add(int verbose, void *mbio_ptr, double time_d, double altitude, int *error);
 int mb_altint_interp(int verbose, void *mbio_ptr, double time_d, double *altitude, int *error);
+int mb_altint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double *altitude, int *error);
 int mb_loadnavdata(int verbose, char *merge_nav_file, int merge_nav_format, int merge_nav_lonflip, int *merge_nav_num,
                    int *merge_nav_alloc, double **merge_nav_time_d, double **merge_nav_lon, double **merge_nav_lat,
                    double **merge_nav_speed, int *error);
@@ -683,6 +726,16 @@ int mb_get_binary_int(bool swapped, void *buffer, const void *ptr);
 int mb_get_binary_float(bool swapped, void *buffer, const void *ptr);
 int mb_get_binary_double(bool swapped, void *buffer, const void *ptr);
 int mb_get_binary_long(bool swapped, void *buffer, const void *ptr);
+int mb_get_binary_short_array(bool swapped, int n, const void *buffer, void *values);
+int mb_get_binary_int_array(bool swapped, int n, const void *buffer, void *values);
+int mb_get_binary_float_array(bool swapped, int n, const void *buffer, void *values);
+int mb_get_binary_double_array(bool swapped, int n, const void *buffer, void *values);
+int mb_get_binary_short_strided(bool swapped, int n, const void *buffer, size_t stride, void *values, size_t value_stride);
+int mb_get_binary_int_strided(bool swapped, int n, const void *buffer, size_t stride, void *values, size_t value_stride);
+int mb_get_binary_float_strided(bool swapped, int n, const void *buffer, size_t stride, void *values, size_t value_stride);
+int mb_get_binary_double_strided(bool swapped, int n, const void *buffer, size_t stride, void *values, size_t value_stride);
+int mb_get_binary_short_int_strided(bool swapped, bool is_unsigned, int n, const void *buffer, size_t stride, void *values,
+                                    size_t value_stride);
 int mb_put_binary_short(bool swapped, short value, void *buffer);
 int mb_put_binary_int(bool swapped, int value, void *buffer);
 int mb_put_binary_float(bool swapped, float value, void *buffer);
@@ -752,6 +805,10 @@ int mb_proj_init(int verbose, char *projection, void **pjptr, int *error);
 int mb_proj_free(int verbose, void **pjptr, int *error);
 int mb_proj_forward(int verbose, void *pjptr, double lon, double lat, double *easting, double *northing, int *error);
 int mb_proj_inverse(int verbose, void *pjptr, double easting, double northing, double *lon, double *lat, int *error);
+int mb_proj_forward_array(int verbose, void *pjptr, int n, double *u, double *v, int *error);
+int mb_proj_inverse_array(int verbose, void *pjptr, int n, double *u, double *v, int *error);
+int mb_proj_init_cached(int verbose, char *projection, void **pjptr, int *error);
+int mb_proj_cache_free(int verbose, int *error);
 int mb_geod_init(int verbose, double radius_equatorial, double flattening, void **g_ptr, int *error);
 int mb_geod_free(int verbose, void **g_ptr, int *error);
 int mb_geod_inverse(int verbose, void *g_ptr,
@@ -785,6 +842,10 @@ int mb_rt(int verbose, void *modelptr, double source_depth, double source_angle,
           double surface_vel, double null_angle, int nplot_max,
           int *nplot, double *xplot, double *zplot, double *tplot,
           double *x, double *z, double *travel_time, int *ray_stat, int *error);
+int mb_rt_table_init(int verbose, void *modelptr, double max_time, void **tableptr, int *error);
+int mb_rt_table_deall(int verbose, void **tableptr, int *error);
+int mb_rt_table(int verbose, void *tableptr, double source_depth, double source_angle, double end_time, int ssv_mode,
+                double surface_vel, double null_angle, double *x, double *z, double *travel_time, int *ray_stat, int *error);
           
 /* mb_bitpack C API function prototypes */
 void *mb_bitpack_new();
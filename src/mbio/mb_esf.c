@@ -31,6 +31,7 @@
 
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -47,6 +48,286 @@
 void mb_mergesort_setup(mb_u_char *list1, mb_u_char *list2, size_t n, size_t size, int (*cmp)(const void *, const void *));
 void mb_mergesort_insertionsort(mb_u_char *a, size_t n, size_t size, int (*cmp)(const void *, const void *));
 
+/* The edit index hashes each edit twice: by time bin alone, so that all of
+    the edits for a ping can be found, and by time bin and beam number, so
+    that the edits for each beam can be found without scanning the ping.
+    The time bins are twice the timestamp matching tolerance wide, so
+    the edits matching a timestamp lie in at most two adjacent bins. The
+    chains hold edit numbers in ascending order, which is the order in
+    which edits are applied. */
+struct mb_esf_index_struct {
+	double binwidth;
+	unsigned int mask;
+	int *ping_head;
+	int *ping_next;
+	int *beam_head;
+	int *beam_next;
+};
+
+/* cursor merging the index chains of the time bins matching a timestamp */
+struct mb_esf_cursor_struct {
+	const int *next;
+	int nchain;
+	int chain[3];
+};
+
+#define MB_ESF_INDEX_PING -1
+
+/*--------------------------------------------------------------------*/
+static unsigned int mb_esf_index_slot(const struct mb_esf_index_struct *index, long long bin, int beam) {
+	uint64_t hash = (uint64_t)bin * 0x9E3779B97F4A7C15ULL;
+	hash ^= (uint64_t)(uint32_t)beam * 0xC2B2AE3D27D4EB4FULL;
+	hash ^= hash >> 29;
+	return (unsigned int)hash & index->mask;
+}
+/*--------------------------------------------------------------------*/
+static long long mb_esf_index_bin(const struct mb_esf_index_struct *index, double time_d) {
+	return (long long)floor(time_d / index->binwidth);
+}
+/*--------------------------------------------------------------------*/
+/* insert an edit into a chain keeping the edit numbers in ascending order */
+static void mb_esf_index_insert(int *head, int *next, unsigned int slot, int iedit) {
+	int *link = &head[slot];
+	while (*link >= 0 && *link < iedit)
+		link = &next[*link];
+	next[iedit] = *link;
+	*link = iedit;
+}
+/*--------------------------------------------------------------------*/
+static void mb_esf_index_remove(int *head, int *next, unsigned int slot, int iedit) {
+	int *link = &head[slot];
+	while (*link >= 0 && *link != iedit)
+		link = &next[*link];
+	if (*link == iedit)
+		*link = next[iedit];
+}
+/*--------------------------------------------------------------------*/
+static void mb_esf_index_link(struct mb_esf_index_struct *index, const struct mb_esf_struct *esf, int iedit) {
+	const long long bin = mb_esf_index_bin(index, esf->edit[iedit].time_d);
+	mb_esf_index_insert(index->ping_head, index->ping_next, mb_esf_index_slot(index, bin, MB_ESF_INDEX_PING), iedit);
+	mb_esf_index_insert(index->beam_head, index->beam_next, mb_esf_index_slot(index, bin, esf->edit[iedit].beam), iedit);
+}
+/*--------------------------------------------------------------------*/
+static void mb_esf_index_unlink(struct mb_esf_index_struct *index, const struct mb_esf_struct *esf, int iedit) {
+	const long long bin = mb_esf_index_bin(index, esf->edit[iedit].time_d);
+	mb_esf_index_remove(index->ping_head, index->ping_next, mb_esf_index_slot(index, bin, MB_ESF_INDEX_PING), iedit);
+	mb_esf_index_remove(index->beam_head, index->beam_next, mb_esf_index_slot(index, bin, esf->edit[iedit].beam), iedit);
+}
+/*--------------------------------------------------------------------*/
+/* start a cursor over the edits that may match time_d and beam, where
+    beam is MB_ESF_INDEX_PING for all of the edits of a ping */
+static void mb_esf_cursor_init(const struct mb_esf_index_struct *index, double time_d, double maxtimediff, int beam,
+                               struct mb_esf_cursor_struct *cursor) {
+	const int *head = (beam == MB_ESF_INDEX_PING ? index->ping_head : index->beam_head);
+	cursor->next = (beam == MB_ESF_INDEX_PING ? index->ping_next : index->beam_next);
+	cursor->nchain = 0;
+	unsigned int slots[3];
+	const long long binmin = mb_esf_index_bin(index, time_d - maxtimediff);
+	const long long binmax = mb_esf_index_bin(index, time_d + maxtimediff);
+	for (long long bin = binmin; bin <= binmax && cursor->nchain < 3; bin++) {
+		const unsigned int slot = mb_esf_index_slot(index, bin, beam);
+		bool duplicate = false;
+		for (int k = 0; k < cursor->nchain; k++) {
+			if (slots[k] == slot)
+				duplicate = true;
+		}
+		if (!duplicate) {
+			slots[cursor->nchain] = slot;
+			cursor->chain[cursor->nchain++] = head[slot];
+		}
+	}
+}
+/*--------------------------------------------------------------------*/
+/* return the next edit number in ascending order, or -1 when done */
+static int mb_esf_cursor_next(struct mb_esf_cursor_struct *cursor) {
+	int kmin = -1;
+	for (int k = 0; k < cursor->nchain; k++) {
+		if (cursor->chain[k] >= 0 && (kmin < 0 || cursor->chain[k] < cursor->chain[kmin]))
+			kmin = k;
+	}
+	if (kmin < 0)
+		return (-1);
+	const int iedit = cursor->chain[kmin];
+	cursor->chain[kmin] = cursor->next[iedit];
+	return (iedit);
+}
+/*--------------------------------------------------------------------*/
+/* 	function mb_esf_index_free releases the edit index. */
+static int mb_esf_index_free(int verbose, struct mb_esf_struct *esf, int *error) {
+	int status = MB_SUCCESS;
+	struct mb_esf_index_struct *index = (struct mb_esf_index_struct *)esf->index;
+	if (index != NULL) {
+		if (index->ping_head != NULL)
+			status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&index->ping_head, error);
+		if (index->ping_next != NULL)
+			status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&index->ping_next, error);
+		if (index->beam_head != NULL)
+			status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&index->beam_head, error);
+		if (index->beam_next != NULL)
+			status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&index->beam_next, error);
+		status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&esf->index, error);
+	}
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+/* 	function mb_esf_index_build hashes the loaded edits by timestamp
+        and beam so that mb_esf_apply() can find the edits for each beam
+        of a ping directly, whatever order the pings are read in. */
+static int mb_esf_index_build(int verbose, struct mb_esf_struct *esf, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
+		fprintf(stderr, "dbg2       esf:              %p\n", (void *)esf);
+		fprintf(stderr, "dbg2       nedit:            %d\n", esf->nedit);
+	}
+
+	int status = mb_esf_index_free(verbose, esf, error);
+
+	if (status == MB_SUCCESS && esf->nedit > 0) {
+		status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mb_esf_index_struct), (void **)&esf->index, error);
+		struct mb_esf_index_struct *index = (struct mb_esf_index_struct *)esf->index;
+		unsigned int nslot = 16;
+		while (nslot < (unsigned int)esf->nedit && nslot < (1U << 30))
+			nslot <<= 1;
+		if (status == MB_SUCCESS) {
+			memset(index, 0, sizeof(struct mb_esf_index_struct));
+			index->binwidth = 2.0 * (esf->version == 1 ? MB_ESF_MAXTIMEDIFF_X10 : MB_ESF_MAXTIMEDIFF);
+			index->mask = nslot - 1;
+			status = mb_mallocd(verbose, __FILE__, __LINE__, nslot * sizeof(int), (void **)&index->ping_head, error);
+		}
+		if (status == MB_SUCCESS)
+			status = mb_mallocd(verbose, __FILE__, __LINE__, nslot * sizeof(int), (void **)&index->beam_head, error);
+		if (status == MB_SUCCESS)
+			status = mb_mallocd(verbose, __FILE__, __LINE__, esf->nedit * sizeof(int), (void **)&index->ping_next, error);
+		if (status == MB_SUCCESS)
+			status = mb_mallocd(verbose, __FILE__, __LINE__, esf->nedit * sizeof(int), (void **)&index->beam_next, error);
+		if (status == MB_SUCCESS) {
+			for (unsigned int i = 0; i < nslot; i++) {
+				index->ping_head[i] = -1;
+				index->beam_head[i] = -1;
+			}
+
+			/* linking in descending order puts each edit at the head of its chains */
+			for (int i = esf->nedit - 1; i >= 0; i--)
+				mb_esf_index_link(index, esf, i);
+		}
+		else {
+			int error2;
+			mb_esf_index_free(verbose, esf, &error2);
+			*error = MB_ERROR_MEMORY_FAIL;
+		}
+	}
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return value:\n");
+		fprintf(stderr, "dbg2       esf->index:       %p\n", esf->index);
+		fprintf(stderr, "dbg2       error:            %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:           %d\n", status);
+	}
+
+	return (status);
+}
+
+/* A compacted esf file holds, after the usual header, a block index and then
+    all of its edits sorted by time; edits saved afterwards are appended as
+    a journal following the sorted edits. The block index is stored in
+    MB_PATH_MAXLINE sized chunks that start with MB_ESF_INDEX_TAG, so that
+    readers not using the index skip the chunks as embedded headers. Each
+    chunk holds the timestamps of the first edits of MB_ESF_INDEX_PERCHUNK
+    blocks of MB_ESF_INDEX_BLOCK sorted edits. mb_esf_close() compacts an
+    esf file once its journal holds at least MB_ESF_COMPACT_MIN edits and
+    a quarter as many edits as the sorted section. */
+#define MB_ESF_RECORD_SIZE (sizeof(double) + 2 * sizeof(int))
+#define MB_ESF_INDEX_TAG "ESFVERSION03 BLOCK INDEX"
+#define MB_ESF_INDEX_TAGSIZE 32
+#define MB_ESF_INDEX_PERCHUNK ((MB_PATH_MAXLINE - MB_ESF_INDEX_TAGSIZE) / (int)sizeof(double))
+#define MB_ESF_INDEX_BLOCK 1024
+#define MB_ESF_COMPACT_MIN 65536
+
+/*--------------------------------------------------------------------*/
+/* get the size of the sorted section and the number of block index
+    chunks of a compacted esf file from its header */
+static void mb_esf_header_sorted(const char *esf_header, int *nsorted, int *blocksize, int *nchunk) {
+	*nsorted = 0;
+	*blocksize = 0;
+	*nchunk = 0;
+	const char *field;
+	if ((field = strstr(esf_header, "\nSorted Edits: ")) != NULL)
+		sscanf(field, "\nSorted Edits: %d", nsorted);
+	if ((field = strstr(esf_header, "\nBlock Size: ")) != NULL)
+		sscanf(field, "\nBlock Size: %d", blocksize);
+	if (*nsorted > 0 && *blocksize > 0) {
+		const int nblock = (*nsorted + *blocksize - 1) / *blocksize;
+		*nchunk = (nblock + MB_ESF_INDEX_PERCHUNK - 1) / MB_ESF_INDEX_PERCHUNK;
+	}
+	else {
+		*nsorted = 0;
+		*blocksize = 0;
+	}
+}
+/*--------------------------------------------------------------------*/
+/* read one edit, skipping over embedded headers and block index chunks */
+static int mb_esf_read_edit(FILE *esffp, bool byteswapped, struct mb_edit_struct *edit) {
+	mb_path esf_header;
+	while (true) {
+		if (fread(&edit->time_d, sizeof(double), 1, esffp) != 1 || fread(&edit->beam, sizeof(int), 1, esffp) != 1 ||
+		    fread(&edit->action, sizeof(int), 1, esffp) != 1)
+			return (MB_FAILURE);
+		if (byteswapped) {
+			mb_swap_double(&edit->time_d);
+			edit->beam = mb_swap_int(edit->beam);
+			edit->action = mb_swap_int(edit->action);
+		}
+		edit->use = 0;
+		if (edit->time_d < 4.29497e9)
+			return (MB_SUCCESS);
+		if (fread(esf_header, MB_PATH_MAXLINE - MB_ESF_RECORD_SIZE, 1, esffp) != 1)
+			return (MB_FAILURE);
+	}
+}
+/*--------------------------------------------------------------------*/
+/* add an edit to the esf structure, growing the edit array as needed */
+static int mb_esf_add_edit(int verbose, struct mb_esf_struct *esf, int *nalloc, const struct mb_edit_struct *edit,
+                           int *error) {
+	int status = MB_SUCCESS;
+	if (esf->nedit >= *nalloc) {
+		const int nalloc_new = (*nalloc > 0 ? 2 * *nalloc : MB_ESF_INDEX_BLOCK);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc_new * sizeof(struct mb_edit_struct), (void **)&esf->edit,
+		                     error);
+		if (status != MB_SUCCESS) {
+			*error = MB_ERROR_MEMORY_FAIL;
+			return (status);
+		}
+		*nalloc = nalloc_new;
+	}
+	esf->edit[esf->nedit] = *edit;
+	esf->nedit++;
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+/* check whether the journal of an esf file is long enough to compact */
+static bool mb_esf_journal_full(const char *esffile) {
+	struct stat file_status;
+	if (stat(esffile, &file_status) != 0 || (file_status.st_mode & S_IFMT) == S_IFDIR)
+		return (false);
+	FILE *esffp = fopen(esffile, "rb");
+	if (esffp == NULL)
+		return (false);
+	mb_path esf_header;
+	const bool header = (fread(esf_header, MB_PATH_MAXLINE, 1, esffp) == 1);
+	fclose(esffp);
+	if (!header || (strncmp(esf_header, "ESFVERSION03", 12) != 0 && strncmp(esf_header, "ESFVERSION02", 12) != 0))
+		return (false);
+	esf_header[MB_PATH_MAXLINE - 1] = '\0';
+	int nsorted, blocksize, nchunk;
+	mb_esf_header_sorted(esf_header, &nsorted, &blocksize, &nchunk);
+	const long long nrecord = (file_status.st_size - MB_PATH_MAXLINE) / MB_ESF_RECORD_SIZE;
+	const long long njournal = nrecord - nsorted - (long long)nchunk * (MB_PATH_MAXLINE / MB_ESF_RECORD_SIZE);
+	return (njournal >= MB_ESF_COMPACT_MIN && 4 * njournal >= nsorted);
+}
 /*--------------------------------------------------------------------*/
 /* 	function mb_esf_check checks for an existing esf file. */
 int mb_esf_check(int verbose, char *swathfile, char *esffile, int *found, int *error) {
@@ -121,7 +402,7 @@ int mb_esf_load(int verbose, const char *program_name, char *swathfile, bool loa
 	esf->edit = NULL;
 	esf->esffp = NULL;
 	esf->essfp = NULL;
-	esf->startnextsearch = 0;
+	esf->index = NULL;
 
 	/* get name of existing or new esffile, then load old edits
 	    and/or open new esf file */
@@ -195,7 +476,7 @@ int mb_esf_open(int verbose, const char *program_name, char *esffile, bool load,
 	esf->edit = NULL;
 	esf->esffp = NULL;
 	esf->essfp = NULL;
-	esf->startnextsearch = 0;
+	esf->index = NULL;
 
 	/* load edits from existing esf file if requested */
 	if (load) {
@@ -316,6 +597,9 @@ int mb_esf_open(int verbose, const char *program_name, char *esffile, bool load,
 				fprintf(stderr,"EDITS SORTED: i:%d edit: %f %d %d  use:%d\n",
 				i,esf->edit[i].time_d,esf->edit[i].beam,
 				esf->edit[i].action,esf->edit[i].use); */
+
+				/* index the edits by timestamp and beam */
+				status = mb_esf_index_build(verbose, esf, error);
 			}
 		}
 	}
@@ -397,7 +681,7 @@ int mb_esf_open(int verbose, const char *program_name, char *esffile, bool load,
 		fprintf(stderr, "dbg2       esf->essfp:            %p\n", (void *)esf->essfp);
 		fprintf(stderr, "dbg2       esf->byteswapped:      %d\n", esf->byteswapped);
 		fprintf(stderr, "dbg2       esf->version:          %d\n", esf->version);
-		fprintf(stderr, "dbg2       esf->startnextsearch:  %d\n", esf->startnextsearch);
+		fprintf(stderr, "dbg2       esf->index:            %p\n", esf->index);
 		fprintf(stderr, "dbg2       error:                 %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:                %d\n", status);
@@ -407,6 +691,181 @@ int mb_esf_open(int verbose, const char *program_name, char *esffile, bool load,
 	return (status);
 }
 
+/*--------------------------------------------------------------------*/
+/* 	function mb_esf_open_window loads the edits in an esf file whose
+        timestamps lie between time_d_min and time_d_max, allowing for
+        the timestamp matching tolerance. For a compacted esf file the
+        block index locates the sorted edits in the time window, so
+        that only those edits and the journal of edits saved since the
+        compaction are read. Other esf files are read in full. No
+        output esf file is opened, so this suits read-only loading
+        for pings whose time span is known (as in mbeditviz);
+        programs that rewrite the esf file or edit a whole swath
+        file use mb_esf_load(). */
+int mb_esf_open_window(int verbose, const char *program_name, char *esffile, double time_d_min, double time_d_max,
+                       struct mb_esf_struct *esf, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
+		fprintf(stderr, "dbg2       program_name:  %s\n", program_name);
+		fprintf(stderr, "dbg2       esffile:       %s\n", esffile);
+		fprintf(stderr, "dbg2       time_d_min:    %f\n", time_d_min);
+		fprintf(stderr, "dbg2       time_d_max:    %f\n", time_d_max);
+		fprintf(stderr, "dbg2       esf:           %p\n", (void *)esf);
+		fprintf(stderr, "dbg2       error:         %p\n", (void *)error);
+	}
+
+	int status = MB_SUCCESS;
+	*error = MB_ERROR_NO_ERROR;
+
+	/* initialize the esf structure */
+	strcpy(esf->esffile, esffile);
+	sprintf(esf->esstream, "%s.stream", esffile);
+	esf->byteswapped = mb_swap_check();
+	esf->version = 3;
+	esf->mode = MB_ESF_MODE_EXPLICIT;
+	esf->nedit = 0;
+	esf->edit = NULL;
+	esf->esffp = NULL;
+	esf->essfp = NULL;
+	esf->index = NULL;
+
+	struct stat file_status;
+	FILE *esffp = NULL;
+	const int fstat = stat(esffile, &file_status);
+	if (fstat == 0 && (file_status.st_mode & S_IFMT) != S_IFDIR && file_status.st_size > 0) {
+		if ((esffp = fopen(esffile, "rb")) == NULL) {
+			status = MB_FAILURE;
+			*error = MB_ERROR_OPEN_FAIL;
+			fprintf(stderr, "\nUnable to open edit save file %s\n", esffile);
+		}
+	}
+
+	if (status == MB_SUCCESS && esffp != NULL) {
+		/* read file header to discern the format and any block index */
+		mb_path esf_header;
+		int nsorted = 0;
+		int blocksize = 0;
+		int nchunk = 0;
+		if (fread(esf_header, MB_PATH_MAXLINE, 1, esffp) == 1 &&
+		    (strncmp(esf_header, "ESFVERSION03", 12) == 0 || strncmp(esf_header, "ESFVERSION02", 12) == 0)) {
+			esf_header[MB_PATH_MAXLINE - 1] = '\0';
+			if (strncmp(esf_header, "ESFVERSION03", 12) == 0) {
+				esf->version = 3;
+				sscanf(&esf_header[13], "ESF Mode: %d", &esf->mode);
+				mb_esf_header_sorted(esf_header, &nsorted, &blocksize, &nchunk);
+			}
+			else {
+				esf->version = 2;
+			}
+		}
+		else {
+			rewind(esffp);
+			esf->version = 1;
+		}
+		const double maxtimediff = (esf->version == 1 ? MB_ESF_MAXTIMEDIFF_X10 : MB_ESF_MAXTIMEDIFF);
+		const double time_d_start = time_d_min - maxtimediff;
+		const double time_d_end = time_d_max + maxtimediff;
+		int nalloc = 0;
+		struct mb_edit_struct edit;
+
+		/* read the sorted edits within the time window - the sorted edits are
+		    only ordered to within the timestamp tolerance, so the blocks read
+		    are widened by a few tolerances */
+		long journal = ftell(esffp);
+		double *blocktime = NULL;
+		if (nsorted > 0) {
+			const int nblock = (nsorted + blocksize - 1) / blocksize;
+			status = mb_mallocd(verbose, __FILE__, __LINE__, nblock * sizeof(double), (void **)&blocktime, error);
+			char chunk[MB_PATH_MAXLINE];
+			for (int ichunk = 0; ichunk < nchunk && status == MB_SUCCESS; ichunk++) {
+				if (fread(chunk, MB_PATH_MAXLINE, 1, esffp) != 1 || strncmp(chunk, MB_ESF_INDEX_TAG, strlen(MB_ESF_INDEX_TAG)) != 0) {
+					status = MB_FAILURE;
+					*error = MB_ERROR_BAD_FORMAT;
+				}
+				for (int i = 0; i < MB_ESF_INDEX_PERCHUNK && ichunk * MB_ESF_INDEX_PERCHUNK + i < nblock; i++) {
+					double *time_d = &blocktime[ichunk * MB_ESF_INDEX_PERCHUNK + i];
+					memcpy(time_d, &chunk[MB_ESF_INDEX_TAGSIZE + i * sizeof(double)], sizeof(double));
+					if (esf->byteswapped)
+						mb_swap_double(time_d);
+				}
+			}
+			if (status == MB_SUCCESS) {
+				const double margin = 4.0 * maxtimediff;
+				int kstart = 0;
+				int kend = nblock;
+				for (int k = 0; k < nblock && blocktime[k] <= time_d_start - margin; k++)
+					kstart = k;
+				for (int k = nblock - 1; k > kstart && blocktime[k] > time_d_end + margin; k--)
+					kend = k;
+				const long sorted = journal + (long)nchunk * MB_PATH_MAXLINE;
+				const int nread = MIN(kend * blocksize, nsorted) - kstart * blocksize;
+				journal = sorted + (long)nsorted * MB_ESF_RECORD_SIZE;
+				if (fseek(esffp, sorted + (long)kstart * blocksize * MB_ESF_RECORD_SIZE, SEEK_SET) != 0) {
+					status = MB_FAILURE;
+					*error = MB_ERROR_EOF;
+				}
+				for (int i = 0; i < nread && status == MB_SUCCESS; i++) {
+					if (mb_esf_read_edit(esffp, esf->byteswapped, &edit) != MB_SUCCESS) {
+						status = MB_FAILURE;
+						*error = MB_ERROR_EOF;
+					}
+					else if (edit.time_d >= time_d_start && edit.time_d <= time_d_end) {
+						status = mb_esf_add_edit(verbose, esf, &nalloc, &edit, error);
+					}
+				}
+			}
+			if (blocktime != NULL)
+				mb_freed(verbose, __FILE__, __LINE__, (void **)&blocktime, error);
+		}
+
+		/* read the journal, or all of the edits of an esf file without a block index */
+		if (status == MB_SUCCESS && fseek(esffp, journal, SEEK_SET) != 0) {
+			status = MB_FAILURE;
+			*error = MB_ERROR_EOF;
+		}
+		while (status == MB_SUCCESS && mb_esf_read_edit(esffp, esf->byteswapped, &edit) == MB_SUCCESS) {
+			if (edit.time_d >= time_d_start && edit.time_d <= time_d_end)
+				status = mb_esf_add_edit(verbose, esf, &nalloc, &edit, error);
+		}
+		fclose(esffp);
+
+		/* sort the edits and index them by timestamp and beam */
+		if (status == MB_SUCCESS && esf->nedit > 1) {
+			if (esf->version > 1)
+				mb_mergesort((char *)esf->edit, esf->nedit, sizeof(struct mb_edit_struct), mb_edit_compare);
+			else
+				mb_mergesort((char *)esf->edit, esf->nedit, sizeof(struct mb_edit_struct), mb_edit_compare_coarse);
+		}
+		if (status == MB_SUCCESS)
+			status = mb_esf_index_build(verbose, esf, error);
+		if (status != MB_SUCCESS) {
+			int error2;
+			if (esf->edit != NULL)
+				mb_freed(verbose, __FILE__, __LINE__, (void **)&esf->edit, &error2);
+			esf->nedit = 0;
+		}
+	}
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return value:\n");
+		fprintf(stderr, "dbg2       nedit:       %d\n", esf->nedit);
+		fprintf(stderr, "dbg2       mode:        %d\n", esf->mode);
+		for (int i = 0; i < esf->nedit; i++)
+			fprintf(stderr, "dbg2       edit event:  %d %.6f %5d %3d %3d\n", i, esf->edit[i].time_d, esf->edit[i].beam,
+			        esf->edit[i].action, esf->edit[i].use);
+		fprintf(stderr, "dbg2       esf->version:          %d\n", esf->version);
+		fprintf(stderr, "dbg2       esf->index:            %p\n", esf->index);
+		fprintf(stderr, "dbg2       error:                 %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:                %d\n", status);
+	}
+
+	return (status);
+}
+
 /*--------------------------------------------------------------------*/
 /* 	function mb_esf_fixtimestamps fixes timestamps of all edits
         in esf that are within tolerance of time_d - those timestamps
@@ -430,10 +889,16 @@ int mb_esf_fixtimestamps(int verbose, struct mb_esf_struct *esf, double time_d,
 	}
 
 	/* all edits that have timestamps within tolerance of time_d will have
-	their timestamps set to time_d */
+	their timestamps set to time_d - indexed edits are moved to the chains
+	for their new timestamps */
+	struct mb_esf_index_struct *index = (struct mb_esf_index_struct *)esf->index;
 	for (int j = 0; j < esf->nedit; j++) {
-		if (fabs(esf->edit[j].time_d - time_d) < tolerance) {
+		if (fabs(esf->edit[j].time_d - time_d) < tolerance && esf->edit[j].time_d != time_d) {
+			if (index != NULL)
+				mb_esf_index_unlink(index, esf, j);
 			esf->edit[j].time_d = time_d;
+			if (index != NULL)
+				mb_esf_index_link(index, esf, j);
 		}
 	}
 
@@ -458,7 +923,6 @@ int mb_esf_fixtimestamps(int verbose, struct mb_esf_struct *esf, double time_d,
     are saved to that file.  */
 int mb_esf_apply(int verbose, struct mb_esf_struct *esf, double time_d, int pingmultiplicity, int nbath, char *beamflag,
                  int *error) {
-	int firstedit, lastedit;
 	int action;
 	int beamoffset, beamoffsetmax;
 	char beamflagorg;
@@ -497,36 +961,30 @@ int mb_esf_apply(int verbose, struct mb_esf_struct *esf, double time_d, int ping
 	else
 		maxtimediff = MB_ESF_MAXTIMEDIFF;
 
-	/* find first and last edits for this ping - take ping multiplicity into account */
-	if (esf->nedit > 0 && esf->startnextsearch > 0
-		&& time_d < (esf->edit[esf->startnextsearch].time_d - maxtimediff)
-			&& time_d < (esf->edit[esf->startnextsearch - 1].time_d - maxtimediff))
-		firstedit = 0;
-	else if (esf->nedit > 0 && esf->startnextsearch > 0
-		&& fabs(time_d - esf->edit[esf->startnextsearch - 1].time_d) <= maxtimediff
-		&& (esf->edit[esf->startnextsearch - 1].beam < beamoffset
-				|| esf->edit[esf->startnextsearch-1].beam > beamoffsetmax))
-		firstedit = 0;
-	else
-		firstedit = esf->startnextsearch;
-	lastedit = firstedit - 1;
-	for (j = firstedit; j < esf->nedit && time_d >= (esf->edit[j].time_d - maxtimediff); j++) {
-		if (fabs(esf->edit[j].time_d - time_d) < maxtimediff && esf->edit[j].beam >= beamoffset &&
-		    esf->edit[j].beam < beamoffsetmax) {
-			if (lastedit < firstedit)
-				firstedit = j;
-			lastedit = j;
+	/* index the edits if that has not already been done */
+	int status = MB_SUCCESS;
+	if (esf->nedit > 0 && esf->index == NULL)
+		status = mb_esf_index_build(verbose, esf, error);
+	struct mb_esf_index_struct *index = (struct mb_esf_index_struct *)esf->index;
+
+	/* find the edits for this ping - take ping multiplicity into account -
+	    and check for edits with bad beam numbers */
+	bool found = false;
+	struct mb_esf_cursor_struct cursor;
+	if (index != NULL) {
+		mb_esf_cursor_init(index, time_d, maxtimediff, MB_ESF_INDEX_PING, &cursor);
+		for (j = mb_esf_cursor_next(&cursor); j >= 0; j = mb_esf_cursor_next(&cursor)) {
+			if (fabs(esf->edit[j].time_d - time_d) < maxtimediff && esf->edit[j].beam >= beamoffset &&
+			    esf->edit[j].beam < beamoffsetmax) {
+				found = true;
+				if ((esf->edit[j].beam % MB_ESF_MULTIPLICITY_FACTOR) >= nbath)
+					esf->edit[j].use += 10000;
+			}
 		}
 	}
 
 	/* apply edits */
-	if (lastedit >= firstedit) {
-		/* check for edits with bad beam numbers */
-		for (j = firstedit; j <= lastedit; j++) {
-			if ((esf->edit[j].beam % MB_ESF_MULTIPLICITY_FACTOR) >= nbath)
-				esf->edit[j].use += 10000;
-		}
-
+	if (found) {
 		bool apply;
 
 		/* loop over all beams */
@@ -534,10 +992,11 @@ int mb_esf_apply(int verbose, struct mb_esf_struct *esf, double time_d, int ping
 			/* apply beam offset for cases of multiple pings */
 			ibeam = i + beamoffset;
 
-			/* loop over all edits for this ping */
+			/* loop over all edits for this beam */
 			apply = false;
 			beamflagorg = beamflag[i];
-			for (j = firstedit; j <= lastedit; j++) {
+			mb_esf_cursor_init(index, time_d, maxtimediff, ibeam, &cursor);
+			for (j = mb_esf_cursor_next(&cursor); j >= 0; j = mb_esf_cursor_next(&cursor)) {
 				/* apply the edits for this beam in the
 				   order they were created so that the last
 				   edit event is applied last - only the
@@ -545,7 +1004,7 @@ int mb_esf_apply(int verbose, struct mb_esf_struct *esf, double time_d, int ping
 				   esf file - the overridden edit events
 				   may already be indicated by a use value
 				   of 100 or more. */
-				if (esf->edit[j].beam == ibeam && esf->edit[j].use < 100) {
+				if (esf->edit[j].beam == ibeam && fabs(esf->edit[j].time_d - time_d) < maxtimediff && esf->edit[j].use < 100) {
 					/* some actions only work on non-null beams */
 					if (!mb_beam_check_flag_unusable(beamflag[i])) {
 						if (esf->edit[j].action == MBP_EDIT_FLAG) {
@@ -629,15 +1088,8 @@ int mb_esf_apply(int verbose, struct mb_esf_struct *esf, double time_d, int ping
 			if (apply && esf->essfp != NULL && beamflag[i] != beamflagorg)
 				mb_ess_save(verbose, esf, time_d, ibeam, action, error);
 		}
-
-		/* reset startnextsearch */
-		esf->startnextsearch = lastedit + 1;
-		if (esf->startnextsearch >= esf->nedit)
-			esf->startnextsearch = esf->nedit - 1;
 	}
 
-	const int status = MB_SUCCESS;
-
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return value:\n");
@@ -792,11 +1244,13 @@ int mb_esf_close(int verbose, struct mb_esf_struct *esf, int *error) {
 	}*/
 
 	/* deallocate the arrays */
+	status = mb_esf_index_free(verbose, esf, error);
 	if (esf->edit != NULL)
 		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(esf->edit), error);
 	esf->nedit = 0;
 
 	/* close the esf file */
+	const bool output = (esf->esffp != NULL);
 	if (esf->esffp != NULL) {
 		fclose(esf->esffp);
 		esf->esffp = NULL;
@@ -808,6 +1262,11 @@ int mb_esf_close(int verbose, struct mb_esf_struct *esf, int *error) {
 		esf->essfp = NULL;
 	}
 
+	/* compact the esf file once the journal of edits saved since it was
+	    last compacted is long enough to slow loading */
+	if (output && status == MB_SUCCESS && mb_esf_journal_full(esf->esffile))
+		status = mb_esf_compact(verbose, __func__, esf->esffile, error);
+
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return value:\n");
@@ -824,6 +1283,121 @@ int mb_esf_close(int verbose, struct mb_esf_struct *esf, int *error) {
 	return (status);
 }
 
+/*--------------------------------------------------------------------*/
+/* 	function mb_esf_compact rewrites an esf file with all of its edits
+        sorted by time and preceded by a block index, so that
+        mb_esf_open_window() can load the edits of a time window without
+        reading the whole file. Edits with the same timestamp and beam
+        keep the order in which they were saved, so loading the compacted
+        file gives the same edits in the same order as before. Files
+        without a version header are left as they are. */
+int mb_esf_compact(int verbose, const char *program_name, char *esffile, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
+		fprintf(stderr, "dbg2       program_name:  %s\n", program_name);
+		fprintf(stderr, "dbg2       esffile:       %s\n", esffile);
+	}
+
+	struct mb_esf_struct esf;
+	int status = mb_esf_open(verbose, program_name, esffile, true, MBP_ESF_NOWRITE, &esf, error);
+
+	if (status == MB_SUCCESS && esf.version > 1 && esf.nedit > 0) {
+		/* the edits are written, not applied, so the index is not needed */
+		mb_esf_index_free(verbose, &esf, error);
+
+		/* write the compacted file alongside the original */
+		mb_pathplus compactfile;
+		snprintf(compactfile, sizeof(compactfile), "%s.compact", esffile);
+		FILE *esffp = fopen(compactfile, "wb");
+		if (esffp == NULL) {
+			status = MB_FAILURE;
+			*error = MB_ERROR_OPEN_FAIL;
+			fprintf(stderr, "Failed to open compacted esffile %s\n", compactfile);
+		}
+
+		/* write the header */
+		const int nblock = (esf.nedit + MB_ESF_INDEX_BLOCK - 1) / MB_ESF_INDEX_BLOCK;
+		const int nchunk = (nblock + MB_ESF_INDEX_PERCHUNK - 1) / MB_ESF_INDEX_PERCHUNK;
+		if (status == MB_SUCCESS) {
+			char user[256], host[256], date[32];
+			status = mb_user_host_date(verbose, user, host, date, error);
+			mb_path esf_header;
+			memset(esf_header, 0, MB_PATH_MAXLINE);
+			snprintf(esf_header, MB_PATH_MAXLINE,
+			        "ESFVERSION03\nESF Mode: %d\nMB-System Version %s\nProgram: %s\nUser: %s\nCPU: %s\nDate: %s\n"
+			        "Sorted Edits: %d\nBlock Size: %d\n",
+			        esf.mode, MB_VERSION, program_name, user, host, date, esf.nedit, MB_ESF_INDEX_BLOCK);
+			if (fwrite(esf_header, MB_PATH_MAXLINE, 1, esffp) != 1) {
+				status = MB_FAILURE;
+				*error = MB_ERROR_WRITE_FAIL;
+			}
+		}
+
+		/* write the block index */
+		for (int ichunk = 0; ichunk < nchunk && status == MB_SUCCESS; ichunk++) {
+			char chunk[MB_PATH_MAXLINE];
+			memset(chunk, 0, MB_PATH_MAXLINE);
+			strcpy(chunk, MB_ESF_INDEX_TAG);
+			for (int i = 0; i < MB_ESF_INDEX_PERCHUNK && ichunk * MB_ESF_INDEX_PERCHUNK + i < nblock; i++) {
+				double time_d = esf.edit[(ichunk * MB_ESF_INDEX_PERCHUNK + i) * MB_ESF_INDEX_BLOCK].time_d;
+				if (esf.byteswapped)
+					mb_swap_double(&time_d);
+				memcpy(&chunk[MB_ESF_INDEX_TAGSIZE + i * sizeof(double)], &time_d, sizeof(double));
+			}
+			if (fwrite(chunk, MB_PATH_MAXLINE, 1, esffp) != 1) {
+				status = MB_FAILURE;
+				*error = MB_ERROR_WRITE_FAIL;
+			}
+		}
+
+		/* write the sorted edits */
+		for (int i = 0; i < esf.nedit && status == MB_SUCCESS; i++) {
+			double time_d = esf.edit[i].time_d;
+			int beam = esf.edit[i].beam;
+			int action = esf.edit[i].action;
+			if (esf.byteswapped) {
+				mb_swap_double(&time_d);
+				beam = mb_swap_int(beam);
+				action = mb_swap_int(action);
+			}
+			if (fwrite(&time_d, sizeof(double), 1, esffp) != 1 || fwrite(&beam, sizeof(int), 1, esffp) != 1 ||
+			    fwrite(&action, sizeof(int), 1, esffp) != 1) {
+				status = MB_FAILURE;
+				*error = MB_ERROR_WRITE_FAIL;
+			}
+		}
+
+		/* replace the original file */
+		if (esffp != NULL && fclose(esffp) != 0 && status == MB_SUCCESS) {
+			status = MB_FAILURE;
+			*error = MB_ERROR_WRITE_FAIL;
+		}
+		if (status == MB_SUCCESS && rename(compactfile, esffile) != 0) {
+			status = MB_FAILURE;
+			*error = MB_ERROR_WRITE_FAIL;
+		}
+		if (status != MB_SUCCESS) {
+			remove(compactfile);
+			fprintf(stderr, "Failed to compact esffile %s\n", esffile);
+		}
+	}
+
+	int error2;
+	mb_esf_close(verbose, &esf, &error2);
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return value:\n");
+		fprintf(stderr, "dbg2       error:            %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:           %d\n", status);
+	}
+
+	return (status);
+}
+
 /*--------------------------------------------------------------------*/
 /* The following code has been modified from code obtained from
 	http://www.gnu-darwin.org/sources/4Darwin-x86/src/lib/libc/stdlib/merge.c
@@ -0,0 +1,314 @@
+/*--------------------------------------------------------------------
+ *    The MB-system:  mb_extract_batch.c  10/15/2026
+ *
+ *    Copyright (c) 2026 by
+ *    David W. Caress (caress@mbari.org)
+ *      Monterey Bay Aquarium Research Institute
+ *      Moss Landing, California, USA
+ *    Dale N. Chayes
+ *      Center for Coastal and Ocean Mapping
+ *      University of New Hampshire
+ *      Durham, New Hampshire, USA
+ *    Christian dos Santos Ferreira
+ *      MARUM
+ *      University of Bremen
+ *      Bremen Germany
+ *
+ *    MB-System was created by Caress and Chayes in 1992 at the
+ *      Lamont-Doherty Earth Observatory
+ *      Columbia University
+ *      Palisades, NY 10964
+ *
+ *    See README.md file for copying and redistribution conditions.
+ *--------------------------------------------------------------------*/
+/*
+ * mb_extract_batch.c reads survey pings from a file which has been
+ * initialized by mb_read_init() in batches, returning the navigation
+ * and beam values of many pings at once as a structure-of-arrays
+ * (struct mb_batch_struct, defined in mb_io.h). The per ping values
+ * (time, navigation, beam counts) are held in arrays indexed by ping,
+ * and the beams and pixels of all of the pings are packed contiguously
+ * into single arrays with per ping offsets, so that programs gridding,
+ * filtering or listing the data can loop over whole batches rather
+ * than handling one ping per function call.
+ *
+ * Each record is read with mb_read_ping() and its values are extracted
+ * by mb_get_all_extract() directly into the batch arrays, so the values
+ * are the same as a program would obtain by calling mb_get_all() itself
+ * and keeping only the survey records read successfully or following a
+ * time gap, without the beams passing through a single ping array.
+ * The batch arrays belong to the mbio descriptor and are released by
+ * mb_close().
+ *
+ * These functions include:
+ *   mb_extract_batch       - read the next batch of survey pings
+ *   mb_extract_batch_deall - release the batch arrays (used by mb_close)
+ *
+ * Author:  D. W. Caress
+ * Date:  15 October 2026
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+/* minimum number of packed beam values allocated */
+#define MB_EXTRACT_BATCH_ALLOC_MIN 4096
+
+/*--------------------------------------------------------------------*/
+/* allocate and set up the batch structure on first use */
+static int mb_extract_batch_init(int verbose, struct mb_io_struct *mb_io_ptr, int *error) {
+  const int status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mb_batch_struct), (void **)&mb_io_ptr->batch,
+                                error);
+  if (status == MB_SUCCESS) {
+    memset(mb_io_ptr->batch, 0, sizeof(struct mb_batch_struct));
+    mb_io_ptr->batch->error_pending = MB_ERROR_NO_ERROR;
+  }
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+/* make sure the per ping arrays can hold npings pings */
+static int mb_extract_batch_alloc_pings(int verbose, struct mb_batch_struct *batch, int npings, int *error) {
+  int status = MB_SUCCESS;
+  if (npings <= batch->npings_alloc)
+    return (status);
+
+  const size_t n = (size_t)npings;
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, 7 * n * sizeof(int), (void **)&batch->time_i, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(double), (void **)&batch->time_d, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(double), (void **)&batch->navlon, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(double), (void **)&batch->navlat, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(double), (void **)&batch->speed, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(double), (void **)&batch->heading, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(double), (void **)&batch->distance, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(double), (void **)&batch->altitude, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(double), (void **)&batch->sensordepth, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(int), (void **)&batch->nbath, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(int), (void **)&batch->namp, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(int), (void **)&batch->nss, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, (n + 1) * sizeof(int), (void **)&batch->bath_offset, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, (n + 1) * sizeof(int), (void **)&batch->amp_offset, error);
+  status &= mb_reallocd(verbose, __FILE__, __LINE__, (n + 1) * sizeof(int), (void **)&batch->ss_offset, error);
+  if (status == MB_SUCCESS)
+    batch->npings_alloc = npings;
+  else
+    *error = MB_ERROR_MEMORY_FAIL;
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+/* get the allocation size for nneeded packed values */
+static int mb_extract_batch_alloc_size(int nalloc, int nneeded) {
+  int nalloc_new = MAX(2 * nalloc, MB_EXTRACT_BATCH_ALLOC_MIN);
+  if (nalloc_new < nneeded)
+    nalloc_new = nneeded;
+  return (nalloc_new);
+}
+/*--------------------------------------------------------------------*/
+/* make sure the packed beam and pixel arrays can hold
+    nbath, namp and nss values - the beam flags are initialized
+    because mb_get_all_extract() nulls the flags it is given */
+static int mb_extract_batch_alloc_beams(int verbose, struct mb_batch_struct *batch, int nbath, int namp, int nss, int *error) {
+  int status = MB_SUCCESS;
+  if (nbath > batch->nbath_alloc) {
+    const int nalloc = mb_extract_batch_alloc_size(batch->nbath_alloc, nbath);
+    status &= mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(char), (void **)&batch->beamflag, error);
+    status &= mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&batch->bath, error);
+    status &= mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&batch->bathacrosstrack, error);
+    status &= mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&batch->bathalongtrack, error);
+    if (status == MB_SUCCESS) {
+      memset(&batch->beamflag[batch->nbath_alloc], 0, (nalloc - batch->nbath_alloc) * sizeof(char));
+      batch->nbath_alloc = nalloc;
+    }
+  }
+  if (status == MB_SUCCESS && namp > batch->namp_alloc) {
+    const int nalloc = mb_extract_batch_alloc_size(batch->namp_alloc, namp);
+    status &= mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&batch->amp, error);
+    if (status == MB_SUCCESS)
+      batch->namp_alloc = nalloc;
+  }
+  if (status == MB_SUCCESS && nss > batch->nss_alloc) {
+    const int nalloc = mb_extract_batch_alloc_size(batch->nss_alloc, nss);
+    status &= mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&batch->ss, error);
+    status &= mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&batch->ssacrosstrack, error);
+    status &= mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&batch->ssalongtrack, error);
+    if (status == MB_SUCCESS)
+      batch->nss_alloc = nalloc;
+  }
+  if (status != MB_SUCCESS)
+    *error = MB_ERROR_MEMORY_FAIL;
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_extract_batch(int verbose, void *mbio_ptr, int npings_want, int *npings, void **batch_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+    fprintf(stderr, "dbg2       npings_want: %d\n", npings_want);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  *npings = 0;
+  *batch_ptr = NULL;
+  *error = MB_ERROR_NO_ERROR;
+
+  /* get the batch structure, allocating it on first use */
+  int status = MB_SUCCESS;
+  if (mb_io_ptr->batch == NULL)
+    status = mb_extract_batch_init(verbose, mb_io_ptr, error);
+  struct mb_batch_struct *batch = mb_io_ptr->batch;
+  if (status == MB_SUCCESS)
+    status = mb_extract_batch_alloc_pings(verbose, batch, MAX(npings_want, 1), error);
+  if (status == MB_SUCCESS) {
+    batch->npings = 0;
+    batch->bath_offset[0] = 0;
+    batch->amp_offset[0] = 0;
+    batch->ss_offset[0] = 0;
+  }
+
+  /* a fatal error reached while filling the previous batch ends the read */
+  if (status == MB_SUCCESS && batch->error_pending != MB_ERROR_NO_ERROR) {
+    status = MB_FAILURE;
+    *error = batch->error_pending;
+  }
+
+  /* read until enough survey pings are found or a fatal error occurs,
+      extracting each record directly into the next slot of the batch
+      arrays - the packed arrays are first made large enough to hold
+      the largest ping read so far, which is the most that
+      mb_get_all_extract() will write */
+  bool done = status != MB_SUCCESS || npings_want <= 0;
+  while (!done) {
+    const int iping = batch->npings;
+    int kind = MB_DATA_NONE;
+    int read_error = MB_ERROR_NO_ERROR;
+    int read_status = mb_read_ping(verbose, mbio_ptr, mb_io_ptr->store_data, &kind, &read_error);
+
+    const int ibath = batch->bath_offset[iping];
+    const int iamp = batch->amp_offset[iping];
+    const int iss = batch->ss_offset[iping];
+    status = mb_extract_batch_alloc_beams(verbose, batch, ibath + mb_io_ptr->beams_bath_max,
+                                          iamp + mb_io_ptr->beams_amp_max, iss + mb_io_ptr->pixels_ss_max, error);
+    if (status != MB_SUCCESS)
+      break;
+
+    int nbath = 0;
+    int namp = 0;
+    int nss = 0;
+    char comment[MB_COMMENT_MAXLINE];
+    read_status = mb_get_all_extract(verbose, mbio_ptr, mb_io_ptr->store_data, read_status, &kind,
+                                     &batch->time_i[7 * iping], &batch->time_d[iping], &batch->navlon[iping],
+                                     &batch->navlat[iping], &batch->speed[iping], &batch->heading[iping],
+                                     &batch->distance[iping], &batch->altitude[iping], &batch->sensordepth[iping], &nbath,
+                                     &namp, &nss, &batch->beamflag[ibath], &batch->bath[ibath], &batch->amp[iamp],
+                                     &batch->bathacrosstrack[ibath], &batch->bathalongtrack[ibath], &batch->ss[iss],
+                                     &batch->ssacrosstrack[iss], &batch->ssalongtrack[iss], comment, &read_error);
+
+    if (read_error > MB_ERROR_NO_ERROR) {
+      batch->error_pending = read_error;
+      done = true;
+    }
+    else if ((read_status == MB_SUCCESS || read_error == MB_ERROR_TIME_GAP) && kind == MB_DATA_DATA) {
+      batch->nbath[iping] = nbath;
+      batch->namp[iping] = namp;
+      batch->nss[iping] = nss;
+      batch->bath_offset[iping + 1] = ibath + nbath;
+      batch->amp_offset[iping + 1] = iamp + namp;
+      batch->ss_offset[iping + 1] = iss + nss;
+      batch->npings++;
+      if (batch->npings >= npings_want)
+        done = true;
+    }
+  }
+
+  /* the batch is good if any pings were read, otherwise
+      return the error that ended the read */
+  if (status == MB_SUCCESS) {
+    *npings = batch->npings;
+    *batch_ptr = (void *)batch;
+    if (batch->npings > 0 || npings_want <= 0) {
+      *error = MB_ERROR_NO_ERROR;
+    }
+    else {
+      status = MB_FAILURE;
+      *error = batch->error_pending;
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       npings:      %d\n", *npings);
+    fprintf(stderr, "dbg2       batch_ptr:   %p\n", *batch_ptr);
+    if (status == MB_SUCCESS) {
+      for (int i = 0; i < batch->npings; i++)
+        fprintf(stderr, "dbg2       ping[%d]:  time_d:%f lon:%f lat:%f nbath:%d namp:%d nss:%d\n", i, batch->time_d[i],
+                batch->navlon[i], batch->navlat[i], batch->nbath[i], batch->namp[i], batch->nss[i]);
+    }
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+/* release the batch arrays */
+int mb_extract_batch_deall(int verbose, void *mbio_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  struct mb_batch_struct *batch = mb_io_ptr->batch;
+
+  int status = MB_SUCCESS;
+  if (batch != NULL) {
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->time_i, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->time_d, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->navlon, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->navlat, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->speed, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->heading, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->distance, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->altitude, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->sensordepth, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->nbath, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->namp, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->nss, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->bath_offset, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->amp_offset, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->ss_offset, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->beamflag, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->bath, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->bathacrosstrack, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->bathalongtrack, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->amp, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->ss, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->ssacrosstrack, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->ssalongtrack, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&mb_io_ptr->batch, error);
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
@@ -33,6 +33,12 @@
  *   mb_fileio_get  - get bytes from input
  *   mb_fileio_put  - put bytes to output
  *
+ * When the fileiobuffer default (see mbdefaults) is negative, files opened
+ * for reading are memory mapped and the FILE stream used by the i/o modules
+ * is opened onto the mapping with fmemopen(). Reads then become memory copies
+ * out of the mapping and fseek()/ftell() become simple offset updates, with
+ * no system call per record. Modules that use mbfp directly are unaffected.
+ *
  * Author:  D. W. Caress
  * Date:  23 May 2012
  */
@@ -40,6 +46,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "mb_define.h"
 #include "mb_io.h"
@@ -66,9 +78,55 @@ int mb_fileio_open(int verbose, void *mbio_ptr, int *error) {
 
   int buffer_error = MB_ERROR_NO_ERROR;
 
+  /* get the file i/o mode
+      fileiomode: mode of single normal file i/o:
+                      0   use fread() and fwrite() with standard buffering
+                      >0  use fread() and fwrite() with user defined buffer
+                      <0  use mmap for file i/o */
+  int fileiobuffer;
+  mb_fileiobuffer(verbose, &fileiobuffer);
+  mb_io_ptr->file_mmap = NULL;
+  mb_io_ptr->file_mmap_size = 0;
+
+#ifndef _WIN32
+  /* if reading and mmap i/o requested then map the entire file and open a
+      stream onto the mapping - fall back to normal fread() i/o if the file
+      cannot be mapped (e.g. zero length or special files) */
+  if (mb_io_ptr->filemode == MB_FILEMODE_READ && fileiobuffer < 0) {
+    const int fd = open(mb_io_ptr->file, O_RDONLY);
+    if (fd >= 0) {
+      struct stat file_status;
+      if (fstat(fd, &file_status) == 0 && S_ISREG(file_status.st_mode) && file_status.st_size > 0) {
+        void *file_mmap = mmap(NULL, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (file_mmap != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+          madvise(file_mmap, (size_t)file_status.st_size, MADV_SEQUENTIAL);
+#endif
+          if ((mb_io_ptr->mbfp = fmemopen(file_mmap, (size_t)file_status.st_size, "rb")) != NULL) {
+            /* unbuffered so that fread() copies directly out of the mapping */
+            setvbuf(mb_io_ptr->mbfp, NULL, _IONBF, 0);
+            mb_io_ptr->file_mmap = file_mmap;
+            mb_io_ptr->file_mmap_size = (size_t)file_status.st_size;
+          }
+          else {
+            munmap(file_mmap, (size_t)file_status.st_size);
+          }
+        }
+      }
+      close(fd);
+    }
+    if (verbose >= 4) {
+      if (mb_io_ptr->file_mmap != NULL)
+        fprintf(stderr, "dbg4  File %s memory mapped: %zu bytes\n", mb_io_ptr->file, mb_io_ptr->file_mmap_size);
+      else
+        fprintf(stderr, "dbg4  File %s could not be memory mapped, using fread()\n", mb_io_ptr->file);
+    }
+  }
+#endif
+
   /* open the file for reading */
   if (mb_io_ptr->filemode == MB_FILEMODE_READ) {
-    if ((mb_io_ptr->mbfp = fopen(mb_io_ptr->file, "rb")) == NULL) {
+    if (mb_io_ptr->mbfp == NULL && (mb_io_ptr->mbfp = fopen(mb_io_ptr->file, "rb")) == NULL) {
       *error = MB_ERROR_OPEN_FAIL;
       status = MB_FAILURE;
     }
@@ -80,14 +138,8 @@ int mb_fileio_open(int verbose, void *mbio_ptr, int *error) {
     }
   }
 
-  /* set buffering if desired
-      fileiomode: mode of single normal file i/o:
-                      0   use fread() and fwrite() with standard buffering
-                      >0  use fread() and fwrite() with user defined buffer
-                      <0  use mmap for file i/o */
-  int fileiobuffer;
+  /* set buffering if desired */
   if (status == MB_SUCCESS) {
-    mb_fileiobuffer(verbose, &fileiobuffer);
     if (fileiobuffer > 0) {
       /* the buffer size must be a multiple of 512, plus 8 to be efficient */
       const size_t fileiobufferbytes = (fileiobuffer * 1024) + 8;
@@ -125,12 +177,25 @@ int mb_fileio_close(int verbose, void *mbio_ptr, int *error) {
 
   struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
+  int status = MB_SUCCESS;
+
   if (mb_io_ptr->mbfp != NULL) {
     fclose(mb_io_ptr->mbfp);
     mb_io_ptr->mbfp = NULL;
   }
 
-  const int status = MB_SUCCESS;
+#ifndef _WIN32
+  /* release the memory mapping, if any, after the stream using it is closed */
+  if (mb_io_ptr->file_mmap != NULL) {
+    munmap(mb_io_ptr->file_mmap, mb_io_ptr->file_mmap_size);
+    mb_io_ptr->file_mmap = NULL;
+    mb_io_ptr->file_mmap_size = 0;
+  }
+#endif
+
+  /* release the user defined i/o buffer, if any */
+  if (mb_io_ptr->file_iobuffer != NULL)
+    status = mb_freed(verbose, __FILE__, __LINE__, (void **)&mb_io_ptr->file_iobuffer, error);
 
   if (verbose >= 2) {
     fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
@@ -2973,6 +2973,16 @@ int mb_get_format(int verbose, char *filename, char *fileroot, int *format, int
     }
   }
 
+  /* identify files not following any suffix convention from their contents */
+  if (!found) {
+    int probe_error = MB_ERROR_NO_ERROR;
+    if (mb_get_format_probe(verbose, filename, format, &probe_error) == MB_SUCCESS) {
+      if (fileroot != NULL)
+        strcpy(fileroot, filename);
+      found = true;
+    }
+  }
+
   /* finally check for parameter file */
   sprintf(parfile, "%s.par", filename);
   if (stat(parfile, &statbuf) == 0) {
@@ -0,0 +1,328 @@
+/*--------------------------------------------------------------------
+ *    The MB-system:  mb_format_probe.c  10/15/2026
+ *
+ *    Copyright (c) 2026 by
+ *    David W. Caress (caress@mbari.org)
+ *      Monterey Bay Aquarium Research Institute
+ *      Moss Landing, California, USA
+ *    Dale N. Chayes
+ *      Center for Coastal and Ocean Mapping
+ *      University of New Hampshire
+ *      Durham, New Hampshire, USA
+ *    Christian dos Santos Ferreira
+ *      MARUM
+ *      University of Bremen
+ *      Bremen Germany
+ *
+ *    MB-System was created by Caress and Chayes in 1992 at the
+ *      Lamont-Doherty Earth Observatory
+ *      Columbia University
+ *      Palisades, NY 10964
+ *
+ *    See README.md file for copying and redistribution conditions.
+ *--------------------------------------------------------------------*/
+/*
+ * mb_format_probe.c identifies the format of swath files whose names
+ * do not follow any of the suffix conventions recognized by
+ * mb_get_format(), which calls mb_get_format_probe() as a last resort.
+ *
+ * A current index sidecar file (file.idx, see mb_index.c) records the
+ * format of the swath file and is used when present. Otherwise the first
+ * MB_FORMAT_PROBE_SIZE bytes of the file are read and passed to the
+ * signature functions in the mb_format_signatures table, in order, until
+ * one returns a format id. Only formats whose leading records can be
+ * recognized unambiguously are included, and the more specific
+ * signatures are tried first.
+ *
+ * The results, including failures, are kept in a table keyed by path
+ * and validated against the size and modification time (to the
+ * nanosecond) of the file, so
+ * datalists naming the same files repeatedly only probe each file once
+ * per process.
+ *
+ * Author:  D. W. Caress
+ * Date:  15 October 2026
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "mb_define.h"
+#include "mb_format.h"
+#include "mb_status.h"
+#include "mbsys_simrad3.h"
+
+#define MB_FORMAT_PROBE_SIZE 4096
+#define MB_FORMAT_PROBE_NHASH 1024
+
+struct mb_format_signature_struct {
+  const char *name;
+  int (*check)(char *buffer, size_t size);
+};
+
+struct mb_format_probe_struct {
+  char *path;
+  mb_s_long size;
+  mb_s_long modtime;
+  mb_s_long modtime_nsec;
+  int format;
+  struct mb_format_probe_struct *next;
+};
+
+static struct mb_format_probe_struct *mb_format_probe_table[MB_FORMAT_PROBE_NHASH];
+static pthread_mutex_t mb_format_probe_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*--------------------------------------------------------------------*/
+/* Kongsberg *.kmall: little-endian datagram size followed by a "#XYZ"
+    datagram type, with the size repeated at the end of the datagram */
+static int mb_format_signature_kmall(char *buffer, size_t size) {
+  if (size < 20 || buffer[4] != '#')
+    return (0);
+  for (int i = 5; i < 8; i++)
+    if (buffer[i] < 'A' || buffer[i] > 'Z')
+      return (0);
+  int numbytes = 0;
+  int nanosec = 0;
+  mb_get_binary_int(true, &buffer[0], &numbytes);
+  mb_get_binary_int(true, &buffer[16], &nanosec);
+  if (numbytes < 24 || nanosec < 0 || nanosec >= 1000000000)
+    return (0);
+  if ((size_t)numbytes <= size) {
+    int numbytes_end = 0;
+    mb_get_binary_int(true, &buffer[numbytes - 4], &numbytes_end);
+    if (numbytes_end != numbytes)
+      return (0);
+  }
+  return (MBF_KEMKMALL);
+}
+/*--------------------------------------------------------------------*/
+/* Teledyne Reson *.s7k: data record frame with the 0x0000FFFF sync pattern */
+static int mb_format_signature_reson7k(char *buffer, size_t size) {
+  if (size < 64)
+    return (0);
+  unsigned short offset = 0;
+  int sync = 0;
+  int record_size = 0;
+  mb_get_binary_short(true, &buffer[2], &offset);
+  mb_get_binary_int(true, &buffer[4], &sync);
+  mb_get_binary_int(true, &buffer[8], &record_size);
+  if (sync != 0x0000FFFF || offset < 60 || record_size < 64)
+    return (0);
+  return (MBF_RESON7K3);
+}
+/*--------------------------------------------------------------------*/
+/* Generic Sensor Format: the first record is the header with the version string */
+static int mb_format_signature_gsf(char *buffer, size_t size) {
+  if (size < 16 || strncmp(&buffer[8], "GSF-v", 5) != 0)
+    return (0);
+  return (MBF_GSFGENMB);
+}
+/*--------------------------------------------------------------------*/
+/* Kongsberg *.all: datagram size followed by STX, the datagram type and the
+    sonar model, with ETX three bytes before the end of the datagram */
+static int mb_format_signature_simrad(char *buffer, size_t size) {
+  if (size < 24 || buffer[4] != 0x02)
+    return (0);
+  const int type = (mb_u_char)buffer[5];
+  if (type < 0x30 || type > 0x7A)
+    return (0);
+
+  /* the datagrams may be in either byte order */
+  for (int i = 0; i < 2; i++) {
+    const bool swapped = i == 1;
+    int numbytes = 0;
+    unsigned short sonar = 0;
+    mb_get_binary_int(swapped, &buffer[0], &numbytes);
+    mb_get_binary_short(swapped, &buffer[6], &sonar);
+    if (numbytes < 16 || numbytes > 1000000 || sonar == 0)
+      continue;
+    if ((size_t)numbytes + 4 <= size && buffer[numbytes + 1] != 0x03)
+      continue;
+    if (sonar == MBSYS_SIMRAD3_M3 || sonar == MBSYS_SIMRAD3_EM710 || sonar == MBSYS_SIMRAD3_EM712 ||
+        sonar == MBSYS_SIMRAD3_EM850 || sonar == MBSYS_SIMRAD3_EM302 || sonar == MBSYS_SIMRAD3_EM304 ||
+        sonar == MBSYS_SIMRAD3_EM122 || sonar == MBSYS_SIMRAD3_EM124 || sonar == MBSYS_SIMRAD3_EM2040 ||
+        sonar == MBSYS_SIMRAD3_EM2045)
+      return (MBF_EM710RAW);
+    return (MBF_EM300RAW);
+  }
+  return (0);
+}
+/*--------------------------------------------------------------------*/
+/* Edgetech *.jsf: message headers starting with the 0x1601 marker */
+static int mb_format_signature_jstar(char *buffer, size_t size) {
+  if (size < 16)
+    return (0);
+  unsigned short marker = 0;
+  int record_size = 0;
+  mb_get_binary_short(true, &buffer[0], &marker);
+  mb_get_binary_int(true, &buffer[12], &record_size);
+  if (marker != 0x1601 || record_size < 0)
+    return (0);
+
+  /* the marker is short, so also check the next message if possible */
+  if ((size_t)record_size + 18 <= size) {
+    mb_get_binary_short(true, &buffer[record_size + 16], &marker);
+    if (marker != 0x1601)
+      return (0);
+  }
+  return (MBF_EDGJSTAR);
+}
+/*--------------------------------------------------------------------*/
+/* Triton *.xtf: file header with the 0x7B format byte and system type 1 */
+static int mb_format_signature_xtf(char *buffer, size_t size) {
+  if (size < 1024 || (mb_u_char)buffer[0] != 0x7B || buffer[1] != 1)
+    return (0);
+  for (int i = 2; i < 10 && buffer[i] != '\0'; i++)
+    if (buffer[i] < ' ' || buffer[i] > '~')
+      return (0);
+  return (MBF_XTFR8101);
+}
+/*--------------------------------------------------------------------*/
+/* HYSWEEP *.HSX: text file starting with the FTP and HSX records */
+static int mb_format_signature_hysweep(char *buffer, size_t size) {
+  if (size < 16 || strncmp(buffer, "FTP ", 4) != 0)
+    return (0);
+  const char *newline = memchr(buffer, '\n', size);
+  if (newline == NULL || (size_t)(newline - buffer) + 4 >= size || strncmp(newline + 1, "HSX ", 4) != 0)
+    return (0);
+  return (MBF_HYSWEEP1);
+}
+/*--------------------------------------------------------------------*/
+/* SEG-Y: 3200 byte text header of 80 character cards starting with 'C' in
+    EBCDIC or ASCII, then a binary header with a valid sample format code */
+static int mb_format_signature_segy(char *buffer, size_t size) {
+  if (size < 3600)
+    return (0);
+  const int card = (mb_u_char)buffer[0];
+  if ((card != 0xC3 && card != 'C') || (mb_u_char)buffer[80] != card || (mb_u_char)buffer[160] != card)
+    return (0);
+  short sample_format = 0;
+  mb_get_binary_short(false, &buffer[3224], &sample_format);
+  if (sample_format < 1 || sample_format > 8)
+    return (0);
+  return (MBF_SEGYSEGY);
+}
+/*--------------------------------------------------------------------*/
+
+/* signature functions in the order they are tried */
+static const struct mb_format_signature_struct mb_format_signatures[] = {
+    {"kmall", mb_format_signature_kmall},
+    {"reson7k", mb_format_signature_reson7k},
+    {"gsf", mb_format_signature_gsf},
+    {"simrad", mb_format_signature_simrad},
+    {"jstar", mb_format_signature_jstar},
+    {"xtf", mb_format_signature_xtf},
+    {"hysweep", mb_format_signature_hysweep},
+    {"segy", mb_format_signature_segy},
+};
+
+/*--------------------------------------------------------------------*/
+static unsigned mb_format_probe_hash(const char *path) {
+  unsigned hash = 2166136261u;
+  for (const char *c = path; *c != '\0'; c++)
+    hash = (hash ^ (mb_u_char)*c) * 16777619u;
+  return (hash % MB_FORMAT_PROBE_NHASH);
+}
+/*--------------------------------------------------------------------*/
+int mb_get_format_probe(int verbose, char *filename, int *format, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:   %d\n", verbose);
+    fprintf(stderr, "dbg2       filename:  %s\n", filename);
+  }
+
+  *format = 0;
+  *error = MB_ERROR_NO_ERROR;
+
+  struct stat file_status;
+  const bool file_ok = stat(filename, &file_status) == 0 && (file_status.st_mode & S_IFMT) != S_IFDIR;
+  const unsigned hash = mb_format_probe_hash(filename);
+
+  /* look for an earlier result for this file */
+  bool cached = false;
+  if (file_ok) {
+    pthread_mutex_lock(&mb_format_probe_mutex);
+    for (struct mb_format_probe_struct *probe = mb_format_probe_table[hash]; probe != NULL; probe = probe->next) {
+      if (strcmp(probe->path, filename) == 0) {
+        if (probe->size == (mb_s_long)file_status.st_size && probe->modtime == (mb_s_long)file_status.st_mtim.tv_sec
+            && probe->modtime_nsec == (mb_s_long)file_status.st_mtim.tv_nsec) {
+          *format = probe->format;
+          cached = true;
+        }
+        break;
+      }
+    }
+    pthread_mutex_unlock(&mb_format_probe_mutex);
+  }
+
+  /* use the format recorded in the index sidecar file if it is current,
+      otherwise test the start of the file against the format signatures */
+  if (file_ok && !cached) {
+    int index_error = MB_ERROR_NO_ERROR;
+    if (mb_index_format(verbose, filename, format, &index_error) != MB_SUCCESS) {
+      FILE *fp = fopen(filename, "rb");
+      if (fp != NULL) {
+        char buffer[MB_FORMAT_PROBE_SIZE];
+        const size_t size = fread(buffer, 1, MB_FORMAT_PROBE_SIZE, fp);
+        fclose(fp);
+        const int nsignature = sizeof(mb_format_signatures) / sizeof(mb_format_signatures[0]);
+        for (int i = 0; i < nsignature && *format == 0; i++) {
+          *format = mb_format_signatures[i].check(buffer, size);
+          if (*format != 0 && verbose >= 2)
+            fprintf(stderr, "dbg2       signature: %s\n", mb_format_signatures[i].name);
+        }
+      }
+    }
+
+    /* remember the result, replacing any out of date entry for the file */
+    pthread_mutex_lock(&mb_format_probe_mutex);
+    struct mb_format_probe_struct *probe = mb_format_probe_table[hash];
+    while (probe != NULL && strcmp(probe->path, filename) != 0)
+      probe = probe->next;
+    if (probe == NULL && (probe = calloc(1, sizeof(struct mb_format_probe_struct))) != NULL) {
+      if ((probe->path = strdup(filename)) != NULL) {
+        probe->next = mb_format_probe_table[hash];
+        mb_format_probe_table[hash] = probe;
+      }
+      else {
+        free(probe);
+        probe = NULL;
+      }
+    }
+    if (probe != NULL) {
+      probe->size = (mb_s_long)file_status.st_size;
+      probe->modtime = (mb_s_long)file_status.st_mtim.tv_sec;
+      probe->modtime_nsec = (mb_s_long)file_status.st_mtim.tv_nsec;
+      probe->format = *format;
+    }
+    pthread_mutex_unlock(&mb_format_probe_mutex);
+  }
+
+  int status = MB_SUCCESS;
+  if (!file_ok) {
+    status = MB_FAILURE;
+    *error = MB_ERROR_OPEN_FAIL;
+  }
+  else if (*format == 0) {
+    status = MB_FAILURE;
+    *error = MB_ERROR_BAD_FORMAT;
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return value:\n");
+    fprintf(stderr, "dbg2       cached:     %d\n", cached);
+    fprintf(stderr, "dbg2       format:     %d\n", *format);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:     %d\n", status);
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
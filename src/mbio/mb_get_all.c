@@ -44,54 +44,31 @@
 #include "mb_status.h"
 
 /*--------------------------------------------------------------------*/
-int mb_get_all(int verbose, void *mbio_ptr, void **store_ptr, int *kind, int time_i[7], double *time_d, double *navlon,
-               double *navlat, double *speed, double *heading, double *distance, double *altitude, double *sensordepth, int *nbath,
-               int *namp, int *nss, char *beamflag, double *bath, double *amp, double *bathacrosstrack, double *bathalongtrack,
-               double *ss, double *ssacrosstrack, double *ssalongtrack, char *comment, int *error) {
+/* extract the values of a record just read by mb_read_ping() into the
+    arrays given, applying alternative navigation and calculating speed
+    and distance and checking the bounds as mb_get_all() does - read_status
+    and the values of kind and error on input are those returned by
+    mb_read_ping(), and the arrays must hold the beams_bath_max,
+    beams_amp_max and pixels_ss_max values of the mbio descriptor */
+int mb_get_all_extract(int verbose, void *mbio_ptr, void *store_ptr, int read_status, int *kind, int time_i[7],
+                       double *time_d, double *navlon, double *navlat, double *speed, double *heading, double *distance,
+                       double *altitude, double *sensordepth, int *nbath, int *namp, int *nss, char *beamflag, double *bath,
+                       double *amp, double *bathacrosstrack, double *bathalongtrack, double *ss, double *ssacrosstrack,
+                       double *ssalongtrack, char *comment, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:      %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:   %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       read_status: %d\n", read_status);
+		fprintf(stderr, "dbg2       kind:        %d\n", *kind);
+		fprintf(stderr, "dbg2       error:       %d\n", *error);
 	}
 
-	/* get mbio and data structure descriptors */
+	/* get mbio descriptor */
 	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-	*store_ptr = mb_io_ptr->store_data;
-
-	/* reset status */
-	*error = MB_ERROR_NO_ERROR;
-
-	if (verbose >= 4) {
-		fprintf(stderr, "\ndbg2  About to read ping in function <%s>\n", __func__);
-		fprintf(stderr, "dbg2       ping_count:    %d\n", mb_io_ptr->ping_count);
-		fprintf(stderr, "dbg2       error:         %d\n", *error);
-	}
-
-	int status = mb_read_ping(verbose, mbio_ptr, *store_ptr, kind, error);
-
-	/* if io arrays have been reallocated, update the
-	    pointers of arrays passed into this function,
-	    as these pointers may have changed */
-	if (status == MB_SUCCESS && mb_io_ptr->new_kind == MB_DATA_DATA) {
-		if (mb_io_ptr->bath_arrays_reallocated) {
-			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&beamflag, error);
-			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&bath, error);
-			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&bathacrosstrack, error);
-			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&bathalongtrack, error);
-			mb_io_ptr->bath_arrays_reallocated = false;
-		}
-		if (mb_io_ptr->amp_arrays_reallocated) {
-			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&amp, error);
-			mb_io_ptr->amp_arrays_reallocated = false;
-		}
-		if (mb_io_ptr->ss_arrays_reallocated) {
-			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&ss, error);
-			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&ssacrosstrack, error);
-			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&ssalongtrack, error);
-			mb_io_ptr->ss_arrays_reallocated = false;
-		}
-	}
+	int status = read_status;
 
 	/* if survey data read into storage array */
 	if (status == MB_SUCCESS &&
@@ -129,19 +106,19 @@ int mb_get_all(int verbose, void *mbio_ptr, void **store_ptr, int *kind, int tim
 
 		/* get the data */
 		status =
-		    mb_extract(verbose, mbio_ptr, *store_ptr, kind, time_i, time_d, navlon, navlat, speed, heading, nbath, namp, nss,
+		    mb_extract(verbose, mbio_ptr, store_ptr, kind, time_i, time_d, navlon, navlat, speed, heading, nbath, namp, nss,
 		               beamflag, bath, amp, bathacrosstrack, bathalongtrack, ss, ssacrosstrack, ssalongtrack, comment, error);
 		if (status == MB_SUCCESS && (*kind == MB_DATA_DATA || *kind == MB_DATA_CALIBRATE || *kind == MB_DATA_SUBBOTTOM_MCS ||
 		                             *kind == MB_DATA_SUBBOTTOM_CNTRBEAM || *kind == MB_DATA_SUBBOTTOM_SUBBOTTOM ||
 		                             *kind == MB_DATA_SIDESCAN2 || *kind == MB_DATA_SIDESCAN3 || *kind == MB_DATA_WATER_COLUMN)) {
-			status = mb_extract_altitude(verbose, mbio_ptr, *store_ptr, kind, sensordepth, altitude, error);
+			status = mb_extract_altitude(verbose, mbio_ptr, store_ptr, kind, sensordepth, altitude, error);
 		}
 		if (status == MB_SUCCESS &&
 		    (*kind == MB_DATA_NAV || *kind == MB_DATA_NAV1 || *kind == MB_DATA_NAV2 || *kind == MB_DATA_NAV3)) {
 			double roll;
 			double pitch;
 			double heave;
-			status = mb_extract_nav(verbose, mbio_ptr, *store_ptr, kind, time_i, time_d, navlon, navlat, speed, heading,
+			status = mb_extract_nav(verbose, mbio_ptr, store_ptr, kind, time_i, time_d, navlon, navlat, speed, heading,
 			                        sensordepth, &roll, &pitch, &heave, error);
 		}
 	}
@@ -378,6 +355,72 @@ int mb_get_all(int verbose, void *mbio_ptr, void **store_ptr, int *kind, int tim
 		mb_io_ptr->old_nlat = *navlat;
 	}
 
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_get_all(int verbose, void *mbio_ptr, void **store_ptr, int *kind, int time_i[7], double *time_d, double *navlon,
+               double *navlat, double *speed, double *heading, double *distance, double *altitude, double *sensordepth, int *nbath,
+               int *namp, int *nss, char *beamflag, double *bath, double *amp, double *bathacrosstrack, double *bathalongtrack,
+               double *ss, double *ssacrosstrack, double *ssalongtrack, char *comment, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+	}
+
+	/* get mbio and data structure descriptors */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	*store_ptr = mb_io_ptr->store_data;
+
+	/* reset status */
+	*error = MB_ERROR_NO_ERROR;
+
+	if (verbose >= 4) {
+		fprintf(stderr, "\ndbg2  About to read ping in function <%s>\n", __func__);
+		fprintf(stderr, "dbg2       ping_count:    %d\n", mb_io_ptr->ping_count);
+		fprintf(stderr, "dbg2       error:         %d\n", *error);
+	}
+
+	int status = mb_read_ping(verbose, mbio_ptr, *store_ptr, kind, error);
+
+	/* if io arrays have been reallocated, update the
+	    pointers of arrays passed into this function,
+	    as these pointers may have changed */
+	if (status == MB_SUCCESS && mb_io_ptr->new_kind == MB_DATA_DATA) {
+		if (mb_io_ptr->bath_arrays_reallocated) {
+			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&beamflag, error);
+			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&bath, error);
+			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&bathacrosstrack, error);
+			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&bathalongtrack, error);
+			mb_io_ptr->bath_arrays_reallocated = false;
+		}
+		if (mb_io_ptr->amp_arrays_reallocated) {
+			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&amp, error);
+			mb_io_ptr->amp_arrays_reallocated = false;
+		}
+		if (mb_io_ptr->ss_arrays_reallocated) {
+			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&ss, error);
+			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&ssacrosstrack, error);
+			status &= mb_update_arrayptr(verbose, mbio_ptr, (void **)&ssalongtrack, error);
+			mb_io_ptr->ss_arrays_reallocated = false;
+		}
+	}
+
+	/* extract the values from the record */
+	status = mb_get_all_extract(verbose, mbio_ptr, *store_ptr, status, kind, time_i, time_d, navlon, navlat, speed, heading,
+	                            distance, altitude, sensordepth, nbath, namp, nss, beamflag, bath, amp, bathacrosstrack,
+	                            bathalongtrack, ss, ssacrosstrack, ssalongtrack, comment, error);
+
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return values:\n");
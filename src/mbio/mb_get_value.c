@@ -32,6 +32,7 @@
 
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -216,6 +217,193 @@ int mb_put_binary_long(bool swapped, mb_s_long value, void *buffer) {
 	return (0);
 }
 /*--------------------------------------------------------------------*/
+/*	The array and strided functions below copy n binary values from a
+ *	buffer in one call, swapping if necessary. They are used by the
+ *	format drivers to decode beam and sample arrays. The swap loops are
+ *	plain C written so that the compiler can vectorize them (SSE2, AVX2,
+ *	NEON, ...) without any instruction set specific code, and they work
+ *	with unaligned buffers. The array functions allow the buffer and
+ *	values to be the same array so data read directly into the output
+ *	can be swapped in place. The strided functions read values separated
+ *	by stride bytes in the buffer (e.g. one field of each beam record)
+ *	and write values separated by value_stride bytes (e.g. one member of
+ *	each element of an array of structures).
+ */
+#ifdef BYTESWAPPED
+#define MB_GET_VALUE_SWAP(swapped) (!(swapped))
+#else
+#define MB_GET_VALUE_SWAP(swapped) (swapped)
+#endif
+
+static inline uint16_t mb_get_value_swap2(uint16_t value) {
+	return (uint16_t)((value << 8) | (value >> 8));
+}
+static inline uint32_t mb_get_value_swap4(uint32_t value) {
+	return (value << 24) | ((value << 8) & 0x00ff0000u) | ((value >> 8) & 0x0000ff00u) | (value >> 24);
+}
+static inline uint64_t mb_get_value_swap8(uint64_t value) {
+	return ((uint64_t)mb_get_value_swap4((uint32_t)value) << 32) | mb_get_value_swap4((uint32_t)(value >> 32));
+}
+/*--------------------------------------------------------------------*/
+static void mb_get_binary_strided2(bool swap, int n, const void *buffer, size_t stride, void *values,
+                                   size_t value_stride) {
+	const unsigned char *in = (const unsigned char *)buffer;
+	unsigned char *out = (unsigned char *)values;
+	uint16_t value;
+	if (swap) {
+		for (int i = 0; i < n; i++) {
+			memcpy(&value, &in[i * stride], sizeof(value));
+			value = mb_get_value_swap2(value);
+			memcpy(&out[i * value_stride], &value, sizeof(value));
+		}
+	}
+	else {
+		for (int i = 0; i < n; i++)
+			memcpy(&out[i * value_stride], &in[i * stride], sizeof(value));
+	}
+}
+/*--------------------------------------------------------------------*/
+static void mb_get_binary_strided4(bool swap, int n, const void *buffer, size_t stride, void *values,
+                                   size_t value_stride) {
+	const unsigned char *in = (const unsigned char *)buffer;
+	unsigned char *out = (unsigned char *)values;
+	uint32_t value;
+	if (swap) {
+		for (int i = 0; i < n; i++) {
+			memcpy(&value, &in[i * stride], sizeof(value));
+			value = mb_get_value_swap4(value);
+			memcpy(&out[i * value_stride], &value, sizeof(value));
+		}
+	}
+	else {
+		for (int i = 0; i < n; i++)
+			memcpy(&out[i * value_stride], &in[i * stride], sizeof(value));
+	}
+}
+/*--------------------------------------------------------------------*/
+static void mb_get_binary_strided8(bool swap, int n, const void *buffer, size_t stride, void *values,
+                                   size_t value_stride) {
+	const unsigned char *in = (const unsigned char *)buffer;
+	unsigned char *out = (unsigned char *)values;
+	uint64_t value;
+	if (swap) {
+		for (int i = 0; i < n; i++) {
+			memcpy(&value, &in[i * stride], sizeof(value));
+			value = mb_get_value_swap8(value);
+			memcpy(&out[i * value_stride], &value, sizeof(value));
+		}
+	}
+	else {
+		for (int i = 0; i < n; i++)
+			memcpy(&out[i * value_stride], &in[i * stride], sizeof(value));
+	}
+}
+/*--------------------------------------------------------------------*/
+/*	function mb_get_binary_short_array copies n binary shorts from
+ *	a buffer, swapping if necessary
+ */
+int mb_get_binary_short_array(bool swapped, int n, const void *buffer, void *values) {
+	if (n > 0 && values != buffer)
+		memmove(values, buffer, n * sizeof(short));
+	if (n > 0 && MB_GET_VALUE_SWAP(swapped))
+		mb_get_binary_strided2(true, n, values, sizeof(short), values, sizeof(short));
+	return (0);
+}
+/*--------------------------------------------------------------------*/
+/*	function mb_get_binary_int_array copies n binary ints from
+ *	a buffer, swapping if necessary
+ */
+int mb_get_binary_int_array(bool swapped, int n, const void *buffer, void *values) {
+	if (n > 0 && values != buffer)
+		memmove(values, buffer, n * sizeof(int));
+	if (n > 0 && MB_GET_VALUE_SWAP(swapped))
+		mb_get_binary_strided4(true, n, values, sizeof(int), values, sizeof(int));
+	return (0);
+}
+/*--------------------------------------------------------------------*/
+/*	function mb_get_binary_float_array copies n binary floats from
+ *	a buffer, swapping if necessary
+ */
+int mb_get_binary_float_array(bool swapped, int n, const void *buffer, void *values) {
+	if (n > 0 && values != buffer)
+		memmove(values, buffer, n * sizeof(float));
+	if (n > 0 && MB_GET_VALUE_SWAP(swapped))
+		mb_get_binary_strided4(true, n, values, sizeof(float), values, sizeof(float));
+	return (0);
+}
+/*--------------------------------------------------------------------*/
+/*	function mb_get_binary_double_array copies n binary doubles from
+ *	a buffer, swapping if necessary
+ */
+int mb_get_binary_double_array(bool swapped, int n, const void *buffer, void *values) {
+	if (n > 0 && values != buffer)
+		memmove(values, buffer, n * sizeof(double));
+	if (n > 0 && MB_GET_VALUE_SWAP(swapped))
+		mb_get_binary_strided8(true, n, values, sizeof(double), values, sizeof(double));
+	return (0);
+}
+/*--------------------------------------------------------------------*/
+/*	function mb_get_binary_short_strided copies n binary shorts
+ *	spaced stride bytes apart in a buffer to values spaced
+ *	value_stride bytes apart, swapping if necessary
+ */
+int mb_get_binary_short_strided(bool swapped, int n, const void *buffer, size_t stride, void *values,
+                                size_t value_stride) {
+	mb_get_binary_strided2(MB_GET_VALUE_SWAP(swapped), n, buffer, stride, values, value_stride);
+	return (0);
+}
+/*--------------------------------------------------------------------*/
+/*	function mb_get_binary_int_strided copies n binary ints
+ *	spaced stride bytes apart in a buffer to values spaced
+ *	value_stride bytes apart, swapping if necessary
+ */
+int mb_get_binary_int_strided(bool swapped, int n, const void *buffer, size_t stride, void *values,
+                              size_t value_stride) {
+	mb_get_binary_strided4(MB_GET_VALUE_SWAP(swapped), n, buffer, stride, values, value_stride);
+	return (0);
+}
+/*--------------------------------------------------------------------*/
+/*	function mb_get_binary_float_strided copies n binary floats
+ *	spaced stride bytes apart in a buffer to values spaced
+ *	value_stride bytes apart, swapping if necessary
+ */
+int mb_get_binary_float_strided(bool swapped, int n, const void *buffer, size_t stride, void *values,
+                                size_t value_stride) {
+	mb_get_binary_strided4(MB_GET_VALUE_SWAP(swapped), n, buffer, stride, values, value_stride);
+	return (0);
+}
+/*--------------------------------------------------------------------*/
+/*	function mb_get_binary_double_strided copies n binary doubles
+ *	spaced stride bytes apart in a buffer to values spaced
+ *	value_stride bytes apart, swapping if necessary
+ */
+int mb_get_binary_double_strided(bool swapped, int n, const void *buffer, size_t stride, void *values,
+                                 size_t value_stride) {
+	mb_get_binary_strided8(MB_GET_VALUE_SWAP(swapped), n, buffer, stride, values, value_stride);
+	return (0);
+}
+/*--------------------------------------------------------------------*/
+/*	function mb_get_binary_short_int_strided copies n binary shorts
+ *	spaced stride bytes apart in a buffer to ints spaced value_stride
+ *	bytes apart, swapping if necessary and treating the shorts as
+ *	unsigned if is_unsigned is true
+ */
+int mb_get_binary_short_int_strided(bool swapped, bool is_unsigned, int n, const void *buffer, size_t stride,
+                                    void *values, size_t value_stride) {
+	const unsigned char *in = (const unsigned char *)buffer;
+	unsigned char *out = (unsigned char *)values;
+	const bool swap = MB_GET_VALUE_SWAP(swapped);
+	for (int i = 0; i < n; i++) {
+		uint16_t raw;
+		memcpy(&raw, &in[i * stride], sizeof(raw));
+		if (swap)
+			raw = mb_get_value_swap2(raw);
+		const int value = is_unsigned ? (int)raw : (int)(int16_t)raw;
+		memcpy(&out[i * value_stride], &value, sizeof(value));
+	}
+	return (0);
+}
+/*--------------------------------------------------------------------*/
 /*	function mb_get_bounds interprets longitude and
  *	latitude values in decimal degrees and degrees:minutes:seconds
  *	form. This code derives from code in GMT (gmt_init.c).
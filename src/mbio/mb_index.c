@@ -0,0 +1,613 @@
+/*--------------------------------------------------------------------
+ *    The MB-system:  mb_index.c  10/15/2026
+ *
+ *    Copyright (c) 2026 by
+ *    David W. Caress (caress@mbari.org)
+ *      Monterey Bay Aquarium Research Institute
+ *      Moss Landing, California, USA
+ *    Dale N. Chayes
+ *      Center for Coastal and Ocean Mapping
+ *      University of New Hampshire
+ *      Durham, New Hampshire, USA
+ *    Christian dos Santos Ferreira
+ *      MARUM
+ *      University of Bremen
+ *      Bremen Germany
+ *
+ *    MB-System was created by Caress and Chayes in 1992 at the
+ *      Lamont-Doherty Earth Observatory
+ *      Columbia University
+ *      Palisades, NY 10964
+ *
+ *    See README.md file for copying and redistribution conditions.
+ *--------------------------------------------------------------------*/
+/*
+ * mb_index.c contains the functions handling the format independent
+ * record index sidecar files. For a swath file named file, the index
+ * file named file.idx holds the byte offset, data record kind, time,
+ * ping number and navigation of every record returned by mb_read_ping().
+ * These files are generated by mbdatalist -O (through mb_make_info(),
+ * which builds the index during the same read that produces the *.inf,
+ * *.fbt and *.fnv ancillary files).
+ *
+ * When mb_read_init() opens a file in a format whose i/o module can
+ * start reading at any record boundary (indicated by the index_seekable
+ * flag set when the format is registered), and a current index file
+ * exists, the index is used to skip directly to the first data record
+ * within the requested time and location bounds. The first record of
+ * the file is always read normally so that any file header is parsed,
+ * and reading resumes at least MB_INDEX_LEADIN records and
+ * MB_INDEX_LEADIN_TIME seconds before the first wanted record. The lead in
+ * lets the i/o module accumulate asynchronous navigation and attitude
+ * before the first wanted ping, and any partial ping assembled from the
+ * lead in is outside the requested bounds and is discarded in the normal
+ * fashion.
+ *
+ * The index file is a little-endian binary file consisting of a
+ * MB_INDEX_HEADER_SIZE byte header:
+ *     char[8]   "MBIDX001"
+ *     int       format id
+ *     int       number of records
+ *     long      size of the swath file in bytes
+ *     long      modification time of the swath file
+ * followed by MB_INDEX_RECORD_SIZE byte records:
+ *     long      byte offset of the record in the swath file
+ *     double    time_d (seconds since 1/1/1970), zero if not a data record
+ *     double    navigation longitude, zero if not a data record
+ *     double    navigation latitude, zero if not a data record
+ *     int       ping number, zero if not a data record or not recorded in the format
+ *     int       data record kind
+ *
+ * These functions include:
+ *   mb_index_make  - generate an index file by reading the swath file
+ *   mb_index_seekable  - check whether an opened swath file can be indexed
+ *   mb_index_add  - add the record just read by mb_read_ping() to an index
+ *   mb_index_write  - write an index file
+ *   mb_index_read  - read an index file if it exists and is current
+ *   mb_index_format  - get the format id from a current index file
+ *   mb_index_seek_init  - set up reading to start from the index, called by mb_read_init()
+ *
+ * Author:  D. W. Caress
+ * Date:  15 October 2026
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+/*--------------------------------------------------------------------*/
+int mb_index_make(int verbose, bool force, char *file, int format, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       force:      %d\n", force);
+    fprintf(stderr, "dbg2       file:       %s\n", file);
+    fprintf(stderr, "dbg2       format:     %d\n", format);
+  }
+
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+
+  /* check for existing index file */
+  char idxfile[MB_PATH_MAXLINE];
+  snprintf(idxfile, sizeof(idxfile), "%s%s", file, MB_INDEX_SUFFIX);
+  struct stat file_status;
+  long datmodtime = 0;
+  if (stat(file, &file_status) == 0 && (file_status.st_mode & S_IFMT) != S_IFDIR) {
+    datmodtime = file_status.st_mtime;
+  }
+  long idxmodtime = 0;
+  if (stat(idxfile, &file_status) == 0 && (file_status.st_mode & S_IFMT) != S_IFDIR && file_status.st_size > 0) {
+    idxmodtime = file_status.st_mtime;
+  }
+  if (datmodtime == 0 || (!force && idxmodtime >= datmodtime)) {
+    if (verbose >= 2) {
+      fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+      fprintf(stderr, "dbg2  Return values:\n");
+      fprintf(stderr, "dbg2       error:      %d\n", *error);
+      fprintf(stderr, "dbg2  Return status:\n");
+      fprintf(stderr, "dbg2       status:     %d\n", status);
+    }
+    return (status);
+  }
+
+  /* open the swath file with no bounds or time restrictions */
+  int pings = 1;
+  int lonflip = 0;
+  double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+  int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+  int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+  double speedmin = 0.0;
+  double timegap = 1000000000.0;
+  double btime_d;
+  double etime_d;
+  int beams_bath;
+  int beams_amp;
+  int pixels_ss;
+  void *mbio_ptr = NULL;
+  status = mb_read_init(verbose, file, format, pings, lonflip, bounds, btime_i, etime_i, speedmin, timegap, &mbio_ptr,
+                        &btime_d, &etime_d, &beams_bath, &beams_amp, &pixels_ss, error);
+  if (status != MB_SUCCESS) {
+    if (verbose >= 2) {
+      fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+      fprintf(stderr, "dbg2  Return values:\n");
+      fprintf(stderr, "dbg2       error:      %d\n", *error);
+      fprintf(stderr, "dbg2  Return status:\n");
+      fprintf(stderr, "dbg2       status:     %d\n", status);
+    }
+    return (status);
+  }
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+  /* only formats that can be read from any record boundary get index files */
+  if (!mb_index_seekable(verbose, mbio_ptr)) {
+    status = mb_close(verbose, &mbio_ptr, error);
+    if (verbose >= 2) {
+      fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+      fprintf(stderr, "dbg2  Return values:\n");
+      fprintf(stderr, "dbg2       error:      %d\n", *error);
+      fprintf(stderr, "dbg2  Return status:\n");
+      fprintf(stderr, "dbg2       status:     %d\n", status);
+    }
+    return (status);
+  }
+
+  if (verbose >= 1)
+    fprintf(stderr, "Generating idx file for %s\n", file);
+
+  /* the file is read here in its entirety, so disable any index based seek */
+  mb_io_ptr->index_seek_pending = false;
+
+  /* read every record, saving the file position at the start of each read */
+  void *store_ptr = NULL;
+  status = mb_get_store(verbose, mbio_ptr, &store_ptr, error);
+  void *fileindex = NULL;
+  int num_fileindex = 0;
+  int num_fileindex_alloc = 0;
+  bool done = (status != MB_SUCCESS);
+  while (!done) {
+    const long offset = ftell(mb_io_ptr->mbfp);
+    int kind = MB_DATA_NONE;
+    status = mb_read_ping(verbose, mbio_ptr, store_ptr, &kind, error);
+    if (status == MB_SUCCESS) {
+      if (mb_index_add(verbose, mbio_ptr, store_ptr, offset, kind, &num_fileindex, &num_fileindex_alloc, &fileindex,
+                       error) != MB_SUCCESS)
+        done = true;
+    }
+    else if (*error > MB_ERROR_NO_ERROR) {
+      done = true;
+    }
+  }
+
+  /* close the swath file */
+  int close_error = MB_ERROR_NO_ERROR;
+  mb_close(verbose, &mbio_ptr, &close_error);
+
+  /* write the index file */
+  status = mb_index_write(verbose, file, format, num_fileindex, fileindex, error);
+
+  if (fileindex != NULL) {
+    int mem_error = MB_ERROR_NO_ERROR;
+    mb_freed(verbose, __FILE__, __LINE__, (void **)&fileindex, &mem_error);
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       num_fileindex: %d\n", num_fileindex);
+    fprintf(stderr, "dbg2       error:         %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:        %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+bool mb_index_seekable(int verbose, void *mbio_ptr) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+  }
+
+  /* only formats that can be read from any record boundary, read from
+      regular files, are indexed */
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  const bool seekable = mb_io_ptr->index_seekable && mb_io_ptr->mbfp != NULL && mb_io_ptr->mbfp != stdin
+      && (mb_io_ptr->filetype == MB_FILETYPE_NORMAL || mb_io_ptr->filetype == MB_FILETYPE_SINGLE);
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       seekable:   %d\n", seekable);
+  }
+
+  return (seekable);
+}
+/*--------------------------------------------------------------------*/
+int mb_index_add(int verbose, void *mbio_ptr, void *store_ptr, long offset, int kind, int *num_fileindex,
+                 int *num_fileindex_alloc, void **fileindex_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:             %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:            %p\n", (void *)mbio_ptr);
+    fprintf(stderr, "dbg2       store_ptr:           %p\n", (void *)store_ptr);
+    fprintf(stderr, "dbg2       offset:              %ld\n", offset);
+    fprintf(stderr, "dbg2       kind:                %d\n", kind);
+    fprintf(stderr, "dbg2       num_fileindex:       %d\n", *num_fileindex);
+    fprintf(stderr, "dbg2       num_fileindex_alloc: %d\n", *num_fileindex_alloc);
+    fprintf(stderr, "dbg2       fileindex_ptr:       %p\n", *fileindex_ptr);
+  }
+
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+
+  /* make room for the record */
+  if (*num_fileindex >= *num_fileindex_alloc) {
+    *num_fileindex_alloc += MB_INDEX_ALLOC_CHUNK;
+    status = mb_reallocd(verbose, __FILE__, __LINE__, *num_fileindex_alloc * sizeof(struct mb_io_fileindex_struct),
+                         fileindex_ptr, error);
+    if (status != MB_SUCCESS) {
+      *num_fileindex_alloc = 0;
+      *num_fileindex = 0;
+    }
+  }
+
+  /* save the offset and kind, and the time, navigation and ping number of data records */
+  if (status == MB_SUCCESS) {
+    struct mb_io_fileindex_struct *record = &((struct mb_io_fileindex_struct *)*fileindex_ptr)[*num_fileindex];
+    memset(record, 0, sizeof(struct mb_io_fileindex_struct));
+    record->offset = offset;
+    record->kind = kind;
+    if (kind == MB_DATA_DATA) {
+      int nav_error = MB_ERROR_NO_ERROR;
+      int nav_kind = kind;
+      int time_i[7];
+      double speed, heading, draft, roll, pitch, heave;
+      mb_extract_nav(verbose, mbio_ptr, store_ptr, &nav_kind, time_i, &record->time_d, &record->navlon,
+                     &record->navlat, &speed, &heading, &draft, &roll, &pitch, &heave, &nav_error);
+
+      /* the ping count that mb_pingnumber() otherwise falls back on depends
+          on how the file is being read, so only ping numbers recorded in
+          the data are indexed */
+      struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+      unsigned int pingnumber = 0;
+      if (mb_io_ptr->mb_io_pingnumber != NULL && mb_pingnumber(verbose, mbio_ptr, &pingnumber, &nav_error) == MB_SUCCESS)
+        record->ping_number = pingnumber;
+    }
+    (*num_fileindex)++;
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       num_fileindex:       %d\n", *num_fileindex);
+    fprintf(stderr, "dbg2       num_fileindex_alloc: %d\n", *num_fileindex_alloc);
+    fprintf(stderr, "dbg2       fileindex_ptr:       %p\n", *fileindex_ptr);
+    fprintf(stderr, "dbg2       error:               %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:              %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_index_write(int verbose, char *file, int format, int num_fileindex, void *fileindex_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
+    fprintf(stderr, "dbg2       file:          %s\n", file);
+    fprintf(stderr, "dbg2       format:        %d\n", format);
+    fprintf(stderr, "dbg2       num_fileindex: %d\n", num_fileindex);
+    fprintf(stderr, "dbg2       fileindex_ptr: %p\n", (void *)fileindex_ptr);
+  }
+
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  struct mb_io_fileindex_struct *fileindex = (struct mb_io_fileindex_struct *)fileindex_ptr;
+
+  /* the index header records the size and modification time of the swath file */
+  char idxfile[MB_PATH_MAXLINE];
+  snprintf(idxfile, sizeof(idxfile), "%s%s", file, MB_INDEX_SUFFIX);
+  struct stat file_status;
+  long datmodtime = 0;
+  long datsize = 0;
+  if (stat(file, &file_status) == 0 && (file_status.st_mode & S_IFMT) != S_IFDIR) {
+    datmodtime = file_status.st_mtime;
+    datsize = file_status.st_size;
+  }
+
+  FILE *fp = NULL;
+  if (num_fileindex > 0 && (fp = fopen(idxfile, "wb")) == NULL) {
+    status = MB_FAILURE;
+    *error = MB_ERROR_OPEN_FAIL;
+  }
+  else if (num_fileindex > 0) {
+    char buffer[MB_INDEX_HEADER_SIZE];
+    memcpy(buffer, MB_INDEX_MAGIC, 8);
+    mb_put_binary_int(true, format, &buffer[8]);
+    mb_put_binary_int(true, num_fileindex, &buffer[12]);
+    mb_put_binary_long(true, (mb_s_long)datsize, &buffer[16]);
+    mb_put_binary_long(true, (mb_s_long)datmodtime, &buffer[24]);
+    if (fwrite(buffer, MB_INDEX_HEADER_SIZE, 1, fp) != 1) {
+      status = MB_FAILURE;
+      *error = MB_ERROR_WRITE_FAIL;
+    }
+    for (int i = 0; i < num_fileindex && status == MB_SUCCESS; i++) {
+      mb_put_binary_long(true, (mb_s_long)fileindex[i].offset, &buffer[0]);
+      mb_put_binary_double(true, fileindex[i].time_d, &buffer[8]);
+      mb_put_binary_double(true, fileindex[i].navlon, &buffer[16]);
+      mb_put_binary_double(true, fileindex[i].navlat, &buffer[24]);
+      mb_put_binary_int(true, (int)fileindex[i].ping_number, &buffer[32]);
+      mb_put_binary_int(true, fileindex[i].kind, &buffer[36]);
+      if (fwrite(buffer, MB_INDEX_RECORD_SIZE, 1, fp) != 1) {
+        status = MB_FAILURE;
+        *error = MB_ERROR_WRITE_FAIL;
+      }
+    }
+    fclose(fp);
+    if (status != MB_SUCCESS)
+      remove(idxfile);
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:     %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_index_read(int verbose, char *file, int format, int *num_fileindex, void **fileindex_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       file:       %s\n", file);
+    fprintf(stderr, "dbg2       format:     %d\n", format);
+  }
+
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  *num_fileindex = 0;
+  struct mb_io_fileindex_struct *fileindex = NULL;
+
+  /* the index is only valid if it matches the current size and
+      modification time of the swath file */
+  char idxfile[MB_PATH_MAXLINE];
+  snprintf(idxfile, sizeof(idxfile), "%s%s", file, MB_INDEX_SUFFIX);
+  struct stat file_status;
+  FILE *fp = NULL;
+  if (stat(file, &file_status) != 0 || (file_status.st_mode & S_IFMT) == S_IFDIR
+      || (fp = fopen(idxfile, "rb")) == NULL) {
+    status = MB_FAILURE;
+    *error = MB_ERROR_FILE_NOT_FOUND;
+  }
+  else {
+    char buffer[MB_INDEX_HEADER_SIZE];
+    int idx_format = 0;
+    int num_records = 0;
+    mb_s_long datsize = 0;
+    mb_s_long datmodtime = 0;
+    if (fread(buffer, MB_INDEX_HEADER_SIZE, 1, fp) == 1 && strncmp(buffer, MB_INDEX_MAGIC, 8) == 0) {
+      mb_get_binary_int(true, &buffer[8], &idx_format);
+      mb_get_binary_int(true, &buffer[12], &num_records);
+      mb_get_binary_long(true, &buffer[16], &datsize);
+      mb_get_binary_long(true, &buffer[24], &datmodtime);
+    }
+    if (idx_format != format || num_records <= 0 || datsize != (mb_s_long)file_status.st_size
+        || datmodtime != (mb_s_long)file_status.st_mtime) {
+      status = MB_FAILURE;
+      *error = MB_ERROR_BAD_DATA;
+    }
+    if (status == MB_SUCCESS)
+      status = mb_mallocd(verbose, __FILE__, __LINE__, num_records * sizeof(struct mb_io_fileindex_struct),
+                          (void **)&fileindex, error);
+    for (int i = 0; i < num_records && status == MB_SUCCESS; i++) {
+      if (fread(buffer, MB_INDEX_RECORD_SIZE, 1, fp) == 1) {
+        mb_s_long offset;
+        int ping_number;
+        mb_get_binary_long(true, &buffer[0], &offset);
+        fileindex[i].offset = (long)offset;
+        mb_get_binary_double(true, &buffer[8], &fileindex[i].time_d);
+        mb_get_binary_double(true, &buffer[16], &fileindex[i].navlon);
+        mb_get_binary_double(true, &buffer[24], &fileindex[i].navlat);
+        mb_get_binary_int(true, &buffer[32], &ping_number);
+        fileindex[i].ping_number = (unsigned int)ping_number;
+        mb_get_binary_int(true, &buffer[36], &fileindex[i].kind);
+      }
+      else {
+        status = MB_FAILURE;
+        *error = MB_ERROR_EOF;
+      }
+    }
+    fclose(fp);
+    if (status == MB_SUCCESS) {
+      *num_fileindex = num_records;
+    }
+    else if (fileindex != NULL) {
+      int mem_error = MB_ERROR_NO_ERROR;
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&fileindex, &mem_error);
+    }
+  }
+  *fileindex_ptr = (void *)fileindex;
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       num_fileindex: %d\n", *num_fileindex);
+    fprintf(stderr, "dbg2       fileindex_ptr: %p\n", *fileindex_ptr);
+    fprintf(stderr, "dbg2       error:         %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:        %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_index_format(int verbose, char *file, int *format, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       file:       %s\n", file);
+  }
+
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  *format = 0;
+
+  /* only the header is read, and as for mb_index_read() it must match
+      the current size and modification time of the swath file */
+  char idxfile[MB_PATH_MAXLINE];
+  snprintf(idxfile, sizeof(idxfile), "%s%s", file, MB_INDEX_SUFFIX);
+  struct stat file_status;
+  FILE *fp = NULL;
+  if (stat(file, &file_status) != 0 || (file_status.st_mode & S_IFMT) == S_IFDIR
+      || (fp = fopen(idxfile, "rb")) == NULL) {
+    status = MB_FAILURE;
+    *error = MB_ERROR_FILE_NOT_FOUND;
+  }
+  else {
+    char buffer[MB_INDEX_HEADER_SIZE];
+    int idx_format = 0;
+    int num_records = 0;
+    mb_s_long datsize = 0;
+    mb_s_long datmodtime = 0;
+    if (fread(buffer, MB_INDEX_HEADER_SIZE, 1, fp) == 1 && strncmp(buffer, MB_INDEX_MAGIC, 8) == 0) {
+      mb_get_binary_int(true, &buffer[8], &idx_format);
+      mb_get_binary_int(true, &buffer[12], &num_records);
+      mb_get_binary_long(true, &buffer[16], &datsize);
+      mb_get_binary_long(true, &buffer[24], &datmodtime);
+    }
+    fclose(fp);
+    if (idx_format <= 0 || num_records <= 0 || datsize != (mb_s_long)file_status.st_size
+        || datmodtime != (mb_s_long)file_status.st_mtime) {
+      status = MB_FAILURE;
+      *error = MB_ERROR_BAD_DATA;
+    }
+    else {
+      *format = idx_format;
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       format:        %d\n", *format);
+    fprintf(stderr, "dbg2       error:         %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:        %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_index_seek_init(int verbose, void *mbio_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+  int status = MB_SUCCESS;
+  mb_io_ptr->index_seek_pending = false;
+  mb_io_ptr->index_seek_offset = 0;
+
+  /* use an index only for seekable formats read from regular files */
+  if (mb_index_seekable(verbose, mbio_ptr)) {
+    int num_fileindex = 0;
+    struct mb_io_fileindex_struct *fileindex = NULL;
+    int index_error = MB_ERROR_NO_ERROR;
+    if (mb_index_read(verbose, mb_io_ptr->file, mb_io_ptr->format, &num_fileindex, (void **)&fileindex, &index_error)
+        == MB_SUCCESS) {
+      /* find the first data record within the time and location bounds */
+      int ifirst = -1;
+      for (int i = 0; i < num_fileindex && ifirst < 0; i++) {
+        if (fileindex[i].kind == MB_DATA_DATA && fileindex[i].time_d >= mb_io_ptr->btime_d
+            && fileindex[i].time_d <= mb_io_ptr->etime_d) {
+          double navlon = fileindex[i].navlon;
+          const double navlat = fileindex[i].navlat;
+          if (navlon == 0.0 && navlat == 0.0) {
+            ifirst = i;
+          }
+          else {
+            if (mb_io_ptr->lonflip < 0) {
+              if (navlon > 0.)
+                navlon = navlon - 360.;
+              else if (navlon < -360.)
+                navlon = navlon + 360.;
+            }
+            else if (mb_io_ptr->lonflip == 0) {
+              if (navlon > 180.)
+                navlon = navlon - 360.;
+              else if (navlon < -180.)
+                navlon = navlon + 360.;
+            }
+            else {
+              if (navlon > 360.)
+                navlon = navlon - 360.;
+              else if (navlon < 0.)
+                navlon = navlon + 360.;
+            }
+            if (navlon >= mb_io_ptr->bounds[0] && navlon <= mb_io_ptr->bounds[1] && navlat >= mb_io_ptr->bounds[2]
+                && navlat <= mb_io_ptr->bounds[3])
+              ifirst = i;
+          }
+        }
+      }
+
+      /* find the start of the lead in - the last data record at least
+          MB_INDEX_LEADIN records and MB_INDEX_LEADIN_TIME seconds earlier */
+      int istart = -1;
+      for (int i = ifirst - MB_INDEX_LEADIN; i > 0 && istart < 0; i--) {
+        if (fileindex[i].kind == MB_DATA_DATA && fileindex[i].time_d <= fileindex[ifirst].time_d - MB_INDEX_LEADIN_TIME)
+          istart = i;
+      }
+
+      /* the first record is always read normally, so only seek if the
+          lead in starts beyond it */
+      if (istart > 1) {
+        mb_io_ptr->index_seek_pending = true;
+        mb_io_ptr->index_seek_offset = fileindex[istart].offset;
+      }
+
+      if (verbose >= 4) {
+        fprintf(stderr, "\ndbg4  Record index read in MBIO function <%s>\n", __func__);
+        fprintf(stderr, "dbg4       num_fileindex:      %d\n", num_fileindex);
+        fprintf(stderr, "dbg4       first record:       %d\n", ifirst);
+        fprintf(stderr, "dbg4       seek pending:       %d\n", mb_io_ptr->index_seek_pending);
+        fprintf(stderr, "dbg4       seek offset:        %ld\n", mb_io_ptr->index_seek_offset);
+      }
+
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&fileindex, &index_error);
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:     %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
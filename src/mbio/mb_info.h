@@ -35,6 +35,9 @@
 #ifndef MB_INFO_H_
 #define MB_INFO_H_
 
+#include <stdbool.h>
+#include <stdio.h>
+
 #define MB_INFO_MASK_DIM 20
 
 /* structure holding output of mbinfo -N -G */
@@ -122,6 +125,11 @@ extern "C" {
 int mb_info_init(int verbose, struct mb_info_struct *mb_info, int *error);
 int mb_get_info(int verbose, char *file, struct mb_info_struct *mb_info, int lonflip, int *error);
 int mb_get_info_datalist(int verbose, char *read_file, int *format, struct mb_info_struct *mb_info, int lonflip, int *error);
+int mb_info_print_file(int verbose, FILE *output, char *file, int format, int *error);
+int mb_info_print_totals(int verbose, FILE *output, struct mb_info_struct *mb_info, int time_start_i[7],
+                         int time_end_i[7], bool bathy_in_meters, int *notice_list, int *error);
+int mb_info_print_notices(int verbose, FILE *output, int *notice_list, int *error);
+int mb_info_print_mask(int verbose, FILE *output, int mask_nx, int mask_ny, int *mask, int *error);
 
 #ifdef __cplusplus
 }  /* extern "C" */
@@ -432,6 +432,25 @@ struct mb_io_indextable_struct {
     mb_u_char read;
 };
 
+/* format independent record index sidecar file (*.idx) defines, see mb_index.c */
+#define MB_INDEX_SUFFIX ".idx"
+#define MB_INDEX_MAGIC "MBIDX001"
+#define MB_INDEX_HEADER_SIZE 32
+#define MB_INDEX_RECORD_SIZE 40
+#define MB_INDEX_ALLOC_CHUNK 4096
+#define MB_INDEX_LEADIN 4
+#define MB_INDEX_LEADIN_TIME 10.0
+
+/* MBIO record index sidecar storage structure */
+struct mb_io_fileindex_struct {
+    long offset;
+    double time_d;
+    double navlon;
+    double navlat;
+    unsigned int ping_number;
+    int kind;
+};
+
 /* MBIO ping storage structure */
 struct mb_io_ping_struct {
   double time_d;
@@ -513,6 +532,8 @@ struct mb_io_struct {
   long file_pos;               /* file position at start of last record read */
   long file_bytes;             /* number of bytes read from file */
   char *file_iobuffer;         /* file i/o buffer for fread() and fwrite() calls */
+  void *file_mmap;             /* memory mapping of file when fileiobuffer < 0 */
+  size_t file_mmap_size;       /* size in bytes of memory mapping */
   FILE *mbfp2;                 /* file descriptor #2 */
   mb_path file2; /* file name #2 */
   long file2_pos;              /* file position #2 at start of last record read */
@@ -533,6 +554,28 @@ struct mb_io_struct {
   unsigned int num_indextable_alloc;
   struct mb_io_indextable_struct *indextable;
 
+  /* format independent record index sidecar (*.idx) use */
+  bool index_seekable;         /* if true the i/o module can start reading at any record offset */
+  bool index_seek_pending;     /* if true seek to index_seek_offset after the first record is read */
+  long index_seek_offset;      /* offset of first record needed within time and location bounds */
+  bool record_contiguous;      /* if true each indexed record occupies exactly the bytes up to the next indexed
+                                  offset, so records may be copied without decoding (see mbcopy -X) */
+
+  /* structure-of-arrays ping batch filled by mb_extract_batch() */
+  struct mb_batch_struct *batch;
+
+  /* background read-ahead decoding (see mb_read_ahead.c) */
+  bool read_ahead_safe;        /* if true the i/o module keeps no state between records that extraction depends on */
+  int read_ahead_pending;      /* number of records to read ahead, started by the first mb_read_ping() call */
+  int read_ahead_threads;      /* number of threads decoding records read ahead */
+  void *read_ahead;            /* read-ahead thread control structure, NULL if reading synchronously */
+
+  /* cache of the pings decoded by mb_get() and mb_read() shared between programs (see mb_pingcache.c) */
+  void *pingcache;             /* cache control structure, NULL if not reading or writing a cache */
+
+  /* deferred decoding of bulky records (e.g. water column) not needed for swath extraction */
+  bool lazy_decode;            /* if true i/o modules supporting it decode such records only when needed */
+
   /* read or write history */
   bool fileheader;       /* indicates whether file header has
                         been read or written */
@@ -619,13 +662,17 @@ struct mb_io_struct {
 
   /* variables for projections to and from projected coordinates */
   bool projection_initialized;
+  bool projection_cached;  /* pjptr belongs to the per-thread cache of mb_proj_init_cached() */
   mb_name projection_id;
   void *pjptr;
 
   /* variables for interpolating/extrapolating navigation
       for formats containing nav as asynchronous
-      position records separate from ping data */
+      position records separate from ping data - the cursor
+      holds the last interpolation bracket so that lookups at
+      increasing times do not have to search the list */
   int nfix;
+  int fix_cursor;
   double fix_time_d[MB_ASYNCH_SAVE_MAX];
   double fix_lon[MB_ASYNCH_SAVE_MAX];
   double fix_lat[MB_ASYNCH_SAVE_MAX];
@@ -634,6 +681,7 @@ struct mb_io_struct {
       for formats containing attitude as asynchronous
       data records separate from ping data */
   int nattitude;
+  int attitude_cursor;
   double attitude_time_d[MB_ASYNCH_SAVE_MAX];
   double attitude_heave[MB_ASYNCH_SAVE_MAX];
   double attitude_roll[MB_ASYNCH_SAVE_MAX];
@@ -643,6 +691,7 @@ struct mb_io_struct {
       for formats containing heading as asynchronous
       data records separate from ping data */
   int nheading;
+  int heading_cursor;
   double heading_time_d[MB_ASYNCH_SAVE_MAX];
   double heading_heading[MB_ASYNCH_SAVE_MAX];
 
@@ -650,6 +699,7 @@ struct mb_io_struct {
       for formats containing sonar depth as asynchronous
       data records separate from ping data */
   int nsensordepth;
+  int sensordepth_cursor;
   double sensordepth_time_d[MB_ASYNCH_SAVE_MAX];
   double sensordepth_sensordepth[MB_ASYNCH_SAVE_MAX];
 
@@ -657,6 +707,7 @@ struct mb_io_struct {
       for formats containing altitude as asynchronous
       data records separate from ping data */
   int naltitude;
+  int altitude_cursor;
   double altitude_time_d[MB_ASYNCH_SAVE_MAX];
   double altitude_altitude[MB_ASYNCH_SAVE_MAX];
 
@@ -754,6 +805,10 @@ struct mb_io_struct {
   int (*mb_io_read_ping)(int verbose, void *mbio_ptr, void *store_ptr, int *error);
   int (*mb_io_write_ping)(int verbose, void *mbio_ptr, void *store_ptr, int *error);
 
+  /* function pointer for skipping over the next record without decoding it,
+      returning its kind and size (optional, see mb_read_ahead.c) */
+  int (*mb_io_frame)(int verbose, void *mbio_ptr, int *kind, long *size, int *error);
+
   /* function pointers for extracting and inserting data */
   int (*mb_io_dimensions)(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nbath, int *namp, int *nss, int *error);
   int (*mb_io_pingnumber)(int verbose, void *mbio_ptr, unsigned int *pingnumber, int *error);
@@ -828,11 +883,21 @@ struct mb_io_struct {
 
 };
 
-/* MBIO buffer control structure */
+/* MBIO buffer control structure - the records are held in a ring
+    that grows as needed, with record i at buffer[(ifirst + i) % nalloc],
+    and the data storage structures of dumped records are kept in a
+    spare list for reuse by later loads */
+#define MB_BUFFER_ALLOC_STEP 256
 struct mb_buffer_struct {
-  void *buffer[MB_BUFFER_MAX];
-  int buffer_kind[MB_BUFFER_MAX];
+  void **buffer;
+  int *buffer_kind;
   int nbuffer;
+  int ifirst;
+  int nalloc;
+  void **spare;
+  int nspare;
+  int nspare_alloc;
+  int spare_format;
 };
 
 /* MBIO datalist control structure */
@@ -852,6 +917,94 @@ struct mb_datalist_struct {
   double weight;
 };
 
+/* MBIO parallel datalist reader ping structure - records read by
+    mb_read_datalist() are returned in this form */
+#define MB_READ_DATALIST_QUEUE_DEFAULT 64
+struct mb_datalist_ping_struct {
+  /* source file */
+  int ifile;
+  char *path;
+  int format;
+  double weight;
+  int sonartype;
+
+  /* values returned by mb_read() */
+  int kind;
+  int error;
+  int time_i[7];
+  double time_d;
+  double navlon;
+  double navlat;
+  double speed;
+  double heading;
+  double distance;
+  double altitude;
+  double sensordepth;
+  int nbath;
+  int namp;
+  int nss;
+  char *beamflag;
+  double *bath;
+  double *amp;
+  double *bathlon;
+  double *bathlat;
+  double *ss;
+  double *sslon;
+  double *sslat;
+  char comment[MB_COMMENT_MAXLINE];
+
+  /* storage management */
+  int nbath_alloc;
+  int namp_alloc;
+  int nss_alloc;
+  struct mb_datalist_ping_struct *next;
+};
+
+/* MBIO ping batch structure - survey pings read by mb_extract_batch()
+    are returned as structure-of-arrays, with one value per ping in the
+    ping arrays and the beams and pixels of all pings packed contiguously
+    in the beam arrays. The beams of ping i are
+    bath[bath_offset[i]] ... bath[bath_offset[i + 1] - 1], and likewise
+    for amp_offset and ss_offset. The batch is owned by the mbio
+    descriptor and remains valid until the next call to
+    mb_extract_batch() or mb_close() */
+struct mb_batch_struct {
+  /* per ping values as returned by mb_get_all() */
+  int npings;
+  int *time_i;                 /* 7 values per ping */
+  double *time_d;
+  double *navlon;
+  double *navlat;
+  double *speed;
+  double *heading;
+  double *distance;
+  double *altitude;
+  double *sensordepth;
+  int *nbath;
+  int *namp;
+  int *nss;
+  int *bath_offset;            /* npings + 1 values */
+  int *amp_offset;             /* npings + 1 values */
+  int *ss_offset;              /* npings + 1 values */
+
+  /* packed beam and pixel values */
+  char *beamflag;
+  double *bath;
+  double *bathacrosstrack;
+  double *bathalongtrack;
+  double *amp;
+  double *ss;
+  double *ssacrosstrack;
+  double *ssalongtrack;
+
+  /* storage management */
+  int error_pending;           /* fatal error reached while filling the previous batch */
+  int npings_alloc;
+  int nbath_alloc;
+  int namp_alloc;
+  int nss_alloc;
+};
+
 /* MBIO imagelist control structure */
 #define MB_IMAGELIST_RECURSION_MAX 25
 struct mb_imagelist_struct {
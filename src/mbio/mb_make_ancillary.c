@@ -0,0 +1,1025 @@
+/*--------------------------------------------------------------------
+ *    The MB-system:  mb_make_ancillary.c  10/15/2026
+ *
+ *    Copyright (c) 2026 by
+ *    David W. Caress (caress@mbari.org)
+ *      Monterey Bay Aquarium Research Institute
+ *      Moss Landing, California, USA
+ *    Dale N. Chayes
+ *      Center for Coastal and Ocean Mapping
+ *      University of New Hampshire
+ *      Durham, New Hampshire, USA
+ *    Christian dos Santos Ferreira
+ *      MARUM
+ *      University of Bremen
+ *      Bremen Germany
+ *
+ *    MB-System was created by Caress and Chayes in 1992 at the
+ *      Lamont-Doherty Earth Observatory
+ *      Columbia University
+ *      Palisades, NY 10964
+ *
+ *    See README.md file for copying and redistribution conditions.
+ *--------------------------------------------------------------------*/
+/*
+ * mb_make_ancillary.c contains functions that generate the ancillary
+ * files used to speed access to swath data files:
+ *   *.inf - the statistical summary normally produced by
+ *           mbinfo -G -N -O -M10/10
+ *   *.fbt - the "fast bathymetry" copy normally produced by
+ *           mbcopy -F format/71 -D
+ *   *.fnv - the "fast navigation" listing normally produced by
+ *           mblist -O tMXYHScRPr=X=Y+X+Y -UN
+ *   *.idx - the record index normally produced by mb_index_make(),
+ *           only for formats that can start reading within a file
+ * All are produced by reading and decoding the swath file once,
+ * within the calling process, rather than by running the three programs
+ * and then reading the file again for the index.
+ *
+ * The mbinfo coverage mask requires the data bounds before the mask
+ * cells can be defined, and mbinfo therefore reads the file twice.
+ * Here the footprint of the data is instead accumulated during the
+ * single pass in a fine raster whose extent grows (by doubling the
+ * cell size) as needed. The coverage mask is then defined from the
+ * final bounds, and each mask cell overlapped by an occupied raster
+ * cell is set. The resulting mask may include a few cells at the edge
+ * of the actual coverage, but never omits a covered cell.
+ *
+ * These functions include:
+ *   mb_make_ancillary      - generate the *.inf, *.fbt, *.fnv and *.idx files of one swath file
+ *   mb_make_info_datalist  - run mb_make_info() for all files in a datalist using multiple threads
+ *
+ * Author:  D. W. Caress
+ * Date:  15 October 2026
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "mb_define.h"
+#include "mb_format.h"
+#include "mb_info.h"
+#include "mb_io.h"
+#include "mb_status.h"
+#include "mbsys_ldeoih.h"
+
+/* coverage mask dimensions, equivalent to mbinfo -M10/10 */
+#define MB_ANCILLARY_MASK_NX 10
+#define MB_ANCILLARY_MASK_NY 10
+
+/* footprint raster dimension and initial cell size (degrees) */
+#define MB_ANCILLARY_RASTER_DIM 512
+#define MB_ANCILLARY_RASTER_CELL 1.0e-7
+
+/* mbinfo considers navigation implying speeds greater than this (km/hr) to be bad */
+#define MB_ANCILLARY_SPEED_THRESHOLD 50.0
+
+/* footprint raster accumulating the data coverage in a single pass */
+struct mb_ancillary_raster_struct {
+  bool set;
+  double xmin;
+  double ymin;
+  double dx;
+  double dy;
+  unsigned char *cells;
+};
+
+/* statistics accumulated for the *.inf file, mirroring mbinfo */
+struct mb_ancillary_inf_struct {
+  int irec;
+  int beams_bath_max;
+  int beams_amp_max;
+  int pixels_ss_max;
+  int ntdbeams, ngdbeams, nzdbeams, nfdbeams;
+  int ntabeams, ngabeams, nzabeams, nfabeams;
+  int ntsbeams, ngsbeams, nzsbeams, nfsbeams;
+  bool lonflip_set;
+  int lonflip;
+  double distot;
+  double time_d_last;
+  bool beginnav, beginsdp, beginalt, beginbath, beginamp, beginss;
+  double lonmin, lonmax, latmin, latmax;
+  double sdpmin, sdpmax, altmin, altmax;
+  double bathmin, bathmax, ampmin, ampmax, ssmin, ssmax;
+  int timbeg_i[7], timend_i[7];
+  double timbeg, timend;
+  double lonbeg, latbeg, bathbeg, spdbeg, hdgbeg, sdpbeg, altbeg;
+  double lonend, latend, bathend, spdend, hdgend, sdpend, altend;
+  struct mb_ancillary_raster_struct raster;
+};
+
+/* parallel ancillary file generation control structure */
+struct mb_make_info_datalist_struct {
+  int verbose;
+  bool force;
+  int nfile;
+  int nfile_alloc;
+  mb_path *files;
+  int *formats;
+  int next;
+  int status;
+  int error;
+  pthread_mutex_t mutex;
+};
+
+/*--------------------------------------------------------------------*/
+static void mb_ancillary_raster_grow(struct mb_ancillary_raster_struct *raster, bool along_x, bool toward_min) {
+  /* double the cell size along one axis, extending the raster toward the
+      minimum if requested, and merge the occupied cells into the coarser cells */
+  const int n = MB_ANCILLARY_RASTER_DIM;
+  const int off = toward_min ? n : 0;
+  for (int j = 0; j < n; j++) {
+    for (int i = 0; i < n; i++) {
+      const int k = i + j * n;
+      if (raster->cells[k] & 1) {
+        raster->cells[k] &= ~1;
+        if (along_x)
+          raster->cells[(i + off) / 2 + j * n] |= 2;
+        else
+          raster->cells[i + ((j + off) / 2) * n] |= 2;
+      }
+    }
+  }
+  for (int k = 0; k < n * n; k++)
+    raster->cells[k] = (raster->cells[k] & 2) != 0;
+  if (along_x) {
+    if (toward_min)
+      raster->xmin -= n * raster->dx;
+    raster->dx *= 2.0;
+  }
+  else {
+    if (toward_min)
+      raster->ymin -= n * raster->dy;
+    raster->dy *= 2.0;
+  }
+}
+/*--------------------------------------------------------------------*/
+static void mb_ancillary_raster_add(struct mb_ancillary_raster_struct *raster, double x, double y) {
+  const int n = MB_ANCILLARY_RASTER_DIM;
+
+  /* center the raster on the first point */
+  if (!raster->set) {
+    raster->dx = MB_ANCILLARY_RASTER_CELL;
+    raster->dy = MB_ANCILLARY_RASTER_CELL;
+    raster->xmin = x - 0.5 * n * raster->dx;
+    raster->ymin = y - 0.5 * n * raster->dy;
+    raster->set = true;
+  }
+
+  /* grow the raster along each axis until it includes the point */
+  while (x < raster->xmin || x >= raster->xmin + n * raster->dx)
+    mb_ancillary_raster_grow(raster, true, x < raster->xmin);
+  while (y < raster->ymin || y >= raster->ymin + n * raster->dy)
+    mb_ancillary_raster_grow(raster, false, y < raster->ymin);
+
+  int i = (int)((x - raster->xmin) / raster->dx);
+  int j = (int)((y - raster->ymin) / raster->dy);
+  i = MIN(MAX(i, 0), n - 1);
+  j = MIN(MAX(j, 0), n - 1);
+  raster->cells[i + j * n] = 1;
+}
+/*--------------------------------------------------------------------*/
+static void mb_ancillary_raster_mask(struct mb_ancillary_raster_struct *raster, double maskbounds[4], int mask_nx,
+                                     int mask_ny, int *mask) {
+  const int n = MB_ANCILLARY_RASTER_DIM;
+  const double mask_dx = (maskbounds[1] - maskbounds[0]) / mask_nx;
+  const double mask_dy = (maskbounds[3] - maskbounds[2]) / mask_ny;
+  for (int k = 0; k < mask_nx * mask_ny; k++)
+    mask[k] = 0;
+  if (!raster->set || !(mask_dx > 0.0) || !(mask_dy > 0.0))
+    return;
+
+  /* set every mask cell overlapped by an occupied raster cell */
+  for (int j = 0; j < n; j++) {
+    for (int i = 0; i < n; i++) {
+      if (raster->cells[i + j * n]) {
+        const double x0 = raster->xmin + i * raster->dx;
+        const double y0 = raster->ymin + j * raster->dy;
+        const int ix0 = MAX((int)floor((x0 - maskbounds[0]) / mask_dx), 0);
+        const int ix1 = MIN((int)ceil((x0 + raster->dx - maskbounds[0]) / mask_dx) - 1, mask_nx - 1);
+        const int iy0 = MAX((int)floor((y0 - maskbounds[2]) / mask_dy), 0);
+        const int iy1 = MIN((int)ceil((y0 + raster->dy - maskbounds[2]) / mask_dy) - 1, mask_ny - 1);
+        for (int iy = iy0; iy <= iy1; iy++)
+          for (int ix = ix0; ix <= ix1; ix++)
+            mask[ix + iy * mask_nx] = 1;
+      }
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+static double mb_ancillary_lonflip(int lonflip, double lon) {
+  if (lonflip == -1) {
+    if (lon > 0.0)
+      lon -= 360.0;
+  }
+  else if (lonflip == 1) {
+    if (lon < 0.0)
+      lon += 360.0;
+  }
+  else {
+    if (lon < -180.0)
+      lon += 360.0;
+    if (lon > 180.0)
+      lon -= 360.0;
+  }
+  return (lon);
+}
+/*--------------------------------------------------------------------*/
+static void mb_ancillary_inf_ping(int verbose, void *mbio_ptr, struct mb_ancillary_inf_struct *inf, int time_i[7],
+                                  double time_d, double navlon, double navlat, double speed, double heading,
+                                  double distance, double altitude, double sensordepth, int beams_bath, int beams_amp,
+                                  int pixels_ss, char *beamflag, double *bath, double *amp, double *bathacrosstrack,
+                                  double *bathalongtrack, double *ss, double *ssacrosstrack, double *ssalongtrack) {
+  inf->irec++;
+  inf->beams_bath_max = MAX(inf->beams_bath_max, beams_bath);
+  inf->beams_amp_max = MAX(inf->beams_amp_max, beams_amp);
+  inf->pixels_ss_max = MAX(inf->pixels_ss_max, pixels_ss);
+  inf->ntdbeams += beams_bath;
+  inf->ntabeams += beams_amp;
+  inf->ntsbeams += pixels_ss;
+
+  /* choose the longitude convention from the first valid navigation as mbinfo does */
+  if (!inf->lonflip_set && (navlon != 0.0 || navlat != 0.0)) {
+    inf->lonflip_set = true;
+    if (navlon < -270.0)
+      inf->lonflip = 0;
+    else if (navlon < -90.0)
+      inf->lonflip = -1;
+    else if (navlon < 90.0)
+      inf->lonflip = 0;
+    else if (navlon < 270.0)
+      inf->lonflip = 1;
+    else
+      inf->lonflip = 0;
+  }
+  if (inf->lonflip_set)
+    navlon = mb_ancillary_lonflip(inf->lonflip, navlon);
+
+  /* get coordinate scaling for the beam and pixel positions */
+  double mtodeglon;
+  double mtodeglat;
+  mb_coor_scale(verbose, navlat, &mtodeglon, &mtodeglat);
+  const double headingx = sin(DTR * heading);
+  const double headingy = cos(DTR * heading);
+
+  const double bathcntr = beams_bath > 0
+                              ? (mb_beam_ok(beamflag[beams_bath / 2]) ? bath[beams_bath / 2] : altitude + sensordepth)
+                              : 0.0;
+
+  /* get beginning values */
+  if (inf->irec == 1) {
+    if (beams_bath > 0)
+      inf->bathbeg = bathcntr;
+    inf->lonbeg = navlon;
+    inf->latbeg = navlat;
+    inf->timbeg = time_d;
+    for (int i = 0; i < 7; i++)
+      inf->timbeg_i[i] = time_i[i];
+    inf->spdbeg = speed;
+    inf->hdgbeg = heading;
+    inf->sdpbeg = sensordepth;
+    inf->altbeg = altitude;
+  }
+  else if (inf->lonbeg == 0.0 && inf->latbeg == 0.0 && navlon != 0.0 && navlat != 0.0) {
+    inf->lonbeg = navlon;
+    if (beams_bath > 0)
+      inf->bathbeg = bathcntr;
+    inf->latbeg = navlat;
+    if (inf->spdbeg == 0.0 && speed != 0.0)
+      inf->spdbeg = speed;
+    if (inf->hdgbeg == 0.0 && heading != 0.0)
+      inf->hdgbeg = heading;
+    if (inf->sdpbeg == 0.0 && sensordepth != 0.0)
+      inf->sdpbeg = sensordepth;
+    if (inf->altbeg == 0.0 && altitude != 0.0)
+      inf->altbeg = altitude;
+  }
+
+  /* reset ending values each time */
+  if (beams_bath > 0)
+    inf->bathend = bathcntr;
+  inf->lonend = navlon;
+  inf->latend = navlat;
+  inf->spdend = speed;
+  inf->hdgend = heading;
+  inf->sdpend = sensordepth;
+  inf->altend = altitude;
+  inf->timend = time_d;
+  for (int i = 0; i < 7; i++)
+    inf->timend_i[i] = time_i[i];
+
+  /* check for good nav, as with mbinfo -G */
+  const double speed_apparent = 3600.0 * distance / (time_d - inf->time_d_last);
+  bool good_nav = true;
+  if (navlon > -0.005 && navlon < 0.005 && navlat > -0.005 && navlat < 0.005)
+    good_nav = false;
+  else if (inf->beginnav && speed_apparent >= MB_ANCILLARY_SPEED_THRESHOLD)
+    good_nav = false;
+  if (good_nav && speed_apparent < MB_ANCILLARY_SPEED_THRESHOLD)
+    inf->distot += distance;
+
+  /* get starting mins and maxs */
+  if (!inf->beginnav && good_nav) {
+    inf->lonmin = navlon;
+    inf->lonmax = navlon;
+    inf->latmin = navlat;
+    inf->latmax = navlat;
+    inf->beginnav = true;
+  }
+  if (!inf->beginsdp && sensordepth > 0.0) {
+    inf->sdpmin = sensordepth;
+    inf->sdpmax = sensordepth;
+    inf->beginsdp = true;
+  }
+  if (!inf->beginalt && altitude > 0.0) {
+    inf->altmin = altitude;
+    inf->altmax = altitude;
+    inf->beginalt = true;
+  }
+  if (!inf->beginbath)
+    for (int i = 0; i < beams_bath; i++)
+      if (mb_beam_ok(beamflag[i])) {
+        inf->bathmin = bath[i];
+        inf->bathmax = bath[i];
+        inf->beginbath = true;
+      }
+  if (!inf->beginamp)
+    for (int i = 0; i < beams_amp; i++)
+      if (mb_beam_ok(beamflag[i])) {
+        inf->ampmin = amp[i];
+        inf->ampmax = amp[i];
+        inf->beginamp = true;
+      }
+  if (!inf->beginss)
+    for (int i = 0; i < pixels_ss; i++)
+      if (ss[i] > MB_SIDESCAN_NULL) {
+        inf->ssmin = ss[i];
+        inf->ssmax = ss[i];
+        inf->beginss = true;
+      }
+
+  /* get mins and maxs, and accumulate the coverage mask footprint, from pings with good nav */
+  const bool use_nav = good_nav && inf->beginnav;
+  if (use_nav) {
+    inf->lonmin = MIN(inf->lonmin, navlon);
+    inf->lonmax = MAX(inf->lonmax, navlon);
+    inf->latmin = MIN(inf->latmin, navlat);
+    inf->latmax = MAX(inf->latmax, navlat);
+    mb_ancillary_raster_add(&inf->raster, navlon, navlat);
+  }
+  if (inf->beginsdp) {
+    inf->sdpmin = MIN(inf->sdpmin, sensordepth);
+    inf->sdpmax = MAX(inf->sdpmax, sensordepth);
+  }
+  if (inf->beginalt) {
+    inf->altmin = MIN(inf->altmin, altitude);
+    inf->altmax = MAX(inf->altmax, altitude);
+  }
+  for (int i = 0; i < beams_bath; i++) {
+    if (mb_beam_ok(beamflag[i])) {
+      const double lon = navlon + headingy * mtodeglon * bathacrosstrack[i] + headingx * mtodeglon * bathalongtrack[i];
+      const double lat = navlat - headingx * mtodeglat * bathacrosstrack[i] + headingy * mtodeglat * bathalongtrack[i];
+      if (use_nav) {
+        inf->lonmin = MIN(inf->lonmin, lon);
+        inf->lonmax = MAX(inf->lonmax, lon);
+        inf->latmin = MIN(inf->latmin, lat);
+        inf->latmax = MAX(inf->latmax, lat);
+        mb_ancillary_raster_add(&inf->raster, lon, lat);
+      }
+      inf->bathmin = MIN(inf->bathmin, bath[i]);
+      inf->bathmax = MAX(inf->bathmax, bath[i]);
+      inf->ngdbeams++;
+      if (bath[i] > 11000.0)
+        mb_notice_log_problem(verbose, mbio_ptr, MB_PROBLEM_TOO_DEEP);
+    }
+    else if (beamflag[i] == MB_FLAG_NULL)
+      inf->nzdbeams++;
+    else
+      inf->nfdbeams++;
+  }
+  for (int i = 0; i < beams_amp; i++) {
+    if (mb_beam_ok(beamflag[i])) {
+      inf->ampmin = MIN(inf->ampmin, amp[i]);
+      inf->ampmax = MAX(inf->ampmax, amp[i]);
+      inf->ngabeams++;
+    }
+    else if (beamflag[i] == MB_FLAG_NULL)
+      inf->nzabeams++;
+    else
+      inf->nfabeams++;
+  }
+  for (int i = 0; i < pixels_ss; i++) {
+    if (ss[i] > MB_SIDESCAN_NULL) {
+      const double lon = navlon + headingy * mtodeglon * ssacrosstrack[i] + headingx * mtodeglon * ssalongtrack[i];
+      const double lat = navlat - headingx * mtodeglat * ssacrosstrack[i] + headingy * mtodeglat * ssalongtrack[i];
+      if (use_nav) {
+        inf->lonmin = MIN(inf->lonmin, lon);
+        inf->lonmax = MAX(inf->lonmax, lon);
+        inf->latmin = MIN(inf->latmin, lat);
+        inf->latmax = MAX(inf->latmax, lat);
+        mb_ancillary_raster_add(&inf->raster, lon, lat);
+      }
+      inf->ssmin = MIN(inf->ssmin, ss[i]);
+      inf->ssmax = MAX(inf->ssmax, ss[i]);
+      inf->ngsbeams++;
+    }
+    else if (ss[i] == 0.0)
+      inf->nzsbeams++;
+    else
+      inf->nfsbeams++;
+  }
+
+  /* look for problems */
+  if (navlon == 0.0 || navlat == 0.0)
+    mb_notice_log_problem(verbose, mbio_ptr, MB_PROBLEM_ZERO_NAV);
+  else if (inf->beginnav && speed_apparent >= MB_ANCILLARY_SPEED_THRESHOLD)
+    mb_notice_log_problem(verbose, mbio_ptr, MB_PROBLEM_TOO_FAST);
+
+  inf->time_d_last = time_d;
+}
+/*--------------------------------------------------------------------*/
+static void mb_ancillary_inf_write(int verbose, FILE *fp, char *file, int format,
+                                   struct mb_ancillary_inf_struct *inf, int *notice_list) {
+  /* the report is printed by the same functions used by mbinfo */
+  struct mb_info_struct summary;
+  int error = MB_ERROR_NO_ERROR;
+  mb_info_init(verbose, &summary, &error);
+  summary.nrecords = inf->irec;
+  summary.nbeams_bath = inf->beams_bath_max;
+  summary.nbeams_bath_total = inf->ntdbeams;
+  summary.nbeams_bath_good = inf->ngdbeams;
+  summary.nbeams_bath_zero = inf->nzdbeams;
+  summary.nbeams_bath_flagged = inf->nfdbeams;
+  summary.nbeams_amp = inf->beams_amp_max;
+  summary.nbeams_amp_total = inf->ntabeams;
+  summary.nbeams_amp_good = inf->ngabeams;
+  summary.nbeams_amp_zero = inf->nzabeams;
+  summary.nbeams_amp_flagged = inf->nfabeams;
+  summary.npixels_ss = inf->pixels_ss_max;
+  summary.npixels_ss_total = inf->ntsbeams;
+  summary.npixels_ss_good = inf->ngsbeams;
+  summary.npixels_ss_zero = inf->nzsbeams;
+  summary.npixels_ss_flagged = inf->nfsbeams;
+  summary.time_total = (inf->timend - inf->timbeg) / 3600.0;
+  summary.dist_total = inf->distot;
+  summary.speed_avg = summary.time_total > 0.0 ? inf->distot / summary.time_total : 0.0;
+  summary.lon_start = inf->lonbeg;
+  summary.lat_start = inf->latbeg;
+  summary.depth_start = inf->bathbeg;
+  summary.speed_start = inf->spdbeg;
+  summary.heading_start = inf->hdgbeg;
+  summary.sensordepth_start = inf->sdpbeg;
+  summary.sonaraltitude_start = inf->altbeg;
+  summary.lon_end = inf->lonend;
+  summary.lat_end = inf->latend;
+  summary.depth_end = inf->bathend;
+  summary.speed_end = inf->spdend;
+  summary.heading_end = inf->hdgend;
+  summary.sensordepth_end = inf->sdpend;
+  summary.sonaraltitude_end = inf->altend;
+  summary.lon_min = inf->lonmin;
+  summary.lon_max = inf->lonmax;
+  summary.lat_min = inf->latmin;
+  summary.lat_max = inf->latmax;
+  summary.sensordepth_min = inf->sdpmin;
+  summary.sensordepth_max = inf->sdpmax;
+  summary.altitude_min = inf->altmin;
+  summary.altitude_max = inf->altmax;
+  summary.depth_min = inf->bathmin;
+  summary.depth_max = inf->bathmax;
+  summary.amp_min = inf->ampmin;
+  summary.amp_max = inf->ampmax;
+  summary.ss_min = inf->ssmin;
+  summary.ss_max = inf->ssmax;
+
+  mb_info_print_file(verbose, fp, file, format, &error);
+  mb_info_print_totals(verbose, fp, &summary, inf->timbeg_i, inf->timend_i, true, notice_list, &error);
+  mb_info_print_notices(verbose, fp, notice_list, &error);
+
+  /* print the coverage mask */
+  double maskbounds[4] = {inf->lonmin, inf->lonmax, inf->latmin, inf->latmax};
+  int mask[MB_ANCILLARY_MASK_NX * MB_ANCILLARY_MASK_NY];
+  mb_ancillary_raster_mask(&inf->raster, maskbounds, MB_ANCILLARY_MASK_NX, MB_ANCILLARY_MASK_NY, mask);
+  mb_info_print_mask(verbose, fp, MB_ANCILLARY_MASK_NX, MB_ANCILLARY_MASK_NY, mask, &error);
+}
+/*--------------------------------------------------------------------*/
+static void mb_ancillary_fnv_ping(int verbose, FILE *fp, int time_i[7], double time_d, double navlon, double navlat,
+                                  double speed, double heading, double sensordepth, double roll, double pitch,
+                                  double heave, int beams_bath, int pixels_ss, char *beamflag, double *bathacrosstrack,
+                                  double *bathalongtrack, double *ss, double *ssacrosstrack, double *ssalongtrack) {
+  /* find the port and starboard-most good beams or pixels */
+  int ibeam_port = 0;
+  int ibeam_cntr = 0;
+  int ibeam_stbd = 0;
+  int ipixel_port = 0;
+  int ipixel_cntr = 0;
+  int ipixel_stbd = 0;
+  int error = MB_ERROR_NO_ERROR;
+  mb_swathbounds(verbose, true, beams_bath, pixels_ss, beamflag, bathacrosstrack, ss, ssacrosstrack, &ibeam_port,
+                 &ibeam_cntr, &ibeam_stbd, &ipixel_port, &ipixel_cntr, &ipixel_stbd, &error);
+  double portx = 0.0;
+  double porty = 0.0;
+  double stbdx = 0.0;
+  double stbdy = 0.0;
+  if (beams_bath > 0) {
+    portx = bathacrosstrack[ibeam_port];
+    porty = bathalongtrack[ibeam_port];
+    stbdx = bathacrosstrack[ibeam_stbd];
+    stbdy = bathalongtrack[ibeam_stbd];
+  }
+  else if (pixels_ss > 0) {
+    portx = ssacrosstrack[ipixel_port];
+    porty = ssalongtrack[ipixel_port];
+    stbdx = ssacrosstrack[ipixel_stbd];
+    stbdy = ssalongtrack[ipixel_stbd];
+  }
+  double mtodeglon;
+  double mtodeglat;
+  mb_coor_scale(verbose, navlat, &mtodeglon, &mtodeglat);
+  const double headingx = sin(DTR * heading);
+  const double headingy = cos(DTR * heading);
+  const double portlon = navlon + headingy * mtodeglon * portx + headingx * mtodeglon * porty;
+  const double portlat = navlat - headingx * mtodeglat * portx + headingy * mtodeglat * porty;
+  const double stbdlon = navlon + headingy * mtodeglon * stbdx + headingx * mtodeglon * stbdy;
+  const double stbdlat = navlat - headingx * mtodeglat * stbdx + headingy * mtodeglat * stbdy;
+
+  /* output in the layout of mblist -O tMXYHScRPr=X=Y+X+Y */
+  const double seconds = time_i[5] + 1e-6 * time_i[6];
+  fprintf(fp, "%.4d %.2d %.2d %.2d %.2d %09.6f\t%.6f\t%15.10f\t%15.10f\t%7.3f\t%6.3f\t%.4f\t%6.3f\t%6.3f\t%7.4f"
+              "\t%15.10f\t%15.10f\t%15.10f\t%15.10f\n",
+          time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], seconds, time_d, navlon, navlat, heading, speed,
+          sensordepth, roll, pitch, heave, portlon, portlat, stbdlon, stbdlat);
+}
+/*--------------------------------------------------------------------*/
+int mb_make_ancillary(int verbose, char *file, int format, bool make_inf, bool make_fbt, bool make_fnv, bool make_idx,
+                      int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       file:       %s\n", file);
+    fprintf(stderr, "dbg2       format:     %d\n", format);
+    fprintf(stderr, "dbg2       make_inf:   %d\n", make_inf);
+    fprintf(stderr, "dbg2       make_fbt:   %d\n", make_fbt);
+    fprintf(stderr, "dbg2       make_fnv:   %d\n", make_fnv);
+    fprintf(stderr, "dbg2       make_idx:   %d\n", make_idx);
+  }
+
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+
+  /* get the format if needed */
+  if (format <= 0)
+    status = mb_get_format(verbose, file, NULL, &format, error);
+
+  /* initialize reading the swath file with the default controls */
+  void *mbio_ptr = NULL;
+  int beams_bath_alloc = 0;
+  int beams_amp_alloc = 0;
+  int pixels_ss_alloc = 0;
+  if (status == MB_SUCCESS && (make_inf || make_fbt || make_fnv || make_idx)) {
+    int format_default;
+    int pings;
+    int lonflip;
+    double bounds[4];
+    int btime_i[7];
+    int etime_i[7];
+    double speedmin;
+    double timegap;
+    mb_defaults(verbose, &format_default, &pings, &lonflip, bounds, btime_i, etime_i, &speedmin, &timegap);
+    double btime_d;
+    double etime_d;
+    status = mb_read_init(verbose, file, format, 1, lonflip, bounds, btime_i, etime_i, speedmin, timegap, &mbio_ptr,
+                          &btime_d, &etime_d, &beams_bath_alloc, &beams_amp_alloc, &pixels_ss_alloc, error);
+  }
+  if (mbio_ptr == NULL) {
+    if (verbose >= 2) {
+      fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+      fprintf(stderr, "dbg2  Return values:\n");
+      fprintf(stderr, "dbg2       error:      %d\n", *error);
+      fprintf(stderr, "dbg2  Return status:\n");
+      fprintf(stderr, "dbg2       status:     %d\n", status);
+    }
+    return (status);
+  }
+  struct mb_io_struct *imb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+  /* only swath data are used, so bulky records such as water column need not be decoded */
+  mb_set_lazy_decode(verbose, mbio_ptr, true, error);
+
+  /* the whole file is read, so never start from an existing index, and
+      index the records as they are read if the format allows it - the
+      record offsets are taken from the file position, so the reading
+      cannot be done ahead by another thread */
+  imb_io_ptr->index_seek_pending = false;
+  make_idx = make_idx && mb_index_seekable(verbose, mbio_ptr);
+  if (!make_inf && !make_fbt && !make_fnv && !make_idx) {
+    status = mb_close(verbose, &mbio_ptr, error);
+    if (verbose >= 2) {
+      fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+      fprintf(stderr, "dbg2  Return values:\n");
+      fprintf(stderr, "dbg2       error:      %d\n", *error);
+      fprintf(stderr, "dbg2  Return status:\n");
+      fprintf(stderr, "dbg2       status:     %d\n", status);
+    }
+    return (status);
+  }
+  void *fileindex = NULL;
+  int num_fileindex = 0;
+  int num_fileindex_alloc = 0;
+  if (make_idx) {
+    imb_io_ptr->read_ahead_pending = 0;
+    if (verbose >= 1)
+      fprintf(stderr, "Generating idx file for %s\n", file);
+  }
+
+  /* register the data arrays */
+  char *beamflag = NULL;
+  double *bath = NULL;
+  double *amp = NULL;
+  double *bathacrosstrack = NULL;
+  double *bathalongtrack = NULL;
+  double *ss = NULL;
+  double *ssacrosstrack = NULL;
+  double *ssalongtrack = NULL;
+  if (*error == MB_ERROR_NO_ERROR)
+    status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag, error);
+  if (*error == MB_ERROR_NO_ERROR)
+    status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bath, error);
+  if (*error == MB_ERROR_NO_ERROR)
+    status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_AMPLITUDE, sizeof(double), (void **)&amp, error);
+  if (*error == MB_ERROR_NO_ERROR)
+    status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathacrosstrack,
+                               error);
+  if (*error == MB_ERROR_NO_ERROR)
+    status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathalongtrack,
+                               error);
+  if (*error == MB_ERROR_NO_ERROR)
+    status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ss, error);
+  if (*error == MB_ERROR_NO_ERROR)
+    status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ssacrosstrack, error);
+  if (*error == MB_ERROR_NO_ERROR)
+    status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ssalongtrack, error);
+
+  /* set up the inf statistics */
+  struct mb_ancillary_inf_struct inf;
+  memset(&inf, 0, sizeof(struct mb_ancillary_inf_struct));
+  if (status == MB_SUCCESS && make_inf)
+    status = mb_mallocd(verbose, __FILE__, __LINE__, MB_ANCILLARY_RASTER_DIM * MB_ANCILLARY_RASTER_DIM,
+                        (void **)&inf.raster.cells, error);
+  if (status == MB_SUCCESS && make_inf)
+    memset(inf.raster.cells, 0, MB_ANCILLARY_RASTER_DIM * MB_ANCILLARY_RASTER_DIM);
+
+  /* open the fbt file, using the fbt version set in the defaults */
+  void *ombio_ptr = NULL;
+  if (status == MB_SUCCESS && make_fbt) {
+    mb_path fbtfile;
+    snprintf(fbtfile, sizeof(fbtfile), "%s.fbt", file);
+    int obeams_bath;
+    int obeams_amp;
+    int opixels_ss;
+    status = mb_write_init(verbose, fbtfile, MBF_MBLDEOIH, &ombio_ptr, &obeams_bath, &obeams_amp, &opixels_ss, error);
+    if (status == MB_SUCCESS) {
+      int fbtversion;
+      mb_fbtversion(verbose, &fbtversion);
+      ((struct mb_io_struct *)ombio_ptr)->save1 = fbtversion;
+
+      /* start with comments describing the origin of the fbt file */
+      char comment[MB_COMMENT_MAXLINE];
+      snprintf(comment, sizeof(comment), "These data copied by function %s", __func__);
+      mb_put_comment(verbose, ombio_ptr, comment, error);
+      snprintf(comment, sizeof(comment), "MB-system Version %s", MB_VERSION);
+      mb_put_comment(verbose, ombio_ptr, comment, error);
+      char user[256];
+      char host[256];
+      char date[32];
+      mb_user_host_date(verbose, user, host, date, error);
+      snprintf(comment, sizeof(comment), "Run by user <%s> on cpu <%s> at <%s>", user, host, date);
+      mb_put_comment(verbose, ombio_ptr, comment, error);
+      snprintf(comment, sizeof(comment), "  Input file:         %s", file);
+      mb_put_comment(verbose, ombio_ptr, comment, error);
+      snprintf(comment, sizeof(comment), "  Input MBIO format:  %d", format);
+      mb_put_comment(verbose, ombio_ptr, comment, error);
+      *error = MB_ERROR_NO_ERROR;
+    }
+  }
+
+  /* open the fnv file */
+  FILE *fnvfp = NULL;
+  if (status == MB_SUCCESS && make_fnv) {
+    mb_path fnvfile;
+    snprintf(fnvfile, sizeof(fnvfile), "%s.fnv", file);
+    if ((fnvfp = fopen(fnvfile, "w")) != NULL) {
+      fprintf(fnvfp, "## <yyyy mm dd hh mm ss.ssssss> <epoch seconds> "
+                     "<longitude (deg)> <latitude (deg)> <heading (deg)> <speed (km/hr)> "
+                     "<draft (m)> <roll (deg)> <pitch (deg)> <heave (m)> <portlon (deg)> "
+                     "<portlat (deg)> <stbdlon (deg)> <stbdlat (deg)>\n");
+    }
+    else {
+      status = MB_FAILURE;
+      *error = MB_ERROR_OPEN_FAIL;
+    }
+  }
+
+  /* read and process the data */
+  while (status == MB_SUCCESS && *error <= MB_ERROR_NO_ERROR) {
+    void *store_ptr = NULL;
+    int kind;
+    int time_i[7];
+    double time_d;
+    double navlon;
+    double navlat;
+    double speed;
+    double heading;
+    double distance;
+    double altitude;
+    double sensordepth;
+    int beams_bath;
+    int beams_amp;
+    int pixels_ss;
+    char comment[MB_COMMENT_MAXLINE];
+    *error = MB_ERROR_NO_ERROR;
+    if (make_idx) {
+      /* read the next record as mb_get_all() does, indexing it before it is extracted */
+      store_ptr = imb_io_ptr->store_data;
+      const long offset = ftell(imb_io_ptr->mbfp);
+      const int read_status = mb_read_ping(verbose, mbio_ptr, store_ptr, &kind, error);
+
+      /* the arrays used here are the registered pointers themselves, and so
+          already follow any reallocation */
+      imb_io_ptr->bath_arrays_reallocated = false;
+      imb_io_ptr->amp_arrays_reallocated = false;
+      imb_io_ptr->ss_arrays_reallocated = false;
+      if (read_status == MB_SUCCESS) {
+        int idx_error = MB_ERROR_NO_ERROR;
+        if (mb_index_add(verbose, mbio_ptr, store_ptr, offset, kind, &num_fileindex, &num_fileindex_alloc, &fileindex,
+                         &idx_error) != MB_SUCCESS)
+          make_idx = false;
+      }
+      mb_get_all_extract(verbose, mbio_ptr, store_ptr, read_status, &kind, time_i, &time_d, &navlon, &navlat, &speed,
+                         &heading, &distance, &altitude, &sensordepth, &beams_bath, &beams_amp, &pixels_ss, beamflag,
+                         bath, amp, bathacrosstrack, bathalongtrack, ss, ssacrosstrack, ssalongtrack, comment, error);
+    }
+    else {
+      mb_get_all(verbose, mbio_ptr, &store_ptr, &kind, time_i, &time_d, &navlon, &navlat, &speed, &heading, &distance,
+                 &altitude, &sensordepth, &beams_bath, &beams_amp, &pixels_ss, beamflag, bath, amp, bathacrosstrack,
+                 bathalongtrack, ss, ssacrosstrack, ssalongtrack, comment, error);
+    }
+
+    /* log nonsurvey records as mb_read() does so the .inf notices match mbinfo */
+    if (*error == MB_ERROR_NO_ERROR && kind != MB_DATA_DATA) {
+      if (kind == MB_DATA_COMMENT)
+        mb_notice_log_error(verbose, mbio_ptr, MB_ERROR_COMMENT);
+      else if (kind == MB_DATA_SUBBOTTOM_MCS || kind == MB_DATA_SUBBOTTOM_CNTRBEAM || kind == MB_DATA_SUBBOTTOM_SUBBOTTOM)
+        mb_notice_log_error(verbose, mbio_ptr, MB_ERROR_SUBBOTTOM);
+      else
+        mb_notice_log_error(verbose, mbio_ptr, MB_ERROR_OTHER);
+    }
+    if (*error == MB_ERROR_TIME_GAP)
+      *error = MB_ERROR_NO_ERROR;
+
+    /* get attitude and draft of survey pings */
+    double draft = 0.0;
+    double roll = 0.0;
+    double pitch = 0.0;
+    double heave = 0.0;
+    if (*error == MB_ERROR_NO_ERROR && kind == MB_DATA_DATA) {
+      double tnavlon;
+      double tnavlat;
+      double tspeed;
+      double theading;
+      mb_extract_nav(verbose, mbio_ptr, store_ptr, &kind, time_i, &time_d, &tnavlon, &tnavlat, &tspeed, &theading,
+                     &draft, &roll, &pitch, &heave, error);
+    }
+
+    /* accumulate the inf statistics */
+    if (make_inf && *error == MB_ERROR_NO_ERROR && kind == MB_DATA_DATA)
+      mb_ancillary_inf_ping(verbose, mbio_ptr, &inf, time_i, time_d, navlon, navlat, speed, heading, distance, altitude,
+                            sensordepth, beams_bath, beams_amp, pixels_ss, beamflag, bath, amp, bathacrosstrack,
+                            bathalongtrack, ss, ssacrosstrack, ssalongtrack);
+
+    /* write the survey pings and comments to the fbt file without amplitude or sidescan */
+    if (ombio_ptr != NULL && *error <= MB_ERROR_NO_ERROR && (kind == MB_DATA_DATA || kind == MB_DATA_COMMENT)
+        && (*error == MB_ERROR_NO_ERROR || *error == MB_ERROR_COMMENT)) {
+      struct mbsys_ldeoih_struct *ostore = (struct mbsys_ldeoih_struct *)((struct mb_io_struct *)ombio_ptr)->store_data;
+      int oerror = MB_ERROR_NO_ERROR;
+      if (kind == MB_DATA_DATA) {
+        int sensorhead = 0;
+        int sonartype = MB_TOPOGRAPHY_TYPE_UNKNOWN;
+        mb_sensorhead(verbose, mbio_ptr, store_ptr, &sensorhead, &oerror);
+        mb_sonartype(verbose, mbio_ptr, store_ptr, &sonartype, &oerror);
+        ostore->sensorhead = sensorhead;
+        ostore->topo_type = sonartype;
+        mb_insert_nav(verbose, ombio_ptr, (void *)ostore, time_i, time_d, navlon, navlat, speed, heading, draft, roll,
+                      pitch, heave, &oerror);
+        mb_insert_altitude(verbose, ombio_ptr, (void *)ostore, draft, altitude, &oerror);
+      }
+      ostore->beam_xwidth = imb_io_ptr->beamwidth_xtrack;
+      ostore->beam_lwidth = imb_io_ptr->beamwidth_ltrack;
+      ostore->kind = kind;
+      oerror = MB_ERROR_NO_ERROR;
+      mb_insert(verbose, ombio_ptr, (void *)ostore, kind, time_i, time_d, navlon, navlat, speed, heading, beams_bath, 0,
+                0, beamflag, bath, amp, bathacrosstrack, bathalongtrack, ss, ssacrosstrack, ssalongtrack, comment,
+                &oerror);
+      if (mb_put_all(verbose, ombio_ptr, (void *)ostore, false, kind, time_i, time_d, navlon, navlat, speed, heading,
+                     beams_bath, 0, 0, beamflag, bath, amp, bathacrosstrack, bathalongtrack, ss, ssacrosstrack,
+                     ssalongtrack, comment, &oerror) != MB_SUCCESS) {
+        status = MB_FAILURE;
+        *error = oerror;
+      }
+    }
+
+    /* list the navigation of survey pings with nonzero navigation to the fnv file */
+    if (fnvfp != NULL && *error == MB_ERROR_NO_ERROR && kind == MB_DATA_DATA && navlon != 0.0 && navlat != 0.0)
+      mb_ancillary_fnv_ping(verbose, fnvfp, time_i, time_d, navlon, navlat, speed, heading, sensordepth, roll, pitch,
+                            heave, beams_bath, pixels_ss, beamflag, bathacrosstrack, bathalongtrack, ss,
+                            ssacrosstrack, ssalongtrack);
+  }
+  if (status == MB_SUCCESS && *error == MB_ERROR_EOF)
+    *error = MB_ERROR_NO_ERROR;
+  else if (status == MB_SUCCESS && *error > MB_ERROR_NO_ERROR)
+    status = MB_FAILURE;
+
+  /* write the inf file */
+  if (make_inf) {
+    if (inf.irec <= 0)
+      mb_notice_log_problem(verbose, mbio_ptr, MB_PROBLEM_NO_DATA);
+    else if (inf.timend > inf.timbeg
+             && inf.distot / ((inf.timend - inf.timbeg) / 3600.0) >= MB_ANCILLARY_SPEED_THRESHOLD)
+      mb_notice_log_problem(verbose, mbio_ptr, MB_PROBLEM_AVG_TOO_FAST);
+    int notice_list[MB_NOTICE_MAX];
+    mb_notice_get_list(verbose, mbio_ptr, notice_list);
+
+    mb_path inffile;
+    snprintf(inffile, sizeof(inffile), "%s.inf", file);
+    FILE *inffp = fopen(inffile, "w");
+    if (inffp != NULL) {
+      mb_ancillary_inf_write(verbose, inffp, file, format, &inf, notice_list);
+      fclose(inffp);
+    }
+    else if (status == MB_SUCCESS) {
+      status = MB_FAILURE;
+      *error = MB_ERROR_OPEN_FAIL;
+    }
+    if (inf.raster.cells != NULL)
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&inf.raster.cells, error);
+  }
+
+  /* write the idx file */
+  if (make_idx) {
+    int idx_error = MB_ERROR_NO_ERROR;
+    if (mb_index_write(verbose, file, format, num_fileindex, fileindex, &idx_error) != MB_SUCCESS
+        && status == MB_SUCCESS) {
+      status = MB_FAILURE;
+      *error = idx_error;
+    }
+  }
+  if (fileindex != NULL) {
+    int mem_error = MB_ERROR_NO_ERROR;
+    mb_freed(verbose, __FILE__, __LINE__, (void **)&fileindex, &mem_error);
+  }
+
+  /* close the files */
+  int close_error = MB_ERROR_NO_ERROR;
+  if (fnvfp != NULL)
+    fclose(fnvfp);
+  if (ombio_ptr != NULL)
+    mb_close(verbose, &ombio_ptr, &close_error);
+  mb_close(verbose, &mbio_ptr, &close_error);
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:     %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+static void *mb_make_info_datalist_worker(void *control_ptr) {
+  struct mb_make_info_datalist_struct *control = (struct mb_make_info_datalist_struct *)control_ptr;
+
+  while (true) {
+    pthread_mutex_lock(&control->mutex);
+    const int ifile = control->next < control->nfile ? control->next++ : -1;
+    pthread_mutex_unlock(&control->mutex);
+    if (ifile < 0)
+      break;
+
+    int error = MB_ERROR_NO_ERROR;
+    const int status = mb_make_info(control->verbose, control->force, control->files[ifile], control->formats[ifile],
+                                    &error);
+    if (status != MB_SUCCESS) {
+      pthread_mutex_lock(&control->mutex);
+      if (control->status == MB_SUCCESS) {
+        control->status = MB_FAILURE;
+        control->error = error;
+      }
+      pthread_mutex_unlock(&control->mutex);
+    }
+  }
+
+  return (NULL);
+}
+/*--------------------------------------------------------------------*/
+int mb_make_info_datalist(int verbose, bool force, void *datalist_ptr, int nthreads, int *nfile, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+    fprintf(stderr, "dbg2       force:        %d\n", force);
+    fprintf(stderr, "dbg2       datalist_ptr: %p\n", (void *)datalist_ptr);
+    fprintf(stderr, "dbg2       nthreads:     %d\n", nthreads);
+  }
+
+  struct mb_make_info_datalist_struct control;
+  memset(&control, 0, sizeof(struct mb_make_info_datalist_struct));
+  control.verbose = verbose;
+  control.force = force;
+  control.status = MB_SUCCESS;
+  control.error = MB_ERROR_NO_ERROR;
+  int status = MB_SUCCESS;
+
+  /* get the list of swath files from the datalist */
+  mb_path path;
+  mb_path dpath;
+  int format;
+  double weight;
+  while (status == MB_SUCCESS && mb_datalist_read(verbose, datalist_ptr, path, dpath, &format, &weight, error) == MB_SUCCESS) {
+    if (control.nfile >= control.nfile_alloc) {
+      control.nfile_alloc += 256;
+      status = mb_reallocd(verbose, __FILE__, __LINE__, control.nfile_alloc * sizeof(mb_path), (void **)&control.files,
+                           error);
+      if (status == MB_SUCCESS)
+        status = mb_reallocd(verbose, __FILE__, __LINE__, control.nfile_alloc * sizeof(int), (void **)&control.formats,
+                             error);
+      if (status != MB_SUCCESS)
+        break;
+    }
+    strcpy(control.files[control.nfile], path);
+    control.formats[control.nfile] = format;
+    control.nfile++;
+  }
+  if (status == MB_SUCCESS)
+    *error = MB_ERROR_NO_ERROR;
+  *nfile = control.nfile;
+
+  /* generate the ancillary files using a pool of worker threads */
+  if (status == MB_SUCCESS && control.nfile > 0) {
+    if (nthreads <= 0) {
+      const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+      nthreads = ncpu > 0 ? (int)ncpu : 1;
+    }
+    nthreads = MAX(MIN(nthreads, control.nfile), 1);
+
+    pthread_mutex_init(&control.mutex, NULL);
+    pthread_t *threads = NULL;
+    status = mb_mallocd(verbose, __FILE__, __LINE__, nthreads * sizeof(pthread_t), (void **)&threads, error);
+    int nstarted = 0;
+    if (status == MB_SUCCESS) {
+      for (int i = 0; i < nthreads; i++) {
+        if (pthread_create(&threads[i], NULL, mb_make_info_datalist_worker, (void *)&control) != 0)
+          break;
+        nstarted++;
+      }
+    }
+
+    /* if no threads could be started do the work in this thread */
+    if (nstarted == 0)
+      mb_make_info_datalist_worker((void *)&control);
+    for (int i = 0; i < nstarted; i++)
+      pthread_join(threads[i], NULL);
+    if (threads != NULL)
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&threads, error);
+    pthread_mutex_destroy(&control.mutex);
+
+    status = control.status;
+    *error = control.error;
+  }
+
+  /* release the file list */
+  int free_error = MB_ERROR_NO_ERROR;
+  if (control.files != NULL)
+    mb_freed(verbose, __FILE__, __LINE__, (void **)&control.files, &free_error);
+  if (control.formats != NULL)
+    mb_freed(verbose, __FILE__, __LINE__, (void **)&control.formats, &free_error);
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       nfile:      %d\n", *nfile);
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:     %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
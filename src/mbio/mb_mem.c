@@ -27,6 +27,16 @@
  * respectively, and also allow debug messages to be printed out
  * according to the verbosity.
  *
+ * Unless disabled, a list of the memory allocated through these
+ * routines is kept so that memory leaks can be reported. The list is
+ * a hash table keyed on the allocated pointer and split into
+ * MB_MEMORY_SHARDS independently locked shards, so that lookups take
+ * constant time and programs reading files in several threads can
+ * allocate and free memory concurrently. Each entry carries a sequence
+ * number so that memory listings are printed in order of allocation.
+ * Building with MB_MEM_NO_TRACKING defined (cmake -DbuildMemTracking=OFF)
+ * compiles the list out entirely.
+ *
  * Author:  D. W. Caress
  * Date:  March 1, 1993
  */
@@ -35,6 +45,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifndef MB_MEM_NO_TRACKING
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#endif
 
 #include "mb_define.h"
 #include "mb_io.h"
@@ -42,21 +57,268 @@
 
 /* memory allocation list variables */
 static const int MB_MEMORY_ALLOC_STEP = 100;
-#define MB_MEMORY_HEAP_MAX 10000
-static bool mb_memory_list_enabled = true;
 static bool mb_mem_debug = false;
-static int n_mb_alloc = 0;
-static void *mb_alloc_ptr[MB_MEMORY_HEAP_MAX];
-static size_t mb_alloc_size[MB_MEMORY_HEAP_MAX];
-static mb_longname mb_alloc_sourcefile[MB_MEMORY_HEAP_MAX];
-static int mb_alloc_sourceline[MB_MEMORY_HEAP_MAX];
-static bool mb_alloc_overflow = false;
+#ifndef MB_MEM_NO_TRACKING
+#define MB_MEMORY_SHARDS 64
+#define MB_MEMORY_BUCKETS_INIT 64
+struct mb_mem_entry_struct {
+  void *ptr;
+  size_t size;
+  mb_longname sourcefile;
+  int sourceline;
+  unsigned long sequence;
+  struct mb_mem_entry_struct *next;
+};
+struct mb_mem_shard_struct {
+  pthread_mutex_t mutex;
+  struct mb_mem_entry_struct **buckets;
+  size_t nbuckets;
+  int nentries;
+  struct mb_mem_entry_struct *spare;
+};
+static bool mb_memory_list_enabled = true;
+static struct mb_mem_shard_struct mb_mem_shards[MB_MEMORY_SHARDS];
+static pthread_once_t mb_mem_shards_once = PTHREAD_ONCE_INIT;
+static atomic_ulong mb_alloc_sequence = 0;
+static atomic_int n_mb_alloc = 0;
+static atomic_int n_mb_alloc_max = 0;
+static atomic_bool mb_alloc_overflow = false;
+#else
+static const bool mb_memory_list_enabled = false;
+static const int n_mb_alloc = 0;
+static const bool mb_alloc_overflow = false;
+#endif
+
+#ifndef MB_MEM_NO_TRACKING
+/*--------------------------------------------------------------------*/
+static void mb_mem_shards_init(void) {
+  for (int i = 0; i < MB_MEMORY_SHARDS; i++) {
+    pthread_mutex_init(&mb_mem_shards[i].mutex, NULL);
+    mb_mem_shards[i].buckets = NULL;
+    mb_mem_shards[i].nbuckets = 0;
+    mb_mem_shards[i].nentries = 0;
+    mb_mem_shards[i].spare = NULL;
+  }
+}
+/*--------------------------------------------------------------------*/
+static size_t mb_mem_hash(const void *ptr) {
+  uint64_t hash = (uint64_t)(uintptr_t)ptr;
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return ((size_t)hash);
+}
+/*--------------------------------------------------------------------*/
+/* lock and return the shard holding ptr */
+static struct mb_mem_shard_struct *mb_mem_shard_lock(const void *ptr, size_t *hash) {
+  pthread_once(&mb_mem_shards_once, mb_mem_shards_init);
+  *hash = mb_mem_hash(ptr);
+  struct mb_mem_shard_struct *shard = &mb_mem_shards[*hash % MB_MEMORY_SHARDS];
+  pthread_mutex_lock(&shard->mutex);
+  return (shard);
+}
+/*--------------------------------------------------------------------*/
+/* add an allocation to the list */
+static void mb_mem_track_add(void *ptr, size_t size, const char *sourcefile, int sourceline) {
+  size_t hash;
+  struct mb_mem_shard_struct *shard = mb_mem_shard_lock(ptr, &hash);
+
+  /* allocate or grow the hash buckets of this shard */
+  if (shard->nbuckets == 0 || (size_t)shard->nentries >= 2 * shard->nbuckets) {
+    const size_t nbuckets = shard->nbuckets > 0 ? 2 * shard->nbuckets : MB_MEMORY_BUCKETS_INIT;
+    struct mb_mem_entry_struct **buckets =
+        (struct mb_mem_entry_struct **)calloc(nbuckets, sizeof(struct mb_mem_entry_struct *));
+    if (buckets != NULL) {
+      for (size_t i = 0; i < shard->nbuckets; i++) {
+        struct mb_mem_entry_struct *entry = shard->buckets[i];
+        while (entry != NULL) {
+          struct mb_mem_entry_struct *next = entry->next;
+          const size_t ibucket = (mb_mem_hash(entry->ptr) / MB_MEMORY_SHARDS) % nbuckets;
+          entry->next = buckets[ibucket];
+          buckets[ibucket] = entry;
+          entry = next;
+        }
+      }
+      free(shard->buckets);
+      shard->buckets = buckets;
+      shard->nbuckets = nbuckets;
+    }
+  }
+
+  /* get an entry, reusing one previously released if possible */
+  struct mb_mem_entry_struct *entry = shard->spare;
+  if (entry != NULL)
+    shard->spare = entry->next;
+  else
+    entry = (struct mb_mem_entry_struct *)malloc(sizeof(struct mb_mem_entry_struct));
+
+  /* the allocation cannot be tracked - later frees of untracked pointers are allowed */
+  if (entry == NULL || shard->nbuckets == 0) {
+    if (entry != NULL) {
+      entry->next = shard->spare;
+      shard->spare = entry;
+    }
+    mb_alloc_overflow = true;
+    if (mb_mem_debug)
+      fprintf(stderr, "NOTICE: mbm_mem overflow pointer allocated %p in function %s\n", ptr, __func__);
+  }
+
+  /* add the entry */
+  else {
+    entry->ptr = ptr;
+    entry->size = size;
+    strncpy(entry->sourcefile, sourcefile, MB_LONGNAME_LENGTH - 1);
+    entry->sourcefile[MB_LONGNAME_LENGTH - 1] = '\0';
+    entry->sourceline = sourceline;
+    entry->sequence = atomic_fetch_add(&mb_alloc_sequence, 1);
+    const size_t ibucket = (hash / MB_MEMORY_SHARDS) % shard->nbuckets;
+    entry->next = shard->buckets[ibucket];
+    shard->buckets[ibucket] = entry;
+    shard->nentries++;
+    const int nalloc = atomic_fetch_add(&n_mb_alloc, 1) + 1;
+    int nallocmax = atomic_load(&n_mb_alloc_max);
+    while (nalloc > nallocmax && !atomic_compare_exchange_weak(&n_mb_alloc_max, &nallocmax, nalloc)) {
+    }
+  }
+
+  pthread_mutex_unlock(&shard->mutex);
+}
+/*--------------------------------------------------------------------*/
+/* remove an allocation from the list, returning false if it is not in the list */
+static bool mb_mem_track_remove(void *ptr, size_t *size, char *sourcefile, int *sourceline) {
+  size_t hash;
+  struct mb_mem_shard_struct *shard = mb_mem_shard_lock(ptr, &hash);
+
+  bool found = false;
+  if (shard->nbuckets > 0) {
+    struct mb_mem_entry_struct **link = &shard->buckets[(hash / MB_MEMORY_SHARDS) % shard->nbuckets];
+    while (*link != NULL && !found) {
+      struct mb_mem_entry_struct *entry = *link;
+      if (entry->ptr == ptr) {
+        found = true;
+        *link = entry->next;
+        if (size != NULL)
+          *size = entry->size;
+        if (sourcefile != NULL)
+          strcpy(sourcefile, entry->sourcefile);
+        if (sourceline != NULL)
+          *sourceline = entry->sourceline;
+        entry->next = shard->spare;
+        shard->spare = entry;
+        shard->nentries--;
+        atomic_fetch_sub(&n_mb_alloc, 1);
+      }
+      else {
+        link = &entry->next;
+      }
+    }
+  }
+
+  pthread_mutex_unlock(&shard->mutex);
+  return (found);
+}
+/*--------------------------------------------------------------------*/
+static int mb_mem_entry_compare(const void *a, const void *b) {
+  const struct mb_mem_entry_struct *entry_a = *(const struct mb_mem_entry_struct *const *)a;
+  const struct mb_mem_entry_struct *entry_b = *(const struct mb_mem_entry_struct *const *)b;
+  return (entry_a->sequence > entry_b->sequence) - (entry_a->sequence < entry_b->sequence);
+}
+#else
+/*--------------------------------------------------------------------*/
+static void mb_mem_track_add(void *ptr, size_t size, const char *sourcefile, int sourceline) {
+  (void)ptr;
+  (void)size;
+  (void)sourcefile;
+  (void)sourceline;
+}
+/*--------------------------------------------------------------------*/
+static bool mb_mem_track_remove(void *ptr, size_t *size, char *sourcefile, int *sourceline) {
+  (void)ptr;
+  (void)size;
+  (void)sourcefile;
+  (void)sourceline;
+  return (false);
+}
+#endif
+/*--------------------------------------------------------------------*/
+/* print the list of allocated memory in order of allocation, or free
+    all of the allocated memory if release is true */
+static void mb_mem_list_process(const char *prefix, bool release, size_t *allocsize) {
+  if (allocsize != NULL)
+    *allocsize = 0;
+#ifndef MB_MEM_NO_TRACKING
+  pthread_once(&mb_mem_shards_once, mb_mem_shards_init);
+  for (int ishard = 0; ishard < MB_MEMORY_SHARDS; ishard++)
+    pthread_mutex_lock(&mb_mem_shards[ishard].mutex);
+
+  /* gather the entries and sort them by allocation sequence */
+  int nentries = 0;
+  for (int ishard = 0; ishard < MB_MEMORY_SHARDS; ishard++)
+    nentries += mb_mem_shards[ishard].nentries;
+  struct mb_mem_entry_struct **entries = NULL;
+  if (prefix != NULL && nentries > 0
+      && (entries = (struct mb_mem_entry_struct **)malloc(nentries * sizeof(struct mb_mem_entry_struct *))) != NULL) {
+    int n = 0;
+    for (int ishard = 0; ishard < MB_MEMORY_SHARDS; ishard++)
+      for (size_t ibucket = 0; ibucket < mb_mem_shards[ishard].nbuckets; ibucket++)
+        for (struct mb_mem_entry_struct *entry = mb_mem_shards[ishard].buckets[ibucket]; entry != NULL; entry = entry->next)
+          entries[n++] = entry;
+    qsort(entries, nentries, sizeof(struct mb_mem_entry_struct *), mb_mem_entry_compare);
+    for (int i = 0; i < nentries; i++)
+      fprintf(stderr, "%si:%d  ptr:%p  size:%zu source:%s line:%d\n", prefix, i, entries[i]->ptr, entries[i]->size,
+              entries[i]->sourcefile, entries[i]->sourceline);
+    free(entries);
+  }
+
+  /* visit the entries in table order */
+  int i = 0;
+  for (int ishard = 0; ishard < MB_MEMORY_SHARDS; ishard++) {
+    struct mb_mem_shard_struct *shard = &mb_mem_shards[ishard];
+    for (size_t ibucket = 0; ibucket < shard->nbuckets; ibucket++) {
+      struct mb_mem_entry_struct *entry = shard->buckets[ibucket];
+      while (entry != NULL) {
+        struct mb_mem_entry_struct *next = entry->next;
+        if (prefix != NULL && entries == NULL)
+          fprintf(stderr, "%si:%d  ptr:%p  size:%zu source:%s line:%d\n", prefix, i, entry->ptr, entry->size,
+                  entry->sourcefile, entry->sourceline);
+        if (allocsize != NULL)
+          *allocsize += entry->size;
+        if (release) {
+          free(entry->ptr);
+          free(entry);
+        }
+        i++;
+        entry = next;
+      }
+      if (release)
+        shard->buckets[ibucket] = NULL;
+    }
+    if (release) {
+      while (shard->spare != NULL) {
+        struct mb_mem_entry_struct *next = shard->spare->next;
+        free(shard->spare);
+        shard->spare = next;
+      }
+      atomic_fetch_sub(&n_mb_alloc, shard->nentries);
+      shard->nentries = 0;
+    }
+  }
+
+  for (int ishard = MB_MEMORY_SHARDS - 1; ishard >= 0; ishard--)
+    pthread_mutex_unlock(&mb_mem_shards[ishard].mutex);
+#else
+  (void)prefix;
+  (void)release;
+#endif
+}
 
 /*--------------------------------------------------------------------*/
 int mb_mem_list_enable(int verbose, int *error) {
 
   /* turn memory list on */
+#ifndef MB_MEM_NO_TRACKING
   mb_memory_list_enabled = true;
+#endif
 
   if (verbose >= 2 || mb_mem_debug) {
     fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
@@ -66,9 +328,7 @@ int mb_mem_list_enable(int verbose, int *error) {
 
   if (verbose >= 6 || mb_mem_debug) {
     fprintf(stderr, "\ndbg6  Allocated memory list in MBIO function <%s>\n", __func__);
-    for (int i = 0; i < n_mb_alloc; i++)
-      fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-              mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+    mb_mem_list_process("dbg6       ", false, NULL);
   }
 
   const int status = MB_SUCCESS;
@@ -88,7 +348,9 @@ int mb_mem_list_enable(int verbose, int *error) {
 int mb_mem_list_disable(int verbose, int *error) {
 
   /* turn memory list off */
+#ifndef MB_MEM_NO_TRACKING
   mb_memory_list_enabled = false;
+#endif
 
   if (verbose >= 2) {
     fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
@@ -124,9 +386,7 @@ int mb_mem_debug_on(int verbose, int *error) {
 
   /* if (verbose >= 6 || mb_mem_debug) */ {
     fprintf(stderr, "\ndbg6  Allocated memory list in MBIO function <%s>\n", __func__);
-    for (int i = 0; i < n_mb_alloc; i++)
-      fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-              mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+    mb_mem_list_process("dbg6       ", false, NULL);
   }
 
   const int status = MB_SUCCESS;
@@ -156,9 +416,7 @@ int mb_mem_debug_off(int verbose, int *error) {
 
   if (verbose >= 6) {
     fprintf(stderr, "\ndbg6  Allocated memory list in MBIO function <%s>\n", __func__);
-    for (int i = 0; i < n_mb_alloc; i++)
-      fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-              mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+    mb_mem_list_process("dbg6       ", false, NULL);
   }
 
   const int status = MB_SUCCESS;
@@ -206,31 +464,18 @@ int mb_malloc(int verbose, size_t size, void **ptr, int *error) {
 
   if ((verbose >= 5 || mb_mem_debug) && size > 0) {
     fprintf(stderr, "\ndbg5  Memory allocated in MBIO function <%s>\n", __func__);
-    fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", n_mb_alloc, (void *)*ptr, size);
+    fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", (int)n_mb_alloc, (void *)*ptr, size);
   }
 
   /* keep list of allocated memory */
   if (mb_memory_list_enabled) {
     /* add to list if size > 0 */
-    if (size > 0) {
-      if (n_mb_alloc < MB_MEMORY_HEAP_MAX) {
-        mb_alloc_ptr[n_mb_alloc] = *ptr;
-        mb_alloc_size[n_mb_alloc] = size;
-        n_mb_alloc++;
-      }
-      else {
-        mb_alloc_overflow = true;
-#ifdef MB_MEM_DEBUG
-        fprintf(stderr, "NOTICE: mbm_mem overflow pointer allocated %d in function %s\n", *ptr, __func__);
-#endif
-      }
-    }
+    if (size > 0 && *ptr != NULL)
+      mb_mem_track_add(*ptr, size, "", 0);
 
     if (verbose >= 6 || mb_mem_debug) {
       fprintf(stderr, "\ndbg6  Allocated memory list in MBIO function <%s>\n", __func__);
-      for (int i = 0; i < n_mb_alloc; i++)
-        fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-                mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+      mb_mem_list_process("dbg6       ", false, NULL);
     }
   }
   if (verbose >= 2 || mb_mem_debug) {
@@ -281,31 +526,16 @@ int mb_mallocd(int verbose, const char *sourcefile, int sourceline, size_t size,
 
     if ((verbose >= 5 || mb_mem_debug) && size > 0) {
       fprintf(stderr, "\ndbg5  Memory allocated in MBIO function <%s>\n", __func__);
-      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", n_mb_alloc, (void *)*ptr, size);
+      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", (int)n_mb_alloc, (void *)*ptr, size);
     }
 
     /* add to list if size > 0 */
-    if (size > 0) {
-      if (n_mb_alloc < MB_MEMORY_HEAP_MAX) {
-        mb_alloc_ptr[n_mb_alloc] = *ptr;
-        mb_alloc_size[n_mb_alloc] = size;
-        strncpy(mb_alloc_sourcefile[n_mb_alloc], sourcefile, MB_LONGNAME_LENGTH - 1);
-        mb_alloc_sourceline[n_mb_alloc] = sourceline;
-        n_mb_alloc++;
-      }
-      else {
-        mb_alloc_overflow = true;
-#ifdef MB_MEM_DEBUG
-        fprintf(stderr, "NOTICE: mbm_mem overflow pointer allocated %d in function %s\n", *ptr, __func__);
-#endif
-      }
-    }
+    if (size > 0 && *ptr != NULL)
+      mb_mem_track_add(*ptr, size, sourcefile, sourceline);
 
     if (verbose >= 6 || mb_mem_debug) {
       fprintf(stderr, "\ndbg6  Allocated memory list in MBIO function <%s>\n", __func__);
-      for (int i = 0; i < n_mb_alloc; i++)
-        fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-                mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+      mb_mem_list_process("dbg6       ", false, NULL);
     }
   }
 
@@ -331,15 +561,16 @@ int mb_realloc(int verbose, size_t size, void **ptr, int *error) {
     fprintf(stderr, "dbg2       *ptr:       %p\n", (void *)*ptr);
   }
 
-
-  /* keep list of allocated memory */
-  int iptr = -1;
-  if (mb_memory_list_enabled) {
-    /* check if pointer is in list */
-    for (int i = 0; i < n_mb_alloc; i++)
-      if (mb_alloc_ptr[i] == *ptr)
-        iptr = i;
-  }
+  /* keep list of allocated memory - take the pointer out of the list
+      before it is released by realloc so that the address cannot be
+      reused by another thread while it is still listed */
+  bool found = false;
+  size_t oldsize = 0;
+  mb_longname oldsourcefile = "";
+  int oldsourceline = 0;
+  void *oldptr = *ptr;
+  if (mb_memory_list_enabled && *ptr != NULL)
+    found = mb_mem_track_remove(*ptr, &oldsize, oldsourcefile, &oldsourceline);
 
   /* if pointer is non-NULL use realloc */
   if (*ptr != NULL)
@@ -361,49 +592,21 @@ int mb_realloc(int verbose, size_t size, void **ptr, int *error) {
 
   /* keep list of allocated memory */
   if (mb_memory_list_enabled) {
-    /* if pointer was already in list update it */
-    if (status == MB_SUCCESS && iptr > -1) {
-      /* if pointer non-NULL update it */
-      if (size > 0 && *ptr != NULL) {
-        mb_alloc_ptr[iptr] = *ptr;
-        mb_alloc_size[iptr] = size;
-      }
-
-      /* else remove it from list */
-      else {
-        for (int i = iptr; i < n_mb_alloc - 1; i++) {
-          mb_alloc_ptr[i] = mb_alloc_ptr[i + 1];
-          mb_alloc_size[i] = mb_alloc_size[i + 1];
-        }
-        n_mb_alloc--;
-      }
-    }
-
-    /* else add to list if possible if size > 0 */
-    else if (status == MB_SUCCESS && size > 0) {
-      if (n_mb_alloc < MB_MEMORY_HEAP_MAX) {
-        mb_alloc_ptr[n_mb_alloc] = *ptr;
-        mb_alloc_size[n_mb_alloc] = size;
-        n_mb_alloc++;
-      }
-      else {
-        mb_alloc_overflow = true;
-#ifdef MB_MEM_DEBUG
-        fprintf(stderr, "NOTICE: mbm_mem overflow pointer allocated %p in function %s\n", *ptr, __func__);
-#endif
-      }
-    }
+    /* add the reallocated pointer to the list, or restore the
+        original pointer if the reallocation failed */
+    if (status == MB_SUCCESS && size > 0)
+      mb_mem_track_add(*ptr, size, oldsourcefile, oldsourceline);
+    else if (status == MB_FAILURE && found)
+      mb_mem_track_add(oldptr, oldsize, oldsourcefile, oldsourceline);
 
     if ((verbose >= 5 || mb_mem_debug) && size > 0) {
       fprintf(stderr, "\ndbg5  Memory reallocated in MBIO function <%s>\n", __func__);
-      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", n_mb_alloc, (void *)*ptr, size);
+      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", (int)n_mb_alloc, (void *)*ptr, size);
     }
 
     if (verbose >= 6 || mb_mem_debug) {
       fprintf(stderr, "\ndbg6  Allocated memory list in MBIO function <%s>\n", __func__);
-      for (int i = 0; i < n_mb_alloc; i++)
-        fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-                mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+      mb_mem_list_process("dbg6       ", false, NULL);
     }
   }
 
@@ -435,16 +638,16 @@ int mb_reallocd(int verbose, const char *sourcefile, int sourceline, size_t size
     fprintf(stderr, "dbg2       *ptr:       %p\n", (void *)*ptr);
   }
 
-  /* keep list of allocated memory */
-  int iptr = -1;
-  if (mb_memory_list_enabled) {
-    /* check if pointer is in list */
-    for (int i = 0; i < n_mb_alloc; i++) {
-      if (mb_alloc_ptr[i] == *ptr) {
-        iptr = i;
-      }
-    }
-  }
+  /* keep list of allocated memory - take the pointer out of the list
+      before it is released by realloc so that the address cannot be
+      reused by another thread while it is still listed */
+  bool found = false;
+  size_t oldsize = 0;
+  mb_longname oldsourcefile = "";
+  int oldsourceline = 0;
+  void *oldptr = *ptr;
+  if (mb_memory_list_enabled && *ptr != NULL)
+    found = mb_mem_track_remove(*ptr, &oldsize, oldsourcefile, &oldsourceline);
 
   /* if pointer is non-NULL use realloc */
   if (*ptr != NULL)
@@ -467,55 +670,22 @@ int mb_reallocd(int verbose, const char *sourcefile, int sourceline, size_t size
 
   /* keep list of allocated memory */
   if (mb_memory_list_enabled) {
-    /* if pointer was already in list update it */
-    if (status == MB_SUCCESS && iptr > -1) {
-      /* if pointer non-NULL update it */
-      if (size > 0 && *ptr != NULL) {
-        mb_alloc_ptr[iptr] = *ptr;
-        mb_alloc_size[iptr] = size;
-        strncpy(mb_alloc_sourcefile[iptr], sourcefile, MB_LONGNAME_LENGTH - 1);
-        mb_alloc_sourceline[iptr] = sourceline;
-      }
-
-      /* else remove it from list */
-      else {
-        for (int i = iptr; i < n_mb_alloc - 1; i++) {
-          mb_alloc_ptr[i] = mb_alloc_ptr[i + 1];
-          mb_alloc_size[i] = mb_alloc_size[i + 1];
-          strncpy(mb_alloc_sourcefile[i], mb_alloc_sourcefile[i + 1], MB_LONGNAME_LENGTH - 1);
-          mb_alloc_sourceline[i] = mb_alloc_sourceline[i + 1];
-        }
-        n_mb_alloc--;
-      }
-    }
-
-    /* else add to list if possible if size > 0 */
-    else if (status == MB_SUCCESS && size > 0) {
-      if (n_mb_alloc < MB_MEMORY_HEAP_MAX) {
-        mb_alloc_ptr[n_mb_alloc] = *ptr;
-        mb_alloc_size[n_mb_alloc] = size;
-        strncpy(mb_alloc_sourcefile[n_mb_alloc], sourcefile, MB_LONGNAME_LENGTH - 1);
-        mb_alloc_sourceline[n_mb_alloc] = sourceline;
-        n_mb_alloc++;
-      }
-      else {
-        mb_alloc_overflow = true;
-        if (mb_mem_debug)
-          fprintf(stderr, "NOTICE: mbm_mem overflow pointer allocated %p in function %s\n", *ptr, __func__);
-      }
-    }
+    /* add the reallocated pointer to the list, or restore the
+        original pointer if the reallocation failed */
+    if (status == MB_SUCCESS && size > 0)
+      mb_mem_track_add(*ptr, size, sourcefile, sourceline);
+    else if (status == MB_FAILURE && found)
+      mb_mem_track_add(oldptr, oldsize, oldsourcefile, oldsourceline);
 
     if ((verbose >= 5 || mb_mem_debug) && size > 0) {
       fprintf(stderr, "\ndbg5  Memory reallocated in MBIO function <%s>\n", __func__);
-      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu source:%s line:%d\n", n_mb_alloc, (void *)*ptr, size, sourcefile,
-              sourceline);
+      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu source:%s line:%d\n", (int)n_mb_alloc, (void *)*ptr, size,
+              sourcefile, sourceline);
     }
 
     if (verbose >= 6 || mb_mem_debug) {
       fprintf(stderr, "\ndbg6  Allocated memory list in MBIO function <%s>\n", __func__);
-      for (int i = 0; i < n_mb_alloc; i++)
-        fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-                mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+      mb_mem_list_process("dbg6       ", false, NULL);
     }
   }
 
@@ -547,40 +717,20 @@ int mb_free(int verbose, void **ptr, int *error) {
   /* if keeping list of allocated memory then free memory only if it is in
       the list or list has overflowed */
   if (mb_memory_list_enabled) {
-    /* check if pointer is in list */
-    int iptr = -1;
-    for (int i = 0; i < n_mb_alloc; i++) {
-      if (mb_alloc_ptr[i] == *ptr) {
-        iptr = i;
-      }
-    }
-
     /* if pointer is in list remove it from list */
-    size_t ptrsize;
-    void *ptrvalue;
-    if (iptr > -1) {
-      /* remove it from list */
-      ptrvalue = mb_alloc_ptr[iptr];
-      ptrsize = mb_alloc_size[iptr];
-      for (int i = iptr; i < n_mb_alloc - 1; i++) {
-        mb_alloc_ptr[i] = mb_alloc_ptr[i + 1];
-        mb_alloc_size[i] = mb_alloc_size[i + 1];
-        strncpy(mb_alloc_sourcefile[i], mb_alloc_sourcefile[i + 1], MB_LONGNAME_LENGTH - 1);
-        mb_alloc_sourceline[i] = mb_alloc_sourceline[i + 1];
-      }
-      n_mb_alloc--;
-
+    size_t ptrsize = 0;
+    void *ptrvalue = *ptr;
+    const bool found = (*ptr != NULL && mb_mem_track_remove(*ptr, &ptrsize, NULL, NULL));
+    if (found) {
       /* free the memory */
-      if (*ptr != NULL) {
-        free(*ptr);
-        *ptr = NULL;
-      }
+      free(*ptr);
+      *ptr = NULL;
     }
 
     /* else heap overflow has occurred */
     else if (mb_alloc_overflow && *ptr != NULL) {
 #ifdef MB_MEM_DEBUG
-      fprintf(stderr, "NOTICE: mbm_mem overflow pointer freed %d in function %s\n", *ptr, __func__);
+      fprintf(stderr, "NOTICE: mbm_mem overflow pointer freed %p in function %s\n", *ptr, __func__);
 #endif
 
       /* free the memory */
@@ -588,16 +738,14 @@ int mb_free(int verbose, void **ptr, int *error) {
       *ptr = NULL;
     }
 
-    if ((verbose >= 5 || mb_mem_debug) && iptr > -1) {
+    if ((verbose >= 5 || mb_mem_debug) && found) {
       fprintf(stderr, "\ndbg5  Allocated memory freed in MBIO function <%s>\n", __func__);
-      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", iptr, ptrvalue, ptrsize);
+      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", (int)n_mb_alloc, ptrvalue, ptrsize);
     }
 
     if (verbose >= 6 || mb_mem_debug) {
       fprintf(stderr, "\ndbg6  Allocated memory list in MBIO function <%s>\n", __func__);
-      for (int i = 0; i < n_mb_alloc; i++)
-        fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-                mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+      mb_mem_list_process("dbg6       ", false, NULL);
     }
   }
 
@@ -636,38 +784,20 @@ int mb_freed(int verbose, const char *sourcefile, int sourceline, void **ptr, in
   /* if keeping list of allocated memory then free memory only if it is in
       the list or list has overflowed */
   if (mb_memory_list_enabled) {
-    /* check if pointer is in list */
-    int iptr = -1;
-    for (int i = 0; i < n_mb_alloc; i++)
-      if (ptr != NULL && mb_alloc_ptr[i] == *ptr)
-        iptr = i;
-
     /* if pointer is in list remove it from list */
-    size_t ptrsize;
-    size_t ptrvalue;
-    if (iptr > -1) {
-      /* remove it from list */
-      ptrvalue = (size_t)mb_alloc_ptr[iptr];
-      ptrsize = mb_alloc_size[iptr];
-      for (int i = iptr; i < n_mb_alloc - 1; i++) {
-        mb_alloc_ptr[i] = mb_alloc_ptr[i + 1];
-        mb_alloc_size[i] = mb_alloc_size[i + 1];
-        strncpy(mb_alloc_sourcefile[i], mb_alloc_sourcefile[i + 1], MB_LONGNAME_LENGTH - 1);
-        mb_alloc_sourceline[i] = mb_alloc_sourceline[i + 1];
-      }
-      n_mb_alloc--;
-
+    size_t ptrsize = 0;
+    void *ptrvalue = (ptr != NULL ? *ptr : NULL);
+    const bool found = (ptr != NULL && *ptr != NULL && mb_mem_track_remove(*ptr, &ptrsize, NULL, NULL));
+    if (found) {
       /* free the memory */
-      if (*ptr != NULL) {
-        free(*ptr);
-        *ptr = NULL;
-      }
+      free(*ptr);
+      *ptr = NULL;
     }
 
     /* else  heap overflow has occurred */
     else if (mb_alloc_overflow && *ptr != NULL) {
   #ifdef MB_MEM_DEBUG
-      fprintf(stderr, "NOTICE: mbm_mem overflow pointer freed %d in function %s\n", *ptr, __func__);
+      fprintf(stderr, "NOTICE: mbm_mem overflow pointer freed %p in function %s\n", *ptr, __func__);
   #endif
 
       /* free the memory */
@@ -675,16 +805,14 @@ int mb_freed(int verbose, const char *sourcefile, int sourceline, void **ptr, in
       *ptr = NULL;
     }
 
-    if ((verbose >= 5 || mb_mem_debug) && iptr > -1) {
+    if ((verbose >= 5 || mb_mem_debug) && found) {
       fprintf(stderr, "\ndbg5  Allocated memory freed in MBIO function <%s>\n", __func__);
-      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", iptr, (void *)ptrvalue, ptrsize);
+      fprintf(stderr, "dbg5       i:%d  ptr:%p  size:%zu\n", (int)n_mb_alloc, ptrvalue, ptrsize);
     }
 
     if (verbose >= 6 || mb_mem_debug) {
       fprintf(stderr, "\ndbg6  Allocated memory list in MBIO function <%s>\n", __func__);
-      for (int i = 0; i < n_mb_alloc; i++)
-        fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-                mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+      mb_mem_list_process("dbg6       ", false, NULL);
     }
   }
 
@@ -718,22 +846,14 @@ int mb_memory_clear(int verbose, int *error) {
 
   /* keep list of allocated memory */
   if (mb_memory_list_enabled) {
-    /* loop over all allocated memory */
-    for (int i = 0; i < n_mb_alloc; i++) {
-      if (verbose >= 5 || mb_mem_debug) {
-        fprintf(stderr, "\ndbg5  Allocated memory freed in MBIO function <%s>\n", __func__);
-        fprintf(stderr, "dbg4       i:%d  ptr:%12p  size:%zu\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i]);
-      }
-
-      /* free the memory */
-      if (mb_alloc_ptr[i] != NULL)
-        free(mb_alloc_ptr[i]);
-      mb_alloc_ptr[i] = NULL;
-      mb_alloc_size[i] = 0;
-      (mb_alloc_sourcefile[i])[0] = 0;
-      mb_alloc_sourceline[i] = 0;
+    /* loop over all allocated memory, freeing it */
+    if (verbose >= 5 || mb_mem_debug) {
+      fprintf(stderr, "\ndbg5  Allocated memory freed in MBIO function <%s>\n", __func__);
+      mb_mem_list_process("dbg4       ", true, NULL);
+    }
+    else {
+      mb_mem_list_process(NULL, true, NULL);
     }
-    n_mb_alloc = 0;
   }
 
   /* assume success */
@@ -763,15 +883,16 @@ int mb_memory_status(int verbose, int *nalloc, int *nallocmax, int *overflow, si
   *overflow = 0;
   *allocsize = 0;
 
-  /* keep list of allocated memory */
+  /* keep list of allocated memory - the list has no fixed size so
+      nallocmax returns the largest number of allocations listed at once */
   if (mb_memory_list_enabled) {
     /* get status */
+    mb_mem_list_process(NULL, false, allocsize);
     *nalloc = n_mb_alloc;
-    *nallocmax = MB_MEMORY_HEAP_MAX;
+#ifndef MB_MEM_NO_TRACKING
+    *nallocmax = n_mb_alloc_max;
+#endif
     *overflow = mb_alloc_overflow;
-    *allocsize = 0;
-    for (int i = 0; i < n_mb_alloc; i++)
-      *allocsize += mb_alloc_size[i];
   }
 
   /* assume success */
@@ -805,9 +926,7 @@ int mb_memory_list(int verbose, int *error) {
     if (verbose >= 4 || mb_mem_debug) {
       if (n_mb_alloc > 0) {
         fprintf(stderr, "\ndbg4  Allocated memory list in MBIO function <%s>\n", __func__);
-        for (int i = 0; i < n_mb_alloc; i++)
-          fprintf(stderr, "dbg6       i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i],
-                  mb_alloc_size[i], mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+        mb_mem_list_process("dbg6       ", false, NULL);
       }
       else {
         fprintf(stderr, "\ndbg4  No memory currently allocated in MBIO function <%s>\n", __func__);
@@ -815,9 +934,7 @@ int mb_memory_list(int verbose, int *error) {
     }
     else if (n_mb_alloc > 0) {
       fprintf(stderr, "\nWarning: some objects are still allocated in memory:\n");
-      for (int i = 0; i < n_mb_alloc; i++)
-        fprintf(stderr, "     i:%d  ptr:%p  size:%zu source:%s line:%d\n", i, (void *)mb_alloc_ptr[i], mb_alloc_size[i],
-                mb_alloc_sourcefile[i], mb_alloc_sourceline[i]);
+      mb_mem_list_process("     ", false, NULL);
       fprintf(stderr, "Probable failure in MB-System garbage collection...\n");
     }
   }
@@ -121,59 +121,66 @@ int mb_navint_add(int verbose, void *mbio_ptr, double time_d, double lon_easting
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-/* 	function mb_navint_interp interpolates or extrapolates a
-        nav fix from the internal list. */
-int mb_navint_interp(int verbose, void *mbio_ptr, double time_d, double heading, double rawspeed, double *lon, double *lat,
-                     double *speed, int *error) {
-	double mtodeglon = 0.0;
-	double mtodeglat = 0.0;
+/* 	function mb_navint_search finds the position ifix in the time
+        list of an asynchronous data stream such that
+        time_list[ifix - 1] <= time_d <= time_list[ifix], given that
+        n > 1 and time_list[0] <= time_d <= time_list[n - 1].
+        The bracket found by the previous call on the same stream is
+        held in *cursor and is checked first along with the following
+        interval, so interpolating at increasing times costs O(1) per
+        call. Otherwise a binary search is used. */
+static int mb_navint_search(int n, const double *time_list, double time_d, int *cursor) {
+	const int ifix = *cursor;
+	if (ifix >= 1 && ifix < n && time_d >= time_list[ifix - 1]) {
+		if (time_d <= time_list[ifix])
+			return (ifix);
+		if (ifix + 1 < n && time_d <= time_list[ifix + 1]) {
+			*cursor = ifix + 1;
+			return (*cursor);
+		}
+	}
+
+	int ilo = 0;
+	int ihi = n - 1;
+	while (ihi - ilo > 1) {
+		const int imid = (ilo + ihi) / 2;
+		if (time_list[imid] < time_d)
+			ilo = imid;
+		else
+			ihi = imid;
+	}
+	*cursor = ihi;
+	return (ihi);
+}
+/*--------------------------------------------------------------------*/
+/* 	function mb_navint_calc interpolates or extrapolates a nav fix
+        from the internal list for the mb_navint_interp(),
+        mb_navint_prjinterp() and mb_navint_ninterp() functions.
+        If projected is true the positions are treated as eastings
+        and northings in meters rather than as lon lat. */
+static int mb_navint_calc(int verbose, struct mb_io_struct *mb_io_ptr, double time_d, double heading, double rawspeed,
+                          bool projected, double *lon, double *lat, double *speed, int *error) {
+	double mtodeglon = 1.0;
+	double mtodeglat = 1.0;
 	double dx, dy, dt, dd;
 	double factor, headingx, headingy;
 	double speed_mps;
 	int ifix = 0;
 	int ifix0, ifix1;
 
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
-		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
-		fprintf(stderr, "dbg2       heading:    %f\n", heading);
-		fprintf(stderr, "dbg2       rawspeed:   %f\n", rawspeed);
-	}
-
-	/* get pointers to mbio descriptor and data structures */
-	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  Current nav fix values:\n");
-		for (int i = 0; i < mb_io_ptr->nfix; i++)
-			fprintf(stderr, "dbg2       nav fix[%2d]:   %f %f %f\n", i, mb_io_ptr->fix_time_d[i], mb_io_ptr->fix_lon[i],
-			        mb_io_ptr->fix_lat[i]);
-	}
-
 	/* get degrees to meters conversion if fix available */
-	if (mb_io_ptr->nfix > 0) {
+	if (!projected && mb_io_ptr->nfix > 0) {
 		mb_coor_scale(verbose, mb_io_ptr->fix_lat[mb_io_ptr->nfix - 1], &mtodeglon, &mtodeglat);
 	}
 
 	/* find location of time_d in the list arrays */
 	if (mb_io_ptr->nfix > 1) {
-		if (time_d <= mb_io_ptr->fix_time_d[0])
+		if (time_d < mb_io_ptr->fix_time_d[0])
 			ifix = 0;
-		else if (time_d >= mb_io_ptr->fix_time_d[mb_io_ptr->nfix - 1])
+		else if (time_d > mb_io_ptr->fix_time_d[mb_io_ptr->nfix - 1])
 			ifix = mb_io_ptr->nfix - 1;
-		else {
-			ifix = (mb_io_ptr->nfix - 1) * (time_d - mb_io_ptr->fix_time_d[0]) /
-			       (mb_io_ptr->fix_time_d[mb_io_ptr->nfix - 1] - mb_io_ptr->fix_time_d[0]);
-			while (time_d > mb_io_ptr->fix_time_d[ifix]) {
-				ifix++;
-			}
-			while (time_d < mb_io_ptr->fix_time_d[ifix - 1]) {
-				ifix--;
-			}
-		}
+		else
+			ifix = mb_navint_search(mb_io_ptr->nfix, mb_io_ptr->fix_time_d, time_d, &mb_io_ptr->fix_cursor);
 	}
 	else if (mb_io_ptr->nfix == 1) {
 		ifix = 0;
@@ -258,6 +265,35 @@ int mb_navint_interp(int verbose, void *mbio_ptr, double time_d, double heading,
 #endif
 	}
 
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+/* 	function mb_navint_interp interpolates or extrapolates a
+        nav fix from the internal list. */
+int mb_navint_interp(int verbose, void *mbio_ptr, double time_d, double heading, double rawspeed, double *lon, double *lat,
+                     double *speed, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+		fprintf(stderr, "dbg2       heading:    %f\n", heading);
+		fprintf(stderr, "dbg2       rawspeed:   %f\n", rawspeed);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  Current nav fix values:\n");
+		for (int i = 0; i < mb_io_ptr->nfix; i++)
+			fprintf(stderr, "dbg2       nav fix[%2d]:   %f %f %f\n", i, mb_io_ptr->fix_time_d[i], mb_io_ptr->fix_lon[i],
+			        mb_io_ptr->fix_lat[i]);
+	}
+
+	const int status = mb_navint_calc(verbose, mb_io_ptr, time_d, heading, rawspeed, false, lon, lat, speed, error);
+
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return value:\n");
@@ -273,18 +309,51 @@ int mb_navint_interp(int verbose, void *mbio_ptr, double time_d, double heading,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
+/* 	function mb_navint_ninterp interpolates or extrapolates nav
+        fixes from the internal list at nsamples times in one call,
+        using the same heading and raw speed for any extrapolation.
+        The search is cheapest when the times are in increasing order. */
+int mb_navint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double heading, double rawspeed,
+                      double *lon, double *lat, double *speed, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       nsamples:   %d\n", nsamples);
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       time_d[%2d]: %f\n", i, time_d[i]);
+		fprintf(stderr, "dbg2       heading:    %f\n", heading);
+		fprintf(stderr, "dbg2       rawspeed:   %f\n", rawspeed);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	int status = MB_SUCCESS;
+	for (int i = 0; i < nsamples; i++)
+		status &= mb_navint_calc(verbose, mb_io_ptr, time_d[i], heading, rawspeed, false, &lon[i], &lat[i], &speed[i], error);
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return value:\n");
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       nav[%2d]:    %f %f %f\n", i, lon[i], lat[i], speed[i]);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return success */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
 /* 	function mb_navint_prjinterp interpolates or extrapolates a
         nav fix from the internal list treating the position
         list as being in a projected coordinate system
         rather than in geographic lon lat. */
 int mb_navint_prjinterp(int verbose, void *mbio_ptr, double time_d, double heading, double rawspeed, double *easting,
                         double *northing, double *speed, int *error) {
-	double dx, dy, dt, dd;
-	double factor, headingx, headingy;
-	double speed_mps;
-	int ifix = 0;
-	int ifix0, ifix1;
-
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
@@ -305,105 +374,7 @@ int mb_navint_prjinterp(int verbose, void *mbio_ptr, double time_d, double headi
 			        mb_io_ptr->fix_lat[i]);
 	}
 
-	/* find location of time_d in the list arrays */
-	if (mb_io_ptr->nfix > 1) {
-		if (time_d <= mb_io_ptr->fix_time_d[0])
-			ifix = 0;
-		else if (time_d >= mb_io_ptr->fix_time_d[mb_io_ptr->nfix - 1])
-			ifix = mb_io_ptr->nfix - 1;
-		else {
-			ifix = (mb_io_ptr->nfix - 1) * (time_d - mb_io_ptr->fix_time_d[0]) /
-			       (mb_io_ptr->fix_time_d[mb_io_ptr->nfix - 1] - mb_io_ptr->fix_time_d[0]);
-			while (time_d > mb_io_ptr->fix_time_d[ifix]) {
-				ifix++;
-			}
-			while (time_d < mb_io_ptr->fix_time_d[ifix - 1]) {
-				ifix--;
-			}
-		}
-	}
-	else if (mb_io_ptr->nfix == 1) {
-		ifix = 0;
-	}
-
-	/* use raw speed if available */
-	if (rawspeed > 0.0)
-		*speed = rawspeed; /* km/hr */
-
-	/* else get speed averaged over as many as 100 fixes */
-	else if (mb_io_ptr->nfix > 1) {
-		ifix0 = MAX(ifix - 50, 0);
-		ifix1 = MIN(ifix + 50, mb_io_ptr->nfix - 1);
-		dx = (mb_io_ptr->fix_lon[ifix1] - mb_io_ptr->fix_lon[ifix0]);
-		dy = (mb_io_ptr->fix_lat[ifix1] - mb_io_ptr->fix_lat[ifix0]);
-		dt = mb_io_ptr->fix_time_d[ifix1] - mb_io_ptr->fix_time_d[ifix0];
-		*speed = 3.6 * sqrt(dx * dx + dy * dy) / dt; /* km/hr */
-	}
-
-	/* else speed unknown */
-	else
-		*speed = 0.0;
-
-	/* get speed in m/s */
-	speed_mps = *speed / 3.6;
-
-	int status = MB_SUCCESS;
-
-	/* interpolate if possible */
-	if (mb_io_ptr->nfix > 1 && (time_d >= mb_io_ptr->fix_time_d[0]) && (time_d <= mb_io_ptr->fix_time_d[mb_io_ptr->nfix - 1])) {
-		factor = (time_d - mb_io_ptr->fix_time_d[ifix - 1]) / (mb_io_ptr->fix_time_d[ifix] - mb_io_ptr->fix_time_d[ifix - 1]);
-		*easting = mb_io_ptr->fix_lon[ifix - 1] + factor * (mb_io_ptr->fix_lon[ifix] - mb_io_ptr->fix_lon[ifix - 1]);
-		*northing = mb_io_ptr->fix_lat[ifix - 1] + factor * (mb_io_ptr->fix_lat[ifix] - mb_io_ptr->fix_lat[ifix - 1]);
-		status = MB_SUCCESS;
-#ifdef MB_NAVINT_DEBUG
-		fprintf(stderr, "mb_navint_interp: Nav  %f %f interpolated at fix %d of %d with factor:%f\n", *easting, *northing, ifix,
-		        mb_io_ptr->nfix, factor);
-#endif
-	}
-
-	/* extrapolate from last fix - note zero speed
-	    results in just using the last fix */
-	else if (mb_io_ptr->nfix > 1 && (time_d > mb_io_ptr->fix_time_d[mb_io_ptr->nfix - 1])) {
-		/* extrapolated position using average speed */
-		dd = (time_d - mb_io_ptr->fix_time_d[mb_io_ptr->nfix - 1]) * speed_mps; /* meters */
-		headingx = sin(DTR * heading);
-		headingy = cos(DTR * heading);
-		*easting = mb_io_ptr->fix_lon[mb_io_ptr->nfix - 1] + headingx * dd;
-		*northing = mb_io_ptr->fix_lat[mb_io_ptr->nfix - 1] + headingy * dd;
-		status = MB_SUCCESS;
-#ifdef MB_NAVINT_DEBUG
-		fprintf(stderr, "mb_navint_interp: Nav %f %f extrapolated from last fix of %d with distance:%f and speed:%f\n", *easting,
-		        *northing, mb_io_ptr->nfix, dd, speed_mps);
-#endif
-	}
-
-	/* extrapolate from first fix - note zero speed
-	    results in just using the first fix */
-	else if (mb_io_ptr->nfix >= 1) {
-		/* extrapolated position using average speed */
-		dd = (time_d - mb_io_ptr->fix_time_d[0]) * speed_mps; /* meters */
-		headingx = sin(DTR * heading);
-		headingy = cos(DTR * heading);
-		*easting = mb_io_ptr->fix_lon[0] + headingx * dd;
-		*northing = mb_io_ptr->fix_lat[0] + headingy * dd;
-		status = MB_SUCCESS;
-#ifdef MB_NAVINT_DEBUG
-		fprintf(stderr, "mb_navint_interp: Nav %f %f extrapolated from first fix of %d with distance %f and speed:%f\n", *easting,
-		        *northing, mb_io_ptr->nfix, dd, speed_mps);
-#endif
-	}
-
-	/* else no fix */
-	else {
-		*easting = 0.0;
-		*northing = 0.0;
-		*speed = 0.0;
-		status = MB_FAILURE;
-		*error = MB_ERROR_NOT_ENOUGH_DATA;
-#ifdef MB_NAVINT_DEBUG
-		fprintf(stderr, "mb_navint_interp: Nav zeroed\n");
-#endif
-	}
+	const int status = mb_navint_calc(verbose, mb_io_ptr, time_d, heading, rawspeed, true, easting, northing, speed, error);
 
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
@@ -492,7 +463,6 @@ int mb_attint_add(int verbose, void *mbio_ptr, double time_d, double heave, doub
         list used for interpolation/extrapolation. */
 int mb_attint_nadd(int verbose, void *mbio_ptr, int nsamples, double *time_d, double *heave, double *roll, double *pitch,
                    int *error) {
-
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
@@ -560,35 +530,20 @@ int mb_attint_nadd(int verbose, void *mbio_ptr, int nsamples, double *time_d, do
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-/* 	function mb_attint_interp interpolates or extrapolates a
-        attitude fix from the internal list. */
-int mb_attint_interp(int verbose, void *mbio_ptr, double time_d, double *heave, double *roll, double *pitch, int *error) {
+/* 	function mb_attint_calc interpolates or extrapolates a
+        attitude fix from the internal list for the
+        mb_attint_interp() and mb_attint_ninterp() functions. */
+static int mb_attint_calc(struct mb_io_struct *mb_io_ptr, double time_d, double *heave, double *roll, double *pitch, int *error) {
 	double factor;
 	int ifix;
 
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
-		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
-	}
-
-	/* get pointers to mbio descriptor and data structures */
-	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
 	int status = MB_SUCCESS;
 
 	/* interpolate if possible */
 	if (mb_io_ptr->nattitude > 1 && (mb_io_ptr->attitude_time_d[mb_io_ptr->nattitude - 1] >= time_d) &&
 	    (mb_io_ptr->attitude_time_d[0] <= time_d)) {
 		/* get interpolated position */
-		ifix = (mb_io_ptr->nattitude - 1) * (time_d - mb_io_ptr->attitude_time_d[0]) /
-		       (mb_io_ptr->attitude_time_d[mb_io_ptr->nattitude - 1] - mb_io_ptr->attitude_time_d[0]);
-		while (time_d > mb_io_ptr->attitude_time_d[ifix])
-			ifix++;
-		while (time_d < mb_io_ptr->attitude_time_d[ifix - 1])
-			ifix--;
+		ifix = mb_navint_search(mb_io_ptr->nattitude, mb_io_ptr->attitude_time_d, time_d, &mb_io_ptr->attitude_cursor);
 
 		factor = (time_d - mb_io_ptr->attitude_time_d[ifix - 1]) /
 		         (mb_io_ptr->attitude_time_d[ifix] - mb_io_ptr->attitude_time_d[ifix - 1]);
@@ -643,6 +598,25 @@ int mb_attint_interp(int verbose, void *mbio_ptr, double time_d, double *heave,
 #endif
 	}
 
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+/* 	function mb_attint_interp interpolates or extrapolates a
+        attitude fix from the internal list. */
+int mb_attint_interp(int verbose, void *mbio_ptr, double time_d, double *heave, double *roll, double *pitch, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	const int status = mb_attint_calc(mb_io_ptr, time_d, heave, roll, pitch, error);
+
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return value:\n");
@@ -658,6 +632,42 @@ int mb_attint_interp(int verbose, void *mbio_ptr, double time_d, double *heave,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
+/* 	function mb_attint_ninterp interpolates or extrapolates attitude
+        from the internal list at nsamples times in one call. The
+        search is cheapest when the times are in increasing order. */
+int mb_attint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double *heave, double *roll,
+                      double *pitch, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       nsamples:   %d\n", nsamples);
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       time_d[%2d]: %f\n", i, time_d[i]);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	int status = MB_SUCCESS;
+	for (int i = 0; i < nsamples; i++)
+		status &= mb_attint_calc(mb_io_ptr, time_d[i], &heave[i], &roll[i], &pitch[i], error);
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return value:\n");
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       value[%2d]:  %f %f %f\n", i, heave[i], roll[i], pitch[i]);
+		fprintf(stderr, "dbg2       error:        %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:       %d\n", status);
+	}
+
+	/* return success */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
 /* 	function mb_hedint_add adds a heading fix to the internal
         list used for interpolation/extrapolation. */
 int mb_hedint_add(int verbose, void *mbio_ptr, double time_d, double heading, int *error) {
@@ -720,7 +730,6 @@ int mb_hedint_add(int verbose, void *mbio_ptr, double time_d, double heading, in
 /* 	function mb_hedint_nadd adds multiple heading fixes to the internal
         list used for interpolation/extrapolation. */
 int mb_hedint_nadd(int verbose, void *mbio_ptr, int nsamples, double *time_d, double *heading, int *error) {
-
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
@@ -781,36 +790,21 @@ int mb_hedint_nadd(int verbose, void *mbio_ptr, int nsamples, double *time_d, do
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-/* 	function mb_hedint_interp interpolates or extrapolates a
-        heading fix from the internal list. */
-int mb_hedint_interp(int verbose, void *mbio_ptr, double time_d, double *heading, int *error) {
+/* 	function mb_hedint_calc interpolates or extrapolates a
+        heading fix from the internal list for the
+        mb_hedint_interp() and mb_hedint_ninterp() functions. */
+static int mb_hedint_calc(struct mb_io_struct *mb_io_ptr, double time_d, double *heading, int *error) {
 	double factor;
 	int ifix;
 	double heading1, heading2;
 
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
-		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
-	}
-
-	/* get pointers to mbio descriptor and data structures */
-	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
 	int status = MB_SUCCESS;
 
 	/* interpolate if possible */
 	if (mb_io_ptr->nheading > 1 && (mb_io_ptr->heading_time_d[mb_io_ptr->nheading - 1] >= time_d) &&
 	    (mb_io_ptr->heading_time_d[0] <= time_d)) {
 		/* get interpolated heading */
-		ifix = (mb_io_ptr->nheading - 1) * (time_d - mb_io_ptr->heading_time_d[0]) /
-		       (mb_io_ptr->heading_time_d[mb_io_ptr->nheading - 1] - mb_io_ptr->heading_time_d[0]);
-		while (time_d > mb_io_ptr->heading_time_d[ifix])
-			ifix++;
-		while (time_d < mb_io_ptr->heading_time_d[ifix - 1])
-			ifix--;
+		ifix = mb_navint_search(mb_io_ptr->nheading, mb_io_ptr->heading_time_d, time_d, &mb_io_ptr->heading_cursor);
 
 		factor = (time_d - mb_io_ptr->heading_time_d[ifix - 1]) /
 		         (mb_io_ptr->heading_time_d[ifix] - mb_io_ptr->heading_time_d[ifix - 1]);
@@ -861,6 +855,25 @@ int mb_hedint_interp(int verbose, void *mbio_ptr, double time_d, double *heading
 #endif
 	}
 
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+/* 	function mb_hedint_interp interpolates or extrapolates a
+        heading fix from the internal list. */
+int mb_hedint_interp(int verbose, void *mbio_ptr, double time_d, double *heading, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	const int status = mb_hedint_calc(mb_io_ptr, time_d, heading, error);
+
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return value:\n");
@@ -874,6 +887,41 @@ int mb_hedint_interp(int verbose, void *mbio_ptr, double time_d, double *heading
 	return (status);
 }
 /*--------------------------------------------------------------------*/
+/* 	function mb_hedint_ninterp interpolates or extrapolates heading
+        from the internal list at nsamples times in one call. The
+        search is cheapest when the times are in increasing order. */
+int mb_hedint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double *heading, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       nsamples:   %d\n", nsamples);
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       time_d[%2d]: %f\n", i, time_d[i]);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	int status = MB_SUCCESS;
+	for (int i = 0; i < nsamples; i++)
+		status &= mb_hedint_calc(mb_io_ptr, time_d[i], &heading[i], error);
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return value:\n");
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       value[%2d]:  %f\n", i, heading[i]);
+		fprintf(stderr, "dbg2       error:        %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:       %d\n", status);
+	}
+
+	/* return success */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
 /* 	function mb_depint_add adds a sonar depth fix to the internal
         list used for interpolation/extrapolation. */
 int mb_depint_add(int verbose, void *mbio_ptr, double time_d, double sensordepth, int *error) {
@@ -934,35 +982,20 @@ int mb_depint_add(int verbose, void *mbio_ptr, double time_d, double sensordepth
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-/* 	function mb_depint_interp interpolates or extrapolates a
-        sonar depth fix from the internal list. */
-int mb_depint_interp(int verbose, void *mbio_ptr, double time_d, double *sensordepth, int *error) {
+/* 	function mb_depint_calc interpolates or extrapolates a
+        sonar depth fix from the internal list for the
+        mb_depint_interp() and mb_depint_ninterp() functions. */
+static int mb_depint_calc(struct mb_io_struct *mb_io_ptr, double time_d, double *sensordepth, int *error) {
 	double factor;
 	int ifix;
 
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
-		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
-	}
-
-	/* get pointers to mbio descriptor and data structures */
-	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
 	int status = MB_SUCCESS;
 
 	/* interpolate if possible */
 	if (mb_io_ptr->nsensordepth > 1 && (mb_io_ptr->sensordepth_time_d[mb_io_ptr->nsensordepth - 1] >= time_d) &&
 	    (mb_io_ptr->sensordepth_time_d[0] <= time_d)) {
 		/* get interpolated position */
-		ifix = (mb_io_ptr->nsensordepth - 1) * (time_d - mb_io_ptr->sensordepth_time_d[0]) /
-		       (mb_io_ptr->sensordepth_time_d[mb_io_ptr->nsensordepth - 1] - mb_io_ptr->sensordepth_time_d[0]);
-		while (time_d > mb_io_ptr->sensordepth_time_d[ifix])
-			ifix++;
-		while (time_d < mb_io_ptr->sensordepth_time_d[ifix - 1])
-			ifix--;
+		ifix = mb_navint_search(mb_io_ptr->nsensordepth, mb_io_ptr->sensordepth_time_d, time_d, &mb_io_ptr->sensordepth_cursor);
 
 		factor = (time_d - mb_io_ptr->sensordepth_time_d[ifix - 1]) /
 		         (mb_io_ptr->sensordepth_time_d[ifix] - mb_io_ptr->sensordepth_time_d[ifix - 1]);
@@ -1006,6 +1039,25 @@ int mb_depint_interp(int verbose, void *mbio_ptr, double time_d, double *sensord
 #endif
 	}
 
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+/* 	function mb_depint_interp interpolates or extrapolates a
+        sonar depth fix from the internal list. */
+int mb_depint_interp(int verbose, void *mbio_ptr, double time_d, double *sensordepth, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	const int status = mb_depint_calc(mb_io_ptr, time_d, sensordepth, error);
+
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return value:\n");
@@ -1019,6 +1071,41 @@ int mb_depint_interp(int verbose, void *mbio_ptr, double time_d, double *sensord
 	return (status);
 }
 /*--------------------------------------------------------------------*/
+/* 	function mb_depint_ninterp interpolates or extrapolates sonar depth
+        from the internal list at nsamples times in one call. The
+        search is cheapest when the times are in increasing order. */
+int mb_depint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double *sensordepth, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       nsamples:   %d\n", nsamples);
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       time_d[%2d]: %f\n", i, time_d[i]);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	int status = MB_SUCCESS;
+	for (int i = 0; i < nsamples; i++)
+		status &= mb_depint_calc(mb_io_ptr, time_d[i], &sensordepth[i], error);
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return value:\n");
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       value[%2d]:  %f\n", i, sensordepth[i]);
+		fprintf(stderr, "dbg2       error:        %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:       %d\n", status);
+	}
+
+	/* return success */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
 /* 	function mb_altint_add adds a heading fix to the internal
         list used for interpolation/extrapolation. */
 int mb_altint_add(int verbose, void *mbio_ptr, double time_d, double altitude, int *error) {
@@ -1078,35 +1165,20 @@ int mb_altint_add(int verbose, void *mbio_ptr, double time_d, double altitude, i
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-/* 	function mb_altint_interp interpolates or extrapolates a
-        altitude fix from the internal list. */
-int mb_altint_interp(int verbose, void *mbio_ptr, double time_d, double *altitude, int *error) {
+/* 	function mb_altint_calc interpolates or extrapolates a
+        altitude fix from the internal list for the
+        mb_altint_interp() and mb_altint_ninterp() functions. */
+static int mb_altint_calc(struct mb_io_struct *mb_io_ptr, double time_d, double *altitude, int *error) {
 	double factor;
 	int ifix;
 
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
-		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
-	}
-
-	/* get pointers to mbio descriptor and data structures */
-	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
 	int status = MB_SUCCESS;
 
 	/* interpolate if possible */
 	if (mb_io_ptr->naltitude > 1 && (mb_io_ptr->altitude_time_d[mb_io_ptr->naltitude - 1] >= time_d) &&
 	    (mb_io_ptr->altitude_time_d[0] <= time_d)) {
 		/* get interpolated position */
-		ifix = (mb_io_ptr->naltitude - 1) * (time_d - mb_io_ptr->altitude_time_d[0]) /
-		       (mb_io_ptr->altitude_time_d[mb_io_ptr->naltitude - 1] - mb_io_ptr->altitude_time_d[0]);
-		while (time_d > mb_io_ptr->altitude_time_d[ifix])
-			ifix++;
-		while (time_d < mb_io_ptr->fix_time_d[ifix - 1])
-			ifix--;
+		ifix = mb_navint_search(mb_io_ptr->naltitude, mb_io_ptr->altitude_time_d, time_d, &mb_io_ptr->altitude_cursor);
 
 		factor = (time_d - mb_io_ptr->altitude_time_d[ifix - 1]) /
 		         (mb_io_ptr->altitude_time_d[ifix] - mb_io_ptr->altitude_time_d[ifix - 1]);
@@ -1148,6 +1220,25 @@ int mb_altint_interp(int verbose, void *mbio_ptr, double time_d, double *altitud
 #endif
 	}
 
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+/* 	function mb_altint_interp interpolates or extrapolates a
+        altitude fix from the internal list. */
+int mb_altint_interp(int verbose, void *mbio_ptr, double time_d, double *altitude, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	const int status = mb_altint_calc(mb_io_ptr, time_d, altitude, error);
+
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return value:\n");
@@ -1160,7 +1251,41 @@ int mb_altint_interp(int verbose, void *mbio_ptr, double time_d, double *altitud
 	/* return success */
 	return (status);
 }
+/*--------------------------------------------------------------------*/
+/* 	function mb_altint_ninterp interpolates or extrapolates altitude
+        from the internal list at nsamples times in one call. The
+        search is cheapest when the times are in increasing order. */
+int mb_altint_ninterp(int verbose, void *mbio_ptr, int nsamples, const double *time_d, double *altitude, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       nsamples:   %d\n", nsamples);
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       time_d[%2d]: %f\n", i, time_d[i]);
+	}
+
+	/* get pointers to mbio descriptor and data structures */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
+	int status = MB_SUCCESS;
+	for (int i = 0; i < nsamples; i++)
+		status &= mb_altint_calc(mb_io_ptr, time_d[i], &altitude[i], error);
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return value:\n");
+		for (int i = 0; i < nsamples; i++)
+			fprintf(stderr, "dbg2       value[%2d]:  %f\n", i, altitude[i]);
+		fprintf(stderr, "dbg2       error:        %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:       %d\n", status);
+	}
+
+	/* return success */
+	return (status);
+}
 /*--------------------------------------------------------------------*/
 
 int mb_loadnavdata(int verbose, char *merge_nav_file, int merge_nav_format, int merge_nav_lonflip, int *merge_nav_num,
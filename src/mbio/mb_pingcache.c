@@ -0,0 +1,741 @@
+/*--------------------------------------------------------------------
+ *    The MB-system:  mb_pingcache.c  10/15/2026
+ *
+ *    Copyright (c) 2026 by
+ *    David W. Caress (caress@mbari.org)
+ *      Monterey Bay Aquarium Research Institute
+ *      Moss Landing, California, USA
+ *    Dale N. Chayes
+ *      Center for Coastal and Ocean Mapping
+ *      University of New Hampshire
+ *      Durham, New Hampshire, USA
+ *    Christian dos Santos Ferreira
+ *      MARUM
+ *      University of Bremen
+ *      Bremen Germany
+ *
+ *    MB-System was created by Caress and Chayes in 1992 at the
+ *      Lamont-Doherty Earth Observatory
+ *      Columbia University
+ *      Palisades, NY 10964
+ *
+ *    See README.md file for copying and redistribution conditions.
+ *--------------------------------------------------------------------*/
+/*
+ * mb_pingcache.c contains functions that keep the pings decoded by
+ * mb_get() and mb_read() in a local cache file, so that programs run
+ * one after another on the same swath file (e.g. mbinfo followed by
+ * mbgrid) decode the file only once. The cache directory is set with
+ * mbdefaults (pingcache: in ~/.mbio_defaults) and is best placed on a
+ * memory backed file system such as /dev/shm. Caching is off by default.
+ *
+ * A cache file holds, for each call of mb_read_ping() made by mb_get() or
+ * mb_read(), the status, error and record kind returned together with
+ * everything mb_extract() and mb_extract_altitude() then obtained from
+ * the record: the navigation, the beam and pixel counts, the beamflag,
+ * bathymetry, amplitude and sidescan arrays, and any comment. The
+ * notices logged, the sonar type and the beam widths are kept as well.
+ * The file is named from a hash of the swath file path and format, and
+ * its header holds the path, format, size, modification time and
+ * projection of the swath file, so any change to the swath file makes
+ * the cache stale. A stale cache is replaced the next time the swath file is read.
+ *
+ * Programs that only use the values returned by mb_get() or mb_read(),
+ * and never the data store itself, call mb_set_pingcache() after
+ * mb_read_init(). If a current cache exists it is then memory mapped
+ * and mb_get() and mb_read() return the cached pings without reading the
+ * swath file; otherwise the pings decoded during this reading are
+ * written to a temporary file which is renamed into place when the end
+ * of the swath file is reached, and discarded if the program stops early.
+ * If mb_read_ping() is called directly on a descriptor using a cache,
+ * for instance through mb_get_all(), the cache is given up and the
+ * swath file is read up to the same point, so reading continues as if
+ * no cache had been used.
+ *
+ * These functions include:
+ *   mb_set_pingcache       - start reading or writing the cache for a descriptor
+ *   mb_pingcache_get       - read and extract the next ping, through the cache
+ *   mb_pingcache_detach    - give up the cache when records are read directly
+ *   mb_pingcache_sonartype - sonar type of the last ping returned from the cache
+ *   mb_pingcache_close     - release the cache (used by mb_close)
+ *
+ * Author:  D. W. Caress
+ * Date:  15 October 2026
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+#define MB_PINGCACHE_ID "MBPCACHE002"
+#define MB_PINGCACHE_ALIGN(n) ((((size_t)(n)) + 7) & ~((size_t)7))
+
+/* what mb_get() and mb_read() did with a cached record */
+#define MB_PINGCACHE_EXTRACT_NONE 0
+#define MB_PINGCACHE_EXTRACT 1
+#define MB_PINGCACHE_EXTRACT_ALTITUDE 2
+
+/* cache modes */
+#define MB_PINGCACHE_READ 1
+#define MB_PINGCACHE_WRITE 2
+
+/* cache file header */
+struct mb_pingcache_header_struct {
+  char id[16];
+  mb_path file;
+  mb_name projection_id;
+  int format;
+  int lonflip;
+  long file_size;
+  long file_mtime;
+  long file_mtime_nsec;
+  long nrecord;
+  long complete;
+};
+
+/* cache record header, followed by the logged notices as index and
+    count pairs, the beamflags, the bathymetry, acrosstrack and alongtrack
+    distances, the amplitudes, the sidescan, acrosstrack and alongtrack
+    distances and the comment, each padded to eight bytes */
+struct mb_pingcache_record_struct {
+  long size;
+  long offset;
+  long file_pos;
+  long file_bytes;
+  int status;
+  int error;
+  int kind;
+  int new_error;
+  int extracted;
+  int sonartype;
+  int nbath;
+  int namp;
+  int nss;
+  int beams_bath_max;
+  int beams_amp_max;
+  int pixels_ss_max;
+  int nnotice;
+  int ncomment;
+  int time_i[7];
+  int spare;
+  double time_d;
+  double navlon;
+  double navlat;
+  double speed;
+  double heading;
+  double sensordepth;
+  double altitude;
+  double beamwidth_xtrack;
+  double beamwidth_ltrack;
+};
+
+/* cache control structure */
+struct mb_pingcache_struct {
+  int mode;
+  struct mb_pingcache_header_struct header;
+  mb_path path;
+  int lonflip;
+
+  /* writing */
+  mb_pathplus tmppath;
+  FILE *fp;
+  bool reading;
+  int notice_list[MB_NOTICE_MAX];
+
+  /* reading */
+  char *map;
+  size_t map_size;
+  size_t cursor;
+  long nserved;
+  long nskipped;
+  bool sonartype_set;
+  int sonartype;
+};
+
+/*--------------------------------------------------------------------*/
+/* get the header describing the swath file read by a descriptor, and
+    the cache file path, returning false if it cannot be cached */
+static bool mb_pingcache_describe(struct mb_io_struct *mb_io_ptr, const char *dir,
+                                  struct mb_pingcache_header_struct *header, char *path) {
+  struct stat file_status;
+  char file[PATH_MAX];
+  if (mb_io_ptr->mbfp == NULL || mb_io_ptr->mbfp == stdin || mb_io_ptr->numfile != 1 ||
+      realpath(mb_io_ptr->file, file) == NULL || strlen(file) >= sizeof(header->file) ||
+      stat(file, &file_status) != 0 || !S_ISREG(file_status.st_mode))
+    return (false);
+
+  memset(header, 0, sizeof(struct mb_pingcache_header_struct));
+  strcpy(header->id, MB_PINGCACHE_ID);
+  strcpy(header->file, file);
+  if (mb_io_ptr->projection_initialized)
+    strncpy(header->projection_id, mb_io_ptr->projection_id, sizeof(header->projection_id) - 1);
+  header->format = mb_io_ptr->format;
+  header->lonflip = mb_io_ptr->lonflip;
+  header->file_size = (long)file_status.st_size;
+  header->file_mtime = (long)file_status.st_mtim.tv_sec;
+  header->file_mtime_nsec = (long)file_status.st_mtim.tv_nsec;
+
+  /* name the cache file with a 64-bit FNV-1a hash of the path and format */
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char *c = file; *c != '\0'; c++)
+    hash = (hash ^ (unsigned char)*c) * 1099511628211ULL;
+  hash = (hash ^ (uint64_t)mb_io_ptr->format) * 1099511628211ULL;
+  snprintf(path, sizeof(mb_path), "%s/%016llx.mbpc", dir, (unsigned long long)hash);
+  return (true);
+}
+/*--------------------------------------------------------------------*/
+/* release the cache, removing an incomplete cache file being written */
+static void mb_pingcache_free(int verbose, struct mb_io_struct *mb_io_ptr) {
+  struct mb_pingcache_struct *cache = (struct mb_pingcache_struct *)mb_io_ptr->pingcache;
+  if (cache->fp != NULL) {
+    fclose(cache->fp);
+    unlink(cache->tmppath);
+  }
+  if (cache->map != NULL)
+    munmap(cache->map, cache->map_size);
+  int error = MB_ERROR_NO_ERROR;
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&mb_io_ptr->pingcache, &error);
+}
+/*--------------------------------------------------------------------*/
+/* check that the record starting at offset lies within the mapped cache
+    file and that its counts account for exactly its size, so that it can
+    be returned without reading beyond the record or the map */
+static bool mb_pingcache_valid(const struct mb_pingcache_struct *cache, size_t offset) {
+  struct mb_pingcache_record_struct record;
+  if (offset > cache->map_size || cache->map_size - offset < sizeof(record))
+    return (false);
+  memcpy(&record, &cache->map[offset], sizeof(record));
+  if (record.size < (long)sizeof(record) || (size_t)record.size > cache->map_size - offset ||
+      record.nnotice < 0 || record.nnotice > MB_NOTICE_MAX || record.nbath < 0 || record.namp < 0 || record.nss < 0 ||
+      record.ncomment < 0 || record.ncomment > MB_COMMENT_MAXLINE || record.beams_bath_max < 0 ||
+      record.beams_amp_max < 0 || record.pixels_ss_max < 0 || record.extracted < MB_PINGCACHE_EXTRACT_NONE ||
+      record.extracted > MB_PINGCACHE_EXTRACT_ALTITUDE)
+    return (false);
+  const size_t size = sizeof(record) + MB_PINGCACHE_ALIGN(2 * record.nnotice * sizeof(int)) +
+                      MB_PINGCACHE_ALIGN(record.nbath) + 3 * (size_t)record.nbath * sizeof(double) +
+                      (size_t)record.namp * sizeof(double) + 3 * (size_t)record.nss * sizeof(double) +
+                      MB_PINGCACHE_ALIGN(record.ncomment);
+  if (size != (size_t)record.size)
+    return (false);
+  const int *notices = (const int *)&cache->map[offset + sizeof(record)];
+  for (int i = 0; i < record.nnotice; i++)
+    if (notices[2 * i] < 0 || notices[2 * i] >= MB_NOTICE_MAX)
+      return (false);
+  return (true);
+}
+/*--------------------------------------------------------------------*/
+/* map an existing cache file, returning false unless it is complete,
+    describes the same swath file and holds exactly the records listed
+    in its header */
+static bool mb_pingcache_map(struct mb_pingcache_struct *cache) {
+  FILE *fp = fopen(cache->path, "rb");
+  if (fp == NULL)
+    return (false);
+  struct mb_pingcache_header_struct header;
+  struct stat file_status;
+  bool current = fread(&header, sizeof(header), 1, fp) == 1 && fstat(fileno(fp), &file_status) == 0 &&
+                 header.complete == 1 && header.nrecord > 0 &&
+                 memcmp(header.id, cache->header.id, sizeof(header.id)) == 0 &&
+                 strcmp(header.file, cache->header.file) == 0 &&
+                 strcmp(header.projection_id, cache->header.projection_id) == 0 &&
+                 header.format == cache->header.format && header.file_size == cache->header.file_size &&
+                 header.file_mtime == cache->header.file_mtime && header.file_mtime_nsec == cache->header.file_mtime_nsec;
+  if (current) {
+    cache->map_size = (size_t)file_status.st_size;
+    cache->map = (char *)mmap(NULL, cache->map_size, PROT_READ, MAP_SHARED, fileno(fp), 0);
+    if (cache->map == MAP_FAILED) {
+      cache->map = NULL;
+      current = false;
+    }
+    else {
+      size_t offset = sizeof(struct mb_pingcache_header_struct);
+      for (long i = 0; i < header.nrecord && current; i++) {
+        current = mb_pingcache_valid(cache, offset);
+        if (current)
+          offset += (size_t)((const struct mb_pingcache_record_struct *)&cache->map[offset])->size;
+      }
+      if (current && offset == cache->map_size) {
+        cache->header = header;
+        cache->cursor = sizeof(struct mb_pingcache_header_struct);
+      }
+      else {
+        munmap(cache->map, cache->map_size);
+        cache->map = NULL;
+        cache->map_size = 0;
+        current = false;
+      }
+    }
+  }
+  fclose(fp);
+  return (current);
+}
+/*--------------------------------------------------------------------*/
+int mb_set_pingcache(int verbose, void *mbio_ptr, bool use, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+    fprintf(stderr, "dbg2       use:         %d\n", use);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+
+  /* give up any cache already set up */
+  if (mb_io_ptr->pingcache != NULL)
+    mb_pingcache_free(verbose, mb_io_ptr);
+
+  /* the cache can only be used from the start of reading a single file */
+  char dir[MB_PATH_MAXLINE];
+  mb_pingcache(verbose, dir);
+  const bool usable = use && strcmp(dir, "none") != 0 && mb_io_ptr->filemode == MB_FILEMODE_READ &&
+                      mb_io_ptr->read_ahead == NULL && mb_io_ptr->file_bytes == 0 &&
+                      mb_io_ptr->ping_count + mb_io_ptr->nav_count + mb_io_ptr->comment_count == 0;
+
+  struct mb_pingcache_struct *cache = NULL;
+  struct mb_pingcache_header_struct header;
+  mb_path path;
+  if (usable && mb_pingcache_describe(mb_io_ptr, dir, &header, path)) {
+    status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mb_pingcache_struct), (void **)&mb_io_ptr->pingcache, error);
+    if (status == MB_SUCCESS) {
+      cache = (struct mb_pingcache_struct *)mb_io_ptr->pingcache;
+      memset(cache, 0, sizeof(struct mb_pingcache_struct));
+      cache->header = header;
+      strcpy(cache->path, path);
+      cache->lonflip = mb_io_ptr->lonflip;
+
+      /* read a current cache, otherwise write one unless the record index
+          means that reading will skip part of the file */
+      if (mb_pingcache_map(cache)) {
+        cache->mode = MB_PINGCACHE_READ;
+      }
+      else if (!mb_io_ptr->index_seek_pending) {
+        snprintf(cache->tmppath, sizeof(cache->tmppath), "%s.%d.%p", cache->path, (int)getpid(), mbio_ptr);
+        if ((cache->fp = fopen(cache->tmppath, "wb")) != NULL &&
+            fwrite(&cache->header, sizeof(struct mb_pingcache_header_struct), 1, cache->fp) == 1)
+          cache->mode = MB_PINGCACHE_WRITE;
+      }
+      if (cache->mode == 0)
+        mb_pingcache_free(verbose, mb_io_ptr);
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       pingcache:   %p\n", mb_io_ptr->pingcache);
+    if (mb_io_ptr->pingcache != NULL) {
+      fprintf(stderr, "dbg2       mode:        %d\n", ((struct mb_pingcache_struct *)mb_io_ptr->pingcache)->mode);
+      fprintf(stderr, "dbg2       path:        %s\n", ((struct mb_pingcache_struct *)mb_io_ptr->pingcache)->path);
+    }
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+/* write the record for the ping just read and extracted */
+static bool mb_pingcache_write(struct mb_io_struct *mb_io_ptr, struct mb_pingcache_struct *cache, long offset,
+                               int status, int error, int kind, int extracted, int sonartype, double *sensordepth,
+                               double *altitude) {
+  struct mb_pingcache_record_struct record;
+  memset(&record, 0, sizeof(record));
+  record.offset = offset;
+  record.file_pos = mb_io_ptr->file_pos;
+  record.file_bytes = mb_io_ptr->file_bytes;
+  record.status = status;
+  record.error = error;
+  record.kind = kind;
+  record.new_error = mb_io_ptr->new_error;
+  record.extracted = extracted;
+  record.sonartype = sonartype;
+  record.beams_bath_max = mb_io_ptr->beams_bath_max;
+  record.beams_amp_max = mb_io_ptr->beams_amp_max;
+  record.pixels_ss_max = mb_io_ptr->pixels_ss_max;
+  record.beamwidth_xtrack = mb_io_ptr->beamwidth_xtrack;
+  record.beamwidth_ltrack = mb_io_ptr->beamwidth_ltrack;
+  if (extracted != MB_PINGCACHE_EXTRACT_NONE) {
+    record.nbath = MAX(0, MIN(mb_io_ptr->new_beams_bath, mb_io_ptr->beams_bath_alloc));
+    record.namp = MAX(0, MIN(mb_io_ptr->new_beams_amp, mb_io_ptr->beams_amp_alloc));
+    record.nss = MAX(0, MIN(mb_io_ptr->new_pixels_ss, mb_io_ptr->pixels_ss_alloc));
+    for (int i = 0; i < 7; i++)
+      record.time_i[i] = mb_io_ptr->new_time_i[i];
+    record.time_d = mb_io_ptr->new_time_d;
+    record.navlon = mb_io_ptr->new_lon;
+    record.navlat = mb_io_ptr->new_lat;
+    record.speed = mb_io_ptr->new_speed;
+    record.heading = mb_io_ptr->new_heading;
+    if (kind == MB_DATA_COMMENT)
+      record.ncomment = strlen(mb_io_ptr->new_comment) + 1;
+  }
+  if (extracted == MB_PINGCACHE_EXTRACT_ALTITUDE) {
+    record.sensordepth = *sensordepth;
+    record.altitude = *altitude;
+  }
+
+  /* the notices logged while reading and extracting the ping */
+  int notices[2 * MB_NOTICE_MAX];
+  for (int i = 0; i < MB_NOTICE_MAX; i++) {
+    if (mb_io_ptr->notice_list[i] != cache->notice_list[i]) {
+      notices[2 * record.nnotice] = i;
+      notices[2 * record.nnotice + 1] = mb_io_ptr->notice_list[i] - cache->notice_list[i];
+      record.nnotice++;
+    }
+  }
+
+  record.size = sizeof(record) + MB_PINGCACHE_ALIGN(2 * record.nnotice * sizeof(int)) + MB_PINGCACHE_ALIGN(record.nbath) +
+                3 * record.nbath * sizeof(double) + record.namp * sizeof(double) + 3 * record.nss * sizeof(double) +
+                MB_PINGCACHE_ALIGN(record.ncomment);
+
+  const char zero[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  FILE *fp = cache->fp;
+  bool ok = fwrite(&record, sizeof(record), 1, fp) == 1;
+  ok = ok && fwrite(notices, sizeof(int), 2 * record.nnotice, fp) == (size_t)(2 * record.nnotice);
+  ok = ok && fwrite(zero, 1, MB_PINGCACHE_ALIGN(2 * record.nnotice * sizeof(int)) - 2 * record.nnotice * sizeof(int), fp) ==
+                 MB_PINGCACHE_ALIGN(2 * record.nnotice * sizeof(int)) - 2 * record.nnotice * sizeof(int);
+  ok = ok && fwrite(mb_io_ptr->new_beamflag, 1, record.nbath, fp) == (size_t)record.nbath;
+  ok = ok && fwrite(zero, 1, MB_PINGCACHE_ALIGN(record.nbath) - record.nbath, fp) == MB_PINGCACHE_ALIGN(record.nbath) - record.nbath;
+  ok = ok && fwrite(mb_io_ptr->new_bath, sizeof(double), record.nbath, fp) == (size_t)record.nbath;
+  ok = ok && fwrite(mb_io_ptr->new_bath_acrosstrack, sizeof(double), record.nbath, fp) == (size_t)record.nbath;
+  ok = ok && fwrite(mb_io_ptr->new_bath_alongtrack, sizeof(double), record.nbath, fp) == (size_t)record.nbath;
+  ok = ok && fwrite(mb_io_ptr->new_amp, sizeof(double), record.namp, fp) == (size_t)record.namp;
+  ok = ok && fwrite(mb_io_ptr->new_ss, sizeof(double), record.nss, fp) == (size_t)record.nss;
+  ok = ok && fwrite(mb_io_ptr->new_ss_acrosstrack, sizeof(double), record.nss, fp) == (size_t)record.nss;
+  ok = ok && fwrite(mb_io_ptr->new_ss_alongtrack, sizeof(double), record.nss, fp) == (size_t)record.nss;
+  ok = ok && fwrite(mb_io_ptr->new_comment, 1, record.ncomment, fp) == (size_t)record.ncomment;
+  ok = ok && fwrite(zero, 1, MB_PINGCACHE_ALIGN(record.ncomment) - record.ncomment, fp) ==
+                 MB_PINGCACHE_ALIGN(record.ncomment) - record.ncomment;
+  cache->header.nrecord++;
+  return (ok);
+}
+/*--------------------------------------------------------------------*/
+/* return the next cached record as though it had just been read and extracted */
+static int mb_pingcache_read(int verbose, struct mb_io_struct *mb_io_ptr, struct mb_pingcache_struct *cache, int *kind,
+                             double *sensordepth, double *altitude, int *error) {
+  struct mb_pingcache_record_struct record;
+  memcpy(&record, &cache->map[cache->cursor], sizeof(record));
+  const char *ptr = &cache->map[cache->cursor + sizeof(record)];
+
+  /* log the notices logged when the ping was read */
+  const int *notices = (const int *)ptr;
+  for (int i = 0; i < record.nnotice; i++)
+    mb_io_ptr->notice_list[notices[2 * i]] += notices[2 * i + 1];
+  ptr += MB_PINGCACHE_ALIGN(2 * record.nnotice * sizeof(int));
+
+  /* make the arrays as large as when the ping was read */
+  int status = MB_SUCCESS;
+  const int beams_bath = MAX(record.beams_bath_max, record.nbath);
+  const int beams_amp = MAX(record.beams_amp_max, record.namp);
+  const int pixels_ss = MAX(record.pixels_ss_max, record.nss);
+  if (beams_bath > mb_io_ptr->beams_bath_alloc || beams_amp > mb_io_ptr->beams_amp_alloc ||
+      pixels_ss > mb_io_ptr->pixels_ss_alloc)
+    status = mb_update_arrays(verbose, (void *)mb_io_ptr, beams_bath, beams_amp, pixels_ss, error);
+  mb_io_ptr->beams_bath_max = MAX(mb_io_ptr->beams_bath_max, record.beams_bath_max);
+  mb_io_ptr->beams_amp_max = MAX(mb_io_ptr->beams_amp_max, record.beams_amp_max);
+  mb_io_ptr->pixels_ss_max = MAX(mb_io_ptr->pixels_ss_max, record.pixels_ss_max);
+  if (status == MB_FAILURE)
+    return (status);
+
+  /* return the values extracted from the ping */
+  if (record.extracted != MB_PINGCACHE_EXTRACT_NONE) {
+    for (int i = 0; i < 7; i++)
+      mb_io_ptr->new_time_i[i] = record.time_i[i];
+    mb_io_ptr->new_time_d = record.time_d;
+    mb_io_ptr->new_lon = record.navlon;
+    mb_io_ptr->new_lat = record.navlat;
+    mb_io_ptr->new_speed = record.speed;
+    mb_io_ptr->new_heading = record.heading;
+    mb_io_ptr->new_beams_bath = record.nbath;
+    mb_io_ptr->new_beams_amp = record.namp;
+    mb_io_ptr->new_pixels_ss = record.nss;
+    memcpy(mb_io_ptr->new_beamflag, ptr, record.nbath);
+    ptr += MB_PINGCACHE_ALIGN(record.nbath);
+    memcpy(mb_io_ptr->new_bath, ptr, record.nbath * sizeof(double));
+    ptr += record.nbath * sizeof(double);
+    memcpy(mb_io_ptr->new_bath_acrosstrack, ptr, record.nbath * sizeof(double));
+    ptr += record.nbath * sizeof(double);
+    memcpy(mb_io_ptr->new_bath_alongtrack, ptr, record.nbath * sizeof(double));
+    ptr += record.nbath * sizeof(double);
+    memcpy(mb_io_ptr->new_amp, ptr, record.namp * sizeof(double));
+    ptr += record.namp * sizeof(double);
+    memcpy(mb_io_ptr->new_ss, ptr, record.nss * sizeof(double));
+    ptr += record.nss * sizeof(double);
+    memcpy(mb_io_ptr->new_ss_acrosstrack, ptr, record.nss * sizeof(double));
+    ptr += record.nss * sizeof(double);
+    memcpy(mb_io_ptr->new_ss_alongtrack, ptr, record.nss * sizeof(double));
+    ptr += record.nss * sizeof(double);
+    if (record.ncomment > 0)
+      memcpy(mb_io_ptr->new_comment, ptr, MIN(record.ncomment, MB_COMMENT_MAXLINE));
+    mb_io_ptr->new_comment[MB_COMMENT_MAXLINE - 1] = '\0';
+
+    /* apply lonflip again if it has been changed since the cache was written */
+    if (mb_io_ptr->lonflip != cache->header.lonflip) {
+      if (mb_io_ptr->lonflip < 0) {
+        if (mb_io_ptr->new_lon > 0.)
+          mb_io_ptr->new_lon = mb_io_ptr->new_lon - 360.;
+        else if (mb_io_ptr->new_lon < -360.)
+          mb_io_ptr->new_lon = mb_io_ptr->new_lon + 360.;
+      }
+      else if (mb_io_ptr->lonflip == 0) {
+        if (mb_io_ptr->new_lon > 180.)
+          mb_io_ptr->new_lon = mb_io_ptr->new_lon - 360.;
+        else if (mb_io_ptr->new_lon < -180.)
+          mb_io_ptr->new_lon = mb_io_ptr->new_lon + 360.;
+      }
+      else {
+        if (mb_io_ptr->new_lon > 360.)
+          mb_io_ptr->new_lon = mb_io_ptr->new_lon - 360.;
+        else if (mb_io_ptr->new_lon < 0.)
+          mb_io_ptr->new_lon = mb_io_ptr->new_lon + 360.;
+      }
+    }
+  }
+  if (record.extracted == MB_PINGCACHE_EXTRACT_ALTITUDE) {
+    *sensordepth = record.sensordepth;
+    *altitude = record.altitude;
+  }
+  *kind = record.kind;
+  *error = record.error;
+  mb_io_ptr->new_error = record.new_error;
+  mb_io_ptr->file_pos = record.file_pos;
+  mb_io_ptr->file_bytes = record.file_bytes;
+  mb_io_ptr->beamwidth_xtrack = record.beamwidth_xtrack;
+  mb_io_ptr->beamwidth_ltrack = record.beamwidth_ltrack;
+  cache->sonartype_set = true;
+  cache->sonartype = record.sonartype;
+  cache->nserved++;
+
+  /* move on to the next record, except that the final record (the end of
+      file) is returned again by any further calls as with reading the file */
+  if (cache->nserved < cache->header.nrecord) {
+    cache->cursor += record.size;
+
+    /* skip ahead after the first record as mb_read_ping() does if the
+        record index shows that the first records are not needed, using
+        the byte offsets at which the records were read as the index does
+        because file_pos is only as accurate as each format's byte count */
+    if (cache->nserved == 1 && record.status == MB_SUCCESS && mb_io_ptr->index_seek_pending) {
+      mb_io_ptr->index_seek_pending = false;
+      struct mb_pingcache_record_struct next;
+      memcpy(&next, &cache->map[cache->cursor], sizeof(next));
+      while (cache->nserved < cache->header.nrecord - 1 && next.offset < mb_io_ptr->index_seek_offset) {
+        cache->cursor += next.size;
+        cache->nserved++;
+        cache->nskipped++;
+        memcpy(&next, &cache->map[cache->cursor], sizeof(next));
+      }
+    }
+  }
+
+  return (record.status);
+}
+/*--------------------------------------------------------------------*/
+int mb_pingcache_get(int verbose, void *mbio_ptr, void *store_ptr, int *kind, double *sensordepth, double *altitude,
+                     int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+    fprintf(stderr, "dbg2       store_ptr:   %p\n", (void *)store_ptr);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  struct mb_pingcache_struct *cache = (struct mb_pingcache_struct *)mb_io_ptr->pingcache;
+  int status = MB_SUCCESS;
+
+  /* give up a cache whose next record is damaged, reading the swath
+      file up to the same point instead */
+  if (cache != NULL && cache->mode == MB_PINGCACHE_READ && !mb_pingcache_valid(cache, cache->cursor)) {
+    mb_pingcache_detach(verbose, mbio_ptr, store_ptr, error);
+    cache = NULL;
+  }
+
+  /* return the next ping from the cache */
+  if (cache != NULL && cache->mode == MB_PINGCACHE_READ) {
+    status = mb_pingcache_read(verbose, mb_io_ptr, cache, kind, sensordepth, altitude, error);
+  }
+
+  /* otherwise read and extract the next ping, writing it to the cache if one is being written */
+  else {
+    long offset = 0;
+    if (cache != NULL) {
+      memcpy(cache->notice_list, mb_io_ptr->notice_list, sizeof(cache->notice_list));
+      cache->reading = true;
+      offset = ftell(mb_io_ptr->mbfp);
+    }
+    status = mb_read_ping(verbose, mbio_ptr, store_ptr, kind, error);
+    if (cache != NULL)
+      cache->reading = false;
+    int extracted = MB_PINGCACHE_EXTRACT_NONE;
+    if (status == MB_SUCCESS && (*kind == MB_DATA_DATA || *kind == MB_DATA_COMMENT)) {
+      status = mb_extract(verbose, mbio_ptr, store_ptr, kind, mb_io_ptr->new_time_i, &mb_io_ptr->new_time_d,
+                          &mb_io_ptr->new_lon, &mb_io_ptr->new_lat, &mb_io_ptr->new_speed, &mb_io_ptr->new_heading,
+                          &mb_io_ptr->new_beams_bath, &mb_io_ptr->new_beams_amp, &mb_io_ptr->new_pixels_ss,
+                          mb_io_ptr->new_beamflag, mb_io_ptr->new_bath, mb_io_ptr->new_amp, mb_io_ptr->new_bath_acrosstrack,
+                          mb_io_ptr->new_bath_alongtrack, mb_io_ptr->new_ss, mb_io_ptr->new_ss_acrosstrack,
+                          mb_io_ptr->new_ss_alongtrack, mb_io_ptr->new_comment, error);
+      extracted = MB_PINGCACHE_EXTRACT;
+    }
+    if (status == MB_SUCCESS && *kind == MB_DATA_DATA) {
+      status = mb_extract_altitude(verbose, mbio_ptr, store_ptr, kind, sensordepth, altitude, error);
+      extracted = MB_PINGCACHE_EXTRACT_ALTITUDE;
+    }
+
+    /* write the ping to the cache, putting the cache in place once the
+        end of the file is reached and giving it up on any other fatal error */
+    if (cache != NULL && mb_io_ptr->pingcache == cache) {
+      int sonartype = MB_TOPOGRAPHY_TYPE_UNKNOWN;
+      int lerror = MB_ERROR_NO_ERROR;
+      mb_sonartype(verbose, mbio_ptr, store_ptr, &sonartype, &lerror);
+      bool ok = mb_pingcache_write(mb_io_ptr, cache, offset, status, *error, *kind, extracted, sonartype, sensordepth,
+                                   altitude);
+      if (ok && status == MB_FAILURE && *error == MB_ERROR_EOF) {
+        cache->header.complete = 1;
+        ok = fseek(cache->fp, 0, SEEK_SET) == 0 &&
+             fwrite(&cache->header, sizeof(struct mb_pingcache_header_struct), 1, cache->fp) == 1;
+        ok = (fclose(cache->fp) == 0) && ok;
+        cache->fp = NULL;
+        if (!ok || rename(cache->tmppath, cache->path) != 0)
+          unlink(cache->tmppath);
+        mb_pingcache_free(verbose, mb_io_ptr);
+      }
+      else if (!ok || (status == MB_FAILURE && *error > MB_ERROR_NO_ERROR)) {
+        mb_pingcache_free(verbose, mb_io_ptr);
+      }
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       kind:        %d\n", *kind);
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_pingcache_detach(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+    fprintf(stderr, "dbg2       store_ptr:   %p\n", (void *)store_ptr);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  struct mb_pingcache_struct *cache = (struct mb_pingcache_struct *)mb_io_ptr->pingcache;
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+
+  /* records read directly rather than by mb_pingcache_get() would be
+      missing from a cache being written, and are not yet read from the
+      file if pings have been returned from the cache - in the latter case
+      read the file up to the same point without logging notices twice,
+      where the records skipped by an index seek are skipped again by
+      mb_read_ping() and so are not read */
+  if (cache != NULL && !cache->reading) {
+    const long nserved = cache->nserved - cache->nskipped;
+    mb_pingcache_free(verbose, mb_io_ptr);
+    if (nserved > 0) {
+      int notice_list[MB_NOTICE_MAX];
+      memcpy(notice_list, mb_io_ptr->notice_list, sizeof(notice_list));
+      mb_io_ptr->index_seek_pending = mb_io_ptr->index_seek_offset > 0;
+      mb_io_ptr->file_pos = 0;
+      mb_io_ptr->file_bytes = 0;
+      for (long i = 0; i < nserved; i++) {
+        int kind;
+        int lerror = MB_ERROR_NO_ERROR;
+        mb_read_ping(verbose, mbio_ptr, store_ptr, &kind, &lerror);
+      }
+      memcpy(mb_io_ptr->notice_list, notice_list, sizeof(notice_list));
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       pingcache:   %p\n", mb_io_ptr->pingcache);
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_pingcache_sonartype(int verbose, void *mbio_ptr, int *sonartype, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  struct mb_pingcache_struct *cache = (struct mb_pingcache_struct *)mb_io_ptr->pingcache;
+
+  /* the data store is not filled when pings are returned from the cache,
+      so the sonar type of the last ping returned is kept in the cache */
+  int status = MB_FAILURE;
+  if (cache != NULL && cache->mode == MB_PINGCACHE_READ && cache->sonartype_set) {
+    *sonartype = cache->sonartype;
+    *error = MB_ERROR_NO_ERROR;
+    status = MB_SUCCESS;
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    if (status == MB_SUCCESS)
+      fprintf(stderr, "dbg2       sonartype:   %d\n", *sonartype);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_pingcache_close(int verbose, void *mbio_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  if (mb_io_ptr->pingcache != NULL)
+    mb_pingcache_free(verbose, mb_io_ptr);
+  *error = MB_ERROR_NO_ERROR;
+  const int status = MB_SUCCESS;
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
@@ -1033,7 +1033,7 @@ struct mb_esf_struct {
   struct mb_edit_struct *edit;
   FILE *esffp;
   FILE *essfp;
-  int startnextsearch;
+  void *index; /* hashed (time_d, beam) edit lookup built by mb_esf_open() */
 };
 
 #ifdef __cplusplus
@@ -1160,12 +1160,15 @@ int mb_esf_check(int verbose, char *swathfile, char *esffile, int *found, int *e
 int mb_esf_load(int verbose, const char *program_name, char *swathfile, bool load, int output, char *esffile, struct mb_esf_struct *esf,
                 int *error);
 int mb_esf_open(int verbose, const char *program_name, char *esffile, bool load, int output, struct mb_esf_struct *esf, int *error);
+int mb_esf_open_window(int verbose, const char *program_name, char *esffile, double time_d_min, double time_d_max,
+                       struct mb_esf_struct *esf, int *error);
 int mb_esf_fixtimestamps(int verbose, struct mb_esf_struct *esf, double time_d, double tolerance, int *error);
 int mb_esf_apply(int verbose, struct mb_esf_struct *esf, double time_d, int pingmultiplicity, int nbath, char *beamflag,
                  int *error);
 int mb_esf_save(int verbose, struct mb_esf_struct *esf, double time_d, int beam, int action, int *error);
 int mb_ess_save(int verbose, struct mb_esf_struct *esf, double time_d, int beam, int action, int *error);
 int mb_esf_close(int verbose, struct mb_esf_struct *esf, int *error);
+int mb_esf_compact(int verbose, const char *program_name, char *esffile, int *error);
 
 int mb_pr_lockswathfile(int verbose, const char *file, int purpose, const char *program_name, int *error);
 int mb_pr_unlockswathfile(int verbose, const char *file, int purpose, const char *program_name, int *error);
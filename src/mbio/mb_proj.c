@@ -31,6 +31,10 @@
  * between geographic coordinates (longitude and latitude) and
  * projected coordinates (e.g. eastings and northings in meters).
  * One can also tranlate between coordinate systems using mb_proj_transform().
+ * Arrays of coordinates are projected in one call with mb_proj_forward_array()
+ * and mb_proj_inverse_array(), and mb_proj_init_cached() returns projections
+ * from a per-thread cache keyed by the projection string. mb_read_init() uses
+ * the cache for the projections named by *.prj files.
  * This code uses libproj. The code in libproj derives without modification
  * from the PROJ.4 distribution. PROJ was originally developed by
  * Gerard Evandim, and is now maintained and distributed by
@@ -48,7 +52,9 @@
  */
 
 #include <math.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <string.h>
@@ -283,6 +289,115 @@ int mb_proj_inverse(int verbose, void *pjptr, double easting, double northing, d
   return (status);
 }
 
+/*--------------------------------------------------------------------*/
+int mb_proj_forward_array(int verbose, void *pjptr, int n, double *u, double *v, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       pjptr:      %p\n", (void *)pjptr);
+    fprintf(stderr, "dbg2       n:          %d\n", n);
+    for (int i = 0; i < n; i++)
+      fprintf(stderr, "dbg2       u[%d]: %f v[%d]: %f\n", i, u[i], i, v[i]);
+  }
+
+  /* do forward projections in place - failed projections are
+      returned as HUGE_VAL */
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  if (pjptr != NULL) {
+    projPJ pj = (projPJ)pjptr;
+    for (int i = 0; i < n; i++) {
+      projUV pjll;
+      pjll.u = DTR * u[i];
+      pjll.v = DTR * v[i];
+      projUV pjxy = pj_fwd(pjll, pj);
+      u[i] = pjxy.u;
+      v[i] = pjxy.v;
+      if (pjxy.u == HUGE_VAL || pjxy.v == HUGE_VAL) {
+        *error = MB_ERROR_BAD_PROJECTION;
+        status = MB_FAILURE;
+      }
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    for (int i = 0; i < n; i++)
+      fprintf(stderr, "dbg2       u[%d]: %f v[%d]: %f\n", i, u[i], i, v[i]);
+    fprintf(stderr, "dbg2       error:           %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:          %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_proj_inverse_array(int verbose, void *pjptr, int n, double *u, double *v, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       pjptr:      %p\n", (void *)pjptr);
+    fprintf(stderr, "dbg2       n:          %d\n", n);
+    for (int i = 0; i < n; i++)
+      fprintf(stderr, "dbg2       u[%d]: %f v[%d]: %f\n", i, u[i], i, v[i]);
+  }
+
+  /* do inverse projections in place - failed projections are
+      returned as HUGE_VAL */
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  if (pjptr != NULL) {
+    projPJ pj = (projPJ)pjptr;
+    for (int i = 0; i < n; i++) {
+      projUV pjxy;
+      pjxy.u = u[i];
+      pjxy.v = v[i];
+      projUV pjll = pj_inv(pjxy, pj);
+      if (pjll.u == HUGE_VAL || pjll.v == HUGE_VAL) {
+        u[i] = HUGE_VAL;
+        v[i] = HUGE_VAL;
+        *error = MB_ERROR_BAD_PROJECTION;
+        status = MB_FAILURE;
+      }
+      else {
+        u[i] = RTD * pjll.u;
+        v[i] = RTD * pjll.v;
+      }
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    for (int i = 0; i < n; i++)
+      fprintf(stderr, "dbg2       u[%d]: %f v[%d]: %f\n", i, u[i], i, v[i]);
+    fprintf(stderr, "dbg2       error:           %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:          %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+/* the obsolete PROJ 4 API has no contexts, so cached projections are
+    created as by mb_proj_init() */
+static void *mb_proj_context_create(void) {
+  return (NULL);
+}
+static void mb_proj_context_destroy(void *context) {
+  (void)context;
+}
+static int mb_proj_create(int verbose, void *context, char *target_crs, void **pjptr, int *error) {
+  (void)context;
+  return (mb_proj_init(verbose, target_crs, pjptr, error));
+}
+static void mb_proj_destroy(void *pjptr) {
+  pj_free((projPJ)pjptr);
+}
+
 /*--------------------------------------------------------------------*/
 /*--------------------------------------------------------------------*/
 // Otherwise use the PROJ 6+ API
@@ -291,7 +406,7 @@ int mb_proj_inverse(int verbose, void *pjptr, double easting, double northing, d
 #include <proj.h>
 
 /*--------------------------------------------------------------------*/
-static int mb_proj6_init(int verbose, char *source_crs, char *target_crs, void **pjptr, int *error) {
+static int mb_proj6_init(int verbose, PJ_CONTEXT *context, char *source_crs, char *target_crs, void **pjptr, int *error) {
 
   if (verbose >= 2) {
     fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
@@ -384,8 +499,8 @@ static int mb_proj6_init(int verbose, char *source_crs, char *target_crs, void *
   }
 
   /* initialize the geodetic operation */
-  PJ *p = proj_create_crs_to_crs(PJ_DEFAULT_CTX, source, target, 0);
-  *pjptr = (void *) proj_normalize_for_visualization(PJ_DEFAULT_CTX, p);
+  PJ *p = proj_create_crs_to_crs(context, source, target, 0);
+  *pjptr = (void *) proj_normalize_for_visualization(context, p);
   proj_destroy(p);
 
   /* check success */
@@ -427,7 +542,7 @@ int mb_proj_init(int verbose, char *target_crs, void **pjptr, int *error) {
   // Here we add the source CRS and call the new init function, which allows
   // transformation between arbritrarily defined CRSs.
   mb_path source_crs = "EPSG:4326";
-  status = mb_proj6_init(verbose, source_crs, target_crs, pjptr,  error);
+  status = mb_proj6_init(verbose, PJ_DEFAULT_CTX, source_crs, target_crs, pjptr,  error);
 
   /* check success */
   if (*pjptr == NULL) {
@@ -557,5 +672,244 @@ int mb_proj_inverse(int verbose, void *pjptr, double u, double v, double *uu, do
   return (status);
 }
 /*--------------------------------------------------------------------*/
+int mb_proj_forward_array(int verbose, void *pjptr, int n, double *u, double *v, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       pjptr:      %p\n", (void *)pjptr);
+    fprintf(stderr, "dbg2       n:          %d\n", n);
+    for (int i = 0; i < n; i++)
+      fprintf(stderr, "dbg2       u[%d]: %f v[%d]: %f\n", i, u[i], i, v[i]);
+  }
+
+  /* do forward projections in place with a single call to PROJ - PROJ
+      returns the number of coordinates transformed and sets any
+      coordinate it fails to transform to HUGE_VAL */
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  if (pjptr != NULL && n > 0) {
+    PJ *p = (PJ *) pjptr;
+    const size_t ntrans = proj_trans_generic(p, PJ_FWD, u, sizeof(double), (size_t)n, v, sizeof(double), (size_t)n,
+                                             NULL, 0, 0, NULL, 0, 0);
+    bool failed = ntrans != (size_t)n;
+    for (int i = 0; i < n && !failed; i++) {
+      if (u[i] == HUGE_VAL || v[i] == HUGE_VAL)
+        failed = true;
+    }
+    if (failed) {
+      *error = MB_ERROR_BAD_PROJECTION;
+      status = MB_FAILURE;
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    for (int i = 0; i < n; i++)
+      fprintf(stderr, "dbg2       u[%d]: %f v[%d]: %f\n", i, u[i], i, v[i]);
+    fprintf(stderr, "dbg2       error:           %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:          %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_proj_inverse_array(int verbose, void *pjptr, int n, double *u, double *v, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       pjptr:      %p\n", (void *)pjptr);
+    fprintf(stderr, "dbg2       n:          %d\n", n);
+    for (int i = 0; i < n; i++)
+      fprintf(stderr, "dbg2       u[%d]: %f v[%d]: %f\n", i, u[i], i, v[i]);
+  }
+
+  /* do inverse projections in place with a single call to PROJ - PROJ
+      returns the number of coordinates transformed and sets any
+      coordinate it fails to transform to HUGE_VAL */
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  if (pjptr != NULL && n > 0) {
+    PJ *p = (PJ *) pjptr;
+    const size_t ntrans = proj_trans_generic(p, PJ_INV, u, sizeof(double), (size_t)n, v, sizeof(double), (size_t)n,
+                                             NULL, 0, 0, NULL, 0, 0);
+    bool failed = ntrans != (size_t)n;
+    for (int i = 0; i < n && !failed; i++) {
+      if (u[i] == HUGE_VAL || v[i] == HUGE_VAL)
+        failed = true;
+    }
+    if (failed) {
+      *error = MB_ERROR_BAD_PROJECTION;
+      status = MB_FAILURE;
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    for (int i = 0; i < n; i++)
+      fprintf(stderr, "dbg2       u[%d]: %f v[%d]: %f\n", i, u[i], i, v[i]);
+    fprintf(stderr, "dbg2       error:           %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:          %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+/* cached projections are created in a PROJ context belonging to the
+    thread that uses them */
+static void *mb_proj_context_create(void) {
+  return ((void *)proj_context_create());
+}
+static void mb_proj_context_destroy(void *context) {
+  if (context != NULL)
+    proj_context_destroy((PJ_CONTEXT *)context);
+}
+static int mb_proj_create(int verbose, void *context, char *target_crs, void **pjptr, int *error) {
+  mb_path source_crs = "EPSG:4326";
+  return (mb_proj6_init(verbose, (PJ_CONTEXT *)context, source_crs, target_crs, pjptr, error));
+}
+static void mb_proj_destroy(void *pjptr) {
+  proj_destroy((PJ *)pjptr);
+}
+/*--------------------------------------------------------------------*/
 
 #endif
+
+/*--------------------------------------------------------------------*/
+/*--------------------------------------------------------------------*/
+/* Each thread keeps its own cache of projections keyed by the projection
+    string, because a PROJ object may only be used by one thread at a time.
+    Threads projecting with the same definition each initialize it once
+    rather than once per file or per call. */
+struct mb_proj_cache_entry_struct {
+  mb_path projection;
+  void *pjptr;
+  struct mb_proj_cache_entry_struct *next;
+};
+struct mb_proj_cache_struct {
+  void *context;
+  struct mb_proj_cache_entry_struct *entries;
+};
+static pthread_key_t mb_proj_cache_key;
+static pthread_once_t mb_proj_cache_once = PTHREAD_ONCE_INIT;
+
+/*--------------------------------------------------------------------*/
+static void mb_proj_cache_delete(void *ptr) {
+  struct mb_proj_cache_struct *cache = (struct mb_proj_cache_struct *)ptr;
+  if (cache != NULL) {
+    struct mb_proj_cache_entry_struct *entry = cache->entries;
+    while (entry != NULL) {
+      struct mb_proj_cache_entry_struct *next = entry->next;
+      mb_proj_destroy(entry->pjptr);
+      free(entry);
+      entry = next;
+    }
+    mb_proj_context_destroy(cache->context);
+    free(cache);
+  }
+}
+/*--------------------------------------------------------------------*/
+static void mb_proj_cache_key_create(void) {
+  pthread_key_create(&mb_proj_cache_key, mb_proj_cache_delete);
+}
+/*--------------------------------------------------------------------*/
+int mb_proj_init_cached(int verbose, char *projection, void **pjptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       projection: %s\n", projection);
+  }
+
+  *error = MB_ERROR_NO_ERROR;
+  int status = MB_SUCCESS;
+  *pjptr = NULL;
+
+  /* get the cache of the calling thread */
+  pthread_once(&mb_proj_cache_once, mb_proj_cache_key_create);
+  struct mb_proj_cache_struct *cache = (struct mb_proj_cache_struct *)pthread_getspecific(mb_proj_cache_key);
+  if (cache == NULL) {
+    cache = (struct mb_proj_cache_struct *)calloc(1, sizeof(struct mb_proj_cache_struct));
+    if (cache != NULL) {
+      cache->context = mb_proj_context_create();
+      pthread_setspecific(mb_proj_cache_key, cache);
+    }
+  }
+  if (cache == NULL) {
+    *error = MB_ERROR_MEMORY_FAIL;
+    status = MB_FAILURE;
+  }
+
+  /* look for the projection, initializing and caching it if not found */
+  if (status == MB_SUCCESS) {
+    for (struct mb_proj_cache_entry_struct *entry = cache->entries; entry != NULL && *pjptr == NULL; entry = entry->next) {
+      if (strcmp(entry->projection, projection) == 0)
+        *pjptr = entry->pjptr;
+    }
+    if (*pjptr == NULL) {
+      struct mb_proj_cache_entry_struct *entry =
+          (struct mb_proj_cache_entry_struct *)calloc(1, sizeof(struct mb_proj_cache_entry_struct));
+      if (entry == NULL) {
+        *error = MB_ERROR_MEMORY_FAIL;
+        status = MB_FAILURE;
+      }
+      else {
+        status = mb_proj_create(verbose, cache->context, projection, &entry->pjptr, error);
+        if (status == MB_SUCCESS && entry->pjptr != NULL) {
+          strncpy(entry->projection, projection, sizeof(mb_path) - 1);
+          entry->next = cache->entries;
+          cache->entries = entry;
+          *pjptr = entry->pjptr;
+        }
+        else {
+          free(entry);
+          *error = (*error == MB_ERROR_NO_ERROR ? MB_ERROR_BAD_PROJECTION : *error);
+          status = MB_FAILURE;
+        }
+      }
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       pjptr:           %p\n", (void *)*pjptr);
+    fprintf(stderr, "dbg2       error:           %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:          %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_proj_cache_free(int verbose, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+  }
+
+  /* free the projections cached by the calling thread */
+  pthread_once(&mb_proj_cache_once, mb_proj_cache_key_create);
+  mb_proj_cache_delete(pthread_getspecific(mb_proj_cache_key));
+  pthread_setspecific(mb_proj_cache_key, NULL);
+
+  *error = MB_ERROR_NO_ERROR;
+  const int status = MB_SUCCESS;
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:           %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:          %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
@@ -104,7 +104,12 @@ int mb_read(int verbose, void *mbio_ptr, int *kind, int *pings, int time_i[7], d
 
 		/* get next ping */
 		if (mb_io_ptr->need_new_ping) {
-			status = mb_read_ping(verbose, mbio_ptr, store_ptr, &mb_io_ptr->new_kind, error);
+			/* pings returned through a ping cache are already extracted */
+			const bool cached = mb_io_ptr->pingcache != NULL;
+			if (cached)
+				status = mb_pingcache_get(verbose, mbio_ptr, store_ptr, &mb_io_ptr->new_kind, sensordepth, altitude, error);
+			else
+				status = mb_read_ping(verbose, mbio_ptr, store_ptr, &mb_io_ptr->new_kind, error);
 
 			/* log errors */
 			if (*error < MB_ERROR_NO_ERROR)
@@ -134,7 +139,7 @@ int mb_read(int verbose, void *mbio_ptr, int *kind, int *pings, int time_i[7], d
 			}
 
 			/* if survey data read into storage array */
-			if (status == MB_SUCCESS && (mb_io_ptr->new_kind == MB_DATA_DATA || mb_io_ptr->new_kind == MB_DATA_COMMENT)) {
+			if (!cached && status == MB_SUCCESS && (mb_io_ptr->new_kind == MB_DATA_DATA || mb_io_ptr->new_kind == MB_DATA_COMMENT)) {
 				status = mb_extract(verbose, mbio_ptr, store_ptr, &mb_io_ptr->new_kind, mb_io_ptr->new_time_i,
 				                    &mb_io_ptr->new_time_d, &mb_io_ptr->new_lon, &mb_io_ptr->new_lat, &mb_io_ptr->new_speed,
 				                    &mb_io_ptr->new_heading, &mb_io_ptr->new_beams_bath, &mb_io_ptr->new_beams_amp,
@@ -142,7 +147,7 @@ int mb_read(int verbose, void *mbio_ptr, int *kind, int *pings, int time_i[7], d
 				                    mb_io_ptr->new_bath_acrosstrack, mb_io_ptr->new_bath_alongtrack, mb_io_ptr->new_ss,
 				                    mb_io_ptr->new_ss_acrosstrack, mb_io_ptr->new_ss_alongtrack, mb_io_ptr->new_comment, error);
 			}
-			if (status == MB_SUCCESS && mb_io_ptr->new_kind == MB_DATA_DATA) {
+			if (!cached && status == MB_SUCCESS && mb_io_ptr->new_kind == MB_DATA_DATA) {
 				status = mb_extract_altitude(verbose, mbio_ptr, store_ptr, &mb_io_ptr->new_kind, sensordepth, altitude, error);
 			}
 
@@ -0,0 +1,550 @@
+/*--------------------------------------------------------------------
+ *    The MB-system:  mb_read_ahead.c  10/15/2026
+ *
+ *    Copyright (c) 2026 by
+ *    David W. Caress (caress@mbari.org)
+ *      Monterey Bay Aquarium Research Institute
+ *      Moss Landing, California, USA
+ *    Dale N. Chayes
+ *      Center for Coastal and Ocean Mapping
+ *      University of New Hampshire
+ *      Durham, New Hampshire, USA
+ *    Christian dos Santos Ferreira
+ *      MARUM
+ *      University of Bremen
+ *      Bremen Germany
+ *
+ *    MB-System was created by Caress and Chayes in 1992 at the
+ *      Lamont-Doherty Earth Observatory
+ *      Columbia University
+ *      Palisades, NY 10964
+ *
+ *    See README.md file for copying and redistribution conditions.
+ *--------------------------------------------------------------------*/
+/*
+ * mb_read_ahead.c contains functions that allow the records of a swath
+ * file opened with mb_read_init() to be read and decoded by a background
+ * thread while the calling program processes the records already
+ * returned. The background thread reads the file through a second
+ * mbio descriptor opened on the same file with the same control
+ * parameters, and places each record read by mb_read_ping() into the
+ * next free store of a ring of nahead stores. Each call to mb_read_ping()
+ * for the original descriptor then copies the oldest waiting record into
+ * the caller's store with mb_copyrecord() and returns the status, error
+ * and record kind obtained by the background thread, so the records,
+ * their order and the errors returned are the same as for synchronous
+ * reading. Because the background thread continues reading while the
+ * caller works, i/o and decoding are overlapped with the processing done
+ * by the calling program.
+ *
+ * Read-ahead is only used for i/o modules that set read_ahead_safe,
+ * meaning that the records are self contained and the module keeps no
+ * state in the mbio descriptor (e.g. asynchronous navigation lists)
+ * that later extraction from the store depends on. For other formats,
+ * for stdin, and once reading has started, mb_read_ahead_init() silently
+ * leaves the descriptor reading synchronously.
+ *
+ * Read-ahead is started either explicitly by calling mb_read_ahead_init()
+ * after mb_read_init(), or for all programs by setting a positive
+ * readahead value with mbdefaults, in which case it starts with the first
+ * call to mb_read_ping(). It is stopped by mb_close().
+ *
+ * If more than one thread is requested and the i/o module can both start
+ * reading at any record (index_seekable) and skip over a record without
+ * decoding it (mb_io_frame), the records are decoded in parallel in two
+ * phases. First a framing scan reads only the record headers to find
+ * the offset of every record in the file. Then each of the threads,
+ * reading through its own descriptor, repeatedly claims the next record,
+ * seeks to its offset and reads it with mb_read_ping() into the slot
+ * reserved for that record, so that the records are still returned to
+ * the caller in file order. If the framing scan does not reach the end of
+ * the file cleanly, for instance because the file is truncated or
+ * corrupted, a single thread reads the file sequentially instead so
+ * that the errors returned are unchanged.
+ *
+ * Parallel decoding is currently limited to the mbldeoih format (71),
+ * the only i/o module that is both read_ahead_safe and provides
+ * mb_io_frame. Although the kmall, 7k3, em710raw and GSF records are
+ * self framing, decoding them in isolation would not reproduce the
+ * records returned by sequential reading: the kmall and 7k3 readers
+ * assemble pings from several datagrams and records and, like the
+ * em710raw reader, interpolate navigation and attitude from
+ * asynchronous records accumulated in the mbio descriptor, and the GSF
+ * library decodes each ping with the scale factors carried over from
+ * earlier pings. Those formats are always read sequentially.
+ *
+ * These functions include:
+ *   mb_read_ahead_init  - open the second descriptors and start the background threads
+ *   mb_read_ahead_next  - return the next record read by the background threads
+ *   mb_read_ahead_close - stop the background threads and release all memory
+ *
+ * Author:  D. W. Caress
+ * Date:  15 October 2026
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+/* read-ahead record slot */
+struct mb_read_ahead_slot_struct {
+  void *store;
+  bool ready;
+  int status;
+  int error;
+  int kind;
+  long file_pos;
+  long file_bytes;
+};
+
+/* read-ahead thread and the descriptor it reads */
+struct mb_read_ahead_thread_struct {
+  struct mb_read_ahead_struct *ahead;
+  void *shadow_ptr;
+  pthread_t thread;
+  bool started;
+};
+
+/* read-ahead control structure */
+struct mb_read_ahead_struct {
+  /* background threads */
+  int nthread;
+  struct mb_read_ahead_thread_struct *threads;
+
+  /* offsets of the records found by the framing scan followed by the
+      end of the file, NULL if a single thread reads sequentially */
+  int nrecord;
+  long *offset;
+
+  /* ring of records read ahead - record i is held in slot i % nslot,
+      records are claimed by the threads in order and released by the
+      caller in order, and record ilast is the final one (-1 until known) */
+  int nslot;
+  struct mb_read_ahead_slot_struct *slots;
+  int nclaimed;
+  int nreleased;
+  int ilast;
+  bool abort;
+
+  /* synchronization */
+  pthread_mutex_t mutex;
+  pthread_cond_t data_ready;
+  pthread_cond_t space_ready;
+};
+
+/*--------------------------------------------------------------------*/
+/* background thread reading records through its own descriptor */
+static void *mb_read_ahead_thread(void *arg) {
+  struct mb_read_ahead_thread_struct *reader = (struct mb_read_ahead_thread_struct *)arg;
+  struct mb_read_ahead_struct *ahead = reader->ahead;
+  struct mb_io_struct *shadow_io_ptr = (struct mb_io_struct *)reader->shadow_ptr;
+
+  /* a projection named by a *.prj file was taken by mb_read_init() from
+      the per-thread cache of the caller, whose PROJ context must not be
+      used from this thread, so take it from this thread's own cache */
+  if (shadow_io_ptr->projection_initialized && shadow_io_ptr->projection_cached) {
+    int lerror = MB_ERROR_NO_ERROR;
+    if (mb_proj_init_cached(0, shadow_io_ptr->projection_id, &shadow_io_ptr->pjptr, &lerror) != MB_SUCCESS)
+      shadow_io_ptr->projection_initialized = false;
+  }
+
+  while (true) {
+    /* claim the next record once its slot is free */
+    pthread_mutex_lock(&ahead->mutex);
+    while (!ahead->abort && (ahead->ilast < 0 || ahead->nclaimed <= ahead->ilast) &&
+           ahead->nclaimed >= ahead->nreleased + ahead->nslot)
+      pthread_cond_wait(&ahead->space_ready, &ahead->mutex);
+    const bool finished = ahead->abort || (ahead->ilast >= 0 && ahead->nclaimed > ahead->ilast);
+    const int irecord = ahead->nclaimed;
+    if (!finished)
+      ahead->nclaimed++;
+    pthread_mutex_unlock(&ahead->mutex);
+    if (finished)
+      break;
+
+    /* when decoding in parallel start at the claimed record */
+    if (ahead->offset != NULL) {
+      fseek(shadow_io_ptr->mbfp, ahead->offset[irecord], SEEK_SET);
+      shadow_io_ptr->file_bytes = ahead->offset[irecord];
+    }
+
+    /* read the record into its slot without holding the lock,
+        quietly since debug output would interleave with the caller's */
+    struct mb_read_ahead_slot_struct *slot = &ahead->slots[irecord % ahead->nslot];
+    slot->error = MB_ERROR_NO_ERROR;
+    slot->status = mb_read_ping(0, reader->shadow_ptr, slot->store, &slot->kind, &slot->error);
+    slot->file_pos = shadow_io_ptr->file_pos;
+    slot->file_bytes = shadow_io_ptr->file_bytes;
+
+    /* reading sequentially stops at the end of file or any other fatal error */
+    const bool fatal = (slot->status == MB_FAILURE && slot->error > MB_ERROR_NO_ERROR);
+
+    /* pass the record to the caller */
+    pthread_mutex_lock(&ahead->mutex);
+    slot->ready = true;
+    if (fatal && ahead->ilast < 0)
+      ahead->ilast = irecord;
+    pthread_cond_signal(&ahead->data_ready);
+    pthread_cond_broadcast(&ahead->space_ready);
+    pthread_mutex_unlock(&ahead->mutex);
+  }
+
+  return (NULL);
+}
+/*--------------------------------------------------------------------*/
+/* find the offsets of all records from the current file position to the
+    end of the file without decoding them, failing unless the end of the
+    file is reached exactly */
+static int mb_read_ahead_frame(int verbose, void *shadow_ptr, int *nrecord, long **offset, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       shadow_ptr:  %p\n", (void *)shadow_ptr);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)shadow_ptr;
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  *nrecord = 0;
+  *offset = NULL;
+
+  const long file_pos = mb_io_ptr->file_pos;
+  const long file_bytes = mb_io_ptr->file_bytes;
+  const bool index_seek_pending = mb_io_ptr->index_seek_pending;
+  struct stat file_status;
+  const long start = ftell(mb_io_ptr->mbfp);
+  long pos = start;
+  if (stat(mb_io_ptr->file, &file_status) != 0 || pos < 0) {
+    status = MB_FAILURE;
+    *error = MB_ERROR_OPEN_FAIL;
+  }
+  mb_io_ptr->file_bytes = pos;
+
+  int nalloc = 0;
+  bool done = false;
+  while (status == MB_SUCCESS && !done) {
+    if (*nrecord >= nalloc) {
+      nalloc += 16384;
+      status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(long), (void **)offset, error);
+    }
+    if (status == MB_SUCCESS) {
+      (*offset)[*nrecord] = pos;
+      int kind;
+      long size;
+      if ((*mb_io_ptr->mb_io_frame)(verbose, shadow_ptr, &kind, &size, error) == MB_SUCCESS) {
+        (*nrecord)++;
+        pos += size;
+
+        /* skip ahead after the first record as mb_read_ping() does */
+        if (*nrecord == 1 && mb_io_ptr->index_seek_pending) {
+          mb_io_ptr->index_seek_pending = false;
+          if (fseek(mb_io_ptr->mbfp, mb_io_ptr->index_seek_offset, SEEK_SET) == 0) {
+            pos = mb_io_ptr->index_seek_offset;
+            mb_io_ptr->file_bytes = pos;
+          }
+          else {
+            status = MB_FAILURE;
+            *error = MB_ERROR_UNINTELLIGIBLE;
+          }
+        }
+      }
+      else if (*error == MB_ERROR_EOF && pos == (long)file_status.st_size) {
+        done = true;
+        *error = MB_ERROR_NO_ERROR;
+      }
+      else {
+        status = MB_FAILURE;
+      }
+    }
+  }
+
+  /* on failure leave the descriptor as it was for sequential reading */
+  if (status == MB_FAILURE) {
+    if (start >= 0)
+      fseek(mb_io_ptr->mbfp, start, SEEK_SET);
+    mb_io_ptr->file_pos = file_pos;
+    mb_io_ptr->file_bytes = file_bytes;
+    mb_io_ptr->index_seek_pending = index_seek_pending;
+    int lerror = MB_ERROR_NO_ERROR;
+    if (*offset != NULL)
+      mb_freed(verbose, __FILE__, __LINE__, (void **)offset, &lerror);
+    *nrecord = 0;
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       nrecord:     %d\n", *nrecord);
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_read_ahead_init(int verbose, void *mbio_ptr, int nahead, int nthread, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+    fprintf(stderr, "dbg2       nahead:      %d\n", nahead);
+    fprintf(stderr, "dbg2       nthread:     %d\n", nthread);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+
+  /* an explicit request supersedes any pending request from the defaults */
+  mb_io_ptr->read_ahead_pending = 0;
+
+  /* only start reading ahead where the result is the same as reading
+      synchronously - a file of a self contained format that has not
+      yet been read from */
+  const bool usable = nahead > 0 && mb_io_ptr->read_ahead == NULL && mb_io_ptr->filemode == MB_FILEMODE_READ &&
+                      mb_io_ptr->read_ahead_safe && mb_io_ptr->mb_io_copyrecord != NULL && mb_io_ptr->mbsp == NULL &&
+                      mb_io_ptr->mbfp != stdin && mb_io_ptr->file_bytes == 0 &&
+                      mb_io_ptr->ping_count + mb_io_ptr->nav_count + mb_io_ptr->comment_count == 0;
+
+  /* records may only be decoded in parallel if they can be framed
+      without decoding and read starting at any record */
+  if (nthread < 1 || !mb_io_ptr->index_seekable || mb_io_ptr->mb_io_frame == NULL)
+    nthread = 1;
+
+  struct mb_read_ahead_struct *ahead = NULL;
+  if (usable) {
+    status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mb_read_ahead_struct), (void **)&ahead, error);
+    if (status == MB_SUCCESS) {
+      memset(ahead, 0, sizeof(struct mb_read_ahead_struct));
+      ahead->nslot = nahead;
+      ahead->ilast = -1;
+      status = mb_mallocd(verbose, __FILE__, __LINE__, nahead * sizeof(struct mb_read_ahead_slot_struct),
+                          (void **)&ahead->slots, error);
+      if (status == MB_SUCCESS)
+        memset(ahead->slots, 0, nahead * sizeof(struct mb_read_ahead_slot_struct));
+    }
+    if (status == MB_SUCCESS) {
+      status = mb_mallocd(verbose, __FILE__, __LINE__, nthread * sizeof(struct mb_read_ahead_thread_struct),
+                          (void **)&ahead->threads, error);
+      if (status == MB_SUCCESS)
+        memset(ahead->threads, 0, nthread * sizeof(struct mb_read_ahead_thread_struct));
+    }
+
+    /* open the file again for each background thread, framing the records
+        with the first descriptor before opening the others */
+    for (int i = 0; i < nthread && status == MB_SUCCESS; i++) {
+      double btime_d;
+      double etime_d;
+      int beams_bath;
+      int beams_amp;
+      int pixels_ss;
+      status = mb_read_init(verbose, mb_io_ptr->file, mb_io_ptr->format, mb_io_ptr->pings, mb_io_ptr->lonflip,
+                            mb_io_ptr->bounds, mb_io_ptr->btime_i, mb_io_ptr->etime_i, mb_io_ptr->speedmin,
+                            mb_io_ptr->timegap, &ahead->threads[i].shadow_ptr, &btime_d, &etime_d, &beams_bath,
+                            &beams_amp, &pixels_ss, error);
+      if (status == MB_SUCCESS) {
+        struct mb_io_struct *shadow_io_ptr = (struct mb_io_struct *)ahead->threads[i].shadow_ptr;
+        shadow_io_ptr->read_ahead_pending = 0;
+        ahead->threads[i].ahead = ahead;
+        ahead->nthread++;
+      }
+      if (status == MB_SUCCESS && i == 0 && nthread > 1) {
+        int lerror = MB_ERROR_NO_ERROR;
+        if (mb_read_ahead_frame(verbose, ahead->threads[0].shadow_ptr, &ahead->nrecord, &ahead->offset, &lerror) ==
+            MB_SUCCESS) {
+          ahead->ilast = ahead->nrecord;
+        }
+        else {
+          nthread = 1;
+        }
+      }
+
+      /* the threads reading in parallel seek to each record themselves */
+      if (status == MB_SUCCESS && ahead->offset != NULL)
+        ((struct mb_io_struct *)ahead->threads[i].shadow_ptr)->index_seek_pending = false;
+    }
+
+    /* allocate the stores */
+    for (int i = 0; i < nahead && status == MB_SUCCESS; i++)
+      status = mb_alloc(verbose, ahead->threads[0].shadow_ptr, &ahead->slots[i].store, error);
+
+    /* start the threads */
+    if (status == MB_SUCCESS) {
+      pthread_mutex_init(&ahead->mutex, NULL);
+      pthread_cond_init(&ahead->data_ready, NULL);
+      pthread_cond_init(&ahead->space_ready, NULL);
+      for (int i = 0; i < ahead->nthread && status == MB_SUCCESS; i++) {
+        if (pthread_create(&ahead->threads[i].thread, NULL, mb_read_ahead_thread, (void *)&ahead->threads[i]) == 0) {
+          ahead->threads[i].started = true;
+        }
+        else {
+          status = MB_FAILURE;
+          *error = MB_ERROR_MEMORY_FAIL;
+        }
+      }
+
+      /* without any thread running there is nothing to read ahead */
+      if (status == MB_FAILURE && !ahead->threads[0].started) {
+        pthread_mutex_destroy(&ahead->mutex);
+        pthread_cond_destroy(&ahead->data_ready);
+        pthread_cond_destroy(&ahead->space_ready);
+      }
+      else if (status == MB_FAILURE) {
+        status = MB_SUCCESS;
+        *error = MB_ERROR_NO_ERROR;
+      }
+    }
+
+    /* on success the original descriptor no longer reads the file itself,
+        otherwise release everything and keep reading synchronously */
+    if (status == MB_SUCCESS) {
+      mb_io_ptr->read_ahead = (void *)ahead;
+      mb_io_ptr->read_ahead_threads = ahead->offset != NULL ? ahead->nthread : 1;
+      mb_io_ptr->index_seek_pending = false;
+    }
+    else if (ahead != NULL) {
+      int lerror = MB_ERROR_NO_ERROR;
+      if (ahead->slots != NULL) {
+        for (int i = 0; i < nahead; i++)
+          if (ahead->slots[i].store != NULL)
+            mb_deall(verbose, ahead->threads[0].shadow_ptr, &ahead->slots[i].store, &lerror);
+        mb_freed(verbose, __FILE__, __LINE__, (void **)&ahead->slots, &lerror);
+      }
+      if (ahead->threads != NULL) {
+        for (int i = 0; i < ahead->nthread; i++)
+          mb_close(verbose, &ahead->threads[i].shadow_ptr, &lerror);
+        mb_freed(verbose, __FILE__, __LINE__, (void **)&ahead->threads, &lerror);
+      }
+      if (ahead->offset != NULL)
+        mb_freed(verbose, __FILE__, __LINE__, (void **)&ahead->offset, &lerror);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&ahead, &lerror);
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       read_ahead:  %p\n", mb_io_ptr->read_ahead);
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_read_ahead_next(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+    fprintf(stderr, "dbg2       store_ptr:   %p\n", (void *)store_ptr);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  struct mb_read_ahead_struct *ahead = (struct mb_read_ahead_struct *)mb_io_ptr->read_ahead;
+
+  /* wait for the next record */
+  pthread_mutex_lock(&ahead->mutex);
+  struct mb_read_ahead_slot_struct *slot = &ahead->slots[ahead->nreleased % ahead->nslot];
+  while (!slot->ready)
+    pthread_cond_wait(&ahead->data_ready, &ahead->mutex);
+  pthread_mutex_unlock(&ahead->mutex);
+
+  /* return the record as though it had just been read */
+  int status = slot->status;
+  *error = slot->error;
+  if (*error <= MB_ERROR_NO_ERROR && slot->kind != MB_DATA_NONE) {
+    int lerror = MB_ERROR_NO_ERROR;
+    if (mb_copyrecord(verbose, mbio_ptr, slot->store, store_ptr, &lerror) == MB_FAILURE) {
+      status = MB_FAILURE;
+      *error = lerror;
+    }
+  }
+  mb_io_ptr->new_kind = slot->kind;
+  mb_io_ptr->new_error = *error;
+  mb_io_ptr->file_pos = slot->file_pos;
+  mb_io_ptr->file_bytes = slot->file_bytes;
+
+  /* release the slot unless it holds the final record, which is then
+      returned again by any further calls as with synchronous reading */
+  pthread_mutex_lock(&ahead->mutex);
+  if (ahead->nreleased != ahead->ilast) {
+    slot->ready = false;
+    ahead->nreleased++;
+    pthread_cond_broadcast(&ahead->space_ready);
+  }
+  pthread_mutex_unlock(&ahead->mutex);
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       kind:        %d\n", mb_io_ptr->new_kind);
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mb_read_ahead_close(int verbose, void *mbio_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  struct mb_read_ahead_struct *ahead = (struct mb_read_ahead_struct *)mb_io_ptr->read_ahead;
+  int status = MB_SUCCESS;
+
+  if (ahead != NULL) {
+    /* stop and join the background threads */
+    pthread_mutex_lock(&ahead->mutex);
+    ahead->abort = true;
+    pthread_cond_broadcast(&ahead->space_ready);
+    pthread_mutex_unlock(&ahead->mutex);
+    for (int i = 0; i < ahead->nthread; i++)
+      if (ahead->threads[i].started)
+        pthread_join(ahead->threads[i].thread, NULL);
+    pthread_mutex_destroy(&ahead->mutex);
+    pthread_cond_destroy(&ahead->data_ready);
+    pthread_cond_destroy(&ahead->space_ready);
+
+    /* release the stores and close the other descriptors */
+    for (int i = 0; i < ahead->nslot; i++)
+      status &= mb_deall(verbose, ahead->threads[0].shadow_ptr, &ahead->slots[i].store, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&ahead->slots, error);
+    for (int i = 0; i < ahead->nthread; i++)
+      status &= mb_close(verbose, &ahead->threads[i].shadow_ptr, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&ahead->threads, error);
+    if (ahead->offset != NULL)
+      status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&ahead->offset, error);
+    status &= mb_freed(verbose, __FILE__, __LINE__, (void **)&mb_io_ptr->read_ahead, error);
+  }
+  mb_io_ptr->read_ahead_pending = 0;
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
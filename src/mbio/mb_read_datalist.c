@@ -0,0 +1,702 @@
+/*--------------------------------------------------------------------
+ *    The MB-system:  mb_read_datalist.c  10/15/2026
+ *
+ *    Copyright (c) 2026 by
+ *    David W. Caress (caress@mbari.org)
+ *      Monterey Bay Aquarium Research Institute
+ *      Moss Landing, California, USA
+ *    Dale N. Chayes
+ *      Center for Coastal and Ocean Mapping
+ *      University of New Hampshire
+ *      Durham, New Hampshire, USA
+ *    Christian dos Santos Ferreira
+ *      MARUM
+ *      University of Bremen
+ *      Bremen Germany
+ *
+ *    MB-System was created by Caress and Chayes in 1992 at the
+ *      Lamont-Doherty Earth Observatory
+ *      Columbia University
+ *      Palisades, NY 10964
+ *
+ *    See README.md file for copying and redistribution conditions.
+ *--------------------------------------------------------------------*/
+/*
+ * mb_read_datalist.c contains functions that read all of the swath files
+ * referenced by a datalist using a pool of worker threads. Each worker
+ * opens one swath file at a time with mb_read_init_altnav() and reads it
+ * with mb_read() through its own mb_io_struct, copying each record into
+ * a mb_datalist_ping_struct that is placed on a bounded queue belonging
+ * to that file. The calling program obtains the records one at a time
+ * with mb_read_datalist(), either in datalist order (all records of
+ * the first file, then all records of the second file, etc) or in the
+ * order the records become available from any file.
+ *
+ * The files to be read are obtained from the datalist with
+ * mb_datalist_read3() when the reader is initialized, so processed
+ * files and alternative navigation are used just as they would be by
+ * a program looping over the datalist itself. Files whose *.inf
+ * files show them to be outside the bounds are skipped, and if requested
+ * the *.fbt files are used in place of the full swath files.
+ *
+ * These functions include:
+ *   mb_read_datalist_init  - open the files from a datalist and start the worker threads
+ *   mb_read_datalist       - return the next record
+ *   mb_read_datalist_close - stop the worker threads and release all memory
+ *
+ * Author:  D. W. Caress
+ * Date:  15 October 2026
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+/* parallel datalist reader file structure */
+struct mb_read_datalist_file_struct {
+  mb_path path;
+  int format;
+  double weight;
+  int astatus;
+  mb_path apath;
+
+  /* queue of records read from this file */
+  struct mb_datalist_ping_struct *head;
+  struct mb_datalist_ping_struct *tail;
+  int count;
+  bool done;
+  bool reported;
+  int status;
+  int error;
+};
+
+/* parallel datalist reader control structure */
+struct mb_read_datalist_struct {
+  int verbose;
+
+  /* read parameters passed on to mb_read_init_altnav() */
+  int pings;
+  int lonflip;
+  double bounds[4];
+  int btime_i[7];
+  int etime_i[7];
+  double speedmin;
+  double timegap;
+  bool use_fbt;
+
+  /* files */
+  int nfile;
+  int nfile_alloc;
+  struct mb_read_datalist_file_struct *files;
+  int ifile_next;
+  int ifile_first;
+
+  /* queue control */
+  int queue_size;
+  bool ordered;
+  bool abort;
+  struct mb_datalist_ping_struct *free_list;
+  struct mb_datalist_ping_struct *current;
+  struct mb_datalist_ping_struct endping;
+
+  /* threads */
+  int nthreads;
+  pthread_t *threads;
+  pthread_mutex_t mutex;
+  pthread_cond_t data_ready;
+  pthread_cond_t space_ready;
+};
+
+/*--------------------------------------------------------------------*/
+/* get a record structure from the free list or allocate a new one, called with the mutex locked */
+static struct mb_datalist_ping_struct *mb_read_datalist_ping_get(struct mb_read_datalist_struct *reader) {
+  struct mb_datalist_ping_struct *ping = reader->free_list;
+  if (ping != NULL) {
+    reader->free_list = ping->next;
+  }
+  else {
+    int error = MB_ERROR_NO_ERROR;
+    if (mb_mallocd(reader->verbose, __FILE__, __LINE__, sizeof(struct mb_datalist_ping_struct), (void **)&ping,
+                   &error) == MB_SUCCESS)
+      memset(ping, 0, sizeof(struct mb_datalist_ping_struct));
+  }
+  if (ping != NULL)
+    ping->next = NULL;
+  return (ping);
+}
+
+/*--------------------------------------------------------------------*/
+/* free a record structure and its arrays */
+static void mb_read_datalist_ping_free(int verbose, struct mb_datalist_ping_struct *ping) {
+  int error = MB_ERROR_NO_ERROR;
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&ping->beamflag, &error);
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&ping->bath, &error);
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&ping->amp, &error);
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&ping->bathlon, &error);
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&ping->bathlat, &error);
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&ping->ss, &error);
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&ping->sslon, &error);
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&ping->sslat, &error);
+  mb_freed(verbose, __FILE__, __LINE__, (void **)&ping, &error);
+}
+
+/*--------------------------------------------------------------------*/
+/* make sure a record structure can hold the beams and pixels of the
+    record just read, called without the mutex locked */
+static int mb_read_datalist_ping_alloc(int verbose, struct mb_datalist_ping_struct *ping, int nbath, int namp,
+                                       int nss, int *error) {
+  int status = MB_SUCCESS;
+  if (nbath > ping->nbath_alloc) {
+    if (status == MB_SUCCESS)
+      status = mb_reallocd(verbose, __FILE__, __LINE__, nbath * sizeof(char), (void **)&ping->beamflag, error);
+    if (status == MB_SUCCESS)
+      status = mb_reallocd(verbose, __FILE__, __LINE__, nbath * sizeof(double), (void **)&ping->bath, error);
+    if (status == MB_SUCCESS)
+      status = mb_reallocd(verbose, __FILE__, __LINE__, nbath * sizeof(double), (void **)&ping->bathlon, error);
+    if (status == MB_SUCCESS)
+      status = mb_reallocd(verbose, __FILE__, __LINE__, nbath * sizeof(double), (void **)&ping->bathlat, error);
+    if (status == MB_SUCCESS)
+      ping->nbath_alloc = nbath;
+  }
+  if (status == MB_SUCCESS && namp > ping->namp_alloc) {
+    status = mb_reallocd(verbose, __FILE__, __LINE__, namp * sizeof(double), (void **)&ping->amp, error);
+    if (status == MB_SUCCESS)
+      ping->namp_alloc = namp;
+  }
+  if (status == MB_SUCCESS && nss > ping->nss_alloc) {
+    if (status == MB_SUCCESS)
+      status = mb_reallocd(verbose, __FILE__, __LINE__, nss * sizeof(double), (void **)&ping->ss, error);
+    if (status == MB_SUCCESS)
+      status = mb_reallocd(verbose, __FILE__, __LINE__, nss * sizeof(double), (void **)&ping->sslon, error);
+    if (status == MB_SUCCESS)
+      status = mb_reallocd(verbose, __FILE__, __LINE__, nss * sizeof(double), (void **)&ping->sslat, error);
+    if (status == MB_SUCCESS)
+      ping->nss_alloc = nss;
+  }
+  return (status);
+}
+
+/*--------------------------------------------------------------------*/
+/* read one swath file, placing each record on the queue of that file */
+static void mb_read_datalist_file(struct mb_read_datalist_struct *reader, int ifile) {
+  struct mb_read_datalist_file_struct *file = &reader->files[ifile];
+  const int verbose = reader->verbose;
+  int status = MB_SUCCESS;
+  int error = MB_ERROR_NO_ERROR;
+
+  /* check the *.inf file for the file bounds if possible */
+  bool file_in_bounds = true;
+  mb_path rfile;
+  strcpy(rfile, file->path);
+  int rformat = file->format;
+  if (mb_check_info(verbose, rfile, reader->lonflip, reader->bounds, &file_in_bounds, &error) == MB_FAILURE) {
+    file_in_bounds = true;
+    error = MB_ERROR_NO_ERROR;
+  }
+
+  /* open the swath file */
+  void *mbio_ptr = NULL;
+  if (file_in_bounds) {
+    if (reader->use_fbt)
+      mb_get_fbt(verbose, rfile, &rformat, &error);
+    double btime_d;
+    double etime_d;
+    int beams_bath;
+    int beams_amp;
+    int pixels_ss;
+    status = mb_read_init_altnav(verbose, rfile, rformat, reader->pings, reader->lonflip, reader->bounds,
+                                 reader->btime_i, reader->etime_i, reader->speedmin, reader->timegap,
+                                 file->astatus, file->apath, &mbio_ptr, &btime_d, &etime_d,
+                                 &beams_bath, &beams_amp, &pixels_ss, &error);
+  }
+
+  /* allocate the arrays used by mb_read() */
+  char *beamflag = NULL;
+  double *bath = NULL;
+  double *amp = NULL;
+  double *bathlon = NULL;
+  double *bathlat = NULL;
+  double *ss = NULL;
+  double *sslon = NULL;
+  double *sslat = NULL;
+  int sonartype = MB_TOPOGRAPHY_TYPE_UNKNOWN;
+  if (status == MB_SUCCESS && mbio_ptr != NULL) {
+    struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+    int sonartype_error = MB_ERROR_NO_ERROR;
+    mb_sonartype(verbose, mbio_ptr, mb_io_ptr->store_data, &sonartype, &sonartype_error);
+    status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag, &error);
+    if (error == MB_ERROR_NO_ERROR)
+      status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bath, &error);
+    if (error == MB_ERROR_NO_ERROR)
+      status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_AMPLITUDE, sizeof(double), (void **)&amp, &error);
+    if (error == MB_ERROR_NO_ERROR)
+      status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathlon, &error);
+    if (error == MB_ERROR_NO_ERROR)
+      status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathlat, &error);
+    if (error == MB_ERROR_NO_ERROR)
+      status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ss, &error);
+    if (error == MB_ERROR_NO_ERROR)
+      status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&sslon, &error);
+    if (error == MB_ERROR_NO_ERROR)
+      status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&sslat, &error);
+  }
+
+  /* read the file */
+  bool abort = false;
+  if (status == MB_SUCCESS && mbio_ptr != NULL) {
+    struct mb_datalist_ping_struct *ping = NULL;
+    while (error <= MB_ERROR_NO_ERROR && !abort) {
+      /* get a record structure */
+      if (ping == NULL) {
+        pthread_mutex_lock(&reader->mutex);
+        ping = mb_read_datalist_ping_get(reader);
+        pthread_mutex_unlock(&reader->mutex);
+        if (ping == NULL) {
+          status = MB_FAILURE;
+          error = MB_ERROR_MEMORY_FAIL;
+          break;
+        }
+      }
+
+      /* read the next record */
+      int pings;
+      int nbath;
+      int namp;
+      int nss;
+      status = mb_read(verbose, mbio_ptr, &ping->kind, &pings, ping->time_i, &ping->time_d, &ping->navlon,
+                       &ping->navlat, &ping->speed, &ping->heading, &ping->distance, &ping->altitude,
+                       &ping->sensordepth, &nbath, &namp, &nss, beamflag, bath, amp, bathlon, bathlat,
+                       ss, sslon, sslat, ping->comment, &error);
+      if (error > MB_ERROR_NO_ERROR)
+        break;
+
+      /* copy the beams and pixels */
+      int alloc_error = MB_ERROR_NO_ERROR;
+      if (mb_read_datalist_ping_alloc(verbose, ping, nbath, namp, nss, &alloc_error) != MB_SUCCESS) {
+        status = MB_FAILURE;
+        error = alloc_error;
+        break;
+      }
+      ping->ifile = ifile;
+      ping->path = file->path;
+      ping->format = file->format;
+      ping->weight = file->weight;
+      ping->sonartype = sonartype;
+      ping->error = error;
+      ping->nbath = nbath;
+      ping->namp = namp;
+      ping->nss = nss;
+      if (nbath > 0) {
+        memcpy(ping->beamflag, beamflag, nbath * sizeof(char));
+        memcpy(ping->bath, bath, nbath * sizeof(double));
+        memcpy(ping->bathlon, bathlon, nbath * sizeof(double));
+        memcpy(ping->bathlat, bathlat, nbath * sizeof(double));
+      }
+      if (namp > 0)
+        memcpy(ping->amp, amp, namp * sizeof(double));
+      if (nss > 0) {
+        memcpy(ping->ss, ss, nss * sizeof(double));
+        memcpy(ping->sslon, sslon, nss * sizeof(double));
+        memcpy(ping->sslat, sslat, nss * sizeof(double));
+      }
+
+      /* place the record on the queue, waiting if the queue is full */
+      pthread_mutex_lock(&reader->mutex);
+      while (file->count >= reader->queue_size && !reader->abort)
+        pthread_cond_wait(&reader->space_ready, &reader->mutex);
+      abort = reader->abort;
+      if (!abort) {
+        if (file->tail != NULL)
+          file->tail->next = ping;
+        else
+          file->head = ping;
+        file->tail = ping;
+        file->count++;
+        ping = NULL;
+        pthread_cond_signal(&reader->data_ready);
+      }
+      pthread_mutex_unlock(&reader->mutex);
+    }
+
+    /* return any unused record structure */
+    if (ping != NULL) {
+      pthread_mutex_lock(&reader->mutex);
+      ping->next = reader->free_list;
+      reader->free_list = ping;
+      pthread_mutex_unlock(&reader->mutex);
+    }
+  }
+
+  /* close the file */
+  if (mbio_ptr != NULL) {
+    int close_error = MB_ERROR_NO_ERROR;
+    mb_close(verbose, &mbio_ptr, &close_error);
+  }
+
+  /* reaching the end of the file is success */
+  if (error == MB_ERROR_EOF || abort) {
+    status = MB_SUCCESS;
+    error = MB_ERROR_NO_ERROR;
+  }
+  if (verbose > 0 && error != MB_ERROR_NO_ERROR) {
+    char *message = NULL;
+    mb_error(verbose, error, &message);
+    fprintf(stderr, "\nMBIO Error reading swath file <%s>:\n%s\n", rfile, message);
+  }
+
+  /* mark the file as completely read */
+  pthread_mutex_lock(&reader->mutex);
+  file->status = status;
+  file->error = error;
+  file->done = true;
+  pthread_cond_broadcast(&reader->data_ready);
+  pthread_mutex_unlock(&reader->mutex);
+}
+
+/*--------------------------------------------------------------------*/
+/* worker thread - read files in datalist order until none remain */
+static void *mb_read_datalist_worker(void *reader_ptr) {
+  struct mb_read_datalist_struct *reader = (struct mb_read_datalist_struct *)reader_ptr;
+
+  while (true) {
+    pthread_mutex_lock(&reader->mutex);
+    const int ifile = reader->ifile_next;
+    const bool done = (reader->abort || ifile >= reader->nfile);
+    if (!done)
+      reader->ifile_next++;
+    pthread_mutex_unlock(&reader->mutex);
+    if (done)
+      break;
+
+    mb_read_datalist_file(reader, ifile);
+  }
+
+  return (NULL);
+}
+
+/*--------------------------------------------------------------------*/
+int mb_read_datalist_init(int verbose, void *datalist_ptr, int pings, int lonflip, double bounds[4], int btime_i[7],
+                          int etime_i[7], double speedmin, double timegap, bool use_fbt, int nthreads, int queue_size,
+                          bool ordered, void **reader_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+    fprintf(stderr, "dbg2       datalist_ptr: %p\n", (void *)datalist_ptr);
+    fprintf(stderr, "dbg2       pings:        %d\n", pings);
+    fprintf(stderr, "dbg2       lonflip:      %d\n", lonflip);
+    fprintf(stderr, "dbg2       bounds[0]:    %f\n", bounds[0]);
+    fprintf(stderr, "dbg2       bounds[1]:    %f\n", bounds[1]);
+    fprintf(stderr, "dbg2       bounds[2]:    %f\n", bounds[2]);
+    fprintf(stderr, "dbg2       bounds[3]:    %f\n", bounds[3]);
+    for (int i = 0; i < 7; i++)
+      fprintf(stderr, "dbg2       btime_i[%d]:   %d\n", i, btime_i[i]);
+    for (int i = 0; i < 7; i++)
+      fprintf(stderr, "dbg2       etime_i[%d]:   %d\n", i, etime_i[i]);
+    fprintf(stderr, "dbg2       speedmin:     %f\n", speedmin);
+    fprintf(stderr, "dbg2       timegap:      %f\n", timegap);
+    fprintf(stderr, "dbg2       use_fbt:      %d\n", use_fbt);
+    fprintf(stderr, "dbg2       nthreads:     %d\n", nthreads);
+    fprintf(stderr, "dbg2       queue_size:   %d\n", queue_size);
+    fprintf(stderr, "dbg2       ordered:      %d\n", ordered);
+  }
+
+  int status = MB_SUCCESS;
+  *reader_ptr = NULL;
+
+  /* allocate the reader structure */
+  struct mb_read_datalist_struct *reader = NULL;
+  status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mb_read_datalist_struct), (void **)&reader, error);
+  if (status == MB_SUCCESS) {
+    memset(reader, 0, sizeof(struct mb_read_datalist_struct));
+    reader->verbose = verbose;
+    reader->pings = pings;
+    reader->lonflip = lonflip;
+    for (int i = 0; i < 4; i++)
+      reader->bounds[i] = bounds[i];
+    for (int i = 0; i < 7; i++) {
+      reader->btime_i[i] = btime_i[i];
+      reader->etime_i[i] = etime_i[i];
+    }
+    reader->speedmin = speedmin;
+    reader->timegap = timegap;
+    reader->use_fbt = use_fbt;
+    reader->queue_size = queue_size > 0 ? queue_size : MB_READ_DATALIST_QUEUE_DEFAULT;
+    reader->ordered = ordered;
+  }
+
+  /* get the list of swath files from the datalist */
+  if (status == MB_SUCCESS) {
+    int pstatus;
+    mb_path path;
+    mb_path ppath;
+    int astatus;
+    mb_path apath;
+    mb_path dpath;
+    int format;
+    double weight;
+    while (status == MB_SUCCESS
+           && mb_datalist_read3(verbose, datalist_ptr, &pstatus, path, ppath, &astatus, apath, dpath, &format,
+                                &weight, error) == MB_SUCCESS) {
+      if (format > 0 && path[0] != '#') {
+        if (reader->nfile >= reader->nfile_alloc) {
+          reader->nfile_alloc += 256;
+          status = mb_reallocd(verbose, __FILE__, __LINE__,
+                               reader->nfile_alloc * sizeof(struct mb_read_datalist_file_struct),
+                               (void **)&reader->files, error);
+          if (status != MB_SUCCESS)
+            break;
+        }
+        struct mb_read_datalist_file_struct *file = &reader->files[reader->nfile];
+        memset(file, 0, sizeof(struct mb_read_datalist_file_struct));
+        strcpy(file->path, pstatus == MB_PROCESSED_USE ? ppath : path);
+        file->format = format;
+        file->weight = weight;
+        file->astatus = astatus;
+        strcpy(file->apath, apath);
+        reader->nfile++;
+      }
+    }
+    if (status == MB_SUCCESS)
+      *error = MB_ERROR_NO_ERROR;
+  }
+
+  /* start the worker threads */
+  if (status == MB_SUCCESS) {
+    if (nthreads <= 0) {
+      const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+      nthreads = ncpu > 0 ? (int)ncpu : 1;
+    }
+    reader->nthreads = MAX(MIN(nthreads, reader->nfile), 1);
+
+    pthread_mutex_init(&reader->mutex, NULL);
+    pthread_cond_init(&reader->data_ready, NULL);
+    pthread_cond_init(&reader->space_ready, NULL);
+    status = mb_mallocd(verbose, __FILE__, __LINE__, reader->nthreads * sizeof(pthread_t), (void **)&reader->threads,
+                        error);
+    if (status == MB_SUCCESS) {
+      int nstarted = 0;
+      for (int i = 0; i < reader->nthreads; i++) {
+        if (pthread_create(&reader->threads[i], NULL, mb_read_datalist_worker, (void *)reader) != 0)
+          break;
+        nstarted++;
+      }
+      if (nstarted == 0 && reader->nfile > 0) {
+        status = MB_FAILURE;
+        *error = MB_ERROR_MEMORY_FAIL;
+      }
+      reader->nthreads = nstarted;
+    }
+    if (status == MB_SUCCESS) {
+      *reader_ptr = (void *)reader;
+    }
+    else {
+      pthread_mutex_destroy(&reader->mutex);
+      pthread_cond_destroy(&reader->data_ready);
+      pthread_cond_destroy(&reader->space_ready);
+    }
+  }
+
+  /* clean up after failure */
+  if (status != MB_SUCCESS && reader != NULL) {
+    int free_error = MB_ERROR_NO_ERROR;
+    if (reader->threads != NULL)
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&reader->threads, &free_error);
+    if (reader->files != NULL)
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&reader->files, &free_error);
+    mb_freed(verbose, __FILE__, __LINE__, (void **)&reader, &free_error);
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       reader_ptr:  %p\n", *reader_ptr);
+    if (reader != NULL && status == MB_SUCCESS) {
+      fprintf(stderr, "dbg2       nfile:       %d\n", reader->nfile);
+      fprintf(stderr, "dbg2       nthreads:    %d\n", reader->nthreads);
+    }
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+
+/*--------------------------------------------------------------------*/
+int mb_read_datalist(int verbose, void *reader_ptr, void **ping_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       reader_ptr:  %p\n", (void *)reader_ptr);
+  }
+
+  struct mb_read_datalist_struct *reader = (struct mb_read_datalist_struct *)reader_ptr;
+  struct mb_datalist_ping_struct **ping = (struct mb_datalist_ping_struct **)ping_ptr;
+  int status = MB_SUCCESS;
+  *ping = NULL;
+
+  pthread_mutex_lock(&reader->mutex);
+
+  /* the record returned by the previous call is no longer in use */
+  if (reader->current != NULL && reader->current != &reader->endping) {
+    reader->current->next = reader->free_list;
+    reader->free_list = reader->current;
+    reader->current = NULL;
+  }
+
+  while (*ping == NULL) {
+    /* skip past files that have been completely read and returned */
+    while (reader->ifile_first < reader->nfile && reader->files[reader->ifile_first].done
+           && reader->files[reader->ifile_first].count == 0 && reader->files[reader->ifile_first].reported)
+      reader->ifile_first++;
+    if (reader->ifile_first >= reader->nfile) {
+      status = MB_FAILURE;
+      *error = MB_ERROR_EOF;
+      break;
+    }
+
+    /* look for the next record - in datalist order only the first
+        unfinished file is eligible, otherwise any file started by a worker */
+    const int ifile_last = reader->ordered ? reader->ifile_first : reader->ifile_next - 1;
+    struct mb_read_datalist_file_struct *file = NULL;
+    for (int ifile = reader->ifile_first; ifile <= ifile_last && file == NULL; ifile++) {
+      struct mb_read_datalist_file_struct *check = &reader->files[ifile];
+      if (check->count > 0 || (check->done && !check->reported))
+        file = check;
+    }
+
+    /* wait for a worker to provide a record */
+    if (file == NULL) {
+      pthread_cond_wait(&reader->data_ready, &reader->mutex);
+    }
+
+    /* take the next record from the file queue */
+    else if (file->count > 0) {
+      *ping = file->head;
+      file->head = (*ping)->next;
+      if (file->head == NULL)
+        file->tail = NULL;
+      file->count--;
+      (*ping)->next = NULL;
+      reader->current = *ping;
+      *error = (*ping)->error;
+      status = (*ping)->error == MB_ERROR_NO_ERROR ? MB_SUCCESS : MB_FAILURE;
+      pthread_cond_broadcast(&reader->space_ready);
+    }
+
+    /* the file is finished - report a fatal error reading it if there was one */
+    else {
+      file->reported = true;
+      if (file->error != MB_ERROR_NO_ERROR) {
+        struct mb_datalist_ping_struct *endping = &reader->endping;
+        endping->ifile = (int)(file - reader->files);
+        endping->path = file->path;
+        endping->format = file->format;
+        endping->weight = file->weight;
+        endping->kind = MB_DATA_NONE;
+        endping->error = file->error;
+        endping->nbath = 0;
+        endping->namp = 0;
+        endping->nss = 0;
+        *ping = endping;
+        reader->current = endping;
+        status = MB_FAILURE;
+        *error = file->error;
+      }
+    }
+  }
+
+  pthread_mutex_unlock(&reader->mutex);
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       ping:        %p\n", (void *)*ping);
+    if (*ping != NULL) {
+      fprintf(stderr, "dbg2       ifile:       %d\n", (*ping)->ifile);
+      fprintf(stderr, "dbg2       path:        %s\n", (*ping)->path);
+      fprintf(stderr, "dbg2       kind:        %d\n", (*ping)->kind);
+      fprintf(stderr, "dbg2       time_d:      %f\n", (*ping)->time_d);
+      fprintf(stderr, "dbg2       nbath:       %d\n", (*ping)->nbath);
+      fprintf(stderr, "dbg2       namp:        %d\n", (*ping)->namp);
+      fprintf(stderr, "dbg2       nss:         %d\n", (*ping)->nss);
+    }
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+
+/*--------------------------------------------------------------------*/
+int mb_read_datalist_close(int verbose, void **reader_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+    fprintf(stderr, "dbg2       reader_ptr:  %p\n", (void *)*reader_ptr);
+  }
+
+  struct mb_read_datalist_struct *reader = (struct mb_read_datalist_struct *)*reader_ptr;
+  int status = MB_SUCCESS;
+
+  if (reader != NULL) {
+    /* stop and join the worker threads */
+    pthread_mutex_lock(&reader->mutex);
+    reader->abort = true;
+    pthread_cond_broadcast(&reader->space_ready);
+    pthread_mutex_unlock(&reader->mutex);
+    for (int i = 0; i < reader->nthreads; i++)
+      pthread_join(reader->threads[i], NULL);
+    pthread_mutex_destroy(&reader->mutex);
+    pthread_cond_destroy(&reader->data_ready);
+    pthread_cond_destroy(&reader->space_ready);
+
+    /* release all of the record structures */
+    if (reader->current != NULL && reader->current != &reader->endping) {
+      reader->current->next = reader->free_list;
+      reader->free_list = reader->current;
+      reader->current = NULL;
+    }
+    for (int ifile = 0; ifile < reader->nfile; ifile++) {
+      struct mb_datalist_ping_struct *ping = reader->files[ifile].head;
+      while (ping != NULL) {
+        struct mb_datalist_ping_struct *next = ping->next;
+        mb_read_datalist_ping_free(verbose, ping);
+        ping = next;
+      }
+    }
+    while (reader->free_list != NULL) {
+      struct mb_datalist_ping_struct *next = reader->free_list->next;
+      mb_read_datalist_ping_free(verbose, reader->free_list);
+      reader->free_list = next;
+    }
+
+    if (reader->threads != NULL)
+      status = mb_freed(verbose, __FILE__, __LINE__, (void **)&reader->threads, error);
+    if (reader->files != NULL)
+      status = mb_freed(verbose, __FILE__, __LINE__, (void **)&reader->files, error);
+    status = mb_freed(verbose, __FILE__, __LINE__, (void **)reader_ptr, error);
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:       %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:      %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
@@ -222,6 +222,7 @@ int mb_read_init(int verbose, char *file, int format, int pings, int lonflip, do
 
 	/* initialize projection parameters */
 	mb_io_ptr->projection_initialized = false;
+	mb_io_ptr->projection_cached = false;
 	mb_io_ptr->projection_id[0] = '\0';
 	mb_io_ptr->pjptr = NULL;
 
@@ -601,10 +602,15 @@ int mb_read_init(int verbose, char *file, int format, int pings, int lonflip, do
 
 	/* initialize variables for interpolating asynchronous data */
 	mb_io_ptr->nfix = 0;
+	mb_io_ptr->fix_cursor = 0;
 	mb_io_ptr->nattitude = 0;
+	mb_io_ptr->attitude_cursor = 0;
 	mb_io_ptr->nheading = 0;
+	mb_io_ptr->heading_cursor = 0;
 	mb_io_ptr->nsensordepth = 0;
+	mb_io_ptr->sensordepth_cursor = 0;
 	mb_io_ptr->naltitude = 0;
+	mb_io_ptr->altitude_cursor = 0;
 	for (int i = 0; i < MB_ASYNCH_SAVE_MAX; i++) {
 		mb_io_ptr->fix_time_d[i] = 0.0;
 		mb_io_ptr->fix_lon[i] = 0.0;
@@ -636,9 +642,12 @@ int mb_read_init(int verbose, char *file, int format, int pings, int lonflip, do
 	  if (pfp != NULL) {
 		  char projection_id[MB_NAME_LENGTH] = {0};;
 		  if (fscanf(pfp, "%31s", projection_id) == 1) {
-			const int proj_status = mb_proj_init(verbose, projection_id, &(mb_io_ptr->pjptr), error);
+			/* the projection is shared with other files read by this thread
+				using the same projection, so it is not freed by mb_close() */
+			const int proj_status = mb_proj_init_cached(verbose, projection_id, &(mb_io_ptr->pjptr), error);
 			if (proj_status == MB_SUCCESS) {
 				mb_io_ptr->projection_initialized = true;
+				mb_io_ptr->projection_cached = true;
 				strcpy(mb_io_ptr->projection_id, projection_id);
 			}
 		  }
@@ -649,6 +658,21 @@ int mb_read_init(int verbose, char *file, int format, int pings, int lonflip, do
 	  }
 	}
 
+	/* check for a record index allowing reading to start within the file */
+	mb_index_seek_init(verbose, *mbio_ptr, error);
+
+	/* read ahead in a background thread from the first read if so
+	    requested by the mbdefaults readahead value (see mb_read_ahead.c) */
+	if (mb_io_ptr->read_ahead_safe) {
+		int readahead = 0;
+		int readthreads = 1;
+		mb_readahead(verbose, &readahead, &readthreads);
+		if (readahead > 0) {
+			mb_io_ptr->read_ahead_pending = readahead;
+			mb_io_ptr->read_ahead_threads = readthreads;
+		}
+	}
+
 	/* set error and status (if you got here you succeeded */
 	*error = MB_ERROR_NO_ERROR;
 	status = MB_SUCCESS;
@@ -1055,6 +1079,7 @@ int mb_input_init(int verbose, char *socket_definition, int format,
 
 	/* initialize projection parameters */
 	mb_io_ptr->projection_initialized = false;
+	mb_io_ptr->projection_cached = false;
 	mb_io_ptr->projection_id[0] = '\0';
 	mb_io_ptr->pjptr = NULL;
 
@@ -1264,10 +1289,15 @@ int mb_input_init(int verbose, char *socket_definition, int format,
 
 	/* initialize variables for interpolating asynchronous data */
 	mb_io_ptr->nfix = 0;
+	mb_io_ptr->fix_cursor = 0;
 	mb_io_ptr->nattitude = 0;
+	mb_io_ptr->attitude_cursor = 0;
 	mb_io_ptr->nheading = 0;
+	mb_io_ptr->heading_cursor = 0;
 	mb_io_ptr->nsensordepth = 0;
+	mb_io_ptr->sensordepth_cursor = 0;
 	mb_io_ptr->naltitude = 0;
+	mb_io_ptr->altitude_cursor = 0;
 	for (int i = 0; i < MB_ASYNCH_SAVE_MAX; i++) {
 		mb_io_ptr->fix_time_d[i] = 0.0;
 		mb_io_ptr->fix_lon[i] = 0.0;
@@ -1359,3 +1389,34 @@ int mb_set_debug_records(int verbose, void *mbio_ptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
+int mb_set_lazy_decode(int verbose, void *mbio_ptr, bool lazy_decode, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:    %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       lazy_decode: %d\n", lazy_decode);
+	}
+
+	/* allow i/o modules that support it to defer decoding bulky records
+	    (e.g. water column) until they are needed - this is only for
+	    programs that extract swath data and do not write the records out
+	    after the input file has been closed */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	mb_io_ptr->lazy_decode = lazy_decode;
+
+	/* set error and status (if you got here you succeeded */
+	*error = MB_ERROR_NO_ERROR;
+	int status = MB_SUCCESS;
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
@@ -56,8 +56,26 @@ int mb_read_ping(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *e
 
 	int status = MB_SUCCESS;
 
-	/* call the appropriate mbr_ read and translate routine */
-	if (mb_io_ptr->mb_io_read_ping != NULL) {
+	/* give up any ping cache if records are read other than through
+	    mb_get() or mb_read() (see mb_pingcache.c) */
+	if (mb_io_ptr->pingcache != NULL) {
+		int lerror = MB_ERROR_NO_ERROR;
+		mb_pingcache_detach(verbose, mbio_ptr, store_ptr, &lerror);
+	}
+
+	/* start reading ahead in a background thread if requested through
+	    the mbdefaults readahead value (see mb_read_ahead.c) */
+	if (mb_io_ptr->read_ahead_pending > 0) {
+		int lerror = MB_ERROR_NO_ERROR;
+		mb_read_ahead_init(verbose, mbio_ptr, mb_io_ptr->read_ahead_pending, mb_io_ptr->read_ahead_threads, &lerror);
+	}
+
+	/* get the next record from the read-ahead thread if running, otherwise
+	    call the appropriate mbr_ read and translate routine */
+	if (mb_io_ptr->read_ahead != NULL) {
+		status = mb_read_ahead_next(verbose, mbio_ptr, store_ptr, error);
+	}
+	else if (mb_io_ptr->mb_io_read_ping != NULL) {
 		status = (*mb_io_ptr->mb_io_read_ping)(verbose, mbio_ptr, store_ptr, error);
 	}
 	else {
@@ -69,6 +87,16 @@ int mb_read_ping(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *e
 	if (status == MB_SUCCESS) {
 		*kind = mb_io_ptr->new_kind;
 		mb_notice_log_datatype(verbose, mb_io_ptr, *kind);
+
+		/* once the first record has been read, skip ahead to the first record
+		    needed according to the record index, if any (see mb_index.c) */
+		if (mb_io_ptr->index_seek_pending) {
+			mb_io_ptr->index_seek_pending = false;
+			if (mb_io_ptr->mbfp != NULL && fseek(mb_io_ptr->mbfp, mb_io_ptr->index_seek_offset, SEEK_SET) == 0) {
+				mb_io_ptr->file_pos = mb_io_ptr->index_seek_offset;
+				mb_io_ptr->file_bytes = mb_io_ptr->index_seek_offset;
+			}
+		}
 	}
 	else
 		*kind = MB_DATA_NONE;
@@ -27,6 +27,15 @@
  * the velocity structure. The ray is traced until it either exits
  * the model or exhausts the specified travel time.
  *
+ * The state of each ray is kept separate from the velocity model, so
+ * mb_rt() may be called for one model from several threads at once.
+ * When many rays are traced through the same model, as when
+ * recalculating bathymetry, mb_rt_table_init() traces a fan of rays
+ * once from the top of the model and mb_rt_table() then obtains each
+ * ray by interpolating in that table. Because the medium is horizontally
+ * layered, a ray from a deeper source follows the tabulated ray with the
+ * same ray parameter from the point where it reaches the source depth.
+ *
  * Author:	D. W. Caress
  * Date:	November 14, 1994
  */
@@ -57,6 +66,15 @@ static const int MB_RT_PLOT_MODE_TABLE = 2;
 static const int MB_SSV_CORRECT = 1;
 static const int MB_SSV_INCORRECT = 2;
 
+/* raytracing lookup table defines - the table is sampled every
+    MB_RT_TABLE_DANGLE degrees of takeoff angle at the top of the model
+    up to MB_RT_TABLE_ANGLE_MAX, and every MB_RT_TABLE_DTIME seconds of
+    one-way travel time up to at most MB_RT_TABLE_TIME_MAX */
+static const double MB_RT_TABLE_DANGLE = 0.1;
+static const double MB_RT_TABLE_ANGLE_MAX = 85.0;
+static const double MB_RT_TABLE_DTIME = 0.005;
+static const double MB_RT_TABLE_TIME_MAX = 8.0;
+
 struct velocity_model {
 	/* velocity model */
 	int number_node;
@@ -70,8 +88,11 @@ struct velocity_model {
 	double *layer_depth_bottom;
 	double *layer_vel_top;
 	double *layer_vel_bottom;
+};
 
-	/* raytracing bookkeeping variables */
+/* raytracing state of a single ray - this is kept apart from the velocity
+    model so that rays may be traced through one model by several threads */
+struct mb_rt_ray_struct {
 	int ray_status;
 	bool done;
 	int outofbounds;
@@ -98,6 +119,21 @@ struct velocity_model {
 	double *tt_plot;
 };
 
+/* raytracing lookup table - the positions of rays traced from the top of
+    the velocity model are tabulated by takeoff angle and travel time */
+struct mb_rt_table_struct {
+	void *modelptr;
+	double source_depth;
+	double vv_source;
+	int nangle;
+	int ntime;
+	double *xx;
+	double *zz;
+	char *ray_status;
+	int *nvalid;
+	int *ndown;
+};
+
 /*--------------------------------------------------------------------------*/
 int mb_rt_init(int verbose, int number_node, double *depth, double *velocity, void **modelptr, int *error) {
 	if (verbose >= 2) {
@@ -149,32 +185,6 @@ int mb_rt_init(int verbose, int number_node, double *depth, double *velocity, vo
 		}
 	}
 
-	/* initialize raytracing bookkeeping variables */
-	model->ray_status = 0;
-	model->done = false;
-	model->outofbounds = 0;
-	model->layer = 0;
-	model->turned = 0;
-	model->plot_mode = 0;
-	model->number_plot_max = 0;
-	model->number_plot = 0;
-	model->sign_x = 0;
-	model->xx = 0.0;
-	model->zz = 0.0;
-	model->xf = 0.0;
-	model->zf = 0.0;
-	model->tt = 0.0;
-	model->dt = 0.0;
-	model->tt_left = 0.0;
-	model->vv_source = 0.0;
-	model->pp = 0.0;
-	model->xc = 0.0;
-	model->zc = 0.0;
-	model->radius = 0.0;
-	model->xx_plot = NULL;
-	model->zz_plot = NULL;
-	model->tt_plot = NULL;
-
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return values:\n");
@@ -215,25 +225,23 @@ int mb_rt_deall(int verbose, void **modelptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
-int mb_rt_get_depth(int verbose, void *modelptr, double beta, int dir_sign, int turn_sign, double *depth, int *error) {
+static int mb_rt_get_depth(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, double beta, int dir_sign, int turn_sign, double *depth, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
-		fprintf(stderr, "dbg2       modelptr:         %p\n", modelptr);
+		fprintf(stderr, "dbg2       model:            %p\n", (void *)model);
+		fprintf(stderr, "dbg2       ray:              %p\n", (void *)ray);
 		fprintf(stderr, "dbg2       beta:             %f\n", beta);
 		fprintf(stderr, "dbg2       dir_sign:         %d\n", dir_sign);
 		fprintf(stderr, "dbg2       turn_sign:        %d\n", turn_sign);
 	}
 
-  /* get velocity model struct * */
-  struct velocity_model *model = (struct velocity_model *)modelptr;
-
 	/* find depth */
-	const double alpha = model->pp * exp(dir_sign * model->tt_left * fabs(model->layer_gradient[model->layer]) + turn_sign * beta);
-	const double velf = 2 * alpha / (alpha * alpha + model->pp * model->pp);
+	const double alpha = ray->pp * exp(dir_sign * ray->tt_left * fabs(model->layer_gradient[ray->layer]) + turn_sign * beta);
+	const double velf = 2 * alpha / (alpha * alpha + ray->pp * ray->pp);
 	*depth =
-	    model->layer_depth_top[model->layer] + (velf - model->layer_vel_top[model->layer]) / model->layer_gradient[model->layer];
+	    model->layer_depth_top[ray->layer] + (velf - model->layer_vel_top[ray->layer]) / model->layer_gradient[ray->layer];
 
 	const int status = MB_SUCCESS;
 
@@ -249,93 +257,90 @@ int mb_rt_get_depth(int verbose, void *modelptr, double beta, int dir_sign, int
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
-int mb_rt_quad1(int verbose, void *modelptr, int *error) {
+static int mb_rt_quad1(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
-		fprintf(stderr, "dbg2       modelptr:         %p\n", modelptr);
+		fprintf(stderr, "dbg2       model:            %p\n", (void *)model);
+		fprintf(stderr, "dbg2       ray:              %p\n", (void *)ray);
 	}
 
-  /* get velocity model struct * */
-  struct velocity_model *model = (struct velocity_model *)modelptr;
-
 	/* find circular path */
-	model->radius = fabs(1.0 / (model->pp * model->layer_gradient[model->layer]));
-	model->zc = model->layer_depth_center[model->layer];
-	model->xc = model->xx + SAFESQRT(model->radius * model->radius - (model->zz - model->zc) * (model->zz - model->zc));
-	const double vi = model->layer_vel_top[model->layer] +
-	     (model->zz - model->layer_depth_top[model->layer]) * model->layer_gradient[model->layer];
-	const double ip = 1.0 / model->pp;
+	ray->radius = fabs(1.0 / (ray->pp * model->layer_gradient[ray->layer]));
+	ray->zc = model->layer_depth_center[ray->layer];
+	ray->xc = ray->xx + SAFESQRT(ray->radius * ray->radius - (ray->zz - ray->zc) * (ray->zz - ray->zc));
+	const double vi = model->layer_vel_top[ray->layer] +
+	     (ray->zz - model->layer_depth_top[ray->layer]) * model->layer_gradient[ray->layer];
+	const double ip = 1.0 / ray->pp;
 	const double ipvi = ip / vi;
 	const double beta = log(ipvi + SAFESQRT(ipvi * ipvi - 1.0));
 
 	int status = MB_SUCCESS;
 
 	/* Check if ray turns in layer */
-	if (model->zc + model->radius < model->layer_depth_bottom[model->layer]) {
+	if (ray->zc + ray->radius < model->layer_depth_bottom[ray->layer]) {
 		/* ray can turn in this layer */
-		model->dt = fabs(beta / model->layer_gradient[model->layer]);
+		ray->dt = fabs(beta / model->layer_gradient[ray->layer]);
 
 		/* raypath ends before turning */
-		if (model->dt >= model->tt_left) {
-			mb_rt_get_depth(verbose, modelptr, beta, -1, 1, &model->zf, error);
-			model->xf = model->xc - SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-			model->dt = model->tt_left;
-			model->tt_left = 0.0;
+		if (ray->dt >= ray->tt_left) {
+			mb_rt_get_depth(verbose, model, ray, beta, -1, 1, &ray->zf, error);
+			ray->xf = ray->xc - SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+			ray->dt = ray->tt_left;
+			ray->tt_left = 0.0;
 		}
 
 		/* raypath turns */
 		else {
-			const double ivf = 1.0 / model->layer_vel_top[model->layer];
-			model->dt = fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - model->pp * model->pp)) + beta) /
-			                 model->layer_gradient[model->layer]);
+			const double ivf = 1.0 / model->layer_vel_top[ray->layer];
+			ray->dt = fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - ray->pp * ray->pp)) + beta) /
+			                 model->layer_gradient[ray->layer]);
 
 			/* ray turns and exits layer before
 			    exhausting tt_left */
-			if (model->dt <= model->tt_left) {
-				model->turned = true;
-				model->ray_status = MB_RT_UP_TURN;
-				model->zf = model->layer_depth_top[model->layer];
-				model->xf =
-				    model->xc + SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-				model->tt_left = model->tt_left - model->dt;
-				model->layer--;
+			if (ray->dt <= ray->tt_left) {
+				ray->turned = true;
+				ray->ray_status = MB_RT_UP_TURN;
+				ray->zf = model->layer_depth_top[ray->layer];
+				ray->xf =
+				    ray->xc + SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+				ray->tt_left = ray->tt_left - ray->dt;
+				ray->layer--;
 			}
 			/* ray turns and exhausts tt_left
 			    before exiting layer */
-			else if (model->dt > model->tt_left) {
-				model->turned = true;
-				model->ray_status = MB_RT_UP_TURN;
-				mb_rt_get_depth(verbose, modelptr, beta, 1, -1, &model->zf, error);
-				model->xf =
-				    model->xc + SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-				model->dt = model->tt_left;
-				model->tt_left = 0.0;
+			else if (ray->dt > ray->tt_left) {
+				ray->turned = true;
+				ray->ray_status = MB_RT_UP_TURN;
+				mb_rt_get_depth(verbose, model, ray, beta, 1, -1, &ray->zf, error);
+				ray->xf =
+				    ray->xc + SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+				ray->dt = ray->tt_left;
+				ray->tt_left = 0.0;
 			}
 		}
 	}
 	else {
 		/* ray cannot turn in this layer */
-		const double ivf = 1.0 / model->layer_vel_bottom[model->layer];
-		model->dt =
-		    fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - model->pp * model->pp)) - beta) / model->layer_gradient[model->layer]);
+		const double ivf = 1.0 / model->layer_vel_bottom[ray->layer];
+		ray->dt =
+		    fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - ray->pp * ray->pp)) - beta) / model->layer_gradient[ray->layer]);
 
 		/* ray exits layer before exhausting tt_left */
-		if (model->dt <= model->tt_left) {
-			model->zf = model->layer_depth_bottom[model->layer];
-			model->xf = model->xc - SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-			model->tt_left = model->tt_left - model->dt;
-			model->layer++;
+		if (ray->dt <= ray->tt_left) {
+			ray->zf = model->layer_depth_bottom[ray->layer];
+			ray->xf = ray->xc - SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+			ray->tt_left = ray->tt_left - ray->dt;
+			ray->layer++;
 		}
-		/* ray exhausts tt_left before exiting layer */
-		else if (model->dt > model->tt_left) {
-			model->turned = true;
-			model->ray_status = MB_RT_UP_TURN;
-			mb_rt_get_depth(verbose, modelptr, beta, -1, 1, &model->zf, error);
-			model->xf = model->xc - SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-			model->dt = model->tt_left;
-			model->tt_left = 0.0;
+		/* ray exhausts tt_left before exiting layer - the
+		    ray is still going down so it has not turned */
+		else if (ray->dt > ray->tt_left) {
+			mb_rt_get_depth(verbose, model, ray, beta, -1, 1, &ray->zf, error);
+			ray->xf = ray->xc - SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+			ray->dt = ray->tt_left;
+			ray->tt_left = 0.0;
 		}
 	}
 
@@ -350,46 +355,44 @@ int mb_rt_quad1(int verbose, void *modelptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
-int mb_rt_quad2(int verbose, void *modelptr, int *error) {
+static int mb_rt_quad2(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
-		fprintf(stderr, "dbg2       modelptr:         %p\n", modelptr);
+		fprintf(stderr, "dbg2       model:            %p\n", (void *)model);
+		fprintf(stderr, "dbg2       ray:              %p\n", (void *)ray);
 	}
 
-  /* get velocity model struct * */
-  struct velocity_model *model = (struct velocity_model *)modelptr;
-
 	/* find circular path */
-	model->radius = fabs(1.0 / (model->pp * model->layer_gradient[model->layer]));
-	model->zc = model->layer_depth_center[model->layer];
-	model->xc = model->xx - SAFESQRT(MAX(0.0, model->radius * model->radius - (model->zz - model->zc) * (model->zz - model->zc)));
+	ray->radius = fabs(1.0 / (ray->pp * model->layer_gradient[ray->layer]));
+	ray->zc = model->layer_depth_center[ray->layer];
+	ray->xc = ray->xx - SAFESQRT(MAX(0.0, ray->radius * ray->radius - (ray->zz - ray->zc) * (ray->zz - ray->zc)));
 
-	const double vi = model->layer_vel_top[model->layer] +
-	     (model->zz - model->layer_depth_top[model->layer]) * model->layer_gradient[model->layer];
-	const double ip = 1.0 / model->pp;
+	const double vi = model->layer_vel_top[ray->layer] +
+	     (ray->zz - model->layer_depth_top[ray->layer]) * model->layer_gradient[ray->layer];
+	const double ip = 1.0 / ray->pp;
 	const double ipvi = ip / vi;
 	const double beta = log(ipvi + SAFESQRT(ipvi * ipvi - 1.0));
 
 	/* Check if ray ends in layer */
-	const double ivf = 1.0 / model->layer_vel_top[model->layer];
-	model->dt =
-	    fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - model->pp * model->pp)) - beta) / model->layer_gradient[model->layer]);
+	const double ivf = 1.0 / model->layer_vel_top[ray->layer];
+	ray->dt =
+	    fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - ray->pp * ray->pp)) - beta) / model->layer_gradient[ray->layer]);
 
 	/* ray exits layer before exhausting tt_left */
-	if (model->dt <= model->tt_left) {
-		model->zf = model->layer_depth_top[model->layer];
-		model->xf = model->xc + SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-		model->tt_left = model->tt_left - model->dt;
-		model->layer--;
+	if (ray->dt <= ray->tt_left) {
+		ray->zf = model->layer_depth_top[ray->layer];
+		ray->xf = ray->xc + SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+		ray->tt_left = ray->tt_left - ray->dt;
+		ray->layer--;
 	}
 	/* ray exhausts tt_left before exiting layer */
-	else if (model->dt > model->tt_left) {
-		mb_rt_get_depth(verbose, modelptr, beta, 1, 1, &model->zf, error);
-		model->xf = model->xc + SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-		model->dt = model->tt_left;
-		model->tt_left = 0.0;
+	else if (ray->dt > ray->tt_left) {
+		mb_rt_get_depth(verbose, model, ray, beta, 1, 1, &ray->zf, error);
+		ray->xf = ray->xc + SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+		ray->dt = ray->tt_left;
+		ray->tt_left = 0.0;
 	}
 
 	const int status = MB_SUCCESS;
@@ -405,45 +408,43 @@ int mb_rt_quad2(int verbose, void *modelptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
-int mb_rt_quad3(int verbose, void *modelptr, int *error) {
+static int mb_rt_quad3(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
-		fprintf(stderr, "dbg2       modelptr:         %p\n", modelptr);
+		fprintf(stderr, "dbg2       model:            %p\n", (void *)model);
+		fprintf(stderr, "dbg2       ray:              %p\n", (void *)ray);
 	}
 
-  /* get velocity model struct * */
-  struct velocity_model *model = (struct velocity_model *)modelptr;
-
 	/* find circular path */
-	model->radius = fabs(1.0 / (model->pp * model->layer_gradient[model->layer]));
-	model->zc = model->layer_depth_center[model->layer];
-	model->xc = model->xx - SAFESQRT(model->radius * model->radius - (model->zz - model->zc) * (model->zz - model->zc));
-	const double vi = model->layer_vel_top[model->layer] +
-	     (model->zz - model->layer_depth_top[model->layer]) * model->layer_gradient[model->layer];
-	const double ip = 1.0 / model->pp;
+	ray->radius = fabs(1.0 / (ray->pp * model->layer_gradient[ray->layer]));
+	ray->zc = model->layer_depth_center[ray->layer];
+	ray->xc = ray->xx - SAFESQRT(ray->radius * ray->radius - (ray->zz - ray->zc) * (ray->zz - ray->zc));
+	const double vi = model->layer_vel_top[ray->layer] +
+	     (ray->zz - model->layer_depth_top[ray->layer]) * model->layer_gradient[ray->layer];
+	const double ip = 1.0 / ray->pp;
 	const double ipvi = ip / vi;
 	const double beta = log(ipvi + SAFESQRT(ipvi * ipvi - 1.0));
 
 	/* Check if ray ends in layer */
-	const double ivf = 1.0 / model->layer_vel_bottom[model->layer];
-	model->dt =
-	    fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - model->pp * model->pp)) - beta) / model->layer_gradient[model->layer]);
+	const double ivf = 1.0 / model->layer_vel_bottom[ray->layer];
+	ray->dt =
+	    fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - ray->pp * ray->pp)) - beta) / model->layer_gradient[ray->layer]);
 
 	/* ray exits layer before exhausting tt_left */
-	if (model->dt <= model->tt_left) {
-		model->zf = model->layer_depth_bottom[model->layer];
-		model->xf = model->xc + SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-		model->tt_left = model->tt_left - model->dt;
-		model->layer++;
+	if (ray->dt <= ray->tt_left) {
+		ray->zf = model->layer_depth_bottom[ray->layer];
+		ray->xf = ray->xc + SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+		ray->tt_left = ray->tt_left - ray->dt;
+		ray->layer++;
 	}
 	/* ray exhausts tt_left before exiting layer */
-	else if (model->dt > model->tt_left) {
-		mb_rt_get_depth(verbose, modelptr, beta, 1, 1, &model->zf, error);
-		model->xf = model->xc + SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-		model->dt = model->tt_left;
-		model->tt_left = 0.0;
+	else if (ray->dt > ray->tt_left) {
+		mb_rt_get_depth(verbose, model, ray, beta, 1, 1, &ray->zf, error);
+		ray->xf = ray->xc + SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+		ray->dt = ray->tt_left;
+		ray->tt_left = 0.0;
 	}
 
 	const int status = MB_SUCCESS;
@@ -459,93 +460,91 @@ int mb_rt_quad3(int verbose, void *modelptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
-int mb_rt_quad4(int verbose, void *modelptr, int *error) {
+static int mb_rt_quad4(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
-		fprintf(stderr, "dbg2       modelptr:         %p\n", modelptr);
+		fprintf(stderr, "dbg2       model:            %p\n", (void *)model);
+		fprintf(stderr, "dbg2       ray:              %p\n", (void *)ray);
 	}
 
-  /* get velocity model struct * */
-  struct velocity_model *model = (struct velocity_model *)modelptr;
-
 	/* find circular path */
-	model->radius = fabs(1.0 / (model->pp * model->layer_gradient[model->layer]));
-	model->zc = model->layer_depth_center[model->layer];
-	model->xc = model->xx + SAFESQRT(model->radius * model->radius - (model->zz - model->zc) * (model->zz - model->zc));
-	const double vi = model->layer_vel_top[model->layer] +
-	     (model->zz - model->layer_depth_top[model->layer]) * model->layer_gradient[model->layer];
-	const double ip = 1.0 / model->pp;
+	ray->radius = fabs(1.0 / (ray->pp * model->layer_gradient[ray->layer]));
+	ray->zc = model->layer_depth_center[ray->layer];
+	ray->xc = ray->xx + SAFESQRT(ray->radius * ray->radius - (ray->zz - ray->zc) * (ray->zz - ray->zc));
+	const double vi = model->layer_vel_top[ray->layer] +
+	     (ray->zz - model->layer_depth_top[ray->layer]) * model->layer_gradient[ray->layer];
+	const double ip = 1.0 / ray->pp;
 	const double ipvi = ip / vi;
 	const double beta = log(ipvi + SAFESQRT(ipvi * ipvi - 1.0));
 
 	int status = MB_SUCCESS;
 
 	/* Check if ray turns in layer */
-	if (model->zc - model->radius > model->layer_depth_top[model->layer]) {
+	if (ray->zc - ray->radius > model->layer_depth_top[ray->layer]) {
 		/* ray can turn in this layer */
-		model->dt = fabs(beta / model->layer_gradient[model->layer]);
+		ray->dt = fabs(beta / model->layer_gradient[ray->layer]);
 
 		/* raypath ends before turning */
-		if (model->dt >= model->tt_left) {
-			mb_rt_get_depth(verbose, modelptr, beta, -1, 1, &model->zf, error);
-			model->xf = model->xc - SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-			model->dt = model->tt_left;
-			model->tt_left = 0.0;
+		if (ray->dt >= ray->tt_left) {
+			mb_rt_get_depth(verbose, model, ray, beta, -1, 1, &ray->zf, error);
+			ray->xf = ray->xc - SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+			ray->dt = ray->tt_left;
+			ray->tt_left = 0.0;
 		}
 
 		/* raypath turns */
 		else {
-			const double ivf = 1.0 / model->layer_vel_bottom[model->layer];
-			model->dt = fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - model->pp * model->pp)) + beta) /
-			                 model->layer_gradient[model->layer]);
+			const double ivf = 1.0 / model->layer_vel_bottom[ray->layer];
+			ray->dt = fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - ray->pp * ray->pp)) + beta) /
+			                 model->layer_gradient[ray->layer]);
 
 			/* ray turns and exits layer before
 			    exhausting tt_left */
-			if (model->dt <= model->tt_left) {
-				model->turned = false;
-				model->ray_status = MB_RT_DOWN_TURN;
-				model->zf = model->layer_depth_bottom[model->layer];
-				model->xf =
-				    model->xc + SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-				model->tt_left = model->tt_left - model->dt;
-				model->layer++;
+			if (ray->dt <= ray->tt_left) {
+				ray->turned = false;
+				ray->ray_status = MB_RT_DOWN_TURN;
+				ray->zf = model->layer_depth_bottom[ray->layer];
+				ray->xf =
+				    ray->xc + SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+				ray->tt_left = ray->tt_left - ray->dt;
+				ray->layer++;
 			}
 			/* ray turns and exhausts tt_left
 			    before exiting layer */
-			else if (model->dt > model->tt_left) {
-				model->turned = false;
-				model->ray_status = MB_RT_DOWN_TURN;
-				mb_rt_get_depth(verbose, modelptr, beta, 1, -1, &model->zf, error);
-				model->xf =
-				    model->xc + SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-				model->dt = model->tt_left;
-				model->tt_left = 0.0;
+			else if (ray->dt > ray->tt_left) {
+				ray->turned = false;
+				ray->ray_status = MB_RT_DOWN_TURN;
+				mb_rt_get_depth(verbose, model, ray, beta, 1, -1, &ray->zf, error);
+				ray->xf =
+				    ray->xc + SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+				ray->dt = ray->tt_left;
+				ray->tt_left = 0.0;
 			}
 		}
 	}
 	else {
 		/* ray cannot turn in this layer */
-		const double ivf = 1.0 / model->layer_vel_top[model->layer];
-		model->dt =
-		    fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - model->pp * model->pp)) - beta) / model->layer_gradient[model->layer]);
+		const double ivf = 1.0 / model->layer_vel_top[ray->layer];
+		ray->dt =
+		    fabs((log(ip * ivf + ip * SAFESQRT(ivf * ivf - ray->pp * ray->pp)) - beta) / model->layer_gradient[ray->layer]);
 
 		/* ray exits layer before exhausting tt_left */
-		if (model->dt <= model->tt_left) {
-			model->zf = model->layer_depth_top[model->layer];
-			model->xf = model->xc - SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-			model->tt_left = model->tt_left - model->dt;
-			model->layer--;
+		if (ray->dt <= ray->tt_left) {
+			ray->zf = model->layer_depth_top[ray->layer];
+			ray->xf = ray->xc - SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+			ray->tt_left = ray->tt_left - ray->dt;
+			ray->layer--;
 		}
 		/* ray exhausts tt_left before exiting layer */
-		else if (model->dt > model->tt_left) {
-			model->turned = true;
-			model->ray_status = MB_RT_UP_TURN;
-			mb_rt_get_depth(verbose, modelptr, beta, -1, 1, &model->zf, error);
-			model->xf = model->xc - SAFESQRT(model->radius * model->radius - (model->zf - model->zc) * (model->zf - model->zc));
-			model->dt = model->tt_left;
-			model->tt_left = 0.0;
+		else if (ray->dt > ray->tt_left) {
+			ray->turned = true;
+			ray->ray_status = MB_RT_UP_TURN;
+			mb_rt_get_depth(verbose, model, ray, beta, -1, 1, &ray->zf, error);
+			ray->xf = ray->xc - SAFESQRT(ray->radius * ray->radius - (ray->zf - ray->zc) * (ray->zf - ray->zc));
+			ray->dt = ray->tt_left;
+			ray->tt_left = 0.0;
 		}
 	}
 
@@ -560,45 +559,43 @@ int mb_rt_quad4(int verbose, void *modelptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
-int mb_rt_plot_circular(int verbose, void *modelptr, int *error) {
+static int mb_rt_plot_circular(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
-		fprintf(stderr, "dbg2       modelptr:         %p\n", modelptr);
+		fprintf(stderr, "dbg2       model:            %p\n", (void *)model);
+		fprintf(stderr, "dbg2       ray:              %p\n", (void *)ray);
 	}
 
-  /* get velocity model struct * */
-  struct velocity_model *model = (struct velocity_model *)modelptr;
-
 	/* if full plot do circle segments */
-	if (model->plot_mode == MB_RT_PLOT_MODE_ON) {
+	if (ray->plot_mode == MB_RT_PLOT_MODE_ON) {
 		/* get angle range */
-		const double ai = atan2((model->xx - model->xc), (model->zz - model->zc));
-		const double af = atan2((model->xf - model->xc), (model->zf - model->zc));
+		const double ai = atan2((ray->xx - ray->xc), (ray->zz - ray->zc));
+		const double af = atan2((ray->xf - ray->xc), (ray->zf - ray->zc));
 		const double dang = (af - ai) / MB_RT_NUMBER_SEGMENTS;
 
 		/* add points to plotting arrays */
-    double tt = model->tt;
+    double tt = ray->tt;
 		for (int i = 0; i < MB_RT_NUMBER_SEGMENTS; i++) {
 			const double angle = ai + (i + 1) * dang;
       const double uz0 = cos(angle - dang); // starting z component of unit direction vector
       const double uz1 = cos(angle); // ending z component of unit direction vector
-			if (model->number_plot < model->number_plot_max) {
-				model->xx_plot[model->number_plot] = model->sign_x * (model->xc + model->radius * sin(angle));
-				model->zz_plot[model->number_plot] = model->zc + model->radius * cos(angle);
+			if (ray->number_plot < ray->number_plot_max) {
+				ray->xx_plot[ray->number_plot] = ray->sign_x * (ray->xc + ray->radius * sin(angle));
+				ray->zz_plot[ray->number_plot] = ray->zc + ray->radius * cos(angle);
         tt += 0.5 * log(((1.0 + uz1)/(1.0 - uz1)) * ((1.0 - uz0)/(1.0 + uz0)))
-              / model->layer_gradient[model->layer];
-        model->tt_plot[model->number_plot] = tt;
-				model->number_plot++;
+              / model->layer_gradient[ray->layer];
+        ray->tt_plot[ray->number_plot] = tt;
+				ray->number_plot++;
 			}
 		}
 	}
 
 	/* otherwise just add the layer end */
-	else if (model->plot_mode == MB_RT_PLOT_MODE_TABLE) {
-		model->xx_plot[model->number_plot] = model->xf;
-		model->number_plot++;
+	else if (ray->plot_mode == MB_RT_PLOT_MODE_TABLE) {
+		ray->xx_plot[ray->number_plot] = ray->xf;
+		ray->number_plot++;
 	}
 
 	const int status = MB_SUCCESS;
@@ -614,32 +611,30 @@ int mb_rt_plot_circular(int verbose, void *modelptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
-int mb_rt_circular(int verbose, void *modelptr, int *error) {
+static int mb_rt_circular(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
-		fprintf(stderr, "dbg2       modelptr:         %p\n", modelptr);
+		fprintf(stderr, "dbg2       model:            %p\n", (void *)model);
+		fprintf(stderr, "dbg2       ray:              %p\n", (void *)ray);
 	}
 
-  /* get velocity model struct * */
-  struct velocity_model *model = (struct velocity_model *)modelptr;
-
 	int status = MB_SUCCESS;
 
 	/* decide which case to use */
-	if (!model->turned && model->layer_gradient[model->layer] > 0.0)
-		status = mb_rt_quad1(verbose, modelptr, error);
-	else if (!model->turned)
-		status = mb_rt_quad3(verbose, modelptr, error);
-	else if (model->turned && model->layer_gradient[model->layer] > 0.0)
-		status = mb_rt_quad2(verbose, modelptr, error);
-	else if (model->turned)
-		status = mb_rt_quad4(verbose, modelptr, error);
+	if (!ray->turned && model->layer_gradient[ray->layer] > 0.0)
+		status = mb_rt_quad1(verbose, model, ray, error);
+	else if (!ray->turned)
+		status = mb_rt_quad3(verbose, model, ray, error);
+	else if (ray->turned && model->layer_gradient[ray->layer] > 0.0)
+		status = mb_rt_quad2(verbose, model, ray, error);
+	else if (ray->turned)
+		status = mb_rt_quad4(verbose, model, ray, error);
 
 	/* put points in plotting arrays */
-	if (model->number_plot_max > 0)
-		status = mb_rt_plot_circular(verbose, modelptr, error);
+	if (ray->number_plot_max > 0)
+		status = mb_rt_plot_circular(verbose, model, ray, error);
 
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
@@ -652,86 +647,84 @@ int mb_rt_circular(int verbose, void *modelptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
-int mb_rt_line(int verbose, void *modelptr, int *error) {
+static int mb_rt_line(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
-		fprintf(stderr, "dbg2       modelptr:         %p\n", modelptr);
+		fprintf(stderr, "dbg2       model:            %p\n", (void *)model);
+		fprintf(stderr, "dbg2       ray:              %p\n", (void *)ray);
 	}
 
-  /* get velocity model struct * */
-  struct velocity_model *model = (struct velocity_model *)modelptr;
-
 	/* find linear path */
-	const double asin_arg = MIN(model->pp * model->layer_vel_top[model->layer], 1.000);
+	const double asin_arg = MIN(ray->pp * model->layer_vel_top[ray->layer], 1.000);
 	double theta = asin(asin_arg);
-	if (!model->turned) {
-		model->zf = model->layer_depth_bottom[model->layer];
+	if (!ray->turned) {
+		ray->zf = model->layer_depth_bottom[ray->layer];
 	}
 	else {
 		theta = theta + M_PI;
-		model->zf = model->layer_depth_top[model->layer];
+		ray->zf = model->layer_depth_top[ray->layer];
 	}
-	const double xvel = model->layer_vel_top[model->layer] * sin(theta);
-	const double zvel = model->layer_vel_top[model->layer] * cos(theta);
+	const double xvel = model->layer_vel_top[ray->layer] * sin(theta);
+	const double zvel = model->layer_vel_top[ray->layer] * cos(theta);
 	if (zvel != 0.0)
-		model->dt = (model->zf - model->zz) / zvel;
+		ray->dt = (ray->zf - ray->zz) / zvel;
 	else
-		model->dt = 100 * model->tt_left;
+		ray->dt = 100 * ray->tt_left;
 
 	/* if (verbose >= 5)
 	    {
 	    fprintf(stderr,"\ndbg5  Ray calculation in MBIO function <%s>\n", __func__);
-	    fprintf(stderr,"dbg5        model->layer:               %d\n", model->layer);
-	    fprintf(stderr,"dbg5        model->layer_vel_top:       %f\n", model->layer_vel_top[model->layer]);
-	    fprintf(stderr,"dbg5        layer_vel_top * pp:         %f\n", model->pp * model->layer_vel_top[model->layer]);
-	    fprintf(stderr,"dbg5        asin(layer_vel_top * pp):   %f\n", asin(model->pp * model->layer_vel_top[model->layer]));
-	    fprintf(stderr,"dbg5        model->pp:                  %f\n", model->pp);
+	    fprintf(stderr,"dbg5        ray->layer:               %d\n", ray->layer);
+	    fprintf(stderr,"dbg5        model->layer_vel_top:       %f\n", model->layer_vel_top[ray->layer]);
+	    fprintf(stderr,"dbg5        layer_vel_top * pp:         %f\n", ray->pp * model->layer_vel_top[ray->layer]);
+	    fprintf(stderr,"dbg5        asin(layer_vel_top * pp):   %f\n", asin(ray->pp * model->layer_vel_top[ray->layer]));
+	    fprintf(stderr,"dbg5        ray->pp:                  %f\n", ray->pp);
 	    fprintf(stderr,"dbg5        theta:                      %f\n", theta);
-	    fprintf(stderr,"dbg5        model->zf:                  %f\n", model->zf);
+	    fprintf(stderr,"dbg5        ray->zf:                  %f\n", ray->zf);
 	    fprintf(stderr,"dbg5        xvel:                       %f\n", xvel);
 	    fprintf(stderr,"dbg5        zvel:                       %f\n", zvel);
 	    }*/
 
 	/* ray exhausts tt_left before exiting layer */
-	if (model->dt >= model->tt_left) {
-		model->xf = model->xx + xvel * model->tt_left;
-		model->zf = model->zz + zvel * model->tt_left;
-		model->dt = model->tt_left;
-		model->tt_left = 0.0;
+	if (ray->dt >= ray->tt_left) {
+		ray->xf = ray->xx + xvel * ray->tt_left;
+		ray->zf = ray->zz + zvel * ray->tt_left;
+		ray->dt = ray->tt_left;
+		ray->tt_left = 0.0;
 	}
 
 	/* ray exits layer before exhausting tt_left */
 	else {
-		model->xf = model->xx + xvel * model->dt;
-		model->zf = model->zz + zvel * model->dt;
-		model->tt_left = model->tt_left - model->dt;
-		if (model->turned)
-			model->layer--;
+		ray->xf = ray->xx + xvel * ray->dt;
+		ray->zf = ray->zz + zvel * ray->dt;
+		ray->tt_left = ray->tt_left - ray->dt;
+		if (ray->turned)
+			ray->layer--;
 		else
-			model->layer++;
+			ray->layer++;
 	}
 
 	/* if (verbose >= 5)
 	    {
 	    fprintf(stderr,"\ndbg5  Ray calculation in MBIO function <%s>\n", __func__);
-	    fprintf(stderr,"dbg5        model->xf:                 %f\n", model->xf);
-	    fprintf(stderr,"dbg5        model->zf:                 %f\n", model->zf);
-	    fprintf(stderr,"dbg5        model->dt:                 %f\n", model->dt);
-	    fprintf(stderr,"dbg5        model->tt_left:            %f\n", model->tt_left);
-	    fprintf(stderr,"dbg5        model->turned:             %d\n", model->turned);
-	    fprintf(stderr,"dbg5        model->layer:              %d\n", model->layer);
+	    fprintf(stderr,"dbg5        ray->xf:                 %f\n", ray->xf);
+	    fprintf(stderr,"dbg5        ray->zf:                 %f\n", ray->zf);
+	    fprintf(stderr,"dbg5        ray->dt:                 %f\n", ray->dt);
+	    fprintf(stderr,"dbg5        ray->tt_left:            %f\n", ray->tt_left);
+	    fprintf(stderr,"dbg5        ray->turned:             %d\n", ray->turned);
+	    fprintf(stderr,"dbg5        ray->layer:              %d\n", ray->layer);
 	    } */
 
 	/* put points in plotting arrays */
-	if (model->plot_mode != MB_RT_PLOT_MODE_OFF && model->number_plot < model->number_plot_max) {
-		model->xx_plot[model->number_plot] = model->sign_x * model->xf;
-		if (model->plot_mode == MB_RT_PLOT_MODE_ON) {
-			model->zz_plot[model->number_plot] = model->zf;
-			model->tt_plot[model->number_plot] = model->tt + model->dt;
+	if (ray->plot_mode != MB_RT_PLOT_MODE_OFF && ray->number_plot < ray->number_plot_max) {
+		ray->xx_plot[ray->number_plot] = ray->sign_x * ray->xf;
+		if (ray->plot_mode == MB_RT_PLOT_MODE_ON) {
+			ray->zz_plot[ray->number_plot] = ray->zf;
+			ray->tt_plot[ray->number_plot] = ray->tt + ray->dt;
 		}
-		model->number_plot++;
+		ray->number_plot++;
 	}
 
 	const int status = MB_SUCCESS;
@@ -747,64 +740,62 @@ int mb_rt_line(int verbose, void *modelptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
-int mb_rt_vertical(int verbose, void *modelptr, int *error) {
+static int mb_rt_vertical(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
-		fprintf(stderr, "dbg2       modelptr:         %p\n", modelptr);
+		fprintf(stderr, "dbg2       model:            %p\n", (void *)model);
+		fprintf(stderr, "dbg2       ray:              %p\n", (void *)ray);
 	}
 
-  /* get velocity model struct * */
-  struct velocity_model *model = (struct velocity_model *)modelptr;
-
 	/* find linear path */
-	const double vi = model->layer_vel_top[model->layer] +
-	     (model->zz - model->layer_depth_top[model->layer]) * model->layer_gradient[model->layer];
+	const double vi = model->layer_vel_top[ray->layer] +
+	     (ray->zz - model->layer_depth_top[ray->layer]) * model->layer_gradient[ray->layer];
 
 	double vf;
-	if (!model->turned) {
-		model->zf = model->layer_depth_bottom[model->layer];
-		vf = model->layer_vel_bottom[model->layer];
+	if (!ray->turned) {
+		ray->zf = model->layer_depth_bottom[ray->layer];
+		vf = model->layer_vel_bottom[ray->layer];
 	}
 	else {
-		model->zf = model->layer_depth_top[model->layer];
-		vf = model->layer_vel_top[model->layer];
+		ray->zf = model->layer_depth_top[ray->layer];
+		vf = model->layer_vel_top[ray->layer];
 	}
-	model->dt = fabs(log(vf / vi) / model->layer_gradient[model->layer]);
+	ray->dt = fabs(log(vf / vi) / model->layer_gradient[ray->layer]);
 
 	/* ray exhausts tt_left before exiting layer */
-	if (model->dt >= model->tt_left) {
-		model->xf = model->xx;
-		const double vfvi = exp(model->tt_left * model->layer_gradient[model->layer]);
-		if (!model->turned)
+	if (ray->dt >= ray->tt_left) {
+		ray->xf = ray->xx;
+		const double vfvi = exp(ray->tt_left * model->layer_gradient[ray->layer]);
+		if (!ray->turned)
 			vf = vi * vfvi;
-		else if (model->turned)
+		else if (ray->turned)
 			vf = vi / vfvi;
-		model->zf = (vf - model->layer_vel_top[model->layer]) / model->layer_gradient[model->layer] +
-		            model->layer_depth_top[model->layer];
-		model->dt = model->tt_left;
-		model->tt_left = 0.0;
+		ray->zf = (vf - model->layer_vel_top[ray->layer]) / model->layer_gradient[ray->layer] +
+		            model->layer_depth_top[ray->layer];
+		ray->dt = ray->tt_left;
+		ray->tt_left = 0.0;
 	}
 
 	/* ray exits layer before exhausting tt_left */
 	else {
-		model->xf = model->xx;
-		model->tt_left = model->tt_left - model->dt;
-		if (model->turned)
-			model->layer--;
+		ray->xf = ray->xx;
+		ray->tt_left = ray->tt_left - ray->dt;
+		if (ray->turned)
+			ray->layer--;
 		else
-			model->layer++;
+			ray->layer++;
 	}
 
 	/* put points in plotting arrays */
-	if (model->plot_mode != MB_RT_PLOT_MODE_OFF && model->number_plot < model->number_plot_max) {
-		model->xx_plot[model->number_plot] = model->sign_x * model->xf;
-		if (model->plot_mode == MB_RT_PLOT_MODE_ON) {
-			model->zz_plot[model->number_plot] = model->zf;
-			model->tt_plot[model->number_plot] = model->tt + model->dt;
+	if (ray->plot_mode != MB_RT_PLOT_MODE_OFF && ray->number_plot < ray->number_plot_max) {
+		ray->xx_plot[ray->number_plot] = ray->sign_x * ray->xf;
+		if (ray->plot_mode == MB_RT_PLOT_MODE_ON) {
+			ray->zz_plot[ray->number_plot] = ray->zf;
+			ray->tt_plot[ray->number_plot] = ray->tt + ray->dt;
 		}
-		model->number_plot++;
+		ray->number_plot++;
 	}
 
 	int status = MB_SUCCESS;
@@ -820,12 +811,99 @@ int mb_rt_vertical(int verbose, void *modelptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------------*/
+static double mb_rt_ssv_angle(int ssv_mode, double surface_vel, double null_angle, double vv_source, double source_angle) {
+	/* reset takeoff angle because of surface sound velocity change:
+	    ssv_mode == MB_SSV_NO_USE:
+	      Do nothing to angles before raytracing.
+	    ssv_mode == MB_SSV_CORRECT:
+	      Adjust the angle assuming the original SSV was correct.
+	      This means use a horizontal layer assumption and Snell's
+	      law to adjust angle as ray goes from original SSV
+	      to the velocity in the SVP at the initial depth. The
+	      null angle is ignored.
+	    ssv_mode == MB_SSV_INCORRECT:
+	      Adjust the angle assuming the original SSV was incorrect.
+	      This means use Snell's law law to adjust angle in a
+	      rotated frame of reference (rotated by null angle) as
+	      ray goes from original SSV to the velocity in the
+	      SVP at the initial depth. This insures that the geometry
+	      of the receiving transducer array is properly handled.
+	 */
+	if (ssv_mode == MB_SSV_CORRECT && surface_vel > 0.0) {
+		const double pp = sin(DTR * source_angle) / surface_vel;
+		const double vel_ratio = MIN(1.0, pp * vv_source);
+		source_angle = asin(vel_ratio) * RTD;
+	}
+	else if (ssv_mode == MB_SSV_INCORRECT && surface_vel > 0.0) {
+		double diff_angle = source_angle - null_angle;
+		const double pp = sin(DTR * diff_angle) / surface_vel;
+		const double vel_ratio = MIN(1.0, pp * vv_source);
+		diff_angle = asin(vel_ratio) * RTD;
+		source_angle = null_angle + diff_angle;
+	}
+	// else do nothing
+
+	return (source_angle);
+}
+/*--------------------------------------------------------------------------*/
+static int mb_rt_trace(int verbose, const struct velocity_model *model, struct mb_rt_ray_struct *ray, int *error) {
+	int status = MB_SUCCESS;
+
+	/* trace the ray */
+	while (!ray->done && !ray->outofbounds) {
+		/* trace ray through current layer */
+		if (model->layer_mode[ray->layer] == MB_RT_LAYER_GRADIENT && ray->pp > 0.0)
+			status = mb_rt_circular(verbose, model, ray, error);
+		else if (model->layer_mode[ray->layer] == MB_RT_LAYER_GRADIENT)
+			status = mb_rt_vertical(verbose, model, ray, error);
+		else
+			status = mb_rt_line(verbose, model, ray, error);
+
+		/* update ray */
+		ray->tt = ray->tt + ray->dt;
+		if (ray->layer < 0) {
+			ray->outofbounds = true;
+			ray->ray_status = MB_RT_OUT_TOP;
+		}
+		if (ray->layer >= model->number_layer) {
+			ray->outofbounds = true;
+			ray->ray_status = MB_RT_OUT_BOTTOM;
+		}
+		if (ray->tt_left <= 0.0)
+			ray->done = true;
+
+		if (verbose >= 2) {
+			fprintf(stderr, "\ndbg2  model->done with ray iteration in MB_RT function <%s>\n", __func__);
+			fprintf(stderr, "dbg2       xx:               %f\n", ray->xx);
+			fprintf(stderr, "dbg2       zz:               %f\n", ray->zz);
+			fprintf(stderr, "dbg2       xf:               %f\n", ray->xf);
+			fprintf(stderr, "dbg2       zf:               %f\n", ray->zf);
+			fprintf(stderr, "dbg2       layer:            %d\n", ray->layer);
+			fprintf(stderr, "dbg2       layer_mode:       %d\n", model->layer_mode[ray->layer]);
+			fprintf(stderr, "dbg2       tt:               %f\n", ray->tt);
+			fprintf(stderr, "dbg2       dt:               %f\n", ray->dt);
+			fprintf(stderr, "dbg2       tt_left:          %f\n", ray->tt_left);
+		}
+
+		/* reset position */
+		ray->xx = ray->xf;
+		ray->zz = ray->zf;
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------------*/
 int mb_rt(int verbose, void *modelptr, double source_depth, double source_angle, double end_time, int ssv_mode,
           double surface_vel, double null_angle, int nplot_max,
           int *nplot, double *xplot, double *zplot, double *tplot,
           double *x, double *z, double *travel_time, int *ray_stat, int *error) {
 	/* get pointer to velocity model */
-	struct velocity_model *model = (struct velocity_model *)modelptr;
+	const struct velocity_model *model = (const struct velocity_model *)modelptr;
+
+	/* the state of this ray is held locally so that mb_rt() is re-entrant */
+	struct mb_rt_ray_struct ray_struct;
+	memset(&ray_struct, 0, sizeof(struct mb_rt_ray_struct));
+	struct mb_rt_ray_struct *ray = &ray_struct;
 
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
@@ -854,12 +932,12 @@ int mb_rt(int verbose, void *modelptr, double source_depth, double source_angle,
 	}
 
 	/* prepare the ray */
-	model->layer = -1;
+	ray->layer = -1;
 	for (int i = 0; i < model->number_layer; i++) {
 		if (source_depth >= model->layer_depth_top[i] && source_depth <= model->layer_depth_bottom[i])
-			model->layer = i;
+			ray->layer = i;
 	}
-	if (verbose > 0 && model->layer == -1) {
+	if (verbose > 0 && ray->layer == -1) {
 		fprintf(stderr, "\nError in MBIO function <%s>\n", __func__);
 		fprintf(stderr, "Ray source depth not within model!!\n");
 		fprintf(stderr, "Raytracing terminated with error!!\n");
@@ -867,160 +945,338 @@ int mb_rt(int verbose, void *modelptr, double source_depth, double source_angle,
 
 	int status = MB_SUCCESS;
 
-	if (model->layer == -1) {
+	if (ray->layer == -1) {
 		status = MB_FAILURE;
 		*error = MB_ERROR_BAD_PARAMETER;
 		return (status);
 	}
-	model->vv_source = model->layer_vel_top[model->layer] +
-	                   model->layer_gradient[model->layer] * (source_depth - model->layer_depth_top[model->layer]);
+	ray->vv_source = model->layer_vel_top[ray->layer] +
+	                   model->layer_gradient[ray->layer] * (source_depth - model->layer_depth_top[ray->layer]);
 
-	/* reset takeoff angle because of surface sound velocity change:
-	    ssv_mode == MB_SSV_NO_USE:
-	      Do nothing to angles before raytracing.
-	    ssv_mode == MB_SSV_CORRECT:
-	      Adjust the angle assuming the original SSV was correct.
-	      This means use a horizontal layer assumption and Snell's
-	      law to adjust angle as ray goes from original SSV
-	      to the velocity in the SVP at the initial depth. The
-	      null angle is ignored.
-	    ssv_mode == MB_SSV_INCORRECT:
-	      Adjust the angle assuming the original SSV was incorrect.
-	      This means use Snell's law law to adjust angle in a
-	      rotated frame of reference (rotated by null angle) as
-	      ray goes from original SSV to the velocity in the
-	      SVP at the initial depth. This insures that the geometry
-	      of the receiving transducer array is properly handled.
-	 */
-	double vel_ratio;
-	if (ssv_mode == MB_SSV_CORRECT && surface_vel > 0.0) {
-		model->pp = sin(DTR * source_angle) / surface_vel;
-		vel_ratio = MIN(1.0, model->pp * model->vv_source);
-		source_angle = asin(vel_ratio) * RTD;
-	}
-	else if (ssv_mode == MB_SSV_INCORRECT && surface_vel > 0.0) {
-		double diff_angle = source_angle - null_angle;
-		model->pp = sin(DTR * diff_angle) / surface_vel;
-		vel_ratio = MIN(1.0, model->pp * model->vv_source);
-		diff_angle = asin(vel_ratio) * RTD;
-		source_angle = null_angle + diff_angle;
-	}
-  // else do nothing
+	/* reset takeoff angle because of surface sound velocity change */
+	source_angle = mb_rt_ssv_angle(ssv_mode, surface_vel, null_angle, ray->vv_source, source_angle);
 
 	/* now initialize ray */
 	if (source_angle > 0.0)
-		model->sign_x = 1;
+		ray->sign_x = 1;
 	else
-		model->sign_x = -1;
+		ray->sign_x = -1;
 	source_angle = fabs(source_angle);
-	model->pp = sin(DTR * source_angle) / model->vv_source;
+	ray->pp = sin(DTR * source_angle) / ray->vv_source;
 	if (source_angle < 90.0) {
-		model->turned = false;
-		model->ray_status = MB_RT_DOWN;
+		ray->turned = false;
+		ray->ray_status = MB_RT_DOWN;
 	}
 	else {
-		model->turned = true;
-		model->ray_status = MB_RT_UP;
+		ray->turned = true;
+		ray->ray_status = MB_RT_UP;
 	}
-	model->xx = 0.0;
-	model->zz = source_depth;
-	model->tt = 0.0;
-	model->tt_left = end_time;
-	model->outofbounds = false;
-	model->done = false;
+	ray->xx = 0.0;
+	ray->zz = source_depth;
+	ray->tt = 0.0;
+	ray->tt_left = end_time;
+	ray->outofbounds = false;
+	ray->done = false;
 
 	/* set up raypath plotting */
 	if (nplot_max > 0) {
-		model->plot_mode = MB_RT_PLOT_MODE_ON;
-		model->number_plot_max = nplot_max;
+		ray->plot_mode = MB_RT_PLOT_MODE_ON;
+		ray->number_plot_max = nplot_max;
 	}
 	else if (nplot_max < 0) {
-		model->plot_mode = MB_RT_PLOT_MODE_TABLE;
-		model->number_plot_max = -nplot_max;
+		ray->plot_mode = MB_RT_PLOT_MODE_TABLE;
+		ray->number_plot_max = -nplot_max;
 	}
 	else {
-		model->plot_mode = MB_RT_PLOT_MODE_OFF;
-		model->number_plot_max = nplot_max;
-	}
-	model->number_plot = 0;
-	if (model->number_plot_max > 0) {
-		model->xx_plot = xplot;
-		model->xx_plot[0] = model->xx;
-		if (model->plot_mode == MB_RT_PLOT_MODE_ON) {
-			model->zz_plot = zplot;
-			model->zz_plot[0] = model->zz;
-			model->tt_plot = tplot;
-			model->tt_plot[0] = model->tt;
+		ray->plot_mode = MB_RT_PLOT_MODE_OFF;
+		ray->number_plot_max = nplot_max;
+	}
+	ray->number_plot = 0;
+	if (ray->number_plot_max > 0) {
+		ray->xx_plot = xplot;
+		ray->xx_plot[0] = ray->xx;
+		if (ray->plot_mode == MB_RT_PLOT_MODE_ON) {
+			ray->zz_plot = zplot;
+			ray->zz_plot[0] = ray->zz;
+			ray->tt_plot = tplot;
+			ray->tt_plot[0] = ray->tt;
 		}
-		model->number_plot++;
+		ray->number_plot++;
 	}
 
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  About to trace ray in MB_RT function <%s> called\n", __func__);
-		fprintf(stderr, "dbg2       xx:               %f\n", model->xx);
-		fprintf(stderr, "dbg2       zz:               %f\n", model->zz);
-		fprintf(stderr, "dbg2       tt:               %f\n", model->tt);
-		fprintf(stderr, "dbg2       layer:            %d\n", model->layer);
-		fprintf(stderr, "dbg2       layer_mode:       %d\n", model->layer_mode[model->layer]);
-		fprintf(stderr, "dbg2       vv_source:        %f\n", model->vv_source);
-		fprintf(stderr, "dbg2       pp:               %f\n", model->pp);
-		fprintf(stderr, "dbg2       tt_left:          %f\n", model->tt_left);
+		fprintf(stderr, "dbg2       xx:               %f\n", ray->xx);
+		fprintf(stderr, "dbg2       zz:               %f\n", ray->zz);
+		fprintf(stderr, "dbg2       tt:               %f\n", ray->tt);
+		fprintf(stderr, "dbg2       layer:            %d\n", ray->layer);
+		fprintf(stderr, "dbg2       layer_mode:       %d\n", model->layer_mode[ray->layer]);
+		fprintf(stderr, "dbg2       vv_source:        %f\n", ray->vv_source);
+		fprintf(stderr, "dbg2       pp:               %f\n", ray->pp);
+		fprintf(stderr, "dbg2       tt_left:          %f\n", ray->tt_left);
 	}
 
 	/* trace the ray */
-	while (!model->done && !model->outofbounds) {
-		/* trace ray through current layer */
-		if (model->layer_mode[model->layer] == MB_RT_LAYER_GRADIENT && model->pp > 0.0)
-			status = mb_rt_circular(verbose, modelptr, error);
-		else if (model->layer_mode[model->layer] == MB_RT_LAYER_GRADIENT)
-			status = mb_rt_vertical(verbose, modelptr, error);
-		else
-			status = mb_rt_line(verbose, modelptr, error);
+	status = mb_rt_trace(verbose, model, ray, error);
 
-		/* update ray */
-		model->tt = model->tt + model->dt;
-		if (model->layer < 0) {
-			model->outofbounds = true;
-			model->ray_status = MB_RT_OUT_TOP;
+	/* report results */
+	*x = ray->xx;
+	*z = ray->zz;
+	*travel_time = ray->tt;
+	*ray_stat = ray->ray_status;
+	if (ray->number_plot_max > 0)
+		*nplot = ray->number_plot;
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		if (nplot_max > 0)
+			fprintf(stderr, "dbg2       nplot:      %d\n", *nplot);
+		fprintf(stderr, "dbg2       x:          %f\n", *x);
+		fprintf(stderr, "dbg2       z:          %f\n", *z);
+		fprintf(stderr, "dbg2       travel_time:%f\n", *travel_time);
+		fprintf(stderr, "dbg2       raystat:    %d\n", *ray_stat);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------------*/
+int mb_rt_table_init(int verbose, void *modelptr, double max_time, void **tableptr, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
+		fprintf(stderr, "dbg2       modelptr:         %p\n", (void *)modelptr);
+		fprintf(stderr, "dbg2       max_time:         %f\n", max_time);
+		fprintf(stderr, "dbg2       tableptr:         %p\n", (void *)tableptr);
+	}
+
+	const struct velocity_model *model = (const struct velocity_model *)modelptr;
+
+	/* allocate memory for the table */
+	*tableptr = NULL;
+	int status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mb_rt_table_struct), tableptr, error);
+	struct mb_rt_table_struct *table = (struct mb_rt_table_struct *)*tableptr;
+	if (status == MB_SUCCESS) {
+		memset(table, 0, sizeof(struct mb_rt_table_struct));
+		table->modelptr = modelptr;
+		table->source_depth = model->depth[0];
+		table->vv_source = model->velocity[0];
+		table->nangle = (int)(MB_RT_TABLE_ANGLE_MAX / MB_RT_TABLE_DANGLE + 0.5) + 1;
+		table->ntime = (int)(MIN(MAX(max_time, 0.0), MB_RT_TABLE_TIME_MAX) / MB_RT_TABLE_DTIME) + 2;
+		const size_t nsample = (size_t)table->nangle * table->ntime;
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nsample * sizeof(double), (void **)&table->xx, error);
+		if (status == MB_SUCCESS)
+			status = mb_mallocd(verbose, __FILE__, __LINE__, nsample * sizeof(double), (void **)&table->zz, error);
+		if (status == MB_SUCCESS)
+			status = mb_mallocd(verbose, __FILE__, __LINE__, nsample * sizeof(char), (void **)&table->ray_status, error);
+		if (status == MB_SUCCESS)
+			status = mb_mallocd(verbose, __FILE__, __LINE__, table->nangle * sizeof(int), (void **)&table->nvalid, error);
+		if (status == MB_SUCCESS)
+			status = mb_mallocd(verbose, __FILE__, __LINE__, table->nangle * sizeof(int), (void **)&table->ndown, error);
+		if (status != MB_SUCCESS)
+			mb_rt_table_deall(verbose, tableptr, error);
+	}
+
+	/* trace a fan of rays from the top of the model, sampling the position
+	    of each ray at regular travel time intervals - each ray is traced
+	    onwards from the previous sample so that every layer is traversed
+	    once per ray */
+	if (status == MB_SUCCESS) {
+		for (int iangle = 0; iangle < table->nangle; iangle++) {
+			struct mb_rt_ray_struct ray;
+			memset(&ray, 0, sizeof(struct mb_rt_ray_struct));
+			ray.layer = 0;
+			ray.vv_source = table->vv_source;
+			ray.pp = sin(DTR * iangle * MB_RT_TABLE_DANGLE) / ray.vv_source;
+			ray.sign_x = 1;
+			ray.turned = false;
+			ray.ray_status = MB_RT_DOWN;
+			ray.plot_mode = MB_RT_PLOT_MODE_OFF;
+			ray.xx = 0.0;
+			ray.zz = table->source_depth;
+
+			double *xx = &table->xx[(size_t)iangle * table->ntime];
+			double *zz = &table->zz[(size_t)iangle * table->ntime];
+			char *ray_status = &table->ray_status[(size_t)iangle * table->ntime];
+			xx[0] = ray.xx;
+			zz[0] = ray.zz;
+			ray_status[0] = ray.ray_status;
+			table->ndown[iangle] = 1;
+			int itime = 1;
+			for (; itime < table->ntime; itime++) {
+				ray.tt_left = MB_RT_TABLE_DTIME;
+				ray.done = false;
+				mb_rt_trace(verbose, model, &ray, error);
+				if (ray.outofbounds)
+					break;
+				xx[itime] = ray.xx;
+				zz[itime] = ray.zz;
+				ray_status[itime] = ray.ray_status;
+				if (!ray.turned)
+					table->ndown[iangle] = itime + 1;
+			}
+			table->nvalid[iangle] = itime;
 		}
-		if (model->layer >= model->number_layer) {
-			model->outofbounds = true;
-			model->ray_status = MB_RT_OUT_BOTTOM;
+	}
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       tableptr:   %p\n", (void *)*tableptr);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------------*/
+int mb_rt_table_deall(int verbose, void **tableptr, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
+		fprintf(stderr, "dbg2       tableptr:         %p\n", (void *)tableptr);
+	}
+
+	/* deallocate memory for the table */
+	int status = MB_SUCCESS;
+	struct mb_rt_table_struct *table = (struct mb_rt_table_struct *)*tableptr;
+	if (table != NULL) {
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&table->xx, error);
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&table->zz, error);
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&table->ray_status, error);
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&table->nvalid, error);
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&table->ndown, error);
+		status = mb_freed(verbose, __FILE__, __LINE__, tableptr, error);
+	}
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------------*/
+static bool mb_rt_table_column(const struct mb_rt_table_struct *table, int iangle, double source_depth, double end_time,
+                               double *x, double *z, int *ray_stat) {
+	const double *xx = &table->xx[(size_t)iangle * table->ntime];
+	const double *zz = &table->zz[(size_t)iangle * table->ntime];
+
+	/* find the time and offset at which the tabulated ray reaches the
+	    source depth while still going down */
+	double time_source = 0.0;
+	double x_source = 0.0;
+	if (source_depth > table->source_depth) {
+		int lo = 0;
+		int hi = table->ndown[iangle] - 1;
+		if (hi < 1 || zz[hi] < source_depth)
+			return (false);
+		while (hi - lo > 1) {
+			const int mid = (lo + hi) / 2;
+			if (zz[mid] < source_depth)
+				lo = mid;
+			else
+				hi = mid;
 		}
-		if (model->tt_left <= 0.0)
-			model->done = true;
+		const double factor = (source_depth - zz[lo]) / (zz[hi] - zz[lo]);
+		time_source = (lo + factor) * MB_RT_TABLE_DTIME;
+		x_source = xx[lo] + factor * (xx[hi] - xx[lo]);
+	}
 
-		if (verbose >= 2) {
-			fprintf(stderr, "\ndbg2  model->done with ray iteration in MB_RT function <%s>\n", __func__);
-			fprintf(stderr, "dbg2       xx:               %f\n", model->xx);
-			fprintf(stderr, "dbg2       zz:               %f\n", model->zz);
-			fprintf(stderr, "dbg2       xf:               %f\n", model->xf);
-			fprintf(stderr, "dbg2       zf:               %f\n", model->zf);
-			fprintf(stderr, "dbg2       layer:            %d\n", model->layer);
-			fprintf(stderr, "dbg2       layer_mode:       %d\n", model->layer_mode[model->layer]);
-			fprintf(stderr, "dbg2       tt:               %f\n", model->tt);
-			fprintf(stderr, "dbg2       dt:               %f\n", model->dt);
-			fprintf(stderr, "dbg2       tt_left:          %f\n", model->tt_left);
+	/* interpolate the tabulated ray at the end time */
+	const double ftime = (time_source + end_time) / MB_RT_TABLE_DTIME;
+	const int itime = (int)ftime;
+	if (itime < 0 || itime + 1 >= table->nvalid[iangle])
+		return (false);
+	const double factor = ftime - itime;
+	*x = xx[itime] + factor * (xx[itime + 1] - xx[itime]) - x_source;
+	*z = zz[itime] + factor * (zz[itime + 1] - zz[itime]);
+	*ray_stat = table->ray_status[(size_t)iangle * table->ntime + itime + 1];
+
+	return (true);
+}
+/*--------------------------------------------------------------------------*/
+int mb_rt_table(int verbose, void *tableptr, double source_depth, double source_angle, double end_time, int ssv_mode,
+                double surface_vel, double null_angle, double *x, double *z, double *travel_time, int *ray_stat, int *error) {
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
+		fprintf(stderr, "dbg2       tableptr:         %p\n", (void *)tableptr);
+		fprintf(stderr, "dbg2       source_depth:     %f\n", source_depth);
+		fprintf(stderr, "dbg2       source_angle:     %f\n", source_angle);
+		fprintf(stderr, "dbg2       end_time:         %f\n", end_time);
+		fprintf(stderr, "dbg2       ssv_mode:         %d\n", ssv_mode);
+		fprintf(stderr, "dbg2       surface_vel:      %f\n", surface_vel);
+		fprintf(stderr, "dbg2       null_angle:       %f\n", null_angle);
+	}
+
+	const struct mb_rt_table_struct *table = (const struct mb_rt_table_struct *)tableptr;
+	const struct velocity_model *model = (const struct velocity_model *)table->modelptr;
+	int status = MB_SUCCESS;
+	bool found = false;
+
+	/* find the layer holding the source and the velocity at the source */
+	int layer = -1;
+	if (source_depth >= model->depth[0] && source_depth <= model->depth[model->number_node - 1]) {
+		int lo = 0;
+		int hi = model->number_layer - 1;
+		while (hi > lo) {
+			const int mid = (lo + hi + 1) / 2;
+			if (model->layer_depth_top[mid] <= source_depth)
+				lo = mid;
+			else
+				hi = mid - 1;
 		}
+		layer = lo;
+	}
 
-		/* reset position */
-		model->xx = model->xf;
-		model->zz = model->zf;
+	/* get the ray parameter and the equivalent takeoff angle at the top of
+	    the model, and interpolate between the two bracketing table rays */
+	if (layer >= 0 && end_time >= 0.0) {
+		const double vv_source =
+		    model->layer_vel_top[layer] + model->layer_gradient[layer] * (source_depth - model->layer_depth_top[layer]);
+		const double angle = fabs(mb_rt_ssv_angle(ssv_mode, surface_vel, null_angle, vv_source, source_angle));
+		if (angle < 90.0) {
+			const double pp = sin(DTR * angle) / vv_source;
+			const double sin_top = pp * table->vv_source;
+			if (sin_top <= sin(DTR * MB_RT_TABLE_ANGLE_MAX)) {
+				const double fangle = asin(sin_top) * RTD / MB_RT_TABLE_DANGLE;
+				const int iangle = MIN((int)fangle, table->nangle - 2);
+				const double factor = fangle - iangle;
+				double x0, z0, x1, z1;
+				int ray_stat0, ray_stat1;
+				if (mb_rt_table_column(table, iangle, source_depth, end_time, &x0, &z0, &ray_stat0) &&
+				    mb_rt_table_column(table, iangle + 1, source_depth, end_time, &x1, &z1, &ray_stat1)) {
+					*x = x0 + factor * (x1 - x0);
+					*z = z0 + factor * (z1 - z0);
+					*travel_time = end_time;
+					*ray_stat = factor < 0.5 ? ray_stat0 : ray_stat1;
+					*error = MB_ERROR_NO_ERROR;
+					found = true;
+				}
+			}
+		}
 	}
 
-	/* report results */
-	*x = model->xx;
-	*z = model->zz;
-	*travel_time = model->tt;
-	*ray_stat = model->ray_status;
-	if (model->number_plot_max > 0)
-		*nplot = model->number_plot;
+	/* rays outside the table are traced directly */
+	if (!found) {
+		status = mb_rt(verbose, table->modelptr, source_depth, source_angle, end_time, ssv_mode, surface_vel, null_angle, 0,
+		               NULL, NULL, NULL, NULL, x, z, travel_time, ray_stat, error);
+	}
 
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return values:\n");
-		if (nplot_max > 0)
-			fprintf(stderr, "dbg2       nplot:      %d\n", *nplot);
 		fprintf(stderr, "dbg2       x:          %f\n", *x);
 		fprintf(stderr, "dbg2       z:          %f\n", *z);
 		fprintf(stderr, "dbg2       travel_time:%f\n", *travel_time);
@@ -30,7 +30,8 @@
  *   Numerical Recipies in C: the Art of Scientific Computing,
  *   Cambridge University Press, 1988.
  * The 1D linear interpolation routine is homegrown, but mimics the
- * spline routines in usage.
+ * spline routines in usage, and reuses the interval found by the
+ * previous call when it can.
  *
  * Author:	D. W. Caress
  * Date:	October 11, 2000
@@ -168,7 +169,41 @@ int mb_spline_interp(int verbose, const double *xa, const double *ya, double *y2
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-// TODO(schwehr): What is the semantic meaning of the args?  i appears to be output only.
+/* find the interval klo such that xa[klo] <= x < xa[klo + 1] for the
+ * unit offset model arrays used by the mb_linear_interp functions, with
+ * xa[1] < x < xa[n]. The interval klo_prev found by the previous call
+ * and the interval following it are checked first so that a sequence
+ * of calls with increasing x costs O(1) per call, with a bisection
+ * search used otherwise. */
+static int mb_linear_interp_search(const double *xa, int n, double x, int klo_prev) {
+	if (klo_prev >= 1 && klo_prev < n && xa[klo_prev] <= x) {
+		if (x < xa[klo_prev + 1])
+			return (klo_prev);
+		if (klo_prev + 1 < n && x < xa[klo_prev + 2])
+			return (klo_prev + 1);
+	}
+
+	int klo = 1;
+	int khi = n;
+	while (khi - klo > 1) {
+		const int k = (khi + klo) >> 1;
+		if (xa[k] > x)
+			khi = k;
+		else
+			klo = k;
+	}
+	if (klo == n)
+		klo = n - 1;
+	return (klo);
+}
+/*--------------------------------------------------------------------*/
+/* The mb_linear_interp functions interpolate the unit offset model
+ * xa[1..n], ya[1..n] at x. On return *i holds the index of the model
+ * interval used. On input *i is treated as a hint: if it still holds
+ * the value returned by a previous call on the same model the search
+ * starts from that interval, so callers stepping through a model in
+ * time order should keep passing the same variable. Any other value
+ * just results in a bisection search. */
 int mb_linear_interp(int verbose, const double *xa, const double *ya, int n, double x, double *y, int *i, int *error) {
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
@@ -204,19 +239,8 @@ int mb_linear_interp(int verbose, const double *xa, const double *ya, int n, dou
 		}
 		/* in range of model so linearly interpolate */
 		else {
-			int klo = 1;
-			int khi = n;
-			while (khi - klo > 1) {
-				const int k = (khi + klo) >> 1;
-				if (xa[k] > x)
-					khi = k;
-				else
-					klo = k;
-			}
-			if (khi == 1)
-				khi = 2;
-			if (klo == n)
-				klo = n - 1;
+			const int klo = mb_linear_interp_search(xa, n, x, *i);
+			const int khi = klo + 1;
 			const double h = xa[khi] - xa[klo];
 			const double b = (ya[khi] - ya[klo]) / h;
 			*y = ya[klo] + b * (x - xa[klo]);
@@ -270,19 +294,8 @@ int mb_linear_interp_longitude(int verbose, const double *xa, const double *ya,
 		}
 		/* in range of model so linearly interpolate */
 		else {
-			int klo = 1;
-			int khi = n;
-			while (khi - klo > 1) {
-				const int k = (khi + klo) >> 1;
-				if (xa[k] > x)
-					khi = k;
-				else
-					klo = k;
-			}
-			if (khi == 1)
-				khi = 2;
-			if (klo == n)
-				klo = n - 1;
+			const int klo = mb_linear_interp_search(xa, n, x, *i);
+			const int khi = klo + 1;
 			const double h = xa[khi] - xa[klo];
 			double yahi = ya[khi];
 			const double yalo = ya[klo];
@@ -346,19 +359,8 @@ int mb_linear_interp_latitude(int verbose, const double *xa, const double *ya, i
 		}
 		/* in range of model so linearly interpolate */
 		else {
-			int klo = 1;
-			int khi = n;
-			while (khi - klo > 1) {
-				const int k = (khi + klo) >> 1;
-				if (xa[k] > x)
-					khi = k;
-				else
-					klo = k;
-			}
-			if (khi == 1)
-				khi = 2;
-			if (klo == n)
-				klo = n - 1;
+			const int klo = mb_linear_interp_search(xa, n, x, *i);
+			const int khi = klo + 1;
 			const double h = xa[khi] - xa[klo];
 			const double yahi = ya[khi];
 			const double yalo = ya[klo];
@@ -418,19 +420,8 @@ int mb_linear_interp_heading(int verbose, const double *xa, const double *ya, in
 		}
 		/* in range of model so linearly interpolate */
 		else {
-			int klo = 1;
-			int khi = n;
-			while (khi - klo > 1) {
-				const int k = (khi + klo) >> 1;
-				if (xa[k] > x)
-					khi = k;
-				else
-					klo = k;
-			}
-			if (khi == 1)
-				khi = 2;
-			if (klo == n)
-				klo = n - 1;
+			const int klo = mb_linear_interp_search(xa, n, x, *i);
+			const int khi = klo + 1;
 			const double h = xa[khi] - xa[klo];
 			double yahi = ya[khi];
 			const double yalo = ya[klo];
@@ -177,6 +177,7 @@ int mb_write_init(int verbose, char *file, int format, void **mbio_ptr, int *bea
 
 	/* initialize projection parameters */
 	mb_io_ptr->projection_initialized = false;
+	mb_io_ptr->projection_cached = false;
 	mb_io_ptr->pjptr = NULL;
 
 	/* initialize ancillary variables used
@@ -544,10 +545,15 @@ int mb_write_init(int verbose, char *file, int format, void **mbio_ptr, int *bea
 
 	/* initialize variables for interpolating asynchronous data */
 	mb_io_ptr->nfix = 0;
+	mb_io_ptr->fix_cursor = 0;
 	mb_io_ptr->nattitude = 0;
+	mb_io_ptr->attitude_cursor = 0;
 	mb_io_ptr->nheading = 0;
+	mb_io_ptr->heading_cursor = 0;
 	mb_io_ptr->nsensordepth = 0;
+	mb_io_ptr->sensordepth_cursor = 0;
 	mb_io_ptr->naltitude = 0;
+	mb_io_ptr->altitude_cursor = 0;
 	for (int i = 0; i < MB_ASYNCH_SAVE_MAX; i++) {
 		mb_io_ptr->fix_time_d[i] = 0.0;
 		mb_io_ptr->fix_lon[i] = 0.0;
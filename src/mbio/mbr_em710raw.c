@@ -3091,6 +3091,7 @@ int mbr_em710raw_rd_bath2(int verbose, void *mbio_ptr, int swap, struct mbsys_si
                           int *goodend, int *error) {
 	struct mbsys_simrad3_ping_struct *ping;
 	char line[EM3_BATH2_HEADER_SIZE];
+	char beams[MBSYS_SIMRAD3_MAXBEAMS * EM3_BATH2_BEAM_SIZE];
 	short short_val = 0;
 	float float_val = 0.0;
 	int int_val = 0;
@@ -3212,24 +3213,22 @@ int mbr_em710raw_rd_bath2(int verbose, void *mbio_ptr, int swap, struct mbsys_si
 
 	/* read binary beam values */
 	if (status == MB_SUCCESS) {
-		for (int i = 0; i < ping->png_nbeams && status == MB_SUCCESS; i++) {
-			read_len = (size_t)EM3_BATH2_BEAM_SIZE;
-			status = mb_fileio_get(verbose, mbio_ptr, (char *)line, &read_len, error);
-			if (status == MB_SUCCESS && i < MBSYS_SIMRAD3_MAXBEAMS) {
-				mb_get_binary_float(swap, &line[0], &float_val);
-				ping->png_depth[i] = float_val;
-				mb_get_binary_float(swap, &line[4], &float_val);
-				ping->png_acrosstrack[i] = float_val;
-				mb_get_binary_float(swap, &line[8], &float_val);
-				ping->png_alongtrack[i] = float_val;
-				mb_get_binary_short(swap, &line[12], &short_val);
-				ping->png_window[i] = (int)((unsigned short)short_val);
-				ping->png_quality[i] = (int)((mb_u_char)line[14]);
-				ping->png_iba[i] = (int)((mb_s_char)line[15]);
-				ping->png_detection[i] = (int)((mb_u_char)line[16]);
-				ping->png_clean[i] = (int)((mb_s_char)line[17]);
-				mb_get_binary_short(swap, &line[18], &short_val);
-				ping->png_amp[i] = (int)short_val;
+		read_len = (size_t)(ping->png_nbeams * EM3_BATH2_BEAM_SIZE);
+		if (read_len > 0)
+			status = mb_fileio_get(verbose, mbio_ptr, beams, &read_len, error);
+		if (status == MB_SUCCESS) {
+			const int nbeams = ping->png_nbeams;
+			mb_get_binary_float_strided(swap, nbeams, &beams[0], EM3_BATH2_BEAM_SIZE, ping->png_depth, sizeof(float));
+			mb_get_binary_float_strided(swap, nbeams, &beams[4], EM3_BATH2_BEAM_SIZE, ping->png_acrosstrack, sizeof(float));
+			mb_get_binary_float_strided(swap, nbeams, &beams[8], EM3_BATH2_BEAM_SIZE, ping->png_alongtrack, sizeof(float));
+			mb_get_binary_short_int_strided(swap, true, nbeams, &beams[12], EM3_BATH2_BEAM_SIZE, ping->png_window, sizeof(int));
+			mb_get_binary_short_int_strided(swap, false, nbeams, &beams[18], EM3_BATH2_BEAM_SIZE, ping->png_amp, sizeof(int));
+			for (int i = 0; i < nbeams; i++) {
+				const char *beam = &beams[i * EM3_BATH2_BEAM_SIZE];
+				ping->png_quality[i] = (int)((mb_u_char)beam[14]);
+				ping->png_iba[i] = (int)((mb_s_char)beam[15]);
+				ping->png_detection[i] = (int)((mb_u_char)beam[16]);
+				ping->png_clean[i] = (int)((mb_s_char)beam[17]);
 			}
 		}
 	}
@@ -3302,6 +3301,7 @@ int mbr_em710raw_rd_rawbeam4(int verbose, void *mbio_ptr, int swap, struct mbsys
                              int *error) {
 	struct mbsys_simrad3_ping_struct *ping;
 	char line[EM3_RAWBEAM4_HEADER_SIZE];
+	char beams[MBSYS_SIMRAD3_MAXBEAMS * EM3_RAWBEAM4_BEAM_SIZE];
 	short short_val = 0;
 	int int_val = 0;
 	float float_val = 0.0;
@@ -3431,24 +3431,26 @@ int mbr_em710raw_rd_rawbeam4(int verbose, void *mbio_ptr, int swap, struct mbsys
 
 	/* read binary beam values */
 	if (status == MB_SUCCESS) {
-		for (int i = 0; i < ping->png_raw_nbeams && status == MB_SUCCESS; i++) {
-			read_len = (size_t)EM3_RAWBEAM4_BEAM_SIZE;
-			status = mb_fileio_get(verbose, mbio_ptr, (char *)line, &read_len, error);
-			if (status == MB_SUCCESS && i < MBSYS_SIMRAD3_MAXBEAMS) {
-				mb_get_binary_short(swap, &line[0], &short_val);
-				ping->png_raw_rxpointangle[i] = (int)short_val;
-				ping->png_raw_rxsector[i] = (mb_u_char)line[2];
-				ping->png_raw_rxdetection[i] = (mb_u_char)line[3];
-				mb_get_binary_short(swap, &line[4], &short_val);
-				ping->png_raw_rxwindow[i] = (int)((unsigned short)short_val);
-				ping->png_raw_rxquality[i] = (mb_u_char)line[6];
-				ping->png_raw_rxspare1[i] = (mb_s_char)line[7];
-				mb_get_binary_float(swap, &line[8], &float_val);
-				ping->png_raw_rxrange[i] = float_val;
-				mb_get_binary_short(swap, &line[12], &short_val);
-				ping->png_raw_rxamp[i] = (int)((short)short_val);
-				ping->png_raw_rxcleaning[i] = (mb_s_char)line[14];
-				ping->png_raw_rxspare2[i] = (mb_u_char)line[15];
+		read_len = (size_t)(ping->png_raw_nbeams * EM3_RAWBEAM4_BEAM_SIZE);
+		if (status == MB_SUCCESS && read_len > 0)
+			status = mb_fileio_get(verbose, mbio_ptr, beams, &read_len, error);
+		if (status == MB_SUCCESS) {
+			const int nbeams = ping->png_raw_nbeams;
+			mb_get_binary_short_int_strided(swap, false, nbeams, &beams[0], EM3_RAWBEAM4_BEAM_SIZE, ping->png_raw_rxpointangle,
+			                                sizeof(int));
+			mb_get_binary_short_int_strided(swap, true, nbeams, &beams[4], EM3_RAWBEAM4_BEAM_SIZE, ping->png_raw_rxwindow,
+			                                sizeof(int));
+			mb_get_binary_float_strided(swap, nbeams, &beams[8], EM3_RAWBEAM4_BEAM_SIZE, ping->png_raw_rxrange, sizeof(float));
+			mb_get_binary_short_int_strided(swap, false, nbeams, &beams[12], EM3_RAWBEAM4_BEAM_SIZE, ping->png_raw_rxamp,
+			                                sizeof(int));
+			for (int i = 0; i < nbeams; i++) {
+				const char *beam = &beams[i * EM3_RAWBEAM4_BEAM_SIZE];
+				ping->png_raw_rxsector[i] = (mb_u_char)beam[2];
+				ping->png_raw_rxdetection[i] = (mb_u_char)beam[3];
+				ping->png_raw_rxquality[i] = (mb_u_char)beam[6];
+				ping->png_raw_rxspare1[i] = (mb_s_char)beam[7];
+				ping->png_raw_rxcleaning[i] = (mb_s_char)beam[14];
+				ping->png_raw_rxspare2[i] = (mb_u_char)beam[15];
 			}
 		}
 
@@ -3722,6 +3724,7 @@ int mbr_em710raw_rd_ss2(int verbose, void *mbio_ptr, int swap, struct mbsys_simr
                         int *error) {
 	struct mbsys_simrad3_ping_struct *ping;
 	char line[EM3_SS2_HEADER_SIZE];
+	char beams[MBSYS_SIMRAD3_MAXBEAMS * EM3_SS2_BEAM_SIZE];
 	short short_val = 0;
 	float float_val = 0.0;
 	size_t read_len;
@@ -3831,25 +3834,25 @@ int mbr_em710raw_rd_ss2(int verbose, void *mbio_ptr, int swap, struct mbsys_simr
 	/* read binary beam values */
 	if (status == MB_SUCCESS) {
 		ping->png_npixels = 0;
+		read_len = (size_t)(ping->png_nbeams_ss * EM3_SS2_BEAM_SIZE);
+		if (read_len > 0)
+			status = mb_fileio_get(verbose, mbio_ptr, beams, &read_len, error);
+		if (status == MB_SUCCESS) {
+			mb_get_binary_short_int_strided(swap, true, ping->png_nbeams_ss, &beams[2], EM3_SS2_BEAM_SIZE, ping->png_beam_samples,
+			                                sizeof(int));
+			mb_get_binary_short_int_strided(swap, true, ping->png_nbeams_ss, &beams[4], EM3_SS2_BEAM_SIZE,
+			                                ping->png_center_sample, sizeof(int));
+		}
 		for (int i = 0; i < ping->png_nbeams_ss && status == MB_SUCCESS; i++) {
-			read_len = (size_t)EM3_SS2_BEAM_SIZE;
-			status = mb_fileio_get(verbose, mbio_ptr, (char *)line, &read_len, error);
-			if (status == MB_SUCCESS && i < MBSYS_SIMRAD3_MAXBEAMS) {
-				status = MB_SUCCESS;
-				ping->png_sort_direction[i] = (mb_s_char)line[0];
-				ping->png_ssdetection[i] = (mb_u_char)line[1];
-				mb_get_binary_short(swap, &line[2], &short_val);
-				ping->png_beam_samples[i] = (int)((unsigned short)short_val);
-				mb_get_binary_short(swap, &line[4], &short_val);
-				ping->png_center_sample[i] = (int)((unsigned short)short_val);
-
-				ping->png_start_sample[i] = ping->png_npixels;
-				ping->png_npixels += ping->png_beam_samples[i];
-				if (ping->png_npixels > MBSYS_SIMRAD3_MAXRAWPIXELS) {
-					ping->png_beam_samples[i] -= (ping->png_npixels - MBSYS_SIMRAD3_MAXRAWPIXELS);
-					if (ping->png_beam_samples[i] < 0)
-						ping->png_beam_samples[i] = 0;
-				}
+			ping->png_sort_direction[i] = (mb_s_char)beams[i * EM3_SS2_BEAM_SIZE];
+			ping->png_ssdetection[i] = (mb_u_char)beams[i * EM3_SS2_BEAM_SIZE + 1];
+
+			ping->png_start_sample[i] = ping->png_npixels;
+			ping->png_npixels += ping->png_beam_samples[i];
+			if (ping->png_npixels > MBSYS_SIMRAD3_MAXRAWPIXELS) {
+				ping->png_beam_samples[i] -= (ping->png_npixels - MBSYS_SIMRAD3_MAXRAWPIXELS);
+				if (ping->png_beam_samples[i] < 0)
+					ping->png_beam_samples[i] = 0;
 			}
 		}
 
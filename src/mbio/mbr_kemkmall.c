@@ -1814,7 +1814,7 @@ int mbr_kemkmall_rd_sha(int verbose, char *buffer, void *store_ptr, void *header
 
 /*--------------------------------------------------------------------*/
 
-int mbr_kemkmall_rd_mrz(int verbose, char *buffer, void *store_ptr, void *header_ptr, int *imrz, int *error) {
+int mbr_kemkmall_rd_mrz(int verbose, char *buffer, void *store_ptr, void *header_ptr, long file_pos, int *imrz, int *error) {
 
   if (verbose >= 2) {
     fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
@@ -1823,6 +1823,7 @@ int mbr_kemkmall_rd_mrz(int verbose, char *buffer, void *store_ptr, void *header
     fprintf(stderr, "dbg2       buffer:     %p\n", (void *) buffer);
     fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *) store_ptr);
     fprintf(stderr, "dbg2       header_ptr: %p\n", (void *)header_ptr);
+    fprintf(stderr, "dbg2       file_pos:   %ld\n", file_pos);
   }
 
   int status = MB_SUCCESS;
@@ -2259,112 +2260,110 @@ int mbr_kemkmall_rd_mrz(int verbose, char *buffer, void *store_ptr, void *header
     /* EMdgmMRZ_sounding - Data for each sounding */
     int numSidescanSamples = 0;
     int numSoundings = mrz->rxInfo.numSoundingsMaxMain + mrz->rxInfo.numExtraDetections;
-    for (int i = 0; i<numSoundings; i++)
-    {
-    /* calculate index at start of of each sounding using pingInfo.numBytesPerTxSector
+
+    /* decode each binary field for all of the soundings at once, using
+        rxInfo.numBytesPerSounding as the record stride
         - this avoids breaking the decoding if fields have been added to sounding */
+    const size_t sounding_stride = mrz->rxInfo.numBytesPerSounding;
+    const size_t sounding_size = sizeof(mrz->sounding[0]);
+    struct mbsys_kmbes_mrz_sounding *sounding = &mrz->sounding[0];
+    for (int i = 0; i < numSoundings; i++) {
       index = index_sounding + i * mrz->rxInfo.numBytesPerSounding;
-
-      mb_get_binary_short(true, &buffer[index], &(mrz->sounding[i].soundingIndex));
-      index += 2;
-      mrz->sounding[i].txSectorNumb = buffer[index];
-      index++;
+      mrz->sounding[i].txSectorNumb = buffer[index + 2];
 
       /* Detection info. */
-      mrz->sounding[i].detectionType = buffer[index];
-      index++;
-      mrz->sounding[i].detectionMethod = buffer[index];
-      index++;
-      mrz->sounding[i].rejectionInfo1 = buffer[index];
-      index++;
-      mrz->sounding[i].rejectionInfo2 = buffer[index];
-      index++;
-      mrz->sounding[i].postProcessingInfo = buffer[index];
-      index++;
-      mrz->sounding[i].detectionClass = buffer[index];
-      index++;
-      mrz->sounding[i].detectionConfidenceLevel = buffer[index];
-      index++;
+      mrz->sounding[i].detectionType = buffer[index + 3];
+      mrz->sounding[i].detectionMethod = buffer[index + 4];
+      mrz->sounding[i].rejectionInfo1 = buffer[index + 5];
+      mrz->sounding[i].rejectionInfo2 = buffer[index + 6];
+      mrz->sounding[i].postProcessingInfo = buffer[index + 7];
+      mrz->sounding[i].detectionClass = buffer[index + 8];
+      mrz->sounding[i].detectionConfidenceLevel = buffer[index + 9];
       /* These two bytes specified as padding in the Kongsberg specification but are
          here used for the MB-System beam flag - if the first mb_u_char == 1 then the
          second byte is an MB-System beamflag */
-      // mb_get_binary_short(true, &buffer[index], &(mrz->sounding[i].padding));
-      // index += 2;
-      mrz->sounding[i].beamflag_enabled = buffer[index];
-      index++;
-      mrz->sounding[i].beamflag = buffer[index];
-      index++;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].rangeFactor));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].qualityFactor));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].detectionUncertaintyVer_m));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].detectionUncertaintyHor_m));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].detectionWindowLength_sec));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].echoLength_sec));
-      index += 4;
+      mrz->sounding[i].beamflag_enabled = buffer[index + 10];
+      mrz->sounding[i].beamflag = buffer[index + 11];
+    }
 
-      /* Water column paramters. */
-      mb_get_binary_short(true, &buffer[index], &(mrz->sounding[i].WCBeamNumb));
-      index += 2;
-      mb_get_binary_short(true, &buffer[index], &(mrz->sounding[i].WCrange_samples));
-      index += 2;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].WCNomBeamAngleAcross_deg));
-      index += 4;
+    index = index_sounding;
+    mb_get_binary_short_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->soundingIndex), sounding_size);
+    index += 2;
 
-      /* Reflectivity data (backscatter (BS) data). */
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].meanAbsCoeff_dBPerkm));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].reflectivity1_dB));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].reflectivity2_dB));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].receiverSensitivityApplied_dB));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].sourceLevelApplied_dB));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].BScalibration_dB));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].TVG_dB));
-      index += 4;
+    /* txSectorNumb, detection info and beamflag bytes (decoded above) */
+    index += 10;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->rangeFactor), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->qualityFactor), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->detectionUncertaintyVer_m), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->detectionUncertaintyHor_m), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->detectionWindowLength_sec), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->echoLength_sec), sounding_size);
+    index += 4;
 
-      /* Range and angle data. */
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].beamAngleReRx_deg));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].beamAngleCorrection_deg));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].twoWayTravelTime_sec));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].twoWayTravelTimeCorrection_sec));
-      index += 4;
+    /* Water column paramters. */
+    mb_get_binary_short_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->WCBeamNumb), sounding_size);
+    index += 2;
+    mb_get_binary_short_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->WCrange_samples), sounding_size);
+    index += 2;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->WCNomBeamAngleAcross_deg), sounding_size);
+    index += 4;
 
-      /* Georeferenced depth points. */
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].deltaLatitude_deg));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].deltaLongitude_deg));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].z_reRefPoint_m));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].y_reRefPoint_m));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].x_reRefPoint_m));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(mrz->sounding[i].beamIncAngleAdj_deg));
-      index += 4;
-      mb_get_binary_short(true, &buffer[index], &(mrz->sounding[i].realTimeCleanInfo));
-      index += 2;
+    /* Reflectivity data (backscatter (BS) data). */
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->meanAbsCoeff_dBPerkm), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->reflectivity1_dB), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->reflectivity2_dB), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->receiverSensitivityApplied_dB), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->sourceLevelApplied_dB), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->BScalibration_dB), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->TVG_dB), sounding_size);
+    index += 4;
 
-      /* Seabed image. */
-      mb_get_binary_short(true, &buffer[index], &(mrz->sounding[i].SIstartRange_samples));
-      index += 2;
-      mb_get_binary_short(true, &buffer[index], &(mrz->sounding[i].SIcentreSample));
-      index += 2;
-      mb_get_binary_short(true, &buffer[index], &(mrz->sounding[i].SInumSamples));
-      index += 2;
+    /* Range and angle data. */
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->beamAngleReRx_deg), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->beamAngleCorrection_deg), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->twoWayTravelTime_sec), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->twoWayTravelTimeCorrection_sec), sounding_size);
+    index += 4;
+
+    /* Georeferenced depth points. */
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->deltaLatitude_deg), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->deltaLongitude_deg), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->z_reRefPoint_m), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->y_reRefPoint_m), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->x_reRefPoint_m), sounding_size);
+    index += 4;
+    mb_get_binary_float_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->beamIncAngleAdj_deg), sounding_size);
+    index += 4;
+    mb_get_binary_short_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->realTimeCleanInfo), sounding_size);
+    index += 2;
+
+    /* Seabed image. */
+    mb_get_binary_short_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->SIstartRange_samples), sounding_size);
+    index += 2;
+    mb_get_binary_short_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->SIcentreSample), sounding_size);
+    index += 2;
+    mb_get_binary_short_strided(true, numSoundings, &buffer[index], sounding_stride, &(sounding->SInumSamples), sounding_size);
+    index += 2;
 
+    for (int i = 0; i < numSoundings; i++) {
       numSidescanSamples += mrz->sounding[i].SInumSamples;
 
       /* calculate beamflag */
@@ -2441,11 +2440,17 @@ int mbr_kemkmall_rd_mrz(int verbose, char *buffer, void *store_ptr, void *header
     index_SIsample = index_sounding + numSoundings * mrz->rxInfo.numBytesPerSounding;
     index = index_SIsample;
 
-    for (int i = 0; i < numSidescanSamples; i++)
-    {
-      mb_get_binary_short(true, &buffer[index], &(mrz->SIsample_desidB[i]));
-      index += 2;
+    /* in lazy decode mode (file_pos >= 0) just copy the seabed image samples as read
+        so that they can be decoded by mbr_kemkmall_rd_deferred_sidescan() if needed */
+    if (file_pos >= 0 && numSidescanSamples > 0) {
+      memcpy(mrz->SIsample_desidB, &buffer[index], 2 * MIN(numSidescanSamples, MBSYS_KMBES_MAX_SIDESCAN_SAMP));
+      mrz->SIsample_deferred = true;
+    }
+    else {
+      mrz->SIsample_deferred = false;
+      mb_get_binary_short_array(true, numSidescanSamples, &buffer[index], mrz->SIsample_desidB);
     }
+    index += 2 * numSidescanSamples;
   }
 
   /* set kind */
@@ -2721,10 +2726,9 @@ int mbr_kemkmall_rd_mwc(int verbose, char *buffer, void *store_ptr, void *header
                 mwc->beamData_p[i].samplePhase16bit_alloc_size = 0;
             }
             if (status == MB_SUCCESS) {
-              for (int k = 0; k<mwc->beamData_p[i].numSampleData; k++) {
-                mb_get_binary_short(true, &buffer[index], &(mwc->beamData_p[i].samplePhase16bit[k]));
-                index += 2;
-              }
+              mb_get_binary_short_array(true, mwc->beamData_p[i].numSampleData, &buffer[index],
+                                        mwc->beamData_p[i].samplePhase16bit);
+              index += 2 * mwc->beamData_p[i].numSampleData;
             }
             break;
         }
@@ -2791,6 +2795,197 @@ int mbr_kemkmall_rd_mwc(int verbose, char *buffer, void *store_ptr, void *header
 
 /*--------------------------------------------------------------------*/
 
+int mbr_kemkmall_rd_mwc_defer(int verbose, char *buffer, void *store_ptr, void *header_ptr, long file_pos, int *imwc, int *error) {
+  struct mbsys_kmbes_mwc *mwc = NULL;
+  struct mbsys_kmbes_m_partition partition;
+  struct mbsys_kmbes_m_body cmnPart;
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       buffer:     %p\n", (void *)buffer);
+    fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+    fprintf(stderr, "dbg2       header_ptr: %p\n", (void *)header_ptr);
+    fprintf(stderr, "dbg2       file_pos:   %ld\n", file_pos);
+  }
+
+  /* get pointer to raw data structure */
+  struct mbsys_kmbes_struct *store = (struct mbsys_kmbes_struct *)store_ptr;
+  struct mbsys_kmbes_header *header = (struct mbsys_kmbes_header *)header_ptr;
+
+  /* get only the partition and common part, which are all that is needed to
+      assemble the ping - the rest of the datagram is decoded from the file
+      by mbr_kemkmall_rd_deferred() if needed */
+  int index = MBSYS_KMBES_HEADER_SIZE;
+
+  /* EMdgmMpartition - data partition information */
+  mb_get_binary_short(true, &buffer[index], &(partition.numOfDgms));
+  index += 2;
+  mb_get_binary_short(true, &buffer[index], &(partition.dgmNum));
+  index += 2;
+
+  /* EMdgmMbody - information of transmitter and receiver used to find data in datagram */
+  mb_get_binary_short(true, &buffer[index], &(cmnPart.numBytesCmnPart));
+  index += 2;
+  mb_get_binary_short(true, &buffer[index], &(cmnPart.pingCnt));
+  index += 2;
+  cmnPart.rxFansPerPing = buffer[index];
+  index++;
+  cmnPart.rxFanIndex = buffer[index];
+  index++;
+  cmnPart.swathsPerPing = buffer[index];
+  index++;
+  cmnPart.swathAlongPosition = buffer[index];
+  index++;
+  cmnPart.txTransducerInd = buffer[index];
+  index++;
+  cmnPart.rxTransducerInd = buffer[index];
+  index++;
+  cmnPart.numRxTransducers = buffer[index];
+  index++;
+  cmnPart.algorithmType = buffer[index];
+  index++;
+
+  /* note which of the MWC datagrams for this ping this is and where it is in the file */
+  *imwc = cmnPart.rxFanIndex;
+  mwc = &store->mwc[cmnPart.rxFanIndex];
+  mwc->header = *header;
+  mwc->partition = partition;
+  mwc->cmnPart = cmnPart;
+  mwc->deferred = true;
+  mwc->deferred_file_pos = file_pos;
+
+  /* set kind - Not MB_DATA_WATER_COLUMN because for this format water column
+     is returned as part of the survey ping */
+  const int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  store->kind = MB_DATA_DATA;
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       imwc:       %d\n", *imwc);
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:  %d\n", status);
+  }
+
+  /* return status */
+  return (status);
+}
+
+/*--------------------------------------------------------------------*/
+
+int mbr_kemkmall_rd_deferred_sidescan(int verbose, void *store_ptr, int *error) {
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+  }
+
+  /* get pointer to raw data structure */
+  struct mbsys_kmbes_struct *store = (struct mbsys_kmbes_struct *)store_ptr;
+
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+
+  /* decode in place any seabed image samples copied undecoded in lazy decode mode */
+  for (int imrz = 0; imrz < MBSYS_KMBES_MAX_NUM_MRZ_DGMS; imrz++) {
+    struct mbsys_kmbes_mrz *mrz = &store->mrz[imrz];
+    if (mrz->SIsample_deferred) {
+      int numSidescanSamples = 0;
+      const int numSoundings = mrz->rxInfo.numSoundingsMaxMain + mrz->rxInfo.numExtraDetections;
+      for (int i = 0; i < numSoundings; i++)
+        numSidescanSamples += mrz->sounding[i].SInumSamples;
+      numSidescanSamples = MIN(numSidescanSamples, MBSYS_KMBES_MAX_SIDESCAN_SAMP);
+      mb_get_binary_short_array(true, numSidescanSamples, mrz->SIsample_desidB, mrz->SIsample_desidB);
+    }
+    mrz->SIsample_deferred = false;
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:  %d\n", status);
+  }
+
+  /* return status */
+  return (status);
+}
+
+/*--------------------------------------------------------------------*/
+
+int mbr_kemkmall_rd_deferred(int verbose, void *store_ptr, int *error) {
+  struct mbsys_kmbes_header header;
+  mbsys_kmbes_emdgm_type emdgm_type;
+  char *buffer = NULL;
+  size_t bufferalloc = 0;
+  int jmwc;
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+  }
+
+  /* get pointer to raw data structure */
+  struct mbsys_kmbes_struct *store = (struct mbsys_kmbes_struct *)store_ptr;
+
+  /* decode any seabed image samples skipped in lazy decode mode */
+  int status = mbr_kemkmall_rd_deferred_sidescan(verbose, store_ptr, error);
+
+  /* decode any MWC datagrams skipped in lazy decode mode, restoring
+      the file position afterwards */
+  for (int imwc = 0; imwc < MBSYS_KMBES_MAX_NUM_MWC_DGMS; imwc++) {
+    struct mbsys_kmbes_mwc *mwc = &store->mwc[imwc];
+    if (status == MB_SUCCESS && mwc->deferred && store->deferred_fp != NULL) {
+      const size_t read_len = (size_t)mwc->header.numBytesDgm;
+      if (bufferalloc < read_len) {
+        status = mb_reallocd(verbose, __FILE__, __LINE__, read_len, (void **)&buffer, error);
+        bufferalloc = status == MB_SUCCESS ? read_len : 0;
+      }
+      if (status == MB_SUCCESS) {
+        const long position = ftell(store->deferred_fp);
+        if (fseek(store->deferred_fp, mwc->deferred_file_pos, SEEK_SET) != 0
+            || fread(buffer, 1, read_len, store->deferred_fp) != read_len) {
+          status = MB_FAILURE;
+          *error = MB_ERROR_EOF;
+        }
+        fseek(store->deferred_fp, position, SEEK_SET);
+      }
+      if (status == MB_SUCCESS)
+        status = mbr_kemkmall_rd_hdr(verbose, buffer, (void *)&header, (void *)&emdgm_type, error);
+      if (status == MB_SUCCESS)
+        status = mbr_kemkmall_rd_mwc(verbose, buffer, store_ptr, (void *)&header, &jmwc, error);
+    }
+    mwc->deferred = false;
+  }
+
+  if (buffer != NULL) {
+    int lerror = MB_ERROR_NO_ERROR;
+    mb_freed(verbose, __FILE__, __LINE__, (void **)&buffer, &lerror);
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:  %d\n", status);
+  }
+
+  /* return status */
+  return (status);
+}
+
+/*--------------------------------------------------------------------*/
+
 int mbr_kemkmall_rd_msc(int verbose, char *buffer, void *store_ptr, void *header_ptr, int *error) {
 
   if (verbose >= 2) {
@@ -4627,10 +4822,21 @@ int mbr_kemkmall_rd_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
     store->n_mrz_read = 0;
     store->n_mwc_read = 0;
     store->msc_read = false;
+    for (int imrz = 0; imrz < MBSYS_KMBES_MAX_NUM_MRZ_DGMS; imrz++)
+      store->mrz[imrz].SIsample_deferred = false;
+    for (int imwc = 0; imwc < MBSYS_KMBES_MAX_NUM_MWC_DGMS; imwc++)
+      store->mwc[imwc].deferred = false;
   }
 
+  /* in lazy decode mode seabed image samples and MWC datagrams are only
+      decoded from the file if needed */
+  const bool lazy_decode = mb_io_ptr->lazy_decode && mb_io_ptr->mbfp != NULL;
+  if (lazy_decode)
+    store->deferred_fp = mb_io_ptr->mbfp;
+
   /* if not done loop over reading data until a record is ready for return */
   while (!done) {
+    bool deferred = false;
 
     // if reading a file then use the index of datagrams
     if (mb_io_ptr->mbfp != NULL) {
@@ -4654,10 +4860,18 @@ int mbr_kemkmall_rd_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
         }
       }
 
+      /* in lazy decode mode read just the start of MWC datagrams */
+      if (lazy_decode && emdgm_type == MWC && read_len > MBSYS_KMBES_MWC_DEFERRED_READSIZE) {
+        deferred = true;
+        read_len = MBSYS_KMBES_MWC_DEFERRED_READSIZE;
+      }
+
       /* read the next datagram */
       if (status == MB_SUCCESS) {
         fseek(mb_io_ptr->mbfp, dgm_index->file_pos, SEEK_SET);
         status = mb_fileio_get(verbose, mbio_ptr, (void *)&buffer[0], &read_len, error);
+        if (deferred)
+          fseek(mb_io_ptr->mbfp, dgm_index->file_pos + dgm_index->header.numBytesDgm, SEEK_SET);
         mb_io_ptr->file_pos = ftell(mb_io_ptr->mbfp);
       }
 
@@ -4836,7 +5050,8 @@ numOfDgms, dgmNum, header.numBytesDgm, dgm_index->index_org, dgm_index->ping_num
         case MRZ:
           /* #MRZ - multibeam data for raw range, depth, reflectivity, seabed image(SI) etc. */
           /*        not done until all MRZ datagrams for a ping are read */
-          status = mbr_kemkmall_rd_mrz(verbose, buffer, store_ptr, (void *)&header, &jmrz, error);
+          status = mbr_kemkmall_rd_mrz(verbose, buffer, store_ptr, (void *)&header,
+                                        lazy_decode ? dgm_index->file_pos : -1, &jmrz, error);
 //fprintf(stderr, "----------->%s:%d PARSE store->mrz[%d].header.numBytesDgm:%d \n",
 //__FILE__, __LINE__, jmrz, store->mrz[jmrz].header.numBytesDgm);
 
@@ -4896,7 +5111,10 @@ numOfDgms, dgmNum, header.numBytesDgm, dgm_index->index_org, dgm_index->ping_num
         case MWC:
           /* #MWC - multibeam water column datagram */
           /*        not done until all MRZ datagrams for a ping are read */
-          status = mbr_kemkmall_rd_mwc(verbose, buffer, store_ptr, (void *)&header, &jmwc, error);
+          if (deferred)
+            status = mbr_kemkmall_rd_mwc_defer(verbose, buffer, store_ptr, (void *)&header, dgm_index->file_pos, &jmwc, error);
+          else
+            status = mbr_kemkmall_rd_mwc(verbose, buffer, store_ptr, (void *)&header, &jmwc, error);
 
           /* if MWC set flag indicating water column records are present */
           if (status == MB_SUCCESS) {
@@ -7405,7 +7623,7 @@ int mbr_kemkmall_wr_mwc(int verbose, size_t *bufferalloc, char **bufferptr, void
   int numBytesPerSample = 1 + mwc->rxInfo.phaseFlag;
   int numBytesWC = 0;
   for (int i=0; i<mwc->rxInfo.numBeams; i++) {
-    numBytesWC = mwc->beamData_p[i].numSampleData * numBytesPerSample;
+    numBytesWC += mwc->beamData_p[i].numSampleData * numBytesPerSample;
   }
   mwc->header.numBytesDgm = MBSYS_KMBES_HEADER_SIZE
                             + mwc->cmnPart.numBytesCmnPart
@@ -9451,8 +9669,18 @@ int mbr_wt_kemkmall(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
   fprintf(stderr, "\nAbout to call mbr_kemkmall_wr_data record kind:%d\n", store->kind);
 #endif
 
+  /* decode any data deferred when read that are to be written - note that
+      MWC datagrams are written only for water column records */
+  struct mbsys_kmbes_struct *store_deferred = (struct mbsys_kmbes_struct *)store_ptr;
+  int status = MB_SUCCESS;
+  if (store_deferred->kind == MB_DATA_WATER_COLUMN)
+    status = mbr_kemkmall_rd_deferred(verbose, store_ptr, error);
+  else
+    status = mbr_kemkmall_rd_deferred_sidescan(verbose, store_ptr, error);
+
   /* write next data to file */
-  const int status = mbr_kemkmall_wr_data(verbose, mbio_ptr, store_ptr, error);
+  if (status == MB_SUCCESS)
+    status = mbr_kemkmall_wr_data(verbose, mbio_ptr, store_ptr, error);
 
 #ifdef MBR_KEMKMALL_DEBUG
   fprintf(stderr, "Done with mbr_kemkmall_wr_data: status:%d error:%d\n", status, *error);
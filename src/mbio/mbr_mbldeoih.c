@@ -851,6 +851,142 @@ int mbr_rt_mbldeoih(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------*/
+int mbr_frame_mbldeoih(int verbose, void *mbio_ptr, int *kind, long *size, int *error) {
+	char buffer[MBF_MBLDEOIH_BUFFERSIZE];
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+	}
+
+	/* get pointer to mbio descriptor */
+	struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* set file position */
+	mb_io_ptr->file_pos = mb_io_ptr->file_bytes;
+	*kind = MB_DATA_NONE;
+	*size = 0;
+
+	int status = MB_SUCCESS;
+	*error = MB_ERROR_NO_ERROR;
+
+	/* read the header id, a clean end of file being the only place
+	    where nothing at all can be read */
+	short flag = 0;
+	int header_length = 0;
+	size_t nread = fread(buffer, 1, 2, mb_io_ptr->mbfp);
+	if (nread == 2) {
+		mb_get_binary_short(false, (void *)&buffer[0], &flag);
+		if (flag == MBF_MBLDEOIH_ID_COMMENT1 || flag == MBF_MBLDEOIH_ID_COMMENT2) {
+			*kind = MB_DATA_COMMENT;
+			header_length = flag == MBF_MBLDEOIH_ID_COMMENT1 ? MBF_MBLDEOIH_V1HEADERSIZE : 2;
+		}
+		else if (flag == MBF_MBLDEOIH_ID_DATA5) {
+			*kind = MB_DATA_DATA;
+			header_length = MBF_MBLDEOIH_V5HEADERSIZE;
+		}
+		else if (flag == MBF_MBLDEOIH_ID_DATA4) {
+			*kind = MB_DATA_DATA;
+			header_length = MBF_MBLDEOIH_V4HEADERSIZE;
+		}
+		else if (flag == MBF_MBLDEOIH_ID_DATA3) {
+			*kind = MB_DATA_DATA;
+			header_length = MBF_MBLDEOIH_V3HEADERSIZE;
+		}
+		else if (flag == MBF_MBLDEOIH_ID_DATA2) {
+			*kind = MB_DATA_DATA;
+			header_length = MBF_MBLDEOIH_V2HEADERSIZE;
+		}
+		else if (flag == MBF_MBLDEOIH_ID_DATA1) {
+			*kind = MB_DATA_DATA;
+			header_length = MBF_MBLDEOIH_V1HEADERSIZE;
+		}
+		else {
+			status = MB_FAILURE;
+			*error = MB_ERROR_UNINTELLIGIBLE;
+		}
+	}
+	else {
+		status = MB_FAILURE;
+		*error = nread == 0 ? MB_ERROR_EOF : MB_ERROR_UNINTELLIGIBLE;
+	}
+	mb_io_ptr->file_bytes += nread;
+
+	/* read the rest of the header */
+	if (status == MB_SUCCESS && header_length > 2) {
+		nread = fread(&buffer[2], 1, header_length - 2, mb_io_ptr->mbfp);
+		mb_io_ptr->file_bytes += nread;
+		if (nread != (size_t)(header_length - 2)) {
+			status = MB_FAILURE;
+			*error = MB_ERROR_UNINTELLIGIBLE;
+		}
+	}
+
+	/* get the length of the data following the header - comments are
+	    always 128 bytes, the numbers of beams and pixels of data records
+	    are ints in version 5 headers and shorts in older versions */
+	long data_length = 0;
+	if (status == MB_SUCCESS && *kind == MB_DATA_COMMENT) {
+		data_length = 128;
+	}
+	else if (status == MB_SUCCESS) {
+		int beams_bath = 0;
+		int beams_amp = 0;
+		int pixels_ss = 0;
+		if (flag == MBF_MBLDEOIH_ID_DATA5) {
+			mb_get_binary_int(false, (void *)&buffer[70], &beams_bath);
+			mb_get_binary_int(false, (void *)&buffer[74], &beams_amp);
+			mb_get_binary_int(false, (void *)&buffer[78], &pixels_ss);
+		}
+		else {
+			const int index = flag == MBF_MBLDEOIH_ID_DATA4 ? 70 : 24;
+			short short_beams_bath = 0;
+			short short_beams_amp = 0;
+			short short_pixels_ss = 0;
+			mb_get_binary_short(false, (void *)&buffer[index], &short_beams_bath);
+			mb_get_binary_short(false, (void *)&buffer[index + 2], &short_beams_amp);
+			mb_get_binary_short(false, (void *)&buffer[index + 4], &short_pixels_ss);
+			beams_bath = short_beams_bath;
+			beams_amp = short_beams_amp;
+			pixels_ss = short_pixels_ss;
+		}
+		if (beams_bath < 0 || beams_amp < 0 || pixels_ss < 0) {
+			status = MB_FAILURE;
+			*error = MB_ERROR_UNINTELLIGIBLE;
+		}
+		else {
+			data_length = 7 * (long)beams_bath + 2 * (long)beams_amp + 6 * (long)pixels_ss;
+		}
+	}
+
+	/* skip over the data */
+	if (status == MB_SUCCESS && data_length > 0) {
+		if (fseek(mb_io_ptr->mbfp, data_length, SEEK_CUR) == 0) {
+			mb_io_ptr->file_bytes += data_length;
+		}
+		else {
+			status = MB_FAILURE;
+			*error = MB_ERROR_UNINTELLIGIBLE;
+		}
+	}
+	if (status == MB_SUCCESS)
+		*size = header_length + data_length;
+
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
+		fprintf(stderr, "dbg2       size:       %ld\n", *size);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
 int mbr_wt_mbldeoih(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 	struct mbsys_ldeoih_old_struct oldstore;
 	int write_size;
@@ -1322,6 +1458,7 @@ int mbr_register_mbldeoih(int verbose, void *mbio_ptr, int *error) {
 	mb_io_ptr->mb_io_store_free = &mbsys_ldeoih_deall;
 	mb_io_ptr->mb_io_read_ping = &mbr_rt_mbldeoih;
 	mb_io_ptr->mb_io_write_ping = &mbr_wt_mbldeoih;
+	mb_io_ptr->mb_io_frame = &mbr_frame_mbldeoih;
 	mb_io_ptr->mb_io_dimensions = &mbsys_ldeoih_dimensions;
 	mb_io_ptr->mb_io_sonartype = &mbsys_ldeoih_sonartype;
 	mb_io_ptr->mb_io_sidescantype = &mbsys_ldeoih_sidescantype;
@@ -1340,6 +1477,16 @@ int mbr_register_mbldeoih(int verbose, void *mbio_ptr, int *error) {
 	mb_io_ptr->mb_io_extract_rawss = NULL;
 	mb_io_ptr->mb_io_insert_rawss = NULL;
 
+	/* each record is self contained, so reading may start at any record,
+	    and nothing is read beyond the end of a record, so the indexed
+	    offsets bound whole records */
+	mb_io_ptr->index_seekable = true;
+	mb_io_ptr->record_contiguous = true;
+
+	/* the store holds everything extracted from a record, so records may be
+	    read ahead by a background thread (see mb_read_ahead.c) */
+	mb_io_ptr->read_ahead_safe = true;
+
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
 		fprintf(stderr, "dbg2  Return values:\n");
@@ -3848,29 +3848,19 @@ int mbr_reson7k3_rd_BeamGeometry(int verbose, char *buffer, void *store_ptr, int
   index += 4;
 
   /* extract the data */
-  for (unsigned int i = 0; i < BeamGeometry->number_beams; i++) {
-    mb_get_binary_float(true, &buffer[index], &(BeamGeometry->angle_alongtrack[i]));
-    index += 4;
-  }
-  for (unsigned int i = 0; i < BeamGeometry->number_beams; i++) {
-    mb_get_binary_float(true, &buffer[index], &(BeamGeometry->angle_acrosstrack[i]));
-    index += 4;
-  }
-  for (unsigned int i = 0; i < BeamGeometry->number_beams; i++) {
-    mb_get_binary_float(true, &buffer[index], &(BeamGeometry->beamwidth_alongtrack[i]));
-    index += 4;
-  }
-  for (unsigned int i = 0; i < BeamGeometry->number_beams; i++) {
-    mb_get_binary_float(true, &buffer[index], &(BeamGeometry->beamwidth_acrosstrack[i]));
-    index += 4;
-  }
+  mb_get_binary_float_array(true, BeamGeometry->number_beams, &buffer[index], BeamGeometry->angle_alongtrack);
+  index += 4 * BeamGeometry->number_beams;
+  mb_get_binary_float_array(true, BeamGeometry->number_beams, &buffer[index], BeamGeometry->angle_acrosstrack);
+  index += 4 * BeamGeometry->number_beams;
+  mb_get_binary_float_array(true, BeamGeometry->number_beams, &buffer[index], BeamGeometry->beamwidth_alongtrack);
+  index += 4 * BeamGeometry->number_beams;
+  mb_get_binary_float_array(true, BeamGeometry->number_beams, &buffer[index], BeamGeometry->beamwidth_acrosstrack);
+  index += 4 * BeamGeometry->number_beams;
   
   /* Hydrosweep sonar data may include an addition array of per-beam Tx delay values */
   if (header->DeviceId >= 14000 && header->DeviceId < 14050) {
-		for (unsigned int i = 0; i < BeamGeometry->number_beams; i++) {
-			mb_get_binary_float(true, &buffer[index], &(BeamGeometry->tx_delay[i]));
-			index += 4;
-		}
+		mb_get_binary_float_array(true, BeamGeometry->number_beams, &buffer[index], BeamGeometry->tx_delay);
+		index += 4 * BeamGeometry->number_beams;
   }
 
   /* set kind */
@@ -3964,28 +3954,20 @@ int mbr_reson7k3_rd_Bathymetry(int verbose, char *buffer, void *store_ptr, int *
   }
 
   /* extract the data */
-  for (unsigned int i = 0; i < Bathymetry->number_beams; i++) {
-    mb_get_binary_float(true, &buffer[index], &(Bathymetry->range[i]));
-    index += 4;
-  }
+  mb_get_binary_float_array(true, Bathymetry->number_beams, &buffer[index], Bathymetry->range);
+  index += 4 * Bathymetry->number_beams;
   for (unsigned int i = 0; i < Bathymetry->number_beams; i++) {
     Bathymetry->quality[i] = buffer[index];
     index++;
   }
-  for (unsigned int i = 0; i < Bathymetry->number_beams; i++) {
-    mb_get_binary_float(true, &buffer[index], &(Bathymetry->intensity[i]));
-    index += 4;
-  }
+  mb_get_binary_float_array(true, Bathymetry->number_beams, &buffer[index], Bathymetry->intensity);
+  index += 4 * Bathymetry->number_beams;
   if ((header->OptionalDataOffset == 0 && header->Size >= 92 + 17 * Bathymetry->number_beams) ||
       (header->OptionalDataOffset > 0 && header->Size >= 137 + 37 * Bathymetry->number_beams)) {
-    for (unsigned int i = 0; i < Bathymetry->number_beams; i++) {
-      mb_get_binary_float(true, &buffer[index], &(Bathymetry->min_depth_gate[i]));
-      index += 4;
-    }
-    for (unsigned int i = 0; i < Bathymetry->number_beams; i++) {
-      mb_get_binary_float(true, &buffer[index], &(Bathymetry->max_depth_gate[i]));
-      index += 4;
-    }
+    mb_get_binary_float_array(true, Bathymetry->number_beams, &buffer[index], Bathymetry->min_depth_gate);
+    index += 4 * Bathymetry->number_beams;
+    mb_get_binary_float_array(true, Bathymetry->number_beams, &buffer[index], Bathymetry->max_depth_gate);
+    index += 4 * Bathymetry->number_beams;
   }
 
   /* extract the optional data */
@@ -4012,18 +3994,14 @@ int mbr_reson7k3_rd_Bathymetry(int verbose, char *buffer, void *store_ptr, int *
     index += 4;
     mb_get_binary_float(true, &buffer[index], &(Bathymetry->vehicle_depth));
     index += 4;
-    for (unsigned int i = 0; i < Bathymetry->number_beams; i++) {
-      mb_get_binary_float(true, &buffer[index], &(Bathymetry->depth[i]));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(Bathymetry->alongtrack[i]));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(Bathymetry->acrosstrack[i]));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(Bathymetry->pointing_angle[i]));
-      index += 4;
-      mb_get_binary_float(true, &buffer[index], &(Bathymetry->azimuth_angle[i]));
-      index += 4;
-    }
+    mb_get_binary_float_strided(true, Bathymetry->number_beams, &buffer[index], 20, Bathymetry->depth, sizeof(float));
+    mb_get_binary_float_strided(true, Bathymetry->number_beams, &buffer[index + 4], 20, Bathymetry->alongtrack, sizeof(float));
+    mb_get_binary_float_strided(true, Bathymetry->number_beams, &buffer[index + 8], 20, Bathymetry->acrosstrack, sizeof(float));
+    mb_get_binary_float_strided(true, Bathymetry->number_beams, &buffer[index + 12], 20, Bathymetry->pointing_angle,
+                                sizeof(float));
+    mb_get_binary_float_strided(true, Bathymetry->number_beams, &buffer[index + 16], 20, Bathymetry->azimuth_angle,
+                                sizeof(float));
+    index += 20 * Bathymetry->number_beams;
   }
   else {
     Bathymetry->optionaldata = false;
@@ -4171,27 +4149,19 @@ int mbr_reson7k3_rd_SideScan(int verbose, char *buffer, void *store_ptr, int *er
   }
   else if (SideScan->sample_size == 2) {
     short_ptr = (short *)SideScan->port_data;
-    for (unsigned int i = 0; i < SideScan->number_samples; i++) {
-      mb_get_binary_short(true, &buffer[index], &(short_ptr[i]));
-      index += 2;
-    }
+    mb_get_binary_short_array(true, SideScan->number_samples, &buffer[index], short_ptr);
+    index += 2 * SideScan->number_samples;
     short_ptr = (short *)SideScan->stbd_data;
-    for (unsigned int i = 0; i < SideScan->number_samples; i++) {
-      mb_get_binary_short(true, &buffer[index], &(short_ptr[i]));
-      index += 2;
-    }
+    mb_get_binary_short_array(true, SideScan->number_samples, &buffer[index], short_ptr);
+    index += 2 * SideScan->number_samples;
   }
   else if (SideScan->sample_size == 4) {
     int_ptr = (int *)SideScan->port_data;
-    for (unsigned int i = 0; i < SideScan->number_samples; i++) {
-      mb_get_binary_int(true, &buffer[index], &(int_ptr[i]));
-      index += 4;
-    }
+    mb_get_binary_int_array(true, SideScan->number_samples, &buffer[index], int_ptr);
+    index += 4 * SideScan->number_samples;
     int_ptr = (int *)SideScan->stbd_data;
-    for (unsigned int i = 0; i < SideScan->number_samples; i++) {
-      mb_get_binary_int(true, &buffer[index], &(int_ptr[i]));
-      index += 4;
-    }
+    mb_get_binary_int_array(true, SideScan->number_samples, &buffer[index], int_ptr);
+    index += 4 * SideScan->number_samples;
   }
 
   /* extract the optional data */
@@ -6039,9 +6009,9 @@ int mbr_reson7k3_rd_Snippet(int verbose, char *buffer, void *store_ptr, int *err
         snippetdata = (s7k3_snippetdata *)&(Snippet->snippetdata[i]);
         u32_ptr = (u32 *)snippetdata->amplitude;
         nsample = snippetdata->end_sample - snippetdata->begin_sample + 1;
-        for (int j = 0; j < nsample; j++) {
-          mb_get_binary_int(true, &buffer[index], &(u32_ptr[j]));
-          index += 4;
+        if (nsample > 0) {
+          mb_get_binary_int_array(true, nsample, &buffer[index], u32_ptr);
+          index += 4 * nsample;
         }
       }
     }
@@ -6050,9 +6020,9 @@ int mbr_reson7k3_rd_Snippet(int verbose, char *buffer, void *store_ptr, int *err
         snippetdata = (s7k3_snippetdata *)&(Snippet->snippetdata[i]);
         u16_ptr = (u16 *)snippetdata->amplitude;
         nsample = snippetdata->end_sample - snippetdata->begin_sample + 1;
-        for (int j = 0; j < nsample; j++) {
-          mb_get_binary_short(true, &buffer[index], &(u16_ptr[j]));
-          index += 2;
+        if (nsample > 0) {
+          mb_get_binary_short_array(true, nsample, &buffer[index], u16_ptr);
+          index += 2 * nsample;
         }
       }
     }
@@ -8177,6 +8147,207 @@ int mbr_reson7k3_chk_pingrecord(int verbose, int recordid, int *pingrecord) {
   return (MB_SUCCESS);
 }
 /*--------------------------------------------------------------------*/
+int mbr_reson7k3_chk_deferred(int verbose, int recordid, int *ideferred) {
+  assert(ideferred != NULL);
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
+    fprintf(stderr, "dbg2       recordid:      %d\n", recordid);
+  }
+
+  /* the bulky water column records not needed for swath extraction
+      may have their decoding deferred in lazy decode mode */
+  switch (recordid) {
+    case R7KRECID_WaterColumn:
+      *ideferred = 0;
+      break;
+    case R7KRECID_Image:
+      *ideferred = 1;
+      break;
+    case R7KRECID_Beamformed:
+      *ideferred = 2;
+      break;
+    case R7KRECID_CompressedBeamformedMagnitude:
+      *ideferred = 3;
+      break;
+    case R7KRECID_CompressedWaterColumn:
+      *ideferred = 4;
+      break;
+    default:
+      *ideferred = -1;
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Output arguments:\n");
+    fprintf(stderr, "dbg2       ideferred:     %d\n", *ideferred);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:        %d\n", MB_SUCCESS);
+  }
+
+  return (MB_SUCCESS);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7k3_rd_defer(int verbose, char *buffer, void *mbio_ptr, void *store_ptr, int recordid, long offset,
+                          unsigned int size, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       buffer:     %p\n", (void *)buffer);
+    fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+    fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+    fprintf(stderr, "dbg2       recordid:   %d\n", recordid);
+    fprintf(stderr, "dbg2       offset:     %ld\n", offset);
+    fprintf(stderr, "dbg2       size:       %u\n", size);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+  /* get pointer to raw data structure */
+  struct mbsys_reson7k3_struct *store = (struct mbsys_reson7k3_struct *)store_ptr;
+
+  /* get the header of the deferred record */
+  s7k3_header *header = NULL;
+  if (recordid == R7KRECID_WaterColumn)
+    header = &(store->WaterColumn.header);
+  else if (recordid == R7KRECID_Image)
+    header = &(store->Image.header);
+  else if (recordid == R7KRECID_Beamformed)
+    header = &(store->Beamformed.header);
+  else if (recordid == R7KRECID_CompressedBeamformedMagnitude)
+    header = &(store->CompressedBeamformedMagnitude.header);
+  else if (recordid == R7KRECID_CompressedWaterColumn)
+    header = &(store->CompressedWaterColumn.header);
+  int ideferred;
+  mbr_reson7k3_chk_deferred(verbose, recordid, &ideferred);
+
+  /* decode only the record header now and note where the record is
+      so that the rest can be decoded by mbr_reson7k3_rd_deferred() */
+  int status = MB_SUCCESS;
+  if (header != NULL && ideferred >= 0) {
+    int index = 0;
+    status = mbr_reson7k3_rd_header(verbose, buffer, &index, header, error);
+    store->deferred_fp = mb_io_ptr->mbfp;
+    store->deferred[ideferred].recordid = recordid;
+    store->deferred[ideferred].offset = offset;
+    store->deferred[ideferred].size = size;
+  }
+  else {
+    status = MB_FAILURE;
+    *error = MB_ERROR_UNINTELLIGIBLE;
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:  %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7k3_rd_deferred(int verbose, void *store_ptr, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+  }
+
+  /* get pointer to raw data structure */
+  struct mbsys_reson7k3_struct *store = (struct mbsys_reson7k3_struct *)store_ptr;
+
+  int status = MB_SUCCESS;
+  *error = MB_ERROR_NO_ERROR;
+  char *buffer = NULL;
+  unsigned int bufferalloc = 0;
+
+  for (int i = 0; i < MBSYS_RESON7K3_NDEFERRED; i++) {
+    s7k3_deferred *deferred = &(store->deferred[i]);
+    if (deferred->recordid == 0)
+      continue;
+
+    /* records dropped since being read (e.g. by mbpreprocess) need no decoding */
+    s7k3_header *header = NULL;
+    bool read_record = false;
+    if (deferred->recordid == R7KRECID_WaterColumn) {
+      header = &(store->WaterColumn.header);
+      read_record = store->read_WaterColumn;
+    }
+    else if (deferred->recordid == R7KRECID_Image) {
+      header = &(store->Image.header);
+      read_record = store->read_Image;
+    }
+    else if (deferred->recordid == R7KRECID_Beamformed) {
+      header = &(store->Beamformed.header);
+      read_record = store->read_Beamformed;
+    }
+    else if (deferred->recordid == R7KRECID_CompressedBeamformedMagnitude) {
+      header = &(store->CompressedBeamformedMagnitude.header);
+      read_record = store->read_CompressedBeamformedMagnitude;
+    }
+    else if (deferred->recordid == R7KRECID_CompressedWaterColumn) {
+      header = &(store->CompressedWaterColumn.header);
+      read_record = store->read_CompressedWaterColumn;
+    }
+
+    /* read the whole record from the input file, restoring the file position afterwards */
+    if (status == MB_SUCCESS && read_record && header != NULL) {
+      if (bufferalloc < deferred->size) {
+        status = mb_reallocd(verbose, __FILE__, __LINE__, deferred->size, (void **)&buffer, error);
+        bufferalloc = status == MB_SUCCESS ? deferred->size : 0;
+      }
+      if (status == MB_SUCCESS) {
+        const long position = ftell(store->deferred_fp);
+        if (fseek(store->deferred_fp, deferred->offset, SEEK_SET) != 0
+            || fread(buffer, 1, deferred->size, store->deferred_fp) != deferred->size) {
+          status = MB_FAILURE;
+          *error = MB_ERROR_EOF;
+        }
+        fseek(store->deferred_fp, position, SEEK_SET);
+      }
+
+      /* decode the record, keeping the header as it was when read
+          (the timestamp may have been corrected from the FileCatalog) */
+      if (status == MB_SUCCESS) {
+        const s7k3_header header_read = *header;
+        if (deferred->recordid == R7KRECID_WaterColumn)
+          status = mbr_reson7k3_rd_WaterColumn(verbose, buffer, store_ptr, error);
+        else if (deferred->recordid == R7KRECID_Image)
+          status = mbr_reson7k3_rd_Image(verbose, buffer, store_ptr, error);
+        else if (deferred->recordid == R7KRECID_Beamformed)
+          status = mbr_reson7k3_rd_Beamformed(verbose, buffer, store_ptr, error);
+        else if (deferred->recordid == R7KRECID_CompressedBeamformedMagnitude)
+          status = mbr_reson7k3_rd_CompressedBeamformedMagnitude(verbose, buffer, store_ptr, error);
+        else if (deferred->recordid == R7KRECID_CompressedWaterColumn)
+          status = mbr_reson7k3_rd_CompressedWaterColumn(verbose, buffer, store_ptr, error);
+        *header = header_read;
+      }
+    }
+    deferred->recordid = 0;
+  }
+
+  if (buffer != NULL) {
+    int lerror = MB_ERROR_NO_ERROR;
+    mb_freed(verbose, __FILE__, __LINE__, (void **)&buffer, &lerror);
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:  %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
 
 int mbr_reson7k3_FileCatalog_compare(const void *a, const void *b) {
   int result = 0;
@@ -9720,6 +9891,8 @@ int mbr_reson7k3_rd_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
   unsigned int *icatalog = (unsigned int *)&mb_io_ptr->save15;
   int *kluge_fix7ktimestamps = (int *)&mb_io_ptr->save20;
   double *kluge_fix7ktimestamps_targetoffset = (double *)&mb_io_ptr->saved1;
+  int *save_deferred = (int *)&mb_io_ptr->save22;
+  double *save_deferred_offset = (double *)&mb_io_ptr->saved4;
 
   /* set file position */
   mb_io_ptr->file_pos = mb_io_ptr->file_bytes;
@@ -9728,12 +9901,18 @@ int mbr_reson7k3_rd_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
   bool done = false;
   *error = MB_ERROR_NO_ERROR;
   while (!done) {
+    /* records whose decoding is deferred are only partly in the buffer */
+    bool deferred = false;
+    long deferred_offset = 0;
+
     /* if previously read record stored use it first */
     if (*save_flag) {
       *save_flag = false;
       mbr_reson7k3_chk_header(verbose, mbio_ptr, buffersave, recordid, deviceid, enumerator, size);
       for (unsigned int i = 0; i < *size; i++)
         buffer[i] = buffersave[i];
+      deferred = *save_deferred;
+      deferred_offset = (long)*save_deferred_offset;
     }
 
 #ifdef MBTRN_ENABLED
@@ -9814,8 +9993,38 @@ Have a nice day...:                              %4.4X | %d\n", store->type, sto
         }
       }
 
+      /* in lazy decode mode read only enough of bulky water column records to
+          get the header and ping number, and skip over the rest - these are
+          decoded later by mbr_reson7k3_rd_deferred() if needed */
+      int ideferred = -1;
+      mbr_reson7k3_chk_deferred(verbose, *recordid, &ideferred);
+      if (status == MB_SUCCESS && ideferred >= 0) {
+        unsigned short offset = 0;
+        mb_get_binary_short(true, &buffer[2], &offset);
+        if (mb_io_ptr->lazy_decode && *size > MBSYS_RESON7K3_DEFERRED_READSIZE
+            && offset + 16 <= MBSYS_RESON7K3_DEFERRED_READSIZE) {
+          deferred = true;
+          deferred_offset = ftell(mb_io_ptr->mbfp) - MBSYS_RESON7K_VERSIONSYNCSIZE;
+        }
+        else {
+          store->deferred[ideferred].recordid = 0;
+        }
+      }
+
       /* read the rest of the record */
-      if (status == MB_SUCCESS) {
+      if (status == MB_SUCCESS && deferred) {
+        read_len = (size_t)(MBSYS_RESON7K3_DEFERRED_READSIZE - MBSYS_RESON7K_VERSIONSYNCSIZE);
+        status = mb_fileio_get(verbose, mbio_ptr, &buffer[MBSYS_RESON7K_VERSIONSYNCSIZE], &read_len, error);
+
+        /* seeking past the end of the file succeeds, so read the last byte
+            of the record to detect a record truncated by the end of the file */
+        if (status == MB_SUCCESS && (fseek(mb_io_ptr->mbfp, deferred_offset + *size - 1, SEEK_SET) != 0
+                                     || fgetc(mb_io_ptr->mbfp) == EOF)) {
+          status = MB_FAILURE;
+          *error = MB_ERROR_EOF;
+        }
+      }
+      else if (status == MB_SUCCESS) {
         read_len = (size_t)(*size - MBSYS_RESON7K_VERSIONSYNCSIZE);
         status = mb_fileio_get(verbose, mbio_ptr, &buffer[MBSYS_RESON7K_VERSIONSYNCSIZE], &read_len, error);
       }
@@ -9878,6 +10087,8 @@ Have a nice day...:                              %4.4X | %d\n", store->type, sto
             *last_ping = -1;
             for (unsigned int i = 0; i < *size; i++)
               buffersave[i] = buffer[i];
+            *save_deferred = deferred;
+            *save_deferred_offset = (double)deferred_offset;
 
             /* get the time */
             if (store->read_RawDetection) {
@@ -9938,6 +10149,8 @@ Have a nice day...:                              %4.4X | %d\n", store->type, sto
           store->read_CalibratedSideScan = false;
           store->read_SnippetBackscatteringStrength = false;
           store->read_RemoteControlSonarSettings = false;
+          for (int i = 0; i < MBSYS_RESON7K3_NDEFERRED; i++)
+            store->deferred[i].recordid = 0;
         }
       }
     }
@@ -9957,6 +10170,8 @@ Have a nice day...:                              %4.4X | %d\n", store->type, sto
         *last_ping = -1;
         for (unsigned int i = 0; i < *size; i++)
           buffersave[i] = buffer[i];
+        *save_deferred = deferred;
+        *save_deferred_offset = (double)deferred_offset;
 
         /* get the time */
         if (store->read_RawDetection) {
@@ -11164,7 +11379,10 @@ Have a nice day...:                              %4.4X | %d\n", store->type, sto
         }
       }
       else if (*recordid == R7KRECID_WaterColumn) {
-        status = mbr_reson7k3_rd_WaterColumn(verbose, buffer, store_ptr, error);
+        if (deferred)
+          status = mbr_reson7k3_rd_defer(verbose, buffer, mbio_ptr, store_ptr, *recordid, deferred_offset, *size, error);
+        else
+          status = mbr_reson7k3_rd_WaterColumn(verbose, buffer, store_ptr, error);
         if (status == MB_SUCCESS) {
           store->nrec_WaterColumn++;
           store->read_WaterColumn = true;
@@ -11191,7 +11409,10 @@ Have a nice day...:                              %4.4X | %d\n", store->type, sto
         }
       }
       else if (*recordid == R7KRECID_Image) {
-        status = mbr_reson7k3_rd_Image(verbose, buffer, store_ptr, error);
+        if (deferred)
+          status = mbr_reson7k3_rd_defer(verbose, buffer, mbio_ptr, store_ptr, *recordid, deferred_offset, *size, error);
+        else
+          status = mbr_reson7k3_rd_Image(verbose, buffer, store_ptr, error);
         if (status == MB_SUCCESS) {
           store->nrec_Image++;
           store->read_Image = true;
@@ -11224,7 +11445,10 @@ Have a nice day...:                              %4.4X | %d\n", store->type, sto
         }
       }
       else if (*recordid == R7KRECID_Beamformed) {
-        status = mbr_reson7k3_rd_Beamformed(verbose, buffer, store_ptr, error);
+        if (deferred)
+          status = mbr_reson7k3_rd_defer(verbose, buffer, mbio_ptr, store_ptr, *recordid, deferred_offset, *size, error);
+        else
+          status = mbr_reson7k3_rd_Beamformed(verbose, buffer, store_ptr, error);
         if (status == MB_SUCCESS) {
           store->nrec_Beamformed++;
           store->read_Beamformed = true;
@@ -11304,7 +11528,10 @@ Have a nice day...:                              %4.4X | %d\n", store->type, sto
         }
       }
       else if (*recordid == R7KRECID_CompressedBeamformedMagnitude) {
-        status = mbr_reson7k3_rd_CompressedBeamformedMagnitude(verbose, buffer, store_ptr, error);
+        if (deferred)
+          status = mbr_reson7k3_rd_defer(verbose, buffer, mbio_ptr, store_ptr, *recordid, deferred_offset, *size, error);
+        else
+          status = mbr_reson7k3_rd_CompressedBeamformedMagnitude(verbose, buffer, store_ptr, error);
         if (status == MB_SUCCESS) {
           store->nrec_CompressedBeamformedMagnitude++;
           store->read_CompressedBeamformedMagnitude = true;
@@ -11313,7 +11540,10 @@ Have a nice day...:                              %4.4X | %d\n", store->type, sto
         }
       }
       else if (*recordid == R7KRECID_CompressedWaterColumn) {
-        status = mbr_reson7k3_rd_CompressedWaterColumn(verbose, buffer, store_ptr, error);
+        if (deferred)
+          status = mbr_reson7k3_rd_defer(verbose, buffer, mbio_ptr, store_ptr, *recordid, deferred_offset, *size, error);
+        else
+          status = mbr_reson7k3_rd_CompressedWaterColumn(verbose, buffer, store_ptr, error);
         if (status == MB_SUCCESS) {
           store->nrec_CompressedWaterColumn++;
           store->read_CompressedWaterColumn = true;
@@ -22318,8 +22548,12 @@ int mbr_wt_reson7k3(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
   struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
   struct mbsys_reson7k3_struct *store = (struct mbsys_reson7k3_struct *)store_ptr;
 
+  /* decode any records deferred when read so they can be written */
+  int status = mbr_reson7k3_rd_deferred(verbose, store, error);
+
   /* write next data to file */
-  const int status = mbr_reson7k3_wr_data(verbose, mb_io_ptr, store, error);
+  if (status == MB_SUCCESS)
+    status = mbr_reson7k3_wr_data(verbose, mb_io_ptr, store, error);
 
   if (verbose >= 2) {
     fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
@@ -22396,6 +22630,11 @@ int mbr_register_reson7k3(int verbose, void *mbio_ptr, int *error) {
   mb_io_ptr->mb_io_ctd = &mbsys_reson7k3_ctd;
   mb_io_ptr->mb_io_ancilliarysensor = &mbsys_reson7k3_ancilliarysensor;
 
+  /* index_seekable and record_contiguous are not set - records are read
+      ahead into buffersave while assembling pings, so the file position
+      before a read is not the start of the next ping, and for files with
+      a FileCatalog the reader positions the file itself from icatalog */
+
   if (verbose >= 2) {
     fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", __func__);
     fprintf(stderr, "dbg2  Return values:\n");
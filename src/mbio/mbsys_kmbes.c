@@ -3072,6 +3072,10 @@ int mbsys_kmbes_copy(int verbose, void *mbio_ptr, void *store_ptr, void *copy_pt
   struct mbsys_kmbes_struct *store = (struct mbsys_kmbes_struct *)store_ptr;
   struct mbsys_kmbes_struct *copy = (struct mbsys_kmbes_struct *)copy_ptr;
 
+  /* decode any data deferred when read so the copy is complete */
+  mbr_kemkmall_rd_deferred(verbose, store_ptr, error);
+  copy->deferred_fp = NULL;
+
   /* copy the data - for many formats memory must be allocated and
       sub-structures copied separately */
   //*copy = *store;
@@ -3114,6 +3118,7 @@ int mbsys_kmbes_copy(int verbose, void *mbio_ptr, void *store_ptr, void *copy_pt
       copy_mwc->sectorData[j] = store_mwc->sectorData[j];
     }
     copy_mwc->rxInfo = store_mwc->rxInfo;
+    copy_mwc->deferred = false;
 
     size_t alloc_size = (size_t)(store_mwc->rxInfo.numBeams * sizeof(struct mbsys_kmbes_mwc_rx_beam_data));
     if (copy_mwc->beamData_p_alloc_size < alloc_size || copy_mwc->beamData_p == NULL) {
@@ -3263,6 +3268,9 @@ int mbsys_kmbes_makess(
 
   /* insert data in structure */
 	if (store->kind == MB_DATA_DATA) {
+		/* decode any seabed image samples deferred when read */
+		mbr_kemkmall_rd_deferred_sidescan(verbose, store_ptr, error);
+
 		/* get number of swaths */
 		const int num_swaths = (store->n_mrz_read > 0)
 													 ? store->mrz[0].cmnPart.swathsPerPing
@@ -136,6 +136,8 @@
 #ifndef MBSYS_KMBES_H_
 #define MBSYS_KMBES_H_
 
+#include <stdio.h>
+
 #include "mb_define.h"
 
 /*---------------------------------------------------------------*/
@@ -185,6 +187,7 @@
 #define MBSYS_KMBES_START_BUFFER_SIZE 64000 // udp packet max is 64kbyte, but the KMBES K-Controller may concat a number of packets
 #define MBSYS_KMBES_INDEX_TABLE_BLOCK_SIZE 4096
 #define MBSYS_KMBES_HEADER_SIZE 20
+#define MBSYS_KMBES_MWC_DEFERRED_READSIZE 36 // header, partition and common part of MWC datagrams
 #define MBSYS_KMBES_PARITION_SIZE 4
 #define MBSYS_KMBES_END_SIZE 4
 #define MBSYS_KMBES_MAX_SPO_DATALENGTH 250
@@ -1228,6 +1231,9 @@ struct mbsys_kmbes_mrz {
      * ranges. First sample for each beam is the one with the lowest range. The centre sample from each beam is geo
      * referenced (x, y, z data from the detections). The BS corrections applied at the centre sample are the same as
      * used for reflectivity2_dB (struct mbsys_kmbes_mrz_sounding).*/
+    bool SIsample_deferred;
+    /* MB-System only: if true, SIsample_desidB holds the seabed image samples as read from the file,
+     * not yet decoded (lazy decode mode) */
 };
 
  #define MBSYS_KMBES_MRZ_VERSION 2
@@ -1323,6 +1329,8 @@ struct mbsys_kmbes_mwc {
     struct mbsys_kmbes_mwc_rx_info rxInfo;
     size_t beamData_p_alloc_size;
     struct mbsys_kmbes_mwc_rx_beam_data *beamData_p;
+    bool deferred;           /* MB-System only: if true, datagram not yet decoded (lazy decode mode) */
+    long deferred_file_pos;  /* MB-System only: file position of datagram not yet decoded */
 };
 
  #define MBSYS_KMBES_MWC_VERSION 1
@@ -1788,6 +1796,10 @@ struct mbsys_kmbes_struct {
     /* Unknown format */
     struct mbsys_kmbes_unknown_struct unknown;
 
+    /* File from which seabed image samples and MWC datagrams are decoded when
+       needed in lazy decode mode */
+    FILE *deferred_fp;
+
 };
 
 
@@ -1900,6 +1912,10 @@ int mbsys_kmbes_copy(int verbose, void *mbio_ptr, void *store_ptr, void *copy_pt
 int mbsys_kmbes_makess(int verbose, void *mbio_ptr, void *store_ptr, int pixel_size_set, double *pixel_size,
                          int swath_width_set, double *swath_width, int pixel_int, int *error);
 
+// decoding of data deferred in lazy decode mode (see mbr_kemkmall.c)
+int mbr_kemkmall_rd_deferred_sidescan(int verbose, void *store_ptr, int *error);
+int mbr_kemkmall_rd_deferred(int verbose, void *store_ptr, int *error);
+
 #ifdef __cplusplus
 }  /* extern "C" */
 #endif
@@ -8439,6 +8439,12 @@ int mbsys_reson7k3_copy(int verbose, void *mbio_ptr, void *store_ptr, void *copy
   struct mbsys_reson7k3_struct *store = (struct mbsys_reson7k3_struct *)store_ptr;
   struct mbsys_reson7k3_struct *copy = (struct mbsys_reson7k3_struct *)copy_ptr;
 
+  /* decode any records deferred when read so the copy is complete */
+  mbr_reson7k3_rd_deferred(verbose, store_ptr, error);
+  copy->deferred_fp = NULL;
+  for (int i = 0; i < MBSYS_RESON7K3_NDEFERRED; i++)
+    copy->deferred[i].recordid = 0;
+
   /* copy over structures, allocating memory where necessary */
 
   /* Type of data record */
@@ -102,6 +102,7 @@
 #define MBSYS_RESON7K3_H_
 
 #include <stdint.h>
+#include <stdio.h>
 #include "mb_define.h"
 
 /*-----------------------------------------------------------------*/
@@ -199,6 +200,12 @@
 #define MBSYS_RESON7K_RECORDHEADER_SIZE 64
 #define MBSYS_RESON7K_RECORDTAIL_SIZE 4
 
+// Deferred decoding of bulky water column records (lazy decode mode):
+// number of record types that may be deferred and the number of bytes
+// read from the start of such records (enough for the ping number)
+#define MBSYS_RESON7K3_NDEFERRED 5
+#define MBSYS_RESON7K3_DEFERRED_READSIZE 128
+
 // 0 means no record at all
 #define R7KHDRSIZE_None 0
 
@@ -3131,6 +3138,13 @@ typedef struct s7k3_ProfileAverageTemperature_struct {
   f32 temperature; // Average water temperature vertically below the sensor. [deg Celcius]
 } s7k3_ProfileAverageTemperature;
 
+// Water column record whose decoding has been deferred (lazy decode mode)
+typedef struct s7k3_deferred_struct {
+  int recordid;      // Reson record ID, 0 if nothing is deferred
+  long offset;       // file offset to the start of the record
+  unsigned int size; // record size in bytes
+} s7k3_deferred;
+
 // internal data structure
 struct mbsys_reson7k3_struct {
   // Type of data record
@@ -3163,6 +3177,11 @@ struct mbsys_reson7k3_struct {
   int read_SnippetBackscatteringStrength;
   int read_RemoteControlSonarSettings;
 
+  // water column records read in lazy decode mode - only the record headers
+  // have been decoded, the rest is decoded from the input file when needed
+  FILE *deferred_fp;
+  s7k3_deferred deferred[MBSYS_RESON7K3_NDEFERRED];
+
   // MB-System time stamp
   f64 time_d;
   int time_i[7];
@@ -3624,4 +3643,7 @@ int mbsys_reson7k3_print_SpreadingLoss(int verbose, s7k3_SpreadingLoss *Spreadin
 int mbsys_reson7k3_print_ProfileAverageSalinity(int verbose, s7k3_ProfileAverageSalinity *ProfileAverageSalinity, int *error);
 int mbsys_reson7k3_print_ProfileAverageTemperature(int verbose, s7k3_ProfileAverageTemperature *ProfileAverageTemperature, int *error);
 
+// decoding of records deferred in lazy decode mode (see mbr_reson7k3.c)
+int mbr_reson7k3_rd_deferred(int verbose, void *store_ptr, int *error);
+
 #endif  //  MBSYS_RESON7K3_H_
@@ -38,8 +38,11 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <cerrno>
 #include <ctime>
+#include <fcntl.h>
 #include <getopt.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "mb_define.h"
@@ -86,7 +89,7 @@ constexpr char help_message[] =
 constexpr char usage_message[] =
     "mbcopy [-Byr/mo/da/hr/mn/sc -Ccommentfile -D -Eyr/mo/da/hr/mn/sc\n"
     "\t-Fiformat/oformat/mformat -H -Iinfile -Llonflip -Mmergefile -N -Ooutfile\n"
-    "\t-Ppings -Qsleep_factor -Rw/e/s/n -Sspeed -V]";
+    "\t-Ppings -Qsleep_factor -Rw/e/s/n -Sspeed -V -X]";
 
 /*--------------------------------------------------------------------*/
 int setup_transfer_rules(int verbose, int ibeams, int obeams, int *istart, int *iend, int *offset, int *error) {
@@ -1631,6 +1634,165 @@ int mbcopy_reson8k_to_gsf(int verbose, void *imbio_ptr, void *ombio_ptr, int *er
 }
 #endif  // ENABLE_GSF
 
+/*--------------------------------------------------------------------*/
+int mbcopy_copy_range(int verbose, int ifd, int ofd, off_t offset, off_t length, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBcopy function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+    fprintf(stderr, "dbg2       ifd:        %d\n", ifd);
+    fprintf(stderr, "dbg2       ofd:        %d\n", ofd);
+    fprintf(stderr, "dbg2       offset:     %lld\n", (long long)offset);
+    fprintf(stderr, "dbg2       length:     %lld\n", (long long)length);
+  }
+
+  int status = MB_SUCCESS;
+  while (length > 0 && status == MB_SUCCESS) {
+    ssize_t ncopy = -1;
+#ifdef __linux__
+    /* let the kernel copy the bytes where the filesystems allow it */
+    ncopy = copy_file_range(ifd, &offset, ofd, nullptr, (size_t)length, 0);
+#endif
+    if (ncopy <= 0) {
+      char buffer[65536];
+      ncopy = pread(ifd, buffer, (size_t)std::min((off_t)sizeof(buffer), length), offset);
+      if (ncopy > 0 && write(ofd, buffer, (size_t)ncopy) != ncopy)
+        ncopy = -1;
+      if (ncopy > 0)
+        offset += ncopy;
+    }
+    if (ncopy > 0) {
+      length -= ncopy;
+    }
+    else {
+      status = MB_FAILURE;
+      *error = MB_ERROR_WRITE_FAIL;
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBcopy function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:     %d\n", status);
+  }
+
+  return (status);
+}
+/*--------------------------------------------------------------------*/
+/* Copies the records of the input file kept by the time and location
+    bounds to the output file without decoding them, using the record
+    offsets in the index file. Only valid for i/o modules that set
+    record_contiguous. Records other than survey pings are always
+    copied, except for comments if stripcomments is true. */
+int mbcopy_passthrough(int verbose, void *imbio_ptr, char *ofile, bool stripcomments, int *idata, int *icomment,
+                       int *odata, int *ocomment, int *error) {
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBcopy function <%s> called\n", __func__);
+    fprintf(stderr, "dbg2  Input arguments:\n");
+    fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
+    fprintf(stderr, "dbg2       imbio_ptr:     %p\n", imbio_ptr);
+    fprintf(stderr, "dbg2       ofile:         %s\n", ofile);
+    fprintf(stderr, "dbg2       stripcomments: %d\n", stripcomments);
+  }
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)imbio_ptr;
+
+  /* get the record offsets, generating the index file if needed */
+  int num_fileindex = 0;
+  struct mb_io_fileindex_struct *fileindex = nullptr;
+  int status = mb_index_make(verbose, false, mb_io_ptr->file, mb_io_ptr->format, error);
+  if (status == MB_SUCCESS)
+    status = mb_index_read(verbose, mb_io_ptr->file, mb_io_ptr->format, &num_fileindex, (void **)&fileindex, error);
+
+  int ifd = -1;
+  int ofd = -1;
+  struct stat file_status;
+  if (status == MB_SUCCESS) {
+    if ((ifd = open(mb_io_ptr->file, O_RDONLY)) < 0 || fstat(ifd, &file_status) != 0
+        || (ofd = open(ofile, O_WRONLY | O_CREAT | O_TRUNC, 0666)) < 0) {
+      status = MB_FAILURE;
+      *error = MB_ERROR_OPEN_FAIL;
+    }
+  }
+
+  /* copy any file header preceding the first record and then the kept
+      records, merging adjacent records into single copies */
+  off_t copy_start = 0;
+  off_t copy_end = status == MB_SUCCESS ? (off_t)fileindex[0].offset : 0;
+  for (int i = 0; i < num_fileindex && status == MB_SUCCESS; i++) {
+    const off_t start = (off_t)fileindex[i].offset;
+    const off_t end = i < num_fileindex - 1 ? (off_t)fileindex[i + 1].offset : file_status.st_size;
+    bool keep = true;
+    if (fileindex[i].kind == MB_DATA_DATA) {
+      (*idata)++;
+
+      /* apply the checks of mb_get_all() to the indexed navigation */
+      double navlon = fileindex[i].navlon;
+      if (mb_io_ptr->lonflip < 0 && navlon > 0.0)
+        navlon -= 360.0;
+      else if (mb_io_ptr->lonflip == 0 && navlon < -180.0)
+        navlon += 360.0;
+      else if (mb_io_ptr->lonflip == 0 && navlon > 180.0)
+        navlon -= 360.0;
+      else if (mb_io_ptr->lonflip > 0 && navlon < 0.0)
+        navlon += 360.0;
+      const double time_d = fileindex[i].time_d;
+      if (navlon < mb_io_ptr->bounds[0] || navlon > mb_io_ptr->bounds[1] || fileindex[i].navlat < mb_io_ptr->bounds[2]
+          || fileindex[i].navlat > mb_io_ptr->bounds[3])
+        keep = false;
+      else if (mb_io_ptr->etime_d > mb_io_ptr->btime_d && time_d > MB_TIME_D_UNKNOWN
+               && (time_d > mb_io_ptr->etime_d || time_d < mb_io_ptr->btime_d))
+        keep = false;
+      else if (mb_io_ptr->etime_d < mb_io_ptr->btime_d && time_d > MB_TIME_D_UNKNOWN
+               && (time_d > mb_io_ptr->etime_d && time_d < mb_io_ptr->btime_d))
+        keep = false;
+      if (keep)
+        (*odata)++;
+    }
+    else if (fileindex[i].kind == MB_DATA_COMMENT) {
+      (*icomment)++;
+      keep = !stripcomments;
+      if (keep)
+        (*ocomment)++;
+    }
+    if (keep) {
+      if (start != copy_end) {
+        status = mbcopy_copy_range(verbose, ifd, ofd, copy_start, copy_end - copy_start, error);
+        copy_start = start;
+      }
+      copy_end = end;
+    }
+  }
+  if (status == MB_SUCCESS)
+    status = mbcopy_copy_range(verbose, ifd, ofd, copy_start, copy_end - copy_start, error);
+
+  if (ifd >= 0)
+    close(ifd);
+  if (ofd >= 0 && close(ofd) != 0 && status == MB_SUCCESS) {
+    status = MB_FAILURE;
+    *error = MB_ERROR_WRITE_FAIL;
+  }
+  if (fileindex != nullptr) {
+    int mem_error = MB_ERROR_NO_ERROR;
+    mb_freed(verbose, __FILE__, __LINE__, (void **)&fileindex, &mem_error);
+  }
+
+  if (verbose >= 2) {
+    fprintf(stderr, "\ndbg2  MBcopy function <%s> completed\n", __func__);
+    fprintf(stderr, "dbg2  Return values:\n");
+    fprintf(stderr, "dbg2       idata:      %d\n", *idata);
+    fprintf(stderr, "dbg2       icomment:   %d\n", *icomment);
+    fprintf(stderr, "dbg2       odata:      %d\n", *odata);
+    fprintf(stderr, "dbg2       ocomment:   %d\n", *ocomment);
+    fprintf(stderr, "dbg2       error:      %d\n", *error);
+    fprintf(stderr, "dbg2  Return status:\n");
+    fprintf(stderr, "dbg2       status:     %d\n", status);
+  }
+
+  return (status);
+}
 /*--------------------------------------------------------------------*/
 
 int main(int argc, char **argv) {
@@ -1661,12 +1823,13 @@ int main(int argc, char **argv) {
   char ofile[MB_PATH_MAXLINE] = "stdout";
   double sleep_factor = 1.0;
   bool use_sleep = false;
+  bool passthrough = false;
 
   {
     bool errflg = false;
     int c;
     bool help = false;
-    while ((c = getopt(argc, argv, "B:b:C:c:DdE:e:F:f:HhI:i:L:l:M:m:NnO:o:P:p:Q:q:R:r:S:s:T:t:Vv")) != -1)
+    while ((c = getopt(argc, argv, "B:b:C:c:DdE:e:F:f:HhI:i:L:l:M:m:NnO:o:P:p:Q:q:R:r:S:s:T:t:VvXx")) != -1)
       switch (c) {
       case 'B':
       case 'b':
@@ -1763,6 +1926,10 @@ int main(int argc, char **argv) {
       case 'v':
         verbose++;
         break;
+      case 'X':
+      case 'x':
+        passthrough = true;
+        break;
       case '?':
         errflg = true;
       }
@@ -1818,6 +1985,7 @@ int main(int argc, char **argv) {
       fprintf(stderr, "dbg2       bath only:      %d\n", bathonly);
       fprintf(stderr, "dbg2       use sleep:      %d\n", use_sleep);
       fprintf(stderr, "dbg2       sleep factor:   %f\n", sleep_factor);
+      fprintf(stderr, "dbg2       passthrough:    %d\n", passthrough);
       fprintf(stderr, "dbg2       fbtversion:     %d\n", fbtversion);
     }
 
@@ -1981,6 +2149,37 @@ int main(int argc, char **argv) {
   }
   imb_io_ptr = (struct mb_io_struct *)imbio_ptr;
 
+  /* copy the records byte for byte if requested and possible */
+  if (passthrough) {
+    if (iformat == oformat && pings == 1 && !merge && !insertcomments && !bathonly && !use_sleep && speedmin <= 0.0
+        && stripmode != MBCOPY_STRIPMODE_BATHYONLY && imb_io_ptr->record_contiguous && imb_io_ptr->mbfp != nullptr
+        && imb_io_ptr->mbfp != stdin
+        && (imb_io_ptr->filetype == MB_FILETYPE_NORMAL || imb_io_ptr->filetype == MB_FILETYPE_SINGLE)
+        && strcmp(ofile, "stdout") != 0) {
+      status = mbcopy_passthrough(verbose, imbio_ptr, ofile, stripmode != MBCOPY_STRIPMODE_NONE, &idata, &icomment,
+                                  &odata, &ocomment, &error);
+      if (status == MB_SUCCESS) {
+        status &= mb_close(verbose, &imbio_ptr, &error);
+        if (verbose >= 1) {
+          fprintf(stderr, "\n%d input data records\n", idata);
+          fprintf(stderr, "%d input comment records\n", icomment);
+          fprintf(stderr, "%d output data records\n", odata);
+          fprintf(stderr, "%d output comment records\n", ocomment);
+        }
+        exit(error);
+      }
+      fprintf(stderr, "\nUnable to copy file <%s> byte for byte, copying normally\n", ifile);
+      idata = 0;
+      icomment = 0;
+      odata = 0;
+      ocomment = 0;
+      error = MB_ERROR_NO_ERROR;
+    }
+    else {
+      fprintf(stderr, "\nByte for byte copying (-X) is not possible for this copy, copying normally\n");
+    }
+  }
+
   /* initialize reading the merge swath sonar file */
   if (merge &&
       (mb_read_init(verbose, mfile, mformat, pings, lonflip, bounds, btime_i, etime_i, speedmin, timegap, &mmbio_ptr,
@@ -52,7 +52,7 @@ constexpr char usage_message[] =
     "\t--format=format_id {-Fformat_id}\n\t--input=file {-Ifile}\n\t--make-ancillary {-N}\n"
     "\t--update-ancillary {-O}\n\t--processed {-P}\n\t--problem {-Q}\n"
     "\t--bounds=w/e/s/n {-Rw/e/s/n}\n\t--status\n"
-    "\t--raw {-U}\n\t--unlock {-Y}\n\t--datalistp {-Z}\n";
+    "\t--threads=nthreads {-Tnthreads}\n\t--raw {-U}\n\t--unlock {-Y}\n\t--datalistp {-Z}\n";
 
 /*--------------------------------------------------------------------*/
 
@@ -74,6 +74,7 @@ int main(int argc, char **argv) {
 	bool copyfiles = false;
 	bool force_update = false;
 	bool make_inf = false;
+	int nthreads = 1;
 	int look_processed = MB_DATALIST_LOOK_UNSET;
 	bool problem_report = false;
 	bool look_bounds = false;
@@ -98,6 +99,7 @@ int main(int argc, char **argv) {
 	                {"problem", no_argument, nullptr, 0},
 	                {"bounds", required_argument, nullptr, 0},
 	                {"status", no_argument, nullptr, 0},
+	                {"threads", required_argument, nullptr, 0},
 	                {"raw", no_argument, nullptr, 0},
 	                {"unlock", no_argument, nullptr, 0},
 	                {"datalistp", no_argument, nullptr, 0},
@@ -106,7 +108,7 @@ int main(int argc, char **argv) {
 		bool errflg = false;
 		int c;
 		bool help = false;
-		while ((c = getopt_long(argc, argv, "VvHhCcDdF:f:I:i:NnOoPpQqR:r:SsUuYyZz", options, &option_index)) != -1)
+		while ((c = getopt_long(argc, argv, "VvHhCcDdF:f:I:i:NnOoPpQqR:r:SsT:t:UuYyZz", options, &option_index)) != -1)
 		{
 			switch (c) {
 			/* long options */
@@ -149,6 +151,9 @@ int main(int argc, char **argv) {
 				else if (strcmp("status", options[option_index].name) == 0) {
 					status_report = true;
 				}
+				else if (strcmp("threads", options[option_index].name) == 0) {
+					sscanf(optarg, "%d", &nthreads);
+				}
 				else if (strcmp("raw", options[option_index].name) == 0) {
 					look_processed = MB_DATALIST_LOOK_NO;
 				}
@@ -208,6 +213,10 @@ int main(int argc, char **argv) {
 			case 's':
 				status_report = true;
 				break;
+			case 'T':
+			case 't':
+				sscanf(optarg, "%d", &nthreads);
+				break;
 			case 'U':
 			case 'u':
 				look_processed = MB_DATALIST_LOOK_NO;
@@ -258,6 +267,7 @@ int main(int argc, char **argv) {
 			fprintf(output, "dbg2       reportdatalists:     %d\n", reportdatalists);
 			fprintf(output, "dbg2       make_inf:            %d\n", make_inf);
 			fprintf(output, "dbg2       force_update:        %d\n", force_update);
+			fprintf(output, "dbg2       nthreads:            %d\n", nthreads);
 			fprintf(output, "dbg2       status_report:       %d\n", status_report);
 			fprintf(output, "dbg2       problem_report:      %d\n", problem_report);
 			fprintf(output, "dbg2       make_datalistp:      %d\n", make_datalistp);
@@ -439,20 +449,21 @@ int main(int argc, char **argv) {
 		mb_path file = "";
 		mb_path dfile = "";
 		mb_path dfilelast = "";
-		while (mb_datalist_read(verbose, datalist, file, dfile, &format, &file_weight, &error) == MB_SUCCESS) {
+
+		/* generate inf fnv fbt files for all files in the datalist, in parallel if requested */
+		if (make_inf) {
+			status = mb_make_info_datalist(verbose, force_update, datalist, nthreads, &nfile, &error);
+		}
+
+		while (!make_inf && mb_datalist_read(verbose, datalist, file, dfile, &format, &file_weight, &error) == MB_SUCCESS) {
 			nfile++;
 			mb_path pwd = "";
       		assert(getcwd(pwd, MB_PATH_MAXLINE) != NULL);
 			mb_get_relative_path(verbose, file, pwd, &error);
 			mb_get_relative_path(verbose, dfile, pwd, &error);
 
-			/* generate inf fnv fbt files */
-			if (make_inf) {
-				status = mb_make_info(verbose, force_update, file, format, &error);
-			}
-
-			/* or generate problem reports */
-			else if (problem_report) {
+			/* generate problem reports */
+			if (problem_report) {
 				status = mb_pr_check(verbose, file, &nparproblem, &ndataproblem, &error);
 				if (nparproblem + ndataproblem > 0)
 					nproblemfiles++;
@@ -70,8 +70,8 @@ constexpr char help_message[] =
     "arguments will be changed; if no ~/.mbio_defaults\n"
     "file exists one will be created.";
 constexpr char usage_message[] =
-    "mbdefaults [-Bfileiobuffer -Dpsdisplay -Ffbtversion -Iimagedisplay -Llonflip\n"
-    "    -Mmbviewsettings\n\t-Ttimegap -Wproject -V -H]";
+    "mbdefaults [-Bfileiobuffer -Cpingcache -Dpsdisplay -Ffbtversion -Iimagedisplay -Llonflip\n"
+    "    -Mmbviewsettings -Rreadahead[/readthreads]\n\t-Ttimegap -Wproject -V -H]";
 
 /*--------------------------------------------------------------------*/
 
@@ -123,13 +123,20 @@ int main(int argc, char **argv) {
 	int fileiobuffer = 0;
 	status &= mb_fileiobuffer(verbose, &fileiobuffer);
 
+	int readahead = 0;
+	int readthreads = 1;
+	status &= mb_readahead(verbose, &readahead, &readthreads);
+
+	char pingcache[MB_PATH_MAXLINE];
+	status &= mb_pingcache(verbose, pingcache);
+
 	bool flag = false;
 
 	{
 		bool errflg = false;
 		bool help = false;
 		int c;
-		while ((c = getopt(argc, argv, "B:b:D:d:F:f:HhI:i:L:l:M:m:T:t:U:u:VvW:w:")) != -1)
+		while ((c = getopt(argc, argv, "B:b:C:c:D:d:F:f:HhI:i:L:l:M:m:R:r:T:t:U:u:VvW:w:")) != -1)
 		{
 			switch (c) {
 			case 'B':
@@ -137,6 +144,11 @@ int main(int argc, char **argv) {
 				sscanf(optarg, "%d", &fileiobuffer);
 				flag = true;
 				break;
+			case 'C':
+			case 'c':
+				sscanf(optarg, "%1023s", pingcache);
+				flag = true;
+				break;
 			case 'D':
 			case 'd':
 				sscanf(optarg, "%1023s", psdisplay);
@@ -199,6 +211,11 @@ int main(int argc, char **argv) {
 				flag = true;
 				break;
 			}
+			case 'R':
+			case 'r':
+				sscanf(optarg, "%d/%d", &readahead, &readthreads);
+				flag = true;
+				break;
 			case 'T':
 			case 't':
 				sscanf(optarg, "%lf", &timegap);
@@ -279,6 +296,9 @@ int main(int argc, char **argv) {
 			fprintf(stderr, "dbg2       fbtversion:                 %d\n", fbtversion);
 			fprintf(stderr, "dbg2       uselockfiles:               %d\n", uselockfiles);
 			fprintf(stderr, "dbg2       fileiobuffer:               %d\n", fileiobuffer);
+			fprintf(stderr, "dbg2       readahead:                  %d\n", readahead);
+			fprintf(stderr, "dbg2       readthreads:                %d\n", readthreads);
+			fprintf(stderr, "dbg2       pingcache:                  %s\n", pingcache);
 			fprintf(stderr, "dbg2       primary_colortable:         %d\n", primary_colortable);
 			fprintf(stderr, "dbg2       primary_colortable_mode:    %d\n", primary_colortable_mode);
 			fprintf(stderr, "dbg2       primary_shade_mode:         %d\n", primary_shade_mode);
@@ -318,6 +338,9 @@ int main(int argc, char **argv) {
 		fprintf(fp, "fbtversion: %d\n", fbtversion);
 		fprintf(fp, "uselockfiles:%d\n", uselockfiles);
 		fprintf(fp, "fileiobuffer:%d\n", fileiobuffer);
+		fprintf(fp, "readahead:%d\n", readahead);
+		fprintf(fp, "readthreads:%d\n", readthreads);
+		fprintf(fp, "pingcache: %s\n", pingcache);
 		fprintf(fp, "mbview_primary_colortable:        %d\n", primary_colortable);
 		fprintf(fp, "mbview_primary_colortable_mode:   %d\n", primary_colortable_mode);
 		fprintf(fp, "mbview_primary_shade_mode:        %d\n", primary_shade_mode);
@@ -350,6 +373,18 @@ int main(int argc, char **argv) {
 			printf("fileiobuffer: %d (use %d kB buffer for fread() & fwrite())\n", fileiobuffer, fileiobuffer);
 		else
 			printf("fileiobuffer: %d (use mmap for file i/o)\n", fileiobuffer);
+		if (readahead > 0)
+			printf("readahead: %d (read up to %d records ahead in a background thread)\n", readahead, readahead);
+		else
+			printf("readahead: %d (read synchronously)\n", readahead);
+		if (readthreads > 1)
+			printf("readthreads: %d (decode records read ahead in %d threads where the format allows)\n", readthreads, readthreads);
+		else
+			printf("readthreads: %d\n", readthreads);
+		if (strcmp(pingcache, "none") != 0)
+			printf("pingcache: %s (keep pings decoded by mbinfo and mbgrid in this directory)\n", pingcache);
+		else
+			printf("pingcache: %s\n", pingcache);
 		if (primary_colortable == MBV_COLORTABLE_HAXBY)
 			printf("mbview primary colortable:    %d  (Haxby)\n", primary_colortable);
 		else if (primary_colortable == MBV_COLORTABLE_BRIGHT)
@@ -440,6 +475,18 @@ int main(int argc, char **argv) {
 			printf("fileiobuffer: %d (use %d kB buffer for fread() & fwrite())\n", fileiobuffer, fileiobuffer);
 		else
 			printf("fileiobuffer: %d (use mmap for file i/o)\n", fileiobuffer);
+		if (readahead > 0)
+			printf("readahead: %d (read up to %d records ahead in a background thread)\n", readahead, readahead);
+		else
+			printf("readahead: %d (read synchronously)\n", readahead);
+		if (readthreads > 1)
+			printf("readthreads: %d (decode records read ahead in %d threads where the format allows)\n", readthreads, readthreads);
+		else
+			printf("readthreads: %d\n", readthreads);
+		if (strcmp(pingcache, "none") != 0)
+			printf("pingcache: %s (keep pings decoded by mbinfo and mbgrid in this directory)\n", pingcache);
+		else
+			printf("pingcache: %s\n", pingcache);
 		if (primary_colortable == MBV_COLORTABLE_HAXBY)
 			printf("mbview primary colortable:         %d  (Haxby)\n", primary_colortable);
 		else if (primary_colortable == MBV_COLORTABLE_BRIGHT)
@@ -46,14 +46,21 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <getopt.h>
 #include <limits>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include "mb_aux.h"
 #include "mb_define.h"
@@ -112,6 +119,7 @@ typedef enum {
     MBGRID_INTERP_GAP = 1,
     MBGRID_INTERP_NEAR = 2,
     MBGRID_INTERP_ALL = 3,
+    MBGRID_INTERP_NEAREST = 4,
 } grid_interp_t;
 
 /* shift mode */
@@ -128,16 +136,10 @@ constexpr double MBGRID_TINY = 0.00000001;
 constexpr double FOOT_THETA_MAX = 85.0;
 
 /* interpolation algorithm
-    The code is set to use either of two
-    algorithms for 2D thin plate spline
-    interpolation. If the USESURFACE preprocessor
-    define is defined then
-    the code will use the surface algorithm
-    from GMT. If not, then the zgrid
-    algorithm will be used.
-    - The default is to use zgrid - to
-    change this uncomment the define below. */
-/* #define USESURFACE */
+    The code uses either of two algorithms for 2D thin plate
+    spline interpolation. By default the zgrid algorithm is
+    used; the --surface option selects the surface algorithm
+    from GMT, which can use the -Z threads. */
 
 /* output stream for basic stuff (stdout if verbose <= 1,
     stderr if verbose > 1) */
@@ -157,7 +159,8 @@ constexpr char usage_message[] =
     "mbgrid   -Ifilelist -Oroot [-Adatatype -Bborder -Cclip[/mode] -Dxdim/ydim\n"
     "          -Edx/dy/units[!]  -Fmode[/threshold] -Ggridkind -Jprojection\n"
     "          -Kbackground -Llonflip -M -N -Ppings -Q  -Rwest/east/south/north\n"
-    "          -Rfactor  -Sspeed  -Ttension  -Utime  -V -Wscale -Xextend]";
+    "          -Rfactor  -Sspeed  -Ttension  -Utime  -V -Wscale -Xextend -Zthreads\n"
+    "          --incremental --surface]";
 
 /*--------------------------------------------------------------------*/
 /* approximate error function altered from numerical recipes */
@@ -436,6 +439,944 @@ int mbgrid_weight(int verbose, double foot_a, double foot_b, double pcx, double
   return (status);
 }
 
+/*--------------------------------------------------------------------*/
+/* Tiled multithreaded gridding. The soundings are gathered in batches
+ * and each is routed to the square tiles of bins it contributes to,
+ * which includes neighboring tiles reached by the halo of bins around
+ * its own bin. The tiles of a batch are then accumulated by worker
+ * threads, each tile by a single thread, while the next batch is read.
+ * Every bin belongs to one tile and receives its contributions in the
+ * order the soundings were read, so the grids are bit for bit the same
+ * as when each sounding is accumulated as soon as it is read, which is
+ * what is done when a single thread is used. */
+
+/* kernels used to accumulate a sounding into the grid */
+typedef enum {
+    MBGRID_KERNEL_GAUSSIAN = 0,
+    MBGRID_KERNEL_FILTER = 1,
+    MBGRID_KERNEL_FOOTPRINT = 2,
+    MBGRID_KERNEL_POINT = 3,
+} grid_kernel_t;
+
+/* maximum and minimum tile dimensions in bins */
+constexpr int MBGRID_TILE_DIM_MAX = 256;
+constexpr int MBGRID_TILE_DIM_MIN = 16;
+
+/* number of soundings accumulated by the worker threads at a time */
+constexpr size_t MBGRID_BATCH_SIZE = 262144;
+
+struct mbgrid_sounding {
+  grid_kernel_t kernel;
+  int ix;              /* bin containing the sounding */
+  int iy;
+  int dix;             /* half widths in bins of the neighborhood the sounding contributes to */
+  int diy;
+  double x;            /* sounding position */
+  double y;
+  double factor;       /* factor applied to the value (topofactor for bathymetry) */
+  double value;
+  double weight;       /* file weight */
+  double foot_hwidth;  /* footprint half width and half length */
+  double foot_hlength;
+  double foot_dxn;     /* unit vector along the horizontal projection of the beam */
+  double foot_dyn;
+  bool slope;          /* if true the value is extended over the footprint using the slope */
+  double dzdx;
+  double dzdy;
+};
+
+struct mbgrid_tiles_struct {
+  /* grid */
+  int verbose;
+  grid_alg_t grid_mode;
+  int gxdim;
+  int gydim;
+  double xmin;
+  double ymin;
+  double dx;
+  double dy;
+  double factor;
+  bool use_projection;
+  double mtodeglon;
+  double mtodeglat;
+  double *grid;
+  double *norm;
+  double *sigma;
+  int *num;
+  int *cnt;
+
+  /* tiles and batches of soundings, one being filled while the other is accumulated */
+  int nthreads;
+  int tiledim;
+  int ntx;
+  int nty;
+  int current;
+  std::vector<mbgrid_sounding> batch[2];
+  std::vector<std::vector<int>> route[2];
+  std::vector<int> active[2];
+  std::atomic<size_t> next_tile;
+  std::vector<std::thread> workers;
+
+  /* tiles added to since the bins were last collected, tracked only for incremental gridding */
+  std::vector<bool> touched;
+};
+
+/*--------------------------------------------------------------------*/
+/* add the contributions of a sounding to the bins ix1 to ix2 and iy1 to iy2 */
+void mbgrid_accumulate(const struct mbgrid_tiles_struct *tiles, const struct mbgrid_sounding &sounding,
+                       int ix1, int ix2, int iy1, int iy2) {
+  const int gydim = tiles->gydim;
+  const double dx = tiles->dx;
+  const double dy = tiles->dy;
+  double *grid = tiles->grid;
+  double *norm = tiles->norm;
+  double *sigma = tiles->sigma;
+  int *num = tiles->num;
+  int *cnt = tiles->cnt;
+
+  if (sounding.kernel == MBGRID_KERNEL_GAUSSIAN) {
+    for (int ii = ix1; ii <= ix2; ii++)
+      for (int jj = iy1; jj <= iy2; jj++) {
+        const int kgrid = ii * gydim + jj;
+        const double xx = tiles->xmin + ii * dx - sounding.x;
+        const double yy = tiles->ymin + jj * dy - sounding.y;
+        const double weight = sounding.weight * exp(-(xx * xx + yy * yy) * tiles->factor);
+        norm[kgrid] = norm[kgrid] + weight;
+        grid[kgrid] = grid[kgrid] + weight * sounding.factor * sounding.value;
+        sigma[kgrid] = sigma[kgrid] + weight * sounding.factor * sounding.factor * sounding.value * sounding.value;
+        num[kgrid]++;
+        if (ii == sounding.ix && jj == sounding.iy)
+          cnt[kgrid]++;
+      }
+  }
+
+  else if (sounding.kernel == MBGRID_KERNEL_FILTER) {
+    const int kgrid = sounding.ix * gydim + sounding.iy;
+    if ((num[kgrid] > 0 && tiles->grid_mode == MBGRID_MINIMUM_FILTER &&
+         grid[kgrid] > sounding.factor * sounding.value) ||
+        (num[kgrid] > 0 && tiles->grid_mode == MBGRID_MAXIMUM_FILTER &&
+         grid[kgrid] < sounding.factor * sounding.value) ||
+        num[kgrid] <= 0) {
+      norm[kgrid] = 1.0;
+      grid[kgrid] = sounding.factor * sounding.value;
+      sigma[kgrid] = sounding.factor * sounding.factor * sounding.value * sounding.value;
+      num[kgrid] = 1;
+      cnt[kgrid] = 1;
+    }
+  }
+
+  else if (sounding.kernel == MBGRID_KERNEL_FOOTPRINT) {
+    for (int ii = ix1; ii <= ix2; ii++)
+      for (int jj = iy1; jj <= iy2; jj++) {
+        /* find center of bin in lon lat degrees from sounding center */
+        const int kgrid = ii * gydim + jj;
+        const double xx = (tiles->xmin + ii * dx + 0.5 * dx - sounding.x);
+        const double yy = (tiles->ymin + jj * dy + 0.5 * dy - sounding.y);
+
+        /* get depth or topo value at this point, using the slope estimate if available */
+        double sbath;
+        if (sounding.slope)
+          sbath = sounding.factor * sounding.value + sounding.dzdx * xx + sounding.dzdy * yy;
+        else
+          sbath = sounding.factor * sounding.value;
+
+        /* get center and corners of bin in meters from sounding center */
+        double xx0;
+        double yy0;
+        double bdx;
+        double bdy;
+        if (tiles->use_projection) {
+          xx0 = xx;
+          yy0 = yy;
+          bdx = 0.5 * dx;
+          bdy = 0.5 * dy;
+        }
+        else {
+          xx0 = xx / tiles->mtodeglon;
+          yy0 = yy / tiles->mtodeglat;
+          bdx = 0.5 * dx / tiles->mtodeglon;
+          bdy = 0.5 * dy / tiles->mtodeglat;
+        }
+        const double xx1 = xx0 - bdx;
+        const double xx2 = xx0 + bdx;
+        const double yy1 = yy0 - bdy;
+        const double yy2 = yy0 + bdy;
+
+        /* rotate center and corners of bin to footprint coordinates */
+        const double foot_dxn = sounding.foot_dxn;
+        const double foot_dyn = sounding.foot_dyn;
+        double prx[5];
+        double pry[5];
+        prx[0] = xx0 * foot_dxn + yy0 * foot_dyn;
+        pry[0] = -xx0 * foot_dyn + yy0 * foot_dxn;
+        prx[1] = xx1 * foot_dxn + yy1 * foot_dyn;
+        pry[1] = -xx1 * foot_dyn + yy1 * foot_dxn;
+        prx[2] = xx2 * foot_dxn + yy1 * foot_dyn;
+        pry[2] = -xx2 * foot_dyn + yy1 * foot_dxn;
+        prx[3] = xx1 * foot_dxn + yy2 * foot_dyn;
+        pry[3] = -xx1 * foot_dyn + yy2 * foot_dxn;
+        prx[4] = xx2 * foot_dxn + yy2 * foot_dyn;
+        pry[4] = -xx2 * foot_dyn + yy2 * foot_dxn;
+
+        /* get weight integrated over bin, without debug output from the worker threads */
+        double weight;
+        grid_use_t use_weight;
+        int error = MB_ERROR_NO_ERROR;
+        mbgrid_weight(tiles->nthreads > 1 ? 0 : tiles->verbose, sounding.foot_hwidth, sounding.foot_hlength, prx[0],
+                      pry[0], bdx, bdy, &prx[1], &pry[1], &weight, &use_weight, &error);
+
+        if (use_weight != MBGRID_USE_NO && weight > 0.000001) {
+          weight *= sounding.weight;
+          norm[kgrid] = norm[kgrid] + weight;
+          grid[kgrid] = grid[kgrid] + weight * sbath;
+          sigma[kgrid] = sigma[kgrid] + weight * sbath * sbath;
+          if (use_weight == MBGRID_USE_YES) {
+            num[kgrid]++;
+            if (ii == sounding.ix && jj == sounding.iy)
+              cnt[kgrid]++;
+          }
+        }
+      }
+  }
+
+  else if (sounding.kernel == MBGRID_KERNEL_POINT) {
+    const int kgrid = sounding.ix * gydim + sounding.iy;
+    norm[kgrid] = norm[kgrid] + sounding.weight;
+    grid[kgrid] = grid[kgrid] + sounding.weight * sounding.factor * sounding.value;
+    sigma[kgrid] = sigma[kgrid] + sounding.weight * sounding.factor * sounding.factor * sounding.value * sounding.value;
+    num[kgrid]++;
+    cnt[kgrid]++;
+  }
+}
+
+/*--------------------------------------------------------------------*/
+/* set up gridding with nthreads worker threads, accumulating each
+    sounding as it is added if nthreads is one */
+void mbgrid_tiles_init(struct mbgrid_tiles_struct *tiles, int verbose, grid_alg_t grid_mode, int nthreads,
+                       int gxdim, int gydim, const double *wbnd, double dx, double dy, double factor,
+                       bool use_projection, double mtodeglon, double mtodeglat, double *grid, double *norm,
+                       double *sigma, int *num, int *cnt) {
+  tiles->verbose = verbose;
+  tiles->grid_mode = grid_mode;
+  tiles->gxdim = gxdim;
+  tiles->gydim = gydim;
+  tiles->xmin = wbnd[0];
+  tiles->ymin = wbnd[2];
+  tiles->dx = dx;
+  tiles->dy = dy;
+  tiles->factor = factor;
+  tiles->use_projection = use_projection;
+  tiles->mtodeglon = mtodeglon;
+  tiles->mtodeglat = mtodeglat;
+  tiles->grid = grid;
+  tiles->norm = norm;
+  tiles->sigma = sigma;
+  tiles->num = num;
+  tiles->cnt = cnt;
+  tiles->nthreads = std::max(nthreads, 1);
+
+  /* use tiles small enough that there are several per thread */
+  tiles->tiledim = MBGRID_TILE_DIM_MAX;
+  while (tiles->tiledim > MBGRID_TILE_DIM_MIN &&
+         ((gxdim - 1) / tiles->tiledim + 1) * ((gydim - 1) / tiles->tiledim + 1) < 16 * tiles->nthreads)
+    tiles->tiledim /= 2;
+  tiles->ntx = (gxdim - 1) / tiles->tiledim + 1;
+  tiles->nty = (gydim - 1) / tiles->tiledim + 1;
+  tiles->current = 0;
+  if (tiles->nthreads > 1) {
+    for (int i = 0; i < 2; i++) {
+      tiles->batch[i].reserve(MBGRID_BATCH_SIZE);
+      tiles->route[i].resize(tiles->ntx * tiles->nty);
+    }
+  }
+}
+
+/*--------------------------------------------------------------------*/
+/* accumulate the soundings of batch ibatch routed to the tiles not yet taken by another thread */
+void mbgrid_tiles_work(struct mbgrid_tiles_struct *tiles, int ibatch) {
+  const std::vector<mbgrid_sounding> &batch = tiles->batch[ibatch];
+  const std::vector<int> &active = tiles->active[ibatch];
+  for (size_t i = tiles->next_tile++; i < active.size(); i = tiles->next_tile++) {
+    const int itile = active[i];
+    const int tx1 = (itile / tiles->nty) * tiles->tiledim;
+    const int tx2 = std::min(tx1 + tiles->tiledim, tiles->gxdim) - 1;
+    const int ty1 = (itile % tiles->nty) * tiles->tiledim;
+    const int ty2 = std::min(ty1 + tiles->tiledim, tiles->gydim) - 1;
+    for (const int isounding : tiles->route[ibatch][itile]) {
+      const mbgrid_sounding &sounding = batch[isounding];
+      mbgrid_accumulate(tiles, sounding, std::max(sounding.ix - sounding.dix, tx1),
+                        std::min(sounding.ix + sounding.dix, tx2), std::max(sounding.iy - sounding.diy, ty1),
+                        std::min(sounding.iy + sounding.diy, ty2));
+    }
+  }
+}
+
+/*--------------------------------------------------------------------*/
+/* wait for the batch being accumulated, then start accumulating the
+    batch being filled unless finishing */
+void mbgrid_tiles_flush(struct mbgrid_tiles_struct *tiles, bool finish) {
+  for (std::thread &worker : tiles->workers)
+    worker.join();
+  tiles->workers.clear();
+
+  /* the batch accumulated is emptied to be filled next */
+  const int ibatch = tiles->current;
+  const int inext = 1 - ibatch;
+  for (const int itile : tiles->active[inext])
+    tiles->route[inext][itile].clear();
+  tiles->active[inext].clear();
+  tiles->batch[inext].clear();
+  tiles->current = inext;
+
+  if (!tiles->active[ibatch].empty()) {
+    tiles->next_tile = 0;
+    for (int i = 0; i < tiles->nthreads; i++)
+      tiles->workers.emplace_back(mbgrid_tiles_work, tiles, ibatch);
+  }
+
+  /* when finishing wait for the last batch too */
+  if (finish && !tiles->workers.empty())
+    mbgrid_tiles_flush(tiles, false);
+}
+
+/*--------------------------------------------------------------------*/
+/* add a sounding to the grid */
+void mbgrid_tiles_add(struct mbgrid_tiles_struct *tiles, const struct mbgrid_sounding &sounding) {
+  const int ix1 = std::max(sounding.ix - sounding.dix, 0);
+  const int ix2 = std::min(sounding.ix + sounding.dix, tiles->gxdim - 1);
+  const int iy1 = std::max(sounding.iy - sounding.diy, 0);
+  const int iy2 = std::min(sounding.iy + sounding.diy, tiles->gydim - 1);
+  if (ix1 > ix2 || iy1 > iy2)
+    return;
+
+  if (!tiles->touched.empty())
+    for (int tx = ix1 / tiles->tiledim; tx <= ix2 / tiles->tiledim; tx++)
+      for (int ty = iy1 / tiles->tiledim; ty <= iy2 / tiles->tiledim; ty++)
+        tiles->touched[tx * tiles->nty + ty] = true;
+
+  if (tiles->nthreads <= 1) {
+    mbgrid_accumulate(tiles, sounding, ix1, ix2, iy1, iy2);
+    return;
+  }
+
+  /* route the sounding to each tile it contributes to */
+  const int ibatch = tiles->current;
+  const int isounding = tiles->batch[ibatch].size();
+  tiles->batch[ibatch].push_back(sounding);
+  for (int tx = ix1 / tiles->tiledim; tx <= ix2 / tiles->tiledim; tx++)
+    for (int ty = iy1 / tiles->tiledim; ty <= iy2 / tiles->tiledim; ty++) {
+      const int itile = tx * tiles->nty + ty;
+      if (tiles->route[ibatch][itile].empty())
+        tiles->active[ibatch].push_back(itile);
+      tiles->route[ibatch][itile].push_back(isounding);
+    }
+
+  if (tiles->batch[ibatch].size() >= MBGRID_BATCH_SIZE)
+    mbgrid_tiles_flush(tiles, false);
+}
+
+/*--------------------------------------------------------------------*/
+/* Out of core median gridding. Rather than holding every value binned
+ * in memory, the values are buffered by tile in single precision and,
+ * whenever the buffers reach the memory limit, appended as chunks to a
+ * scratch file. The tiles are then loaded from the scratch file and
+ * reduced one at a time, so that the memory needed is bounded by the
+ * memory limit and by the number of values in the densest tile rather
+ * than by the total number of values. */
+
+/* a value binned in the grid as stored in the scratch file */
+struct mbgrid_spill_value {
+  int kgrid;
+  float value;
+};
+
+/* a run of values of one tile in the scratch file */
+struct mbgrid_spill_chunk {
+  off_t offset;
+  size_t count;
+};
+
+struct mbgrid_spill_struct {
+  int verbose;
+  int gydim;
+  int tiledim;
+  int ntx;
+  int nty;
+  size_t max_buffered;
+  size_t nbuffered;
+  FILE *fp;
+  off_t size;
+  int *total;  /* number of values added to each bin */
+  std::vector<std::vector<mbgrid_spill_value>> buffer;
+  std::vector<std::vector<mbgrid_spill_chunk>> chunks;
+  int error;   /* the first error writing the scratch file */
+};
+
+/*--------------------------------------------------------------------*/
+/* open the scratch file and set up buffering at most memory bytes of values */
+int mbgrid_spill_init(struct mbgrid_spill_struct *spill, int verbose, int gxdim, int gydim, double memory,
+                      const char *scratchfile, int *error) {
+  spill->verbose = verbose;
+  spill->gydim = gydim;
+  spill->tiledim = MBGRID_TILE_DIM_MAX;
+  spill->ntx = (gxdim - 1) / spill->tiledim + 1;
+  spill->nty = (gydim - 1) / spill->tiledim + 1;
+  spill->max_buffered = std::max(memory / sizeof(mbgrid_spill_value), 1.0);
+  spill->nbuffered = 0;
+  spill->size = 0;
+  spill->total = nullptr;
+  spill->error = MB_ERROR_NO_ERROR;
+  spill->buffer.resize(spill->ntx * spill->nty);
+  spill->chunks.resize(spill->ntx * spill->nty);
+
+  /* the scratch file is removed as soon as it is open so that it
+      does not outlive the program */
+  spill->fp = fopen(scratchfile, "w+b");
+  if (spill->fp == nullptr) {
+    *error = MB_ERROR_OPEN_FAIL;
+    return (MB_FAILURE);
+  }
+  unlink(scratchfile);
+
+  const int status = mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(int), (void **)&spill->total, error);
+  if (status == MB_SUCCESS)
+    memset(spill->total, 0, gxdim * gydim * sizeof(int));
+  return (status);
+}
+
+/*--------------------------------------------------------------------*/
+/* append the buffered values to the scratch file */
+void mbgrid_spill_flush(struct mbgrid_spill_struct *spill) {
+  for (size_t itile = 0; itile < spill->buffer.size(); itile++) {
+    std::vector<mbgrid_spill_value> &buffer = spill->buffer[itile];
+    if (buffer.empty())
+      continue;
+    if (spill->error == MB_ERROR_NO_ERROR) {
+      if (fwrite(buffer.data(), sizeof(mbgrid_spill_value), buffer.size(), spill->fp) == buffer.size()) {
+        spill->chunks[itile].push_back({spill->size, buffer.size()});
+        spill->size += buffer.size() * sizeof(mbgrid_spill_value);
+      }
+      else
+        spill->error = MB_ERROR_WRITE_FAIL;
+    }
+    buffer.clear();
+  }
+  spill->nbuffered = 0;
+}
+
+/*--------------------------------------------------------------------*/
+/* add a value to bin kgrid at ix, iy */
+void mbgrid_spill_add(struct mbgrid_spill_struct *spill, int ix, int iy, double value) {
+  const int kgrid = ix * spill->gydim + iy;
+  const int itile = (ix / spill->tiledim) * spill->nty + iy / spill->tiledim;
+  spill->buffer[itile].push_back({kgrid, static_cast<float>(value)});
+  spill->total[kgrid]++;
+  spill->nbuffered++;
+  if (spill->nbuffered >= spill->max_buffered)
+    mbgrid_spill_flush(spill);
+}
+
+/*--------------------------------------------------------------------*/
+/* get the values added to a tile ordered by bin, with the values of
+    each bin in the order they were added */
+int mbgrid_spill_tile(struct mbgrid_spill_struct *spill, int itile, std::vector<mbgrid_spill_value> &values,
+                      int *error) {
+  values.clear();
+  for (const mbgrid_spill_chunk &chunk : spill->chunks[itile]) {
+    const size_t nvalues = values.size();
+    values.resize(nvalues + chunk.count);
+    if (fseeko(spill->fp, chunk.offset, SEEK_SET) != 0 ||
+        fread(&values[nvalues], sizeof(mbgrid_spill_value), chunk.count, spill->fp) != chunk.count) {
+      *error = MB_ERROR_EOF;
+      return (MB_FAILURE);
+    }
+  }
+  values.insert(values.end(), spill->buffer[itile].begin(), spill->buffer[itile].end());
+  std::stable_sort(values.begin(), values.end(),
+                   [](const mbgrid_spill_value &a, const mbgrid_spill_value &b) { return a.kgrid < b.kgrid; });
+  return (MB_SUCCESS);
+}
+
+/*--------------------------------------------------------------------*/
+/* close the scratch file and release the buffers */
+int mbgrid_spill_close(struct mbgrid_spill_struct *spill, int *error) {
+  if (spill->fp != nullptr)
+    fclose(spill->fp);
+  spill->fp = nullptr;
+  std::vector<std::vector<mbgrid_spill_value>>().swap(spill->buffer);
+  std::vector<std::vector<mbgrid_spill_chunk>>().swap(spill->chunks);
+  return (mb_freed(spill->verbose, __FILE__, __LINE__, (void **)&spill->total, error));
+}
+
+/*--------------------------------------------------------------------*/
+/* Incremental weighted mean gridding. The sums behind the weighted
+ * mean grid are saved in an accumulator file alongside the grid as the
+ * contribution of each file gridded, identified by the line of the
+ * file in the output datalist and by the modification times (to the
+ * nanosecond) and sizes of the files read. When mbgrid is run again
+ * with the same gridding parameters the saved contributions of
+ * unchanged files are reused rather than read again, so that only new
+ * or changed files are gridded and the contributions of files no longer
+ * in the datalist are dropped. The sums are then rebuilt from the contributions of the
+ * files in the datalist, so that repeated updates do not accumulate
+ * the round off of subtracting and adding contributions. */
+
+constexpr char MBGRID_ACC_MAGIC[16] = "MBGRID ACC 2";
+
+/* number of contributions copied or summed at a time */
+constexpr size_t MBGRID_ACC_CHUNK = 65536;
+
+/* the contribution of a file to a bin */
+struct mbgrid_acc_cell {
+  int kgrid;
+  int num;
+  int cnt;
+  double grid;
+  double norm;
+  double sigma;
+};
+
+/* a file gridded into the accumulator */
+struct mbgrid_acc_file {
+  std::string key;  /* the line of the file in the output datalist */
+  int64_t stamp[6]; /* modification time (seconds and nanoseconds) and size of the file and of any
+                        alternative navigation */
+  int ndata;
+  int64_t ncells;
+  off_t offset;     /* where the contributions are in the accumulator file */
+  bool used;
+};
+
+struct mbgrid_acc_struct {
+  int verbose;
+  FILE *ifp;                               /* the accumulator saved before, if any */
+  std::vector<mbgrid_acc_file> files;      /* the files in the accumulator saved before */
+  std::map<std::string, size_t> index;
+  FILE *ofp;                               /* the accumulator being written */
+  off_t nfiles_offset;
+  int64_t nfiles;
+  std::vector<mbgrid_acc_cell> cells;
+  int error;                               /* the first error writing the accumulator */
+};
+
+/*--------------------------------------------------------------------*/
+/* identify the state of a file from its line in the output datalist
+    and from the files read, navfile being nullptr unless alternative
+    navigation is used */
+void mbgrid_acc_identify(struct mbgrid_acc_file *file, int pstatus, int astatus, const char *path, int format,
+                         double file_weight, const char *apath, const char *rfile, const char *navfile) {
+  char line[3 * MB_PATH_MAXLINE];
+  if (pstatus == MB_PROCESSED_USE && astatus == MB_ALTNAV_USE)
+    snprintf(line, sizeof(line), "A:%s %d %f %s", path, format, file_weight, apath);
+  else if (pstatus == MB_PROCESSED_USE)
+    snprintf(line, sizeof(line), "P:%s %d %f", path, format, file_weight);
+  else
+    snprintf(line, sizeof(line), "R:%s %d %f", path, format, file_weight);
+  file->key = line;
+
+  struct stat file_status;
+  for (int i = 0; i < 6; i++)
+    file->stamp[i] = -1;
+  if (stat(rfile, &file_status) == 0) {
+    file->stamp[0] = file_status.st_mtim.tv_sec;
+    file->stamp[1] = file_status.st_mtim.tv_nsec;
+    file->stamp[2] = file_status.st_size;
+  }
+  if (navfile != nullptr && stat(navfile, &file_status) == 0) {
+    file->stamp[3] = file_status.st_mtim.tv_sec;
+    file->stamp[4] = file_status.st_mtim.tv_nsec;
+    file->stamp[5] = file_status.st_size;
+  }
+  file->ndata = 0;
+  file->ncells = 0;
+  file->offset = 0;
+  file->used = false;
+}
+
+/*--------------------------------------------------------------------*/
+bool mbgrid_acc_read_string(FILE *fp, std::string &value) {
+  int length;
+  if (fread(&length, sizeof(int), 1, fp) != 1 || length < 0 || length > 4 * MB_PATH_MAXLINE)
+    return false;
+  value.resize(length);
+  return length == 0 || fread(&value[0], 1, length, fp) == (size_t)length;
+}
+
+/*--------------------------------------------------------------------*/
+bool mbgrid_acc_write_string(FILE *fp, const std::string &value) {
+  const int length = value.size();
+  return fwrite(&length, sizeof(int), 1, fp) == 1 && fwrite(value.data(), 1, length, fp) == (size_t)length;
+}
+
+/*--------------------------------------------------------------------*/
+/* open an accumulator file and read its index of files, failing with
+    MB_ERROR_OPEN_FAIL if there is none and with MB_ERROR_BAD_FORMAT if it
+    is unreadable or was saved with other gridding parameters */
+int mbgrid_acc_open(int verbose, const char *accfile, const char *signature, FILE **fp,
+                    std::vector<mbgrid_acc_file> &files, int *error) {
+  files.clear();
+  *fp = fopen(accfile, "rb");
+  if (*fp == nullptr) {
+    *error = MB_ERROR_OPEN_FAIL;
+    return (MB_FAILURE);
+  }
+
+  off_t size = 0;
+  if (fseeko(*fp, 0, SEEK_END) == 0)
+    size = ftello(*fp);
+  rewind(*fp);
+  char magic[sizeof(MBGRID_ACC_MAGIC)];
+  std::string saved;
+  int64_t nfiles = 0;
+  bool ok = fread(magic, sizeof(magic), 1, *fp) == 1 && memcmp(magic, MBGRID_ACC_MAGIC, sizeof(magic)) == 0 &&
+            mbgrid_acc_read_string(*fp, saved) && saved == signature && fread(&nfiles, sizeof(int64_t), 1, *fp) == 1;
+  for (int64_t i = 0; ok && i < nfiles; i++) {
+    mbgrid_acc_file file;
+    ok = mbgrid_acc_read_string(*fp, file.key) && fread(file.stamp, sizeof(int64_t), 6, *fp) == 6 &&
+         fread(&file.ndata, sizeof(int), 1, *fp) == 1 && fread(&file.ncells, sizeof(int64_t), 1, *fp) == 1 &&
+         file.ncells >= 0;
+    if (ok) {
+      file.offset = ftello(*fp);
+      file.used = false;
+      ok = file.offset + (off_t)(file.ncells * sizeof(mbgrid_acc_cell)) <= size &&
+           fseeko(*fp, file.ncells * sizeof(mbgrid_acc_cell), SEEK_CUR) == 0;
+      files.push_back(file);
+    }
+  }
+
+  if (verbose >= 2) {
+    fprintf(outfp, "\ndbg2  Accumulator file <%s> opened in program <%s>\n", accfile, program_name);
+    fprintf(outfp, "dbg2       usable:         %d\n", ok);
+    fprintf(outfp, "dbg2       nfiles:         %zu\n", files.size());
+  }
+
+  if (!ok) {
+    fclose(*fp);
+    *fp = nullptr;
+    files.clear();
+    *error = MB_ERROR_BAD_FORMAT;
+    return (MB_FAILURE);
+  }
+  return (MB_SUCCESS);
+}
+
+/*--------------------------------------------------------------------*/
+/* read the accumulator saved before, if it was saved with the same
+    gridding parameters, and start writing the new one to tmpfile */
+int mbgrid_acc_init(struct mbgrid_acc_struct *acc, int verbose, const char *accfile, const char *tmpfile,
+                    const char *signature, int *error) {
+  acc->verbose = verbose;
+  acc->nfiles = 0;
+  acc->error = MB_ERROR_NO_ERROR;
+  int open_error = MB_ERROR_NO_ERROR;
+  mbgrid_acc_open(verbose, accfile, signature, &acc->ifp, acc->files, &open_error);
+  for (size_t i = 0; i < acc->files.size(); i++)
+    acc->index.emplace(acc->files[i].key, i);
+  if (open_error == MB_ERROR_BAD_FORMAT)
+    fprintf(outfp, "\nAccumulator file %s not usable with these gridding parameters, all files will be gridded\n",
+            accfile);
+
+  acc->ofp = fopen(tmpfile, "w+b");
+  if (acc->ofp == nullptr) {
+    *error = MB_ERROR_OPEN_FAIL;
+    return (MB_FAILURE);
+  }
+  if (fwrite(MBGRID_ACC_MAGIC, sizeof(MBGRID_ACC_MAGIC), 1, acc->ofp) != 1 ||
+      !mbgrid_acc_write_string(acc->ofp, signature))
+    acc->error = MB_ERROR_WRITE_FAIL;
+  acc->nfiles_offset = ftello(acc->ofp);
+  if (fwrite(&acc->nfiles, sizeof(int64_t), 1, acc->ofp) != 1)
+    acc->error = MB_ERROR_WRITE_FAIL;
+  return (MB_SUCCESS);
+}
+
+/*--------------------------------------------------------------------*/
+void mbgrid_acc_write_file(struct mbgrid_acc_struct *acc, const struct mbgrid_acc_file &file) {
+  if (!mbgrid_acc_write_string(acc->ofp, file.key) || fwrite(file.stamp, sizeof(int64_t), 6, acc->ofp) != 6 ||
+      fwrite(&file.ndata, sizeof(int), 1, acc->ofp) != 1 || fwrite(&file.ncells, sizeof(int64_t), 1, acc->ofp) != 1)
+    acc->error = MB_ERROR_WRITE_FAIL;
+  acc->nfiles++;
+}
+
+/*--------------------------------------------------------------------*/
+/* if the file is unchanged since the accumulator was saved, copy its
+    contribution to the new accumulator and return true */
+bool mbgrid_acc_reuse(struct mbgrid_acc_struct *acc, const struct mbgrid_acc_file &file, int *ndata) {
+  const auto found = acc->index.find(file.key);
+  if (found == acc->index.end())
+    return false;
+  mbgrid_acc_file &saved = acc->files[found->second];
+  if (saved.used || memcmp(saved.stamp, file.stamp, sizeof(file.stamp)) != 0)
+    return false;
+  saved.used = true;
+
+  mbgrid_acc_write_file(acc, saved);
+  if (fseeko(acc->ifp, saved.offset, SEEK_SET) != 0)
+    acc->error = MB_ERROR_EOF;
+  for (int64_t i = 0; i < saved.ncells && acc->error == MB_ERROR_NO_ERROR; i += MBGRID_ACC_CHUNK) {
+    const size_t ncells = std::min((int64_t)MBGRID_ACC_CHUNK, saved.ncells - i);
+    acc->cells.resize(ncells);
+    if (fread(acc->cells.data(), sizeof(mbgrid_acc_cell), ncells, acc->ifp) != ncells)
+      acc->error = MB_ERROR_EOF;
+    else if (fwrite(acc->cells.data(), sizeof(mbgrid_acc_cell), ncells, acc->ofp) != ncells)
+      acc->error = MB_ERROR_WRITE_FAIL;
+  }
+  *ndata = saved.ndata;
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+/* wait for the soundings of a file just gridded to be accumulated, then
+    move its contribution from the bins of the tiles it touched to the
+    new accumulator, leaving the bins empty for the next file */
+void mbgrid_acc_save(struct mbgrid_acc_struct *acc, struct mbgrid_acc_file &file,
+                     struct mbgrid_tiles_struct *tiles) {
+  mbgrid_tiles_flush(tiles, true);
+  acc->cells.clear();
+  for (int itile = 0; itile < tiles->ntx * tiles->nty; itile++) {
+    if (!tiles->touched[itile])
+      continue;
+    tiles->touched[itile] = false;
+    const int tx1 = (itile / tiles->nty) * tiles->tiledim;
+    const int tx2 = std::min(tx1 + tiles->tiledim, tiles->gxdim);
+    const int ty1 = (itile % tiles->nty) * tiles->tiledim;
+    const int ty2 = std::min(ty1 + tiles->tiledim, tiles->gydim);
+    for (int i = tx1; i < tx2; i++)
+      for (int j = ty1; j < ty2; j++) {
+        const int kgrid = i * tiles->gydim + j;
+        if (tiles->num[kgrid] > 0 || tiles->norm[kgrid] != 0.0) {
+          acc->cells.push_back({kgrid, tiles->num[kgrid], tiles->cnt[kgrid], tiles->grid[kgrid],
+                                tiles->norm[kgrid], tiles->sigma[kgrid]});
+          tiles->grid[kgrid] = 0.0;
+          tiles->norm[kgrid] = 0.0;
+          tiles->sigma[kgrid] = 0.0;
+          tiles->num[kgrid] = 0;
+          tiles->cnt[kgrid] = 0;
+        }
+      }
+  }
+
+  file.ncells = acc->cells.size();
+  mbgrid_acc_write_file(acc, file);
+  if (fwrite(acc->cells.data(), sizeof(mbgrid_acc_cell), acc->cells.size(), acc->ofp) != acc->cells.size())
+    acc->error = MB_ERROR_WRITE_FAIL;
+}
+
+/*--------------------------------------------------------------------*/
+/* finish the new accumulator, replace the one saved before with it, and
+    sum the contributions of its files into the bins */
+int mbgrid_acc_close(struct mbgrid_acc_struct *acc, const char *accfile, const char *tmpfile, const char *signature,
+                     int ngrid, double *grid, double *norm, double *sigma, int *num, int *cnt, int *error) {
+  if (acc->ifp != nullptr)
+    fclose(acc->ifp);
+  acc->ifp = nullptr;
+  if (fseeko(acc->ofp, acc->nfiles_offset, SEEK_SET) != 0 || fwrite(&acc->nfiles, sizeof(int64_t), 1, acc->ofp) != 1)
+    acc->error = MB_ERROR_WRITE_FAIL;
+  if (fclose(acc->ofp) != 0 && acc->error == MB_ERROR_NO_ERROR)
+    acc->error = MB_ERROR_WRITE_FAIL;
+  acc->ofp = nullptr;
+  if (acc->error == MB_ERROR_NO_ERROR && rename(tmpfile, accfile) != 0)
+    acc->error = MB_ERROR_WRITE_FAIL;
+  if (acc->error != MB_ERROR_NO_ERROR) {
+    unlink(tmpfile);
+    *error = acc->error;
+    return (MB_FAILURE);
+  }
+
+  FILE *fp = nullptr;
+  if (mbgrid_acc_open(acc->verbose, accfile, signature, &fp, acc->files, error) != MB_SUCCESS)
+    return (MB_FAILURE);
+  for (const mbgrid_acc_file &file : acc->files) {
+    if (fseeko(fp, file.offset, SEEK_SET) != 0)
+      *error = MB_ERROR_EOF;
+    for (int64_t i = 0; i < file.ncells && *error == MB_ERROR_NO_ERROR; i += MBGRID_ACC_CHUNK) {
+      const size_t ncells = std::min((int64_t)MBGRID_ACC_CHUNK, file.ncells - i);
+      acc->cells.resize(ncells);
+      if (fread(acc->cells.data(), sizeof(mbgrid_acc_cell), ncells, fp) != ncells) {
+        *error = MB_ERROR_EOF;
+        break;
+      }
+      for (const mbgrid_acc_cell &cell : acc->cells) {
+        if (cell.kgrid < 0 || cell.kgrid >= ngrid) {
+          *error = MB_ERROR_BAD_FORMAT;
+          break;
+        }
+        grid[cell.kgrid] += cell.grid;
+        norm[cell.kgrid] += cell.norm;
+        sigma[cell.kgrid] += cell.sigma;
+        num[cell.kgrid] += cell.num;
+        cnt[cell.kgrid] += cell.cnt;
+      }
+    }
+  }
+  fclose(fp);
+  std::vector<mbgrid_acc_cell>().swap(acc->cells);
+  return (*error == MB_ERROR_NO_ERROR ? MB_SUCCESS : MB_FAILURE);
+}
+
+/*--------------------------------------------------------------------*/
+/* Nearest data interpolation. An exact Euclidean distance transform
+ * (Felzenszwalb and Huttenlocher, 2012) finds in linear time the
+ * distance from every grid cell to the nearest cell set by data, which
+ * limits the interpolation to the cells within the clip distance. Each
+ * of those cells is then set to the inverse distance weighted mean of
+ * the nearest data cells found with a k-d tree, so that the fill time
+ * scales with the number of grid cells rather than with the square of
+ * the clip distance. */
+
+/* number of data cells averaged to fill each empty cell */
+constexpr int MBGRID_NEAREST_NUMBER = 8;
+
+/* a data cell in the k-d tree */
+struct mbgrid_kdtree_point {
+  int i;
+  int j;
+  double value;
+};
+
+/*--------------------------------------------------------------------*/
+/* squared distance transform of the n samples of f, where samples that
+    are not data are infinite, using the lower envelope of the parabolas
+    rooted at the data samples */
+void mbgrid_distance_1d(int n, const double *f, double *d, int *v, double *z) {
+  int k = -1;
+  for (int q = 0; q < n; q++) {
+    if (!std::isfinite(f[q]))
+      continue;
+    double s = -std::numeric_limits<double>::infinity();
+    while (k >= 0) {
+      s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) / (2.0 * (q - v[k]));
+      if (s > z[k])
+        break;
+      k--;
+    }
+    if (k < 0)
+      s = -std::numeric_limits<double>::infinity();
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = std::numeric_limits<double>::infinity();
+  }
+
+  if (k < 0) {
+    for (int q = 0; q < n; q++)
+      d[q] = std::numeric_limits<double>::infinity();
+    return;
+  }
+  k = 0;
+  for (int q = 0; q < n; q++) {
+    while (z[k + 1] < q)
+      k++;
+    d[q] = (double)(q - v[k]) * (q - v[k]) + f[v[k]];
+  }
+}
+
+/*--------------------------------------------------------------------*/
+/* get the squared distance in grid cells from every cell to the nearest
+    cell set by data */
+void mbgrid_distance_transform(int gxdim, int gydim, const double *grid, double clipvalue, double *dist2) {
+  const int n = std::max(gxdim, gydim);
+  std::vector<double> f(n), d(n), z(n + 1);
+  std::vector<int> v(n);
+
+  /* transform along each column */
+  for (int i = 0; i < gxdim; i++) {
+    for (int j = 0; j < gydim; j++)
+      f[j] = grid[i * gydim + j] < clipvalue ? 0.0 : std::numeric_limits<double>::infinity();
+    mbgrid_distance_1d(gydim, f.data(), &dist2[i * gydim], v.data(), z.data());
+  }
+
+  /* then along each row */
+  for (int j = 0; j < gydim; j++) {
+    for (int i = 0; i < gxdim; i++)
+      f[i] = dist2[i * gydim + j];
+    mbgrid_distance_1d(gxdim, f.data(), d.data(), v.data(), z.data());
+    for (int i = 0; i < gxdim; i++)
+      dist2[i * gydim + j] = d[i];
+  }
+}
+
+/*--------------------------------------------------------------------*/
+/* order points[lo, hi) as a balanced k-d tree, splitting on i at even
+    depths and on j at odd depths */
+void mbgrid_kdtree_build(std::vector<mbgrid_kdtree_point> &points, int lo, int hi, int depth) {
+  if (hi - lo < 2)
+    return;
+  const int mid = (lo + hi) / 2;
+  std::nth_element(points.begin() + lo, points.begin() + mid, points.begin() + hi,
+                   [depth](const mbgrid_kdtree_point &a, const mbgrid_kdtree_point &b) {
+                     return depth % 2 == 0 ? a.i < b.i : a.j < b.j;
+                   });
+  mbgrid_kdtree_build(points, lo, mid, depth + 1);
+  mbgrid_kdtree_build(points, mid + 1, hi, depth + 1);
+}
+
+/*--------------------------------------------------------------------*/
+/* find the nearest data cells within a squared distance of max_dist2 of
+    cell i, j, keeping them ordered by distance in nearest and dist2 */
+void mbgrid_kdtree_nearest(const std::vector<mbgrid_kdtree_point> &points, int lo, int hi, int depth, int i, int j,
+                           double max_dist2, int *nfound, int *nearest, double *dist2) {
+  if (hi <= lo)
+    return;
+  const int mid = (lo + hi) / 2;
+  const mbgrid_kdtree_point &point = points[mid];
+
+  /* insert this point if it is among the nearest found so far */
+  const double r2 = (double)(point.i - i) * (point.i - i) + (double)(point.j - j) * (point.j - j);
+  if (r2 <= max_dist2 && (*nfound < MBGRID_NEAREST_NUMBER || r2 < dist2[*nfound - 1])) {
+    int k = std::min(*nfound, MBGRID_NEAREST_NUMBER - 1);
+    for (; k > 0 && dist2[k - 1] > r2; k--) {
+      nearest[k] = nearest[k - 1];
+      dist2[k] = dist2[k - 1];
+    }
+    nearest[k] = mid;
+    dist2[k] = r2;
+    *nfound = std::min(*nfound + 1, MBGRID_NEAREST_NUMBER);
+  }
+
+  /* search the side of the split holding the cell first, and the other
+      side only if it may hold a nearer point */
+  const int diff = depth % 2 == 0 ? i - point.i : j - point.j;
+  const int near_lo = diff < 0 ? lo : mid + 1;
+  const int near_hi = diff < 0 ? mid : hi;
+  const int far_lo = diff < 0 ? mid + 1 : lo;
+  const int far_hi = diff < 0 ? hi : mid;
+  mbgrid_kdtree_nearest(points, near_lo, near_hi, depth + 1, i, j, max_dist2, nfound, nearest, dist2);
+  const double bound = *nfound < MBGRID_NEAREST_NUMBER ? max_dist2 : dist2[*nfound - 1];
+  if ((double)diff * diff <= bound)
+    mbgrid_kdtree_nearest(points, far_lo, far_hi, depth + 1, i, j, max_dist2, nfound, nearest, dist2);
+}
+
+/*--------------------------------------------------------------------*/
+/* mark the empty cells within clip cells of data in both the x and y
+    directions, as found by searching square rings of increasing size,
+    using running counts of data cells along the columns and then the rows */
+void mbgrid_near_mask(int gxdim, int gydim, const double *grid, double clipvalue, int clip, bool *smask) {
+  std::vector<int> colnear(gxdim * gydim);
+  std::vector<int> count(std::max(gxdim, gydim) + 1);
+
+  /* count the data cells within clip cells of each cell along its column */
+  for (int i = 0; i < gxdim; i++) {
+    count[0] = 0;
+    for (int j = 0; j < gydim; j++)
+      count[j + 1] = count[j] + (grid[i * gydim + j] < clipvalue ? 1 : 0);
+    for (int j = 0; j < gydim; j++)
+      colnear[i * gydim + j] = count[std::min(gydim, j + clip + 1)] - count[std::max(0, j - clip)];
+  }
+
+  /* then find the columns within clip cells holding such data cells */
+  for (int j = 0; j < gydim; j++) {
+    count[0] = 0;
+    for (int i = 0; i < gxdim; i++)
+      count[i + 1] = count[i] + (colnear[i * gydim + j] > 0 ? 1 : 0);
+    for (int i = 0; i < gxdim; i++) {
+      const int kgrid = i * gydim + j;
+      smask[kgrid] =
+          grid[kgrid] >= clipvalue && count[std::min(gxdim, i + clip + 1)] - count[std::max(0, i - clip)] > 0;
+    }
+  }
+}
+
 /*--------------------------------------------------------------------*/
 
 int main(int argc, char **argv) {
@@ -471,11 +1412,8 @@ int main(int argc, char **argv) {
   bool first_in_stays = true;
   bool check_time = false;
   double timediff = 300.0;
-#ifdef USESURFACE
-  double tension = 0.35;
-#else
   double tension = 0.0;
-#endif
+  bool set_tension = false;
 
   double boundsfactor = 0.0;
   bool bathy_in_feet = false;
@@ -496,15 +1434,34 @@ int main(int argc, char **argv) {
   bool spacing_priority = false;
   bool set_dimensions = false;
   grid_interp_t clipmode = MBGRID_INTERP_NONE;
+  int nthreads = 1;
+  double median_memory = 0.0;
+  bool incremental = false;
+  bool use_surface = false;
 
   {
+    int option_index;
+    const struct option options[] = {
+      {"incremental", no_argument, nullptr, 0},
+      {"surface", no_argument, nullptr, 0},
+      {nullptr, 0, nullptr, 0}};
+
     bool errflg = false;
     int c;
     bool help = false;
-    while ((c = getopt(argc, argv, "A:a:B:b:C:c:D:d:E:e:F:f:G:g:HhI:i:J:j:K:k:L:l:MmNnO:o:P:p:QqR:r:S:s:T:t:U:u:VvW:w:X:x:Y:y:")) !=
-           -1)
+    while ((c = getopt_long(argc, argv, "A:a:B:b:C:c:D:d:E:e:F:f:G:g:HhI:i:J:j:K:k:L:l:MmNnO:o:P:p:QqR:r:S:s:T:t:U:u:VvW:w:X:x:Y:y:Z:z:",
+                            options, &option_index)) != -1)
     {
       switch (c) {
+      /* long options */
+      case 0:
+        if (strcmp("incremental", options[option_index].name) == 0) {
+          incremental = true;
+        }
+        else if (strcmp("surface", options[option_index].name) == 0) {
+          use_surface = true;
+        }
+        break;
       case 'A':
       case 'a':
       {
@@ -530,7 +1487,7 @@ int main(int argc, char **argv) {
           clipmode = MBGRID_INTERP_NONE;
         else if (clip > 0 && clipmode < 0)
           clipmode = MBGRID_INTERP_GAP;
-        else if (clipmode >= 3)
+        else if (clipmode >= 3 && clipmode != MBGRID_INTERP_NEAREST)
           clipmode = MBGRID_INTERP_ALL;
         break;
       }
@@ -570,6 +1527,8 @@ int main(int argc, char **argv) {
           } else if (grid_mode == MBGRID_MAXIMUM_FILTER) {
             minormax_weighted_mean_threshold = dvalue;
             grid_mode = MBGRID_MAXIMUM_WEIGHTED_MEAN;
+          } else if (grid_mode == MBGRID_MEDIAN_FILTER) {
+            median_memory = dvalue;
           } else {
             minormax_weighted_mean_threshold = dvalue;
           }
@@ -665,6 +1624,7 @@ int main(int argc, char **argv) {
       case 'T':
       case 't':
         sscanf(optarg, "%lf", &tension);
+        set_tension = true;
         break;
       case 'U':
       case 'u':
@@ -699,6 +1659,10 @@ int main(int argc, char **argv) {
 					}
 					break;
         }
+      case 'Z':
+      case 'z':
+        sscanf(optarg, "%d", &nthreads);
+        break;
       case '?':
         errflg = true;
       }
@@ -773,6 +1737,10 @@ int main(int argc, char **argv) {
       fprintf(outfp, "dbg2       projection_pars_f:    %d\n", projection_pars_f);
       fprintf(outfp, "dbg2       projection_id:        %s\n", projection_id);
       fprintf(outfp, "dbg2       minormax_weighted_mean_threshold: %f\n", minormax_weighted_mean_threshold);
+      fprintf(outfp, "dbg2       nthreads:             %d\n", nthreads);
+      fprintf(outfp, "dbg2       median_memory:        %f\n", median_memory);
+      fprintf(outfp, "dbg2       incremental:          %d\n", incremental);
+      fprintf(outfp, "dbg2       use_surface:          %d\n", use_surface);
 
     }
 
@@ -876,20 +1844,17 @@ int main(int argc, char **argv) {
   double *firsttime = nullptr;
   double *gridsmall = nullptr;
   double *minormax = nullptr;
-#ifdef USESURFACE
   float *bxdata = nullptr;
   float *bydata = nullptr;
   float *bzdata = nullptr;
   float *sxdata = nullptr;
   float *sydata = nullptr;
   float *szdata = nullptr;
-#else
   float *bdata = nullptr;
   float *sdata = nullptr;
   float *work1 = nullptr;
   int *work2 = nullptr;
   bool *work3 = nullptr;
-#endif
   double bdata_origin_x, bdata_origin_y;
   float *output = nullptr;
   float *sgrid = nullptr;
@@ -927,10 +1892,7 @@ int main(int argc, char **argv) {
   double foot_dtheta, foot_dphi;
   double foot_hwidth, foot_hlength;
   int foot_wix, foot_wiy, foot_lix, foot_liy, foot_dix, foot_diy;
-  double sbath;
-  double xx0, yy0, bdx, bdy, xx1, xx2, yy1, yy2;
-  double prx[5], pry[5];
-  grid_use_t use_weight;
+  double xx1, yy1;
 
   int gxdim = 0;
   int gydim = 0;
@@ -958,6 +1920,27 @@ int main(int argc, char **argv) {
     grid_mode = MBGRID_WEIGHTED_MEAN;
   }
 
+  /* use at most one gridding thread per processor, and only one if the
+      swath overlap time checks are needed as these depend on all earlier
+      soundings having been accumulated */
+  const int n_concurrency = std::thread::hardware_concurrency();
+  if (n_concurrency > 0)
+    nthreads = std::min(nthreads, n_concurrency);
+  if (nthreads < 1 || check_time)
+    nthreads = 1;
+
+  /* incremental gridding needs sums that each file adds to independently
+      of the others, which the weighted mean has unless swath overlap
+      time checks are made */
+  if (incremental && (grid_mode != MBGRID_WEIGHTED_MEAN || check_time)) {
+    fprintf(outfp, "\nIncremental gridding is only available for weighted mean gridding without -U\n");
+    incremental = false;
+  }
+
+  /* the surface spline defaults to some tension, the zgrid spline to none */
+  if (use_surface && !set_tension)
+    tension = 0.35;
+
   /* more option not available with minimum
       or maximum filter algorithms */
   if (more && (grid_mode == MBGRID_MINIMUM_FILTER || grid_mode == MBGRID_MAXIMUM_FILTER))
@@ -1479,12 +2462,18 @@ int main(int argc, char **argv) {
       fprintf(outfp, "Footprint 1/e distance: %f times footprint\n", scale);
     if (grid_mode == MBGRID_MINIMUM_WEIGHTED_MEAN)
       fprintf(outfp, "Minimum filter threshold for Minimum Weighted Mean: %f\n", minormax_weighted_mean_threshold);
+    if (grid_mode == MBGRID_MEDIAN_FILTER && median_memory > 0.0)
+      fprintf(outfp, "Median filter memory limit:   %f MB\n", median_memory);
     if (check_time && !first_in_stays)
       fprintf(outfp, "Swath overlap handling:       Last data used\n");
     if (check_time && first_in_stays)
       fprintf(outfp, "Swath overlap handling:       First data used\n");
     if (check_time)
       fprintf(outfp, "Swath overlap time threshold: %f minutes\n", timediff / 60.);
+    if (nthreads > 1)
+      fprintf(outfp, "Gridding threads: %d\n", nthreads);
+    if (incremental)
+      fprintf(outfp, "Incremental gridding accumulator: %s.acc\n", fileroot);
     if (clipmode == MBGRID_INTERP_NONE)
       fprintf(outfp, "Spline interpolation not applied\n");
     else if (clipmode == MBGRID_INTERP_GAP) {
@@ -1501,6 +2490,10 @@ int main(int argc, char **argv) {
       fprintf(outfp, "Spline interpolation applied to fill entire grid\n");
       fprintf(outfp, "Spline tension (range 0.0 to infinity): %f\n", tension);
     }
+    else if (clipmode == MBGRID_INTERP_NEAREST) {
+      fprintf(outfp, "Inverse distance interpolation applied near data\n");
+      fprintf(outfp, "Inverse distance interpolation clipping dimension: %d\n", clip);
+    }
     if (grdrasterid == 0)
       fprintf(outfp, "Background not applied\n");
     else if (grdrasterid < 0)
@@ -1545,36 +2538,37 @@ int main(int argc, char **argv) {
     /* guess about twice the data actually expected */
     int nbackground_alloc = 2 * gxdim * gydim;
 
-/* allocate and initialize background data arrays */
-#ifdef USESURFACE
-    status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bxdata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bydata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bzdata, &error);
-    if (error != MB_ERROR_NO_ERROR) {
-      char *message = nullptr;
-      mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-      fprintf(outfp, "\nMBIO Error allocating background data array:\n%s\n", message);
-      fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
-      mb_memory_clear(verbose, &memclear_error);
-      exit(MB_ERROR_MEMORY_FAIL);
+    /* allocate and initialize background data arrays */
+    if (use_surface) {
+      status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bxdata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bydata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bzdata, &error);
+      if (error != MB_ERROR_NO_ERROR) {
+        char *message = nullptr;
+        mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+        fprintf(outfp, "\nMBIO Error allocating background data array:\n%s\n", message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(MB_ERROR_MEMORY_FAIL);
+      }
+      memset((char *)bxdata, 0, nbackground_alloc * sizeof(float));
+      memset((char *)bydata, 0, nbackground_alloc * sizeof(float));
+      memset((char *)bzdata, 0, nbackground_alloc * sizeof(float));
     }
-    memset((char *)bxdata, 0, nbackground_alloc * sizeof(float));
-    memset((char *)bydata, 0, nbackground_alloc * sizeof(float));
-    memset((char *)bzdata, 0, nbackground_alloc * sizeof(float));
-#else
-    status = mb_mallocd(verbose, __FILE__, __LINE__, 3 * nbackground_alloc * sizeof(float), (void **)&bdata, &error);
-    if (error != MB_ERROR_NO_ERROR) {
-      char *message = nullptr;
-      mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-      fprintf(outfp, "\nMBIO Error allocating background interpolation work arrays:\n%s\n", message);
-      fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
-      mb_memory_clear(verbose, &memclear_error);
-      exit(MB_ERROR_MEMORY_FAIL);
+    else {
+      status = mb_mallocd(verbose, __FILE__, __LINE__, 3 * nbackground_alloc * sizeof(float), (void **)&bdata, &error);
+      if (error != MB_ERROR_NO_ERROR) {
+        char *message = nullptr;
+        mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+        fprintf(outfp, "\nMBIO Error allocating background interpolation work arrays:\n%s\n", message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(MB_ERROR_MEMORY_FAIL);
+      }
+      memset((char *)bdata, 0, 3 * nbackground_alloc * sizeof(float));
     }
-    memset((char *)bdata, 0, 3 * nbackground_alloc * sizeof(float));
-#endif
 
     const int pid = getpid();
 
@@ -1676,49 +2670,50 @@ int main(int argc, char **argv) {
           tlon += 360.0;
         if (use_projection)
           mb_proj_forward(verbose, pjptr, tlon, tlat, &tlon, &tlat, &error);
-#ifdef USESURFACE
-        if (nbackground >= nbackground_alloc) {
-          nbackground_alloc += 10000;
-          status =
-              mb_reallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bxdata, &error);
-          if (status == MB_SUCCESS)
-            status =
-                mb_reallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bydata, &error);
-          if (status == MB_SUCCESS)
+        if (use_surface) {
+          if (nbackground >= nbackground_alloc) {
+            nbackground_alloc += 10000;
             status =
-                mb_reallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bzdata, &error);
-          if (error != MB_ERROR_NO_ERROR) {
-            char *message = nullptr;
-            mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-            fprintf(outfp, "\nMBIO Error reallocating background data array:\n%s\n", message);
-            fprintf(outfp, "\nProgram <%s> Terminated at line %d in source file %s\n", program_name, __LINE__,
-                    __FILE__);
-            mb_memory_clear(verbose, &memclear_error);
-            exit(MB_ERROR_MEMORY_FAIL);
+                mb_reallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bxdata, &error);
+            if (status == MB_SUCCESS)
+              status =
+                  mb_reallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bydata, &error);
+            if (status == MB_SUCCESS)
+              status =
+                  mb_reallocd(verbose, __FILE__, __LINE__, nbackground_alloc * sizeof(float), (void **)&bzdata, &error);
+            if (error != MB_ERROR_NO_ERROR) {
+              char *message = nullptr;
+              mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+              fprintf(outfp, "\nMBIO Error reallocating background data array:\n%s\n", message);
+              fprintf(outfp, "\nProgram <%s> Terminated at line %d in source file %s\n", program_name, __LINE__,
+                      __FILE__);
+              mb_memory_clear(verbose, &memclear_error);
+              exit(MB_ERROR_MEMORY_FAIL);
+            }
           }
+          bxdata[nbackground] = (float)(tlon - bdata_origin_x);
+          bydata[nbackground] = (float)(tlat - bdata_origin_y);
+          bzdata[nbackground] = (float)tvalue;
         }
-        bxdata[nbackground] = (float)(tlon - bdata_origin_x);
-        bydata[nbackground] = (float)(tlat - bdata_origin_y);
-        bzdata[nbackground] = (float)tvalue;
-#else
-        if (nbackground >= nbackground_alloc) {
-          nbackground_alloc += 10000;
-          status =
-              mb_reallocd(verbose, __FILE__, __LINE__, 3 * nbackground_alloc * sizeof(float), (void **)&bdata, &error);
-          if (error != MB_ERROR_NO_ERROR) {
-            char *message = nullptr;
-            mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-            fprintf(outfp, "\nMBIO Error allocating background interpolation work arrays:\n%s\n", message);
-            fprintf(outfp, "\nProgram <%s> Terminated at line %d in source file %s\n", program_name, __LINE__,
-                    __FILE__);
-            mb_memory_clear(verbose, &memclear_error);
-            exit(MB_ERROR_MEMORY_FAIL);
+        else {
+          if (nbackground >= nbackground_alloc) {
+            nbackground_alloc += 10000;
+            status = mb_reallocd(verbose, __FILE__, __LINE__, 3 * nbackground_alloc * sizeof(float), (void **)&bdata,
+                                 &error);
+            if (error != MB_ERROR_NO_ERROR) {
+              char *message = nullptr;
+              mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+              fprintf(outfp, "\nMBIO Error allocating background interpolation work arrays:\n%s\n", message);
+              fprintf(outfp, "\nProgram <%s> Terminated at line %d in source file %s\n", program_name, __LINE__,
+                      __FILE__);
+              mb_memory_clear(verbose, &memclear_error);
+              exit(MB_ERROR_MEMORY_FAIL);
+            }
           }
+          bdata[nbackground * 3] = (float)(tlon - bdata_origin_x);
+          bdata[nbackground * 3 + 1] = (float)(tlat - bdata_origin_y);
+          bdata[nbackground * 3 + 2] = (float)tvalue;
         }
-        bdata[nbackground * 3] = (float)(tlon - bdata_origin_x);
-        bdata[nbackground * 3 + 1] = (float)(tlat - bdata_origin_y);
-        bdata[nbackground * 3 + 2] = (float)tvalue;
-#endif
         nbackground++;
       }
       pclose(rfp);
@@ -1875,6 +2870,10 @@ int main(int argc, char **argv) {
             exit(error);
           }
 
+          /* only swath data are gridded, so bulky records such as water column need not be decoded */
+          mb_set_lazy_decode(verbose, mbio_ptr, true, &error);
+          mb_set_pingcache(verbose, mbio_ptr, true, &error);
+
           /* get mb_io_ptr */
           mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
@@ -1956,10 +2955,7 @@ int main(int argc, char **argv) {
               /* reproject beam positions if necessary */
               if (use_projection) {
                 mb_proj_forward(verbose, pjptr, navlon, navlat, &navlon, &navlat, &error);
-                for (ib = 0; ib < beams_bath; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_bath, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -2037,121 +3033,124 @@ int main(int argc, char **argv) {
         }
       }
 
-/* now fill in the low resolution grid with interpolation */
-#ifdef USESURFACE
-    /* allocate and initialize sgrid */
-    status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&sxdata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&sydata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&szdata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, sxdim * sydim * sizeof(float), (void **)&sgrid, &error);
-    if (error != MB_ERROR_NO_ERROR) {
-      char *message = nullptr;
-      mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-      fprintf(outfp, "\nMBIO Error allocating interpolation work arrays:\n%s\n", message);
-      fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
-      mb_memory_clear(verbose, &memclear_error);
-      exit(error);
-    }
-    memset((char *)sgrid, 0, sxdim * sydim * sizeof(float));
-    memset((char *)sxdata, 0, ndata * sizeof(float));
-    memset((char *)sydata, 0, ndata * sizeof(float));
-    memset((char *)szdata, 0, ndata * sizeof(float));
-
-    /* get points from grid */
-    /* simultaneously find the depth values nearest to the grid corners and edge midpoints */
-    ndata = 0;
-    for (int i = 0; i < sxdim; i++)
-      for (int j = 0; j < sydim; j++) {
-        kgrid = i * sydim + j;
-        if (cnt[kgrid] > 0) {
-          sxdata[ndata] = (float)(wbnd[0] + sdx * i - bdata_origin_x);
-          sydata[ndata] = (float)(wbnd[2] + sdy * j - bdata_origin_y);
-          szdata[ndata] = (float)gridsmall[kgrid];
-          ndata++;
-        }
+    /* now fill in the low resolution grid with interpolation */
+    if (use_surface) {
+      /* allocate and initialize sgrid */
+      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&sxdata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&sydata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&szdata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, sxdim * sydim * sizeof(float), (void **)&sgrid, &error);
+      if (error != MB_ERROR_NO_ERROR) {
+        char *message = nullptr;
+        mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+        fprintf(outfp, "\nMBIO Error allocating interpolation work arrays:\n%s\n", message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(error);
       }
+      memset((char *)sgrid, 0, sxdim * sydim * sizeof(float));
+      memset((char *)sxdata, 0, ndata * sizeof(float));
+      memset((char *)sydata, 0, ndata * sizeof(float));
+      memset((char *)szdata, 0, ndata * sizeof(float));
+
+      /* get points from grid */
+      /* simultaneously find the depth values nearest to the grid corners and edge midpoints */
+      ndata = 0;
+      for (int i = 0; i < sxdim; i++)
+        for (int j = 0; j < sydim; j++) {
+          kgrid = i * sydim + j;
+          if (cnt[kgrid] > 0) {
+            sxdata[ndata] = (float)(wbnd[0] + sdx * i - bdata_origin_x);
+            sydata[ndata] = (float)(wbnd[2] + sdy * j - bdata_origin_y);
+            szdata[ndata] = (float)gridsmall[kgrid];
+            ndata++;
+          }
+        }
 
-    /* do the interpolation */
-    fprintf(outfp, "\nDoing Surface spline interpolation with %d data points...\n", ndata);
-    mb_surface(verbose, ndata, sxdata, sydata, szdata, (wbnd[0] - bdata_origin_x), (wbnd[1] - bdata_origin_x),
-               (wbnd[2] - bdata_origin_y), (wbnd[3] - bdata_origin_y), sdx, sdy, tension, sgrid);
-#else
-    /* allocate and initialize sgrid */
-    status = mb_mallocd(verbose, __FILE__, __LINE__, 3 * ndata * sizeof(float), (void **)&sdata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, sxdim * sydim * sizeof(float), (void **)&sgrid, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&work1, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(int), (void **)&work2, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, (sxdim + sydim) * sizeof(bool), (void **)&work3, &error);
-    if (error != MB_ERROR_NO_ERROR) {
-      char *message = nullptr;
-      mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-      fprintf(outfp, "\nMBIO Error allocating interpolation work arrays:\n%s\n", message);
-      fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
-      mb_memory_clear(verbose, &memclear_error);
-      exit(error);
+      /* do the interpolation */
+      fprintf(outfp, "\nDoing Surface spline interpolation with %d data points...\n", ndata);
+      void *surface_ptr = nullptr;
+      if (mb_surface_init(verbose, nthreads, &surface_ptr, &error) == MB_SUCCESS) {
+        mb_surface_grid(verbose, surface_ptr, ndata, sxdata, sydata, szdata, (wbnd[0] - bdata_origin_x),
+                        (wbnd[1] - bdata_origin_x), (wbnd[2] - bdata_origin_y), (wbnd[3] - bdata_origin_y), sdx, sdy,
+                        tension, sgrid, &error);
+        mb_surface_deall(verbose, &surface_ptr, &error);
+      }
     }
-    memset((char *)sgrid, 0, sxdim * sydim * sizeof(float));
-    memset((char *)sdata, 0, 3 * ndata * sizeof(float));
-    memset((char *)work1, 0, ndata * sizeof(float));
-    memset((char *)work2, 0, ndata * sizeof(int));
-    memset((char *)work3, 0, (sxdim + sydim) * sizeof(bool));
-
-    /* get points from grid */
-    /* simultaneously find the depth values nearest to the grid corners and edge midpoints */
-    ndata = 0;
-    for (int i = 0; i < sxdim; i++)
-      for (int j = 0; j < sydim; j++) {
-        kgrid = i * sydim + j;
-        if (cnt[kgrid] > 0) {
-          sdata[ndata++] = (float)(wbnd[0] + sdx * i - bdata_origin_x);
-          sdata[ndata++] = (float)(wbnd[2] + sdy * j - bdata_origin_y);
-          sdata[ndata++] = (float)gridsmall[kgrid];
-        }
+    else {
+      /* allocate and initialize sgrid */
+      status = mb_mallocd(verbose, __FILE__, __LINE__, 3 * ndata * sizeof(float), (void **)&sdata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, sxdim * sydim * sizeof(float), (void **)&sgrid, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&work1, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(int), (void **)&work2, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, (sxdim + sydim) * sizeof(bool), (void **)&work3, &error);
+      if (error != MB_ERROR_NO_ERROR) {
+        char *message = nullptr;
+        mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+        fprintf(outfp, "\nMBIO Error allocating interpolation work arrays:\n%s\n", message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(error);
       }
-    ndata = ndata / 3;
-
-    /* do the interpolation */
-    float cay = (float)tension;
-    float xmin = (float)(wbnd[0] - 0.5 * sdx - bdata_origin_x);
-    float ymin = (float)(wbnd[2] - 0.5 * sdy - bdata_origin_y);
-    float ddx = (float)sdx;
-    float ddy = (float)sdy;
-    fprintf(outfp, "\nDoing Zgrid spline interpolation with %d data points...\n", ndata);
-    mb_zgrid2(sgrid, &sxdim, &sydim, &xmin, &ymin, &ddx, &ddy, sdata, &ndata, work1, work2, work3, &cay, &sclip);
-#endif
+      memset((char *)sgrid, 0, sxdim * sydim * sizeof(float));
+      memset((char *)sdata, 0, 3 * ndata * sizeof(float));
+      memset((char *)work1, 0, ndata * sizeof(float));
+      memset((char *)work2, 0, ndata * sizeof(int));
+      memset((char *)work3, 0, (sxdim + sydim) * sizeof(bool));
+
+      /* get points from grid */
+      /* simultaneously find the depth values nearest to the grid corners and edge midpoints */
+      ndata = 0;
+      for (int i = 0; i < sxdim; i++)
+        for (int j = 0; j < sydim; j++) {
+          kgrid = i * sydim + j;
+          if (cnt[kgrid] > 0) {
+            sdata[ndata++] = (float)(wbnd[0] + sdx * i - bdata_origin_x);
+            sdata[ndata++] = (float)(wbnd[2] + sdy * j - bdata_origin_y);
+            sdata[ndata++] = (float)gridsmall[kgrid];
+          }
+        }
+      ndata = ndata / 3;
+
+      /* do the interpolation */
+      float cay = (float)tension;
+      float xmin = (float)(wbnd[0] - 0.5 * sdx - bdata_origin_x);
+      float ymin = (float)(wbnd[2] - 0.5 * sdy - bdata_origin_y);
+      float ddx = (float)sdx;
+      float ddy = (float)sdy;
+      fprintf(outfp, "\nDoing Zgrid spline interpolation with %d data points...\n", ndata);
+      mb_zgrid2(sgrid, &sxdim, &sydim, &xmin, &ymin, &ddx, &ddy, sdata, &ndata, work1, work2, work3, &cay, &sclip);
+    }
 
     // float zflag = 5.0e34f;
     for (int i = 0; i < sxdim; i++)
       for (int j = 0; j < sydim; j++) {
         kgrid = i * sydim + j;
-#ifdef USESURFACE
-        kint = i + (sydim - j - 1) * sxdim;
-#else
-        kint = i + j * sxdim;
-#endif
+        kint = use_surface ? i + (sydim - j - 1) * sxdim : i + j * sxdim;
         if (cnt[kgrid] == 0) {
           gridsmall[kgrid] = sgrid[kint];
         }
       }
 
-/* deallocate the interpolation arrays */
-#ifdef USESURFACE
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&sxdata, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&sydata, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&szdata, &error);
-#else
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&sdata, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&work1, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&work2, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&work3, &error);
-#endif
+    /* deallocate the interpolation arrays */
+    if (use_surface) {
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&sxdata, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&sydata, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&szdata, &error);
+    }
+    else {
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&sdata, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&work1, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&work2, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&work3, &error);
+    }
     mb_freed(verbose, __FILE__, __LINE__, (void **)&sgrid, &error);
 
     /* do second pass footprint gridding using slope estimates from first pass interpolated grid */
@@ -2168,6 +3167,11 @@ int main(int argc, char **argv) {
         cnt[kgrid] = 0;
       }
 
+    /* set up the accumulation of soundings into the grid */
+    struct mbgrid_tiles_struct tiles;
+    mbgrid_tiles_init(&tiles, verbose, grid_mode, nthreads, gxdim, gydim, wbnd, dx, dy, factor, use_projection,
+                      mtodeglon, mtodeglat, grid, norm, sigma, num, cnt);
+
     /* read in data */
     fprintf(outfp, "\nDoing second pass to generate final grid...\n");
     ndata = 0;
@@ -2224,6 +3228,10 @@ int main(int argc, char **argv) {
             exit(error);
           }
 
+          /* only swath data are gridded, so bulky records such as water column need not be decoded */
+          mb_set_lazy_decode(verbose, mbio_ptr, true, &error);
+          mb_set_pingcache(verbose, mbio_ptr, true, &error);
+
           /* get mb_io_ptr */
           mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
@@ -2314,10 +3322,7 @@ int main(int argc, char **argv) {
               /* reproject beam positions if necessary */
               if (use_projection) {
                 mb_proj_forward(verbose, pjptr, navlon, navlat, &navlon, &navlat, &error);
-                for (ib = 0; ib < beams_bath; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_bath, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -2330,13 +3335,8 @@ int main(int argc, char **argv) {
                   /* deal with point data without footprint */
                   if (topo_type != MB_TOPOGRAPHY_TYPE_MULTIBEAM) {
                     if (ix >= 0 && ix < gxdim && iy >= 0 && iy < gydim) {
-                      kgrid = ix * gydim + iy;
-                      norm[kgrid] = norm[kgrid] + file_weight;
-                      grid[kgrid] = grid[kgrid] + file_weight * topofactor * bath[ib];
-                      sigma[kgrid] =
-                          sigma[kgrid] + file_weight * topofactor * topofactor * bath[ib] * bath[ib];
-                      num[kgrid]++;
-                      cnt[kgrid]++;
+                      mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_POINT, ix, iy, 0, 0, bathlon[ib], bathlat[ib],
+                                                topofactor, bath[ib], file_weight});
                       ndata++;
                       ndatafile++;
                       if (first) {
@@ -2475,68 +3475,10 @@ int main(int argc, char **argv) {
                       }
                       foot_dix = 2 * std::max(foot_wix, foot_lix);
                       foot_diy = 2 * std::max(foot_wiy, foot_liy);
-                      ix1 = std::max(ix - foot_dix, 0);
-                      ix2 = std::min(ix + foot_dix, gxdim - 1);
-                      iy1 = std::max(iy - foot_diy, 0);
-                      iy2 = std::min(iy + foot_diy, gydim - 1);
-
-                      /* loop over neighborhood of bins */
-                      for (int ii = ix1; ii <= ix2; ii++)
-                        for (int jj = iy1; jj <= iy2; jj++) {
-                          /* find center of bin in lon lat degrees from sounding center */
-                          kgrid = ii * gydim + jj;
-                          xx = (wbnd[0] + ii * dx + 0.5 * dx - bathlon[ib]);
-                          yy = (wbnd[2] + jj * dy + 0.5 * dy - bathlat[ib]);
-
-                          /* get depth or topo value at this point using slope estimate */
-                          sbath = topofactor * bath[ib] + dzdx * xx + dzdy * yy;
-
-                          /* get center and corners of bin in meters from sounding center */
-                          if (use_projection) {
-                            xx0 = xx;
-                            yy0 = yy;
-                            bdx = 0.5 * dx;
-                            bdy = 0.5 * dy;
-                          }
-                          else {
-                            xx0 = xx / mtodeglon;
-                            yy0 = yy / mtodeglat;
-                            bdx = 0.5 * dx / mtodeglon;
-                            bdy = 0.5 * dy / mtodeglat;
-                          }
-                          xx1 = xx0 - bdx;
-                          xx2 = xx0 + bdx;
-                          yy1 = yy0 - bdy;
-                          yy2 = yy0 + bdy;
-
-                          /* rotate center and corners of bin to footprint coordinates */
-                          prx[0] = xx0 * foot_dxn + yy0 * foot_dyn;
-                          pry[0] = -xx0 * foot_dyn + yy0 * foot_dxn;
-                          prx[1] = xx1 * foot_dxn + yy1 * foot_dyn;
-                          pry[1] = -xx1 * foot_dyn + yy1 * foot_dxn;
-                          prx[2] = xx2 * foot_dxn + yy1 * foot_dyn;
-                          pry[2] = -xx2 * foot_dyn + yy1 * foot_dxn;
-                          prx[3] = xx1 * foot_dxn + yy2 * foot_dyn;
-                          pry[3] = -xx1 * foot_dyn + yy2 * foot_dxn;
-                          prx[4] = xx2 * foot_dxn + yy2 * foot_dyn;
-                          pry[4] = -xx2 * foot_dyn + yy2 * foot_dxn;
-
-                          /* get weight integrated over bin */
-                          mbgrid_weight(verbose, foot_hwidth, foot_hlength, prx[0], pry[0], bdx,
-                                        bdy, &prx[1], &pry[1], &weight, &use_weight, &error);
-
-                          if (use_weight != MBGRID_USE_NO && weight > 0.000001) {
-                            weight *= file_weight;
-                            norm[kgrid] = norm[kgrid] + weight;
-                            grid[kgrid] = grid[kgrid] + weight * sbath;
-                            sigma[kgrid] = sigma[kgrid] + weight * sbath * sbath;
-                            if (use_weight == MBGRID_USE_YES) {
-                              num[kgrid]++;
-                              if (ii == ix && jj == iy)
-                                cnt[kgrid]++;
-                            }
-                          }
-                        }
+                      mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_FOOTPRINT, ix, iy, foot_dix, foot_diy,
+                                                bathlon[ib], bathlat[ib], topofactor, bath[ib], file_weight,
+                                                foot_hwidth, foot_hlength, foot_dxn, foot_dyn, true, dzdx,
+                                                dzdy});
                       ndata++;
                       ndatafile++;
                       if (first) {
@@ -2551,13 +3493,8 @@ int main(int argc, char **argv) {
 
                       /* else for xyz data without footprint */
                     else if (time_ok && region_ok) {
-                      kgrid = ix * gydim + iy;
-                      norm[kgrid] = norm[kgrid] + file_weight;
-                      grid[kgrid] = grid[kgrid] + file_weight * topofactor * bath[ib];
-                      sigma[kgrid] =
-                          sigma[kgrid] + file_weight * topofactor * topofactor * bath[ib] * bath[ib];
-                      num[kgrid]++;
-                      cnt[kgrid]++;
+                      mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_POINT, ix, iy, 0, 0, bathlon[ib], bathlat[ib],
+                                                topofactor, bath[ib], file_weight});
                       ndata++;
                       ndatafile++;
                       if (first) {
@@ -2587,6 +3524,9 @@ int main(int argc, char **argv) {
       mb_datalist_close(verbose, &datalist, &error);
     fprintf(outfp, "\n%d total data points processed\n", ndata);
 
+    /* wait for all soundings to be accumulated */
+    mbgrid_tiles_flush(&tiles, true);
+
     /* now loop over all points in the output grid */
     if (verbose >= 1)
       fprintf(outfp, "\nMaking raw grid...\n");
@@ -2631,6 +3571,11 @@ int main(int argc, char **argv) {
         cnt[kgrid] = 0;
       }
 
+    /* set up the accumulation of soundings into the grid */
+    struct mbgrid_tiles_struct tiles;
+    mbgrid_tiles_init(&tiles, verbose, grid_mode, nthreads, gxdim, gydim, wbnd, dx, dy, factor, use_projection,
+                      mtodeglon, mtodeglat, grid, norm, sigma, num, cnt);
+
     /* read in data */
     fprintf(outfp, "\nDoing single pass to generate grid...\n");
     ndata = 0;
@@ -2688,6 +3633,10 @@ int main(int argc, char **argv) {
             exit(error);
           }
 
+          /* only swath data are gridded, so bulky records such as water column need not be decoded */
+          mb_set_lazy_decode(verbose, mbio_ptr, true, &error);
+          mb_set_pingcache(verbose, mbio_ptr, true, &error);
+
           /* get mb_io_ptr */
           mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
@@ -2778,10 +3727,7 @@ int main(int argc, char **argv) {
               /* reproject beam positions if necessary */
               if (use_projection) {
                 mb_proj_forward(verbose, pjptr, navlon, navlat, &navlon, &navlat, &error);
-                for (ib = 0; ib < beams_bath; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_bath, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -2830,13 +3776,8 @@ int main(int argc, char **argv) {
                       && iy >= 0 && iy < gydim && time_ok) {
                     /* deal with point data without footprint */
                     if (topo_type != MB_TOPOGRAPHY_TYPE_MULTIBEAM) {
-                      kgrid = ix * gydim + iy;
-                      norm[kgrid] = norm[kgrid] + file_weight;
-                      grid[kgrid] = grid[kgrid] + file_weight * topofactor * bath[ib];
-                      sigma[kgrid] =
-                          sigma[kgrid] + file_weight * topofactor * topofactor * bath[ib] * bath[ib];
-                      num[kgrid]++;
-                      cnt[kgrid]++;
+                      mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_POINT, ix, iy, 0, 0, bathlon[ib], bathlat[ib],
+                                                topofactor, bath[ib], file_weight});
                       ndata++;
                       ndatafile++;
                       if (first) {
@@ -2906,68 +3847,9 @@ int main(int argc, char **argv) {
                         }
                         foot_dix = 2 * std::max(foot_wix, foot_lix);
                         foot_diy = 2 * std::max(foot_wiy, foot_liy);
-                        ix1 = std::max(ix - foot_dix, 0);
-                        ix2 = std::min(ix + foot_dix, gxdim - 1);
-                        iy1 = std::max(iy - foot_diy, 0);
-                        iy2 = std::min(iy + foot_diy, gydim - 1);
-
-                        /* loop over neighborhood of bins */
-                        for (int ii = ix1; ii <= ix2; ii++)
-                          for (int jj = iy1; jj <= iy2; jj++) {
-                            /* find center of bin in lon lat degrees from sounding center */
-                            kgrid = ii * gydim + jj;
-                            xx = (wbnd[0] + ii * dx + 0.5 * dx - bathlon[ib]);
-                            yy = (wbnd[2] + jj * dy + 0.5 * dy - bathlat[ib]);
-
-                            /* get depth or topo value at this point */
-                            sbath = topofactor * bath[ib];
-
-                            /* get center and corners of bin in meters from sounding center */
-                            if (use_projection) {
-                              xx0 = xx;
-                              yy0 = yy;
-                              bdx = 0.5 * dx;
-                              bdy = 0.5 * dy;
-                            }
-                            else {
-                              xx0 = xx / mtodeglon;
-                              yy0 = yy / mtodeglat;
-                              bdx = 0.5 * dx / mtodeglon;
-                              bdy = 0.5 * dy / mtodeglat;
-                            }
-                            xx1 = xx0 - bdx;
-                            xx2 = xx0 + bdx;
-                            yy1 = yy0 - bdy;
-                            yy2 = yy0 + bdy;
-
-                            /* rotate center and corners of bin to footprint coordinates */
-                            prx[0] = xx0 * foot_dxn + yy0 * foot_dyn;
-                            pry[0] = -xx0 * foot_dyn + yy0 * foot_dxn;
-                            prx[1] = xx1 * foot_dxn + yy1 * foot_dyn;
-                            pry[1] = -xx1 * foot_dyn + yy1 * foot_dxn;
-                            prx[2] = xx2 * foot_dxn + yy1 * foot_dyn;
-                            pry[2] = -xx2 * foot_dyn + yy1 * foot_dxn;
-                            prx[3] = xx1 * foot_dxn + yy2 * foot_dyn;
-                            pry[3] = -xx1 * foot_dyn + yy2 * foot_dxn;
-                            prx[4] = xx2 * foot_dxn + yy2 * foot_dyn;
-                            pry[4] = -xx2 * foot_dyn + yy2 * foot_dxn;
-
-                            /* get weight integrated over bin */
-                            mbgrid_weight(verbose, foot_hwidth, foot_hlength, prx[0], pry[0], bdx,
-                                          bdy, &prx[1], &pry[1], &weight, &use_weight, &error);
-
-                            if (use_weight != MBGRID_USE_NO && weight > 0.000001) {
-                              weight *= file_weight;
-                              norm[kgrid] = norm[kgrid] + weight;
-                              grid[kgrid] = grid[kgrid] + weight * sbath;
-                              sigma[kgrid] = sigma[kgrid] + weight * sbath * sbath;
-                              if (use_weight == MBGRID_USE_YES) {
-                                num[kgrid]++;
-                                if (ii == ix && jj == iy)
-                                  cnt[kgrid]++;
-                              }
-                            }
-                          }
+                        mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_FOOTPRINT, ix, iy, foot_dix, foot_diy,
+                                                  bathlon[ib], bathlat[ib], topofactor, bath[ib], file_weight,
+                                                  foot_hwidth, foot_hlength, foot_dxn, foot_dyn});
                         ndata++;
                         ndatafile++;
                         if (first) {
@@ -2982,13 +3864,8 @@ int main(int argc, char **argv) {
 
                       /* else for xyz data without footprint */
                       else if (ix >= 0 && ix < gxdim && iy >= 0 && iy < gydim) {
-                        kgrid = ix * gydim + iy;
-                        norm[kgrid] = norm[kgrid] + file_weight;
-                        grid[kgrid] = grid[kgrid] + file_weight * topofactor * bath[ib];
-                        sigma[kgrid] =
-                            sigma[kgrid] + file_weight * topofactor * topofactor * bath[ib] * bath[ib];
-                        num[kgrid]++;
-                        cnt[kgrid]++;
+                        mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_POINT, ix, iy, 0, 0, bathlon[ib], bathlat[ib],
+                                                  topofactor, bath[ib], file_weight});
                         ndata++;
                         ndatafile++;
                         if (first) {
@@ -3040,6 +3917,9 @@ int main(int argc, char **argv) {
       dfp = nullptr;
     }
 
+    /* wait for all soundings to be accumulated */
+    mbgrid_tiles_flush(&tiles, true);
+
     /* now loop over all points in the output grid */
     if (verbose >= 1)
       fprintf(outfp, "\nMaking raw grid...\n");
@@ -3093,6 +3973,23 @@ int main(int argc, char **argv) {
         data[kgrid] = nullptr;
       }
 
+    /* if a memory limit is set keep the data in a scratch file rather than in memory */
+    const bool out_of_core = median_memory > 0.0;
+    struct mbgrid_spill_struct spill;
+    if (out_of_core) {
+      char scratchfile[MB_PATH_MAXLINE + 20];
+      snprintf(scratchfile, sizeof(scratchfile), "%s_median.tmp", fileroot);
+      if (mbgrid_spill_init(&spill, verbose, gxdim, gydim, 1048576.0 * median_memory, scratchfile, &error) !=
+          MB_SUCCESS) {
+        char *message = nullptr;
+        mb_error(verbose, error, &message);
+        fprintf(outfp, "\nMBIO Error opening median filter scratch file %s:\n%s\n", scratchfile, message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(error);
+      }
+    }
+
     /* read in data */
     ndata = 0;
     const int look_processed = MB_DATALIST_LOOK_UNSET;
@@ -3149,6 +4046,10 @@ int main(int argc, char **argv) {
             exit(error);
           }
 
+          /* only swath data are gridded, so bulky records such as water column need not be decoded */
+          mb_set_lazy_decode(verbose, mbio_ptr, true, &error);
+          mb_set_pingcache(verbose, mbio_ptr, true, &error);
+
           /* allocate memory for reading data arrays */
           if (error == MB_ERROR_NO_ERROR)
             status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag,
@@ -3229,10 +4130,7 @@ int main(int argc, char **argv) {
 
               /* reproject beam positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < beams_bath; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_bath, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -3266,7 +4164,7 @@ int main(int argc, char **argv) {
                     }
 
                     /* make sure there is space for the data */
-                    if (time_ok && cnt[kgrid] >= num[kgrid]) {
+                    if (time_ok && !out_of_core && cnt[kgrid] >= num[kgrid]) {
                       num[kgrid] += REALLOC_STEP_SIZE;
                       if ((data[kgrid] = (double *)realloc(data[kgrid], num[kgrid] * sizeof(double))) ==
                           nullptr) {
@@ -3286,8 +4184,12 @@ int main(int argc, char **argv) {
 
                     /* process it */
                     if (time_ok) {
-                      value = data[kgrid];
-                      value[cnt[kgrid]] = topofactor * bath[ib];
+                      if (out_of_core)
+                        mbgrid_spill_add(&spill, ix, iy, topofactor * bath[ib]);
+                      else {
+                        value = data[kgrid];
+                        value[cnt[kgrid]] = topofactor * bath[ib];
+                      }
                       cnt[kgrid]++;
                       ndata++;
                       ndatafile++;
@@ -3307,10 +4209,7 @@ int main(int argc, char **argv) {
 
               /* reproject beam positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < beams_amp; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_amp, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -3344,7 +4243,7 @@ int main(int argc, char **argv) {
                     }
 
                     /* make sure there is space for the data */
-                    if (time_ok && cnt[kgrid] >= num[kgrid]) {
+                    if (time_ok && !out_of_core && cnt[kgrid] >= num[kgrid]) {
                       num[kgrid] += REALLOC_STEP_SIZE;
                       if ((data[kgrid] = (double *)realloc(data[kgrid], num[kgrid] * sizeof(double))) ==
                           nullptr) {
@@ -3364,8 +4263,12 @@ int main(int argc, char **argv) {
 
                     /* process it */
                     if (time_ok) {
-                      value = data[kgrid];
-                      value[cnt[kgrid]] = amp[ib];
+                      if (out_of_core)
+                        mbgrid_spill_add(&spill, ix, iy, amp[ib]);
+                      else {
+                        value = data[kgrid];
+                        value[cnt[kgrid]] = amp[ib];
+                      }
                       cnt[kgrid]++;
                       ndata++;
                       ndatafile++;
@@ -3385,9 +4288,7 @@ int main(int argc, char **argv) {
 
               /* reproject pixel positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < pixels_ss; ib++)
-                  if (ss[ib] > MB_SIDESCAN_NULL)
-                    mb_proj_forward(verbose, pjptr, sslon[ib], sslat[ib], &sslon[ib], &sslat[ib], &error);
+                mb_proj_forward_array(verbose, pjptr, pixels_ss, sslon, sslat, &error);
               }
 
               /* deal with data */
@@ -3421,7 +4322,7 @@ int main(int argc, char **argv) {
                     }
 
                     /* make sure there is space for the data */
-                    if (time_ok && cnt[kgrid] >= num[kgrid]) {
+                    if (time_ok && !out_of_core && cnt[kgrid] >= num[kgrid]) {
                       num[kgrid] += REALLOC_STEP_SIZE;
                       if ((data[kgrid] = (double *)realloc(data[kgrid], num[kgrid] * sizeof(double))) ==
                           nullptr) {
@@ -3441,8 +4342,12 @@ int main(int argc, char **argv) {
 
                     /* process it */
                     if (time_ok) {
-                      value = data[kgrid];
-                      value[cnt[kgrid]] = ss[ib];
+                      if (out_of_core)
+                        mbgrid_spill_add(&spill, ix, iy, ss[ib]);
+                      else {
+                        value = data[kgrid];
+                        value[cnt[kgrid]] = ss[ib];
+                      }
                       cnt[kgrid]++;
                       ndata++;
                       ndatafile++;
@@ -3528,7 +4433,7 @@ int main(int argc, char **argv) {
             }
 
             /* make sure there is space for the data */
-            if (time_ok && cnt[kgrid] >= num[kgrid]) {
+            if (time_ok && !out_of_core && cnt[kgrid] >= num[kgrid]) {
               num[kgrid] += REALLOC_STEP_SIZE;
               if ((data[kgrid] = (double *)realloc(data[kgrid], num[kgrid] * sizeof(double))) == nullptr) {
                 error = MB_ERROR_MEMORY_FAIL;
@@ -3547,8 +4452,12 @@ int main(int argc, char **argv) {
 
             /* process it */
             if (time_ok) {
-              value = data[kgrid];
-              value[cnt[kgrid]] = topofactor * tvalue;
+              if (out_of_core)
+                mbgrid_spill_add(&spill, ix, iy, topofactor * tvalue);
+              else {
+                value = data[kgrid];
+                value[cnt[kgrid]] = topofactor * tvalue;
+              }
               cnt[kgrid]++;
               ndata++;
               ndatafile++;
@@ -3604,25 +4513,90 @@ int main(int argc, char **argv) {
     nbinzero = 0;
     nbinspline = 0;
     nbinbackground = 0;
-    for (int i = 0; i < gxdim; i++)
-      for (int j = 0; j < gydim; j++) {
-        kgrid = i * gydim + j;
-        if (cnt[kgrid] > 0) {
-          value = data[kgrid];
-          qsort((char *)value, cnt[kgrid], sizeof(double), mb_double_compare);
-          grid[kgrid] = value[cnt[kgrid] / 2];
-          sigma[kgrid] = 0.0;
-          for (int k = 0; k < cnt[kgrid]; k++)
-            sigma[kgrid] += (value[k] - grid[kgrid]) * (value[k] - grid[kgrid]);
-          if (cnt[kgrid] > 1)
-            sigma[kgrid] = sqrt(sigma[kgrid] / (cnt[kgrid] - 1));
+
+    /* get the median of the values in a bin */
+    auto median_bin = [&](int kgrid, double *value) {
+      qsort((char *)value, cnt[kgrid], sizeof(double), mb_double_compare);
+      grid[kgrid] = value[cnt[kgrid] / 2];
+      sigma[kgrid] = 0.0;
+      for (int k = 0; k < cnt[kgrid]; k++)
+        sigma[kgrid] += (value[k] - grid[kgrid]) * (value[k] - grid[kgrid]);
+      if (cnt[kgrid] > 1)
+        sigma[kgrid] = sqrt(sigma[kgrid] / (cnt[kgrid] - 1));
+      else
+        sigma[kgrid] = 0.0;
+    };
+
+    /* if the data are in the scratch file load and reduce one tile at a time */
+    if (out_of_core) {
+      if (spill.error != MB_ERROR_NO_ERROR) {
+        char *message = nullptr;
+        mb_error(verbose, spill.error, &message);
+        fprintf(outfp, "\nMBIO Error writing median filter scratch file:\n%s\n", message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(spill.error);
+      }
+      for (int i = 0; i < gxdim; i++)
+        for (int j = 0; j < gydim; j++) {
+          kgrid = i * gydim + j;
+          if (cnt[kgrid] > 0)
+            nbinset++;
           else
-            sigma[kgrid] = 0.0;
-          nbinset++;
+            grid[kgrid] = clipvalue;
+        }
+      std::vector<mbgrid_spill_value> values;
+      std::vector<double> binvalues;
+      for (int itile = 0; itile < spill.ntx * spill.nty; itile++) {
+        if (mbgrid_spill_tile(&spill, itile, values, &error) != MB_SUCCESS) {
+          char *message = nullptr;
+          mb_error(verbose, error, &message);
+          fprintf(outfp, "\nMBIO Error reading median filter scratch file:\n%s\n", message);
+          fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+          mb_memory_clear(verbose, &memclear_error);
+          exit(error);
+        }
+
+        /* the values of each bin follow one another, and only the last
+            cnt[kgrid] remain if the bin was reset by the swath overlap check */
+        for (size_t k = 0; k < values.size(); k += spill.total[values[k].kgrid]) {
+          kgrid = values[k].kgrid;
+          if (cnt[kgrid] > 0) {
+            binvalues.clear();
+            for (size_t kk = k + spill.total[kgrid] - cnt[kgrid]; kk < k + spill.total[kgrid]; kk++)
+              binvalues.push_back(values[kk].value);
+            median_bin(kgrid, binvalues.data());
+          }
         }
-        else
-          grid[kgrid] = clipvalue;
       }
+      mbgrid_spill_close(&spill, &error);
+    }
+
+    /* else sort the values in each bin, dividing the grid columns among
+        the gridding threads as each bin is independent of the others */
+    else {
+      std::vector<int> nbinset_thread(nthreads, 0);
+      auto median_columns = [&](int ithread) {
+        for (int i = ithread * gxdim / nthreads; i < (ithread + 1) * gxdim / nthreads; i++)
+          for (int j = 0; j < gydim; j++) {
+            const int kgrid = i * gydim + j;
+            if (cnt[kgrid] > 0) {
+              median_bin(kgrid, data[kgrid]);
+              nbinset_thread[ithread]++;
+            }
+            else
+              grid[kgrid] = clipvalue;
+          }
+      };
+      std::vector<std::thread> median_threads;
+      for (int ithread = 1; ithread < nthreads; ithread++)
+        median_threads.emplace_back(median_columns, ithread);
+      median_columns(0);
+      for (std::thread &median_thread : median_threads)
+        median_thread.join();
+      for (int ithread = 0; ithread < nthreads; ithread++)
+        nbinset += nbinset_thread[ithread];
+    }
 
     /* now deallocate space for the data */
     for (int i = 0; i < gxdim; i++)
@@ -3667,6 +4641,49 @@ int main(int argc, char **argv) {
         cnt[kgrid] = 0;
       }
 
+    /* set up the accumulation of soundings into the grid */
+    struct mbgrid_tiles_struct tiles;
+    mbgrid_tiles_init(&tiles, verbose, grid_mode, nthreads, gxdim, gydim, wbnd, dx, dy, factor, use_projection,
+                      mtodeglon, mtodeglat, grid, norm, sigma, num, cnt);
+
+    /* with incremental gridding start from the accumulator saved before,
+        saving the contribution of each file gridded in the new one */
+    struct mbgrid_acc_struct acc;
+    char accfile[MB_PATH_MAXLINE + 16];
+    char acctmpfile[MB_PATH_MAXLINE + 16];
+    std::string signature;
+    struct mbgrid_acc_file accentry;
+    int nreused = 0;
+    int ngridded = 0;
+    if (incremental) {
+      snprintf(accfile, sizeof(accfile), "%s.acc", fileroot);
+      snprintf(acctmpfile, sizeof(acctmpfile), "%s.acc.tmp", fileroot);
+
+      /* the contributions can only be reused with the same gridding parameters */
+      const double parameters[] = {(double)gxdim, (double)gydim, wbnd[0], wbnd[1], wbnd[2], wbnd[3], dx, dy,
+                                   (double)datatype, factor, (double)xtradim, topofactor, (double)pings,
+                                   (double)lonflip, bounds[0], bounds[1], bounds[2], bounds[3], speedmin, timegap,
+                                   (double)shift_mode, shift_lon, shift_lat};
+      char value[64];
+      for (const double parameter : parameters) {
+        snprintf(value, sizeof(value), "%.17g ", parameter);
+        signature += value;
+      }
+      for (int i = 0; i < 7; i++) {
+        snprintf(value, sizeof(value), "%d %d ", btime_i[i], etime_i[i]);
+        signature += value;
+      }
+      signature += projection_id;
+
+      if (mbgrid_acc_init(&acc, verbose, accfile, acctmpfile, signature.c_str(), &error) != MB_SUCCESS) {
+        fprintf(outfp, "\nUnable to open accumulator file: %s\n", acctmpfile);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(error);
+      }
+      tiles.touched.assign(tiles.ntx * tiles.nty, false);
+    }
+
     /* read in data */
     ndata = 0;
     const int look_processed = MB_DATALIST_LOOK_UNSET;
@@ -3681,6 +4698,25 @@ int main(int argc, char **argv) {
            MB_SUCCESS) {
       ndatafile = 0;
 
+      /* with incremental gridding reuse the contribution of a file
+          unchanged since the accumulator was saved */
+      if (incremental && path[0] != '#') {
+        mbgrid_acc_identify(&accentry, pstatus, astatus, path, format, file_weight, apath,
+                            (format > 0 && pstatus == MB_PROCESSED_USE) ? ppath : path,
+                            (astatus == MB_ALTNAV_USE) ? apath : nullptr);
+        if (mbgrid_acc_reuse(&acc, accentry, &ndatafile)) {
+          ndata += ndatafile;
+          nreused++;
+          if (verbose > 0 || ndatafile > 0)
+            fprintf(outfp, "%d data points reused in %s\n", ndatafile, path);
+          if (ndatafile > 0 && dfp != nullptr) {
+            fprintf(dfp, "%s\n", accentry.key.c_str());
+            fflush(dfp);
+          }
+          continue;
+        }
+      }
+
       /* if format > 0 then input is swath sonar file */
       if (format > 0 && path[0] != '#') {
         /* apply pstatus */
@@ -3723,6 +4759,10 @@ int main(int argc, char **argv) {
             exit(error);
           }
 
+          /* only swath data are gridded, so bulky records such as water column need not be decoded */
+          mb_set_lazy_decode(verbose, mbio_ptr, true, &error);
+          mb_set_pingcache(verbose, mbio_ptr, true, &error);
+
           /* allocate memory for reading data arrays */
           if (error == MB_ERROR_NO_ERROR)
             status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag,
@@ -3803,10 +4843,7 @@ int main(int argc, char **argv) {
 
               /* reproject beam positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < beams_bath; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_bath, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -3857,24 +4894,8 @@ int main(int argc, char **argv) {
                   if (grid_mode == MBGRID_WEIGHTED_MEAN
                       && ix >= 0 && ix < gxdim
                       && iy >= 0 && iy < gydim && time_ok) {
-                    ix1 = std::max(ix - xtradim, 0);
-                    ix2 = std::min(ix + xtradim, gxdim - 1);
-                    iy1 = std::max(iy - xtradim, 0);
-                    iy2 = std::min(iy + xtradim, gydim - 1);
-                    for (int ii = ix1; ii <= ix2; ii++)
-                      for (int jj = iy1; jj <= iy2; jj++) {
-                        kgrid = ii * gydim + jj;
-                        xx = wbnd[0] + ii * dx - bathlon[ib];
-                        yy = wbnd[2] + jj * dy - bathlat[ib];
-                        weight = file_weight * exp(-(xx * xx + yy * yy) * factor);
-                        norm[kgrid] = norm[kgrid] + weight;
-                        grid[kgrid] = grid[kgrid] + weight * topofactor * bath[ib];
-                        sigma[kgrid] =
-                            sigma[kgrid] + weight * topofactor * topofactor * bath[ib] * bath[ib];
-                        num[kgrid]++;
-                        if (ii == ix && jj == iy)
-                          cnt[kgrid]++;
-                      }
+                    mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_GAUSSIAN, ix, iy, xtradim, xtradim, bathlon[ib],
+                                              bathlat[ib], topofactor, bath[ib], file_weight});
                     ndata++;
                     ndatafile++;
                     if (first) {
@@ -3887,18 +4908,8 @@ int main(int argc, char **argv) {
                     }
                   }
                   else if (ix >= 0 && ix < gxdim && iy >= 0 && iy < gydim && time_ok) {
-                    kgrid = ix * gydim + iy;
-                    if ((num[kgrid] > 0 && grid_mode == MBGRID_MINIMUM_FILTER &&
-                         grid[kgrid] > topofactor * bath[ib]) ||
-                        (num[kgrid] > 0 && grid_mode == MBGRID_MAXIMUM_FILTER &&
-                         grid[kgrid] < topofactor * bath[ib]) ||
-                        num[kgrid] <= 0) {
-                      norm[kgrid] = 1.0;
-                      grid[kgrid] = topofactor * bath[ib];
-                      sigma[kgrid] = topofactor * topofactor * bath[ib] * bath[ib];
-                      num[kgrid] = 1;
-                      cnt[kgrid] = 1;
-                    }
+                    mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_FILTER, ix, iy, 0, 0, bathlon[ib], bathlat[ib],
+                                              topofactor, bath[ib], file_weight});
                     ndata++;
                     ndatafile++;
                     if (first) {
@@ -3916,10 +4927,7 @@ int main(int argc, char **argv) {
 
               /* reproject beam positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < beams_amp; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_amp, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -3967,23 +4975,8 @@ int main(int argc, char **argv) {
                   if (grid_mode == MBGRID_WEIGHTED_MEAN
                       && ix >= 0 && ix < gxdim
                       && iy >= 0 && iy < gydim && time_ok) {
-                    ix1 = std::max(ix - xtradim, 0);
-                    ix2 = std::min(ix + xtradim, gxdim - 1);
-                    iy1 = std::max(iy - xtradim, 0);
-                    iy2 = std::min(iy + xtradim, gydim - 1);
-                    for (int ii = ix1; ii <= ix2; ii++)
-                      for (int jj = iy1; jj <= iy2; jj++) {
-                        kgrid = ii * gydim + jj;
-                        xx = wbnd[0] + ii * dx - bathlon[ib];
-                        yy = wbnd[2] + jj * dy - bathlat[ib];
-                        weight = file_weight * exp(-(xx * xx + yy * yy) * factor);
-                        norm[kgrid] = norm[kgrid] + weight;
-                        grid[kgrid] = grid[kgrid] + weight * amp[ib];
-                        sigma[kgrid] = sigma[kgrid] + weight * amp[ib] * amp[ib];
-                        num[kgrid]++;
-                        if (ii == ix && jj == iy)
-                          cnt[kgrid]++;
-                      }
+                    mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_GAUSSIAN, ix, iy, xtradim, xtradim, bathlon[ib],
+                                              bathlat[ib], 1.0, amp[ib], file_weight});
                     ndata++;
                     ndatafile++;
                     if (first) {
@@ -3996,16 +4989,8 @@ int main(int argc, char **argv) {
                     }
                   }
                   else if (ix >= 0 && ix < gxdim && iy >= 0 && iy < gydim && time_ok) {
-                    kgrid = ix * gydim + iy;
-                    if ((num[kgrid] > 0 && grid_mode == MBGRID_MINIMUM_FILTER && grid[kgrid] > amp[ib]) ||
-                        (num[kgrid] > 0 && grid_mode == MBGRID_MAXIMUM_FILTER && grid[kgrid] < amp[ib]) ||
-                        num[kgrid] <= 0) {
-                      norm[kgrid] = 1.0;
-                      grid[kgrid] = amp[ib];
-                      sigma[kgrid] = amp[ib] * amp[ib];
-                      num[kgrid] = 1;
-                      cnt[kgrid] = 1;
-                    }
+                    mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_FILTER, ix, iy, 0, 0, bathlon[ib], bathlat[ib],
+                                              1.0, amp[ib], file_weight});
                     ndata++;
                     ndatafile++;
                     if (first) {
@@ -4023,9 +5008,7 @@ int main(int argc, char **argv) {
 
               /* reproject pixel positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < pixels_ss; ib++)
-                  if (ss[ib] > MB_SIDESCAN_NULL)
-                    mb_proj_forward(verbose, pjptr, sslon[ib], sslat[ib], &sslon[ib], &sslat[ib], &error);
+                mb_proj_forward_array(verbose, pjptr, pixels_ss, sslon, sslat, &error);
               }
 
               /* deal with data */
@@ -4073,37 +5056,14 @@ int main(int argc, char **argv) {
                   if (grid_mode == MBGRID_WEIGHTED_MEAN
                       && ix >= 0 && ix < gxdim
                       && iy >= 0 && iy < gydim && time_ok) {
-                    ix1 = std::max(ix - xtradim, 0);
-                    ix2 = std::min(ix + xtradim, gxdim - 1);
-                    iy1 = std::max(iy - xtradim, 0);
-                    iy2 = std::min(iy + xtradim, gydim - 1);
-                    for (int ii = ix1; ii <= ix2; ii++)
-                      for (int jj = iy1; jj <= iy2; jj++) {
-                        kgrid = ii * gydim + jj;
-                        xx = wbnd[0] + ii * dx - sslon[ib];
-                        yy = wbnd[2] + jj * dy - sslat[ib];
-                        weight = file_weight * exp(-(xx * xx + yy * yy) * factor);
-                        norm[kgrid] = norm[kgrid] + weight;
-                        grid[kgrid] = grid[kgrid] + weight * ss[ib];
-                        sigma[kgrid] = sigma[kgrid] + weight * ss[ib] * ss[ib];
-                        num[kgrid]++;
-                        if (ii == ix && jj == iy)
-                          cnt[kgrid]++;
-                      }
+                    mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_GAUSSIAN, ix, iy, xtradim, xtradim, sslon[ib],
+                                              sslat[ib], 1.0, ss[ib], file_weight});
                     ndata++;
                     ndatafile++;
                   }
                   else if (ix >= 0 && ix < gxdim && iy >= 0 && iy < gydim && time_ok) {
-                    kgrid = ix * gydim + iy;
-                    if ((num[kgrid] > 0 && grid_mode == MBGRID_MINIMUM_FILTER && grid[kgrid] > ss[ib]) ||
-                        (num[kgrid] > 0 && grid_mode == MBGRID_MAXIMUM_FILTER && grid[kgrid] < ss[ib]) ||
-                        num[kgrid] <= 0) {
-                      norm[kgrid] = 1.0;
-                      grid[kgrid] = ss[ib];
-                      sigma[kgrid] = ss[ib] * ss[ib];
-                      num[kgrid] = 1;
-                      cnt[kgrid] = 1;
-                    }
+                    mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_FILTER, ix, iy, 0, 0, sslon[ib], sslat[ib], 1.0,
+                                              ss[ib], file_weight});
                     ndata++;
                     ndatafile++;
                   }
@@ -4186,37 +5146,14 @@ int main(int argc, char **argv) {
           /* process the data */
           if (grid_mode == MBGRID_WEIGHTED_MEAN && ix >= -xtradim && ix < gxdim + xtradim && iy >= -xtradim &&
               iy < gydim + xtradim && time_ok) {
-            ix1 = std::max(ix - xtradim, 0);
-            ix2 = std::min(ix + xtradim, gxdim - 1);
-            iy1 = std::max(iy - xtradim, 0);
-            iy2 = std::min(iy + xtradim, gydim - 1);
-            for (int ii = ix1; ii <= ix2; ii++)
-              for (int jj = iy1; jj <= iy2; jj++) {
-                kgrid = ii * gydim + jj;
-                xx = wbnd[0] + ii * dx - tlon;
-                yy = wbnd[2] + jj * dy - tlat;
-                weight = file_weight * exp(-(xx * xx + yy * yy) * factor);
-                norm[kgrid] = norm[kgrid] + weight;
-                grid[kgrid] = grid[kgrid] + weight * topofactor * tvalue;
-                sigma[kgrid] = sigma[kgrid] + weight * topofactor * topofactor * tvalue * tvalue;
-                num[kgrid]++;
-                if (ii == ix && jj == iy)
-                  cnt[kgrid]++;
-              }
+            mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_GAUSSIAN, ix, iy, xtradim, xtradim, tlon, tlat, topofactor,
+                                      tvalue, file_weight});
             ndata++;
             ndatafile++;
           }
           else if (ix >= 0 && ix < gxdim && iy >= 0 && iy < gydim && time_ok) {
-            kgrid = ix * gydim + iy;
-            if ((num[kgrid] > 0 && grid_mode == MBGRID_MINIMUM_FILTER && grid[kgrid] > topofactor * tvalue) ||
-                (num[kgrid] > 0 && grid_mode == MBGRID_MAXIMUM_FILTER && grid[kgrid] < topofactor * tvalue) ||
-                num[kgrid] <= 0) {
-              norm[kgrid] = 1.0;
-              grid[kgrid] = topofactor * tvalue;
-              sigma[kgrid] = topofactor * topofactor * tvalue * tvalue;
-              num[kgrid] = 1;
-              cnt[kgrid] = 1;
-            }
+            mbgrid_tiles_add(&tiles, {MBGRID_KERNEL_FILTER, ix, iy, 0, 0, tlon, tlat, topofactor, tvalue,
+                                      file_weight});
             ndata++;
             ndatafile++;
           }
@@ -4244,6 +5181,13 @@ int main(int argc, char **argv) {
           fflush(dfp);
         }
       } /* end if (format == 0) */
+
+      /* with incremental gridding save the contribution of the file */
+      if (incremental && path[0] != '#') {
+        accentry.ndata = ndatafile;
+        mbgrid_acc_save(&acc, accentry, &tiles);
+        ngridded++;
+      }
     }
     if (datalist != nullptr)
       mb_datalist_close(verbose, &datalist, &error);
@@ -4255,6 +5199,26 @@ int main(int argc, char **argv) {
       dfp = nullptr;
     }
 
+    /* wait for all soundings to be accumulated */
+    mbgrid_tiles_flush(&tiles, true);
+
+    /* with incremental gridding replace the accumulator saved before and
+        sum the contributions of the files now in it */
+    if (incremental) {
+      const int nreplaced = acc.files.size() - nreused;
+      if (mbgrid_acc_close(&acc, accfile, acctmpfile, signature.c_str(), gxdim * gydim, grid, norm, sigma, num, cnt,
+                           &error) != MB_SUCCESS) {
+        char *message = nullptr;
+        mb_error(verbose, error, &message);
+        fprintf(outfp, "\nMBIO Error writing accumulator file %s:\n%s\n", accfile, message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(error);
+      }
+      fprintf(outfp, "%d files reused, %d files gridded and %d saved files replaced or removed in %s\n", nreused,
+              ngridded, nreplaced, accfile);
+    }
+
     /* now loop over all points in the output grid */
     if (verbose >= 1)
       fprintf(outfp, "\nMaking raw grid...\n");
@@ -4373,6 +5337,10 @@ int main(int argc, char **argv) {
             exit(error);
           }
 
+          /* only swath data are gridded, so bulky records such as water column need not be decoded */
+          mb_set_lazy_decode(verbose, mbio_ptr, true, &error);
+          mb_set_pingcache(verbose, mbio_ptr, true, &error);
+
           /* allocate memory for reading data arrays */
           if (error == MB_ERROR_NO_ERROR)
             status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag,
@@ -4453,10 +5421,7 @@ int main(int argc, char **argv) {
 
               /* reproject beam positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < beams_bath; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_bath, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -4532,10 +5497,7 @@ int main(int argc, char **argv) {
 
               /* reproject beam positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < beams_amp; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_amp, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -4609,9 +5571,7 @@ int main(int argc, char **argv) {
 
               /* reproject pixel positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < pixels_ss; ib++)
-                  if (ss[ib] > MB_SIDESCAN_NULL)
-                    mb_proj_forward(verbose, pjptr, sslon[ib], sslat[ib], &sslon[ib], &sslat[ib], &error);
+                mb_proj_forward_array(verbose, pjptr, pixels_ss, sslon, sslat, &error);
               }
 
               /* deal with data */
@@ -4783,6 +5743,10 @@ int main(int argc, char **argv) {
             exit(error);
           }
 
+          /* only swath data are gridded, so bulky records such as water column need not be decoded */
+          mb_set_lazy_decode(verbose, mbio_ptr, true, &error);
+          mb_set_pingcache(verbose, mbio_ptr, true, &error);
+
           /* allocate memory for reading data arrays */
           if (error == MB_ERROR_NO_ERROR)
             status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag,
@@ -4863,10 +5827,7 @@ int main(int argc, char **argv) {
 
               /* reproject beam positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < beams_bath; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_bath, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -4955,10 +5916,7 @@ int main(int argc, char **argv) {
 
               /* reproject beam positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < beams_amp; ib++)
-                  if (mb_beam_ok(beamflag[ib]))
-                    mb_proj_forward(verbose, pjptr, bathlon[ib], bathlat[ib], &bathlon[ib], &bathlat[ib],
-                                    &error);
+                mb_proj_forward_array(verbose, pjptr, beams_amp, bathlon, bathlat, &error);
               }
 
               /* deal with data */
@@ -5044,9 +6002,7 @@ int main(int argc, char **argv) {
 
               /* reproject pixel positions if necessary */
               if (use_projection) {
-                for (ib = 0; ib < pixels_ss; ib++)
-                  if (ss[ib] > MB_SIDESCAN_NULL)
-                    mb_proj_forward(verbose, pjptr, sslon[ib], sslat[ib], &sslon[ib], &sslat[ib], &error);
+                mb_proj_forward_array(verbose, pjptr, pixels_ss, sslon, sslat, &error);
               }
 
               /* deal with data */
@@ -5192,7 +6148,7 @@ int main(int argc, char **argv) {
 /* -------------------------------------------------------------------------- */
 
   /* if clip set do smooth interpolation */
-  if (clipmode != MBGRID_INTERP_NONE && clip > 0 && nbinset > 0) {
+  if (clipmode != MBGRID_INTERP_NONE && clipmode != MBGRID_INTERP_NEAREST && clip > 0 && nbinset > 0) {
     /* set up data vector */
     if (setborder)
       ndata = 2 * gxdim + 2 * gydim - 2;
@@ -5205,177 +6161,183 @@ int main(int argc, char **argv) {
           ndata++;
       }
 
-#ifdef USESURFACE
-    /* allocate and initialize sgrid */
-    status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&sxdata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&sydata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&szdata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(float), (void **)&sgrid, &error);
-    if (error != MB_ERROR_NO_ERROR) {
-      char *message = nullptr;
-      mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-      fprintf(outfp, "\nMBIO Error allocating interpolation work arrays:\n%s\n", message);
-      fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
-      mb_memory_clear(verbose, &memclear_error);
-      exit(error);
-    }
-    memset((char *)sgrid, 0, gxdim * gydim * sizeof(float));
-    memset((char *)sxdata, 0, ndata * sizeof(float));
-    memset((char *)sydata, 0, ndata * sizeof(float));
-    memset((char *)szdata, 0, ndata * sizeof(float));
-
-    /* get points from grid */
-    /* simultaneously find the depth values nearest to the grid corners and edge midpoints */
-    ndata = 0;
-    for (int i = 0; i < gxdim; i++)
-      for (int j = 0; j < gydim; j++) {
-        kgrid = i * gydim + j;
-        if (grid[kgrid] < clipvalue) {
-          sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          szdata[ndata] = (float)grid[kgrid];
-          ndata++;
-        }
+    if (use_surface) {
+      /* allocate and initialize sgrid */
+      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&sxdata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&sydata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&szdata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(float), (void **)&sgrid, &error);
+      if (error != MB_ERROR_NO_ERROR) {
+        char *message = nullptr;
+        mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+        fprintf(outfp, "\nMBIO Error allocating interpolation work arrays:\n%s\n", message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(error);
       }
-
-    /* if desired set border */
-    if (setborder) {
-      for (int i = 0; i < gxdim; i++) {
-        j = 0;
-        kgrid = i * gydim + j;
-        if (grid[kgrid] >= clipvalue) {
-          sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          szdata[ndata] = (float)border;
-          ndata++;
-        }
-        j = gydim - 1;
-        kgrid = i * gydim + j;
-        if (grid[kgrid] >= clipvalue) {
-          sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          szdata[ndata] = (float)border;
-          ndata++;
+      memset((char *)sgrid, 0, gxdim * gydim * sizeof(float));
+      memset((char *)sxdata, 0, ndata * sizeof(float));
+      memset((char *)sydata, 0, ndata * sizeof(float));
+      memset((char *)szdata, 0, ndata * sizeof(float));
+
+      /* get points from grid */
+      /* simultaneously find the depth values nearest to the grid corners and edge midpoints */
+      ndata = 0;
+      for (int i = 0; i < gxdim; i++)
+        for (int j = 0; j < gydim; j++) {
+          kgrid = i * gydim + j;
+          if (grid[kgrid] < clipvalue) {
+            sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            szdata[ndata] = (float)grid[kgrid];
+            ndata++;
+          }
         }
-      }
-      for (int j = 1; j < gydim - 1; j++) {
-        i = 0;
-        kgrid = i * gydim + j;
-        if (grid[kgrid] >= clipvalue) {
-          sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          szdata[ndata] = (float)border;
-          ndata++;
+
+      /* if desired set border */
+      if (setborder) {
+        for (int i = 0; i < gxdim; i++) {
+          int j = 0;
+          kgrid = i * gydim + j;
+          if (grid[kgrid] >= clipvalue) {
+            sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            szdata[ndata] = (float)border;
+            ndata++;
+          }
+          j = gydim - 1;
+          kgrid = i * gydim + j;
+          if (grid[kgrid] >= clipvalue) {
+            sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            szdata[ndata] = (float)border;
+            ndata++;
+          }
         }
-        i = gxdim - 1;
-        kgrid = i * gydim + j;
-        if (grid[kgrid] >= clipvalue) {
-          sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          szdata[ndata] = (float)border;
-          ndata++;
+        for (int j = 1; j < gydim - 1; j++) {
+          int i = 0;
+          kgrid = i * gydim + j;
+          if (grid[kgrid] >= clipvalue) {
+            sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            szdata[ndata] = (float)border;
+            ndata++;
+          }
+          i = gxdim - 1;
+          kgrid = i * gydim + j;
+          if (grid[kgrid] >= clipvalue) {
+            sxdata[ndata] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sydata[ndata] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            szdata[ndata] = (float)border;
+            ndata++;
+          }
         }
       }
-    }
 
-    /* do the interpolation */
-    fprintf(outfp, "\nDoing Surface spline interpolation with %d data points...\n", ndata);
-    mb_surface(verbose, ndata, sxdata, sydata, szdata, (float)(gbnd[0] - bdata_origin_x), (float)(gbnd[1] - bdata_origin_x),
-               (float)(gbnd[2] - bdata_origin_y), (float)(gbnd[3] - bdata_origin_y), dx, dy, tension, sgrid);
-#else
-    /* allocate and initialize sgrid */
-    status = mb_mallocd(verbose, __FILE__, __LINE__, 3 * ndata * sizeof(float), (void **)&sdata, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(float), (void **)&sgrid, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&work1, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(int), (void **)&work2, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, (gxdim + gydim) * sizeof(bool), (void **)&work3, &error);
-    if (error != MB_ERROR_NO_ERROR) {
-      char *message = nullptr;
-      mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-      fprintf(outfp, "\nMBIO Error allocating interpolation work arrays:\n%s\n", message);
-      fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
-      mb_memory_clear(verbose, &memclear_error);
-      exit(error);
+      /* do the interpolation */
+      fprintf(outfp, "\nDoing Surface spline interpolation with %d data points...\n", ndata);
+      void *surface_ptr = nullptr;
+      if (mb_surface_init(verbose, nthreads, &surface_ptr, &error) == MB_SUCCESS) {
+        mb_surface_grid(verbose, surface_ptr, ndata, sxdata, sydata, szdata, (float)(gbnd[0] - bdata_origin_x),
+                        (float)(gbnd[1] - bdata_origin_x), (float)(gbnd[2] - bdata_origin_y),
+                        (float)(gbnd[3] - bdata_origin_y), dx, dy, tension, sgrid, &error);
+        mb_surface_deall(verbose, &surface_ptr, &error);
+      }
     }
-    memset((char *)sgrid, 0, gxdim * gydim * sizeof(float));
-    memset((char *)sdata, 0, 3 * ndata * sizeof(float));
-    memset((char *)work1, 0, ndata * sizeof(float));
-    memset((char *)work2, 0, ndata * sizeof(int));
-    memset((char *)work3, 0, (gxdim + gydim) * sizeof(bool));
-
-    /* get points from grid */
-    /* simultaneously find the depth values nearest to the grid corners and edge midpoints */
-    ndata = 0;
-    for (int i = 0; i < gxdim; i++)
-      for (int j = 0; j < gydim; j++) {
-        kgrid = i * gydim + j;
-        if (grid[kgrid] < clipvalue) {
-          sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          sdata[ndata++] = (float)grid[kgrid];
-        }
+    else {
+      /* allocate and initialize sgrid */
+      status = mb_mallocd(verbose, __FILE__, __LINE__, 3 * ndata * sizeof(float), (void **)&sdata, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(float), (void **)&sgrid, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(float), (void **)&work1, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, ndata * sizeof(int), (void **)&work2, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, (gxdim + gydim) * sizeof(bool), (void **)&work3, &error);
+      if (error != MB_ERROR_NO_ERROR) {
+        char *message = nullptr;
+        mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+        fprintf(outfp, "\nMBIO Error allocating interpolation work arrays:\n%s\n", message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(error);
       }
-
-    /* if desired set border */
-    if (setborder) {
-      for (int i = 0; i < gxdim; i++) {
-        int j = 0;
-        kgrid = i * gydim + j;
-        if (grid[kgrid] >= clipvalue) {
-          sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          sdata[ndata++] = (float)border;
-        }
-        j = gydim - 1;
-        kgrid = i * gydim + j;
-        if (grid[kgrid] >= clipvalue) {
-          sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          sdata[ndata++] = (float)border;
+      memset((char *)sgrid, 0, gxdim * gydim * sizeof(float));
+      memset((char *)sdata, 0, 3 * ndata * sizeof(float));
+      memset((char *)work1, 0, ndata * sizeof(float));
+      memset((char *)work2, 0, ndata * sizeof(int));
+      memset((char *)work3, 0, (gxdim + gydim) * sizeof(bool));
+
+      /* get points from grid */
+      /* simultaneously find the depth values nearest to the grid corners and edge midpoints */
+      ndata = 0;
+      for (int i = 0; i < gxdim; i++)
+        for (int j = 0; j < gydim; j++) {
+          kgrid = i * gydim + j;
+          if (grid[kgrid] < clipvalue) {
+            sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            sdata[ndata++] = (float)grid[kgrid];
+          }
         }
-      }
-      for (int j = 1; j < gydim - 1; j++) {
-        int i = 0;
-        kgrid = i * gydim + j;
-        if (grid[kgrid] >= clipvalue) {
-          sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          sdata[ndata++] = (float)border;
+
+      /* if desired set border */
+      if (setborder) {
+        for (int i = 0; i < gxdim; i++) {
+          int j = 0;
+          kgrid = i * gydim + j;
+          if (grid[kgrid] >= clipvalue) {
+            sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            sdata[ndata++] = (float)border;
+          }
+          j = gydim - 1;
+          kgrid = i * gydim + j;
+          if (grid[kgrid] >= clipvalue) {
+            sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            sdata[ndata++] = (float)border;
+          }
         }
-        i = gxdim - 1;
-        kgrid = i * gydim + j;
-        if (grid[kgrid] >= clipvalue) {
-          sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
-          sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
-          sdata[ndata++] = (float)border;
+        for (int j = 1; j < gydim - 1; j++) {
+          int i = 0;
+          kgrid = i * gydim + j;
+          if (grid[kgrid] >= clipvalue) {
+            sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            sdata[ndata++] = (float)border;
+          }
+          i = gxdim - 1;
+          kgrid = i * gydim + j;
+          if (grid[kgrid] >= clipvalue) {
+            sdata[ndata++] = (float)(wbnd[0] + dx * i - bdata_origin_x);
+            sdata[ndata++] = (float)(wbnd[2] + dy * j - bdata_origin_y);
+            sdata[ndata++] = (float)border;
+          }
         }
       }
+      ndata = ndata / 3;
+
+      /* do the interpolation */
+      float cay = (float)tension;
+      float xmin = (float)(wbnd[0] - 0.5 * dx - bdata_origin_x);
+      float ymin = (float)(wbnd[2] - 0.5 * dy - bdata_origin_y);
+      float ddx = (float)dx;
+      float ddy = (float)dy;
+      fprintf(outfp, "\nDoing Zgrid spline interpolation with %d data points...\n", ndata);
+      /*for (i=0;i<ndata/3;i++)
+      {
+      if (sdata[3*i+2]>2000.0)
+      fprintf(stderr,"%d %f\n",i,sdata[3*i+2]);
+      }*/
+      if (clipmode == MBGRID_INTERP_ALL)
+        clip = std::max(gxdim, gydim);
+      mb_zgrid(sgrid, &gxdim, &gydim, &xmin, &ymin, &ddx, &ddy, sdata, &ndata, work1, work2, work3, &cay, &clip);
     }
-    ndata = ndata / 3;
-
-    /* do the interpolation */
-    float cay = (float)tension;
-    float xmin = (float)(wbnd[0] - 0.5 * dx - bdata_origin_x);
-    float ymin = (float)(wbnd[2] - 0.5 * dy - bdata_origin_y);
-    float ddx = (float)dx;
-    float ddy = (float)dy;
-    fprintf(outfp, "\nDoing Zgrid spline interpolation with %d data points...\n", ndata);
-    /*for (i=0;i<ndata/3;i++)
-    {
-    if (sdata[3*i+2]>2000.0)
-    fprintf(stderr,"%d %f\n",i,sdata[3*i+2]);
-    }*/
-    if (clipmode == MBGRID_INTERP_ALL)
-      clip = std::max(gxdim, gydim);
-    mb_zgrid(sgrid, &gxdim, &gydim, &xmin, &ymin, &ddx, &ddy, sdata, &ndata, work1, work2, work3, &cay, &clip);
-#endif
 
     if (clipmode == MBGRID_INTERP_GAP)
       fprintf(outfp, "Applying spline interpolation to fill gaps of %d cells or less...\n", clip);
@@ -5403,11 +6365,7 @@ int main(int argc, char **argv) {
       for (int i = 0; i < gxdim; i++)
         for (int j = 0; j < gydim; j++) {
           kgrid = i * gydim + j;
-#ifdef USESURFACE
-          kint = i + (gydim - j - 1) * gxdim;
-#else
-          kint = i + j * gxdim;
-#endif
+          kint = use_surface ? i + (gydim - j - 1) * gxdim : i + j * gxdim;
           smask[kgrid] = false;
           if (grid[kgrid] >= clipvalue && sgrid[kint] < zflag) {
             /* initialize direction mask of search */
@@ -5484,11 +6442,7 @@ int main(int argc, char **argv) {
       for (int i = 0; i < gxdim; i++)
         for (int j = 0; j < gydim; j++) {
           kgrid = i * gydim + j;
-#ifdef USESURFACE
-          kint = i + (gydim - j - 1) * gxdim;
-#else
-          kint = i + j * gxdim;
-#endif
+          kint = use_surface ? i + (gydim - j - 1) * gxdim : i + j * gxdim;
           if (smask[kgrid] == true) {
             grid[kgrid] = sgrid[kint];
             nbinspline++;
@@ -5499,64 +6453,12 @@ int main(int argc, char **argv) {
     /* translate the interpolation into the grid array
         filling by proximity */
     else if (clipmode == MBGRID_INTERP_NEAR) {
+      mbgrid_near_mask(gxdim, gydim, grid, clipvalue, clip, smask);
       for (int i = 0; i < gxdim; i++)
         for (int j = 0; j < gydim; j++) {
           kgrid = i * gydim + j;
-#ifdef USESURFACE
-          kint = i + (gydim - j - 1) * gxdim;
-#else
-          kint = i + j * gxdim;
-#endif
-
-          smask[kgrid] = false;
-          if (grid[kgrid] >= clipvalue && sgrid[kint] < zflag) {
-            /* loop over rings around point, starting close */
-            for (int ir = 0; ir <= clip && smask[kgrid] == false; ir++) {
-              /* set bounds of search */
-              const int i1 = std::max(0, i - ir);
-              const int i2 = std::min(gxdim - 1, i + ir);
-              const int j1 = std::max(0, j - ir);
-              const int j2 = std::min(gydim - 1, j + ir);
-
-              int jj = j1;
-              for (int ii = i1; ii <= i2 && smask[kgrid] == false; ii++) {
-                if (grid[ii * gydim + jj] < clipvalue) {
-                  smask[kgrid] = true;
-                }
-              }
-
-              jj = j2;
-              for (int ii = i1; ii <= i2 && smask[kgrid] == false; ii++) {
-                if (grid[ii * gydim + jj] < clipvalue) {
-                  smask[kgrid] = true;
-                }
-              }
-
-              int ii = i1;
-              for (jj = j1; jj <= j2 && smask[kgrid] == false; jj++) {
-                if (grid[ii * gydim + jj] < clipvalue) {
-                  smask[kgrid] = true;
-                }
-              }
-
-              ii = i2;
-              for (jj = j1; jj <= j2 && smask[kgrid] == false; jj++) {
-                if (grid[ii * gydim + jj] < clipvalue) {
-                  smask[kgrid] = true;
-                }
-              }
-            }
-          }
-        }
-      for (int i = 0; i < gxdim; i++)
-        for (int j = 0; j < gydim; j++) {
-          kgrid = i * gydim + j;
-#ifdef USESURFACE
-          kint = i + (gydim - j - 1) * gxdim;
-#else
-          kint = i + j * gxdim;
-#endif
-          if (smask[kgrid] == true) {
+          kint = use_surface ? i + (gydim - j - 1) * gxdim : i + j * gxdim;
+          if (smask[kgrid] == true && sgrid[kint] < zflag) {
             grid[kgrid] = sgrid[kint];
             nbinspline++;
           }
@@ -5569,11 +6471,7 @@ int main(int argc, char **argv) {
       for (int i = 0; i < gxdim; i++)
         for (int j = 0; j < gydim; j++) {
           kgrid = i * gydim + j;
-#ifdef USESURFACE
-          kint = i + (gydim - j - 1) * gxdim;
-#else
-          kint = i + j * gxdim;
-#endif
+          kint = use_surface ? i + (gydim - j - 1) * gxdim : i + j * gxdim;
           if (grid[kgrid] >= clipvalue && sgrid[kint] < zflag) {
             grid[kgrid] = sgrid[kint];
             nbinspline++;
@@ -5581,76 +6479,150 @@ int main(int argc, char **argv) {
         }
     }
 
-/* deallocate the interpolation arrays */
-#ifdef USESURFACE
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&sxdata, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&sydata, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&szdata, &error);
-#else
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&sdata, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&work1, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&work2, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&work3, &error);
-#endif
+    /* deallocate the interpolation arrays */
+    if (use_surface) {
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&sxdata, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&sydata, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&szdata, &error);
+    }
+    else {
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&sdata, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&work1, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&work2, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&work3, &error);
+    }
     mb_freed(verbose, __FILE__, __LINE__, (void **)&smask, &error);
     mb_freed(verbose, __FILE__, __LINE__, (void **)&sgrid, &error);
   }
-/* -------------------------------------------------------------------------- */
 
-  /* if grdrasterid set and background data previously read in
-      then interpolate it onto internal grid */
-  if (grdrasterid != 0 && nbackground > 0) {
+  /* if clip set in nearest data mode fill the empty cells within clip cells
+      of data using the inverse distance weighted mean of the nearest data */
+  if (clipmode == MBGRID_INTERP_NEAREST && clip > 0 && nbinset > 0) {
+    fprintf(outfp, "\nApplying inverse distance interpolation to fill %d cells from data...\n", clip);
 
-/* allocate and initialize grid and work arrays */
-#ifdef USESURFACE
-    status = mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(float), (void **)&sgrid, &error);
-    if (error != MB_ERROR_NO_ERROR) {
+    /* get the distance from each cell to the nearest data */
+    double *sdist2 = nullptr;
+    if (mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(double), (void **)&sdist2, &error) != MB_SUCCESS) {
       char *message = nullptr;
       mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-      fprintf(outfp, "\nMBIO Error allocating background data array:\n%s\n", message);
+      fprintf(outfp, "\nMBIO Error allocating interpolation work arrays:\n%s\n", message);
       fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
       mb_memory_clear(verbose, &memclear_error);
       exit(error);
     }
-    memset((char *)sgrid, 0, gxdim * gydim * sizeof(float));
-#else
-    status = mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(float), (void **)&sgrid, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground * sizeof(float), (void **)&work1, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground * sizeof(int), (void **)&work2, &error);
-    if (status == MB_SUCCESS)
-      status = mb_mallocd(verbose, __FILE__, __LINE__, (gxdim + gydim) * sizeof(int), (void **)&work3, &error);
-    if (error != MB_ERROR_NO_ERROR) {
-      char *message = nullptr;
-      mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
-      fprintf(outfp, "\nMBIO Error allocating background interpolation work arrays:\n%s\n", message);
-      fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
-      mb_memory_clear(verbose, &memclear_error);
-      exit(error);
+    mbgrid_distance_transform(gxdim, gydim, grid, clipvalue, sdist2);
+
+    /* put the data cells in a k-d tree */
+    std::vector<mbgrid_kdtree_point> points;
+    points.reserve(nbinset);
+    for (int i = 0; i < gxdim; i++)
+      for (int j = 0; j < gydim; j++) {
+        kgrid = i * gydim + j;
+        if (grid[kgrid] < clipvalue)
+          points.push_back({i, j, grid[kgrid]});
+      }
+    mbgrid_kdtree_build(points, 0, points.size(), 0);
+
+    /* fill the empty cells within clip cells of data, dividing the grid
+        columns among the gridding threads as each cell is independent
+        of the others */
+    const double clip2 = (double)clip * clip;
+    std::vector<int> nbinspline_thread(nthreads, 0);
+    auto nearest_columns = [&](int ithread) {
+      int nearest[MBGRID_NEAREST_NUMBER];
+      double dist2[MBGRID_NEAREST_NUMBER];
+      for (int i = ithread * gxdim / nthreads; i < (ithread + 1) * gxdim / nthreads; i++)
+        for (int j = 0; j < gydim; j++) {
+          const int kgrid = i * gydim + j;
+          if (grid[kgrid] >= clipvalue && sdist2[kgrid] <= clip2) {
+            int nfound = 0;
+            mbgrid_kdtree_nearest(points, 0, points.size(), 0, i, j, clip2, &nfound, nearest, dist2);
+            double sumw = 0.0;
+            double sumvw = 0.0;
+            for (int k = 0; k < nfound; k++) {
+              sumw += 1.0 / dist2[k];
+              sumvw += points[nearest[k]].value / dist2[k];
+            }
+            if (sumw > 0.0) {
+              grid[kgrid] = sumvw / sumw;
+              nbinspline_thread[ithread]++;
+            }
+          }
+        }
+    };
+    std::vector<std::thread> nearest_threads;
+    for (int ithread = 1; ithread < nthreads; ithread++)
+      nearest_threads.emplace_back(nearest_columns, ithread);
+    nearest_columns(0);
+    for (std::thread &nearest_thread : nearest_threads)
+      nearest_thread.join();
+    for (int ithread = 0; ithread < nthreads; ithread++)
+      nbinspline += nbinspline_thread[ithread];
+
+    mb_freed(verbose, __FILE__, __LINE__, (void **)&sdist2, &error);
+  }
+/* -------------------------------------------------------------------------- */
+
+  /* if grdrasterid set and background data previously read in
+      then interpolate it onto internal grid */
+  if (grdrasterid != 0 && nbackground > 0) {
+
+    /* allocate and initialize grid and work arrays */
+    if (use_surface) {
+      status = mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(float), (void **)&sgrid, &error);
+      if (error != MB_ERROR_NO_ERROR) {
+        char *message = nullptr;
+        mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+        fprintf(outfp, "\nMBIO Error allocating background data array:\n%s\n", message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(error);
+      }
+      memset((char *)sgrid, 0, gxdim * gydim * sizeof(float));
+    }
+    else {
+      status = mb_mallocd(verbose, __FILE__, __LINE__, gxdim * gydim * sizeof(float), (void **)&sgrid, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground * sizeof(float), (void **)&work1, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, nbackground * sizeof(int), (void **)&work2, &error);
+      if (status == MB_SUCCESS)
+        status = mb_mallocd(verbose, __FILE__, __LINE__, (gxdim + gydim) * sizeof(int), (void **)&work3, &error);
+      if (error != MB_ERROR_NO_ERROR) {
+        char *message = nullptr;
+        mb_error(verbose, MB_ERROR_MEMORY_FAIL, &message);
+        fprintf(outfp, "\nMBIO Error allocating background interpolation work arrays:\n%s\n", message);
+        fprintf(outfp, "\nProgram <%s> Terminated\n", program_name);
+        mb_memory_clear(verbose, &memclear_error);
+        exit(error);
+      }
+      memset((char *)sgrid, 0, gxdim * gydim * sizeof(float));
+      memset((char *)work1, 0, nbackground * sizeof(float));
+      memset((char *)work2, 0, nbackground * sizeof(int));
+      memset((char *)work3, 0, (gxdim + gydim) * sizeof(int));
     }
-    memset((char *)sgrid, 0, gxdim * gydim * sizeof(float));
-    memset((char *)work1, 0, nbackground * sizeof(float));
-    memset((char *)work2, 0, nbackground * sizeof(int));
-    memset((char *)work3, 0, (gxdim + gydim) * sizeof(int));
-#endif
 
     /* do the interpolation */
     fprintf(outfp, "\nDoing spline interpolation with %d background points...\n", nbackground);
-#ifdef USESURFACE
-    mb_surface(verbose, nbackground, bxdata, bydata, bzdata, (float)(wbnd[0] - bdata_origin_x),
-               (float)(wbnd[1] - bdata_origin_x), (float)(wbnd[2] - bdata_origin_y), (float)(wbnd[3] - bdata_origin_y), dx,
-               dy, tension, sgrid);
-#else
-    float cay = (float)tension;
-    float xmin = (float)(wbnd[0] - 0.5 * dx - bdata_origin_x);
-    float ymin = (float)(wbnd[2] - 0.5 * dy - bdata_origin_y);
-    float ddx = (float)dx;
-    float ddy = (float)dy;
-    clip = std::max(gxdim, gydim);
-    fprintf(outfp, "\nDoing Zgrid spline interpolation with %d background points...\n", nbackground);
-    mb_zgrid(sgrid, &gxdim, &gydim, &xmin, &ymin, &ddx, &ddy, bdata, &nbackground, work1, work2, work3, &cay, &clip);
-#endif
+    if (use_surface) {
+      void *surface_ptr = nullptr;
+      if (mb_surface_init(verbose, nthreads, &surface_ptr, &error) == MB_SUCCESS) {
+        mb_surface_grid(verbose, surface_ptr, nbackground, bxdata, bydata, bzdata, (float)(wbnd[0] - bdata_origin_x),
+                        (float)(wbnd[1] - bdata_origin_x), (float)(wbnd[2] - bdata_origin_y),
+                        (float)(wbnd[3] - bdata_origin_y), dx, dy, tension, sgrid, &error);
+        mb_surface_deall(verbose, &surface_ptr, &error);
+      }
+    }
+    else {
+      float cay = (float)tension;
+      float xmin = (float)(wbnd[0] - 0.5 * dx - bdata_origin_x);
+      float ymin = (float)(wbnd[2] - 0.5 * dy - bdata_origin_y);
+      float ddx = (float)dx;
+      float ddy = (float)dy;
+      clip = std::max(gxdim, gydim);
+      fprintf(outfp, "\nDoing Zgrid spline interpolation with %d background points...\n", nbackground);
+      mb_zgrid(sgrid, &gxdim, &gydim, &xmin, &ymin, &ddx, &ddy, bdata, &nbackground, work1, work2, work3, &cay, &clip);
+    }
 
     /* translate the interpolation into the grid array
         - interpolate only to fill a data gap */
@@ -5658,26 +6630,23 @@ int main(int argc, char **argv) {
     for (int i = 0; i < gxdim; i++)
       for (int j = 0; j < gydim; j++) {
         kgrid = i * gydim + j;
-#ifdef USESURFACE
-        kint = i + (gydim - j - 1) * gxdim;
-#else
-        kint = i + j * gxdim;
-#endif
+        kint = use_surface ? i + (gydim - j - 1) * gxdim : i + j * gxdim;
         if (grid[kgrid] >= clipvalue && sgrid[kint] < zflag) {
           grid[kgrid] = sgrid[kint];
           nbinbackground++;
         }
       }
-#ifdef USESURFACE
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&bxdata, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&bydata, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&bzdata, &error);
-#else
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&bdata, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&work1, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&work2, &error);
-    mb_freed(verbose, __FILE__, __LINE__, (void **)&work3, &error);
-#endif
+    if (use_surface) {
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&bxdata, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&bydata, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&bzdata, &error);
+    }
+    else {
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&bdata, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&work1, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&work2, &error);
+      mb_freed(verbose, __FILE__, __LINE__, (void **)&work3, &error);
+    }
     mb_freed(verbose, __FILE__, __LINE__, (void **)&sgrid, &error);
   }
 /* -------------------------------------------------------------------------- */
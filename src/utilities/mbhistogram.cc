@@ -41,6 +41,7 @@
 #include <unistd.h>
 
 #include "mb_define.h"
+#include "mb_io.h"
 #include "mb_status.h"
 
 typedef enum {
@@ -58,7 +59,7 @@ constexpr char help_message[] =
     "\tThe results are dumped to stdout.";
 constexpr char usage_message[] =
     "mbhistogram [-Akind -Byr/mo/da/hr/mn/sc -Dmin/max -Eyr/mo/da/hr/mn/sc -Fformat -G -Ifile -Llonflip "
-    "-Mnintervals -Nnbins -Ppings -Rw/e/s/n -Sspeed -V -H]";
+    "-Mnintervals -Nnbins -Ppings -Rw/e/s/n -Sspeed -Zthreads -V -H]";
 
 /*--------------------------------------------------------------------*/
 
@@ -108,6 +109,50 @@ double qsnorm(double p) {
 	return (-z);
 }
 
+/*--------------------------------------------------------------------*/
+/* add the values of one ping to the histogram, returning the number of values */
+int mbhistogram_add(histogram_mode_t mode, int beams_bath, int beams_amp, int pixels_ss, const char *beamflag,
+                    const double *bath, const double *amp, const double *ss, int nbins, double value_bin_min,
+                    double dvalue_bin, double *histogram, bool *data_first, double *data_min, double *data_max) {
+	int nvalue = 0;
+	int nvalues = 0;
+	const double *values = nullptr;
+	if (mode == MBHISTOGRAM_BATH) {
+		nvalues = beams_bath;
+		values = bath;
+	}
+	else if (mode == MBHISTOGRAM_AMP) {
+		nvalues = beams_amp;
+		values = amp;
+	}
+	else if (mode == MBHISTOGRAM_SS) {
+		nvalues = pixels_ss;
+		values = ss;
+	}
+
+	for (int i = 0; i < nvalues; i++) {
+		/* bathymetry and amplitude use the beam flags, sidescan the null value */
+		const bool ok = (mode == MBHISTOGRAM_SS) ? values[i] > MB_SIDESCAN_NULL : mb_beam_ok(beamflag[i]);
+		if (ok) {
+			nvalue++;
+			const int j = (values[i] - value_bin_min) / dvalue_bin;
+			if (j >= 0 && j < nbins)
+				histogram[j]++;
+			if (*data_first) {
+				*data_min = values[i];
+				*data_max = values[i];
+				*data_first = false;
+			}
+			else {
+				*data_min = std::min(values[i], *data_min);
+				*data_max = std::max(values[i], *data_max);
+			}
+		}
+	}
+
+	return (nvalue);
+}
+
 /*--------------------------------------------------------------------*/
 
 int main(int argc, char **argv) {
@@ -129,13 +174,14 @@ int main(int argc, char **argv) {
 	bool gaussian = false;
 	int nintervals = 0;
 	int nbins = 0;
+	int nthreads = 1;
 	FILE *output;
 
 	{
 		bool errflg = false;
 		bool help = false;
 		int c;
-		while ((c = getopt(argc, argv, "A:a:B:b:D:d:E:e:F:f:GgHhI:i:L:l:M:m:N:n:P:p:R:r:S:s:T:t:Vv")) != -1)
+		while ((c = getopt(argc, argv, "A:a:B:b:D:d:E:e:F:f:GgHhI:i:L:l:M:m:N:n:P:p:R:r:S:s:T:t:VvZ:z:")) != -1)
 		{
 			switch (c) {
 			case 'A':
@@ -209,6 +255,10 @@ int main(int argc, char **argv) {
 			case 'v':
 				verbose++;
 				break;
+			case 'Z':
+			case 'z':
+				sscanf(optarg, "%d", &nthreads);
+				break;
 			case '?':
 				errflg = true;
 			}
@@ -283,16 +333,15 @@ int main(int argc, char **argv) {
 		fprintf(output, "dbg2       nintervals: %d\n", nintervals);
 		fprintf(output, "dbg2       value_min:  %f\n", value_min);
 		fprintf(output, "dbg2       value_max:  %f\n", value_max);
+		fprintf(output, "dbg2       nthreads:   %d\n", nthreads);
 	}
 
 
 	/* MBIO read control parameters */
 	void *datalist;
-	double file_weight;
 	double btime_d;
 	double etime_d;
 	char file[MB_PATH_MAXLINE];
-	char dfile[MB_PATH_MAXLINE];
 	int beams_bath;
 	int beams_amp;
 	int pixels_ss;
@@ -371,9 +420,14 @@ int main(int argc, char **argv) {
 
 	/* determine whether to read one file or a list of files */
 	const bool read_datalist = format < 0;
-	bool read_data;
 
-	/* open file list */
+	double data_min = INFINITY;
+	double data_max = -INFINITY;
+	bool data_first = true;
+
+	/* read the files in the datalist concurrently - the histogram does not
+	    depend on the order of the pings, so they are taken as they are
+	    decoded unless the files are being reported one at a time */
 	if (read_datalist) {
 		const int look_processed = MB_DATALIST_LOOK_UNSET;
 		if (mb_datalist_open(verbose, &datalist, read_file, look_processed, &error) != MB_SUCCESS) {
@@ -381,19 +435,63 @@ int main(int argc, char **argv) {
 			fprintf(stderr, "\nProgram <%s> Terminated\n", program_name);
 			exit(MB_ERROR_OPEN_FAIL);
 		}
-		read_data = mb_datalist_read(verbose, datalist, file, dfile, &format, &file_weight, &error) == MB_SUCCESS;
-	} else {
-		// else copy single filename to be read
-		strcpy(file, read_file);
-		read_data = true;
-	}
+		void *reader = nullptr;
+		if (mb_read_datalist_init(verbose, datalist, pings, lonflip, bounds, btime_i, etime_i, speedmin, timegap, false,
+		                          nthreads, 0, verbose > 0, &reader, &error) != MB_SUCCESS) {
+			char *message;
+			mb_error(verbose, error, &message);
+			fprintf(output, "\nMBIO Error returned from function <mb_read_datalist_init>:\n%s\n", message);
+			fprintf(output, "\nProgram <%s> Terminated\n", program_name);
+			exit(error);
+		}
 
-	double data_min = INFINITY;
-	double data_max = -INFINITY;
-	bool data_first = true;
+		int ifile = -1;
+		int nrec = 0;
+		int nvalue = 0;
+		struct mb_datalist_ping_struct *ping = nullptr;
+		while (mb_read_datalist(verbose, reader, (void **)&ping, &error) == MB_SUCCESS || ping != nullptr) {
+			/* output information */
+			if (ping->ifile != ifile && verbose > 0) {
+				if (ifile >= 0)
+					fprintf(stderr, "%d records processed\n%d data processed\n", nrec, nvalue);
+				fprintf(stderr, "\nprocessing file: %s %d\n", ping->path, ping->format);
+			}
+			if (ping->ifile != ifile) {
+				ifile = ping->ifile;
+				nrec = 0;
+				nvalue = 0;
+			}
+
+			/* a file that could not be read is reported and skipped */
+			if (ping->error > MB_ERROR_NO_ERROR) {
+				char *message;
+				mb_error(verbose, ping->error, &message);
+				fprintf(stderr, "\nMBIO Error reading swath file <%s>:\n%s\n", ping->path, message);
+			}
+
+			/* process the pings */
+			else if (ping->error == MB_ERROR_NO_ERROR || ping->error == MB_ERROR_TIME_GAP) {
+				nrec++;
+				nrectot++;
+				const int n = mbhistogram_add(mode, ping->nbath, ping->namp, ping->nss, ping->beamflag, ping->bath,
+				                              ping->amp, ping->ss, nbins, value_bin_min, dvalue_bin, histogram,
+				                              &data_first, &data_min, &data_max);
+				nvalue += n;
+				nvaluetot += n;
+			}
+		}
+		if (ifile >= 0 && verbose > 0)
+			fprintf(stderr, "%d records processed\n%d data processed\n", nrec, nvalue);
+		if (error == MB_ERROR_EOF)
+			error = MB_ERROR_NO_ERROR;
+
+		mb_read_datalist_close(verbose, &reader, &error);
+		mb_datalist_close(verbose, &datalist, &error);
+	}
 
-	/* loop over all files to be read */
-	while (read_data) {
+	/* read a single file */
+	else {
+		strcpy(file, read_file);
 
 		/* obtain format array location - format id will
 		    be aliased to current id if old format id given */
@@ -461,65 +559,8 @@ int main(int argc, char **argv) {
 				/* increment record counter */
 				nrec++;
 
-				/* do the bathymetry */
-				if (mode == MBHISTOGRAM_BATH)
-					for (int i = 0; i < beams_bath; i++) {
-						if (mb_beam_ok(beamflag[i])) {
-							nvalue++;
-							const int j = (bath[i] - value_bin_min) / dvalue_bin;
-							if (j >= 0 && j < nbins)
-								histogram[j]++;
-							if (data_first) {
-								data_min = bath[i];
-								data_max = bath[i];
-								data_first = false;
-							}
-							else {
-								data_min = std::min(bath[i], data_min);
-								data_max = std::max(bath[i], data_max);
-							}
-						}
-					}
-
-				/* do the amplitude */
-				if (mode == MBHISTOGRAM_AMP)
-					for (int i = 0; i < beams_amp; i++) {
-						if (mb_beam_ok(beamflag[i])) {
-							nvalue++;
-							const int j = (amp[i] - value_bin_min) / dvalue_bin;
-							if (j >= 0 && j < nbins)
-								histogram[j]++;
-							if (data_first) {
-								data_min = amp[i];
-								data_max = amp[i];
-								data_first = false;
-							}
-							else {
-								data_min = std::min(amp[i], data_min);
-								data_max = std::max(amp[i], data_max);
-							}
-						}
-					}
-
-				/* do the sidescan */
-				if (mode == MBHISTOGRAM_SS)
-					for (int i = 0; i < pixels_ss; i++) {
-						if (ss[i] > MB_SIDESCAN_NULL) {
-							nvalue++;
-							const int j = (ss[i] - value_bin_min) / dvalue_bin;
-							if (j >= 0 && j < nbins)
-								histogram[j]++;
-							if (data_first) {
-								data_min = ss[i];
-								data_max = ss[i];
-								data_first = false;
-							}
-							else {
-								data_min = std::min(ss[i], data_min);
-								data_max = std::max(ss[i], data_max);
-							}
-						}
-					}
+				nvalue += mbhistogram_add(mode, beams_bath, beams_amp, pixels_ss, beamflag, bath, amp, ss, nbins,
+				                          value_bin_min, dvalue_bin, histogram, &data_first, &data_min, &data_max);
 			}
 		}
 
@@ -532,18 +573,7 @@ int main(int argc, char **argv) {
 		if (error == MB_ERROR_NO_ERROR && verbose > 0) {
 			fprintf(stderr, "%d records processed\n%d data processed\n", nrec, nvalue);
 		}
-
-		/* figure out whether and what to read next */
-		if (read_datalist) {
-			read_data = mb_datalist_read(verbose, datalist, file, dfile, &format, &file_weight, &error) == MB_SUCCESS;
-		} else {
-			read_data = false;
-		}
-
-		/* end loop over files in list */
 	}
-	if (read_datalist)
-		mb_datalist_close(verbose, &datalist, &error);
 
 	/* output information */
 	if (error == MB_ERROR_NO_ERROR && verbose > 0) {
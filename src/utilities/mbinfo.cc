@@ -724,6 +724,9 @@ int main(int argc, char **argv) {
           fprintf(stream, "\nProgram <%s> Terminated\n", program_name);
           exit(error);
         }
+
+        /* only swath data are summarized, so bulky records such as water column need not be decoded */
+        mb_set_lazy_decode(verbose, mbio_ptr, true, &error);
         
         /* set debug printouts if requested */
         if (enable_debug_record_type_listing || num_debug_record_identifiers > 0) {
@@ -731,6 +734,11 @@ int main(int argc, char **argv) {
         								num_debug_record_identifiers, debug_record_identifiers, &error);
         }
 
+        /* only the values returned by mb_read() are used, so unless records are
+            listed the decoded pings can be shared through the ping cache */
+        if (!enable_debug_record_type_listing && num_debug_record_identifiers == 0)
+          mb_set_pingcache(verbose, mbio_ptr, true, &error);
+
         /* allocate memory for data arrays */
         memset(data, 0, MBINFO_MAXPINGS * sizeof(struct ping));
         for (int i = 0; i < pings_read; i++) {
@@ -937,9 +945,7 @@ int main(int argc, char **argv) {
 						case FREE_TEXT:
 						default:
 						{
-							fprintf(output, "\nSwath Data File:      %s\n", fileprint);
-							fprintf(output, "MBIO Data Format ID:  %d\n", format);
-							fprintf(output, "%s", format_description);
+							mb_info_print_file(verbose, output, fileprint, format, &error);
 							break;
 						}
           }
@@ -2114,72 +2120,59 @@ int main(int argc, char **argv) {
   mb_get_jtime(verbose, timend_i, timend_j);
 
   switch (output_format) {
-  case FREE_TEXT:
-    fprintf(output, "\nData Totals:\n");
-    fprintf(output, "Number of Records:                    %8d\n", irec);
-    isbtmrec = notice_list_tot[MB_DATA_SUBBOTTOM_MCS] + notice_list_tot[MB_DATA_SUBBOTTOM_CNTRBEAM] +
-               notice_list_tot[MB_DATA_SUBBOTTOM_SUBBOTTOM];
-    if (isbtmrec > 0)
-      fprintf(output, "Number of Subbottom Records:          %8d\n", isbtmrec);
-    if (notice_list_tot[MB_DATA_SIDESCAN2] > 0)
-      fprintf(output, "Number of Secondary Sidescan Records: %8d\n", notice_list_tot[MB_DATA_SIDESCAN2]);
-    if (notice_list_tot[MB_DATA_SIDESCAN3] > 0)
-      fprintf(output, "Number of Tertiary Sidescan Records:  %8d\n", notice_list_tot[MB_DATA_SIDESCAN3]);
-    if (notice_list_tot[MB_DATA_WATER_COLUMN] > 0)
-      fprintf(output, "Number of Water Column Records:       %8d\n", notice_list_tot[MB_DATA_WATER_COLUMN]);
-
-    fprintf(output, "Bathymetry Data (%d beams):\n", beams_bath_max);
-    fprintf(output, "  Number of Beams:         %8d\n", ntdbeams);
-    fprintf(output, "  Number of Good Beams:    %8d     %5.2f%%\n", ngdbeams, ngd_percent);
-    fprintf(output, "  Number of Zero Beams:    %8d     %5.2f%%\n", nzdbeams, nzd_percent);
-    fprintf(output, "  Number of Flagged Beams: %8d     %5.2f%%\n", nfdbeams, nfd_percent);
-    fprintf(output, "Amplitude Data (%d beams):\n", beams_amp_max);
-    fprintf(output, "  Number of Beams:         %8d\n", ntabeams);
-    fprintf(output, "  Number of Good Beams:    %8d     %5.2f%%\n", ngabeams, nga_percent);
-    fprintf(output, "  Number of Zero Beams:    %8d     %5.2f%%\n", nzabeams, nza_percent);
-    fprintf(output, "  Number of Flagged Beams: %8d     %5.2f%%\n", nfabeams, nfa_percent);
-    fprintf(output, "Sidescan Data (%d pixels):\n", pixels_ss_max);
-    fprintf(output, "  Number of Pixels:        %8d\n", ntsbeams);
-    fprintf(output, "  Number of Good Pixels:   %8d     %5.2f%%\n", ngsbeams, ngs_percent);
-    fprintf(output, "  Number of Zero Pixels:   %8d     %5.2f%%\n", nzsbeams, nzs_percent);
-    fprintf(output, "  Number of Flagged Pixels:%8d     %5.2f%%\n", nfsbeams, nfs_percent);
-    fprintf(output, "\nNavigation Totals:\n");
-    fprintf(output, "Total Time:         %10.4f hours\n", timtot);
-    fprintf(output, "Total Track Length: %10.4f km\n", distot);
-    fprintf(output, "Average Speed:      %10.4f km/hr (%7.4f knots)\n", spdavg, spdavg / 1.85);
-    fprintf(output, "\nStart of Data:\n");
-    fprintf(output, "Time:  %2.2d %2.2d %4.4d %2.2d:%2.2d:%2.2d.%6.6d  JD%d (%4.4d-%2.2d-%2.2dT%2.2d:%2.2d:%2.2d.%6.6d)\n",
-            timbeg_i[1], timbeg_i[2], timbeg_i[0], timbeg_i[3], timbeg_i[4], timbeg_i[5], timbeg_i[6], timbeg_j[1],
-            timbeg_i[0], timbeg_i[1], timbeg_i[2], timbeg_i[3], timbeg_i[4], timbeg_i[5], timbeg_i[6]);
-    if (bathy_in_meters)
-      fprintf(output, "Lon: %15.9f     Lat: %15.9f     Depth: %10.4f meters\n", lonbeg, latbeg, bathbeg);
-    else
-      fprintf(output, "Lon: %15.9f     Lat: %15.9f     Depth: %10.4f feet\n", lonbeg, latbeg, bathy_scale * bathbeg);
-    fprintf(output, "Speed: %7.4f km/hr (%7.4f knots)  Heading:%9.4f degrees\n", spdbeg, spdbeg / 1.85, hdgbeg);
-    fprintf(output, "Sonar Depth:%10.4f m  Sonar Altitude:%10.4f m\n", sdpbeg, altbeg);
-    fprintf(output, "\nEnd of Data:\n");
-    fprintf(output, "Time:  %2.2d %2.2d %4.4d %2.2d:%2.2d:%2.2d.%6.6d  JD%d (%4.4d-%2.2d-%2.2dT%2.2d:%2.2d:%2.2d.%6.6d)\n",
-            timend_i[1], timend_i[2], timend_i[0], timend_i[3], timend_i[4], timend_i[5], timend_i[6], timend_j[1],
-            timend_i[0], timend_i[1], timend_i[2], timend_i[3], timend_i[4], timend_i[5], timend_i[6]);
-    if (bathy_in_meters)
-      fprintf(output, "Lon: %15.9f     Lat: %15.9f     Depth: %10.4f meters\n", lonend, latend, bathend);
-    else
-      fprintf(output, "Lon: %15.9f     Lat: %15.9f     Depth: %10.4f feet\n", lonend, latend, bathy_scale * bathend);
-    fprintf(output, "Speed: %7.4f km/hr (%7.4f knots)  Heading:%9.4f degrees\n", spdend, spdend / 1.85, hdgend);
-    fprintf(output, "Sonar Depth:%10.4f m  Sonar Altitude:%10.4f m\n", sdpend, altend);
-    fprintf(output, "\nLimits:\n");
-    fprintf(output, "Minimum Longitude:   %15.9f   Maximum Longitude:   %15.9f\n", lonmin, lonmax);
-    fprintf(output, "Minimum Latitude:    %15.9f   Maximum Latitude:    %15.9f\n", latmin, latmax);
-    fprintf(output, "Minimum Sonar Depth: %10.4f   Maximum Sonar Depth: %10.4f\n", sdpmin, sdpmax);
-    fprintf(output, "Minimum Altitude:    %10.4f   Maximum Altitude:    %10.4f\n", altmin, altmax);
-    if (ngdbeams > 0 || verbose >= 1)
-      fprintf(output, "Minimum Depth:       %10.4f   Maximum Depth:       %10.4f\n", bathy_scale * bathmin,
-              bathy_scale * bathmax);
-    if (ngabeams > 0 || verbose >= 1)
-      fprintf(output, "Minimum Amplitude:   %10.4f   Maximum Amplitude:   %10.4f\n", ampmin, ampmax);
-    if (ngsbeams > 0 || verbose >= 1)
-      fprintf(output, "Minimum Sidescan:    %10.4f   Maximum Sidescan:    %10.4f\n", ssmin, ssmax);
+  case FREE_TEXT: {
+    struct mb_info_struct summary;
+    mb_info_init(verbose, &summary, &error);
+    summary.nrecords = irec;
+    summary.nbeams_bath = beams_bath_max;
+    summary.nbeams_bath_total = ntdbeams;
+    summary.nbeams_bath_good = ngdbeams;
+    summary.nbeams_bath_zero = nzdbeams;
+    summary.nbeams_bath_flagged = nfdbeams;
+    summary.nbeams_amp = beams_amp_max;
+    summary.nbeams_amp_total = ntabeams;
+    summary.nbeams_amp_good = ngabeams;
+    summary.nbeams_amp_zero = nzabeams;
+    summary.nbeams_amp_flagged = nfabeams;
+    summary.npixels_ss = pixels_ss_max;
+    summary.npixels_ss_total = ntsbeams;
+    summary.npixels_ss_good = ngsbeams;
+    summary.npixels_ss_zero = nzsbeams;
+    summary.npixels_ss_flagged = nfsbeams;
+    summary.time_total = timtot;
+    summary.dist_total = distot;
+    summary.speed_avg = spdavg;
+    summary.lon_start = lonbeg;
+    summary.lat_start = latbeg;
+    summary.depth_start = bathbeg;
+    summary.speed_start = spdbeg;
+    summary.heading_start = hdgbeg;
+    summary.sensordepth_start = sdpbeg;
+    summary.sonaraltitude_start = altbeg;
+    summary.lon_end = lonend;
+    summary.lat_end = latend;
+    summary.depth_end = bathend;
+    summary.speed_end = spdend;
+    summary.heading_end = hdgend;
+    summary.sensordepth_end = sdpend;
+    summary.sonaraltitude_end = altend;
+    summary.lon_min = lonmin;
+    summary.lon_max = lonmax;
+    summary.lat_min = latmin;
+    summary.lat_max = latmax;
+    summary.sensordepth_min = sdpmin;
+    summary.sensordepth_max = sdpmax;
+    summary.altitude_min = altmin;
+    summary.altitude_max = altmax;
+    summary.depth_min = bathmin;
+    summary.depth_max = bathmax;
+    summary.amp_min = ampmin;
+    summary.amp_max = ampmax;
+    summary.ss_min = ssmin;
+    summary.ss_max = ssmax;
+    mb_info_print_totals(verbose, output, &summary, timbeg_i, timend_i, bathy_in_meters, notice_list_tot, &error);
     break;
+  }
   case JSON:
     fprintf(output, "\"data_totals\": {\n");
     fprintf(output, "\"number_of_records\": \"%d\"", irec);
@@ -2534,30 +2527,7 @@ int main(int argc, char **argv) {
   if (print_notices) {
     switch (output_format) {
     case FREE_TEXT:
-      fprintf(output, "\nData Record Type Notices:\n");
-      for (int i = 0; i <= MB_DATA_KINDS; i++) {
-        if (notice_list_tot[i] > 0) {
-          char *notice_message;
-          mb_notice_message(verbose, i, &notice_message);
-          fprintf(output, "DN: %d %s\n", notice_list_tot[i], notice_message);
-        }
-      }
-      fprintf(output, "\nNonfatal Error Notices:\n");
-      for (int i = MB_DATA_KINDS + 1; i <= MB_DATA_KINDS - (MB_ERROR_MIN); i++) {
-        if (notice_list_tot[i] > 0) {
-          char *notice_message;
-          mb_notice_message(verbose, i, &notice_message);
-          fprintf(output, "EN: %d %s\n", notice_list_tot[i], notice_message);
-        }
-      }
-      fprintf(output, "\nProblem Notices:\n");
-      for (int i = MB_DATA_KINDS - (MB_ERROR_MIN) + 1; i < MB_NOTICE_MAX; i++) {
-        if (notice_list_tot[i] > 0) {
-          char *notice_message;
-          mb_notice_message(verbose, i, &notice_message);
-          fprintf(output, "PN: %d %s\n", notice_list_tot[i], notice_message);
-        }
-      }
+      mb_info_print_notices(verbose, output, notice_list_tot, &error);
       break;
     case JSON: {
       fprintf(output, ",\n\"notices\": {\n");
@@ -2651,15 +2621,7 @@ int main(int argc, char **argv) {
   if (coverage_mask) {
     switch (output_format) {
     case FREE_TEXT:
-      fprintf(output, "\nCoverage Mask:\nCM dimensions: %d %d\n", mask_nx, mask_ny);
-      for (int j = mask_ny - 1; j >= 0; j--) {
-        fprintf(output, "CM:  ");
-        for (int i = 0; i < mask_nx; i++) {
-          const int k = i + j * mask_nx;
-          fprintf(output, " %1d", mask[k]);
-        }
-        fprintf(output, "\n");
-      }
+      mb_info_print_mask(verbose, output, mask_nx, mask_ny, mask, &error);
       break;
     case JSON:
       fprintf(output, ",\n\"coverage_mask\": {\n");
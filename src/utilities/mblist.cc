@@ -3108,6 +3108,10 @@ int main(int argc, char **argv) {
       fprintf(stderr, "\nProgram <%s> Terminated\n", program_name);
       exit(error);
     }
+
+    /* only swath data are listed, so bulky records such as water column need not be decoded */
+    mb_set_lazy_decode(verbose, mbio_ptr, true, &error);
+
     if (verbose > 0) {
       fprintf(stderr, "  mblist opened: %s\n", file);
     }
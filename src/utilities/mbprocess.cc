@@ -576,6 +576,8 @@ void process_file(int verbose, int thread_id, struct mb_process_struct *process,
   double *velocity = nullptr;
   double *velocity_sum = nullptr;
   void *rt_svp = nullptr;
+  void *rt_table = nullptr;
+  double rt_table_time = 0.0;
   double ssv;
   int sensorhead = 0;
   int sensortype = 0;
@@ -4706,10 +4708,22 @@ void process_file(int verbose, int thread_id, struct mb_process_struct *process,
               }
             }
 
-            /* raytrace */
-            *status = mb_rt(verbose, rt_svp, (depth_offset_use - static_shift), angles[i], 0.5 * ttimes[i],
-                           process->mbp_angle_mode, ssv, angles_null[i], 0, nullptr, nullptr, nullptr, nullptr, &xx, &zz, &ttime,
-                           &ray_stat, error);
+            /* raytrace using a lookup table, (re)building the table whenever
+                these data require longer travel times than it spans */
+            const double rt_time = 0.5 * ttimes[i] + 2.0 * (depth_offset_use - static_shift - depth[0]) / velocity[0];
+            if (rt_table == nullptr || rt_time > rt_table_time) {
+              if (rt_table != nullptr)
+                mb_rt_table_deall(verbose, &rt_table, error);
+              rt_table_time = 1.5 * rt_time;
+              mb_rt_table_init(verbose, rt_svp, rt_table_time, &rt_table, error);
+            }
+            if (rt_table != nullptr)
+              *status = mb_rt_table(verbose, rt_table, (depth_offset_use - static_shift), angles[i], 0.5 * ttimes[i],
+                                    process->mbp_angle_mode, ssv, angles_null[i], &xx, &zz, &ttime, &ray_stat, error);
+            else
+              *status = mb_rt(verbose, rt_svp, (depth_offset_use - static_shift), angles[i], 0.5 * ttimes[i],
+                             process->mbp_angle_mode, ssv, angles_null[i], 0, nullptr, nullptr, nullptr, nullptr, &xx, &zz, &ttime,
+                             &ray_stat, error);
 
             /* apply static shift if any */
             zz += static_shift;
@@ -5745,6 +5759,8 @@ void process_file(int verbose, int thread_id, struct mb_process_struct *process,
     mb_freed(verbose, __FILE__, __LINE__, (void **)&depth, error);
     mb_freed(verbose, __FILE__, __LINE__, (void **)&velocity, error);
     mb_freed(verbose, __FILE__, __LINE__, (void **)&velocity_sum, error);
+    if (rt_table != nullptr)
+      *status = mb_rt_table_deall(verbose, &rt_table, error);
     if (rt_svp != nullptr)
       *status = mb_rt_deall(verbose, &rt_svp, error);
   }
@@ -5797,14 +5813,6 @@ int main(int argc, char **argv) {
 
   unsigned int n_threads = 1;
 
-  /* disable keeping a list of allocated memory because the memory list
-      functionality in mb_mem.c is not thread safe */
-  // TODO: add mutex locking/unlocking to allow testing with memory list
-  //       enabled - we will still want it disabled most of the time for
-  //       performance, but it would be good to be able to check for memory
-  //       leaks again.  DWC December 27 2020
-  mb_mem_list_disable(verbose, &error);
-
   /* process argument list */
   {
     bool errflg = false;
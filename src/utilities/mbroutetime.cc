@@ -42,9 +42,11 @@
 
 #include "mb_define.h"
 #include "mb_format.h"
+#include "mb_io.h"
 #include "mb_status.h"
 
 constexpr int MBES_ALLOC_NUM = 128;
+constexpr int MBES_BATCH_PINGS = 256;
 /* constexpr int MBES_ROUTE_WAYPOINT_NONE = 0; */
 /* constexpr int MBES_ROUTE_WAYPOINT_SIMPLE = 1; */
 constexpr int MBES_ROUTE_WAYPOINT_TRANSIT = 2;
@@ -325,24 +327,6 @@ int main(int argc, char **argv) {
 
 	/* MBIO read values */
 	void *mbio_ptr = nullptr;
-	void *store_ptr = nullptr;
-	int kind;
-	int time_i[7];
-	double time_d;
-	double navlon;
-	double navlat;
-	double speed;
-	double distance;
-	double altitude;
-	double sensordepth;
-	char *beamflag = nullptr;
-	double *bath = nullptr;
-	double *bathacrosstrack = nullptr;
-	double *bathalongtrack = nullptr;
-	double *amp = nullptr;
-	double *ss = nullptr;
-	double *ssacrosstrack = nullptr;
-	double *ssalongtrack = nullptr;
 
 	int nroutepointfound = 0;
 
@@ -368,48 +352,21 @@ int main(int argc, char **argv) {
 			exit(error);
 		}
 
-		/* allocate memory for data arrays */
-		if (error == MB_ERROR_NO_ERROR)
-			status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag, &error);
-		if (error == MB_ERROR_NO_ERROR)
-			status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bath, &error);
-		if (error == MB_ERROR_NO_ERROR)
-			status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_AMPLITUDE, sizeof(double), (void **)&amp, &error);
-		if (error == MB_ERROR_NO_ERROR)
-			status =
-			    mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathacrosstrack, &error);
-		if (error == MB_ERROR_NO_ERROR)
-			status =
-			    mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathalongtrack, &error);
-		if (error == MB_ERROR_NO_ERROR)
-			status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ss, &error);
-		if (error == MB_ERROR_NO_ERROR)
-			status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ssacrosstrack, &error);
-		if (error == MB_ERROR_NO_ERROR)
-			status = mb_register_array(verbose, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ssalongtrack, &error);
-
-		/* if error initializing memory then quit */
-		if (error != MB_ERROR_NO_ERROR) {
-			char *message;
-			mb_error(verbose, error, &message);
-			fprintf(stderr, "\nMBIO Error allocating data arrays:\n%s\n", message);
-			fprintf(stderr, "\nProgram <%s> Terminated\n", program_name);
-			exit(error);
-		}
-
-		/* read and use data */
+		/* read and use data, the survey pings being read in batches */
 		int nread = 0;
 		while (error <= MB_ERROR_NO_ERROR && activewaypoint < nroutepoint) {
-			/* reset error */
-			error = MB_ERROR_NO_ERROR;
-
-			/* read next data record */
-			status = mb_get_all(verbose, mbio_ptr, &store_ptr, &kind, time_i, &time_d, &navlon, &navlat, &speed, &heading,
-			                    &distance, &altitude, &sensordepth, &beams_bath, &beams_amp, &pixels_ss, beamflag, bath, amp,
-			                    bathacrosstrack, bathalongtrack, ss, ssacrosstrack, ssalongtrack, comment, &error);
+			/* read next batch of survey pings */
+			int npings = 0;
+			struct mb_batch_struct *batch = nullptr;
+			status = mb_extract_batch(verbose, mbio_ptr, MBES_BATCH_PINGS, &npings, (void **)&batch, &error);
+
+			/* deal with nav and time from survey data only - not nav, sidescan, or subbottom,
+				nor survey pings with nonfatal read errors other than a time gap */
+			for (int iping = 0; iping < npings && activewaypoint < nroutepoint; iping++) {
+				const double time_d = batch->time_d[iping];
+				const double navlon = batch->navlon[iping];
+				const double navlat = batch->navlat[iping];
 
-			/* deal with nav and time from survey data only - not nav, sidescan, or subbottom */
-			if (error <= MB_ERROR_NO_ERROR && kind == MB_DATA_DATA) {
 				/* increment counter */
 				nread++;
 
@@ -418,8 +375,8 @@ int main(int argc, char **argv) {
 					lastlon = navlon;
 				if (navlat != 0.0)
 					lastlat = navlat;
-				if (heading != 0.0)
-					lastheading = heading;
+				if (batch->heading[iping] != 0.0)
+					lastheading = batch->heading[iping];
 				if (time_d != 0.0)
 					lasttime_d = time_d;
 
@@ -446,8 +403,8 @@ int main(int argc, char **argv) {
 			}
 
 			if (verbose >= 2) {
-				fprintf(stderr, "\ndbg2  Ping read in program <%s>\n", program_name);
-				fprintf(stderr, "dbg2       kind:           %d\n", kind);
+				fprintf(stderr, "\ndbg2  Pings read in program <%s>\n", program_name);
+				fprintf(stderr, "dbg2       npings:         %d\n", npings);
 				fprintf(stderr, "dbg2       error:          %d\n", error);
 				fprintf(stderr, "dbg2       status:         %d\n", status);
 			}
@@ -0,0 +1,177 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_process.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kNbath = 8;
+
+class MbEsfTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    filename = ::testing::TempDir() + "mb_esf_test.esf";
+    struct mb_esf_struct esf;
+    int error = MB_ERROR_NO_ERROR;
+    ASSERT_EQ(MB_SUCCESS, mb_esf_open(0, "mb_esf_test", &filename[0], false, MBP_ESF_WRITE, &esf, &error));
+    // Edits for three pings, the second ping repeating the first timestamp.
+    mb_esf_save(0, &esf, kTime0, 1, MBP_EDIT_FLAG, &error);
+    mb_esf_save(0, &esf, kTime0, 1, MBP_EDIT_UNFLAG, &error);
+    mb_esf_save(0, &esf, kTime0, 5, MBP_EDIT_FILTER, &error);
+    mb_esf_save(0, &esf, kTime0, MB_ESF_MULTIPLICITY_FACTOR + 2, MBP_EDIT_ZERO, &error);
+    mb_esf_save(0, &esf, kTime1 + 0.0000005, 3, MBP_EDIT_FLAG, &error);
+    mb_esf_save(0, &esf, kTime1, kNbath + 2, MBP_EDIT_FLAG, &error);
+    mb_esf_save(0, &esf, kTime2, 0, MBP_EDIT_SONAR, &error);
+    ASSERT_EQ(MB_SUCCESS, mb_esf_close(0, &esf, &error));
+  }
+
+  void TearDown() override {
+    std::remove(filename.c_str());
+    std::remove((filename + ".stream").c_str());
+  }
+
+  static constexpr double kTime0 = 1700000000.25;
+  static constexpr double kTime1 = 1700000000.75;
+  static constexpr double kTime2 = 1700000001.25;
+  std::string filename;
+};
+
+TEST_F(MbEsfTest, ApplyOutOfOrder) {
+  struct mb_esf_struct esf;
+  int error = MB_ERROR_NO_ERROR;
+  ASSERT_EQ(MB_SUCCESS, mb_esf_open(0, "mb_esf_test", &filename[0], true, MBP_ESF_NOWRITE, &esf, &error));
+  ASSERT_EQ(7, esf.nedit);
+
+  std::vector<char> ping0(kNbath, MB_FLAG_NONE), ping0b(kNbath, MB_FLAG_NONE);
+  std::vector<char> ping1(kNbath, MB_FLAG_NONE), ping2(kNbath, MB_FLAG_NONE);
+  EXPECT_EQ(MB_SUCCESS, mb_esf_apply(0, &esf, kTime2, 0, kNbath, ping2.data(), &error));
+  EXPECT_EQ(MB_SUCCESS, mb_esf_apply(0, &esf, kTime0, 1, kNbath, ping0b.data(), &error));
+  EXPECT_EQ(MB_SUCCESS, mb_esf_apply(0, &esf, kTime1, 0, kNbath, ping1.data(), &error));
+  EXPECT_EQ(MB_SUCCESS, mb_esf_apply(0, &esf, kTime0, 0, kNbath, ping0.data(), &error));
+
+  // Later edits of a beam override earlier ones.
+  EXPECT_EQ(MB_FLAG_NONE, ping0[1]);
+  EXPECT_TRUE(mb_beam_check_flag_filter(ping0[5]));
+  EXPECT_TRUE(mb_beam_check_flag_null(ping0b[2]));
+  EXPECT_EQ(MB_FLAG_NONE, ping0b[5]);
+  EXPECT_TRUE(mb_beam_check_flag_manual(ping1[3]));
+  EXPECT_TRUE(mb_beam_check_flag_sonar(ping2[0]));
+
+  // Each edit is used once, except the one for a beam the ping lacks.
+  for (int i = 0; i < esf.nedit; i++) {
+    if (esf.edit[i].beam == kNbath + 2)
+      EXPECT_EQ(10000, esf.edit[i].use);
+    else
+      EXPECT_EQ(1, esf.edit[i].use);
+  }
+  EXPECT_EQ(MB_SUCCESS, mb_esf_close(0, &esf, &error));
+}
+
+TEST_F(MbEsfTest, FixTimestamps) {
+  struct mb_esf_struct esf;
+  int error = MB_ERROR_NO_ERROR;
+  ASSERT_EQ(MB_SUCCESS, mb_esf_open(0, "mb_esf_test", &filename[0], true, MBP_ESF_NOWRITE, &esf, &error));
+
+  // Edits moved to a new timestamp are found there and not at the old one.
+  const double time_d = kTime1 + 0.0004;
+  EXPECT_EQ(MB_SUCCESS, mb_esf_fixtimestamps(0, &esf, time_d, 0.001, &error));
+  std::vector<char> old_ping(kNbath, MB_FLAG_NONE), new_ping(kNbath, MB_FLAG_NONE);
+  EXPECT_EQ(MB_SUCCESS, mb_esf_apply(0, &esf, kTime1, 0, kNbath, old_ping.data(), &error));
+  EXPECT_EQ(MB_SUCCESS, mb_esf_apply(0, &esf, time_d, 0, kNbath, new_ping.data(), &error));
+  EXPECT_THAT(old_ping, ::testing::Each(MB_FLAG_NONE));
+  EXPECT_TRUE(mb_beam_check_flag_manual(new_ping[3]));
+  EXPECT_EQ(MB_SUCCESS, mb_esf_close(0, &esf, &error));
+}
+
+using Edit = std::tuple<double, int, int>;
+
+std::vector<Edit> Edits(const struct mb_esf_struct &esf) {
+  std::vector<Edit> edits;
+  for (int i = 0; i < esf.nedit; i++)
+    edits.emplace_back(esf.edit[i].time_d, esf.edit[i].beam, esf.edit[i].action);
+  return edits;
+}
+
+std::vector<Edit> Load(const std::string &filename) {
+  struct mb_esf_struct esf;
+  int error = MB_ERROR_NO_ERROR;
+  std::string name = filename;
+  EXPECT_EQ(MB_SUCCESS, mb_esf_open(0, "mb_esf_test", &name[0], true, MBP_ESF_NOWRITE, &esf, &error));
+  const std::vector<Edit> edits = Edits(esf);
+  mb_esf_close(0, &esf, &error);
+  return edits;
+}
+
+void Save(const std::string &filename, int output, int nedit, int seed) {
+  struct mb_esf_struct esf;
+  int error = MB_ERROR_NO_ERROR;
+  std::string name = filename;
+  ASSERT_EQ(MB_SUCCESS, mb_esf_open(0, "mb_esf_test", &name[0], false, output, &esf, &error));
+  for (int i = 0; i < nedit; i++) {
+    const int ping = (i * 7919 + seed) % 1000;
+    mb_esf_save(0, &esf, 1700000000.0 + 0.5 * ping, (i * 31 + seed) % 200, MBP_EDIT_FLAG + i % 3, &error);
+  }
+  ASSERT_EQ(MB_SUCCESS, mb_esf_close(0, &esf, &error));
+}
+
+std::string Header(const std::string &filename) {
+  char header[MB_PATH_MAXLINE] = "";
+  FILE *fp = std::fopen(filename.c_str(), "rb");
+  if (fp != nullptr) {
+    if (std::fread(header, MB_PATH_MAXLINE, 1, fp) != 1)
+      header[0] = '\0';
+    std::fclose(fp);
+  }
+  header[MB_PATH_MAXLINE - 1] = '\0';
+  return header;
+}
+
+TEST_F(MbEsfTest, CompactAndLoadWindow) {
+  Save(filename, MBP_ESF_WRITE, 5000, 0);
+  const std::vector<Edit> saved = Load(filename);
+  ASSERT_EQ(5000u, saved.size());
+
+  // Compaction sorts the file without changing the edits loaded from it.
+  int error = MB_ERROR_NO_ERROR;
+  ASSERT_EQ(MB_SUCCESS, mb_esf_compact(0, "mb_esf_test", &filename[0], &error));
+  EXPECT_THAT(Header(filename), ::testing::HasSubstr("\nSorted Edits: 5000\n"));
+  EXPECT_EQ(saved, Load(filename));
+
+  // Edits appended after compaction are journaled and loaded with the rest.
+  Save(filename, MBP_ESF_APPEND, 300, 11);
+  const std::vector<Edit> all = Load(filename);
+  ASSERT_EQ(5300u, all.size());
+
+  const double time_d_min = 1700000000.0 + 0.5 * 420;
+  const double time_d_max = 1700000000.0 + 0.5 * 610;
+  std::vector<Edit> expected;
+  for (const auto &edit : all) {
+    if (std::get<0>(edit) >= time_d_min && std::get<0>(edit) <= time_d_max)
+      expected.push_back(edit);
+  }
+  struct mb_esf_struct esf;
+  ASSERT_EQ(MB_SUCCESS, mb_esf_open_window(0, "mb_esf_test", &filename[0], time_d_min, time_d_max, &esf, &error));
+  EXPECT_EQ(expected, Edits(esf));
+  EXPECT_EQ(MB_SUCCESS, mb_esf_close(0, &esf, &error));
+}
+
+TEST_F(MbEsfTest, CloseCompactsLongJournal) {
+  Save(filename, MBP_ESF_WRITE, 70000, 0);
+  EXPECT_THAT(Header(filename), ::testing::HasSubstr("\nSorted Edits: 70000\n"));
+  Save(filename, MBP_ESF_APPEND, 1000, 3);
+  EXPECT_THAT(Header(filename), ::testing::HasSubstr("\nSorted Edits: 70000\n"));
+  EXPECT_EQ(71000u, Load(filename).size());
+}
+
+}  // namespace
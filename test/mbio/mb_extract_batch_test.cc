@@ -0,0 +1,180 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kFormat = 71;  // MBF_MBLDEOIH, which stores a beam count with each ping
+constexpr int kPings = 100;
+constexpr int kGapPing = 60;  // the ping following a ten minute time gap
+
+int BeamCount(int i) { return i < 20 ? 5 : 5 + (i * 7) % 40; }
+
+// Writes a comment and kPings pings whose number of beams changes along the file.
+void WritePings(char *file) {
+  int error = MB_ERROR_NO_ERROR;
+  void *mbio_ptr = nullptr;
+  int beams_bath, beams_amp, pixels_ss;
+  ASSERT_EQ(MB_SUCCESS, mb_write_init(0, file, kFormat, &mbio_ptr, &beams_bath, &beams_amp, &pixels_ss, &error));
+  void *store_ptr = nullptr;
+  mb_get_store(0, mbio_ptr, &store_ptr, &error);
+  char comment[] = "mb_extract_batch_test";
+  mb_put_comment(0, mbio_ptr, comment, &error);
+
+  int time_i[7] = {2020, 1, 1, 0, 0, 0, 0};
+  double t0;
+  mb_get_time(0, time_i, &t0);
+  std::vector<char> beamflag(64);
+  std::vector<double> bath(64), amp(64), bathacrosstrack(64), bathalongtrack(64);
+  double ss[1], ssacrosstrack[1], ssalongtrack[1];
+  for (int i = 0; i < kPings; i++) {
+    const int nbeams = BeamCount(i);
+    for (int j = 0; j < nbeams; j++) {
+      beamflag[j] = j == 2 ? MB_FLAG_FLAG + MB_FLAG_MANUAL : MB_FLAG_NONE;
+      bath[j] = 1000.0 + i + 0.5 * j;
+      amp[j] = j;
+      bathacrosstrack[j] = (j - nbeams / 2) * 50.0;
+      bathalongtrack[j] = 0.0;
+    }
+    const double time_d = t0 + i + (i >= kGapPing ? 600.0 : 0.0);
+    mb_get_date(0, time_d, time_i);
+    EXPECT_EQ(MB_SUCCESS, mb_put_all(0, mbio_ptr, store_ptr, true, MB_DATA_DATA, time_i, time_d, -120.0 + 0.001 * i,
+                                     36.0, 10.0, 90.0, nbeams, nbeams, 0, beamflag.data(), bath.data(), amp.data(),
+                                     bathacrosstrack.data(), bathalongtrack.data(), ss, ssacrosstrack, ssalongtrack,
+                                     nullptr, &error));
+  }
+  mb_close(0, &mbio_ptr, &error);
+}
+
+void *Open(char *file) {
+  double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+  int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+  int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+  void *mbio_ptr = nullptr;
+  double btime_d, etime_d;
+  int beams_bath, beams_amp, pixels_ss;
+  int error = MB_ERROR_NO_ERROR;
+  EXPECT_EQ(MB_SUCCESS, mb_read_init(0, file, kFormat, 1, 0, bounds, btime_i, etime_i, 0.0, 1.0, &mbio_ptr, &btime_d,
+                                     &etime_d, &beams_bath, &beams_amp, &pixels_ss, &error));
+  return mbio_ptr;
+}
+
+struct Ping {
+  double time_d, navlon, navlat, speed, heading, distance, altitude, sensordepth;
+  std::vector<char> beamflag;
+  std::vector<double> bath, bathacrosstrack, bathalongtrack, amp;
+};
+
+// Reads the survey pings one at a time with mb_get_all().
+std::vector<Ping> ReadPings(char *file) {
+  void *mbio_ptr = Open(file);
+  int error = MB_ERROR_NO_ERROR;
+  char *beamflag = nullptr;
+  double *bath = nullptr, *amp = nullptr, *bathacrosstrack = nullptr, *bathalongtrack = nullptr;
+  double *ss = nullptr, *ssacrosstrack = nullptr, *ssalongtrack = nullptr;
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bath, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_AMPLITUDE, sizeof(double), (void **)&amp, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathacrosstrack, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathalongtrack, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ss, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ssacrosstrack, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ssalongtrack, &error);
+
+  std::vector<Ping> pings;
+  void *store_ptr = nullptr;
+  int kind, time_i[7], nbath, namp, nss;
+  char comment[MB_COMMENT_MAXLINE];
+  Ping ping;
+  while (error <= MB_ERROR_NO_ERROR) {
+    const int status = mb_get_all(0, mbio_ptr, &store_ptr, &kind, time_i, &ping.time_d, &ping.navlon, &ping.navlat,
+                                  &ping.speed, &ping.heading, &ping.distance, &ping.altitude, &ping.sensordepth, &nbath,
+                                  &namp, &nss, beamflag, bath, amp, bathacrosstrack, bathalongtrack, ss, ssacrosstrack,
+                                  ssalongtrack, comment, &error);
+    if ((status == MB_SUCCESS || error == MB_ERROR_TIME_GAP) && kind == MB_DATA_DATA) {
+      if (error == MB_ERROR_TIME_GAP)
+        EXPECT_EQ(kGapPing, (int)pings.size());
+      ping.beamflag.assign(beamflag, beamflag + nbath);
+      ping.bath.assign(bath, bath + nbath);
+      ping.bathacrosstrack.assign(bathacrosstrack, bathacrosstrack + nbath);
+      ping.bathalongtrack.assign(bathalongtrack, bathalongtrack + nbath);
+      ping.amp.assign(amp, amp + namp);
+      pings.push_back(ping);
+    }
+  }
+  EXPECT_EQ(MB_ERROR_EOF, error);
+  mb_close(0, &mbio_ptr, &error);
+  return pings;
+}
+
+TEST(MbExtractBatchTest, BatchesMatchSinglePingReads) {
+  std::string path = testing::TempDir() + "mb_extract_batch_test.mb71";
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path.c_str());
+  WritePings(file);
+  const std::vector<Ping> expected = ReadPings(file);
+  ASSERT_EQ(kPings, (int)expected.size());
+
+  for (int npings_want : {1, 7, 64, 1000}) {
+    void *mbio_ptr = Open(file);
+    int error = MB_ERROR_NO_ERROR;
+    int npings = 0;
+    struct mb_batch_struct *batch = nullptr;
+    int iping = 0;
+    while (mb_extract_batch(0, mbio_ptr, npings_want, &npings, (void **)&batch, &error) == MB_SUCCESS) {
+      EXPECT_EQ(MB_ERROR_NO_ERROR, error);
+      EXPECT_GT(npings, 0);
+      EXPECT_LE(npings, npings_want);
+      EXPECT_EQ(npings, batch->npings);
+      EXPECT_EQ(0, batch->bath_offset[0]);
+      for (int i = 0; i < npings; i++, iping++) {
+        ASSERT_LT(iping, kPings);
+        const Ping &ping = expected[iping];
+        EXPECT_DOUBLE_EQ(ping.time_d, batch->time_d[i]);
+        EXPECT_DOUBLE_EQ(ping.navlon, batch->navlon[i]);
+        EXPECT_DOUBLE_EQ(ping.navlat, batch->navlat[i]);
+        EXPECT_DOUBLE_EQ(ping.speed, batch->speed[i]);
+        EXPECT_DOUBLE_EQ(ping.heading, batch->heading[i]);
+        EXPECT_DOUBLE_EQ(ping.distance, batch->distance[i]);
+        EXPECT_DOUBLE_EQ(ping.sensordepth, batch->sensordepth[i]);
+        ASSERT_EQ((int)ping.bath.size(), batch->nbath[i]);
+        ASSERT_EQ((int)ping.amp.size(), batch->namp[i]);
+        EXPECT_EQ(0, batch->nss[i]);
+        EXPECT_EQ(batch->bath_offset[i] + batch->nbath[i], batch->bath_offset[i + 1]);
+        EXPECT_EQ(batch->amp_offset[i] + batch->namp[i], batch->amp_offset[i + 1]);
+        const int k = batch->bath_offset[i];
+        for (int j = 0; j < batch->nbath[i]; j++) {
+          EXPECT_EQ(ping.beamflag[j], batch->beamflag[k + j]);
+          EXPECT_DOUBLE_EQ(ping.bath[j], batch->bath[k + j]);
+          EXPECT_DOUBLE_EQ(ping.bathacrosstrack[j], batch->bathacrosstrack[k + j]);
+          EXPECT_DOUBLE_EQ(ping.bathalongtrack[j], batch->bathalongtrack[k + j]);
+        }
+        for (int j = 0; j < batch->namp[i]; j++)
+          EXPECT_DOUBLE_EQ(ping.amp[j], batch->amp[batch->amp_offset[i] + j]);
+      }
+    }
+    EXPECT_EQ(kPings, iping);
+    EXPECT_EQ(MB_ERROR_EOF, error);
+    EXPECT_EQ(0, npings);
+
+    // The end of the file is reported again on the next call.
+    EXPECT_EQ(MB_FAILURE, mb_extract_batch(0, mbio_ptr, npings_want, &npings, (void **)&batch, &error));
+    EXPECT_EQ(MB_ERROR_EOF, error);
+    mb_close(0, &mbio_ptr, &error);
+  }
+
+  std::remove(path.c_str());
+}
+
+}  // namespace
@@ -5,8 +5,14 @@
 #include "mbio/mb_define.h"  // TODO(schwehr): Move prototypes to mb_format.h.
 #include "mbio/mb_format.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -117,4 +123,87 @@ TEST(MbGetBasenameTest, FbtExtra) {
   free(path);
 }
 
+void WriteFile(const std::string &path, const std::vector<unsigned char> &bytes) {
+  FILE *fp = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(nullptr, fp);
+  std::fwrite(bytes.data(), 1, bytes.size(), fp);
+  std::fclose(fp);
+}
+
+void PutInt(std::vector<unsigned char> *bytes, size_t offset, unsigned value) {
+  for (int i = 0; i < 4; i++)
+    (*bytes)[offset + i] = (value >> (8 * i)) & 0xff;
+}
+
+TEST(MbGetFormatTest, ProbeContents) {
+  std::string path = ::testing::TempDir() + "mb_format_test_probe";
+  int format = -1;
+  int error = MB_ERROR_NO_ERROR;
+  char root[MB_PATH_MAXLINE];
+
+  // A Kongsberg kmall datagram with no suffix to go by.
+  std::vector<unsigned char> kmall(64, 0);
+  PutInt(&kmall, 0, kmall.size());
+  std::memcpy(&kmall[4], "#IIP", 4);
+  PutInt(&kmall, kmall.size() - 4, kmall.size());
+  WriteFile(path, kmall);
+  EXPECT_EQ(MB_SUCCESS, mb_get_format(0, &path[0], root, &format, &error));
+  EXPECT_EQ(MBF_KEMKMALL, format);
+  EXPECT_EQ(path, root);
+
+  // Replacing the file invalidates the cached result.
+  std::vector<unsigned char> all(40, 0);
+  PutInt(&all, 0, all.size() - 4);
+  all[4] = 0x02;
+  all[5] = 'I';
+  all[6] = 2040 & 0xff;
+  all[7] = 2040 >> 8;
+  all[all.size() - 3] = 0x03;
+  WriteFile(path, all);
+  EXPECT_EQ(MB_SUCCESS, mb_get_format(0, &path[0], root, &format, &error));
+  EXPECT_EQ(MBF_EM710RAW, format);
+
+  const std::string text = "## not swath data\n";
+  WriteFile(path, std::vector<unsigned char>(text.begin(), text.end()));
+  EXPECT_EQ(MB_FAILURE, mb_get_format(0, &path[0], root, &format, &error));
+  EXPECT_EQ(MB_ERROR_BAD_FORMAT, error);
+  EXPECT_EQ(0, format);
+  std::remove(path.c_str());
+}
+
+void SetModificationTime(const std::string &path, long nsec) {
+  const struct timespec times[2] = {{1000000000, nsec}, {1000000000, nsec}};
+  ASSERT_EQ(0, utimensat(AT_FDCWD, path.c_str(), times, 0));
+}
+
+TEST(MbGetFormatTest, ProbeSeesSubsecondReplacement) {
+  std::string path = ::testing::TempDir() + "mb_format_test_subsecond";
+  int format = -1;
+  int error = MB_ERROR_NO_ERROR;
+  char root[MB_PATH_MAXLINE];
+
+  std::vector<unsigned char> kmall(64, 0);
+  PutInt(&kmall, 0, kmall.size());
+  std::memcpy(&kmall[4], "#IIP", 4);
+  PutInt(&kmall, kmall.size() - 4, kmall.size());
+  WriteFile(path, kmall);
+  SetModificationTime(path, 100);
+  EXPECT_EQ(MB_SUCCESS, mb_get_format(0, &path[0], root, &format, &error));
+  EXPECT_EQ(MBF_KEMKMALL, format);
+
+  // A file of the same size rewritten within the same second is probed again.
+  std::vector<unsigned char> all(kmall.size(), 0);
+  PutInt(&all, 0, all.size() - 4);
+  all[4] = 0x02;
+  all[5] = 'I';
+  all[6] = 2040 & 0xff;
+  all[7] = 2040 >> 8;
+  all[all.size() - 3] = 0x03;
+  WriteFile(path, all);
+  SetModificationTime(path, 200);
+  EXPECT_EQ(MB_SUCCESS, mb_get_format(0, &path[0], root, &format, &error));
+  EXPECT_EQ(MBF_EM710RAW, format);
+  std::remove(path.c_str());
+}
+
 }  // namespace
@@ -0,0 +1,105 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "mb_define.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+// Buffer of n records of record_size bytes with varied byte values.
+std::vector<char> MakeBuffer(int n, int record_size) {
+  std::vector<char> buffer(n * record_size + 1);
+  for (size_t i = 0; i < buffer.size(); i++)
+    buffer[i] = static_cast<char>(i * 37 + 11);
+  return buffer;
+}
+
+TEST(MbGetValueTest, ArraysMatchScalar) {
+  // Odd sizes and an unaligned start exercise any vectorized loop tails.
+  constexpr int kN = 1023;
+  const std::vector<char> data = MakeBuffer(kN, 8);
+  const char *buffer = &data[1];
+  for (bool swapped : {false, true}) {
+    std::vector<short> s(kN);
+    std::vector<int> i(kN);
+    std::vector<float> f(kN);
+    std::vector<double> d(kN);
+    mb_get_binary_short_array(swapped, kN, buffer, s.data());
+    mb_get_binary_int_array(swapped, kN, buffer, i.data());
+    mb_get_binary_float_array(swapped, kN, buffer, f.data());
+    mb_get_binary_double_array(swapped, kN, buffer, d.data());
+    for (int k = 0; k < kN; k++) {
+      short s_value;
+      int i_value;
+      float f_value;
+      double d_value;
+      mb_get_binary_short(swapped, const_cast<char *>(&buffer[2 * k]), &s_value);
+      mb_get_binary_int(swapped, const_cast<char *>(&buffer[4 * k]), &i_value);
+      mb_get_binary_float(swapped, const_cast<char *>(&buffer[4 * k]), &f_value);
+      mb_get_binary_double(swapped, const_cast<char *>(&buffer[8 * k]), &d_value);
+      EXPECT_EQ(s_value, s[k]);
+      EXPECT_EQ(i_value, i[k]);
+      EXPECT_EQ(0, memcmp(&f_value, &f[k], sizeof(float)));
+      EXPECT_EQ(0, memcmp(&d_value, &d[k], sizeof(double)));
+    }
+  }
+}
+
+TEST(MbGetValueTest, ArrayInPlace) {
+  constexpr int kN = 101;
+  const std::vector<char> data = MakeBuffer(kN, 4);
+  std::vector<int> expected(kN);
+  mb_get_binary_int_array(true, kN, data.data(), expected.data());
+  std::vector<int> values(kN);
+  memcpy(values.data(), data.data(), kN * sizeof(int));
+  mb_get_binary_int_array(true, kN, values.data(), values.data());
+  EXPECT_EQ(expected, values);
+}
+
+struct Beam {
+  float depth;
+  short amp;
+  double range;
+  int window;
+};
+
+TEST(MbGetValueTest, StridedRecords) {
+  // Records of 19 bytes: float at 0, short at 4, double at 6, unsigned short at 14.
+  constexpr int kN = 77;
+  constexpr size_t kRecord = 19;
+  const std::vector<char> data = MakeBuffer(kN, kRecord);
+  for (bool swapped : {false, true}) {
+    std::vector<Beam> beams(kN);
+    std::vector<int> amps(kN);
+    mb_get_binary_float_strided(swapped, kN, &data[0], kRecord, &beams[0].depth, sizeof(Beam));
+    mb_get_binary_short_strided(swapped, kN, &data[4], kRecord, &beams[0].amp, sizeof(Beam));
+    mb_get_binary_double_strided(swapped, kN, &data[6], kRecord, &beams[0].range, sizeof(Beam));
+    mb_get_binary_short_int_strided(swapped, true, kN, &data[14], kRecord, &beams[0].window, sizeof(Beam));
+    mb_get_binary_short_int_strided(swapped, false, kN, &data[14], kRecord, amps.data(), sizeof(int));
+    for (int k = 0; k < kN; k++) {
+      char *record = const_cast<char *>(&data[k * kRecord]);
+      float depth;
+      short amp;
+      double range;
+      short window;
+      mb_get_binary_float(swapped, &record[0], &depth);
+      mb_get_binary_short(swapped, &record[4], &amp);
+      mb_get_binary_double(swapped, &record[6], &range);
+      mb_get_binary_short(swapped, &record[14], &window);
+      EXPECT_EQ(0, memcmp(&depth, &beams[k].depth, sizeof(float)));
+      EXPECT_EQ(amp, beams[k].amp);
+      EXPECT_EQ(0, memcmp(&range, &beams[k].range, sizeof(double)));
+      EXPECT_EQ(static_cast<int>(static_cast<unsigned short>(window)), beams[k].window);
+      EXPECT_EQ(static_cast<int>(window), amps[k]);
+    }
+  }
+}
+
+}  // namespace
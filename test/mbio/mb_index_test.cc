@@ -0,0 +1,298 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_format.h"
+#include "mb_io.h"
+#include "mb_status.h"
+#include "mbsys_reson7k3.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kFormat = 71;  // MBF_MBLDEOIH, which can be read from any record
+constexpr int kPings = 200;
+constexpr int kBeams = 11;
+
+// Writes a comment and kPings pings one second apart starting at 2020/01/01.
+double WritePings(char *file) {
+  int error = MB_ERROR_NO_ERROR;
+  void *mbio_ptr = nullptr;
+  int beams_bath, beams_amp, pixels_ss;
+  EXPECT_EQ(MB_SUCCESS, mb_write_init(0, file, kFormat, &mbio_ptr, &beams_bath, &beams_amp, &pixels_ss, &error));
+  void *store_ptr = nullptr;
+  mb_get_store(0, mbio_ptr, &store_ptr, &error);
+  char comment[] = "mb_index_test";
+  mb_put_comment(0, mbio_ptr, comment, &error);
+
+  int time_i[7] = {2020, 1, 1, 0, 0, 0, 0};
+  double t0;
+  mb_get_time(0, time_i, &t0);
+  char beamflag[kBeams];
+  double bath[kBeams], amp[kBeams], bathacrosstrack[kBeams], bathalongtrack[kBeams];
+  double ss[1], ssacrosstrack[1], ssalongtrack[1];
+  for (int i = 0; i < kPings; i++) {
+    for (int j = 0; j < kBeams; j++) {
+      beamflag[j] = MB_FLAG_NONE;
+      bath[j] = 1000.0 + i;
+      amp[j] = j;
+      bathacrosstrack[j] = (j - kBeams / 2) * 100.0;
+      bathalongtrack[j] = 0.0;
+    }
+    const double time_d = t0 + i;
+    mb_get_date(0, time_d, time_i);
+    EXPECT_EQ(MB_SUCCESS, mb_put_all(0, mbio_ptr, store_ptr, true, MB_DATA_DATA, time_i, time_d, -120.0 + 0.001 * i,
+                                     36.0, 10.0, 90.0, kBeams, kBeams, 0, beamflag, bath, amp, bathacrosstrack,
+                                     bathalongtrack, ss, ssacrosstrack, ssalongtrack, nullptr, &error));
+  }
+  mb_close(0, &mbio_ptr, &error);
+  return t0;
+}
+
+// Returns the time of the first ping read after ping start, or zero.
+double FirstPingTime(char *file, double t0, int start, bool *seek_pending, int format = kFormat) {
+  double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+  int btime_i[7];
+  int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+  mb_get_date(0, t0 + start, btime_i);
+  void *mbio_ptr = nullptr;
+  double btime_d, etime_d;
+  int beams_bath, beams_amp, pixels_ss;
+  int error = MB_ERROR_NO_ERROR;
+  if (mb_read_init(0, file, format, 1, 0, bounds, btime_i, etime_i, 0.0, 1000000.0, &mbio_ptr, &btime_d, &etime_d,
+                   &beams_bath, &beams_amp, &pixels_ss, &error) != MB_SUCCESS)
+    return 0.0;
+  *seek_pending = ((struct mb_io_struct *)mbio_ptr)->index_seek_pending;
+
+  char *beamflag = nullptr;
+  double *bath = nullptr, *amp = nullptr, *bathlon = nullptr, *bathlat = nullptr;
+  double *ss = nullptr, *sslon = nullptr, *sslat = nullptr;
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bath, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_AMPLITUDE, sizeof(double), (void **)&amp, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathlon, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathlat, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ss, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&sslon, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&sslat, &error);
+
+  double first = 0.0;
+  int kind, rpings, time_i[7];
+  double time_d, navlon, navlat, speed, heading, distance, altitude, sensordepth;
+  char comment[MB_COMMENT_MAXLINE];
+  while (first == 0.0 && error <= MB_ERROR_NO_ERROR) {
+    const int status = mb_read(0, mbio_ptr, &kind, &rpings, time_i, &time_d, &navlon, &navlat, &speed, &heading,
+                               &distance, &altitude, &sensordepth, &beams_bath, &beams_amp, &pixels_ss, beamflag, bath,
+                               amp, bathlon, bathlat, ss, sslon, sslat, comment, &error);
+    if (status == MB_SUCCESS && kind == MB_DATA_DATA)
+      first = time_d;
+  }
+  mb_close(0, &mbio_ptr, &error);
+  return first;
+}
+
+TEST(MbIndexTest, WindowedReadStartsAtFirstPingInWindow) {
+  std::string path = testing::TempDir() + "mb_index_test.mb71";
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path.c_str());
+  const double t0 = WritePings(file);
+
+  // Without an index the windowed read decodes every record before the window.
+  const int starts[] = {1, 20, 150, 180};
+  double expected[4];
+  bool seek_pending = true;
+  for (int i = 0; i < 4; i++) {
+    expected[i] = FirstPingTime(file, t0, starts[i], &seek_pending);
+    EXPECT_GE(expected[i], t0 + starts[i]);
+    EXPECT_LE(expected[i], t0 + starts[i] + 1);
+    EXPECT_FALSE(seek_pending);
+  }
+
+  int error = MB_ERROR_NO_ERROR;
+  ASSERT_EQ(MB_SUCCESS, mb_index_make(0, true, file, kFormat, &error));
+  int num_fileindex = 0;
+  void *fileindex_ptr = nullptr;
+  ASSERT_EQ(MB_SUCCESS, mb_index_read(0, file, kFormat, &num_fileindex, &fileindex_ptr, &error));
+  ASSERT_EQ(kPings + 1, num_fileindex);
+  const struct mb_io_fileindex_struct *fileindex = (struct mb_io_fileindex_struct *)fileindex_ptr;
+  EXPECT_EQ(MB_DATA_COMMENT, fileindex[0].kind);
+  for (int i = 1; i < num_fileindex; i++) {
+    EXPECT_EQ(MB_DATA_DATA, fileindex[i].kind);
+    EXPECT_DOUBLE_EQ(t0 + i - 1, fileindex[i].time_d);
+    EXPECT_GT(fileindex[i].offset, fileindex[i - 1].offset);
+  }
+  mb_freed(0, __FILE__, __LINE__, &fileindex_ptr, &error);
+
+  // With the index the read seeks close to the window and starts at the same ping.
+  for (int i = 0; i < 4; i++) {
+    EXPECT_DOUBLE_EQ(expected[i], FirstPingTime(file, t0, starts[i], &seek_pending));
+    EXPECT_EQ(starts[i] > 1, seek_pending);
+  }
+
+  std::remove((path + MB_INDEX_SUFFIX).c_str());
+  std::remove(path.c_str());
+}
+
+TEST(MbIndexTest, IndexedRecordsAreContiguous) {
+  std::string path = testing::TempDir() + "mb_index_test_contiguous.mb71";
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path.c_str());
+  const double t0 = WritePings(file);
+  int error = MB_ERROR_NO_ERROR;
+  ASSERT_EQ(MB_SUCCESS, mb_index_make(0, true, file, kFormat, &error));
+  int num_fileindex = 0;
+  void *fileindex_ptr = nullptr;
+  ASSERT_EQ(MB_SUCCESS, mb_index_read(0, file, kFormat, &num_fileindex, &fileindex_ptr, &error));
+  ASSERT_EQ(kPings + 1, num_fileindex);
+  const struct mb_io_fileindex_struct *fileindex = (struct mb_io_fileindex_struct *)fileindex_ptr;
+
+  // The bytes between two index offsets are a file holding just that ping.
+  constexpr int kPing = 100;
+  const long start = fileindex[kPing + 1].offset;
+  const long size = fileindex[kPing + 2].offset - start;
+  mb_freed(0, __FILE__, __LINE__, &fileindex_ptr, &error);
+  std::string bytes(size, '\0');
+  FILE *fp = fopen(file, "rb");
+  ASSERT_NE(nullptr, fp);
+  fseek(fp, start, SEEK_SET);
+  ASSERT_EQ((size_t)size, fread(&bytes[0], 1, size, fp));
+  fclose(fp);
+  std::string ping_path = testing::TempDir() + "mb_index_test_ping.mb71";
+  fp = fopen(ping_path.c_str(), "wb");
+  ASSERT_NE(nullptr, fp);
+  fwrite(bytes.data(), 1, size, fp);
+  fclose(fp);
+  char ping_file[MB_PATH_MAXLINE];
+  snprintf(ping_file, sizeof(ping_file), "%s", ping_path.c_str());
+  bool seek_pending = false;
+  EXPECT_DOUBLE_EQ(t0 + kPing, FirstPingTime(ping_file, t0, 0, &seek_pending));
+
+  double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+  int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+  int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+  void *mbio_ptr = nullptr;
+  double btime_d, etime_d;
+  int beams_bath, beams_amp, pixels_ss;
+  ASSERT_EQ(MB_SUCCESS, mb_read_init(0, file, kFormat, 1, 0, bounds, btime_i, etime_i, 0.0, 1.0, &mbio_ptr, &btime_d,
+                                     &etime_d, &beams_bath, &beams_amp, &pixels_ss, &error));
+  EXPECT_TRUE(((struct mb_io_struct *)mbio_ptr)->record_contiguous);
+  mb_close(0, &mbio_ptr, &error);
+
+  std::remove(ping_path.c_str());
+  std::remove((path + MB_INDEX_SUFFIX).c_str());
+  std::remove(path.c_str());
+}
+
+// Reson 7k: hand built RawDetection (7027) records, one per ping.
+
+void Put16(std::vector<char> *record, size_t index, unsigned int value) {
+  (*record)[index] = value & 0xff;
+  (*record)[index + 1] = (value >> 8) & 0xff;
+}
+
+void Put32(std::vector<char> *record, size_t index, unsigned int value) {
+  Put16(record, index, value & 0xffff);
+  Put16(record, index + 2, value >> 16);
+}
+
+void PutFloat(std::vector<char> *record, size_t index, float value) {
+  unsigned int bits;
+  memcpy(&bits, &value, sizeof(bits));
+  Put32(record, index, bits);
+}
+
+constexpr int kDetections = 3;
+
+// Writes kPings pings one second apart starting at 2020/01/01.
+double WriteReson7k(char *file) {
+  std::vector<char> data;
+  for (int ping = 0; ping < kPings; ping++) {
+    std::vector<char> record(MBSYS_RESON7K_VERSIONSYNCSIZE + 99 + 22 * kDetections + 4, 0);
+    Put16(&record, 0, 5);
+    Put16(&record, 2, MBSYS_RESON7K_VERSIONSYNCSIZE - 4);
+    Put32(&record, 4, 0x0000FFFF);
+    Put32(&record, 8, record.size());
+    Put16(&record, 20, 2020);
+    Put16(&record, 22, 1);
+    PutFloat(&record, 24, (float)(ping % 60));
+    record[28] = ping / 3600;
+    record[29] = (ping / 60) % 60;
+    Put16(&record, 30, 1);
+    Put32(&record, 32, R7KRECID_RawDetection);
+    Put32(&record, 36, 7125);
+    size_t index = MBSYS_RESON7K_VERSIONSYNCSIZE;
+    Put32(&record, index + 8, ping);
+    index += 14;
+    Put32(&record, index, kDetections);
+    Put32(&record, index + 4, 22);
+    PutFloat(&record, index + 13, 10000.0);
+    index += 85;
+    for (int i = 0; i < kDetections; i++, index += 22) {
+      Put16(&record, index, i);
+      PutFloat(&record, index + 2, 100.0 + i + ping);
+      PutFloat(&record, index + 6, 0.1 * (i - 1));
+      Put32(&record, index + 14, 3);
+    }
+    data.insert(data.end(), record.begin(), record.end());
+  }
+  FILE *fp = fopen(file, "wb");
+  EXPECT_NE(nullptr, fp);
+  fwrite(data.data(), 1, data.size(), fp);
+  fclose(fp);
+  int time_i[7] = {2020, 1, 1, 0, 0, 0, 0};
+  double t0;
+  mb_get_time(0, time_i, &t0);
+  return t0;
+}
+
+// The 7k readers read records ahead while assembling pings, and position
+// the file themselves from a FileCatalog, so s7k files are not indexed and
+// windowed reads decode every record before the window.
+TEST(MbIndexTest, Reson7kFilesAreNotIndexed) {
+  for (const int format : {MBF_RESON7KR, MBF_RESON7K3}) {
+    std::string path = testing::TempDir() + "mb_index_test_" + std::to_string(format) + ".s7k";
+    char file[MB_PATH_MAXLINE];
+    snprintf(file, sizeof(file), "%s", path.c_str());
+    const double t0 = WriteReson7k(file);
+
+    double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+    int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+    int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+    void *mbio_ptr = nullptr;
+    double btime_d, etime_d;
+    int beams_bath, beams_amp, pixels_ss;
+    int error = MB_ERROR_NO_ERROR;
+    ASSERT_EQ(MB_SUCCESS, mb_read_init(0, file, format, 1, 0, bounds, btime_i, etime_i, 0.0, 1.0, &mbio_ptr,
+                                       &btime_d, &etime_d, &beams_bath, &beams_amp, &pixels_ss, &error));
+    EXPECT_FALSE(((struct mb_io_struct *)mbio_ptr)->index_seekable) << format;
+    EXPECT_FALSE(((struct mb_io_struct *)mbio_ptr)->record_contiguous) << format;
+    mb_close(0, &mbio_ptr, &error);
+
+    ASSERT_EQ(MB_SUCCESS, mb_index_make(0, true, file, format, &error));
+    FILE *fp = fopen((path + MB_INDEX_SUFFIX).c_str(), "rb");
+    EXPECT_EQ(nullptr, fp) << format;
+    if (fp != nullptr)
+      fclose(fp);
+
+    for (const int start : {1, 20, 150}) {
+      bool seek_pending = true;
+      const double first = FirstPingTime(file, t0, start, &seek_pending, format);
+      EXPECT_GE(first, t0 + start) << format;
+      EXPECT_LE(first, t0 + start + 1) << format;
+      EXPECT_FALSE(seek_pending) << format;
+    }
+
+    std::remove((path + MB_INDEX_SUFFIX).c_str());
+    std::remove(path.c_str());
+  }
+}
+
+}  // namespace
@@ -0,0 +1,364 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_format.h"
+#include "mb_io.h"
+#include "mb_status.h"
+#include "mbsys_kmbes.h"
+#include "mbsys_reson7k3.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kPings = 5;
+
+void *Open(const std::string &path, int format, bool lazy) {
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path.c_str());
+  double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+  int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+  int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+  void *mbio_ptr = nullptr;
+  double btime_d, etime_d;
+  int beams_bath, beams_amp, pixels_ss;
+  int error = MB_ERROR_NO_ERROR;
+  EXPECT_EQ(MB_SUCCESS, mb_read_init(0, file, format, 1, 0, bounds, btime_i, etime_i, 0.0, 1.0, &mbio_ptr, &btime_d,
+                                     &etime_d, &beams_bath, &beams_amp, &pixels_ss, &error));
+  EXPECT_EQ(MB_SUCCESS, mb_set_lazy_decode(0, mbio_ptr, lazy, &error));
+  return mbio_ptr;
+}
+
+// Reson 7k3: hand built RawDetection (7027) and WaterColumn (7008) records.
+
+void Put16(std::vector<char> *record, size_t index, unsigned int value) {
+  (*record)[index] = value & 0xff;
+  (*record)[index + 1] = (value >> 8) & 0xff;
+}
+
+void Put32(std::vector<char> *record, size_t index, unsigned int value) {
+  Put16(record, index, value & 0xffff);
+  Put16(record, index + 2, value >> 16);
+}
+
+void PutFloat(std::vector<char> *record, size_t index, float value) {
+  unsigned int bits;
+  memcpy(&bits, &value, sizeof(bits));
+  Put32(record, index, bits);
+}
+
+// Returns a record with a version 5 header, data section of datasize bytes
+// starting with the serial and ping numbers, and room for the checksum.
+std::vector<char> Reson7k3Record(int recordid, int ping, size_t datasize) {
+  std::vector<char> record(MBSYS_RESON7K_VERSIONSYNCSIZE + datasize + 4, 0);
+  Put16(&record, 0, 5);
+  Put16(&record, 2, MBSYS_RESON7K_VERSIONSYNCSIZE - 4);
+  Put32(&record, 4, 0x0000FFFF);
+  Put32(&record, 8, record.size());
+  Put16(&record, 20, 2020);
+  Put16(&record, 22, 1);
+  PutFloat(&record, 24, (float)ping);
+  Put16(&record, 30, 1);
+  Put32(&record, 32, recordid);
+  Put32(&record, 36, 7125);
+  Put32(&record, MBSYS_RESON7K_VERSIONSYNCSIZE + 8, ping);
+  return record;
+}
+
+constexpr int kDetections = 3;
+constexpr int kWaterColumnBeams = 4;
+constexpr int kWaterColumnSamples = 200;
+
+// Writes kPings pings, leaving off the last truncate bytes of the file.
+void WriteReson7k3(const std::string &path, size_t truncate) {
+  std::vector<char> data;
+  for (int ping = 0; ping < kPings; ping++) {
+    std::vector<char> detection = Reson7k3Record(R7KRECID_RawDetection, ping, 99 + 22 * kDetections);
+    size_t index = MBSYS_RESON7K_VERSIONSYNCSIZE + 14;
+    Put32(&detection, index, kDetections);
+    Put32(&detection, index + 4, 22);
+    PutFloat(&detection, index + 13, 10000.0);
+    index += 85;
+    for (int i = 0; i < kDetections; i++, index += 22) {
+      Put16(&detection, index, i);
+      PutFloat(&detection, index + 2, 100.0 + i + ping);
+      PutFloat(&detection, index + 6, 0.1 * (i - 1));
+      Put32(&detection, index + 14, 3);
+    }
+    data.insert(data.end(), detection.begin(), detection.end());
+
+    std::vector<char> watercolumn = Reson7k3Record(
+        R7KRECID_WaterColumn, ping, 30 + 10 * kWaterColumnBeams + kWaterColumnBeams * kWaterColumnSamples);
+    index = MBSYS_RESON7K_VERSIONSYNCSIZE + 14;
+    Put16(&watercolumn, index, kWaterColumnBeams);
+    Put32(&watercolumn, index + 4, kWaterColumnSamples);
+    Put32(&watercolumn, index + 12, 1);  // 8 bit amplitudes
+    index += 16;
+    for (int i = 0; i < kWaterColumnBeams; i++, index += 10) {
+      Put16(&watercolumn, index, i);
+      Put32(&watercolumn, index + 6, kWaterColumnSamples - 1);
+    }
+    for (int j = 0; j < kWaterColumnBeams * kWaterColumnSamples; j++)
+      watercolumn[index++] = (char)(7 * j + ping);
+    data.insert(data.end(), watercolumn.begin(), watercolumn.end());
+  }
+  data.resize(data.size() - truncate);
+
+  FILE *fp = fopen(path.c_str(), "wb");
+  ASSERT_NE(nullptr, fp);
+  fwrite(data.data(), 1, data.size(), fp);
+  fclose(fp);
+}
+
+struct Reson7k3Ping {
+  int ping_number;
+  std::vector<float> detection_point;
+  bool read_WaterColumn;
+  std::vector<char> watercolumn;
+};
+
+// Reads every ping, copying each one so that the water column is decoded as it would be for writing.
+int ReadReson7k3(const std::string &path, bool lazy, std::vector<Reson7k3Ping> *pings) {
+  void *mbio_ptr = Open(path, MBF_RESON7K3, lazy);
+  int error = MB_ERROR_NO_ERROR;
+  void *store_ptr = nullptr;
+  mb_get_store(0, mbio_ptr, &store_ptr, &error);
+  void *copy_ptr = nullptr;
+  EXPECT_EQ(MB_SUCCESS, mb_alloc(0, mbio_ptr, &copy_ptr, &error));
+  int kind;
+  while (error <= MB_ERROR_NO_ERROR) {
+    if (mb_read_ping(0, mbio_ptr, store_ptr, &kind, &error) != MB_SUCCESS || kind != MB_DATA_DATA)
+      continue;
+    const struct mbsys_reson7k3_struct *store = (struct mbsys_reson7k3_struct *)store_ptr;
+    Reson7k3Ping ping;
+    ping.ping_number = store->RawDetection.ping_number;
+    for (unsigned int i = 0; i < store->RawDetection.number_beams; i++)
+      ping.detection_point.push_back(store->RawDetection.rawdetectiondata[i].detection_point);
+    ping.read_WaterColumn = store->read_WaterColumn;
+
+    // Copying the ping decodes any deferred records in the store being copied.
+    EXPECT_EQ(MB_SUCCESS, mb_copyrecord(0, mbio_ptr, store_ptr, copy_ptr, &error));
+    if (store->read_WaterColumn) {
+      const s7k3_WaterColumn *WaterColumn = &store->WaterColumn;
+      EXPECT_EQ(store->RawDetection.ping_number, WaterColumn->ping_number);
+      for (unsigned int i = 0; i < WaterColumn->number_beams; i++) {
+        const s7k3_wcd *wcd = &WaterColumn->wcd[i];
+        const char *amplitude = (const char *)wcd->amplitude;
+        ping.watercolumn.insert(ping.watercolumn.end(), amplitude,
+                                amplitude + wcd->end_sample - wcd->begin_sample + 1);
+      }
+    }
+    pings->push_back(ping);
+  }
+  const int final_error = error;
+  mb_deall(0, mbio_ptr, &copy_ptr, &error);
+  mb_close(0, &mbio_ptr, &error);
+  return final_error;
+}
+
+TEST(MbLazyDecodeTest, Reson7k3LazyReadMatchesEagerRead) {
+  const std::string path = testing::TempDir() + "mb_lazy_decode_test.s7k";
+  WriteReson7k3(path, 0);
+
+  std::vector<Reson7k3Ping> eager, lazy;
+  EXPECT_EQ(MB_ERROR_EOF, ReadReson7k3(path, false, &eager));
+  EXPECT_EQ(MB_ERROR_EOF, ReadReson7k3(path, true, &lazy));
+  ASSERT_EQ(kPings, (int)eager.size());
+  ASSERT_EQ(kPings, (int)lazy.size());
+  for (int i = 0; i < kPings; i++) {
+    EXPECT_EQ(i, eager[i].ping_number);
+    EXPECT_EQ(kDetections, (int)eager[i].detection_point.size());
+    EXPECT_TRUE(eager[i].read_WaterColumn);
+    ASSERT_EQ(kWaterColumnBeams * kWaterColumnSamples, (int)eager[i].watercolumn.size());
+    EXPECT_EQ((char)(7 + i), eager[i].watercolumn[1]);
+    EXPECT_EQ(eager[i].ping_number, lazy[i].ping_number);
+    EXPECT_EQ(eager[i].detection_point, lazy[i].detection_point);
+    EXPECT_EQ(eager[i].read_WaterColumn, lazy[i].read_WaterColumn);
+    EXPECT_EQ(eager[i].watercolumn, lazy[i].watercolumn);
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(MbLazyDecodeTest, Reson7k3LazyReadDropsTruncatedFinalRecord) {
+  const std::string path = testing::TempDir() + "mb_lazy_decode_test_truncated.s7k";
+
+  // Truncated inside the last water column record, beyond the part read in lazy mode.
+  WriteReson7k3(path, 100);
+
+  std::vector<Reson7k3Ping> eager, lazy;
+  EXPECT_EQ(MB_ERROR_EOF, ReadReson7k3(path, false, &eager));
+  EXPECT_EQ(MB_ERROR_EOF, ReadReson7k3(path, true, &lazy));
+  ASSERT_EQ(kPings, (int)eager.size());
+  ASSERT_EQ(kPings, (int)lazy.size());
+  EXPECT_FALSE(eager.back().read_WaterColumn);
+  EXPECT_FALSE(lazy.back().read_WaterColumn);
+  for (int i = 0; i < kPings; i++) {
+    EXPECT_EQ(eager[i].ping_number, lazy[i].ping_number);
+    EXPECT_EQ(eager[i].read_WaterColumn, lazy[i].read_WaterColumn);
+    EXPECT_EQ(eager[i].watercolumn, lazy[i].watercolumn);
+  }
+
+  std::remove(path.c_str());
+}
+
+// kmall: MWC and MRZ datagrams written through the kmall writer.
+
+constexpr int kSoundings = 16;
+constexpr int kSeabedImageSamples = 5;
+constexpr int kMwcBeams = 8;
+
+void WriteKmall(const std::string &path) {
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path.c_str());
+  int error = MB_ERROR_NO_ERROR;
+  void *mbio_ptr = nullptr;
+  int beams_bath, beams_amp, pixels_ss;
+  ASSERT_EQ(MB_SUCCESS, mb_write_init(0, file, MBF_KEMKMALL, &mbio_ptr, &beams_bath, &beams_amp, &pixels_ss, &error));
+  void *store_ptr = nullptr;
+  mb_get_store(0, mbio_ptr, &store_ptr, &error);
+  struct mbsys_kmbes_struct *store = (struct mbsys_kmbes_struct *)store_ptr;
+
+  struct mbsys_kmbes_mwc *mwc = &store->mwc[0];
+  ASSERT_EQ(MB_SUCCESS, mb_reallocd(0, __FILE__, __LINE__, kMwcBeams * sizeof(struct mbsys_kmbes_mwc_rx_beam_data),
+                                    (void **)&mwc->beamData_p, &error));
+  memset(mwc->beamData_p, 0, kMwcBeams * sizeof(struct mbsys_kmbes_mwc_rx_beam_data));
+  for (int ping = 0; ping < kPings; ping++) {
+    memcpy(mwc->header.dgmType, "#MWC", 4);
+    mwc->header.time_sec = 1600000000 + ping;
+    mwc->header.echoSounderID = 2040;
+    mwc->partition.numOfDgms = 1;
+    mwc->partition.dgmNum = 1;
+    mwc->cmnPart.pingCnt = ping;
+    mwc->cmnPart.rxFansPerPing = 1;
+    mwc->cmnPart.swathsPerPing = 1;
+    mwc->txInfo.numTxSectors = 1;
+    mwc->rxInfo.numBeams = kMwcBeams;
+    mwc->rxInfo.phaseFlag = 1;
+    mwc->rxInfo.sampleFreq_Hz = 1000.0;
+    mwc->rxInfo.soundVelocity_mPerSec = 1500.0;
+    for (int i = 0; i < kMwcBeams; i++) {
+      struct mbsys_kmbes_mwc_rx_beam_data *beamData = &mwc->beamData_p[i];
+      beamData->numSampleData = 50 + ping;
+      mb_reallocd(0, __FILE__, __LINE__, beamData->numSampleData, (void **)&beamData->sampleAmplitude05dB_p, &error);
+      mb_reallocd(0, __FILE__, __LINE__, beamData->numSampleData, (void **)&beamData->samplePhase8bit, &error);
+      beamData->sampleAmplitude05dB_p_alloc_size = beamData->numSampleData;
+      beamData->samplePhase8bit_alloc_size = beamData->numSampleData;
+      for (int j = 0; j < beamData->numSampleData; j++) {
+        beamData->sampleAmplitude05dB_p[j] = (7 * i + j + ping) & 0x7f;
+        beamData->samplePhase8bit[j] = (i + 3 * j + ping) & 0x3f;
+      }
+    }
+    store->n_mwc_read = 1;
+    store->kind = MB_DATA_WATER_COLUMN;
+    EXPECT_EQ(MB_SUCCESS, mb_write_ping(0, mbio_ptr, store_ptr, &error));
+
+    struct mbsys_kmbes_mrz *mrz = &store->mrz[0];
+    memcpy(mrz->header.dgmType, "#MRZ", 4);
+    mrz->header.time_sec = 1600000000 + ping;
+    mrz->header.echoSounderID = 2040;
+    mrz->partition.numOfDgms = 1;
+    mrz->partition.dgmNum = 1;
+    mrz->cmnPart.pingCnt = ping;
+    mrz->cmnPart.rxFansPerPing = 1;
+    mrz->cmnPart.swathsPerPing = 1;
+    mrz->pingInfo.numTxSectors = 1;
+    mrz->pingInfo.latitude_deg = 36.0;
+    mrz->pingInfo.longitude_deg = -122.0;
+    mrz->rxInfo.numSoundingsMaxMain = kSoundings;
+    for (int i = 0; i < kSoundings; i++) {
+      mrz->sounding[i].soundingIndex = i;
+      mrz->sounding[i].SInumSamples = kSeabedImageSamples;
+      mrz->sounding[i].SIcentreSample = kSeabedImageSamples / 2;
+      mrz->sounding[i].z_reRefPoint_m = 100.0 + i + ping;
+      mrz->sounding[i].y_reRefPoint_m = -80.0 + 10.0 * i;
+      mrz->sounding[i].twoWayTravelTime_sec = 0.1;
+    }
+    for (int i = 0; i < kSoundings * kSeabedImageSamples; i++)
+      mrz->SIsample_desidB[i] = -(3 * i + ping);
+    store->n_mrz_read = 1;
+    store->kind = MB_DATA_DATA;
+    EXPECT_EQ(MB_SUCCESS, mb_write_ping(0, mbio_ptr, store_ptr, &error));
+  }
+  mb_close(0, &mbio_ptr, &error);
+}
+
+struct KmallPing {
+  std::vector<float> depth;
+  std::vector<short> seabed_image;
+  std::vector<signed char> watercolumn;
+};
+
+// Reads every ping, copying each one to get the seabed image and water column as they would be written.
+int ReadKmall(const std::string &path, bool lazy, std::vector<KmallPing> *pings) {
+  void *mbio_ptr = Open(path, MBF_KEMKMALL, lazy);
+  int error = MB_ERROR_NO_ERROR;
+  void *store_ptr = nullptr;
+  mb_get_store(0, mbio_ptr, &store_ptr, &error);
+  void *copy_ptr = nullptr;
+  EXPECT_EQ(MB_SUCCESS, mb_alloc(0, mbio_ptr, &copy_ptr, &error));
+  int kind;
+  while (error <= MB_ERROR_NO_ERROR) {
+    if (mb_read_ping(0, mbio_ptr, store_ptr, &kind, &error) != MB_SUCCESS || kind != MB_DATA_DATA)
+      continue;
+    const struct mbsys_kmbes_struct *store = (struct mbsys_kmbes_struct *)store_ptr;
+    KmallPing ping;
+    for (int imrz = 0; imrz < store->n_mrz_read; imrz++)
+      for (int i = 0; i < store->mrz[imrz].rxInfo.numSoundingsMaxMain; i++)
+        ping.depth.push_back(store->mrz[imrz].sounding[i].z_reRefPoint_m);
+
+    EXPECT_EQ(MB_SUCCESS, mb_copyrecord(0, mbio_ptr, store_ptr, copy_ptr, &error));
+    const struct mbsys_kmbes_struct *copy = (struct mbsys_kmbes_struct *)copy_ptr;
+    for (int imrz = 0; imrz < copy->n_mrz_read; imrz++)
+      ping.seabed_image.insert(ping.seabed_image.end(), copy->mrz[imrz].SIsample_desidB,
+                               copy->mrz[imrz].SIsample_desidB + kSoundings * kSeabedImageSamples);
+    for (int imwc = 0; imwc < copy->n_mwc_read; imwc++) {
+      const struct mbsys_kmbes_mwc *mwc = &copy->mwc[imwc];
+      for (int i = 0; i < mwc->rxInfo.numBeams; i++) {
+        const struct mbsys_kmbes_mwc_rx_beam_data *beamData = &mwc->beamData_p[i];
+        ping.watercolumn.insert(ping.watercolumn.end(), beamData->sampleAmplitude05dB_p,
+                                beamData->sampleAmplitude05dB_p + beamData->numSampleData);
+        ping.watercolumn.insert(ping.watercolumn.end(), beamData->samplePhase8bit,
+                                beamData->samplePhase8bit + beamData->numSampleData);
+      }
+    }
+    pings->push_back(ping);
+  }
+  const int final_error = error;
+  mb_deall(0, mbio_ptr, &copy_ptr, &error);
+  mb_close(0, &mbio_ptr, &error);
+  return final_error;
+}
+
+TEST(MbLazyDecodeTest, KmallDeferredReadMatchesEagerRead) {
+  const std::string path = testing::TempDir() + "mb_lazy_decode_test.kmall";
+  WriteKmall(path);
+
+  std::vector<KmallPing> eager, lazy;
+  EXPECT_EQ(MB_ERROR_EOF, ReadKmall(path, false, &eager));
+  EXPECT_EQ(MB_ERROR_EOF, ReadKmall(path, true, &lazy));
+  ASSERT_EQ(kPings, (int)eager.size());
+  ASSERT_EQ(kPings, (int)lazy.size());
+  for (int i = 0; i < kPings; i++) {
+    ASSERT_EQ(kSoundings, (int)eager[i].depth.size());
+    EXPECT_FLOAT_EQ(100.0 + i, eager[i].depth[0]);
+    ASSERT_EQ(kSoundings * kSeabedImageSamples, (int)eager[i].seabed_image.size());
+    EXPECT_EQ(-(3 + i), eager[i].seabed_image[1]);
+    EXPECT_EQ(2 * kMwcBeams * (50 + i), (int)eager[i].watercolumn.size());
+    EXPECT_EQ(eager[i].depth, lazy[i].depth);
+    EXPECT_EQ(eager[i].seabed_image, lazy[i].seabed_image);
+    EXPECT_EQ(eager[i].watercolumn, lazy[i].watercolumn);
+  }
+
+  std::remove(path.c_str());
+}
+
+}  // namespace
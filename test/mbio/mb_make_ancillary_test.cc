@@ -0,0 +1,202 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_format.h"
+#include "mb_info.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kFormat = 71;  // MBF_MBLDEOIH, which can be read from any record
+constexpr int kPings = 120;
+constexpr int kBeams = 11;
+
+std::string ReadBytes(const std::string &path) {
+  std::ifstream stream(path, std::ios::binary);
+  std::stringstream bytes;
+  bytes << stream.rdbuf();
+  return bytes.str();
+}
+
+struct Nav {
+  double time_d;
+  double navlon;
+  double navlat;
+  double heading;
+};
+
+// Returns the navigation of every survey ping of a file.
+std::vector<Nav> ReadNav(char *file, int format) {
+  std::vector<Nav> nav;
+  double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+  int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+  int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+  void *mbio_ptr = nullptr;
+  double btime_d, etime_d;
+  int beams_bath, beams_amp, pixels_ss;
+  int error = MB_ERROR_NO_ERROR;
+  if (mb_read_init(0, file, format, 1, 0, bounds, btime_i, etime_i, 0.0, 1000000.0, &mbio_ptr, &btime_d, &etime_d,
+                   &beams_bath, &beams_amp, &pixels_ss, &error) != MB_SUCCESS)
+    return nav;
+
+  char *beamflag = nullptr;
+  double *bath = nullptr, *amp = nullptr, *bathlon = nullptr, *bathlat = nullptr;
+  double *ss = nullptr, *sslon = nullptr, *sslat = nullptr;
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bath, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_AMPLITUDE, sizeof(double), (void **)&amp, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathlon, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathlat, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ss, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&sslon, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&sslat, &error);
+
+  void *store_ptr = nullptr;
+  int kind, time_i[7];
+  double time_d, navlon, navlat, speed, heading, distance, altitude, sensordepth;
+  char comment[MB_COMMENT_MAXLINE];
+  while (error <= MB_ERROR_NO_ERROR) {
+    error = MB_ERROR_NO_ERROR;
+    const int status = mb_get_all(0, mbio_ptr, &store_ptr, &kind, time_i, &time_d, &navlon, &navlat, &speed, &heading,
+                                  &distance, &altitude, &sensordepth, &beams_bath, &beams_amp, &pixels_ss, beamflag,
+                                  bath, amp, bathlon, bathlat, ss, sslon, sslat, comment, &error);
+    if (status == MB_SUCCESS && kind == MB_DATA_DATA)
+      nav.push_back({time_d, navlon, navlat, heading});
+  }
+  mb_close(0, &mbio_ptr, &error);
+  return nav;
+}
+
+class MbMakeAncillaryTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = testing::TempDir() + "mb_make_ancillary_test.mb71";
+    snprintf(file_, sizeof(file_), "%s", path_.c_str());
+    WritePings();
+  }
+
+  void TearDown() override {
+    for (const char *suffix : {".inf", ".fbt", ".fnv", MB_INDEX_SUFFIX})
+      std::remove((path_ + suffix).c_str());
+    std::remove(path_.c_str());
+  }
+
+  // Writes a comment and kPings pings one second apart along a line to the east.
+  void WritePings() {
+    int error = MB_ERROR_NO_ERROR;
+    void *mbio_ptr = nullptr;
+    int beams_bath, beams_amp, pixels_ss;
+    ASSERT_EQ(MB_SUCCESS, mb_write_init(0, file_, kFormat, &mbio_ptr, &beams_bath, &beams_amp, &pixels_ss, &error));
+    void *store_ptr = nullptr;
+    mb_get_store(0, mbio_ptr, &store_ptr, &error);
+    char comment[] = "mb_make_ancillary_test";
+    mb_put_comment(0, mbio_ptr, comment, &error);
+
+    int time_i[7] = {2020, 1, 1, 0, 0, 0, 0};
+    mb_get_time(0, time_i, &t0_);
+    char beamflag[kBeams];
+    double bath[kBeams], amp[kBeams], bathacrosstrack[kBeams], bathalongtrack[kBeams];
+    double ss[1], ssacrosstrack[1], ssalongtrack[1];
+    for (int i = 0; i < kPings; i++) {
+      for (int j = 0; j < kBeams; j++) {
+        beamflag[j] = j == 0 ? MB_FLAG_FLAG + MB_FLAG_MANUAL : MB_FLAG_NONE;
+        bath[j] = 1000.0 + i;
+        amp[j] = j;
+        bathacrosstrack[j] = (j - kBeams / 2) * 100.0;
+        bathalongtrack[j] = 0.0;
+      }
+      const double time_d = t0_ + i;
+      mb_get_date(0, time_d, time_i);
+      ASSERT_EQ(MB_SUCCESS, mb_put_all(0, mbio_ptr, store_ptr, true, MB_DATA_DATA, time_i, time_d, -120.0 + 0.0001 * i,
+                                       36.0, 10.0, 90.0, kBeams, kBeams, 0, beamflag, bath, amp, bathacrosstrack,
+                                       bathalongtrack, ss, ssacrosstrack, ssalongtrack, nullptr, &error));
+    }
+    mb_close(0, &mbio_ptr, &error);
+  }
+
+  std::string path_;
+  char file_[MB_PATH_MAXLINE];
+  double t0_ = 0.0;
+};
+
+TEST_F(MbMakeAncillaryTest, IndexMatchesTheSeparateIndexPass) {
+  int error = MB_ERROR_NO_ERROR;
+  ASSERT_EQ(MB_SUCCESS, mb_index_make(0, true, file_, kFormat, &error));
+  const std::string expected = ReadBytes(path_ + MB_INDEX_SUFFIX);
+  ASSERT_FALSE(expected.empty());
+  std::remove((path_ + MB_INDEX_SUFFIX).c_str());
+
+  // The index is built during the read that makes the other ancillary files.
+  ASSERT_EQ(MB_SUCCESS, mb_make_info(0, true, file_, kFormat, &error));
+  EXPECT_TRUE(expected == ReadBytes(path_ + MB_INDEX_SUFFIX));
+
+  // Only the out of date index is regenerated when the other files are current.
+  std::remove((path_ + MB_INDEX_SUFFIX).c_str());
+  const std::string inf = ReadBytes(path_ + ".inf");
+  ASSERT_EQ(MB_SUCCESS, mb_make_info(0, false, file_, kFormat, &error));
+  EXPECT_TRUE(expected == ReadBytes(path_ + MB_INDEX_SUFFIX));
+  EXPECT_EQ(inf, ReadBytes(path_ + ".inf"));
+}
+
+TEST_F(MbMakeAncillaryTest, InfMatchesTheSwathData) {
+  int error = MB_ERROR_NO_ERROR;
+  ASSERT_EQ(MB_SUCCESS, mb_make_info(0, true, file_, kFormat, &error));
+
+  // The summary is in the mbinfo layout, which mb_get_info() parses.
+  const std::string inf = ReadBytes(path_ + ".inf");
+  EXPECT_THAT(inf, testing::HasSubstr("\nSwath Data File:      mb_make_ancillary_test.mb71\n"));
+  EXPECT_THAT(inf, testing::HasSubstr("\nCoverage Mask:\nCM dimensions: 10 10\n"));
+  struct mb_info_struct mb_info;
+  ASSERT_EQ(MB_SUCCESS, mb_get_info(0, file_, &mb_info, 0, &error));
+  EXPECT_EQ(kPings, mb_info.nrecords);
+  EXPECT_EQ(kBeams, mb_info.nbeams_bath);
+  EXPECT_EQ(kPings * kBeams, mb_info.nbeams_bath_total);
+  EXPECT_EQ(kPings * (kBeams - 1), mb_info.nbeams_bath_good);
+  EXPECT_EQ(kPings, mb_info.nbeams_bath_flagged);
+  EXPECT_NEAR(1000.0, mb_info.depth_min, 1e-4);
+  EXPECT_NEAR(1000.0 + kPings - 1, mb_info.depth_max, 1e-4);
+
+  // The navigation totals and limits are those of the pings read back from the file.
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path_.c_str());
+  const std::vector<Nav> nav = ReadNav(file, kFormat);
+  ASSERT_EQ((size_t)kPings, nav.size());
+  EXPECT_NEAR((nav.back().time_d - nav.front().time_d) / 3600.0, mb_info.time_total, 1e-4);
+  EXPECT_NEAR(nav.front().navlon, mb_info.lon_start, 1e-9);
+  EXPECT_NEAR(nav.back().navlon, mb_info.lon_end, 1e-9);
+  EXPECT_NEAR(nav.front().navlat, mb_info.lat_start, 1e-9);
+  EXPECT_NEAR(nav.back().navlat, mb_info.lat_end, 1e-9);
+}
+
+TEST_F(MbMakeAncillaryTest, FnvMatchesTheSwathNavigation) {
+  int error = MB_ERROR_NO_ERROR;
+  ASSERT_EQ(MB_SUCCESS, mb_make_info(0, true, file_, kFormat, &error));
+
+  // Reading the fnv file gives the navigation of every ping of the swath file.
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path_.c_str());
+  const std::vector<Nav> expected = ReadNav(file, kFormat);
+  snprintf(file, sizeof(file), "%s.fnv", path_.c_str());
+  const std::vector<Nav> nav = ReadNav(file, MBF_MBPRONAV);
+  ASSERT_EQ(expected.size(), nav.size());
+  for (size_t i = 0; i < nav.size(); i++) {
+    EXPECT_NEAR(expected[i].time_d, nav[i].time_d, 1e-6) << i;
+    EXPECT_NEAR(expected[i].navlon, nav[i].navlon, 1e-9) << i;
+    EXPECT_NEAR(expected[i].navlat, nav[i].navlat, 1e-9) << i;
+    EXPECT_NEAR(expected[i].heading, nav[i].heading, 1e-3) << i;
+  }
+}
+
+}  // namespace
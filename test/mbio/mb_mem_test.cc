@@ -4,6 +4,8 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <thread>
+#include <vector>
 
 #include "mb_define.h"
 #include "mb_status.h"
@@ -72,6 +74,8 @@ TEST(MbDebug, MallocThenClear) {
   EXPECT_EQ(MB_ERROR_NO_ERROR, error);
 }
 
+#ifndef MB_MEM_NO_TRACKING
+// Pointers not in the allocation list are not freed.
 TEST(MbDebug, FreeBadPtr) {
   int error = MB_ERROR_NO_ERROR;
   int verbose = 0;
@@ -80,6 +84,7 @@ TEST(MbDebug, FreeBadPtr) {
   EXPECT_EQ(MB_SUCCESS, mb_free(verbose, &ptr, &error));
   EXPECT_EQ(MB_ERROR_NO_ERROR, error);
 }
+#endif
 
 TEST(MbDebug, FreeNullptr) {
   int error = MB_ERROR_NO_ERROR;
@@ -90,12 +95,79 @@ TEST(MbDebug, FreeNullptr) {
   EXPECT_EQ(MB_ERROR_NO_ERROR, error);
 }
 
-// TODO(schwehr): Test mb_mallocd
+#ifndef MB_MEM_NO_TRACKING
+TEST(MbDebug, MallocdReallocdFreed) {
+  int error = MB_ERROR_NO_ERROR;
+  const int verbose = 0;
+  int nalloc0, nallocmax, overflow;
+  size_t allocsize0;
+  EXPECT_EQ(MB_SUCCESS, mb_memory_status(verbose, &nalloc0, &nallocmax, &overflow, &allocsize0, &error));
+
+  void *ptr = nullptr;
+  EXPECT_EQ(MB_SUCCESS, mb_mallocd(verbose, __FILE__, __LINE__, 100, &ptr, &error));
+  EXPECT_NE(nullptr, ptr);
+  int nalloc;
+  size_t allocsize;
+  EXPECT_EQ(MB_SUCCESS, mb_memory_status(verbose, &nalloc, &nallocmax, &overflow, &allocsize, &error));
+  EXPECT_EQ(nalloc0 + 1, nalloc);
+  EXPECT_EQ(allocsize0 + 100, allocsize);
+  EXPECT_LE(nalloc, nallocmax);
+
+  EXPECT_EQ(MB_SUCCESS, mb_reallocd(verbose, __FILE__, __LINE__, 1000, &ptr, &error));
+  EXPECT_NE(nullptr, ptr);
+  EXPECT_EQ(MB_SUCCESS, mb_memory_status(verbose, &nalloc, &nallocmax, &overflow, &allocsize, &error));
+  EXPECT_EQ(nalloc0 + 1, nalloc);
+  EXPECT_EQ(allocsize0 + 1000, allocsize);
+
+  EXPECT_EQ(MB_SUCCESS, mb_freed(verbose, __FILE__, __LINE__, &ptr, &error));
+  EXPECT_EQ(nullptr, ptr);
+  EXPECT_EQ(MB_SUCCESS, mb_memory_status(verbose, &nalloc, &nallocmax, &overflow, &allocsize, &error));
+  EXPECT_EQ(nalloc0, nalloc);
+  EXPECT_EQ(allocsize0, allocsize);
+  EXPECT_EQ(MB_ERROR_NO_ERROR, error);
+}
+
+// Allocations and frees from several threads at once are all tracked.
+TEST(MbDebug, Threads) {
+  const int verbose = 0;
+  int error = MB_ERROR_NO_ERROR;
+  int nalloc0, nallocmax, overflow;
+  size_t allocsize0;
+  EXPECT_EQ(MB_SUCCESS, mb_memory_status(verbose, &nalloc0, &nallocmax, &overflow, &allocsize0, &error));
+
+  const int n_threads = 8;
+  const int n_alloc = 2000;
+  std::vector<std::vector<void *>> ptrs(n_threads, std::vector<void *>(n_alloc, nullptr));
+  std::vector<std::thread> threads;
+  for (int ithread = 0; ithread < n_threads; ithread++) {
+    threads.push_back(std::thread([&ptrs, ithread, n_alloc]() {
+      int thread_error = MB_ERROR_NO_ERROR;
+      for (int i = 0; i < n_alloc; i++)
+        mb_mallocd(0, __FILE__, __LINE__, 8, &ptrs[ithread][i], &thread_error);
+      for (int i = 0; i < n_alloc; i += 2)
+        mb_freed(0, __FILE__, __LINE__, &ptrs[ithread][i], &thread_error);
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  int nalloc;
+  size_t allocsize;
+  EXPECT_EQ(MB_SUCCESS, mb_memory_status(verbose, &nalloc, &nallocmax, &overflow, &allocsize, &error));
+  EXPECT_EQ(nalloc0 + n_threads * n_alloc / 2, nalloc);
+  EXPECT_EQ(allocsize0 + 8 * n_threads * n_alloc / 2, allocsize);
+
+  for (int ithread = 0; ithread < n_threads; ithread++)
+    for (int i = 1; i < n_alloc; i += 2)
+      EXPECT_EQ(MB_SUCCESS, mb_freed(verbose, __FILE__, __LINE__, &ptrs[ithread][i], &error));
+  EXPECT_EQ(MB_SUCCESS, mb_memory_status(verbose, &nalloc, &nallocmax, &overflow, &allocsize, &error));
+  EXPECT_EQ(nalloc0, nalloc);
+  EXPECT_EQ(allocsize0, allocsize);
+}
+#endif
+
 // TODO(schwehr): Test mb_realloc
-// TODO(schwehr): Test mb_reallocd
-// TODO(schwehr): Test mb_freed
 // TODO(schwehr): Test mb_memory_clear
-// TODO(schwehr): Test mb_memory_status
 // TODO(schwehr): Test mb_memory_list
 // TODO(schwehr): Test mb_register_array
 // TODO(schwehr): Test mb_update_arrays
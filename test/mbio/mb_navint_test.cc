@@ -0,0 +1,121 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cmath>
+#include <cstdlib>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kNumSamples = 2000;
+
+// Brute force linear interpolation used as the reference.
+double Interp(int n, const double *t, const double *v, double time_d) {
+  if (time_d <= t[0])
+    return v[0];
+  if (time_d >= t[n - 1])
+    return v[n - 1];
+  int i = 1;
+  while (t[i] < time_d)
+    i++;
+  return v[i - 1] + (time_d - t[i - 1]) / (t[i] - t[i - 1]) * (v[i] - v[i - 1]);
+}
+
+class MbNavintTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mb_io_ptr = static_cast<mb_io_struct *>(calloc(1, sizeof(mb_io_struct)));
+    ASSERT_NE(nullptr, mb_io_ptr);
+    int error = MB_ERROR_NO_ERROR;
+    // Irregularly spaced samples.
+    double time_d = 1000.0;
+    for (int i = 0; i < kNumSamples; i++) {
+      time_d += 0.05 + 0.01 * (i % 7);
+      ASSERT_EQ(MB_SUCCESS, mb_attint_add(0, mb_io_ptr, time_d, 0.1 * (i % 13), sin(0.01 * i), cos(0.02 * i), &error));
+      ASSERT_EQ(MB_SUCCESS, mb_depint_add(0, mb_io_ptr, time_d, 100.0 + 0.5 * i, &error));
+    }
+  }
+
+  void TearDown() override { free(mb_io_ptr); }
+
+  mb_io_struct *mb_io_ptr = nullptr;
+};
+
+TEST_F(MbNavintTest, AttitudeMatchesReference) {
+  int error = MB_ERROR_NO_ERROR;
+  const int n = mb_io_ptr->nattitude;
+  ASSERT_EQ(kNumSamples, n);
+  // Forward, backward and scattered queries exercise both the cursor
+  // and the binary search, including the exact first and last times.
+  for (int pass = 0; pass < 3; pass++) {
+    for (int j = 0; j <= 5000; j++) {
+      const int k = pass == 0 ? j : pass == 1 ? 5000 - j : (j * 2749) % 5001;
+      const double time_d = mb_io_ptr->attitude_time_d[0] - 1.0 +
+                            (mb_io_ptr->attitude_time_d[n - 1] - mb_io_ptr->attitude_time_d[0] + 2.0) * k / 5000.0;
+      double heave, roll, pitch;
+      EXPECT_EQ(MB_SUCCESS, mb_attint_interp(0, mb_io_ptr, time_d, &heave, &roll, &pitch, &error));
+      EXPECT_NEAR(Interp(n, mb_io_ptr->attitude_time_d, mb_io_ptr->attitude_heave, time_d), heave, 1e-9);
+      EXPECT_NEAR(Interp(n, mb_io_ptr->attitude_time_d, mb_io_ptr->attitude_roll, time_d), roll, 1e-9);
+      EXPECT_NEAR(Interp(n, mb_io_ptr->attitude_time_d, mb_io_ptr->attitude_pitch, time_d), pitch, 1e-9);
+    }
+  }
+  double heave, roll, pitch;
+  EXPECT_EQ(MB_SUCCESS, mb_attint_interp(0, mb_io_ptr, mb_io_ptr->attitude_time_d[0], &heave, &roll, &pitch, &error));
+  EXPECT_DOUBLE_EQ(mb_io_ptr->attitude_heave[0], heave);
+  EXPECT_EQ(MB_SUCCESS, mb_attint_interp(0, mb_io_ptr, mb_io_ptr->attitude_time_d[n - 1], &heave, &roll, &pitch, &error));
+  EXPECT_DOUBLE_EQ(mb_io_ptr->attitude_heave[n - 1], heave);
+}
+
+TEST_F(MbNavintTest, BatchMatchesSingle) {
+  int error = MB_ERROR_NO_ERROR;
+  constexpr int kSamples = 512;
+  double time_d[kSamples];
+  double depth[kSamples];
+  for (int i = 0; i < kSamples; i++)
+    time_d[i] = mb_io_ptr->sensordepth_time_d[100] + 0.013 * i;
+  EXPECT_EQ(MB_SUCCESS, mb_depint_ninterp(0, mb_io_ptr, kSamples, time_d, depth, &error));
+  for (int i = 0; i < kSamples; i++) {
+    double sensordepth;
+    EXPECT_EQ(MB_SUCCESS, mb_depint_interp(0, mb_io_ptr, time_d[i], &sensordepth, &error));
+    EXPECT_DOUBLE_EQ(sensordepth, depth[i]);
+  }
+}
+
+TEST_F(MbNavintTest, NoData) {
+  int error = MB_ERROR_NO_ERROR;
+  double heading = -1.0;
+  const double time_d = 1000.0;
+  EXPECT_EQ(MB_FAILURE, mb_hedint_ninterp(0, mb_io_ptr, 1, &time_d, &heading, &error));
+  EXPECT_EQ(MB_ERROR_NOT_ENOUGH_DATA, error);
+  EXPECT_DOUBLE_EQ(0.0, heading);
+}
+
+TEST(MbLinearInterp, CursorMatchesSearch) {
+  int error = MB_ERROR_NO_ERROR;
+  constexpr int kNum = 300;
+  double xa[kNum];
+  double ya[kNum];
+  for (int i = 0; i < kNum; i++) {
+    xa[i] = 2.0 * i + 0.1 * (i % 5);
+    ya[i] = sqrt(1.0 * i);
+  }
+  int icursor = 0;
+  for (double x = -5.0; x < 2.0 * kNum + 5.0; x += 0.37) {
+    double y1, y2;
+    int i1 = 0;
+    EXPECT_EQ(MB_SUCCESS, mb_linear_interp(0, xa - 1, ya - 1, kNum, x, &y1, &i1, &error));
+    EXPECT_EQ(MB_SUCCESS, mb_linear_interp(0, xa - 1, ya - 1, kNum, x, &y2, &icursor, &error));
+    EXPECT_DOUBLE_EQ(y1, y2);
+    EXPECT_EQ(i1, icursor);
+    EXPECT_NEAR(Interp(kNum, xa, ya, x), y2, 1e-12);
+  }
+}
+
+}  // namespace
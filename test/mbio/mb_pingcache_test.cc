@@ -0,0 +1,343 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kFormat = 71;  // MBF_MBLDEOIH
+constexpr int kPings = 40;
+
+class MbPingcacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    // Point the mbio defaults at a cache directory of our own.
+    home_ = testing::TempDir() + "mb_pingcache_test_home";
+    cache_dir_ = home_ + "/cache";
+    mkdir(home_.c_str(), 0755);
+    mkdir(cache_dir_.c_str(), 0755);
+    for (const std::string &name : CacheFiles())
+      std::remove((cache_dir_ + "/" + name).c_str());
+    const char *home = getenv("HOME");
+    if (home != nullptr)
+      saved_home_ = home;
+    setenv("HOME", home_.c_str(), 1);
+    FILE *fp = fopen((home_ + "/.mbio_defaults").c_str(), "w");
+    ASSERT_NE(nullptr, fp);
+    fprintf(fp, "pingcache: %s\n", cache_dir_.c_str());
+    fclose(fp);
+
+    path_ = testing::TempDir() + "mb_pingcache_test.mb71";
+    snprintf(file_, sizeof(file_), "%s", path_.c_str());
+    WritePings();
+  }
+
+  void TearDown() override {
+    for (const std::string &name : CacheFiles())
+      std::remove((cache_dir_ + "/" + name).c_str());
+    std::remove((home_ + "/.mbio_defaults").c_str());
+    rmdir(cache_dir_.c_str());
+    rmdir(home_.c_str());
+    std::remove(path_.c_str());
+    std::remove((path_ + MB_INDEX_SUFFIX).c_str());
+    if (!saved_home_.empty())
+      setenv("HOME", saved_home_.c_str(), 1);
+  }
+
+  // Writes a comment and kPings pings whose number of beams changes along the file.
+  void WritePings() {
+    int error = MB_ERROR_NO_ERROR;
+    void *mbio_ptr = nullptr;
+    int beams_bath, beams_amp, pixels_ss;
+    ASSERT_EQ(MB_SUCCESS, mb_write_init(0, file_, kFormat, &mbio_ptr, &beams_bath, &beams_amp, &pixels_ss, &error));
+    void *store_ptr = nullptr;
+    mb_get_store(0, mbio_ptr, &store_ptr, &error);
+    char comment[] = "mb_pingcache_test";
+    mb_put_comment(0, mbio_ptr, comment, &error);
+    int time_i[7] = {2020, 1, 1, 0, 0, 0, 0};
+    double t0;
+    mb_get_time(0, time_i, &t0);
+    t0_ = t0;
+    std::vector<char> beamflag(32);
+    std::vector<double> bath(32), amp(32), bathacrosstrack(32), bathalongtrack(32);
+    double ss[1], ssacrosstrack[1], ssalongtrack[1];
+    for (int i = 0; i < kPings; i++) {
+      const int nbeams = 5 + i % 17;
+      for (int j = 0; j < nbeams; j++) {
+        beamflag[j] = j == 1 ? MB_FLAG_FLAG + MB_FLAG_MANUAL : MB_FLAG_NONE;
+        bath[j] = 500.0 + i + j;
+        amp[j] = j;
+        bathacrosstrack[j] = (j - nbeams / 2) * 20.0;
+        bathalongtrack[j] = 0.0;
+      }
+      mb_get_date(0, t0 + i, time_i);
+      EXPECT_EQ(MB_SUCCESS, mb_put_all(0, mbio_ptr, store_ptr, true, MB_DATA_DATA, time_i, t0 + i, -120.0 + 0.001 * i,
+                                       36.0, 10.0, 90.0, nbeams, nbeams, 0, beamflag.data(), bath.data(), amp.data(),
+                                       bathacrosstrack.data(), bathalongtrack.data(), ss, ssacrosstrack, ssalongtrack,
+                                       nullptr, &error));
+    }
+    mb_close(0, &mbio_ptr, &error);
+  }
+
+  std::vector<std::string> CacheFiles() const {
+    std::vector<std::string> names;
+    DIR *dir = opendir(cache_dir_.c_str());
+    if (dir != nullptr) {
+      for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+        if (entry->d_name[0] != '.')
+          names.push_back(entry->d_name);
+      closedir(dir);
+    }
+    return names;
+  }
+
+  struct Record {
+    int status, error, kind;
+    double time_d, navlon, navlat;
+    std::vector<char> beamflag;
+    std::vector<double> bath;
+    std::string comment;
+
+    bool operator==(const Record &other) const {
+      return status == other.status && error == other.error && kind == other.kind && time_d == other.time_d &&
+             navlon == other.navlon && navlat == other.navlat && beamflag == other.beamflag && bath == other.bath &&
+             comment == other.comment;
+    }
+  };
+
+  struct Reader {
+    void *mbio_ptr = nullptr;
+    char *beamflag = nullptr;
+    double *bath = nullptr, *amp = nullptr, *bathlon = nullptr, *bathlat = nullptr;
+    double *ss = nullptr, *sslon = nullptr, *sslat = nullptr;
+  };
+
+  // Opens the swath file into reader, whose arrays are registered with mbio and
+  // so must stay in place, reading from ping start on and asking for the ping
+  // cache if use_cache is set, and returns whether the cache is being read
+  // rather than written.
+  void Open(Reader *reader, bool *reading_cache, int start = -1, bool use_cache = true) {
+    double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+    int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+    int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+    if (start >= 0)
+      mb_get_date(0, t0_ + start, btime_i);
+    void *mbio_ptr = nullptr;
+    double btime_d, etime_d;
+    int beams_bath, beams_amp, pixels_ss;
+    int error = MB_ERROR_NO_ERROR;
+    EXPECT_EQ(MB_SUCCESS, mb_read_init(0, file_, kFormat, 1, 0, bounds, btime_i, etime_i, 0.0, 1.0, &mbio_ptr,
+                                       &btime_d, &etime_d, &beams_bath, &beams_amp, &pixels_ss, &error));
+    ((struct mb_io_struct *)mbio_ptr)->read_ahead_pending = 0;
+    EXPECT_EQ(MB_SUCCESS, mb_set_pingcache(0, mbio_ptr, use_cache, &error));
+    EXPECT_EQ(use_cache, ((struct mb_io_struct *)mbio_ptr)->pingcache != nullptr);
+    // A cache being written is a temporary file named after the cache file.
+    const std::vector<std::string> names = CacheFiles();
+    *reading_cache = names.size() == 1 && names[0].size() > 5 && names[0].compare(names[0].size() - 5, 5, ".mbpc") == 0;
+
+    *reader = Reader();
+    reader->mbio_ptr = mbio_ptr;
+    mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&reader->beamflag, &error);
+    mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&reader->bath, &error);
+    mb_register_array(0, mbio_ptr, MB_MEM_TYPE_AMPLITUDE, sizeof(double), (void **)&reader->amp, &error);
+    mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&reader->bathlon, &error);
+    mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&reader->bathlat, &error);
+    mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&reader->ss, &error);
+    mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&reader->sslon, &error);
+    mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&reader->sslat, &error);
+  }
+
+  // Reads up to count records with mb_read(), stopping at the end of the file.
+  std::vector<Record> Read(Reader *reader, int count) {
+    int error = MB_ERROR_NO_ERROR;
+    std::vector<Record> records;
+    int pings, time_i[7], nbath, namp, nss;
+    double speed, heading, distance, altitude, sensordepth;
+    char comment[MB_COMMENT_MAXLINE];
+    while ((int)records.size() < count && error <= MB_ERROR_NO_ERROR) {
+      Record record;
+      comment[0] = '\0';
+      record.status = mb_read(0, reader->mbio_ptr, &record.kind, &pings, time_i, &record.time_d, &record.navlon,
+                              &record.navlat, &speed, &heading, &distance, &altitude, &sensordepth, &nbath, &namp, &nss,
+                              reader->beamflag, reader->bath, reader->amp, reader->bathlon, reader->bathlat, reader->ss,
+                              reader->sslon, reader->sslat, comment, &error);
+      record.error = error;
+      if (record.kind == MB_DATA_DATA && error <= MB_ERROR_NO_ERROR) {
+        record.beamflag.assign(reader->beamflag, reader->beamflag + nbath);
+        record.bath.assign(reader->bath, reader->bath + nbath);
+      }
+      else if (record.kind == MB_DATA_COMMENT && error <= MB_ERROR_NO_ERROR) {
+        // mb_read() leaves the time and navigation of a comment unset.
+        record.time_d = record.navlon = record.navlat = 0.0;
+        record.comment = comment;
+      }
+      records.push_back(record);
+    }
+    return records;
+  }
+
+  // Reads the whole file, writing the cache if it is missing or unusable.
+  std::vector<Record> ReadAll(bool *reading_cache) {
+    Reader reader;
+    Open(&reader, reading_cache);
+    std::vector<Record> records = Read(&reader, 1000000);
+    int error = MB_ERROR_NO_ERROR;
+    mb_close(0, &reader.mbio_ptr, &error);
+    return records;
+  }
+
+  std::string CachePath() const {
+    const std::vector<std::string> names = CacheFiles();
+    return names.size() == 1 ? cache_dir_ + "/" + names[0] : std::string();
+  }
+
+  long CacheSize() const {
+    struct stat file_status;
+    return stat(CachePath().c_str(), &file_status) == 0 ? (long)file_status.st_size : -1;
+  }
+
+  // Reads count records with mb_read() and then the rest with mb_get_all(),
+  // which reads the swath file directly.
+  std::vector<Record> ReadThenGetAll(Reader *reader, int count) {
+    std::vector<Record> records = Read(reader, count);
+    int error = MB_ERROR_NO_ERROR;
+    void *store_ptr = nullptr;
+    int time_i[7], nbath, namp, nss;
+    double speed, heading, distance, altitude, sensordepth;
+    char comment[MB_COMMENT_MAXLINE];
+    while (error <= MB_ERROR_NO_ERROR || error == MB_ERROR_OUT_TIME) {
+      Record record;
+      comment[0] = '\0';
+      record.status = mb_get_all(0, reader->mbio_ptr, &store_ptr, &record.kind, time_i, &record.time_d,
+                                 &record.navlon, &record.navlat, &speed, &heading, &distance, &altitude, &sensordepth,
+                                 &nbath, &namp, &nss, reader->beamflag, reader->bath, reader->amp, reader->bathlon,
+                                 reader->bathlat, reader->ss, reader->sslon, reader->sslat, comment, &error);
+      record.error = error;
+      if (record.kind == MB_DATA_DATA && error <= MB_ERROR_NO_ERROR) {
+        record.beamflag.assign(reader->beamflag, reader->beamflag + nbath);
+        record.bath.assign(reader->bath, reader->bath + nbath);
+      }
+      records.push_back(record);
+    }
+    int lerror = MB_ERROR_NO_ERROR;
+    mb_close(0, &reader->mbio_ptr, &lerror);
+    return records;
+  }
+
+  double t0_ = 0.0;
+  std::string home_;
+  std::string saved_home_;
+  std::string cache_dir_;
+  std::string path_;
+  char file_[MB_PATH_MAXLINE];
+};
+
+TEST_F(MbPingcacheTest, WrittenCacheReadsBackTheSameRecords) {
+  bool reading_cache = true;
+  const std::vector<Record> expected = ReadAll(&reading_cache);
+  EXPECT_FALSE(reading_cache);
+  ASSERT_EQ(kPings + 2, (int)expected.size());
+  EXPECT_EQ(MB_ERROR_EOF, expected.back().error);
+  ASSERT_FALSE(CachePath().empty());
+
+  const std::vector<Record> cached = ReadAll(&reading_cache);
+  EXPECT_TRUE(reading_cache);
+  ASSERT_EQ(expected.size(), cached.size());
+  for (size_t i = 0; i < expected.size(); i++)
+    EXPECT_TRUE(expected[i] == cached[i]) << "record " << i;
+}
+
+TEST_F(MbPingcacheTest, DirectReadsDetachFromTheCache) {
+  bool reading_cache = true;
+  const std::vector<Record> expected = ReadAll(&reading_cache);
+
+  // Half the records come from the cache, then reading the store directly
+  // gives up the cache and continues from the swath file at the same record.
+  Reader reader;
+  Open(&reader, &reading_cache);
+  EXPECT_TRUE(reading_cache);
+  const int half = kPings / 2;
+  const std::vector<Record> first = Read(&reader, half);
+  ASSERT_EQ(half, (int)first.size());
+  for (int i = 0; i < half; i++)
+    EXPECT_TRUE(expected[i] == first[i]) << "record " << i;
+
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)reader.mbio_ptr;
+  int error = MB_ERROR_NO_ERROR;
+  void *store_ptr = nullptr;
+  int kind, time_i[7], nbath, namp, nss;
+  double time_d, navlon, navlat, speed, heading, distance, altitude, sensordepth;
+  char comment[MB_COMMENT_MAXLINE];
+  for (size_t i = half; i < expected.size(); i++) {
+    mb_get_all(0, reader.mbio_ptr, &store_ptr, &kind, time_i, &time_d, &navlon, &navlat, &speed, &heading,
+               &distance, &altitude, &sensordepth, &nbath, &namp, &nss, reader.beamflag, reader.bath, reader.amp,
+               reader.bathlon, reader.bathlat, reader.ss, reader.sslon, reader.sslat, comment, &error);
+    EXPECT_EQ(nullptr, mb_io_ptr->pingcache);
+    EXPECT_EQ(expected[i].error, error) << "record " << i;
+    EXPECT_EQ(expected[i].kind, kind) << "record " << i;
+    if (kind == MB_DATA_DATA && error <= MB_ERROR_NO_ERROR)
+      EXPECT_DOUBLE_EQ(expected[i].time_d, time_d) << "record " << i;
+  }
+  mb_close(0, &reader.mbio_ptr, &error);
+}
+
+TEST_F(MbPingcacheTest, DamagedCacheIsReplacedByDecodingTheFile) {
+  bool reading_cache = true;
+  const std::vector<Record> expected = ReadAll(&reading_cache);
+  const long size = CacheSize();
+  ASSERT_GT(size, 0);
+
+  // A cache truncated part way through a record, or with bytes beyond its
+  // last record, is not used, and is rewritten from the swath file.
+  for (const long damaged_size : {size - 12, size / 2, size + 8}) {
+    ASSERT_EQ(0, truncate(CachePath().c_str(), damaged_size));
+    const std::vector<Record> records = ReadAll(&reading_cache);
+    EXPECT_FALSE(reading_cache) << damaged_size;
+    ASSERT_EQ(expected.size(), records.size());
+    for (size_t i = 0; i < expected.size(); i++)
+      EXPECT_TRUE(expected[i] == records[i]) << "record " << i;
+    EXPECT_EQ(size, CacheSize());
+  }
+}
+
+TEST_F(MbPingcacheTest, DetachAfterIndexSeekContinuesAtTheSameRecord) {
+  bool reading_cache = true;
+  ReadAll(&reading_cache);
+  int error = MB_ERROR_NO_ERROR;
+  ASSERT_EQ(MB_SUCCESS, mb_index_make(0, true, file_, kFormat, &error));
+
+  // A time window late in the file seeks through the index past the first
+  // records, both when reading the file and when reading the cache.
+  constexpr int kStart = 30;
+  Reader reader;
+  Open(&reader, &reading_cache, kStart, false);
+  EXPECT_TRUE(((struct mb_io_struct *)reader.mbio_ptr)->index_seek_pending);
+  const std::vector<Record> expected = ReadThenGetAll(&reader, 3);
+
+  Open(&reader, &reading_cache, kStart);
+  EXPECT_TRUE(reading_cache);
+  const std::vector<Record> records = ReadThenGetAll(&reader, 3);
+  ASSERT_GT(expected.size(), 3u);
+  EXPECT_EQ(MB_DATA_COMMENT, expected[0].kind);
+  EXPECT_DOUBLE_EQ(t0_ + kStart - MB_INDEX_LEADIN_TIME, expected[1].time_d);
+  ASSERT_EQ(expected.size(), records.size());
+  for (size_t i = 0; i < expected.size(); i++)
+    EXPECT_TRUE(expected[i] == records[i]) << "record " << i;
+}
+
+}  // namespace
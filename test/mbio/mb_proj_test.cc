@@ -0,0 +1,161 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+char kUtm10N[] = "UTM10N";
+
+TEST(MbProjTest, ArraysMatchSinglePoints) {
+  int error = MB_ERROR_NO_ERROR;
+  void *pjptr = nullptr;
+  ASSERT_EQ(MB_SUCCESS, mb_proj_init(0, kUtm10N, &pjptr, &error));
+
+  std::vector<double> lon, lat;
+  for (int i = 0; i < 100; i++) {
+    lon.push_back(-123.5 + 0.01 * i);
+    lat.push_back(36.0 + 0.005 * i);
+  }
+  std::vector<double> easting(lon), northing(lat);
+  EXPECT_EQ(MB_SUCCESS, mb_proj_forward_array(0, pjptr, easting.size(), easting.data(), northing.data(), &error));
+  EXPECT_EQ(MB_ERROR_NO_ERROR, error);
+  for (size_t i = 0; i < lon.size(); i++) {
+    double x, y;
+    mb_proj_forward(0, pjptr, lon[i], lat[i], &x, &y, &error);
+    EXPECT_DOUBLE_EQ(x, easting[i]);
+    EXPECT_DOUBLE_EQ(y, northing[i]);
+  }
+
+  // The inverse projection recovers the original coordinates.
+  EXPECT_EQ(MB_SUCCESS, mb_proj_inverse_array(0, pjptr, easting.size(), easting.data(), northing.data(), &error));
+  for (size_t i = 0; i < lon.size(); i++) {
+    EXPECT_NEAR(lon[i], easting[i], 1e-9);
+    EXPECT_NEAR(lat[i], northing[i], 1e-9);
+  }
+  mb_proj_free(0, &pjptr, &error);
+}
+
+TEST(MbProjTest, ArraysReportFailedPoints) {
+  int error = MB_ERROR_NO_ERROR;
+  void *pjptr = nullptr;
+  ASSERT_EQ(MB_SUCCESS, mb_proj_init(0, kUtm10N, &pjptr, &error));
+
+  // A latitude beyond the pole cannot be projected.
+  std::vector<double> u = {-123.0, -123.0, -122.0};
+  std::vector<double> v = {36.0, 95.0, 37.0};
+  EXPECT_EQ(MB_FAILURE, mb_proj_forward_array(0, pjptr, u.size(), u.data(), v.data(), &error));
+  EXPECT_EQ(MB_ERROR_BAD_PROJECTION, error);
+  EXPECT_EQ(HUGE_VAL, u[1]);
+  EXPECT_TRUE(std::isfinite(u[0]));
+  EXPECT_TRUE(std::isfinite(u[2]));
+
+  u = {u[0], HUGE_VAL};
+  v = {v[0], HUGE_VAL};
+  EXPECT_EQ(MB_FAILURE, mb_proj_inverse_array(0, pjptr, u.size(), u.data(), v.data(), &error));
+  EXPECT_EQ(MB_ERROR_BAD_PROJECTION, error);
+  EXPECT_NEAR(-123.0, u[0], 1e-9);
+  EXPECT_NEAR(36.0, v[0], 1e-9);
+
+  // Success clears an earlier error.
+  EXPECT_EQ(MB_SUCCESS, mb_proj_inverse_array(0, pjptr, 1, u.data(), v.data(), &error));
+  EXPECT_EQ(MB_ERROR_NO_ERROR, error);
+  mb_proj_free(0, &pjptr, &error);
+}
+
+TEST(MbProjTest, CachedPerThread) {
+  int error = MB_ERROR_NO_ERROR;
+  void *first = nullptr;
+  void *second = nullptr;
+  ASSERT_EQ(MB_SUCCESS, mb_proj_init_cached(0, kUtm10N, &first, &error));
+  ASSERT_EQ(MB_SUCCESS, mb_proj_init_cached(0, kUtm10N, &second, &error));
+  EXPECT_NE(nullptr, first);
+  EXPECT_EQ(first, second);
+
+  // Other threads get their own projection, which gives the same results.
+  double x, y;
+  mb_proj_forward(0, first, -122.0, 36.8, &x, &y, &error);
+  void *other = nullptr;
+  double xt = 0.0, yt = 0.0;
+  std::thread thread([&]() {
+    int thread_error = MB_ERROR_NO_ERROR;
+    if (mb_proj_init_cached(0, kUtm10N, &other, &thread_error) == MB_SUCCESS)
+      mb_proj_forward(0, other, -122.0, 36.8, &xt, &yt, &thread_error);
+    mb_proj_cache_free(0, &thread_error);
+  });
+  thread.join();
+  EXPECT_NE(nullptr, other);
+  EXPECT_NE(first, other);
+  EXPECT_DOUBLE_EQ(x, xt);
+  EXPECT_DOUBLE_EQ(y, yt);
+
+  EXPECT_EQ(MB_SUCCESS, mb_proj_cache_free(0, &error));
+}
+
+void *Open(char *file) {
+  double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+  int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+  int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+  void *mbio_ptr = nullptr;
+  double btime_d, etime_d;
+  int beams_bath, beams_amp, pixels_ss;
+  int error = MB_ERROR_NO_ERROR;
+  EXPECT_EQ(MB_SUCCESS, mb_read_init(0, file, 71, 1, 0, bounds, btime_i, etime_i, 0.0, 1.0, &mbio_ptr, &btime_d,
+                                     &etime_d, &beams_bath, &beams_amp, &pixels_ss, &error));
+  return mbio_ptr;
+}
+
+TEST(MbProjTest, ReadInitSharesCachedProjection) {
+  const std::string path = testing::TempDir() + "mb_proj_test.mb71";
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path.c_str());
+  int error = MB_ERROR_NO_ERROR;
+  void *mbio_ptr = nullptr;
+  int beams_bath, beams_amp, pixels_ss;
+  ASSERT_EQ(MB_SUCCESS, mb_write_init(0, file, 71, &mbio_ptr, &beams_bath, &beams_amp, &pixels_ss, &error));
+  char comment[] = "mb_proj_test";
+  mb_put_comment(0, mbio_ptr, comment, &error);
+  mb_close(0, &mbio_ptr, &error);
+  const std::string prj = path + ".prj";
+  FILE *fp = fopen(prj.c_str(), "w");
+  ASSERT_NE(nullptr, fp);
+  fprintf(fp, "%s\n", kUtm10N);
+  fclose(fp);
+
+  // Files opened by the same thread with the same projection share it.
+  void *first = Open(file);
+  void *second = Open(file);
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  struct mb_io_struct *first_io = (struct mb_io_struct *)first;
+  struct mb_io_struct *second_io = (struct mb_io_struct *)second;
+  EXPECT_TRUE(first_io->projection_initialized);
+  EXPECT_TRUE(first_io->projection_cached);
+  EXPECT_EQ(first_io->pjptr, second_io->pjptr);
+
+  // Closing a file leaves the shared projection usable by the other.
+  void *pjptr = second_io->pjptr;
+  mb_close(0, &first, &error);
+  double x, y;
+  EXPECT_EQ(MB_SUCCESS, mb_proj_forward(0, pjptr, -122.0, 36.8, &x, &y, &error));
+  EXPECT_TRUE(std::isfinite(x));
+  mb_close(0, &second, &error);
+
+  mb_proj_cache_free(0, &error);
+  std::remove(prj.c_str());
+  std::remove(path.c_str());
+}
+
+}  // namespace
@@ -0,0 +1,191 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kFormat = 71;  // MBF_MBLDEOIH, the only format framed for parallel decoding
+constexpr int kPings = 300;
+
+int BeamCount(int i) { return 5 + (i * 11) % 37; }
+
+// Writes kPings pings whose number of beams changes along the file, with comments
+// at the start and part way through.
+void WritePings(char *file) {
+  int error = MB_ERROR_NO_ERROR;
+  void *mbio_ptr = nullptr;
+  int beams_bath, beams_amp, pixels_ss;
+  ASSERT_EQ(MB_SUCCESS, mb_write_init(0, file, kFormat, &mbio_ptr, &beams_bath, &beams_amp, &pixels_ss, &error));
+  void *store_ptr = nullptr;
+  mb_get_store(0, mbio_ptr, &store_ptr, &error);
+  char comment[] = "mb_read_ahead_test";
+  mb_put_comment(0, mbio_ptr, comment, &error);
+
+  int time_i[7] = {2020, 1, 1, 0, 0, 0, 0};
+  double t0;
+  mb_get_time(0, time_i, &t0);
+  std::vector<char> beamflag(64);
+  std::vector<double> bath(64), amp(64), bathacrosstrack(64), bathalongtrack(64);
+  double ss[1], ssacrosstrack[1], ssalongtrack[1];
+  for (int i = 0; i < kPings; i++) {
+    if (i == kPings / 2) {
+      char middle[] = "halfway";
+      mb_put_comment(0, mbio_ptr, middle, &error);
+    }
+    const int nbeams = BeamCount(i);
+    for (int j = 0; j < nbeams; j++) {
+      beamflag[j] = j % 5 == 0 ? MB_FLAG_FLAG + MB_FLAG_MANUAL : MB_FLAG_NONE;
+      bath[j] = 1000.0 + i + 0.5 * j;
+      amp[j] = j;
+      bathacrosstrack[j] = (j - nbeams / 2) * 50.0;
+      bathalongtrack[j] = 0.0;
+    }
+    const double time_d = t0 + i;
+    mb_get_date(0, time_d, time_i);
+    EXPECT_EQ(MB_SUCCESS, mb_put_all(0, mbio_ptr, store_ptr, true, MB_DATA_DATA, time_i, time_d, -120.0 + 0.001 * i,
+                                     36.0, 10.0, 90.0, nbeams, nbeams, 0, beamflag.data(), bath.data(), amp.data(),
+                                     bathacrosstrack.data(), bathalongtrack.data(), ss, ssacrosstrack, ssalongtrack,
+                                     nullptr, &error));
+  }
+  mb_close(0, &mbio_ptr, &error);
+}
+
+struct Record {
+  int status, error, kind;
+  double time_d, navlon, navlat, heading;
+  std::vector<char> beamflag;
+  std::vector<double> bath, bathacrosstrack;
+  std::string comment;
+
+  bool operator==(const Record &other) const {
+    return status == other.status && error == other.error && kind == other.kind && time_d == other.time_d &&
+           navlon == other.navlon && navlat == other.navlat && heading == other.heading &&
+           beamflag == other.beamflag && bath == other.bath && bathacrosstrack == other.bathacrosstrack &&
+           comment == other.comment;
+  }
+};
+
+// Reads every record with mb_get_all(), reading ahead with nthread threads
+// if nthread is positive, and returns the number of threads decoding.
+int ReadRecords(char *file, int nthread, std::vector<Record> *records) {
+  double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+  int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+  int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+  void *mbio_ptr = nullptr;
+  double btime_d, etime_d;
+  int beams_bath, beams_amp, pixels_ss;
+  int error = MB_ERROR_NO_ERROR;
+  EXPECT_EQ(MB_SUCCESS, mb_read_init(0, file, kFormat, 1, 0, bounds, btime_i, etime_i, 0.0, 1.0, &mbio_ptr, &btime_d,
+                                     &etime_d, &beams_bath, &beams_amp, &pixels_ss, &error));
+  struct mb_io_struct *mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+  mb_io_ptr->read_ahead_pending = 0;
+  int nthread_used = 0;
+  if (nthread > 0) {
+    EXPECT_EQ(MB_SUCCESS, mb_read_ahead_init(0, mbio_ptr, 8, nthread, &error));
+    EXPECT_NE(nullptr, mb_io_ptr->read_ahead);
+    nthread_used = mb_io_ptr->read_ahead_threads;
+  }
+
+  char *beamflag = nullptr;
+  double *bath = nullptr, *amp = nullptr, *bathacrosstrack = nullptr, *bathalongtrack = nullptr;
+  double *ss = nullptr, *ssacrosstrack = nullptr, *ssalongtrack = nullptr;
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(char), (void **)&beamflag, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bath, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_AMPLITUDE, sizeof(double), (void **)&amp, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathacrosstrack, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_BATHYMETRY, sizeof(double), (void **)&bathalongtrack, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ss, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ssacrosstrack, &error);
+  mb_register_array(0, mbio_ptr, MB_MEM_TYPE_SIDESCAN, sizeof(double), (void **)&ssalongtrack, &error);
+
+  void *store_ptr = nullptr;
+  int time_i[7], nbath, namp, nss;
+  double speed, distance, altitude, sensordepth;
+  char comment[MB_COMMENT_MAXLINE];
+  error = MB_ERROR_NO_ERROR;
+  while (error <= MB_ERROR_NO_ERROR) {
+    Record record;
+    comment[0] = '\0';
+    record.status = mb_get_all(0, mbio_ptr, &store_ptr, &record.kind, time_i, &record.time_d, &record.navlon,
+                               &record.navlat, &speed, &record.heading, &distance, &altitude, &sensordepth, &nbath,
+                               &namp, &nss, beamflag, bath, amp, bathacrosstrack, bathalongtrack, ss, ssacrosstrack,
+                               ssalongtrack, comment, &error);
+    record.error = error;
+    if (record.kind == MB_DATA_DATA && error <= MB_ERROR_NO_ERROR) {
+      record.beamflag.assign(beamflag, beamflag + nbath);
+      record.bath.assign(bath, bath + nbath);
+      record.bathacrosstrack.assign(bathacrosstrack, bathacrosstrack + nbath);
+    }
+    else if (record.kind == MB_DATA_COMMENT && error <= MB_ERROR_NO_ERROR) {
+      record.comment = comment;
+    }
+    records->push_back(record);
+  }
+  mb_close(0, &mbio_ptr, &error);
+  return nthread_used;
+}
+
+TEST(MbReadAheadTest, ParallelDecodingMatchesSequentialReading) {
+  std::string path = testing::TempDir() + "mb_read_ahead_test.mb71";
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path.c_str());
+  WritePings(file);
+
+  std::vector<Record> expected;
+  EXPECT_EQ(0, ReadRecords(file, 0, &expected));
+  ASSERT_EQ(kPings + 3, (int)expected.size());
+  EXPECT_EQ(MB_ERROR_EOF, expected.back().error);
+
+  // One background thread reads sequentially, several decode framed records in parallel.
+  for (int nthread : {1, 2, 4, 7}) {
+    std::vector<Record> records;
+    EXPECT_EQ(nthread, ReadRecords(file, nthread, &records));
+    ASSERT_EQ(expected.size(), records.size());
+    for (size_t i = 0; i < expected.size(); i++)
+      EXPECT_TRUE(expected[i] == records[i]) << "record " << i << " with " << nthread << " threads";
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(MbReadAheadTest, TruncatedFileIsReadSequentially) {
+  std::string path = testing::TempDir() + "mb_read_ahead_test_truncated.mb71";
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path.c_str());
+  WritePings(file);
+  FILE *fp = fopen(file, "rb");
+  ASSERT_NE(nullptr, fp);
+  fseek(fp, 0, SEEK_END);
+  const long size = ftell(fp);
+  fclose(fp);
+  ASSERT_EQ(0, truncate(file, size - 10));
+
+  std::vector<Record> expected;
+  ReadRecords(file, 0, &expected);
+  ASSERT_FALSE(expected.empty());
+
+  // The framing scan does not reach the end of the file, so one thread
+  // reads and the same records and errors are returned.
+  std::vector<Record> records;
+  EXPECT_EQ(1, ReadRecords(file, 4, &records));
+  ASSERT_EQ(expected.size(), records.size());
+  for (size_t i = 0; i < expected.size(); i++)
+    EXPECT_TRUE(expected[i] == records[i]) << "record " << i;
+
+  std::remove(path.c_str());
+}
+
+}  // namespace
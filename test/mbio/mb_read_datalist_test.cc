@@ -0,0 +1,183 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_format.h"
+#include "mb_io.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kFormat = 71;  // MBF_MBLDEOIH
+constexpr int kFiles = 5;
+constexpr int kBeams = 7;
+constexpr int kBadFormat = 999;  // not a valid format id
+
+// ifile, kind, error, time_d, nbath, bath[0]
+typedef std::tuple<int, int, int, double, int, double> Record;
+
+// Writes a comment and npings pings whose depths identify the file.
+void WriteFile(const std::string &path, int ifile, int npings) {
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", path.c_str());
+  int error = MB_ERROR_NO_ERROR;
+  void *mbio_ptr = nullptr;
+  int beams_bath, beams_amp, pixels_ss;
+  ASSERT_EQ(MB_SUCCESS, mb_write_init(0, file, kFormat, &mbio_ptr, &beams_bath, &beams_amp, &pixels_ss, &error));
+  void *store_ptr = nullptr;
+  mb_get_store(0, mbio_ptr, &store_ptr, &error);
+  char comment[] = "mb_read_datalist_test";
+  mb_put_comment(0, mbio_ptr, comment, &error);
+
+  int time_i[7] = {2020, 1, 1, 0, 0, 0, 0};
+  double t0;
+  mb_get_time(0, time_i, &t0);
+  char beamflag[kBeams];
+  double bath[kBeams], amp[kBeams], bathacrosstrack[kBeams], bathalongtrack[kBeams];
+  double ss[1], ssacrosstrack[1], ssalongtrack[1];
+  for (int i = 0; i < npings; i++) {
+    for (int j = 0; j < kBeams; j++) {
+      beamflag[j] = MB_FLAG_NONE;
+      bath[j] = 1000.0 * (ifile + 1) + i;
+      amp[j] = j;
+      bathacrosstrack[j] = (j - kBeams / 2) * 100.0;
+      bathalongtrack[j] = 0.0;
+    }
+    const double time_d = t0 + 1000.0 * ifile + i;
+    mb_get_date(0, time_d, time_i);
+    EXPECT_EQ(MB_SUCCESS, mb_put_all(0, mbio_ptr, store_ptr, true, MB_DATA_DATA, time_i, time_d, -120.0 + 0.001 * i,
+                                     36.0, 10.0, 90.0, kBeams, kBeams, 0, beamflag, bath, amp, bathacrosstrack,
+                                     bathalongtrack, ss, ssacrosstrack, ssalongtrack, nullptr, &error));
+  }
+  mb_close(0, &mbio_ptr, &error);
+}
+
+// Reads every record of the datalist, returning the final error.
+int ReadAll(const std::string &list, int nthreads, int queue_size, bool ordered, std::vector<Record> *records) {
+  char file[MB_PATH_MAXLINE];
+  snprintf(file, sizeof(file), "%s", list.c_str());
+  int error = MB_ERROR_NO_ERROR;
+  void *datalist = nullptr;
+  EXPECT_EQ(MB_SUCCESS, mb_datalist_open(0, &datalist, file, MB_DATALIST_LOOK_UNSET, &error));
+
+  double bounds[4] = {-360.0, 360.0, -90.0, 90.0};
+  int btime_i[7] = {1962, 2, 21, 10, 30, 0, 0};
+  int etime_i[7] = {2062, 2, 21, 10, 30, 0, 0};
+  void *reader = nullptr;
+  EXPECT_EQ(MB_SUCCESS, mb_read_datalist_init(0, datalist, 1, 0, bounds, btime_i, etime_i, 0.0, 1000000.0, false,
+                                              nthreads, queue_size, ordered, &reader, &error));
+
+  struct mb_datalist_ping_struct *ping = nullptr;
+  while (mb_read_datalist(0, reader, (void **)&ping, &error) == MB_SUCCESS || ping != nullptr) {
+    // Only survey records have a defined time.
+    const double time_d = ping->kind == MB_DATA_DATA ? ping->time_d : 0.0;
+    records->push_back(Record(ping->ifile, ping->kind, ping->error, time_d, ping->nbath,
+                              ping->nbath > 0 ? ping->bath[0] : 0.0));
+  }
+  const int final_error = error;
+
+  // Reading past the end keeps reporting the end of the data.
+  EXPECT_EQ(MB_FAILURE, mb_read_datalist(0, reader, (void **)&ping, &error));
+  EXPECT_EQ(MB_ERROR_EOF, error);
+  EXPECT_EQ(nullptr, ping);
+
+  EXPECT_EQ(MB_SUCCESS, mb_read_datalist_close(0, &reader, &error));
+  EXPECT_EQ(nullptr, reader);
+  mb_datalist_close(0, &datalist, &error);
+  return final_error;
+}
+
+TEST(MbReadDatalistTest, ThreadedReadsMatchSerialRead) {
+  const std::string dir = testing::TempDir();
+  const int npings[kFiles] = {30, 1, 0, 57, 12};
+  const std::string list = dir + "mb_read_datalist_test.mb-1";
+  FILE *fp = fopen(list.c_str(), "w");
+  ASSERT_NE(nullptr, fp);
+  std::vector<std::string> paths;
+  for (int ifile = 0; ifile < kFiles; ifile++) {
+    paths.push_back(dir + "mb_read_datalist_test_" + std::to_string(ifile) + ".mb71");
+    WriteFile(paths.back(), ifile, npings[ifile]);
+    fprintf(fp, "%s %d\n", paths.back().c_str(), kFormat);
+  }
+
+  // A file that cannot be read is reported as a record with a fatal error.
+  fprintf(fp, "%s %d\n", paths.front().c_str(), kBadFormat);
+  fclose(fp);
+
+  std::vector<Record> serial;
+  EXPECT_EQ(MB_ERROR_EOF, ReadAll(list, 1, 0, true, &serial));
+
+  // One comment and all of the pings from each file, in datalist order.
+  int nrecord = 0;
+  for (int ifile = 0; ifile < kFiles; ifile++)
+    nrecord += 1 + npings[ifile];
+  ASSERT_EQ(nrecord + 1, (int)serial.size());
+  int irecord = 0;
+  for (int ifile = 0; ifile < kFiles; ifile++) {
+    EXPECT_EQ(ifile, std::get<0>(serial[irecord]));
+    EXPECT_EQ(MB_DATA_COMMENT, std::get<1>(serial[irecord]));
+    irecord++;
+    for (int i = 0; i < npings[ifile]; i++) {
+      EXPECT_EQ(ifile, std::get<0>(serial[irecord]));
+      EXPECT_EQ(MB_DATA_DATA, std::get<1>(serial[irecord]));
+      EXPECT_EQ(MB_ERROR_NO_ERROR, std::get<2>(serial[irecord]));
+      EXPECT_EQ(kBeams, std::get<4>(serial[irecord]));
+      EXPECT_NEAR(1000.0 * (ifile + 1) + i, std::get<5>(serial[irecord]), 0.5);
+      irecord++;
+    }
+  }
+  EXPECT_EQ(kFiles, std::get<0>(serial[irecord]));
+  EXPECT_EQ(MB_DATA_NONE, std::get<1>(serial[irecord]));
+  EXPECT_GT(std::get<2>(serial[irecord]), MB_ERROR_NO_ERROR);
+
+  // Several threads with short queues return the same records in the same order.
+  for (int nthreads : {2, 4, 8}) {
+    std::vector<Record> ordered;
+    EXPECT_EQ(MB_ERROR_EOF, ReadAll(list, nthreads, 2, true, &ordered));
+    EXPECT_EQ(serial, ordered);
+  }
+
+  // In arrival order the files are interleaved but each file stays in order.
+  std::vector<Record> unordered;
+  EXPECT_EQ(MB_ERROR_EOF, ReadAll(list, 4, 2, false, &unordered));
+  ASSERT_EQ(serial.size(), unordered.size());
+  for (int ifile = 0; ifile <= kFiles; ifile++) {
+    std::vector<Record> expected, actual;
+    for (const Record &record : serial)
+      if (std::get<0>(record) == ifile)
+        expected.push_back(record);
+    for (const Record &record : unordered)
+      if (std::get<0>(record) == ifile)
+        actual.push_back(record);
+    EXPECT_EQ(expected, actual);
+  }
+
+  for (const std::string &path : paths)
+    std::remove(path.c_str());
+  std::remove(list.c_str());
+}
+
+TEST(MbReadDatalistTest, EmptyDatalist) {
+  const std::string list = testing::TempDir() + "mb_read_datalist_test_empty.mb-1";
+  FILE *fp = fopen(list.c_str(), "w");
+  ASSERT_NE(nullptr, fp);
+  fprintf(fp, "# no swath files\n");
+  fclose(fp);
+
+  std::vector<Record> records;
+  EXPECT_EQ(MB_ERROR_EOF, ReadAll(list, 4, 0, true, &records));
+  EXPECT_TRUE(records.empty());
+  std::remove(list.c_str());
+}
+
+}  // namespace
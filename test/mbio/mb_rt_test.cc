@@ -0,0 +1,130 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "mb_define.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int kSsvCorrect = 1;
+
+class MbRtTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Sound velocity profile with a sharp thermocline, extended to 12000 m
+    // as mbprocess does.
+    for (double d = 0.0; d <= 1500.0; d += 2.0) {
+      depth.push_back(d);
+      velocity.push_back(1540.0 - 40.0 * tanh((d - 60.0) / 25.0) + 0.016 * d);
+    }
+    depth.push_back(12000.0);
+    velocity.push_back(velocity.back() + 0.016 * 10500.0);
+    int error = MB_ERROR_NO_ERROR;
+    ASSERT_EQ(MB_SUCCESS, mb_rt_init(0, depth.size(), depth.data(), velocity.data(), &model, &error));
+  }
+
+  void TearDown() override {
+    int error = MB_ERROR_NO_ERROR;
+    mb_rt_deall(0, &model, &error);
+  }
+
+  void Trace(double source_depth, double angle, double end_time, double *x, double *z, double *travel_time = nullptr) {
+    int error = MB_ERROR_NO_ERROR;
+    double ttime;
+    int ray_stat;
+    ASSERT_EQ(MB_SUCCESS, mb_rt(0, model, source_depth, angle, end_time, kSsvCorrect, 1510.0, 0.0, 0, nullptr, nullptr,
+                                nullptr, nullptr, x, z, &ttime, &ray_stat, &error));
+    if (travel_time != nullptr)
+      *travel_time = ttime;
+  }
+
+  std::vector<double> depth;
+  std::vector<double> velocity;
+  void *model = nullptr;
+};
+
+TEST_F(MbRtTest, TableMatchesTrace) {
+  int error = MB_ERROR_NO_ERROR;
+  void *table = nullptr;
+  ASSERT_EQ(MB_SUCCESS, mb_rt_table_init(0, model, 1.0, &table, &error));
+  for (double source_depth : {0.0, 3.7, 8.2, 140.0}) {
+    for (double angle = 0.0; angle < 80.0; angle += 3.3) {
+      for (double end_time = 0.01; end_time < 0.5; end_time += 0.047) {
+        double x, z, ttime;
+        Trace(source_depth, angle, end_time, &x, &z, &ttime);
+        double xt, zt, travel_time;
+        int ray_stat;
+        EXPECT_EQ(MB_SUCCESS, mb_rt_table(0, table, source_depth, angle, end_time, kSsvCorrect, 1510.0, 0.0, &xt, &zt,
+                                          &travel_time, &ray_stat, &error));
+        EXPECT_NEAR(x, xt, 0.01);
+        EXPECT_NEAR(z, zt, 0.01);
+        EXPECT_NEAR(ttime, travel_time, 1e-9);
+      }
+    }
+  }
+  EXPECT_EQ(MB_SUCCESS, mb_rt_table_deall(0, &table, &error));
+  EXPECT_EQ(nullptr, table);
+}
+
+TEST_F(MbRtTest, TableFallsBackToTrace) {
+  int error = MB_ERROR_NO_ERROR;
+  void *table = nullptr;
+  ASSERT_EQ(MB_SUCCESS, mb_rt_table_init(0, model, 0.1, &table, &error));
+  // Travel times beyond the table and near horizontal rays are traced directly.
+  for (const auto &ray : std::vector<std::pair<double, double>>{{30.0, 0.4}, {88.0, 0.05}}) {
+    double x, z;
+    Trace(5.0, ray.first, ray.second, &x, &z);
+    double xt, zt, travel_time;
+    int ray_stat;
+    EXPECT_EQ(MB_SUCCESS, mb_rt_table(0, table, 5.0, ray.first, ray.second, kSsvCorrect, 1510.0, 0.0, &xt, &zt,
+                                      &travel_time, &ray_stat, &error));
+    EXPECT_DOUBLE_EQ(x, xt);
+    EXPECT_DOUBLE_EQ(z, zt);
+  }
+  // Sources outside the model fail as for mb_rt().
+  double xt, zt, travel_time;
+  int ray_stat;
+  EXPECT_EQ(MB_FAILURE, mb_rt_table(0, table, -5.0, 10.0, 0.1, kSsvCorrect, 1510.0, 0.0, &xt, &zt, &travel_time,
+                                    &ray_stat, &error));
+  EXPECT_EQ(MB_ERROR_BAD_PARAMETER, error);
+  // A ray found in the table clears the error left by an earlier call.
+  EXPECT_EQ(MB_SUCCESS, mb_rt_table(0, table, 5.0, 10.0, 0.05, kSsvCorrect, 1510.0, 0.0, &xt, &zt, &travel_time,
+                                    &ray_stat, &error));
+  EXPECT_EQ(MB_ERROR_NO_ERROR, error);
+  mb_rt_table_deall(0, &table, &error);
+}
+
+TEST_F(MbRtTest, ConcurrentTraces) {
+  constexpr int kThreads = 4;
+  constexpr int kRays = 500;
+  std::vector<double> x(kRays), z(kRays);
+  for (int i = 0; i < kRays; i++)
+    Trace(5.0, 0.15 * i, 0.05 + 0.0008 * i, &x[i], &z[i]);
+
+  // Several threads tracing rays through one model get the same results.
+  std::vector<std::vector<double>> xs(kThreads, std::vector<double>(kRays));
+  std::vector<std::vector<double>> zs(kThreads, std::vector<double>(kRays));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kRays; i++)
+        Trace(5.0, 0.15 * i, 0.05 + 0.0008 * i, &xs[t][i], &zs[t][i]);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  for (int t = 0; t < kThreads; t++) {
+    EXPECT_EQ(x, xs[t]);
+    EXPECT_EQ(z, zs[t]);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,108 @@
+// Copyright 2026 Google Inc. All Rights Reserved.
+//
+// See README file for copying and redistribution conditions.
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "mb_aux.h"
+#include "mb_define.h"
+#include "mb_status.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+// Large enough to be relaxed in strips of grid columns.
+constexpr int kColumns = 401;
+constexpr int kRows = 301;
+constexpr double kTension = 0.35;
+
+struct Data {
+  std::vector<float> x, y, z;
+};
+
+// Soundings of a smooth surface along a few survey lines, leaving gaps between.
+Data MakeData() {
+  Data data;
+  for (int line = 0; line < 8; line++)
+    for (int k = 0; k < 400; k += 2) {
+      const float x = (float)k;
+      const float y = (float)(15 + 38 * line) + 4.0f * std::sin(0.05f * k);
+      data.x.push_back(x);
+      data.y.push_back(y);
+      data.z.push_back(-1000.0f - 0.5f * x + 0.2f * y + 30.0f * std::sin(0.02f * x) * std::cos(0.03f * y));
+    }
+  return data;
+}
+
+std::vector<float> Grid(void *surface_ptr, Data *data) {
+  std::vector<float> sgrid(kColumns * kRows);
+  int error = MB_ERROR_NO_ERROR;
+  EXPECT_EQ(MB_SUCCESS, mb_surface_grid(0, surface_ptr, (int)data->x.size(), data->x.data(), data->y.data(),
+                                        data->z.data(), 0.0, kColumns - 1.0, 0.0, kRows - 1.0, 1.0, 1.0, kTension,
+                                        sgrid.data(), &error));
+  EXPECT_EQ(MB_ERROR_NO_ERROR, error);
+  return sgrid;
+}
+
+std::vector<float> GridWithThreads(int nthreads, Data *data) {
+  void *surface_ptr = nullptr;
+  int error = MB_ERROR_NO_ERROR;
+  EXPECT_EQ(MB_SUCCESS, mb_surface_init(0, nthreads, &surface_ptr, &error));
+  std::vector<float> sgrid = Grid(surface_ptr, data);
+  EXPECT_EQ(MB_SUCCESS, mb_surface_deall(0, &surface_ptr, &error));
+  EXPECT_EQ(nullptr, surface_ptr);
+  return sgrid;
+}
+
+TEST(MbSurfaceTest, SolutionFitsTheData) {
+  Data data = MakeData();
+  const std::vector<float> sgrid = GridWithThreads(1, &data);
+
+  // The grid is stored by rows from the north, and passes close to the soundings.
+  for (size_t k = 0; k < data.x.size(); k += 37) {
+    const int i = (int)std::lround(data.x[k]);
+    const int j = (int)std::lround(data.y[k]);
+    const float z = sgrid[(kRows - 1 - j) * kColumns + i];
+    EXPECT_NEAR(data.z[k], z, 2.0) << "sounding " << k;
+  }
+  for (const float z : sgrid)
+    ASSERT_TRUE(std::isfinite(z));
+}
+
+TEST(MbSurfaceTest, ThreadsAndRepeatedCallsGiveTheSameSolution) {
+  Data data = MakeData();
+  std::vector<float> expected(kColumns * kRows);
+  ASSERT_EQ(MB_SUCCESS, mb_surface(0, (int)data.x.size(), data.x.data(), data.y.data(), data.z.data(), 0.0,
+                                   kColumns - 1.0, 0.0, kRows - 1.0, 1.0, 1.0, kTension, expected.data()));
+
+  for (int nthreads : {1, 2, 3, 4, 16, 40}) {
+    void *surface_ptr = nullptr;
+    int error = MB_ERROR_NO_ERROR;
+    ASSERT_EQ(MB_SUCCESS, mb_surface_init(0, nthreads, &surface_ptr, &error));
+    for (int repeat = 0; repeat < 2; repeat++)
+      EXPECT_TRUE(Grid(surface_ptr, &data) == expected) << nthreads << " threads, call " << repeat;
+    mb_surface_deall(0, &surface_ptr, &error);
+  }
+}
+
+TEST(MbSurfaceTest, ContextsAreIndependent) {
+  Data data = MakeData();
+  const std::vector<float> expected = GridWithThreads(1, &data);
+
+  // Several surfaces computed at once, each with its own context and data.
+  std::vector<Data> copies(4, data);
+  std::vector<std::vector<float>> grids(copies.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < copies.size(); i++)
+    threads.emplace_back([i, &copies, &grids]() { grids[i] = GridWithThreads(1 + (int)i % 2, &copies[i]); });
+  for (std::thread &thread : threads)
+    thread.join();
+  for (size_t i = 0; i < grids.size(); i++)
+    EXPECT_TRUE(grids[i] == expected) << "surface " << i;
+}
+
+}  // namespace
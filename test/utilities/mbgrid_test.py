@@ -7,7 +7,9 @@
 """Tests for mbgrid command line app."""
 
 import os
+import shutil
 import subprocess
+import tempfile
 import unittest
 
 
@@ -15,6 +17,33 @@ class MbGridTest(unittest.TestCase):
 
   def setUp(self):
     self.cmd = '../../src/utilities/mbgrid'
+    self.src_filename = 'testdata/mb71/TN136HS.309.snipped.mb71'
+    self.tmpdir = tempfile.mkdtemp()
+
+  def tearDown(self):
+    shutil.rmtree(self.tmpdir)
+
+  def MakeDatalist(self, names):
+    """Copies the test swath file to each name and lists them."""
+    datalist = os.path.join(self.tmpdir, 'datalist.mb-1')
+    with open(datalist, 'w') as datalist_file:
+      for name in names:
+        filename = os.path.join(self.tmpdir, name)
+        shutil.copyfile(self.src_filename, filename)
+        shutil.copyfile(self.src_filename + '.inf', filename + '.inf')
+        datalist_file.write('%s 71\n' % filename)
+    return datalist
+
+  def Grid(self, datalist, root, *args):
+    """Grids the datalist as an ascii grid, returning the program output."""
+    root = os.path.join(self.tmpdir, root)
+    cmd = [self.cmd, '-I' + datalist, '-O' + root, '-G1', '-E2/2/meters!'] + list(args)
+    return subprocess.check_output(cmd, stderr=subprocess.STDOUT).decode()
+
+  def ReadGrid(self, root):
+    """Returns the grid values, skipping the header naming the user and date."""
+    with open(os.path.join(self.tmpdir, root + '.asc')) as grid_file:
+      return grid_file.read().splitlines()[2:]
 
   def testNoArgs(self):
     cmd = [self.cmd]
@@ -49,7 +78,101 @@ class MbGridTest(unittest.TestCase):
     self.assertIn('lonflip', output)
     self.assertIn('minormax_weighted_mean_threshold:', output)
 
-  # TODO(schwehr): Add tests of actual usage.
+  def ReadCells(self, root):
+    """Returns the grid dimensions and the cell values, indexed by i * ny + j."""
+    lines = self.ReadGrid(root)
+    nx, ny = [int(value) for value in lines[0].split()]
+    values = [float(value) for line in lines[2:] for value in line.split()]
+    self.assertEqual(nx * ny, len(values))
+    return nx, ny, values
+
+  def testClipFillsCellsNearData(self):
+    datalist = self.MakeDatalist(['a.mb71'])
+    area = ['-E10/10/meters!', '-R-124.51/-124.493/40.832/40.845']
+    no_data = 99999.0
+    clip = 3
+    self.Grid(datalist, 'data', '-F1', *area)
+    nx, ny, data = self.ReadCells('data')
+    cells = [(k // ny, k % ny) for k in range(nx * ny) if data[k] < no_data]
+    self.assertTrue(cells)
+
+    # Mode 2 fills empty cells within clip cells of data in both x and y,
+    # mode 4 those within a distance of clip cells.
+    near = {2: lambda di, dj: max(abs(di), abs(dj)) <= clip,
+            4: lambda di, dj: di * di + dj * dj <= clip * clip}
+    for mode in (2, 4):
+      self.Grid(datalist, 'clip', '-F1', '-C%d/%d' % (clip, mode), *area)
+      self.assertEqual((nx, ny), self.ReadCells('clip')[:2])
+      filled = self.ReadCells('clip')[2]
+      nfilled = 0
+      for k in range(nx * ny):
+        i, j = k // ny, k % ny
+        if data[k] < no_data:
+          self.assertEqual(data[k], filled[k], (mode, i, j))
+          continue
+        within = any(near[mode](i - ci, j - cj) for ci, cj in cells)
+        if filled[k] < no_data:
+          nfilled += 1
+          self.assertTrue(within, (mode, i, j))
+        elif mode == 4:
+          self.assertFalse(within, (mode, i, j))
+      self.assertGreater(nfilled, 0, mode)
+
+  def testThreadsGiveTheSameGrid(self):
+    datalist = self.MakeDatalist(['a.mb71', 'b.mb71'])
+    for mode in ('-F1', '-F2'):
+      self.Grid(datalist, 'z1', mode, '-Z1')
+      self.Grid(datalist, 'z4', mode, '-Z4')
+      self.assertEqual(self.ReadGrid('z1'), self.ReadGrid('z4'), mode)
+
+  def testMedianSpillGivesTheSameGrid(self):
+    datalist = self.MakeDatalist(['a.mb71', 'b.mb71'])
+    self.Grid(datalist, 'memory', '-F2')
+
+    # A memory limit of a few bytes writes every value to the scratch file.
+    output = self.Grid(datalist, 'spill', '-F2/0.00001')
+    self.assertIn('Median filter memory limit:', output)
+    self.assertEqual(self.ReadGrid('memory'), self.ReadGrid('spill'))
+
+  def testIncrementalRegridsTouchedFile(self):
+    datalist = self.MakeDatalist(['a.mb71', 'b.mb71'])
+    output = self.Grid(datalist, 'inc', '-F1', '--incremental')
+    self.assertNotIn('data points reused', output)
+    self.assertTrue(os.path.exists(os.path.join(self.tmpdir, 'inc.acc')))
+
+    # Unchanged files are reused.
+    output = self.Grid(datalist, 'inc', '-F1', '--incremental')
+    self.assertIn('data points reused in ' + os.path.join(self.tmpdir, 'a.mb71'), output)
+    self.assertIn('data points reused in ' + os.path.join(self.tmpdir, 'b.mb71'), output)
+
+    # A file touched within the same second is gridded again.
+    filename = os.path.join(self.tmpdir, 'b.mb71')
+    stat = os.stat(filename)
+    seconds = stat.st_mtime_ns // 1000000000 * 1000000000
+    mtime_ns = seconds + (stat.st_mtime_ns + 500000000) % 1000000000
+    os.utime(filename, ns=(stat.st_atime_ns, mtime_ns))
+    output = self.Grid(datalist, 'inc', '-F1', '--incremental')
+    self.assertIn('data points reused in ' + os.path.join(self.tmpdir, 'a.mb71'), output)
+    self.assertNotIn('data points reused in ' + filename, output)
+
+    self.Grid(datalist, 'full', '-F1')
+    self.assertEqual(self.ReadGrid('full'), self.ReadGrid('inc'))
+
+  def testIncrementalRebuildsWithOtherParameters(self):
+    datalist = self.MakeDatalist(['a.mb71', 'b.mb71'])
+    self.Grid(datalist, 'inc', '-F1', '--incremental')
+
+    # Other gridding parameters make the accumulator unusable.
+    output = self.Grid(datalist, 'inc', '-F1', '--incremental', '-E3/3/meters!')
+    self.assertIn('not usable with these gridding parameters', output)
+    self.assertNotIn('data points reused', output)
+    self.Grid(datalist, 'full', '-F1', '-E3/3/meters!')
+    self.assertEqual(self.ReadGrid('full'), self.ReadGrid('inc'))
+
+    # The rebuilt accumulator is then reused.
+    output = self.Grid(datalist, 'inc', '-F1', '--incremental', '-E3/3/meters!')
+    self.assertIn('data points reused', output)
+    self.assertEqual(self.ReadGrid('full'), self.ReadGrid('inc'))
 
 
 if __name__ == '__main__':